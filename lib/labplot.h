@@ -12,6 +12,7 @@
 #include "backend/core/Project.h"
 
 #include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnArrow.h"
 
 #include "backend/worksheet/Worksheet.h"
 
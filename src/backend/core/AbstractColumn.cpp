@@ -474,6 +474,23 @@ QVector<Interval<int>> AbstractColumn::maskedIntervals() const {
 	return d->m_masking.intervals();
 }
 
+/**
+ * \brief Return the first masked row at or after \c row, \c INT_MAX if there is none
+ *
+ * Together with nextUnmaskedRow() this allows to iterate over the runs of unmasked rows
+ * without checking every row with isMasked().
+ */
+int AbstractColumn::nextMaskedRow(int row) const {
+	return d->m_masking.nextSet(row);
+}
+
+/**
+ * \brief Return the first row at or after \c row that is not masked
+ */
+int AbstractColumn::nextUnmaskedRow(int row) const {
+	return d->m_masking.nextUnset(row);
+}
+
 /**
  * \brief Clear all masking information
  */
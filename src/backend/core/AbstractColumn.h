@@ -164,6 +164,8 @@ public:
 	bool isMasked(int row) const;
 	bool isMasked(const Interval<int>& i) const;
 	QVector<Interval<int>> maskedIntervals() const;
+	int nextMaskedRow(int row) const;
+	int nextUnmaskedRow(int row) const;
 	void clearMasks();
 	void setMasked(const Interval<int>& i, bool mask = true);
 	void setMasked(int row, bool mask = true);
@@ -12,6 +12,7 @@
 */
 #include "backend/core/Project.h"
 #include "backend/core/Settings.h"
+#include "backend/lib/UndoMemoryBudget.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -73,7 +74,7 @@ namespace {
 // the project version will be compared with this.
 // if you make any imcompatible changes to the xmlfile
 // or the function in labplot, increase this number.
-int buildXmlVersion = 15;
+int buildXmlVersion = 16;
 }
 
 /**
@@ -173,6 +174,7 @@ public:
 	QString defaultDockWidgetState;
 	bool saveCalculations{true};
 	QUndoStack undo_stack;
+	qint64 undoMemoryLimit{0}; // maximal number of bytes used by the commands on the undo stack, no limit if 0
 };
 
 int ProjectPrivate::m_versionNumber = 0;
@@ -197,6 +199,7 @@ Project::Project()
 	const auto& group = Settings::group(QStringLiteral("Settings_General"));
 	setSaveDefaultDockWidgetState(group.readEntry(QStringLiteral("SaveDefaultDockWidgetState"), false));
 	setSaveCalculations(group.readEntry(QStringLiteral("SaveCalculations"), true));
+	setUndoMemoryLimit(group.readEntry(QStringLiteral("UndoMemoryLimit"), 2048) * qint64(1024 * 1024));
 
 	setUndoAware(true);
 	setIsLoading(false);
@@ -204,6 +207,9 @@ Project::Project()
 
 	connect(this, &Project::aspectDescriptionChanged, this, &Project::descriptionChanged);
 	connect(this, &Project::childAspectAdded, this, &Project::aspectAddedSlot);
+	connect(&d->undo_stack, &QUndoStack::indexChanged, this, [d]() {
+		UndoMemoryBudget::limit(&d->undo_stack, d->undoMemoryLimit);
+	});
 }
 
 Project::~Project() {
@@ -256,6 +262,22 @@ QUndoStack* Project::undoStack() const {
 	return &d_ptr->undo_stack;
 }
 
+/*!
+ * sets the maximal number of bytes used by the commands on the undo stack to keep the data needed to undo and redo them,
+ * e.g. the old values of changed columns. If the limit is exceeded, the oldest commands are removed from the undo history.
+ * No limit is applied if \c limit is 0.
+ */
+void Project::setUndoMemoryLimit(qint64 limit) {
+	Q_D(Project);
+	d->undoMemoryLimit = limit;
+	UndoMemoryBudget::limit(&d->undo_stack, limit);
+}
+
+qint64 Project::undoMemoryLimit() const {
+	Q_D(const Project);
+	return d->undoMemoryLimit;
+}
+
 QMenu* Project::createContextMenu() {
 	QMenu* menu = AbstractAspect::createContextMenu();
 
@@ -44,6 +44,8 @@ public:
 		return this;
 	}
 	QUndoStack* undoStack() const override;
+	void setUndoMemoryLimit(qint64);
+	qint64 undoMemoryLimit() const;
 	QString path() const override {
 		return name();
 	}
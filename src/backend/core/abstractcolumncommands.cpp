@@ -68,10 +68,8 @@ void AbstractColumnClearMasksCmd::undo() {
 }
 
 void AbstractColumnClearMasksCmd::finalize() const {
-	// TODO: implement AbstractColumn::setChanged() instead of these two calls,
-	// move the already available Column::setChanged to the base class.
-	Q_EMIT m_col->owner()->dataChanged(m_col->owner());
-	m_col->owner()->invalidateProperties();
+	// invalidates the cached values (statistics, min/max index) before the listeners are notified
+	m_col->owner()->setChanged();
 }
 
 /** ***************************************************************************
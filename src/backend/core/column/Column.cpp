@@ -10,6 +10,7 @@
 */
 
 #include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnCacheFile.h"
 #ifndef SDK
 #include "backend/notebook/Notebook.h"
 #endif
@@ -21,6 +22,8 @@
 #include "backend/core/datatypes/DateTime2StringFilter.h"
 #include "backend/core/datatypes/Double2StringFilter.h"
 #include "backend/core/datatypes/String2DateTimeFilter.h"
+#include "backend/lib/DateTimeVector.h"
+#include "backend/lib/XYPoints.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/lib/trace.h"
@@ -91,7 +94,13 @@ Column::Column(const QString& name, const QVector<QString>& data)
 
 Column::Column(const QString& name, const QVector<QDateTime>& data, ColumnMode mode)
 	: AbstractColumn(name, AspectType::Column)
-	, d(new ColumnPrivate(this, mode, new QVector<QDateTime>(data))) {
+	, d(new ColumnPrivate(this, mode, new DateTimeVector(data))) {
+	init();
+}
+
+Column::Column(const QString& name, const DateTimeVector& data, ColumnMode mode)
+	: AbstractColumn(name, AspectType::Column)
+	, d(new ColumnPrivate(this, mode, new DateTimeVector(data))) {
 	init();
 }
 
@@ -431,6 +440,18 @@ void Column::invalidateProperties() {
 	d->invalidate();
 }
 
+/*!
+ * invalidates the internal properties after rows starting at \c first were appended to the column
+ * directly via the data()-pointer and emits the signal \c dataChanged().
+ * Contrary to \c setChanged(), the cached values of the rows before \c first are kept and only the appended rows
+ * are processed on their next usage, e.g. in the moments of the statistics.
+ */
+void Column::setRowsAppended(int first) {
+	d->invalidate(first, rowCount() - 1);
+	if (!d->m_suppressDataChangedSignal)
+		Q_EMIT dataChanged(this);
+}
+
 /**
  * \brief Insert some empty (or initialized with zero) rows
  */
@@ -631,6 +652,53 @@ const QMap<QString, int>& Column::frequencies() const {
 	return d->frequencies();
 }
 
+/*!
+ * returns the dictionary encoding of the values of a text column with a code for every row,
+ * equality tests, counting and sorting can be done on the codes instead of the strings.
+ */
+const TextDictionary& Column::dictionary() const {
+	return d->dictionary();
+}
+
+/*!
+ * dictionary-encodes the values of a text column, equal strings share their data afterwards.
+ * The representation of the values doesn't change, \c data() is still a \c QVector<QString>.
+ */
+void Column::encodeTexts() {
+	d->encodeTexts();
+}
+
+/*!
+ * uses the values of the column \c column in the cache file \c file, the values are read from the memory-mapped file
+ * on demand instead of being kept in memory. This is only possible for double columns, the values are loaded into memory
+ * when the column is modified. The change is not undo aware.
+ * Returns \c false if the column can't be used.
+ */
+bool Column::setCacheFile(std::shared_ptr<ColumnCacheFile> file, int column) {
+	return d->setCacheFile(std::move(file), column);
+}
+
+/*!
+ * returns \c true if the values of the column are read from a cache file and are not in memory.
+ */
+bool Column::hasCacheFile() const {
+	return d->cacheFile() != nullptr;
+}
+
+/*!
+ * returns the cache file with the values of the column, \c nullptr if the values are in memory.
+ */
+std::shared_ptr<ColumnCacheFile> Column::cacheFile() const {
+	return d->cacheFile();
+}
+
+/*!
+ * returns the index of the column in \c cacheFile().
+ */
+int Column::cacheFileColumn() const {
+	return d->cacheFileColumn();
+}
+
 void Column::addValueLabel(const QString& value, const QString& label) {
 	d->addValueLabel(value, label);
 }
@@ -1081,6 +1149,18 @@ void Column::save(QXmlStreamWriter* writer) const {
 	writer->writeAttribute(QStringLiteral("designation"), QString::number(static_cast<int>(plotDesignation())));
 	writer->writeAttribute(QStringLiteral("mode"), QString::number(static_cast<int>(columnMode())));
 	writer->writeAttribute(QStringLiteral("width"), QString::number(width()));
+	if (d->cacheFile() && !d->cacheFile()->isExternalMemory()) {
+		// the values stay in the cache file and are not saved in the project
+		writer->writeAttribute(QStringLiteral("cacheFile"), d->cacheFile()->fileName());
+		writer->writeAttribute(QStringLiteral("cacheFileColumn"), QString::number(d->cacheFileColumn()));
+	}
+	if (columnMode() == ColumnMode::DateTime || columnMode() == ColumnMode::Month || columnMode() == ColumnMode::Day) {
+		const auto& timeZone = static_cast<DateTimeVector*>(d->data())->timeZone();
+		if (timeZone.timeSpec() == Qt::LocalTime)
+			writer->writeAttribute(QStringLiteral("timeZone"), QStringLiteral("LocalTime"));
+		else if (timeZone.timeSpec() != Qt::UTC)
+			writer->writeAttribute(QStringLiteral("timeZone"), QString::fromLatin1(timeZone.id()));
+	}
 
 	// save the formula used to generate column values, if available
 	if (!formula().isEmpty()) {
@@ -1242,6 +1322,15 @@ void Column::save(QXmlStreamWriter* writer) const {
 	int i;
 	switch (columnMode()) {
 	case ColumnMode::Double: {
+		if (d->cacheFile()) {
+			if (!d->cacheFile()->isExternalMemory())
+				break;
+			// values in the memory of another application are saved like the values in a vector
+			const char* data = reinterpret_cast<const char*>(d->cacheFile()->columnData(d->cacheFileColumn()));
+			size_t size = d->rowCount() * sizeof(double);
+			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, (int)size).toBase64()));
+			break;
+		}
 		const char* data = reinterpret_cast<const char*>(static_cast<QVector<double>*>(d->data())->constData());
 		size_t size = d->rowCount() * sizeof(double);
 		writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, (int)size).toBase64()));
@@ -1269,15 +1358,14 @@ void Column::save(QXmlStreamWriter* writer) const {
 		break;
 	case ColumnMode::DateTime:
 	case ColumnMode::Month:
-	case ColumnMode::Day:
-		for (i = 0; i < rowCount(); ++i) {
-			writer->writeStartElement(QStringLiteral("row"));
-			writer->writeAttribute(QStringLiteral("index"), QString::number(i));
-			writer->writeCharacters(dateTimeAt(i).toString(QLatin1String("yyyy-dd-MM hh:mm:ss:zzz")));
-			writer->writeEndElement();
-		}
+	case ColumnMode::Day: {
+		// milliseconds since epoch, invalid values are saved as DateTimeVector::InvalidValue
+		const char* data = reinterpret_cast<const char*>(static_cast<DateTimeVector*>(d->data())->constData());
+		size_t size = d->rowCount() * sizeof(qint64);
+		writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, (int)size).toBase64()));
 		break;
 	}
+	}
 
 	writer->writeEndElement(); // "column"
 }
@@ -1285,9 +1373,10 @@ void Column::save(QXmlStreamWriter* writer) const {
 // TODO: extra header
 class DecodeColumnTask : public QRunnable {
 public:
-	DecodeColumnTask(ColumnPrivate* priv, const QString& content)
+	DecodeColumnTask(ColumnPrivate* priv, const QString& content, const QTimeZone& timeZone = QTimeZone::UTC)
 		: m_private(priv)
-		, m_content(content){};
+		, m_content(content)
+		, m_timeZone(timeZone){};
 	void run() override {
 		QByteArray bytes = QByteArray::fromBase64(m_content.toLatin1());
 		if (m_private->columnMode() == AbstractColumn::ColumnMode::Double) {
@@ -1298,6 +1387,12 @@ public:
 			auto* data = new QVector<qint64>(bytes.size() / (int)sizeof(qint64));
 			memcpy(data->data(), bytes.data(), bytes.size());
 			m_private->replaceData(data);
+		} else if (m_private->columnMode() == AbstractColumn::ColumnMode::DateTime || m_private->columnMode() == AbstractColumn::ColumnMode::Month
+				   || m_private->columnMode() == AbstractColumn::ColumnMode::Day) {
+			auto* data = new DateTimeVector(bytes.size() / (int)sizeof(qint64));
+			memcpy(data->data(), bytes.data(), bytes.size());
+			data->setTimeZone(m_timeZone);
+			m_private->replaceData(data);
 		} else {
 			auto* data = new QVector<int>(bytes.size() / (int)sizeof(int));
 			memcpy(data->data(), bytes.data(), bytes.size());
@@ -1308,6 +1403,7 @@ public:
 private:
 	ColumnPrivate* m_private;
 	QString m_content;
+	QTimeZone m_timeZone;
 };
 
 /**
@@ -1343,6 +1439,18 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 	else
 		d->setWidth(str.toInt());
 
+	// date-time values are saved as milliseconds since epoch starting with version 16, as rows before
+	const bool dateTimeRows = (Project::xmlVersion() < 16);
+	QTimeZone timeZone(QTimeZone::UTC);
+	str = attribs.value(QStringLiteral("timeZone")).toString();
+	if (str == QLatin1String("LocalTime"))
+		timeZone = QTimeZone(QTimeZone::LocalTime);
+	else if (!str.isEmpty() && QTimeZone(str.toLatin1()).isValid())
+		timeZone = QTimeZone(str.toLatin1());
+
+	const QString cacheFileName = attribs.value(QStringLiteral("cacheFile")).toString();
+	const int cacheFileColumn = attribs.value(QStringLiteral("cacheFileColumn")).toInt();
+
 	QVector<QDateTime> dateTimeVector;
 	QVector<QString> textVector;
 
@@ -1464,9 +1572,12 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 
 		if (!preview) {
 			QString content = reader->text().toString().trimmed();
-			// Datetime and text are read in row by row
-			if (!content.isEmpty() && (columnMode() == ColumnMode::Double || columnMode() == ColumnMode::Integer || columnMode() == ColumnMode::BigInt)) {
-				auto* task = new DecodeColumnTask(d, content);
+			// text (and datetime in older versions) are read in row by row
+			const bool dateTime = (columnMode() == ColumnMode::DateTime || columnMode() == ColumnMode::Month || columnMode() == ColumnMode::Day);
+			if (!content.isEmpty()
+				&& (columnMode() == ColumnMode::Double || columnMode() == ColumnMode::Integer || columnMode() == ColumnMode::BigInt
+					|| (dateTime && !dateTimeRows))) {
+				auto* task = new DecodeColumnTask(d, content, timeZone);
 				QThreadPool::globalInstance()->start(task);
 			}
 		}
@@ -1481,13 +1592,22 @@ bool Column::load(XmlStreamReader* reader, bool preview) {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
-		setDateTimes(dateTimeVector);
+		if (dateTimeRows)
+			setDateTimes(dateTimeVector);
 		break;
 	case AbstractColumn::ColumnMode::Text:
 		setText(textVector);
 		break;
 	}
 
+	if (!cacheFileName.isEmpty() && !preview) {
+		auto file = std::make_shared<ColumnCacheFile>(cacheFileName);
+		if (!file->open())
+			reader->raiseWarning(file->errorString());
+		else if (!d->setCacheFile(file, cacheFileColumn))
+			reader->raiseWarning(i18n("The column %1 couldn't be read from the cache file \"%2\".", name(), cacheFileName));
+	}
+
 	return !reader->error();
 }
 
@@ -1831,7 +1951,10 @@ double Column::minimum(int startIndex, int endIndex) const {
 
 	ColumnMode mode = columnMode();
 	Properties property = properties();
-	if (property == Properties::No || property == Properties::NonMonotonic) {
+	double max;
+	if ((property == Properties::No || property == Properties::NonMonotonic) && d->indexedMinMax(startIndex, endIndex, min, max)) {
+		// large column, determined with the min/max index
+	} else if (property == Properties::No || property == Properties::NonMonotonic) {
 		// skipping values is only in Properties::No needed, because
 		// when there are invalid values the property must be Properties::No
 		switch (mode) {
@@ -1879,12 +2002,12 @@ double Column::minimum(int startIndex, int endIndex) const {
 		case ColumnMode::Text:
 			break;
 		case ColumnMode::DateTime: {
-			auto* vec = static_cast<QVector<QDateTime>*>(data());
+			auto* vec = static_cast<DateTimeVector*>(data());
 			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
+				if (!vec->isValid(row) || isMasked(row))
 					continue;
 
-				const qint64 val = vec->at(row).toMSecsSinceEpoch();
+				const qint64 val = vec->msecsAt(row);
 
 				if (val < min)
 					min = val;
@@ -1978,7 +2101,10 @@ double Column::maximum(int startIndex, int endIndex) const {
 
 	ColumnMode mode = columnMode();
 	Properties property = properties();
-	if (property == Properties::No || property == Properties::NonMonotonic) {
+	double min;
+	if ((property == Properties::No || property == Properties::NonMonotonic) && d->indexedMinMax(startIndex, endIndex, min, max)) {
+		// large column, determined with the min/max index
+	} else if (property == Properties::No || property == Properties::NonMonotonic) {
 		switch (mode) {
 		case ColumnMode::Double: {
 			auto* vec = static_cast<QVector<double>*>(data());
@@ -2021,11 +2147,11 @@ double Column::maximum(int startIndex, int endIndex) const {
 		case ColumnMode::Text:
 			break;
 		case ColumnMode::DateTime: {
-			auto* vec = static_cast<QVector<QDateTime>*>(data());
+			auto* vec = static_cast<DateTimeVector*>(data());
 			for (int row = startIndex; row <= endIndex; ++row) {
-				if (!isValid(row) || isMasked(row))
+				if (!vec->isValid(row) || isMasked(row))
 					continue;
-				const qint64 val = vec->at(row).toMSecsSinceEpoch();
+				const qint64 val = vec->msecsAt(row);
 
 				if (val > max)
 					max = val;
@@ -2159,13 +2285,9 @@ int Column::indexForValue(double x, QVector<double>& column, Properties properti
 	return -1;
 }
 
-/*!
- * Find index which corresponds to a @p x . In a vector of values
- * When monotonic increasing or decreasing a different algorithm will be used, which needs less steps (mean) (log_2(rowCount)) to find the value.
- * @param x
- * @return -1 if index not found, otherwise the index
- */
-int Column::indexForValue(const double x, const QVector<QPointF>& points, Properties properties) {
+namespace {
+template<typename Points>
+int indexForPointValue(const double x, const Points& points, AbstractColumn::Properties properties) {
 	int rowCount = points.count();
 
 	if (rowCount == 0)
@@ -2180,7 +2302,7 @@ int Column::indexForValue(const double x, const QVector<QPointF>& points, Proper
 		int lowerIndex = 0;
 		int higherIndex = rowCount - 1;
 
-		unsigned int maxSteps = calculateMaxSteps(static_cast<unsigned int>(rowCount)) + 1;
+		unsigned int maxSteps = Column::calculateMaxSteps(static_cast<unsigned int>(rowCount)) + 1;
 
 		for (unsigned int i = 0; i < maxSteps; i++) { // so no log_2(rowCount) needed
 			int index = lowerIndex + round(static_cast<double>(higherIndex - lowerIndex) / 2);
@@ -2223,6 +2345,21 @@ int Column::indexForValue(const double x, const QVector<QPointF>& points, Proper
 	}
 	return -1;
 }
+} // namespace
+
+/*!
+ * Find index which corresponds to a @p x . In a vector of values
+ * When monotonic increasing or decreasing a different algorithm will be used, which needs less steps (mean) (log_2(rowCount)) to find the value.
+ * @param x
+ * @return -1 if index not found, otherwise the index
+ */
+int Column::indexForValue(const double x, const QVector<QPointF>& points, Properties properties) {
+	return indexForPointValue(x, points, properties);
+}
+
+int Column::indexForValue(const double x, const XYPoints& points, Properties properties) {
+	return indexForPointValue(x, points, properties);
+}
 
 /*!
  * Find index which corresponds to a @p x . In a vector of values
@@ -16,11 +16,17 @@
 #include "backend/nsl/nsl_sf_stats.h"
 #include <QPixmap>
 
+#include <memory>
+
 class AbstractSimpleFilter;
 class CartesianPlot;
+class ColumnCacheFile;
 class ColumnStringIO;
+class DateTimeVector;
+class TextDictionary;
 class QAction;
 class QActionGroup;
+class XYPoints;
 class ColumnPrivate;
 class ColumnSetGlobalFormulaCmd;
 
@@ -41,6 +47,7 @@ public:
 	Column(const QString& name, const QVector<qint64>& data);
 	Column(const QString& name, const QVector<QString>& data);
 	Column(const QString& name, const QVector<QDateTime>& data, ColumnMode);
+	Column(const QString& name, const DateTimeVector& data, ColumnMode);
 	void init();
 	~Column() override;
 
@@ -161,6 +168,7 @@ public:
 
 	Properties properties() const override;
 	void invalidateProperties() override;
+	void setRowsAppended(int first);
 
 	void setFromColumn(int, AbstractColumn*, int);
 	QString textAt(int) const override;
@@ -169,6 +177,12 @@ public:
 	void replaceTexts(int, const QVector<QString>&) override;
 	int dictionaryIndex(int row) const override;
 	const QMap<QString, int>& frequencies() const;
+	const TextDictionary& dictionary() const;
+	void encodeTexts();
+	bool setCacheFile(std::shared_ptr<ColumnCacheFile>, int column);
+	bool hasCacheFile() const;
+	std::shared_ptr<ColumnCacheFile> cacheFile() const;
+	int cacheFileColumn() const;
 
 	QDate dateAt(int) const override;
 	void setDateAt(int, QDate) override;
@@ -202,6 +216,7 @@ public:
 	static int calculateMaxSteps(unsigned int value);
 	static int indexForValue(double x, QVector<double>& column, Properties properties = Properties::No);
 	static int indexForValue(const double x, const QVector<QPointF>& column, Properties properties = Properties::No);
+	static int indexForValue(const double x, const XYPoints& points, Properties properties = Properties::No);
 	static int indexForValue(double x, QVector<QLineF>& lines, Properties properties = Properties::No);
 	int indexForValue(double x) const override;
 	bool indicesMinMax(double v1, double v2, int& start, int& end) const override;
@@ -277,6 +292,7 @@ private Q_SLOTS:
 	friend class ColumnStringIO;
 	friend class ColumnRemoveRowsCmd;
 	friend class ColumnInsertRowsCmd;
+	friend class SpreadsheetSortCmd;
 	friend class Project; // requires handleAspectUpdated()
 };
 
@@ -0,0 +1,528 @@
+/*
+	File                 : ColumnArrow.cpp
+	Project              : LabPlot
+	Description          : Exchange of columns via the Arrow C data interface
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ColumnArrow.h"
+#include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnCacheFile.h"
+#include "backend/lib/DateTimeVector.h"
+
+#include <KLocalizedString>
+
+#include <QTimeZone>
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+/*!
+ * \class ColumnArrow
+ * \brief Export and import of columns in the layout of the Arrow C data interface (validity bitmap and values buffer).
+ *
+ * Exported columns share their values with the column: the values buffer points to the data of the column, which is
+ * implicitly shared and kept alive until the consumer calls the release callback of the array. If the column is modified
+ * in the meantime, it detaches from the exported data. Only the validity bitmap and the offsets and characters of text
+ * columns are created for the export.
+ *
+ * Imported float64 arrays without null values are not copied, the column reads the values from the memory of the producer
+ * via \c ColumnCacheFile::fromMemory() and the release callback of the array is called when the column doesn't use them
+ * anymore, i.e. when it was modified or deleted. All other arrays are copied and released right away.
+ *
+ * NaN values of double columns and invalid date-times are exported as null values. Null values are imported as NaN,
+ * invalid date-times or empty texts, integer arrays with null values are imported as double columns.
+ *
+ * Column modes and Arrow formats:
+ * \li Double: "g" (float64), "f" (float32) is imported too
+ * \li Integer: "i" (int32), "c", "C", "s", "S" and "b" (boolean) are imported too
+ * \li BigInt: "l" (int64), "I" (uint32) is imported too
+ * \li Text: "u" (utf8), "U" (large utf8) is imported too
+ * \li DateTime, Month and Day: "tsm:<time zone>" (timestamp in milliseconds), the other timestamp units and the dates "tdD" and "tdm" are imported too
+ *
+ * Several columns are exchanged as a struct array ("+s") with one child array per column.
+ */
+
+namespace {
+
+struct SchemaData {
+	QByteArray format;
+	QByteArray name;
+	std::vector<ArrowSchema> children;
+	std::vector<ArrowSchema*> childPointers;
+};
+
+void releaseSchema(ArrowSchema* schema) {
+	auto* data = static_cast<SchemaData*>(schema->private_data);
+	for (auto* child : data->childPointers) {
+		if (child->release)
+			child->release(child);
+	}
+	delete data;
+	schema->release = nullptr;
+}
+
+void initSchema(ArrowSchema* schema, SchemaData* data, int64_t flags) {
+	schema->format = data->format.constData();
+	schema->name = data->name.constData();
+	schema->metadata = nullptr;
+	schema->flags = flags;
+	schema->n_children = static_cast<int64_t>(data->childPointers.size());
+	schema->children = data->childPointers.empty() ? nullptr : data->childPointers.data();
+	schema->dictionary = nullptr;
+	schema->release = releaseSchema;
+	schema->private_data = data;
+}
+
+// buffers of an exported array, the values are shared with the column
+struct ArrayData {
+	QVector<double> doubles;
+	QVector<int> integers;
+	QVector<qint64> bigInts;
+	std::shared_ptr<ColumnCacheFile> cacheFile;
+	std::vector<uint8_t> validity;
+	std::vector<int32_t> offsets;
+	QByteArray characters;
+	const void* buffers[3]{nullptr, nullptr, nullptr};
+	std::vector<ArrowArray> children;
+	std::vector<ArrowArray*> childPointers;
+};
+
+void releaseArray(ArrowArray* array) {
+	auto* data = static_cast<ArrayData*>(array->private_data);
+	for (auto* child : data->childPointers) {
+		if (child->release)
+			child->release(child);
+	}
+	delete data;
+	array->release = nullptr;
+}
+
+void initArray(ArrowArray* array, ArrayData* data, int64_t length, int64_t nullCount, int64_t bufferCount) {
+	array->length = length;
+	array->null_count = nullCount;
+	array->offset = 0;
+	array->n_buffers = bufferCount;
+	array->n_children = static_cast<int64_t>(data->childPointers.size());
+	array->buffers = data->buffers;
+	array->children = data->childPointers.empty() ? nullptr : data->childPointers.data();
+	array->dictionary = nullptr;
+	array->release = releaseArray;
+	array->private_data = data;
+}
+
+// creates the validity bitmap of \c length rows, no bitmap is needed if all rows are valid. Returns the number of null values.
+template<typename Valid>
+int64_t createValidity(std::vector<uint8_t>& bitmap, int64_t length, Valid valid) {
+	bitmap.assign((length + 7) / 8, 0);
+	int64_t nullCount = 0;
+	for (int64_t i = 0; i < length; ++i) {
+		if (valid(i))
+			bitmap[i >> 3] |= static_cast<uint8_t>(1 << (i & 7));
+		else
+			++nullCount;
+	}
+	if (nullCount == 0)
+		bitmap.clear();
+	return nullCount;
+}
+
+bool exportArray(const Column* column, ArrowArray* array, SchemaData* schema, QString* errorString) {
+	auto* data = new ArrayData;
+	const int64_t length = column->rowCount();
+	int64_t nullCount = 0;
+	int64_t bufferCount = 2;
+	schema->name = column->name().toUtf8();
+
+	switch (column->columnMode()) {
+	case AbstractColumn::ColumnMode::Double: {
+		schema->format = "g";
+		const double* values;
+		const auto cacheFile = column->cacheFile();
+		if (cacheFile && cacheFile->isExternalMemory()) {
+			// the values are already in memory, e.g. imported from another application
+			data->cacheFile = cacheFile;
+			values = cacheFile->columnData(column->cacheFileColumn());
+		} else if (cacheFile) {
+			// the chunks of the column are not stored contiguously in the cache file
+			data->doubles.resize(length);
+			cacheFile->copy(column->cacheFileColumn(), 0, length, data->doubles.data());
+			values = data->doubles.constData();
+		} else {
+			data->doubles = *static_cast<QVector<double>*>(column->data());
+			values = data->doubles.constData();
+		}
+		nullCount = createValidity(data->validity, length, [values](int64_t i) {
+			return !std::isnan(values[i]);
+		});
+		data->buffers[1] = values;
+		break;
+	}
+	case AbstractColumn::ColumnMode::Integer:
+		schema->format = "i";
+		data->integers = *static_cast<QVector<int>*>(column->data());
+		data->buffers[1] = data->integers.constData();
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		schema->format = "l";
+		data->bigInts = *static_cast<QVector<qint64>*>(column->data());
+		data->buffers[1] = data->bigInts.constData();
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day: {
+		const auto* dateTimes = static_cast<DateTimeVector*>(column->data());
+		const auto& timeZone = dateTimes->timeZone();
+		if (timeZone.timeSpec() == Qt::LocalTime)
+			schema->format = "tsm:" + QTimeZone::systemTimeZoneId();
+		else if (timeZone.timeSpec() == Qt::UTC)
+			schema->format = "tsm:UTC";
+		else
+			schema->format = "tsm:" + timeZone.id();
+		data->bigInts = dateTimes->msecs();
+		nullCount = createValidity(data->validity, length, [dateTimes](int64_t i) {
+			return dateTimes->isValid(i);
+		});
+		data->buffers[1] = data->bigInts.constData();
+		break;
+	}
+	case AbstractColumn::ColumnMode::Text: {
+		schema->format = "u";
+		const auto* texts = static_cast<QVector<QString>*>(column->data());
+		data->offsets.resize(length + 1);
+		data->offsets[0] = 0;
+		for (int64_t i = 0; i < length; ++i) {
+			const QByteArray utf8 = texts->at(i).toUtf8();
+			if (data->characters.size() + utf8.size() > std::numeric_limits<int32_t>::max()) {
+				if (errorString)
+					*errorString = i18n("The texts of the column \"%1\" are too large to be exported.", column->name());
+				delete data;
+				return false;
+			}
+			data->characters.append(utf8);
+			data->offsets[i + 1] = static_cast<int32_t>(data->characters.size());
+		}
+		data->buffers[1] = data->offsets.data();
+		data->buffers[2] = data->characters.constData();
+		bufferCount = 3;
+		break;
+	}
+	}
+
+	if (!data->validity.empty())
+		data->buffers[0] = data->validity.data();
+	initArray(array, data, length, nullCount, bufferCount);
+	return true;
+}
+
+// the imported array, released when the last column using its memory is deleted
+struct ImportedArray {
+	explicit ImportedArray(const ArrowArray& array)
+		: array(array) {
+	}
+	~ImportedArray() {
+		if (array.release)
+			array.release(&array);
+	}
+	ImportedArray(const ImportedArray&) = delete;
+	ImportedArray& operator=(const ImportedArray&) = delete;
+
+	ArrowArray array;
+};
+
+bool isValid(const uint8_t* validity, int64_t i) {
+	return !validity || ((validity[i >> 3] >> (i & 7)) & 1);
+}
+
+template<typename T>
+const T* buffer(const ArrowArray* array, int index) {
+	return static_cast<const T*>(array->buffers[index]);
+}
+
+// copies the values of a primitive array, null values are replaced by \c null
+template<typename Target, typename Source>
+QVector<Target> copyValues(const ArrowArray* array, int64_t offset, int rows, const uint8_t* validity, Target null) {
+	QVector<Target> values(rows);
+	const auto* source = buffer<Source>(array, 1) + offset;
+	for (int i = 0; i < rows; ++i)
+		values[i] = isValid(validity, offset + i) ? static_cast<Target>(source[i]) : null;
+	return values;
+}
+
+// integer arrays with null values become double columns with NaN for the null values
+template<typename Target, typename Source>
+Column* importIntegers(const QString& name, const ArrowArray* array, int64_t offset, int rows, const uint8_t* validity) {
+	if (validity)
+		return new Column(name, copyValues<double, Source>(array, offset, rows, validity, NAN));
+	return new Column(name, copyValues<Target, Source>(array, offset, rows, nullptr, 0));
+}
+
+template<typename Offset>
+QVector<QString> copyTexts(const ArrowArray* array, int64_t offset, int rows, const uint8_t* validity) {
+	QVector<QString> texts(rows);
+	const auto* offsets = buffer<Offset>(array, 1) + offset;
+	const auto* characters = buffer<char>(array, 2);
+	for (int i = 0; i < rows; ++i) {
+		if (isValid(validity, offset + i))
+			texts[i] = QString::fromUtf8(characters + offsets[i], static_cast<qsizetype>(offsets[i + 1] - offsets[i]));
+	}
+	return texts;
+}
+
+// rounds towards negative infinity, also for negative time stamps
+qint64 floorDivide(qint64 value, qint64 divisor) {
+	const qint64 quotient = value / divisor;
+	return (value % divisor < 0) ? quotient - 1 : quotient;
+}
+
+Column* importDateTimes(const QString& name, const QByteArray& format, const ArrowArray* array, int64_t offset, int rows, const uint8_t* validity) {
+	DateTimeVector dateTimes(rows);
+	qint64* msecs = dateTimes.data();
+	if (format == "tdD") {
+		const auto* days = buffer<int32_t>(array, 1) + offset;
+		for (int i = 0; i < rows; ++i) {
+			if (isValid(validity, offset + i))
+				msecs[i] = days[i] * qint64(86400000);
+		}
+	} else {
+		const auto* values = buffer<int64_t>(array, 1) + offset;
+		const char unit = format.at(2);
+		for (int i = 0; i < rows; ++i) {
+			if (!isValid(validity, offset + i))
+				continue;
+			switch (unit) {
+			case 's':
+				msecs[i] = values[i] * 1000;
+				break;
+			case 'u':
+				msecs[i] = floorDivide(values[i], 1000);
+				break;
+			case 'n':
+				msecs[i] = floorDivide(values[i], 1000000);
+				break;
+			default: // milliseconds
+				msecs[i] = values[i];
+			}
+		}
+	}
+
+	// time stamps without time zone are interpreted as UTC, offsets like "+01:00" are supported too
+	QTimeZone timeZone = QTimeZone::utc();
+	const QByteArray zone = format.startsWith("ts") ? format.mid(4) : QByteArray();
+	if (!zone.isEmpty() && zone != "UTC") {
+		QTimeZone tz(zone);
+		if (!tz.isValid())
+			tz = QTimeZone("UTC" + zone);
+		if (tz.isValid())
+			timeZone = tz;
+	}
+	dateTimes.setTimeZone(timeZone);
+
+	return new Column(name, dateTimes, AbstractColumn::ColumnMode::DateTime);
+}
+
+Column* importArray(const ArrowArray* array,
+					const ArrowSchema* schema,
+					int64_t offset,
+					int64_t length,
+					const std::shared_ptr<ImportedArray>& owner,
+					QString* errorString) {
+	const QString name = schema->name ? QString::fromUtf8(schema->name) : QString();
+	const QByteArray format(schema->format ? schema->format : "");
+	const auto setError = [errorString](const QString& error) {
+		if (errorString)
+			*errorString = error;
+	};
+
+	if (length < 0 || length > std::numeric_limits<int>::max()) {
+		setError(i18n("The array \"%1\" has too many rows.", name));
+		return nullptr;
+	}
+	if (schema->dictionary || array->dictionary) {
+		setError(i18n("The dictionary-encoded array \"%1\" is not supported.", name));
+		return nullptr;
+	}
+	const int rows = static_cast<int>(length);
+	const int64_t bufferCount = (format == "u" || format == "U") ? 3 : 2;
+	if (array->n_buffers < bufferCount) {
+		setError(i18n("The array \"%1\" with the format \"%2\" is not supported.", name, QString::fromLatin1(format)));
+		return nullptr;
+	}
+
+	// the bitmap is only used if there are null values in the imported rows
+	const uint8_t* validity = (array->null_count != 0) ? buffer<uint8_t>(array, 0) : nullptr;
+	if (validity) {
+		bool nulls = false;
+		for (int i = 0; i < rows && !nulls; ++i)
+			nulls = !isValid(validity, offset + i);
+		if (!nulls)
+			validity = nullptr;
+	}
+
+	if (format == "g") {
+		const auto* values = buffer<double>(array, 1) + offset;
+		if (!validity && reinterpret_cast<uintptr_t>(values) % alignof(double) == 0) {
+			// the column reads the values from the memory of the producer, the array is released when the column doesn't need them anymore
+			auto file = ColumnCacheFile::fromMemory(name, values, rows, [owner]() mutable {
+				owner.reset();
+			});
+			auto* column = new Column(name, AbstractColumn::ColumnMode::Double);
+			column->setCacheFile(std::move(file), 0);
+			return column;
+		}
+		return new Column(name, copyValues<double, double>(array, offset, rows, validity, NAN));
+	}
+	if (format == "f")
+		return new Column(name, copyValues<double, float>(array, offset, rows, validity, NAN));
+	if (format == "i")
+		return importIntegers<int, int32_t>(name, array, offset, rows, validity);
+	if (format == "c")
+		return importIntegers<int, int8_t>(name, array, offset, rows, validity);
+	if (format == "C")
+		return importIntegers<int, uint8_t>(name, array, offset, rows, validity);
+	if (format == "s")
+		return importIntegers<int, int16_t>(name, array, offset, rows, validity);
+	if (format == "S")
+		return importIntegers<int, uint16_t>(name, array, offset, rows, validity);
+	if (format == "I")
+		return importIntegers<qint64, uint32_t>(name, array, offset, rows, validity);
+	if (format == "l")
+		return importIntegers<qint64, int64_t>(name, array, offset, rows, validity);
+	if (format == "b") {
+		// the values are stored as bits like the validity
+		const auto* bits = buffer<uint8_t>(array, 1);
+		if (validity) {
+			QVector<double> values(rows);
+			for (int i = 0; i < rows; ++i)
+				values[i] = isValid(validity, offset + i) ? isValid(bits, offset + i) : NAN;
+			return new Column(name, values);
+		}
+		QVector<int> values(rows);
+		for (int i = 0; i < rows; ++i)
+			values[i] = isValid(bits, offset + i);
+		return new Column(name, values);
+	}
+	if (format == "u")
+		return new Column(name, copyTexts<int32_t>(array, offset, rows, validity));
+	if (format == "U")
+		return new Column(name, copyTexts<int64_t>(array, offset, rows, validity));
+	if (format == "tdD" || format == "tdm" || (format.startsWith("ts") && format.size() >= 4 && format.at(3) == ':'))
+		return importDateTimes(name, format, array, offset, rows, validity);
+
+	setError(i18n("The array \"%1\" with the format \"%2\" is not supported.", name, QString::fromLatin1(format)));
+	return nullptr;
+}
+}
+
+/*!
+ * exports the column \c column to \c array and \c schema, which are owned by the consumer afterwards
+ * and have to be released via their release callbacks. Returns \c false if the column can't be exported.
+ */
+bool ColumnArrow::exportColumn(const Column* column, ArrowArray* array, ArrowSchema* schema, QString* errorString) {
+	if (!column || !array || !schema)
+		return false;
+
+	auto* schemaData = new SchemaData;
+	if (!exportArray(column, array, schemaData, errorString)) {
+		delete schemaData;
+		return false;
+	}
+	initSchema(schema, schemaData, ARROW_FLAG_NULLABLE);
+	return true;
+}
+
+/*!
+ * exports the columns \c columns as a struct array with one child per column, e.g. the columns of a spreadsheet.
+ * All columns must have the same number of rows.
+ */
+bool ColumnArrow::exportColumns(const QVector<Column*>& columns, ArrowArray* array, ArrowSchema* schema, QString* errorString) {
+	if (!array || !schema)
+		return false;
+
+	const int64_t length = columns.isEmpty() ? 0 : columns.first()->rowCount();
+	for (const auto* column : columns) {
+		if (column->rowCount() != length) {
+			if (errorString)
+				*errorString = i18n("The columns have different numbers of rows.");
+			return false;
+		}
+	}
+
+	const size_t count = columns.size();
+	auto* arrayData = new ArrayData;
+	arrayData->children.resize(count, ArrowArray{});
+	auto* schemaData = new SchemaData;
+	schemaData->format = "+s";
+	schemaData->children.resize(count, ArrowSchema{});
+	for (size_t i = 0; i < count; ++i) {
+		arrayData->childPointers.push_back(&arrayData->children[i]);
+		schemaData->childPointers.push_back(&schemaData->children[i]);
+	}
+	initArray(array, arrayData, length, 0, 1);
+	initSchema(schema, schemaData, 0);
+
+	for (size_t i = 0; i < count; ++i) {
+		auto* childSchemaData = new SchemaData;
+		if (!exportArray(columns.at(i), &arrayData->children[i], childSchemaData, errorString)) {
+			delete childSchemaData;
+			array->release(array);
+			schema->release(schema);
+			return false;
+		}
+		initSchema(&schemaData->children[i], childSchemaData, ARROW_FLAG_NULLABLE);
+	}
+
+	return true;
+}
+
+/*!
+ * creates a new column with the values of \c array described by \c schema. The array is moved, i.e. LabPlot takes
+ * the ownership of it and calls its release callback when its memory is not used anymore, also if the import fails.
+ * The schema stays owned by the caller. Returns \c nullptr if the array can't be imported.
+ */
+Column* ColumnArrow::importColumn(ArrowArray* array, const ArrowSchema* schema, QString* errorString) {
+	if (!array || !array->release || !schema)
+		return nullptr;
+
+	auto owner = std::make_shared<ImportedArray>(*array);
+	array->release = nullptr;
+	return importArray(&owner->array, schema, owner->array.offset, owner->array.length, owner, errorString);
+}
+
+/*!
+ * creates new columns with the values of the children of the struct array \c array, e.g. a table exported by another application.
+ * The array is moved like in \c importColumn(), the columns are added to \c columns and owned by the caller.
+ * The validity bitmap of the struct array itself is not taken into account.
+ */
+bool ColumnArrow::importColumns(ArrowArray* array, const ArrowSchema* schema, QVector<Column*>& columns, QString* errorString) {
+	if (!array || !array->release || !schema)
+		return false;
+
+	auto owner = std::make_shared<ImportedArray>(*array);
+	array->release = nullptr;
+	const auto& parent = owner->array;
+	if (!schema->format || std::strcmp(schema->format, "+s") != 0 || schema->n_children != parent.n_children) {
+		if (errorString)
+			*errorString = i18n("The array is not a struct array.");
+		return false;
+	}
+
+	QVector<Column*> imported;
+	for (int64_t i = 0; i < parent.n_children; ++i) {
+		const auto* child = parent.children[i];
+		auto* column = importArray(child, schema->children[i], parent.offset + child->offset, parent.length, owner, errorString);
+		if (!column) {
+			qDeleteAll(imported);
+			return false;
+		}
+		imported << column;
+	}
+
+	columns << imported;
+	return true;
+}
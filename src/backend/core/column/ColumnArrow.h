@@ -0,0 +1,76 @@
+/*
+	File                 : ColumnArrow.h
+	Project              : LabPlot
+	Description          : Exchange of columns via the Arrow C data interface
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef COLUMNARROW_H
+#define COLUMNARROW_H
+
+#include <QString>
+#include <QVector>
+
+#include <cstdint>
+
+// structures of the Arrow C data interface, see https://arrow.apache.org/docs/format/CDataInterface.html
+#ifndef ARROW_C_DATA_INTERFACE
+#define ARROW_C_DATA_INTERFACE
+
+#define ARROW_FLAG_DICTIONARY_ORDERED 1
+#define ARROW_FLAG_NULLABLE 2
+#define ARROW_FLAG_MAP_KEYS_SORTED 4
+
+struct ArrowSchema {
+	// array type description
+	const char* format;
+	const char* name;
+	const char* metadata;
+	int64_t flags;
+	int64_t n_children;
+	struct ArrowSchema** children;
+	struct ArrowSchema* dictionary;
+
+	// release callback
+	void (*release)(struct ArrowSchema*);
+	// opaque producer-specific data
+	void* private_data;
+};
+
+struct ArrowArray {
+	// array data description
+	int64_t length;
+	int64_t null_count;
+	int64_t offset;
+	int64_t n_buffers;
+	int64_t n_children;
+	const void** buffers;
+	struct ArrowArray** children;
+	struct ArrowArray* dictionary;
+
+	// release callback
+	void (*release)(struct ArrowArray*);
+	// opaque producer-specific data
+	void* private_data;
+};
+
+#endif // ARROW_C_DATA_INTERFACE
+
+class Column;
+
+#ifdef SDK
+#include "labplot_export.h"
+class LABPLOT_EXPORT ColumnArrow {
+#else
+class ColumnArrow {
+#endif
+public:
+	static bool exportColumn(const Column*, ArrowArray*, ArrowSchema*, QString* errorString = nullptr);
+	static bool exportColumns(const QVector<Column*>&, ArrowArray*, ArrowSchema*, QString* errorString = nullptr);
+	static Column* importColumn(ArrowArray*, const ArrowSchema*, QString* errorString = nullptr);
+	static bool importColumns(ArrowArray*, const ArrowSchema*, QVector<Column*>& columns, QString* errorString = nullptr);
+};
+
+#endif // COLUMNARROW_H
@@ -0,0 +1,461 @@
+/*
+	File                 : ColumnCacheFile.cpp
+	Project              : LabPlot
+	Description          : Memory-mapped file with the values of columns stored in chunks
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "ColumnCacheFile.h"
+#include "backend/core/AbstractColumn.h"
+#include "backend/lib/Parallel.h"
+#include "backend/lib/macros.h"
+
+#include <KLocalizedString>
+
+#include <QDataStream>
+
+#include <algorithm>
+#include <cstring>
+
+/*!
+ * \class ColumnCacheFile
+ * \brief LabPlot-native columnar cache file, the values of double columns are stored in chunks of \c chunkRows() rows.
+ *
+ * The file is mapped into memory and the chunks are only paged in by the operating system when their values are accessed.
+ * For every chunk the minimum, the maximum and the number of NaN values are stored so that the minimum and the maximum
+ * of a range of rows only needs to read the chunks at the borders of the range and chunks without values can be skipped.
+ *
+ * Layout of the file (native byte order for the values, little endian for the rest):
+ * \li header: magic "LPCC" and the format version (8 bytes)
+ * \li the values of the chunks of all columns, written in the order they were filled
+ * \li footer: rows per chunk, the columns with their names, row counts and the \c ChunkInfo of their chunks
+ * \li trailer: position of the footer, magic and version (16 bytes)
+ *
+ * Files are written with \c ColumnCacheFile::Writer, the values of the columns are appended block-wise
+ * so that data larger than the available memory can be converted.
+ *
+ * With \c fromMemory() the values of a column are read from memory owned by another library or application
+ * instead of a file, e.g. from a buffer handed over via the Arrow C data interface, without copying them.
+ */
+
+namespace {
+const char Magic[4] = {'L', 'P', 'C', 'C'};
+const quint32 Version = 1;
+const qint64 TrailerSize = 16;
+
+void summarize(ColumnCacheFile::ChunkInfo& info, const double* values) {
+	for (int i = 0; i < info.rows; ++i) {
+		const double value = values[i];
+		if (!std::isfinite(value)) {
+			++info.nanCount;
+			continue;
+		}
+		if (value < info.min)
+			info.min = value;
+		if (value > info.max)
+			info.max = value;
+	}
+}
+}
+
+ColumnCacheFile::Writer::Writer(const QString& fileName, int chunkRows)
+	: m_file(fileName)
+	, m_chunkRows(std::max(chunkRows, 1)) {
+}
+
+ColumnCacheFile::Writer::~Writer() {
+	if (m_file.isOpen())
+		m_file.close();
+}
+
+/*!
+ * creates the file and writes the header, returns \c false if the file couldn't be created.
+ */
+bool ColumnCacheFile::Writer::open() {
+	if (!m_file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+		m_errorString = i18n("Failed to create the file \"%1\": %2", m_file.fileName(), m_file.errorString());
+		return false;
+	}
+
+	QDataStream out(&m_file);
+	out.setByteOrder(QDataStream::LittleEndian);
+	out.writeRawData(Magic, sizeof(Magic));
+	out << Version;
+	return out.status() == QDataStream::Ok;
+}
+
+/*!
+ * adds a column with the name \c name, returns the index of the new column.
+ */
+int ColumnCacheFile::Writer::addColumn(const QString& name) {
+	Column column;
+	column.name = name;
+	column.buffer.reserve(m_chunkRows);
+	m_columns << column;
+	return m_columns.size() - 1;
+}
+
+/*!
+ * appends \c count values to the column \c column. Full chunks are written to the file immediately.
+ */
+bool ColumnCacheFile::Writer::append(int column, const double* values, qint64 count) {
+	if (column < 0 || column >= m_columns.size() || !m_file.isOpen())
+		return false;
+
+	auto& c = m_columns[column];
+	while (count > 0) {
+		const qint64 n = std::min(count, (qint64)(m_chunkRows - c.buffer.size()));
+		const auto size = c.buffer.size();
+		c.buffer.resize(size + n);
+		std::memcpy(c.buffer.data() + size, values, n * sizeof(double));
+		values += n;
+		count -= n;
+		c.rowCount += n;
+
+		if (c.buffer.size() == m_chunkRows && !writeChunk(c))
+			return false;
+	}
+
+	return true;
+}
+
+bool ColumnCacheFile::Writer::writeChunk(Column& column) {
+	if (column.buffer.isEmpty())
+		return true;
+
+	ChunkInfo info;
+	info.offset = m_file.pos();
+	info.rows = column.buffer.size();
+	summarize(info, column.buffer.constData());
+
+	const qint64 size = info.rows * (qint64)sizeof(double);
+	if (m_file.write(reinterpret_cast<const char*>(column.buffer.constData()), size) != size) {
+		m_errorString = i18n("Failed to write to the file \"%1\": %2", m_file.fileName(), m_file.errorString());
+		return false;
+	}
+
+	column.chunks << info;
+	column.buffer.resize(0);
+	return true;
+}
+
+/*!
+ * writes the remaining values, the footer and closes the file.
+ */
+bool ColumnCacheFile::Writer::finish() {
+	if (!m_file.isOpen())
+		return false;
+
+	for (auto& column : m_columns) {
+		if (!writeChunk(column))
+			return false;
+	}
+
+	const qint64 footerOffset = m_file.pos();
+	QDataStream out(&m_file);
+	out.setByteOrder(QDataStream::LittleEndian);
+	out << (qint32)m_chunkRows << (qint32)m_columns.size();
+	for (const auto& column : std::as_const(m_columns)) {
+		out << column.name << column.rowCount << (qint32)column.chunks.size();
+		for (const auto& info : column.chunks)
+			out << info.offset << (qint32)info.rows << (qint32)info.nanCount << info.min << info.max;
+	}
+
+	out << footerOffset;
+	out.writeRawData(Magic, sizeof(Magic));
+	out << Version;
+
+	const bool ok = (out.status() == QDataStream::Ok);
+	if (!ok)
+		m_errorString = i18n("Failed to write to the file \"%1\": %2", m_file.fileName(), m_file.errorString());
+	m_file.close();
+	return ok;
+}
+
+QString ColumnCacheFile::Writer::errorString() const {
+	return m_errorString;
+}
+
+/*!
+ * writes the numeric columns \c columns to the cache file \c fileName.
+ */
+bool ColumnCacheFile::write(const QString& fileName, const QVector<const AbstractColumn*>& columns, int chunkRows, QString* errorString) {
+	Writer writer(fileName, chunkRows);
+	bool ok = writer.open();
+
+	QVector<double> block(std::max(chunkRows, 1));
+	for (int i = 0; ok && i < columns.size(); ++i) {
+		const auto* column = columns.at(i);
+		const int index = writer.addColumn(column->name());
+		const int rows = column->rowCount();
+		for (int start = 0; ok && start < rows; start += block.size()) {
+			const int end = std::min(start + (int)block.size(), rows);
+			for (int row = start; row < end; ++row)
+				block[row - start] = column->valueAt(row);
+			ok = writer.append(index, block.constData(), end - start);
+		}
+	}
+
+	if (ok)
+		ok = writer.finish();
+	if (!ok && errorString)
+		*errorString = writer.errorString();
+	return ok;
+}
+
+/*!
+ * creates a column \c name with the \c rowCount values at \c values that stay in the memory of the caller.
+ * The summary of the chunks is determined here, the values are not copied. \c release is called
+ * when the returned object is deleted and the memory is not used anymore, e.g. to call the release callback
+ * of an Arrow array. The values must not be modified as long as they are used.
+ */
+std::shared_ptr<ColumnCacheFile>
+ColumnCacheFile::fromMemory(const QString& name, const double* values, qint64 rowCount, std::function<void()> release, int chunkRows) {
+	auto file = std::make_shared<ColumnCacheFile>(QString());
+	file->m_chunkRows = std::max(chunkRows, 1);
+	file->m_release = std::move(release);
+
+	Column column;
+	column.name = name;
+	column.rowCount = std::max(rowCount, (qint64)0);
+	column.base = reinterpret_cast<const uchar*>(values);
+	column.chunks.resize((column.rowCount + file->m_chunkRows - 1) / file->m_chunkRows);
+	const int chunkCount = column.chunks.size();
+	Parallel::forRanges(chunkCount, 1, [&](int start, int end) {
+		for (int i = start; i < end; ++i) {
+			auto& info = column.chunks[i];
+			const qint64 first = (qint64)i * file->m_chunkRows;
+			info.offset = first * (qint64)sizeof(double);
+			info.rows = static_cast<int>(std::min((qint64)file->m_chunkRows, column.rowCount - first));
+			summarize(info, values + first);
+		}
+	});
+	file->m_columns << column;
+
+	return file;
+}
+
+ColumnCacheFile::ColumnCacheFile(const QString& fileName)
+	: m_file(fileName) {
+}
+
+ColumnCacheFile::~ColumnCacheFile() {
+	if (m_map)
+		m_file.unmap(const_cast<uchar*>(m_map));
+	if (m_release)
+		m_release();
+}
+
+/*!
+ * reads the description of the columns and maps the file into memory, returns \c false if the file is not a valid cache file.
+ */
+bool ColumnCacheFile::open() {
+	if (!m_file.open(QIODevice::ReadOnly)) {
+		m_errorString = i18n("Failed to open the file \"%1\": %2", m_file.fileName(), m_file.errorString());
+		return false;
+	}
+
+	const qint64 size = m_file.size();
+	if (size < 8 + TrailerSize) {
+		m_errorString = i18n("\"%1\" is not a valid cache file.", m_file.fileName());
+		return false;
+	}
+
+	// trailer
+	QDataStream in(&m_file);
+	in.setByteOrder(QDataStream::LittleEndian);
+	m_file.seek(size - TrailerSize);
+	qint64 footerOffset;
+	char magic[4];
+	quint32 version;
+	in >> footerOffset;
+	in.readRawData(magic, sizeof(magic));
+	in >> version;
+	if (in.status() != QDataStream::Ok || std::memcmp(magic, Magic, sizeof(Magic)) != 0 || footerOffset < 8 || footerOffset > size - TrailerSize) {
+		m_errorString = i18n("\"%1\" is not a valid cache file.", m_file.fileName());
+		return false;
+	}
+	if (version > Version) {
+		m_errorString = i18n("The cache file \"%1\" was created with a newer version of LabPlot.", m_file.fileName());
+		return false;
+	}
+
+	// footer
+	m_file.seek(footerOffset);
+	qint32 chunkRows, columnCount;
+	in >> chunkRows >> columnCount;
+	m_chunkRows = chunkRows;
+	if (m_chunkRows <= 0)
+		in.setStatus(QDataStream::ReadCorruptData);
+	m_columns.clear();
+	for (int i = 0; i < columnCount && in.status() == QDataStream::Ok; ++i) {
+		Column column;
+		qint32 chunkCount;
+		in >> column.name >> column.rowCount >> chunkCount;
+		column.chunks.resize(std::max(chunkCount, 0));
+		qint64 rowCount = 0;
+		for (int chunk = 0; chunk < column.chunks.size(); ++chunk) {
+			auto& info = column.chunks[chunk];
+			qint32 rows, nanCount;
+			in >> info.offset >> rows >> nanCount >> info.min >> info.max;
+			info.rows = rows;
+			info.nanCount = nanCount;
+			rowCount += rows;
+			// the chunk of a row is determined by the number of rows per chunk, only the last chunk can have less rows
+			const bool lastChunk = (chunk == column.chunks.size() - 1);
+			if (rows <= 0 || rows > m_chunkRows || (!lastChunk && rows != m_chunkRows) || nanCount < 0 || nanCount > rows)
+				in.setStatus(QDataStream::ReadCorruptData);
+			else if (info.offset < 8 || info.offset % (qint64)sizeof(double) != 0 || info.offset > footerOffset
+					 || info.offset + info.rows * (qint64)sizeof(double) > footerOffset)
+				in.setStatus(QDataStream::ReadCorruptData);
+		}
+		if (column.rowCount != rowCount)
+			in.setStatus(QDataStream::ReadCorruptData);
+		m_columns << column;
+	}
+
+	if (in.status() != QDataStream::Ok) {
+		m_errorString = i18n("\"%1\" is not a valid cache file.", m_file.fileName());
+		m_columns.clear();
+		return false;
+	}
+
+	// map the whole file, the operating system only reads the pages of the chunks that are accessed
+	m_map = m_file.map(0, size);
+	if (!m_map) {
+		m_errorString = i18n("Failed to map the file \"%1\" into memory: %2", m_file.fileName(), m_file.errorString());
+		m_columns.clear();
+		return false;
+	}
+	for (auto& column : m_columns)
+		column.base = m_map;
+
+	DEBUG(Q_FUNC_INFO << ", columns = " << m_columns.size() << ", rows per chunk = " << m_chunkRows)
+	return true;
+}
+
+QString ColumnCacheFile::fileName() const {
+	return m_file.fileName();
+}
+
+/*!
+ * returns \c true if the values are read from memory owned by the caller of \c fromMemory() instead of a file.
+ */
+bool ColumnCacheFile::isExternalMemory() const {
+	return !m_map && !m_columns.isEmpty();
+}
+
+QString ColumnCacheFile::errorString() const {
+	return m_errorString;
+}
+
+int ColumnCacheFile::columnCount() const {
+	return m_columns.size();
+}
+
+QString ColumnCacheFile::columnName(int column) const {
+	return m_columns.at(column).name;
+}
+
+qint64 ColumnCacheFile::rowCount(int column) const {
+	return m_columns.at(column).rowCount;
+}
+
+int ColumnCacheFile::chunkRows() const {
+	return m_chunkRows;
+}
+
+int ColumnCacheFile::chunkCount(int column) const {
+	return m_columns.at(column).chunks.size();
+}
+
+const ColumnCacheFile::ChunkInfo& ColumnCacheFile::chunkInfo(int column, int chunk) const {
+	return m_columns.at(column).chunks.at(chunk);
+}
+
+/*!
+ * returns the values of the chunk \c chunk of the column \c column, \c chunkInfo().rows values are available.
+ */
+const double* ColumnCacheFile::chunkData(int column, int chunk) const {
+	const auto& c = m_columns.at(column);
+	return reinterpret_cast<const double*>(c.base + c.chunks.at(chunk).offset);
+}
+
+/*!
+ * returns all values of the column \c column if they are stored contiguously in memory, i.e. for columns
+ * created with \c fromMemory(), \c nullptr otherwise.
+ */
+const double* ColumnCacheFile::columnData(int column) const {
+	if (!isExternalMemory())
+		return nullptr;
+	return reinterpret_cast<const double*>(m_columns.at(column).base);
+}
+
+/*!
+ * returns the value in the row \c row of the column \c column, NAN if the row doesn't exist.
+ */
+double ColumnCacheFile::value(int column, qint64 row) const {
+	if (row < 0 || row >= m_columns.at(column).rowCount)
+		return NAN;
+
+	return chunkData(column, row / m_chunkRows)[row % m_chunkRows];
+}
+
+/*!
+ * copies \c count values of the column \c column starting with the row \c first to \c target.
+ */
+void ColumnCacheFile::copy(int column, qint64 first, qint64 count, double* target) const {
+	while (count > 0) {
+		const int chunk = first / m_chunkRows;
+		const int offset = first % m_chunkRows;
+		const qint64 n = std::min(count, (qint64)chunkInfo(column, chunk).rows - offset);
+		std::memcpy(target, chunkData(column, chunk) + offset, n * sizeof(double));
+		target += n;
+		first += n;
+		count -= n;
+	}
+}
+
+/*!
+ * determines the minimum and the maximum of the finite values in the rows [first, last] of the column \c column.
+ * Only the chunks at the borders of the range are read, the summary of the other chunks is used and chunks
+ * without finite values are skipped. \c min and \c max are INFINITY and -INFINITY if there is no finite value.
+ */
+void ColumnCacheFile::minMax(int column, qint64 first, qint64 last, double& min, double& max) const {
+	min = INFINITY;
+	max = -INFINITY;
+	first = std::max(first, (qint64)0);
+	last = std::min(last, rowCount(column) - 1);
+	if (first > last)
+		return;
+
+	const int firstChunk = first / m_chunkRows;
+	const int lastChunk = last / m_chunkRows;
+	for (int chunk = firstChunk; chunk <= lastChunk; ++chunk) {
+		const auto& info = chunkInfo(column, chunk);
+		if (info.nanCount == info.rows)
+			continue;
+
+		const qint64 chunkStart = (qint64)chunk * m_chunkRows;
+		const int start = (chunk == firstChunk) ? first - chunkStart : 0;
+		const int end = (chunk == lastChunk) ? last - chunkStart : info.rows - 1;
+		if (start == 0 && end == info.rows - 1) {
+			min = std::min(min, info.min);
+			max = std::max(max, info.max);
+			continue;
+		}
+
+		const double* data = chunkData(column, chunk);
+		for (int i = start; i <= end; ++i) {
+			const double value = data[i];
+			if (!std::isfinite(value))
+				continue;
+			if (value < min)
+				min = value;
+			if (value > max)
+				max = value;
+		}
+	}
+}
@@ -0,0 +1,103 @@
+/*
+	File                 : ColumnCacheFile.h
+	Project              : LabPlot
+	Description          : Memory-mapped file with the values of columns stored in chunks
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef COLUMNCACHEFILE_H
+#define COLUMNCACHEFILE_H
+
+#include <QFile>
+#include <QString>
+#include <QVector>
+
+#include <cmath>
+#include <functional>
+#include <memory>
+
+class AbstractColumn;
+
+class ColumnCacheFile {
+public:
+	static constexpr int DefaultChunkRows = 65536;
+
+	//! location and summary of the values of one chunk
+	struct ChunkInfo {
+		qint64 offset{0}; // position of the first value in the file
+		int rows{0};
+		int nanCount{0}; // number of NaN and infinite values
+		double min{INFINITY}; // minimum of the finite values
+		double max{-INFINITY}; // maximum of the finite values
+	};
+
+	class Writer {
+	public:
+		explicit Writer(const QString& fileName, int chunkRows = DefaultChunkRows);
+		~Writer();
+
+		bool open();
+		int addColumn(const QString& name);
+		bool append(int column, const double* values, qint64 count);
+		bool finish();
+		QString errorString() const;
+
+	private:
+		struct Column {
+			QString name;
+			qint64 rowCount{0};
+			QVector<double> buffer;
+			QVector<ChunkInfo> chunks;
+		};
+		bool writeChunk(Column&);
+
+		QFile m_file;
+		int m_chunkRows;
+		QVector<Column> m_columns;
+		QString m_errorString;
+	};
+
+	static bool write(const QString& fileName, const QVector<const AbstractColumn*>&, int chunkRows = DefaultChunkRows, QString* errorString = nullptr);
+	static std::shared_ptr<ColumnCacheFile>
+	fromMemory(const QString& name, const double* values, qint64 rowCount, std::function<void()> release, int chunkRows = DefaultChunkRows);
+
+	explicit ColumnCacheFile(const QString& fileName);
+	~ColumnCacheFile();
+
+	bool open();
+	QString fileName() const;
+	bool isExternalMemory() const;
+	QString errorString() const;
+
+	int columnCount() const;
+	QString columnName(int column) const;
+	qint64 rowCount(int column) const;
+	int chunkRows() const;
+	int chunkCount(int column) const;
+	const ChunkInfo& chunkInfo(int column, int chunk) const;
+	const double* chunkData(int column, int chunk) const;
+	const double* columnData(int column) const;
+
+	double value(int column, qint64 row) const;
+	void copy(int column, qint64 first, qint64 count, double* target) const;
+	void minMax(int column, qint64 first, qint64 last, double& min, double& max) const;
+
+private:
+	struct Column {
+		QString name;
+		qint64 rowCount{0};
+		QVector<ChunkInfo> chunks;
+		const uchar* base{nullptr}; // start of the mapped file or of the external memory, the offsets of the chunks are relative to it
+	};
+
+	QFile m_file;
+	const uchar* m_map{nullptr};
+	std::function<void()> m_release; // releases the external memory
+	int m_chunkRows{DefaultChunkRows};
+	QVector<Column> m_columns;
+	QString m_errorString;
+};
+
+#endif // COLUMNCACHEFILE_H
@@ -12,9 +12,12 @@
 
 #include "ColumnPrivate.h"
 #include "Column.h"
+#include "ColumnCacheFile.h"
 #include "ColumnStringIO.h"
 #include "backend/core/datatypes/filter.h"
 #include "backend/gsl/ExpressionParser.h"
+#include "backend/lib/Parallel.h"
+#include "backend/lib/ParallelSort.h"
 #include "backend/lib/trace.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
@@ -24,8 +27,8 @@
 
 #include "functions.h"
 
+#include <algorithm>
 #include <array>
-#include <unordered_map>
 
 namespace {
 template<typename T>
@@ -776,6 +779,24 @@ ColumnPrivate::ColumnPrivate(Column* owner, AbstractColumn::ColumnMode mode, voi
  * with the existing content where the memory was already allocated.
  */
 bool ColumnPrivate::initDataContainer(bool resize) {
+	if (m_cacheFile) {
+		// the values are loaded from the cache file into memory, e.g. before they are modified
+		auto file = std::move(m_cacheFile);
+		if (m_columnMode == AbstractColumn::ColumnMode::Double && resize) {
+			auto* vec = new QVector<double>();
+			try {
+				vec->resize(m_rowCount);
+			} catch (std::bad_alloc&) {
+				delete vec;
+				m_cacheFile = std::move(file);
+				return false;
+			}
+			file->copy(m_cacheFileColumn, 0, m_rowCount, vec->data());
+			m_data = vec;
+			return true;
+		}
+	}
+
 	switch (m_columnMode) {
 	case AbstractColumn::ColumnMode::Double: {
 		auto* vec = new QVector<double>();
@@ -817,7 +838,7 @@ bool ColumnPrivate::initDataContainer(bool resize) {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day: {
-		auto* vec = new QVector<QDateTime>();
+		auto* vec = new DateTimeVector();
 		try {
 			if (resize)
 				vec->resize(m_rowCount);
@@ -879,6 +900,7 @@ ColumnPrivate::~ColumnPrivate() {
 }
 
 void ColumnPrivate::deleteData() {
+	m_cacheFile.reset();
 	if (!m_data)
 		return;
 
@@ -898,7 +920,7 @@ void ColumnPrivate::deleteData() {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
-		delete static_cast<QVector<QDateTime>*>(m_data);
+		delete static_cast<DateTimeVector*>(m_data);
 		break;
 	}
 	m_data = nullptr;
@@ -921,6 +943,9 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 	if (mode == m_columnMode)
 		return;
 
+	if (m_cacheFile && !initDataContainer())
+		return; // failed to allocate memory
+
 	void* old_data = m_data;
 	// remark: the deletion of the old data will be done in the dtor of a command
 
@@ -966,7 +991,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<double>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		case AbstractColumn::ColumnMode::Month:
@@ -974,7 +999,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<double>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		case AbstractColumn::ColumnMode::Day:
@@ -982,7 +1007,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<double>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		} // switch(mode)
@@ -1024,7 +1049,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<int>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			DEBUG(Q_FUNC_INFO << ", int -> datetime done")
 			break;
@@ -1033,7 +1058,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<int>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		case AbstractColumn::ColumnMode::Day:
@@ -1041,7 +1066,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<int>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		} // switch(mode)
@@ -1082,7 +1107,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<qint64>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		case AbstractColumn::ColumnMode::Month:
@@ -1090,7 +1115,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<qint64>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		case AbstractColumn::ColumnMode::Day:
@@ -1098,7 +1123,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<qint64>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		} // switch(mode)
@@ -1141,7 +1166,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<QString>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		case AbstractColumn::ColumnMode::Month:
@@ -1149,7 +1174,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<QString>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		case AbstractColumn::ColumnMode::Day:
@@ -1157,7 +1182,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter_is_temporary = true;
 			if (m_data) {
 				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<QString>*>(old_data)));
-				m_data = new QVector<QDateTime>();
+				m_data = new DateTimeVector();
 			}
 			break;
 		} // switch(mode)
@@ -1177,7 +1202,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 			filter = outputFilter();
 			filter_is_temporary = false;
 			if (m_data) {
-				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<QDateTime>*>(old_data)), m_columnMode);
+				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<DateTimeVector*>(old_data)), m_columnMode);
 				m_data = new QStringList();
 			}
 			break;
@@ -1190,7 +1215,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 				filter = new DateTime2DoubleFilter();
 			filter_is_temporary = true;
 			if (m_data) {
-				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<QDateTime>*>(old_data)), m_columnMode);
+				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<DateTimeVector*>(old_data)), m_columnMode);
 				m_data = new QVector<double>();
 			}
 			break;
@@ -1203,7 +1228,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 				filter = new DateTime2IntegerFilter();
 			filter_is_temporary = true;
 			if (m_data) {
-				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<QDateTime>*>(old_data)), m_columnMode);
+				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<DateTimeVector*>(old_data)), m_columnMode);
 				m_data = new QVector<int>();
 			}
 			break;
@@ -1216,7 +1241,7 @@ void ColumnPrivate::setColumnMode(AbstractColumn::ColumnMode mode) {
 				filter = new DateTime2BigIntFilter();
 			filter_is_temporary = true;
 			if (m_data) {
-				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<QVector<QDateTime>*>(old_data)), m_columnMode);
+				temp_col = new Column(QStringLiteral("temp_col"), *(static_cast<DateTimeVector*>(old_data)), m_columnMode);
 				m_data = new QVector<qint64>();
 			}
 			break;
@@ -1354,6 +1379,7 @@ void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void* data,
 		break;
 	}
 
+	invalidate();
 	Q_EMIT q->modeChanged(q);
 }
 
@@ -1363,6 +1389,7 @@ void ColumnPrivate::replaceModeData(AbstractColumn::ColumnMode mode, void* data,
 void ColumnPrivate::replaceData(void* data) {
 	Q_EMIT q->dataAboutToChange(q);
 
+	m_cacheFile.reset();
 	m_data = data;
 	q->setChanged();
 }
@@ -1419,7 +1446,7 @@ bool ColumnPrivate::copy(const AbstractColumn* other) {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day: {
-		auto* vec = static_cast<QVector<QDateTime>*>(m_data);
+		auto* vec = static_cast<DateTimeVector*>(m_data);
 		for (int i = 0; i < num_rows; ++i)
 			vec->replace(i, other->dateTimeAt(i));
 		break;
@@ -1485,7 +1512,7 @@ bool ColumnPrivate::copy(const AbstractColumn* source, int source_start, int des
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
 		for (int i = 0; i < num_rows; i++)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(dest_start + i, source->dateTimeAt(source_start + i));
+			static_cast<DateTimeVector*>(m_data)->replace(dest_start + i, source->dateTimeAt(source_start + i));
 		break;
 	}
 
@@ -1542,7 +1569,7 @@ bool ColumnPrivate::copy(const ColumnPrivate* other) {
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
 		for (int i = 0; i < num_rows; ++i)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(i, other->dateTimeAt(i));
+			static_cast<DateTimeVector*>(m_data)->replace(i, other->dateTimeAt(i));
 		break;
 	}
 
@@ -1604,7 +1631,7 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
 		for (int i = 0; i < num_rows; ++i)
-			static_cast<QVector<QDateTime>*>(m_data)->replace(dest_start + i, source->dateTimeAt(source_start + i));
+			static_cast<DateTimeVector*>(m_data)->replace(dest_start + i, source->dateTimeAt(source_start + i));
 		break;
 	}
 
@@ -1613,6 +1640,167 @@ bool ColumnPrivate::copy(const ColumnPrivate* source, int source_start, int dest
 	return true;
 }
 
+/*!
+ * determines the rows with values different from the values in \c other, \c other needs to have the same mode and number of rows.
+ * The rows are returned in \c rows as intervals of consecutive rows.
+ * Returns \c false if the columns can't be compared or if more than \c maxRows rows are different.
+ */
+bool ColumnPrivate::changedRows(const AbstractColumn* other, int maxRows, QVector<Interval<int>>& rows) const {
+	rows.clear();
+	const int count = rowCount();
+	if (!m_data || other->columnMode() != m_columnMode || other->rowCount() != count)
+		return false;
+
+	int changed = 0;
+	const auto findRows = [&](auto differs) {
+		int row = 0;
+		while (row < count) {
+			if (!differs(row)) {
+				++row;
+				continue;
+			}
+			const int start = row;
+			while (row < count && differs(row))
+				++row;
+			rows << Interval<int>(start, row - 1);
+			changed += row - start;
+			if (changed > maxRows)
+				return false;
+		}
+		return true;
+	};
+
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double: {
+		const double* data = static_cast<QVector<double>*>(m_data)->constData();
+		return findRows([&](int row) {
+			const double value = other->valueAt(row);
+			return data[row] != value && !(std::isnan(data[row]) && std::isnan(value));
+		});
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		const int* data = static_cast<QVector<int>*>(m_data)->constData();
+		return findRows([&](int row) {
+			return data[row] != other->integerAt(row);
+		});
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		const qint64* data = static_cast<QVector<qint64>*>(m_data)->constData();
+		return findRows([&](int row) {
+			return data[row] != other->bigIntAt(row);
+		});
+	}
+	case AbstractColumn::ColumnMode::Text: {
+		const QString* data = static_cast<QVector<QString>*>(m_data)->constData();
+		return findRows([&](int row) {
+			return data[row] != other->textAt(row);
+		});
+	}
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day: {
+		const auto* data = static_cast<DateTimeVector*>(m_data);
+		return findRows([&](int row) {
+			const auto dateTime = other->dateTimeAt(row);
+			if (!dateTime.isValid())
+				return data->isValid(row);
+			return !data->isValid(row) || data->msecsAt(row) != dateTime.toMSecsSinceEpoch();
+		});
+	}
+	}
+
+	return false;
+}
+
+/*!
+ * exchanges the values in the rows \c rows with the values in \c other, where the values of all intervals
+ * are stored one after another starting at the first row of \c other.
+ * Used in the undo commands that only keep the values of the changed rows instead of a copy of the whole column.
+ */
+bool ColumnPrivate::swapRows(ColumnPrivate* other, const QVector<Interval<int>>& rows) {
+	if (other->columnMode() != m_columnMode)
+		return false;
+	if (rows.isEmpty())
+		return true;
+
+	if (!m_data) {
+		if (!initDataContainer())
+			return false; // failed to allocate memory
+	}
+	if (!other->m_data) {
+		if (!other->initDataContainer())
+			return false;
+	}
+
+	Q_EMIT q->dataAboutToChange(q);
+
+	const auto swap = [&rows](auto* data, auto* otherData) {
+		qsizetype offset = 0;
+		for (const auto& interval : rows) {
+			std::swap_ranges(data + interval.start(), data + interval.end() + 1, otherData + offset);
+			offset += interval.size();
+		}
+	};
+
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		swap(static_cast<QVector<double>*>(m_data)->data(), static_cast<QVector<double>*>(other->m_data)->data());
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		swap(static_cast<QVector<int>*>(m_data)->data(), static_cast<QVector<int>*>(other->m_data)->data());
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		swap(static_cast<QVector<qint64>*>(m_data)->data(), static_cast<QVector<qint64>*>(other->m_data)->data());
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		swap(static_cast<QVector<QString>*>(m_data)->data(), static_cast<QVector<QString>*>(other->m_data)->data());
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		swap(static_cast<DateTimeVector*>(m_data)->data(), static_cast<DateTimeVector*>(other->m_data)->data());
+		break;
+	}
+
+	invalidate(rows.constFirst().start(), rows.constLast().end());
+	other->invalidate();
+	if (!m_suppressDataChangedSignal)
+		Q_EMIT q->dataChanged(q);
+
+	return true;
+}
+
+/*!
+ * reorders the first \c permutation.size() rows, see \c ParallelSort::permute(). No signals are emitted and the cached
+ * properties are not invalidated, so this can be called for several columns in parallel. \c setChanged() has to be called afterwards.
+ */
+void ColumnPrivate::permuteRows(const std::vector<int>& permutation, bool inverse) {
+	if (permutation.empty() || (int)permutation.size() > rowCount())
+		return;
+	if ((m_cacheFile || !m_data) && !initDataContainer())
+		return; // failed to allocate memory
+
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+		ParallelSort::permute(static_cast<QVector<double>*>(m_data)->data(), permutation, inverse);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		ParallelSort::permute(static_cast<QVector<int>*>(m_data)->data(), permutation, inverse);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		ParallelSort::permute(static_cast<QVector<qint64>*>(m_data)->data(), permutation, inverse);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		ParallelSort::permute(static_cast<QVector<QString>*>(m_data)->data(), permutation, inverse);
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		ParallelSort::permute(static_cast<DateTimeVector*>(m_data)->data(), permutation, inverse);
+		break;
+	}
+}
+
 /**
  * \brief Return the data vector size
  *
@@ -1632,7 +1820,7 @@ int ColumnPrivate::rowCount() const {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
-		return static_cast<QVector<QDateTime>*>(m_data)->size();
+		return static_cast<DateTimeVector*>(m_data)->size();
 	case AbstractColumn::ColumnMode::Text:
 		return static_cast<QVector<QString>*>(m_data)->size();
 	}
@@ -1673,10 +1861,9 @@ int ColumnPrivate::rowCount(double min, double max) const {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day: {
-		const auto* data = static_cast<QVector<QDateTime>*>(m_data);
-		for (const auto& d : *data) {
-			const auto value = d.toMSecsSinceEpoch();
-			if (value >= min && value <= max)
+		const auto* data = static_cast<DateTimeVector*>(m_data);
+		for (const auto value : data->msecs()) {
+			if (value != DateTimeVector::InvalidValue && value >= min && value <= max)
 				counter++;
 		}
 		break;
@@ -1725,6 +1912,9 @@ void ColumnPrivate::resizeTo(int new_size) {
 	// 	DEBUG("ColumnPrivate::resizeTo() " << old_size << " -> " << new_size);
 	const int new_rows = new_size - old_size;
 
+	if (m_cacheFile && !initDataContainer())
+		return; // failed to allocate memory
+
 	if (!m_data) {
 		m_rowCount += new_rows;
 		return;
@@ -1766,16 +1956,20 @@ void ColumnPrivate::resizeTo(int new_size) {
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day: {
-		auto* data = static_cast<QVector<QDateTime>*>(m_data);
+		auto* data = static_cast<DateTimeVector*>(m_data);
 		if (new_rows > 0)
-			data->insert(data->end(), new_rows, QDateTime());
+			data->insert(data->size(), new_rows, QDateTime());
 		else
 			data->remove(old_size - 1 + new_rows, -new_rows);
 		break;
 	}
 	}
 
-	invalidate();
+	// the cached values of the rows before appended rows stay valid
+	if (new_rows > 0)
+		invalidate(old_size, new_size - 1);
+	else
+		invalidate();
 }
 
 /**
@@ -1787,6 +1981,9 @@ void ColumnPrivate::insertRows(int before, int count) {
 
 	m_formulas.insertRows(before, count);
 
+	if (m_cacheFile && !initDataContainer())
+		return; // failed to allocate memory
+
 	if (!m_data) {
 		m_rowCount += count;
 		return;
@@ -1806,8 +2003,7 @@ void ColumnPrivate::insertRows(int before, int count) {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			for (int i = 0; i < count; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->insert(before, QDateTime());
+			static_cast<DateTimeVector*>(m_data)->insert(before, count, QDateTime());
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			for (int i = 0; i < count; ++i)
@@ -1833,6 +2029,9 @@ void ColumnPrivate::removeRows(int first, int count) {
 		if (first + count > rowCount())
 			corrected_count = rowCount() - first;
 
+		if (m_cacheFile && !initDataContainer())
+			return; // failed to allocate memory
+
 		if (!m_data) {
 			m_rowCount -= corrected_count;
 			return;
@@ -1851,8 +2050,7 @@ void ColumnPrivate::removeRows(int first, int count) {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			for (int i = 0; i < corrected_count; ++i)
-				static_cast<QVector<QDateTime>*>(m_data)->removeAt(first);
+			static_cast<DateTimeVector*>(m_data)->remove(first, corrected_count);
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			for (int i = 0; i < corrected_count; ++i)
@@ -1931,6 +2129,33 @@ void* ColumnPrivate::data() const {
 	return m_data;
 }
 
+/*!
+ * uses the values of the column \c column in the cache file \c file instead of keeping them in memory.
+ * The values are read from the memory-mapped file on demand, they are loaded into memory
+ * when the column is modified or when \c data() is called.
+ */
+bool ColumnPrivate::setCacheFile(std::shared_ptr<ColumnCacheFile> file, int column) {
+	if (!file || m_columnMode != AbstractColumn::ColumnMode::Double || column < 0 || column >= file->columnCount()
+		|| file->rowCount(column) > std::numeric_limits<int>::max())
+		return false;
+
+	Q_EMIT q->dataAboutToChange(q);
+	deleteData();
+	m_cacheFile = std::move(file);
+	m_cacheFileColumn = column;
+	m_rowCount = static_cast<int>(m_cacheFile->rowCount(column));
+	q->setChanged();
+	return true;
+}
+
+const std::shared_ptr<ColumnCacheFile>& ColumnPrivate::cacheFile() const {
+	return m_cacheFile;
+}
+
+int ColumnPrivate::cacheFileColumn() const {
+	return m_cacheFileColumn;
+}
+
 /**
  * \brief Return the input filter (for string -> data type conversion)
  */
@@ -2556,12 +2781,12 @@ QDateTime ColumnPrivate::dateTimeAt(int row) const {
 		|| (m_columnMode != AbstractColumn::ColumnMode::DateTime && m_columnMode != AbstractColumn::ColumnMode::Month
 			&& m_columnMode != AbstractColumn::ColumnMode::Day))
 		return QDateTime();
-	return static_cast<QVector<QDateTime>*>(m_data)->value(row);
+	return static_cast<DateTimeVector*>(m_data)->value(row);
 }
 
 double ColumnPrivate::doubleAt(int index) const {
 	if (!m_data)
-		return NAN;
+		return m_cacheFile ? m_cacheFile->value(m_cacheFileColumn, index) : NAN;
 
 	return static_cast<QVector<double>*>(m_data)->value(index, NAN);
 }
@@ -2573,7 +2798,7 @@ double ColumnPrivate::doubleAt(int index) const {
  */
 double ColumnPrivate::valueAt(int index) const {
 	if (!m_data)
-		return NAN;
+		return m_cacheFile ? m_cacheFile->value(m_cacheFileColumn, index) : NAN;
 
 	switch (m_columnMode) {
 	case AbstractColumn::ColumnMode::Double:
@@ -2582,8 +2807,13 @@ double ColumnPrivate::valueAt(int index) const {
 		return static_cast<QVector<int>*>(m_data)->value(index, 0);
 	case AbstractColumn::ColumnMode::BigInt:
 		return static_cast<QVector<qint64>*>(m_data)->value(index, 0);
-	case AbstractColumn::ColumnMode::DateTime:
-		return static_cast<QVector<QDateTime>*>(m_data)->value(index).toMSecsSinceEpoch();
+	case AbstractColumn::ColumnMode::DateTime: {
+		// invalid date-times are 0 like QDateTime::toMSecsSinceEpoch() of an invalid date-time
+		const auto* data = static_cast<DateTimeVector*>(m_data);
+		if (index < 0 || index >= data->size() || !data->isValid(index))
+			return 0;
+		return data->msecsAt(index);
+	}
 	case AbstractColumn::ColumnMode::Month: // Fall through
 	case AbstractColumn::ColumnMode::Day: // Fall through
 	case AbstractColumn::ColumnMode::Text: // Fall through
@@ -2612,6 +2842,121 @@ qint64 ColumnPrivate::bigIntAt(int row) const {
 
 void ColumnPrivate::invalidate() {
 	available.setUnavailable();
+	m_minMaxIndex.clear();
+	m_minMaxIndexFirst = INT_MAX;
+	m_minMaxIndexLast = -1;
+	m_moments = Moments();
+	m_momentsRowCount = 0;
+	m_monotonicityIndex.clear();
+	m_monotonicityIndexFirst = INT_MAX;
+	m_monotonicityIndexLast = -1;
+}
+
+/*!
+ * invalidates the cached values after the values in the rows [first, last] were changed.
+ * Contrary to \c invalidate(), the min/max and the monotonicity indices are kept and only the changed rows are updated on their next usage.
+ * The moments used in the statistics are kept if only rows behind them were changed, e.g. when rows were appended.
+ */
+void ColumnPrivate::invalidate(int first, int last) {
+	available.setUnavailable();
+	m_minMaxIndexFirst = std::min(m_minMaxIndexFirst, first);
+	m_minMaxIndexLast = std::max(m_minMaxIndexLast, last);
+	m_monotonicityIndexFirst = std::min(m_monotonicityIndexFirst, first);
+	m_monotonicityIndexLast = std::max(m_monotonicityIndexLast, last);
+	if (first < m_momentsRowCount) {
+		m_moments = Moments();
+		m_momentsRowCount = 0;
+	}
+}
+
+/*!
+ * determines the minimum and the maximum of the valid and not masked values in the rows [startIndex, endIndex]
+ * with the help of the min/max index. The index is built on the first call and updated for the rows changed since then.
+ * Returns \c false if the column is too small or has no numeric values, the rows need to be iterated in this case.
+ */
+bool ColumnPrivate::indexedMinMax(int startIndex, int endIndex, double& min, double& max) {
+	// scanning small columns is faster than building the index
+	static const int minRowCount = 4096;
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double:
+	case AbstractColumn::ColumnMode::Integer:
+	case AbstractColumn::ColumnMode::BigInt:
+	case AbstractColumn::ColumnMode::DateTime:
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		return false;
+	}
+
+	if (m_cacheFile) {
+		// use the summary of the chunks in the cache file
+		if (m_masking.isEmpty()) {
+			m_cacheFile->minMax(m_cacheFileColumn, startIndex, endIndex, min, max);
+			return true;
+		}
+
+		// combine the min/max of the runs of unmasked rows
+		min = INFINITY;
+		max = -INFINITY;
+		const int last = std::min(endIndex, m_rowCount - 1);
+		int row = m_masking.nextUnset(startIndex);
+		while (row <= last) {
+			const int runEnd = std::min(m_masking.nextSet(row) - 1, last);
+			double runMin, runMax;
+			m_cacheFile->minMax(m_cacheFileColumn, row, runEnd, runMin, runMax);
+			min = std::min(min, runMin);
+			max = std::max(max, runMax);
+			row = m_masking.nextUnset(runEnd + 1);
+		}
+		return true;
+	}
+
+	const int rows = rowCount();
+	if (!m_data || rows < minRowCount)
+		return false;
+
+	const auto value = [this](int row) {
+		return minMaxIndexValue(row);
+	};
+	if (!m_minMaxIndex.isBuilt())
+		m_minMaxIndex.build(rows, value);
+	else if (m_minMaxIndexFirst <= m_minMaxIndexLast || m_minMaxIndex.rowCount() != rows)
+		m_minMaxIndex.update(m_minMaxIndexFirst, m_minMaxIndexLast, rows, value);
+	m_minMaxIndexFirst = INT_MAX;
+	m_minMaxIndexLast = -1;
+
+	m_minMaxIndex.minMax(startIndex, endIndex, value, min, max);
+	return true;
+}
+
+/*!
+ * value of the row \c row used in the min/max index, NAN for invalid and masked rows.
+ */
+double ColumnPrivate::minMaxIndexValue(int row) const {
+	if (m_masking.isSet(row))
+		return NAN;
+
+	switch (m_columnMode) {
+	case AbstractColumn::ColumnMode::Double: {
+		const double value = static_cast<QVector<double>*>(m_data)->at(row);
+		return std::isfinite(value) ? value : NAN;
+	}
+	case AbstractColumn::ColumnMode::Integer:
+		return static_cast<QVector<int>*>(m_data)->at(row);
+	case AbstractColumn::ColumnMode::BigInt:
+		return static_cast<QVector<qint64>*>(m_data)->at(row);
+	case AbstractColumn::ColumnMode::DateTime: {
+		const auto* data = static_cast<DateTimeVector*>(m_data);
+		return data->isValid(row) ? data->msecsAt(row) : NAN;
+	}
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+
+	return NAN;
 }
 
 /**
@@ -2642,17 +2987,12 @@ int ColumnPrivate::dictionaryIndex(int row) const {
 	if (!available.dictionary)
 		const_cast<ColumnPrivate*>(this)->initDictionary();
 
-	const auto& value = textAt(row);
-	int index = 0;
-	auto it = m_dictionary.constBegin();
-	while (it != m_dictionary.constEnd()) {
-		if (*it == value)
-			break;
-		++index;
-		++it;
-	}
+	// empty strings are not part of the dictionary, their index is the size of the dictionary
+	const auto code = m_dictionary.code(row);
+	if (code == TextDictionary::EmptyCode)
+		return m_dictionary.size();
 
-	return index;
+	return static_cast<int>(code);
 }
 
 const QMap<QString, int>& ColumnPrivate::frequencies() const {
@@ -2662,25 +3002,33 @@ const QMap<QString, int>& ColumnPrivate::frequencies() const {
 	return m_dictionaryFrequencies;
 }
 
-void ColumnPrivate::initDictionary() {
+/*!
+ * returns the dictionary encoding of the text values, the dictionary is (re-)built if the values were changed.
+ */
+const TextDictionary& ColumnPrivate::dictionary() const {
+	if (!available.dictionary)
+		const_cast<ColumnPrivate*>(this)->initDictionary();
+
+	return m_dictionary;
+}
+
+/*!
+ * builds the dictionary and lets equal strings share their data, this reduces the memory needed for categorical data.
+ * Contrary to the lazy creation of the dictionary, this modifies the stored strings and is only called when
+ * no other thread is accessing the values, e.g. at the end of the import.
+ */
+void ColumnPrivate::encodeTexts() {
+	initDictionary(true);
+}
+
+void ColumnPrivate::initDictionary(bool intern) {
 	m_dictionary.clear();
 	m_dictionaryFrequencies.clear();
 	if (!m_data || columnMode() != AbstractColumn::ColumnMode::Text)
 		return;
 
-	auto data = static_cast<QVector<QString>*>(m_data);
-	for (auto& value : *data) {
-		if (value.isEmpty())
-			continue;
-
-		if (!m_dictionary.contains(value))
-			m_dictionary << value;
-
-		if (m_dictionaryFrequencies.constFind(value) == m_dictionaryFrequencies.constEnd())
-			m_dictionaryFrequencies[value] = 1;
-		else
-			m_dictionaryFrequencies[value]++;
-	}
+	m_dictionary.build(*static_cast<QVector<QString>*>(m_data), intern);
+	m_dictionaryFrequencies = m_dictionary.frequencies();
 
 	available.dictionary = true;
 }
@@ -2793,7 +3141,12 @@ void ColumnPrivate::replaceValues(int first, const QVector<double>& new_values)
 			ptr[first + i] = new_values.at(i);
 	}
 
-	q->setChanged();
+	if (first < 0)
+		invalidate();
+	else
+		invalidate(first, first + new_values.size() - 1);
+	if (!m_suppressDataChangedSignal)
+		Q_EMIT q->dataChanged(q);
 }
 
 void ColumnPrivate::addValueLabel(const QString& value, const QString& label) {
@@ -2872,171 +3225,90 @@ void ColumnPrivate::replaceBigInt(int first, const QVector<qint64>& new_values)
  * Updates the properties. Will be called, when data in the column changed.
  * The properties will be used to speed up some algorithms.
  * See where variable properties will be used.
+ *
+ * The monotonicity is determined with the help of the monotonicity index. The index is built on the first call
+ * and only the rows changed since then are compared on the next calls, e.g. only the rows appended to a live data column.
  */
 void ColumnPrivate::updateProperties() {
 	PERFTRACE(name() + QLatin1String(Q_FUNC_INFO));
 
 	// TODO: for double Properties::Constant will never be used. Use an epsilon (difference smaller than epsilon is zero)
 	const int rows = rowCount();
-	if (rows == 0 || m_columnMode == AbstractColumn::ColumnMode::Text) {
-		properties = AbstractColumn::Properties::No;
-		available.properties = true;
-		return;
-	}
-
-	double prevValue = NAN;
-	int prevValueInt = 0;
-	qint64 prevValueBigInt = 0;
-	qint64 prevValueDatetime = 0;
-
-	if (m_columnMode == AbstractColumn::ColumnMode::Integer)
-		prevValueInt = integerAt(0);
-	else if (m_columnMode == AbstractColumn::ColumnMode::BigInt)
-		prevValueBigInt = bigIntAt(0);
-	else if (m_columnMode == AbstractColumn::ColumnMode::Double)
-		prevValue = doubleAt(0);
-	else if (m_columnMode == AbstractColumn::ColumnMode::DateTime || m_columnMode == AbstractColumn::ColumnMode::Month
-			 || m_columnMode == AbstractColumn::ColumnMode::Day)
-		prevValueDatetime = dateTimeAt(0).toMSecsSinceEpoch();
-	else {
+	if (rows == 0 || (!m_data && !m_cacheFile) || m_columnMode == AbstractColumn::ColumnMode::Text) {
 		properties = AbstractColumn::Properties::No;
 		available.properties = true;
 		return;
 	}
 
-	int monotonic_decreasing = -1;
-	int monotonic_increasing = -1;
-
-	double value;
-	int valueInt;
-	qint64 valueBigInt;
-	qint64 valueDateTime;
-	for (int row = 1; row < rows; row++) {
-		if (!q->isValid(row) || q->isMasked(row)) {
-			// if there is one invalid or masked value, the property is No, because
-			// otherwise it's difficult to find the correct index in indexForValue().
-			// You don't know if you should increase the index or decrease it when
-			// you hit an invalid value
-			properties = AbstractColumn::Properties::No;
-			available.properties = true;
-			return;
-		}
-
+	// if there is one invalid or masked value, the property is No, because
+	// otherwise it's difficult to find the correct index in indexForValue().
+	// You don't know if you should increase the index or decrease it when
+	// you hit an invalid value
+	const auto updateIndex = [&](auto compare, auto valid) {
+		if (!m_monotonicityIndex.isBuilt())
+			m_monotonicityIndex.build(rows, compare, valid);
+		else if (m_monotonicityIndexFirst <= m_monotonicityIndexLast || m_monotonicityIndex.rowCount() != rows)
+			m_monotonicityIndex.update(m_monotonicityIndexFirst, m_monotonicityIndexLast, rows, compare, valid);
+		m_monotonicityIndexFirst = INT_MAX;
+		m_monotonicityIndexLast = -1;
+	};
+	const auto compareValues = [](auto a, auto b) {
+		return (a > b) - (a < b);
+	};
+	const auto notMasked = [this](int row) {
+		return !m_masking.isSet(row);
+	};
+
+	if (m_cacheFile) {
+		updateIndex(
+			[&](int a, int b) {
+				return compareValues(m_cacheFile->value(m_cacheFileColumn, a), m_cacheFile->value(m_cacheFileColumn, b));
+			},
+			[&](int row) {
+				return std::isfinite(m_cacheFile->value(m_cacheFileColumn, row)) && notMasked(row);
+			});
+	} else {
 		switch (m_columnMode) {
-		case AbstractColumn::ColumnMode::Integer: {
-			valueInt = integerAt(row);
-
-			if (valueInt > prevValueInt) {
-				monotonic_decreasing = 0;
-				if (monotonic_increasing < 0)
-					monotonic_increasing = 1;
-				else if (monotonic_increasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else if (valueInt < prevValueInt) {
-				monotonic_increasing = 0;
-				if (monotonic_decreasing < 0)
-					monotonic_decreasing = 1;
-				else if (monotonic_decreasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else {
-				if (monotonic_increasing < 0 && monotonic_decreasing < 0) {
-					monotonic_decreasing = 1;
-					monotonic_increasing = 1;
-				}
-			}
-
-			prevValueInt = valueInt;
+		case AbstractColumn::ColumnMode::Double: {
+			const auto* data = static_cast<QVector<double>*>(m_data)->constData();
+			updateIndex(
+				[&](int a, int b) {
+					return compareValues(data[a], data[b]);
+				},
+				[&](int row) {
+					return std::isfinite(data[row]) && notMasked(row);
+				});
 			break;
 		}
-		case AbstractColumn::ColumnMode::BigInt: {
-			valueBigInt = bigIntAt(row);
-
-			if (valueBigInt > prevValueBigInt) {
-				monotonic_decreasing = 0;
-				if (monotonic_increasing < 0)
-					monotonic_increasing = 1;
-				else if (monotonic_increasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else if (valueBigInt < prevValueBigInt) {
-				monotonic_increasing = 0;
-				if (monotonic_decreasing < 0)
-					monotonic_decreasing = 1;
-				else if (monotonic_decreasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else {
-				if (monotonic_increasing < 0 && monotonic_decreasing < 0) {
-					monotonic_decreasing = 1;
-					monotonic_increasing = 1;
-				}
-			}
-
-			prevValueBigInt = valueBigInt;
+		case AbstractColumn::ColumnMode::Integer: {
+			const auto* data = static_cast<QVector<int>*>(m_data)->constData();
+			updateIndex(
+				[&](int a, int b) {
+					return compareValues(data[a], data[b]);
+				},
+				notMasked);
 			break;
 		}
-		case AbstractColumn::ColumnMode::Double: {
-			value = doubleAt(row);
-
-			if (std::isnan(value)) {
-				monotonic_increasing = 0;
-				monotonic_decreasing = 0;
-				break;
-			}
-
-			if (value > prevValue) {
-				monotonic_decreasing = 0;
-				if (monotonic_increasing < 0)
-					monotonic_increasing = 1;
-				else if (monotonic_increasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else if (value < prevValue) {
-				monotonic_increasing = 0;
-				if (monotonic_decreasing < 0)
-					monotonic_decreasing = 1;
-				else if (monotonic_decreasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else {
-				if (monotonic_increasing < 0 && monotonic_decreasing < 0) {
-					monotonic_decreasing = 1;
-					monotonic_increasing = 1;
-				}
-			}
-
-			prevValue = value;
+		case AbstractColumn::ColumnMode::BigInt: {
+			const auto* data = static_cast<QVector<qint64>*>(m_data)->constData();
+			updateIndex(
+				[&](int a, int b) {
+					return compareValues(data[a], data[b]);
+				},
+				notMasked);
 			break;
 		}
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day: {
-			valueDateTime = dateTimeAt(row).toMSecsSinceEpoch();
-
-			if (valueDateTime > prevValueDatetime) {
-				monotonic_decreasing = 0;
-				if (monotonic_increasing < 0)
-					monotonic_increasing = 1;
-				else if (monotonic_increasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else if (valueDateTime < prevValueDatetime) {
-				monotonic_increasing = 0;
-				if (monotonic_decreasing < 0)
-					monotonic_decreasing = 1;
-				else if (monotonic_decreasing == 0)
-					break; // when nor increasing, nor decreasing, break
-
-			} else {
-				if (monotonic_increasing < 0 && monotonic_decreasing < 0) {
-					monotonic_decreasing = 1;
-					monotonic_increasing = 1;
-				}
-			}
-
-			prevValueDatetime = valueDateTime;
+			const auto* data = static_cast<DateTimeVector*>(m_data);
+			updateIndex(
+				[&](int a, int b) {
+					return compareValues(data->msecsAt(a), data->msecsAt(b));
+				},
+				[&](int row) {
+					return data->isValid(row) && notMasked(row);
+				});
 			break;
 		}
 		case AbstractColumn::ColumnMode::Text:
@@ -3044,16 +3316,29 @@ void ColumnPrivate::updateProperties() {
 		}
 	}
 
-	properties = AbstractColumn::Properties::NonMonotonic;
-	if (monotonic_increasing > 0 && monotonic_decreasing > 0) {
-		properties = AbstractColumn::Properties::Constant;
-		DEBUG("	setting column CONSTANT")
-	} else if (monotonic_decreasing > 0) {
+	switch (m_monotonicityIndex.monotonicity()) {
+	case MonotonicityIndex::Monotonicity::Invalid:
+		properties = AbstractColumn::Properties::No;
+		break;
+	case MonotonicityIndex::Monotonicity::Constant:
+		// a single value is not treated as constant
+		if (rows > 1) {
+			properties = AbstractColumn::Properties::Constant;
+			DEBUG("	setting column CONSTANT")
+		} else
+			properties = AbstractColumn::Properties::NonMonotonic;
+		break;
+	case MonotonicityIndex::Monotonicity::Decreasing:
 		properties = AbstractColumn::Properties::MonotonicDecreasing;
 		DEBUG("	setting column MONOTONIC DECREASING")
-	} else if (monotonic_increasing > 0) {
+		break;
+	case MonotonicityIndex::Monotonicity::Increasing:
 		properties = AbstractColumn::Properties::MonotonicIncreasing;
 		DEBUG("	setting column MONOTONIC INCREASING")
+		break;
+	case MonotonicityIndex::Monotonicity::NonMonotonic:
+		properties = AbstractColumn::Properties::NonMonotonic;
+		break;
 	}
 
 	available.properties = true;
@@ -3077,6 +3362,128 @@ void ColumnPrivate::replaceFormulas(const IntervalAttribute<QString>& formulas)
 	m_formulas = formulas;
 }
 
+namespace {
+// number of rows processed together in the parallel calculation of the statistics
+constexpr int statisticsBlockRows = 65536;
+
+/*!
+ * calls \c function(block, first, last) for the blocks of \c statisticsBlockRows rows covering the rows [first, last) in parallel.
+ * The blocks don't depend on the number of threads, so results combined in the order of the blocks are reproducible.
+ */
+template<typename Function>
+void forStatisticsBlocks(int first, int last, Function function) {
+	const int blocks = (last - first + statisticsBlockRows - 1) / statisticsBlockRows;
+	Parallel::forRanges(blocks, 1, [&](int start, int end) {
+		for (int block = start; block < end; ++block) {
+			const int blockFirst = first + block * statisticsBlockRows;
+			function(block, blockFirst, std::min(blockFirst + statisticsBlockRows, last));
+		}
+	});
+}
+
+/*!
+ * calls \c function(v) for the values \c v = \c value(row) of the rows [first, last) that are not masked and not NaN.
+ */
+template<typename Value, typename Function>
+void forEachStatisticsValue(const IntervalAttribute<bool>& masking, int first, int last, Value value, Function function) {
+	int row = masking.nextUnset(first);
+	while (row < last) {
+		const int end = std::min(masking.nextSet(row), last);
+		for (; row < end; ++row) {
+			const double v = value(row);
+			if (!std::isnan(v))
+				function(v);
+		}
+		row = masking.nextUnset(end);
+	}
+}
+
+//! moments of the values of the rows [first, last), calculated in parallel
+template<typename Value>
+Moments statisticsMoments(const IntervalAttribute<bool>& masking, int first, int last, Value value) {
+	std::vector<Moments> blockMoments((last - first + statisticsBlockRows - 1) / statisticsBlockRows);
+	forStatisticsBlocks(first, last, [&](int block, int blockFirst, int blockLast) {
+		auto& moments = blockMoments[block];
+		forEachStatisticsValue(masking, blockFirst, blockLast, value, [&moments](double v) {
+			moments.add(v);
+		});
+	});
+
+	Moments moments;
+	for (const auto& m : blockMoments)
+		moments.add(m);
+	return moments;
+}
+
+//! values of the rows [0, rows) used in the statistics, copied in parallel
+template<typename Value>
+std::vector<double> statisticsValues(const IntervalAttribute<bool>& masking, int rows, Value value) {
+	// count the values of every block first to copy them directly to their final position
+	std::vector<size_t> offsets((rows + statisticsBlockRows - 1) / statisticsBlockRows + 1, 0);
+	forStatisticsBlocks(0, rows, [&](int block, int first, int last) {
+		size_t count = 0;
+		forEachStatisticsValue(masking, first, last, value, [&count](double) {
+			++count;
+		});
+		offsets[block + 1] = count;
+	});
+	for (size_t i = 1; i < offsets.size(); ++i)
+		offsets[i] += offsets[i - 1];
+
+	std::vector<double> values(offsets.back());
+	forStatisticsBlocks(0, rows, [&](int block, int first, int last) {
+		double* target = values.data() + offsets.at(block);
+		forEachStatisticsValue(masking, first, last, value, [&target](double v) {
+			*target++ = v;
+		});
+	});
+	return values;
+}
+
+/*!
+ * partitions [first, last) with nth_element so that the values at the sorted \c positions (relative to \c begin)
+ * are the ones of the sorted data and all values between two positions are between the values at these positions.
+ */
+void selectPositions(std::vector<double>::iterator begin,
+					 std::vector<double>::iterator first,
+					 std::vector<double>::iterator last,
+					 std::vector<size_t>::const_iterator positionsFirst,
+					 std::vector<size_t>::const_iterator positionsLast) {
+	if (positionsFirst == positionsLast || last - first < 2)
+		return;
+
+	// select the middle position first, the other positions are in the smaller ranges left and right of it
+	const auto middle = positionsFirst + (positionsLast - positionsFirst) / 2;
+	const auto nth = begin + *middle;
+	std::nth_element(first, nth, last);
+	selectPositions(begin, first, nth, positionsFirst, middle);
+	selectPositions(begin, nth + 1, last, middle + 1, positionsLast);
+}
+
+/*!
+ * median of \c values determined by selection, equivalent to gsl_stats_quantile_from_sorted_data() of the sorted values.
+ * The order of the values is changed.
+ */
+double selectMedian(std::vector<double>& values) {
+	const double index = 0.5 * (values.size() - 1);
+	const size_t lhs = index;
+	const double delta = index - lhs;
+	std::nth_element(values.begin(), values.begin() + lhs, values.end());
+	if (lhs == values.size() - 1 || delta == 0.)
+		return values.at(lhs);
+	const double next = *std::min_element(values.begin() + lhs + 1, values.end());
+	return (1 - delta) * values.at(lhs) + delta * next;
+}
+} // namespace
+
+/*!
+ * calculates the statistics of the column.
+ *
+ * The moments (mean, variance, skewness, kurtosis, ...) are calculated in one parallel pass over the rows.
+ * They are kept and only the values of rows appended since the last calculation are added to them, see \c invalidate().
+ * The quantiles are determined by selecting the required positions, the partitions between these positions are
+ * sorted in parallel afterwards to count the frequencies of the values for the mode and the entropy.
+ */
 void ColumnPrivate::calculateStatistics() {
 	PERFTRACE(QStringLiteral("calculate column statistics"));
 	statistics = AbstractColumn::ColumnStatistics();
@@ -3092,159 +3499,178 @@ void ColumnPrivate::calculateStatistics() {
 	}
 
 	// ######  location measures  #######
-	int rowValuesSize = rowCount();
-	double columnSum = 0.0;
-	double columnProduct = 1.0;
-	double columnSumNeg = 0.0;
-	double columnSumSquare = 0.0;
-	statistics.minimum = INFINITY;
-	statistics.maximum = -INFINITY;
-	std::unordered_map<double, int> frequencyOfValues;
-	QVector<double> rowData;
-	rowData.reserve(rowValuesSize);
-
-	for (int row = 0; row < rowValuesSize; ++row) {
-		double val = valueAt(row);
-		if (std::isnan(val) || q->isMasked(row))
-			continue;
+	const int rows = rowCount();
+	std::vector<double> values;
+	const auto collect = [&](auto value) {
+		if (m_momentsRowCount > rows) {
+			m_moments = Moments();
+			m_momentsRowCount = 0;
+		}
+		m_moments.add(statisticsMoments(m_masking, m_momentsRowCount, rows, value));
+		m_momentsRowCount = rows;
+		values = statisticsValues(m_masking, rows, value);
+	};
 
-		if (val < statistics.minimum)
-			statistics.minimum = val;
-		if (val > statistics.maximum)
-			statistics.maximum = val;
-		columnSum += val;
-		columnSumNeg += (1.0 / val); // will be Inf when val == 0
-		columnSumSquare += val * val;
-		columnProduct *= val;
-		if (frequencyOfValues.find(val) != frequencyOfValues.end())
-			frequencyOfValues.operator[](val)++;
-		else
-			frequencyOfValues.insert(std::make_pair(val, 1));
-		rowData.push_back(val);
+	if (!m_data) {
+		collect([this](int row) {
+			return m_cacheFile ? m_cacheFile->value(m_cacheFileColumn, row) : NAN;
+		});
+	} else {
+		switch (m_columnMode) {
+		case AbstractColumn::ColumnMode::Double: {
+			const double* data = static_cast<QVector<double>*>(m_data)->constData();
+			collect([data](int row) {
+				return data[row];
+			});
+			break;
+		}
+		case AbstractColumn::ColumnMode::Integer: {
+			const int* data = static_cast<QVector<int>*>(m_data)->constData();
+			collect([data](int row) {
+				return static_cast<double>(data[row]);
+			});
+			break;
+		}
+		case AbstractColumn::ColumnMode::BigInt: {
+			const qint64* data = static_cast<QVector<qint64>*>(m_data)->constData();
+			collect([data](int row) {
+				return static_cast<double>(data[row]);
+			});
+			break;
+		}
+		case AbstractColumn::ColumnMode::Text:
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
 	}
 
-	const size_t notNanCount = rowData.size();
+	const size_t notNanCount = values.size();
 
 	if (notNanCount == 0) {
+		statistics.minimum = INFINITY;
+		statistics.maximum = -INFINITY;
 		available.statistics = true;
 		available.min = true;
 		available.max = true;
 		return;
 	}
 
-	if (rowData.size() < rowValuesSize)
-		rowData.squeeze();
-
 	statistics.size = notNanCount;
-	statistics.arithmeticMean = columnSum / notNanCount;
+	statistics.minimum = m_moments.minimum();
+	statistics.maximum = m_moments.maximum();
+	statistics.arithmeticMean = m_moments.sum() / notNanCount;
 
-	// geometric mean
+	// geometric mean, calculated via the sum of the logarithms to not overflow the product of the values
 	if (statistics.minimum <= -100.) // invalid
 		statistics.geometricMean = NAN;
-	else if (statistics.minimum < 0) { // interpret as percentage (/100) and add 1
-		columnProduct = 1.; // recalculate
-		for (auto val : rowData)
-			columnProduct *= val / 100. + 1.;
-		// n-th root and convert back to percentage changes
-		statistics.geometricMean = 100. * (std::pow(columnProduct, 1.0 / notNanCount) - 1.);
-	} else if (statistics.minimum == 0) { // replace zero values with 1
-		columnProduct = 1.; // recalculate
-		for (auto val : rowData)
-			columnProduct *= (val == 0.) ? 1. : val;
-		statistics.geometricMean = std::pow(columnProduct, 1.0 / notNanCount);
-	} else
-		statistics.geometricMean = std::pow(columnProduct, 1.0 / notNanCount);
-
-	statistics.harmonicMean = notNanCount / columnSumNeg;
-	statistics.contraharmonicMean = columnSumSquare / columnSum;
-
-	// calculate the mode, the most frequent value in the data set
+	else if (statistics.minimum < 0) // interpret as percentage (/100) and add 1, convert back to percentage changes
+		statistics.geometricMean = 100. * (std::exp(m_moments.sumLogPercentage() / notNanCount) - 1.);
+	else // zero values are replaced by 1 and don't contribute to the sum of the logarithms
+		statistics.geometricMean = std::exp(m_moments.sumLog() / notNanCount);
+
+	statistics.harmonicMean = notNanCount / m_moments.sumInverse();
+	statistics.contraharmonicMean = m_moments.sumSquare() / m_moments.sum();
+
+	// select the values needed for the percentiles
+	const std::array<double, 9> fractions{0.01, 0.05, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99};
+	std::vector<size_t> positions;
+	for (double fraction : fractions) {
+		const size_t lhs = fraction * (notNanCount - 1);
+		positions.push_back(lhs);
+		if (lhs + 1 < notNanCount)
+			positions.push_back(lhs + 1);
+	}
+	std::sort(positions.begin(), positions.end());
+	positions.erase(std::unique(positions.begin(), positions.end()), positions.end());
+	selectPositions(values.begin(), values.begin(), values.end(), positions.cbegin(), positions.cend());
+
+	// sort the partitions between the selected positions in parallel, all values are sorted afterwards
+	std::vector<std::pair<size_t, size_t>> partitions;
+	size_t partitionStart = 0;
+	for (size_t position : positions) {
+		if (position > partitionStart + 1)
+			partitions.emplace_back(partitionStart, position);
+		partitionStart = position + 1;
+	}
+	if (partitionStart + 1 < notNanCount)
+		partitions.emplace_back(partitionStart, notNanCount);
+	Parallel::forRanges(static_cast<int>(partitions.size()), 1, [&](int start, int end) {
+		for (int i = start; i < end; ++i)
+			std::sort(values.begin() + partitions.at(i).first, values.begin() + partitions.at(i).second);
+	});
+
+	statistics.firstQuartile = gsl_stats_quantile_from_sorted_data(values.data(), 1, notNanCount, 0.25);
+	statistics.median = gsl_stats_quantile_from_sorted_data(values.data(), 1, notNanCount, 0.50);
+	statistics.thirdQuartile = gsl_stats_quantile_from_sorted_data(values.data(), 1, notNanCount, 0.75);
+	statistics.percentile_1 = gsl_stats_quantile_from_sorted_data(values.data(), 1, notNanCount, 0.01);
+	statistics.percentile_5 = gsl_stats_quantile_from_sorted_data(values.data(), 1, notNanCount, 0.05);
+	statistics.percentile_10 = gsl_stats_quantile_from_sorted_data(values.data(), 1, notNanCount, 0.1);
+	statistics.percentile_90 = gsl_stats_quantile_from_sorted_data(values.data(), 1, notNanCount, 0.9);
+	statistics.percentile_95 = gsl_stats_quantile_from_sorted_data(values.data(), 1, notNanCount, 0.95);
+	statistics.percentile_99 = gsl_stats_quantile_from_sorted_data(values.data(), 1, notNanCount, 0.99);
+	statistics.iqr = statistics.thirdQuartile - statistics.firstQuartile;
+	statistics.trimean = (statistics.firstQuartile + 2. * statistics.median + statistics.thirdQuartile) / 4.;
+
+	// the mode (the most frequent value in the data set) and the entropy from the runs of equal values.
+	// if the max frequency occurs more than once, we have a multi-modal distribution and don't show any mode
 	int maxFreq = 0;
-	double mode = NAN;
-	for (const auto& it : frequencyOfValues) {
-		if (it.second > maxFreq) {
-			maxFreq = it.second;
-			mode = it.first;
-		}
-	}
-	// check how many times the max frequency occurs in the data set.
-	// if more than once, we have a multi-modal distribution and don't show any mode
 	int maxFreqOccurance = 0;
-	for (const auto& it : frequencyOfValues) {
-		if (it.second == maxFreq)
+	double mode = NAN;
+	double entropy = 0.;
+	for (size_t i = 0; i < notNanCount;) {
+		size_t runEnd = i + 1;
+		while (runEnd < notNanCount && values.at(runEnd) == values.at(i))
+			++runEnd;
+
+		const int frequency = runEnd - i;
+		if (frequency > maxFreq) {
+			maxFreq = frequency;
+			maxFreqOccurance = 1;
+			mode = values.at(i);
+		} else if (frequency == maxFreq)
 			++maxFreqOccurance;
 
-		if (maxFreqOccurance > 1) {
-			mode = NAN;
-			break;
-		}
+		const double frequencyNorm = static_cast<double>(frequency) / notNanCount;
+		entropy += (frequencyNorm * std::log2(frequencyNorm));
+		i = runEnd;
 	}
-	statistics.mode = mode;
-
-	// sort the data to calculate the percentiles
-	std::sort(rowData.begin(), rowData.end());
-	statistics.firstQuartile = gsl_stats_quantile_from_sorted_data(rowData.constData(), 1, notNanCount, 0.25);
-	statistics.median = gsl_stats_quantile_from_sorted_data(rowData.constData(), 1, notNanCount, 0.50);
-	statistics.thirdQuartile = gsl_stats_quantile_from_sorted_data(rowData.constData(), 1, notNanCount, 0.75);
-	statistics.percentile_1 = gsl_stats_quantile_from_sorted_data(rowData.constData(), 1, notNanCount, 0.01);
-	statistics.percentile_5 = gsl_stats_quantile_from_sorted_data(rowData.constData(), 1, notNanCount, 0.05);
-	statistics.percentile_10 = gsl_stats_quantile_from_sorted_data(rowData.constData(), 1, notNanCount, 0.1);
-	statistics.percentile_90 = gsl_stats_quantile_from_sorted_data(rowData.constData(), 1, notNanCount, 0.9);
-	statistics.percentile_95 = gsl_stats_quantile_from_sorted_data(rowData.constData(), 1, notNanCount, 0.95);
-	statistics.percentile_99 = gsl_stats_quantile_from_sorted_data(rowData.constData(), 1, notNanCount, 0.99);
-	statistics.iqr = statistics.thirdQuartile - statistics.firstQuartile;
-	statistics.trimean = (statistics.firstQuartile + 2. * statistics.median + statistics.thirdQuartile) / 4.;
+	statistics.mode = (maxFreqOccurance > 1) ? NAN : mode;
+	statistics.entropy = -entropy;
 
 	// ######  dispersion and shape measures  #######
-	statistics.variance = 0.;
-	statistics.meanDeviation = 0.;
-	statistics.meanDeviationAroundMedian = 0.;
-	double centralMoment_r3 = 0.;
-	double centralMoment_r4 = 0.;
-	QVector<double> absoluteMedianList;
-	absoluteMedianList.reserve(notNanCount);
-	absoluteMedianList.resize(notNanCount);
-
-	for (size_t row = 0; row < notNanCount; ++row) {
-		double val = rowData.value(row);
-		statistics.variance += gsl_pow_2(val - statistics.arithmeticMean);
-		statistics.meanDeviation += std::abs(val - statistics.arithmeticMean);
-
-		absoluteMedianList[row] = std::abs(val - statistics.median);
-		statistics.meanDeviationAroundMedian += absoluteMedianList[row];
+	statistics.variance = m_moments.variance();
+	statistics.standardDeviation = std::sqrt(statistics.variance);
 
-		centralMoment_r3 += gsl_pow_3(val - statistics.arithmeticMean);
-		centralMoment_r4 += gsl_pow_4(val - statistics.arithmeticMean);
+	// the absolute deviations from the mean and from the median
+	std::vector<double> absoluteMedianList(notNanCount);
+	std::vector<KahanSum> meanDeviations((notNanCount + statisticsBlockRows - 1) / statisticsBlockRows);
+	std::vector<KahanSum> medianDeviations(meanDeviations.size());
+	forStatisticsBlocks(0, static_cast<int>(notNanCount), [&](int block, int first, int last) {
+		for (int i = first; i < last; ++i) {
+			const double val = values[i];
+			meanDeviations[block].add(std::abs(val - statistics.arithmeticMean));
+			absoluteMedianList[i] = std::abs(val - statistics.median);
+			medianDeviations[block].add(absoluteMedianList[i]);
+		}
+	});
+	KahanSum meanDeviation;
+	KahanSum medianDeviation;
+	for (size_t i = 0; i < meanDeviations.size(); ++i) {
+		meanDeviation.add(meanDeviations.at(i));
+		medianDeviation.add(medianDeviations.at(i));
 	}
-
-	double centralMoment_r2 = statistics.variance / notNanCount;
-
-	// normalize
-	statistics.variance = (notNanCount != 1) ? statistics.variance / (notNanCount - 1) : NAN;
-	statistics.meanDeviationAroundMedian = statistics.meanDeviationAroundMedian / notNanCount;
-	statistics.meanDeviation = statistics.meanDeviation / notNanCount;
-
-	// standard deviation
-	statistics.standardDeviation = std::sqrt(statistics.variance);
+	statistics.meanDeviation = meanDeviation.value() / notNanCount;
+	statistics.meanDeviationAroundMedian = medianDeviation.value() / notNanCount;
 
 	//"median absolute deviation" - the median of the absolute deviations from the data's median.
-	std::sort(absoluteMedianList.begin(), absoluteMedianList.end());
-	statistics.medianDeviation = gsl_stats_quantile_from_sorted_data(absoluteMedianList.data(), 1, notNanCount, 0.50);
+	statistics.medianDeviation = selectMedian(absoluteMedianList);
 
 	// skewness and kurtosis
-	centralMoment_r3 /= notNanCount;
-	centralMoment_r4 /= notNanCount;
-	statistics.skewness = centralMoment_r3 / gsl_pow_3(std::sqrt(centralMoment_r2));
-	statistics.kurtosis = centralMoment_r4 / gsl_pow_2(centralMoment_r2);
-
-	// entropy
-	double entropy = 0.;
-	for (const auto& v : frequencyOfValues) {
-		const double frequencyNorm = static_cast<double>(v.second) / notNanCount;
-		entropy += (frequencyNorm * std::log2(frequencyNorm));
-	}
-
-	statistics.entropy = -entropy;
+	const double centralMoment_r2 = m_moments.centralMoment2();
+	statistics.skewness = m_moments.centralMoment3() / gsl_pow_3(std::sqrt(centralMoment_r2));
+	statistics.kurtosis = m_moments.centralMoment4() / gsl_pow_2(centralMoment_r2);
 
 	available.statistics = true;
 	available.min = true;
@@ -3264,7 +3690,7 @@ void ColumnPrivate::calculateTextStatistics() {
 	}
 
 	statistics.size = valid;
-	statistics.unique = m_dictionary.count();
+	statistics.unique = m_dictionary.size();
 	available.statistics = true;
 }
 
@@ -3273,15 +3699,13 @@ void ColumnPrivate::calculateDateTimeStatistics() {
 	statistics.maximum = -INFINITY;
 
 	int valid = 0;
-	for (int row = 0; row < rowCount(); ++row) {
-		if (q->isMasked(row))
-			continue;
-
-		const auto& value = dateTimeAt(row);
-		if (!value.isValid())
+	const auto* data = static_cast<DateTimeVector*>(m_data);
+	const int rows = data ? data->size() : 0;
+	for (int row = 0; row < rows; ++row) {
+		if (q->isMasked(row) || !data->isValid(row))
 			continue;
 
-		quint64 val = value.toMSecsSinceEpoch();
+		const qint64 val = data->msecsAt(row);
 		if (val < statistics.minimum)
 			statistics.minimum = val;
 		if (val > statistics.maximum)
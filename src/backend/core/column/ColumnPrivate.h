@@ -14,13 +14,32 @@
 
 #include "backend/core/AbstractColumnPrivate.h"
 #include "backend/core/column/Column.h"
+#include "backend/lib/DateTimeVector.h"
 #include "backend/lib/IntervalAttribute.h"
+#include "backend/lib/MinMaxIndex.h"
+#include "backend/lib/Moments.h"
+#include "backend/lib/MonotonicityIndex.h"
+#include "backend/lib/TextDictionary.h"
 
 #include <QMap>
 
+#include <memory>
+#include <vector>
+
 class Column;
+class ColumnCacheFile;
 class ColumnSetGlobalFormulaCmd;
 
+// type of the data container of the column for values of type T
+template<typename T>
+struct ColumnDataContainer {
+	using type = QVector<T>;
+};
+template<>
+struct ColumnDataContainer<QDateTime> {
+	using type = DateTimeVector;
+};
+
 class ColumnPrivate : public AbstractColumnPrivate {
 	Q_OBJECT
 
@@ -39,6 +58,9 @@ public:
 	bool copy(const AbstractColumn*, int source_start, int dest_start, int num_rows);
 	bool copy(const ColumnPrivate*);
 	bool copy(const ColumnPrivate*, int source_start, int dest_start, int num_rows);
+	bool changedRows(const AbstractColumn*, int maxRows, QVector<Interval<int>>& rows) const;
+	bool swapRows(ColumnPrivate*, const QVector<Interval<int>>& rows);
+	void permuteRows(const std::vector<int>& permutation, bool inverse);
 
 	int indexForValue(double x) const;
 
@@ -105,6 +127,12 @@ public:
 	void replaceTexts(int first, const QVector<QString>&);
 	int dictionaryIndex(int row) const;
 	const QMap<QString, int>& frequencies() const;
+	const TextDictionary& dictionary() const;
+	void encodeTexts();
+
+	bool setCacheFile(std::shared_ptr<ColumnCacheFile>, int column);
+	const std::shared_ptr<ColumnCacheFile>& cacheFile() const;
+	int cacheFileColumn() const;
 
 	QDate dateAt(int row) const;
 	void setDateAt(int row, QDate);
@@ -136,6 +164,8 @@ public:
 	void updateProperties();
 	void calculateStatistics();
 	void invalidate();
+	void invalidate(int first, int last);
+	bool indexedMinMax(int startIndex, int endIndex, double& min, double& max);
 	void finalizeLoad();
 
 	void formulaVariableColumnAdded(const AbstractAspect*);
@@ -253,9 +283,11 @@ public:
 
 private:
 	AbstractColumn::ColumnMode m_columnMode; // type of column data
-	void* m_data{nullptr}; // pointer to the data container (QVector<T>)
+	void* m_data{nullptr}; // pointer to the data container (QVector<T> or DateTimeVector, see ColumnDataContainer)
 	int m_rowCount{0};
-	QVector<QString> m_dictionary; // dictionary for string columns
+	std::shared_ptr<ColumnCacheFile> m_cacheFile; // file with the values of a double column that are not loaded into memory
+	int m_cacheFileColumn{0}; // index of the column in m_cacheFile
+	TextDictionary m_dictionary; // dictionary encoding of string columns
 	QMap<QString, int> m_dictionaryFrequencies; // dictionary for elements frequencies in string columns
 
 	AbstractSimpleFilter* m_inputFilter{nullptr}; // input filter for string -> data type conversion
@@ -268,11 +300,20 @@ private:
 	AbstractColumn::PlotDesignation m_plotDesignation{AbstractColumn::PlotDesignation::NoDesignation};
 	int m_width{0}; // column width in the view
 	QVector<QMetaObject::Connection> m_connectionsUpdateFormula;
-
-	void initDictionary();
+	MinMaxIndex m_minMaxIndex; // index of the minima and maxima of large columns, see indexedMinMax()
+	int m_minMaxIndexFirst{INT_MAX}; // first and last row changed since the last update of m_minMaxIndex
+	int m_minMaxIndexLast{-1};
+	Moments m_moments; // moments of the rows [0, m_momentsRowCount) used in the statistics, see calculateStatistics()
+	int m_momentsRowCount{0};
+	MonotonicityIndex m_monotonicityIndex; // monotonicity of the rows, see updateProperties()
+	int m_monotonicityIndexFirst{INT_MAX}; // first and last row changed since the last update of m_monotonicityIndex
+	int m_monotonicityIndexLast{-1};
+
+	void initDictionary(bool intern = false);
 	void calculateTextStatistics();
 	void calculateDateTimeStatistics();
 	void connectFormulaColumn(const AbstractColumn*);
+	double minMaxIndexValue(int row) const;
 
 	// Never call this function directly, because it does no
 	// mode checking.
@@ -283,13 +324,13 @@ private:
 				return; // failed to allocate memory
 		}
 
-		invalidate();
+		invalidate(row, row);
 
 		Q_EMIT q->dataAboutToChange(q);
 		if (row >= rowCount())
 			resizeTo(row + 1);
 
-		static_cast<QVector<T>*>(m_data)->replace(row, new_value);
+		static_cast<typename ColumnDataContainer<T>::type*>(m_data)->replace(row, new_value);
 		if (!m_suppressDataChangedSignal)
 			Q_EMIT q->dataChanged(q);
 	}
@@ -304,25 +345,38 @@ private:
 				return; // failed to allocate memory
 		}
 
-		invalidate();
+		if (first < 0)
+			invalidate();
+		else
+			invalidate(first, first + new_values.size() - 1);
 
 		Q_EMIT q->dataAboutToChange(q);
 
+		auto* data = static_cast<typename ColumnDataContainer<T>::type*>(m_data);
 		if (first < 0)
-			*static_cast<QVector<T>*>(m_data) = new_values;
+			*data = new_values;
 		else {
-			const int num_rows = new_values.size();
-			resizeTo(first + num_rows);
-
-			T* ptr = static_cast<QVector<T>*>(m_data)->data();
-			for (int i = 0; i < num_rows; ++i)
-				ptr[first + i] = new_values.at(i);
+			resizeTo(first + new_values.size());
+			replaceRange(data, first, new_values);
 		}
 
 		if (!m_suppressDataChangedSignal)
 			Q_EMIT q->dataChanged(q);
 	}
 
+	template<typename T>
+	static void replaceRange(QVector<T>* data, int first, const QVector<T>& new_values) {
+		T* ptr = data->data();
+		const int num_rows = new_values.size();
+		for (int i = 0; i < num_rows; ++i)
+			ptr[first + i] = new_values.at(i);
+	}
+	static void replaceRange(DateTimeVector* data, int first, const QVector<QDateTime>& new_values) {
+		const int num_rows = new_values.size();
+		for (int i = 0; i < num_rows; ++i)
+			data->replace(first + i, new_values.at(i));
+	}
+
 private Q_SLOTS:
 	void formulaVariableColumnRemoved(const AbstractAspect*);
 
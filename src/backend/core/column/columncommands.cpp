@@ -19,6 +19,36 @@
 
 #include <cmath>
 
+namespace {
+/*!
+ * approximate number of bytes used by the values of the column \c col, the text of strings is not taken into account.
+ */
+qint64 dataSize(const ColumnPrivate* col) {
+	if (!col)
+		return 0;
+
+	qint64 valueSize = 0;
+	switch (col->columnMode()) {
+	case AbstractColumn::ColumnMode::Double:
+		valueSize = sizeof(double);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		valueSize = sizeof(int);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		valueSize = sizeof(qint64);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		valueSize = sizeof(QString);
+		break;
+	}
+	return col->rowCount() * valueSize;
+}
+}
+
 /** ***************************************************************************
  * \class ColumnSetModeCmd
  * \brief Set the column mode
@@ -111,7 +141,7 @@ ColumnSetModeCmd::~ColumnSetModeCmd() {
 			case AbstractColumn::ColumnMode::DateTime:
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day:
-				delete static_cast<QVector<QDateTime>*>(m_new_data);
+				delete static_cast<DateTimeVector*>(m_new_data);
 				break;
 			}
 	} else {
@@ -132,7 +162,7 @@ ColumnSetModeCmd::~ColumnSetModeCmd() {
 			case AbstractColumn::ColumnMode::DateTime:
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day:
-				delete static_cast<QVector<QDateTime>*>(m_old_data);
+				delete static_cast<DateTimeVector*>(m_old_data);
 				break;
 			}
 	}
@@ -195,6 +225,9 @@ void ColumnSetModeCmd::undo() {
 /**
  * \var ColumnFullCopyCmd::m_backup
  * \brief A backup column
+ *
+ * Contains the old values of the column or, if only some rows were changed, the old values of the changed rows only,
+ * see \c m_changedRowsOnly. The values are swapped with the values in the column on undo and redo.
  */
 
 /**
@@ -206,6 +239,19 @@ void ColumnSetModeCmd::undo() {
  * replacement without too much copying.
  */
 
+/**
+ * \var ColumnFullCopyCmd::m_changedRowsOnly
+ * \brief Flag indicating whether the backup only contains the values of the rows in \c m_changedRows
+ *
+ * Copying a column into a large column of the same size often only changes a part of the rows, e.g. when pasting
+ * or filling a range of cells. Only the values of these rows are kept then instead of a copy of the whole column.
+ */
+
+/**
+ * \var ColumnFullCopyCmd::m_changedRows
+ * \brief The changed rows if \c m_changedRowsOnly is set
+ */
+
 /**
  * \brief Ctor
  */
@@ -231,9 +277,44 @@ void ColumnFullCopyCmd::redo() {
 	if (m_backup == nullptr) {
 		m_backup_owner = new Column(QStringLiteral("temp"), m_src->columnMode());
 		m_backup = new ColumnPrivate(m_backup_owner, m_src->columnMode());
-		m_backup->copy(m_col);
-		m_col->copy(m_src);
-	} else {
+
+		// keep only the changed rows if less than half of the rows are changed
+		m_changedRowsOnly = m_col->changedRows(m_src, m_col->rowCount() / 2, m_changedRows);
+		if (m_changedRowsOnly) {
+			// copy the new values of the changed rows into the backup and swap them with the old values in the column
+			int count = 0;
+			for (const auto& rows : std::as_const(m_changedRows))
+				count += rows.size();
+			m_backup->resizeTo(count);
+			int offset = 0;
+			for (const auto& rows : std::as_const(m_changedRows)) {
+				m_backup->copy(m_src, rows.start(), offset, rows.size());
+				offset += rows.size();
+			}
+			m_col->swapRows(m_backup, m_changedRows);
+		} else {
+			m_changedRows.clear();
+			m_backup->copy(m_col);
+			m_col->copy(m_src);
+		}
+	} else
+		swap();
+}
+
+/**
+ * \brief Undo the command
+ */
+void ColumnFullCopyCmd::undo() {
+	swap();
+}
+
+void ColumnFullCopyCmd::swap() {
+	if (!m_backup)
+		return;
+
+	if (m_changedRowsOnly)
+		m_col->swapRows(m_backup, m_changedRows);
+	else {
 		// swap data of orig. column and backup
 		void* data_temp = m_col->data();
 		m_col->replaceData(m_backup->data());
@@ -241,14 +322,16 @@ void ColumnFullCopyCmd::redo() {
 	}
 }
 
-/**
- * \brief Undo the command
- */
-void ColumnFullCopyCmd::undo() {
-	// swap data of orig. column and backup
-	void* data_temp = m_col->data();
-	m_col->replaceData(m_backup->data());
-	m_backup->replaceData(data_temp);
+qint64 ColumnFullCopyCmd::memorySize() const {
+	return dataSize(m_backup);
+}
+
+void ColumnFullCopyCmd::releaseMemory() {
+	delete m_backup;
+	m_backup = nullptr;
+	delete m_backup_owner;
+	m_backup_owner = nullptr;
+	m_changedRows.clear();
 }
 
 /** ***************************************************************************
@@ -267,27 +350,16 @@ void ColumnFullCopyCmd::undo() {
  */
 
 /**
- * \var ColumnPartialCopyCmd::m_col_backup
- * \brief A backup of the original column
- */
-
-/**
- * \var ColumnPartialCopyCmd::m_src_backup
- * \brief A backup of the source column
- */
-
-/**
- * \var ColumnPartialCopyCmd::m_col_backup_owner
- * \brief A dummy owner for the backup column
+ * \var ColumnPartialCopyCmd::m_backup
+ * \brief A backup of the copied rows
  *
- * This is needed because a ColumnPrivate must have an owner and
- * we must have a ColumnPrivate object as backup.
- * Using a Column object as backup would lead to an infinite loop.
+ * Contains the new values of the rows before the first execution of the command. The values are swapped
+ * with the values in the column on undo and redo, so the backup contains the old values after redo.
  */
 
 /**
- * \var ColumnPartialCopyCmd::m_src_backup_owner
- * \brief A dummy owner for the source backup column
+ * \var ColumnPartialCopyCmd::m_backup_owner
+ * \brief A dummy owner for the backup column
  *
  * This is needed because a ColumnPrivate must have an owner and
  * we must have a ColumnPrivate object as backup.
@@ -331,38 +403,53 @@ ColumnPartialCopyCmd::ColumnPartialCopyCmd(ColumnPrivate* col, const AbstractCol
  * \brief Dtor
  */
 ColumnPartialCopyCmd::~ColumnPartialCopyCmd() {
-	delete m_src_backup;
-	delete m_col_backup;
-	delete m_src_backup_owner;
-	delete m_col_backup_owner;
+	delete m_backup;
+	delete m_backup_owner;
 }
 
 /**
  * \brief Execute the command
  */
 void ColumnPartialCopyCmd::redo() {
-	if (m_src_backup == nullptr) {
-		// copy the relevant rows of source and destination column into backup columns
-		m_src_backup_owner = new Column(QStringLiteral("temp"), m_col->columnMode());
-		m_src_backup = new ColumnPrivate(m_src_backup_owner, m_col->columnMode());
-		m_src_backup->copy(m_src, m_src_start, 0, m_num_rows);
-		m_col_backup_owner = new Column(QStringLiteral("temp"), m_col->columnMode());
-		m_col_backup = new ColumnPrivate(m_col_backup_owner, m_col->columnMode());
-		m_col_backup->copy(m_col, m_dest_start, 0, m_num_rows);
+	if (m_backup_owner == nullptr) {
+		// copy the relevant rows of the source column into the backup column
+		m_backup_owner = new Column(QStringLiteral("temp"), m_col->columnMode());
+		m_backup = new ColumnPrivate(m_backup_owner, m_col->columnMode());
+		if (!m_backup->copy(m_src, m_src_start, 0, m_num_rows)) {
+			delete m_backup;
+			m_backup = nullptr;
+		}
 		m_old_row_count = m_col->rowCount();
 	}
-	m_col->copy(m_src_backup, 0, m_dest_start, m_num_rows);
+	if (!m_backup || m_num_rows <= 0)
+		return;
+
+	if (m_col->rowCount() < m_dest_start + m_num_rows)
+		m_col->resizeTo(m_dest_start + m_num_rows);
+	m_col->swapRows(m_backup, {Interval<int>(m_dest_start, m_dest_start + m_num_rows - 1)});
 }
 
 /**
  * \brief Undo the command
  */
 void ColumnPartialCopyCmd::undo() {
-	m_col->copy(m_col_backup, 0, m_dest_start, m_num_rows);
+	if (!m_backup || m_num_rows <= 0)
+		return;
+
+	m_col->swapRows(m_backup, {Interval<int>(m_dest_start, m_dest_start + m_num_rows - 1)});
 	m_col->resizeTo(m_old_row_count);
 	m_col->replaceData(m_col->data());
 }
 
+qint64 ColumnPartialCopyCmd::memorySize() const {
+	return dataSize(m_backup);
+}
+
+void ColumnPartialCopyCmd::releaseMemory() {
+	delete m_backup;
+	m_backup = nullptr;
+}
+
 /** ***************************************************************************
  * \class ColumnInsertRowsCmd
  * \brief Insert empty rows
@@ -484,6 +571,9 @@ void ColumnRemoveRowsCmd::redo() {
  * \brief Undo the command
  */
 void ColumnRemoveRowsCmd::undo() {
+	if (!m_backup)
+		return;
+
 	m_col->insertRows(m_first, m_count);
 	m_col->copy(m_backup, 0, m_first, m_data_row_count);
 	m_col->resizeTo(m_old_size);
@@ -491,6 +581,18 @@ void ColumnRemoveRowsCmd::undo() {
 	m_col->owner()->setChanged();
 }
 
+qint64 ColumnRemoveRowsCmd::memorySize() const {
+	return dataSize(m_backup);
+}
+
+void ColumnRemoveRowsCmd::releaseMemory() {
+	delete m_backup;
+	m_backup = nullptr;
+	delete m_backup_owner;
+	m_backup_owner = nullptr;
+	m_formulas.clear();
+}
+
 /** ***************************************************************************
  * \class ColumnSetPlotDesignationCmd
  * \brief Sets a column's plot designation
@@ -593,7 +695,7 @@ ColumnClearCmd::~ColumnClearCmd() {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			delete static_cast<QVector<QDateTime>*>(m_empty_data);
+			delete static_cast<DateTimeVector*>(m_empty_data);
 			break;
 		}
 	} else {
@@ -615,7 +717,7 @@ ColumnClearCmd::~ColumnClearCmd() {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			delete static_cast<QVector<QDateTime>*>(m_data);
+			delete static_cast<DateTimeVector*>(m_data);
 			break;
 		}
 	}
@@ -652,9 +754,7 @@ void ColumnClearCmd::redo() {
 		case AbstractColumn::ColumnMode::DateTime:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
-			m_empty_data = new QVector<QDateTime>();
-			for (int i = 0; i < rowCount; ++i)
-				static_cast<QVector<QDateTime>*>(m_empty_data)->append(QDateTime());
+			m_empty_data = new DateTimeVector(rowCount);
 			break;
 		case AbstractColumn::ColumnMode::Text:
 			m_empty_data = new QVector<QString>();
@@ -15,6 +15,7 @@
 #include "backend/core/column/Column.h"
 #include "backend/core/column/ColumnPrivate.h"
 #include "backend/lib/IntervalAttribute.h"
+#include "backend/lib/UndoMemoryBudget.h"
 
 #include <KLocalizedString>
 
@@ -45,36 +46,42 @@ private:
 	bool m_executed{false};
 };
 
-class ColumnFullCopyCmd : public QUndoCommand {
+class ColumnFullCopyCmd : public QUndoCommand, public UndoCommandMemory {
 public:
 	explicit ColumnFullCopyCmd(ColumnPrivate* col, const AbstractColumn* src, QUndoCommand* parent = nullptr);
 	~ColumnFullCopyCmd() override;
 
 	void redo() override;
 	void undo() override;
+	qint64 memorySize() const override;
+	void releaseMemory() override;
 
 private:
+	void swap();
+
 	ColumnPrivate* m_col;
 	const AbstractColumn* m_src;
 	ColumnPrivate* m_backup{nullptr};
 	Column* m_backup_owner{nullptr};
+	bool m_changedRowsOnly{false};
+	QVector<Interval<int>> m_changedRows;
 };
 
-class ColumnPartialCopyCmd : public QUndoCommand {
+class ColumnPartialCopyCmd : public QUndoCommand, public UndoCommandMemory {
 public:
 	explicit ColumnPartialCopyCmd(ColumnPrivate* col, const AbstractColumn* src, int src_start, int dest_start, int num_rows, QUndoCommand* parent = nullptr);
 	~ColumnPartialCopyCmd() override;
 
 	void redo() override;
 	void undo() override;
+	qint64 memorySize() const override;
+	void releaseMemory() override;
 
 private:
 	ColumnPrivate* m_col;
 	const AbstractColumn* m_src;
-	ColumnPrivate* m_col_backup{nullptr};
-	ColumnPrivate* m_src_backup{nullptr};
-	Column* m_col_backup_owner{nullptr};
-	Column* m_src_backup_owner{nullptr};
+	ColumnPrivate* m_backup{nullptr};
+	Column* m_backup_owner{nullptr};
 	int m_src_start;
 	int m_dest_start;
 	int m_num_rows;
@@ -93,13 +100,15 @@ private:
 	int m_before, m_count;
 };
 
-class ColumnRemoveRowsCmd : public QUndoCommand {
+class ColumnRemoveRowsCmd : public QUndoCommand, public UndoCommandMemory {
 public:
 	explicit ColumnRemoveRowsCmd(ColumnPrivate* col, int first, int count, QUndoCommand* parent = nullptr);
 	~ColumnRemoveRowsCmd() override;
 
 	void redo() override;
 	void undo() override;
+	qint64 memorySize() const override;
+	void releaseMemory() override;
 
 private:
 	ColumnPrivate* m_col;
@@ -245,7 +254,7 @@ private:
 };
 
 template<typename T>
-class ColumnReplaceCmd : public QUndoCommand {
+class ColumnReplaceCmd : public QUndoCommand, public UndoCommandMemory {
 public:
 	/**
 	 * \var ColumnReplaceTextsCmd::m_col
@@ -276,6 +285,11 @@ public:
 	 * \var ColumnReplaceTextsCmd::m_row_count
 	 * \brief The old number of rows
 	 */
+
+	/**
+	 * \var ColumnReplaceTextsCmd::m_released
+	 * \brief Whether the values were released to limit the memory of the undo stack
+	 */
 	explicit ColumnReplaceCmd(ColumnPrivate* col, int first, const QVector<T>& new_values, QUndoCommand* parent = nullptr)
 		: QUndoCommand(parent)
 		, m_col(col)
@@ -289,36 +303,49 @@ public:
 
 	void redo() override {
 		auto* data = m_col->data();
-		if (!data)
+		if (!data || m_released)
 			return;
 
 		if (m_first < 0)
-			m_old_values = *static_cast<QVector<T>*>(data);
+			m_old_values = static_cast<Container*>(data)->mid(0);
 		else
-			m_old_values = static_cast<QVector<T>*>(data)->mid(m_first, m_new_values.count());
+			m_old_values = static_cast<Container*>(data)->mid(m_first, m_new_values.count());
 
 		m_col->replaceValues(m_first, m_new_values);
 		m_new_values.clear(); // delete values, because otherwise we use a lot of ram even if we don't need it
 	}
 	void undo() override {
 		auto* data = m_col->data();
-		if (!data)
+		if (!data || m_released)
 			return;
 
 		if (m_first < 0)
-			m_new_values = *static_cast<QVector<T>*>(data);
+			m_new_values = static_cast<Container*>(data)->mid(0);
 		else
-			m_new_values = static_cast<QVector<T>*>(data)->mid(m_first, m_old_values.count());
+			m_new_values = static_cast<Container*>(data)->mid(m_first, m_old_values.count());
 
 		m_col->replaceValues(m_first, m_old_values);
 		m_old_values.clear();
 	}
 
+	qint64 memorySize() const override {
+		// the text of strings is not taken into account
+		return qint64(m_old_values.size() + m_new_values.size()) * sizeof(T);
+	}
+	void releaseMemory() override {
+		m_old_values = QVector<T>();
+		m_new_values = QVector<T>();
+		m_released = true; // the values can't be restored anymore, undo/redo don't modify the column
+	}
+
 private:
+	using Container = typename ColumnDataContainer<T>::type;
+
 	ColumnPrivate* m_col;
 	int m_first;
 	QVector<T> m_new_values;
 	QVector<T> m_old_values;
+	bool m_released{false};
 };
 
 #endif
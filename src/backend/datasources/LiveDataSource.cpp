@@ -15,6 +15,7 @@
 #include "backend/datasources/filters/AsciiFilter.h"
 #include "backend/datasources/filters/BinaryFilter.h"
 #include "backend/datasources/filters/FITSFilter.h"
+#include "backend/datasources/filters/JsonFilter.h"
 #include "backend/datasources/filters/ROOTFilter.h"
 #include "backend/datasources/filters/SpiceFilter.h"
 #include "backend/lib/XmlStreamReader.h"
@@ -561,6 +562,13 @@ void LiveDataSource::read() {
 				// DEBUG("Read " << bytes << " bytes, in total: " << m_bytesRead);
 			}
 			break;
+		case AbstractFileFilter::FileType::JSON:
+			// new documents are appended for JSON Lines data
+			if (m_readingType == LiveDataSource::ReadingType::WholeFile)
+				m_filter->readDataFromFile(m_fileName, this);
+			else
+				m_bytesRead += static_cast<JsonFilter*>(m_filter)->readFromLiveDevice(*m_device, this, m_bytesRead, m_keepNValues);
+			break;
 		case AbstractFileFilter::FileType::Binary:
 			// TODO: not implemented yet
 			//  bytes = qSharedPointerCast<BinaryFilter>(m_filter)->readFromLiveDevice(*m_file, this, m_bytesRead);
@@ -578,7 +586,6 @@ void LiveDataSource::read() {
 		case AbstractFileFilter::FileType::VECTOR_BLF:
 		case AbstractFileFilter::FileType::NETCDF:
 		case AbstractFileFilter::FileType::FITS:
-		case AbstractFileFilter::FileType::JSON:
 		case AbstractFileFilter::FileType::READSTAT:
 		case AbstractFileFilter::FileType::MATIO:
 		case AbstractFileFilter::FileType::MCAP:
@@ -598,6 +605,8 @@ void LiveDataSource::read() {
 		if (m_fileType == AbstractFileFilter::FileType::Ascii)
 			static_cast<AsciiFilter*>(m_filter)
 				->readFromDevice(*m_device, AbstractFileFilter::ImportMode::Replace, AbstractFileFilter::ImportMode::Append, 0, sampleSize(), m_keepNValues);
+		else if (m_fileType == AbstractFileFilter::FileType::JSON)
+			static_cast<JsonFilter*>(m_filter)->readFromLiveDevice(*m_device, this, 0, m_keepNValues);
 		break;
 	case SourceType::LocalSocket:
 		DEBUG("	Reading from local socket. state before abort = " << m_localSocket->state());
@@ -624,7 +633,8 @@ void LiveDataSource::read() {
 																firstRead);
 			if (static_cast<AsciiFilter*>(m_filter)->lastError().isEmpty())
 				firstRead = false;
-		}
+		} else if (m_fileType == AbstractFileFilter::FileType::JSON)
+			static_cast<JsonFilter*>(m_filter)->readFromLiveDevice(*m_device, this, 0, m_keepNValues);
 #endif
 		break;
 	}
@@ -944,6 +954,10 @@ bool LiveDataSource::load(XmlStreamReader* reader, bool preview) {
 			setFilter(new AsciiFilter);
 			if (!m_filter->load(reader))
 				return false;
+		} else if (reader->name() == QLatin1String("jsonFilter")) {
+			setFilter(new JsonFilter);
+			if (!m_filter->load(reader))
+				return false;
 		} else if (reader->name() == QLatin1String("rootFilter")) {
 			setFilter(new ROOTFilter);
 			if (!m_filter->load(reader))
@@ -11,6 +11,8 @@
 #include "AsciiFilter.h"
 #include "AsciiFilterPrivate.h"
 #include "backend/core/Project.h"
+#include "backend/lib/ByteScanner.h"
+#include "backend/lib/Parallel.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/hostprocess.h"
 #include "backend/lib/trace.h"
@@ -22,7 +24,7 @@
 
 #include <QDateTime>
 
-#include <fstream>
+#include <cstring>
 
 namespace {
 // Simple object to automatically closing a device when this object
@@ -134,11 +136,9 @@ void AsciiFilter::setDataSource(AbstractDataSource* dataSource) {
 
 void AsciiFilter::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, ImportMode columnImportMode) {
 	Q_D(AsciiFilter);
-	d->fileNumberLines = lineCount(fileName);
+	KCompressionDevice compressionDevice(fileName);
 
-	KCompressionDevice file(fileName);
-
-	if (d->isUTF16(file)) {
+	if (d->isUTF16(compressionDevice)) {
 		d->setLastError(AsciiFilter::Status::UTF16NotSupported);
 		return;
 	}
@@ -148,7 +148,16 @@ void AsciiFilter::readDataFromFile(const QString& fileName, AbstractDataSource*
 	if (columnImportMode != ImportMode::Replace)
 		rowImportMode = ImportMode::Append;
 	setDataSource(dataSource);
-	readFromDevice(file, columnImportMode, rowImportMode, 0, lines, 0);
+
+	if (compressionDevice.compressionType() == KCompressionDevice::None) {
+		// uncompressed files are read directly, large files are mapped into the memory and imported in parallel
+		QFile file(fileName);
+		d->fileNumberLines = d->parallelImport(file, lines, 0, false) ? 0 : lineCount(fileName);
+		readFromDevice(file, columnImportMode, rowImportMode, 0, lines, 0);
+	} else {
+		d->fileNumberLines = lineCount(fileName);
+		readFromDevice(compressionDevice, columnImportMode, rowImportMode, 0, lines, 0);
+	}
 }
 
 qint64 AsciiFilter::readFromDevice(QIODevice& device,
@@ -292,28 +301,30 @@ size_t AsciiFilter::lineCount(const QString& fileName, const size_t maxLines) {
 		return 0;
 	}
 
-	if (device.compressionType() == KCompressionDevice::None) { // uncompressed
+	// the line ends are counted in blocks of bytes, uncompressed files are read directly
+	QFile file(fileName);
+	QIODevice* source = &device;
+	if (device.compressionType() == KCompressionDevice::None) {
 		device.close();
-
-		std::ifstream file(fileName.toStdString());
-
-		size_t count = 0;
-		std::string line;
-		while (std::getline(file, line) && count < maxLines)
-			++count;
-		DEBUG(Q_FUNC_INFO << "Number of lines: " << count)
-		return count;
+		if (!file.open(QIODevice::ReadOnly))
+			return 0;
+		source = &file;
 	}
 
-	// fallback for compressed data
 	size_t count = 0;
-	while (!device.atEnd()) {
-		if (count >= maxLines) // stop when maxLines available
-			return count;
-		device.readLine();
-		count++;
+	char last = '\n';
+	QByteArray buffer(1024 * 1024, Qt::Uninitialized);
+	qint64 size;
+	while (count < maxLines && (size = source->read(buffer.data(), buffer.size())) > 0) {
+		count += ByteScanner::count(buffer.constData(), buffer.constData() + size, '\n');
+		last = buffer.at(size - 1);
 	}
+	// the last line doesn't need to end with a line end
+	if (last != '\n')
+		++count;
 
+	count = std::min(count, maxLines);
+	DEBUG(Q_FUNC_INFO << "Number of lines: " << count)
 	return count;
 }
 
@@ -658,6 +669,10 @@ bool AsciiFilterPrivate::ignoringLine(QStringView line, const AsciiFilter::Prope
 		|| (line.size() == 2 && line.at(0) == QLatin1Char('\r') && line.at(1) == QLatin1Char('\n'));
 }
 
+bool AsciiFilterPrivate::ignoringLine(QByteArrayView line, QByteArrayView commentCharacter) {
+	return line.isEmpty() || line == "\n" || line == "\r\n" || (!commentCharacter.isEmpty() && line.startsWith(commentCharacter));
+}
+
 void AsciiFilterPrivate::setDataSource(AbstractDataSource* dataSource) {
 	m_dataSource = dataSource;
 	m_DataContainer = DataContainer();
@@ -722,6 +737,18 @@ AsciiFilter::Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 		}
 	}
 
+	// the converters are created once per import instead of interpreting the locale and the date-time format for every value
+	m_numberParser = NumberParser(properties.locale);
+	m_dateTimeParser = DateTimeParser(properties.dateTimeFormat, properties.baseYear);
+	if (m_dateTimeParser.isValid()) {
+		// the values are written in UTC without QDateTime, which sets the time zone of the container otherwise
+		for (int i = 0; i < m_DataContainer.size(); ++i) {
+			const auto mode = m_DataContainer.columnMode(i);
+			if (mode == AbstractColumn::ColumnMode::DateTime || mode == AbstractColumn::ColumnMode::Month || mode == AbstractColumn::ColumnMode::Day)
+				static_cast<DateTimeVector*>(m_DataContainer.dataContainer().at(i))->setTimeZone(QTimeZone::UTC);
+		}
+	}
+
 	qsizetype dataContainerStartIndex = 0;
 	if (rowImportMode == AbstractFileFilter::ImportMode::Replace) {
 		// Replace all rows
@@ -753,6 +780,21 @@ AsciiFilter::Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 	if (device.atEnd() && !device.isSequential())
 		return handleError(Status::DeviceAtEnd); // File empty
 
+	qsizetype rowIndex = dataContainerStartIndex;
+	auto* file = dynamic_cast<QFile*>(&device);
+	if (file && parallelImport(device, lines, keepNRows, skipFirstLine)) {
+		const qint64 size = file->size() - from;
+		if (auto* data = file->map(from, size)) {
+			const auto status = readFromMappedFile(QByteArrayView(data, size), rowIndex);
+			file->unmap(data);
+			if (status != Status::Success)
+				return handleError(status);
+			bytes_read = size;
+			return finishImport(columnImportMode, rowImportMode, dataContainerStartIndex, rowIndex, keepNRows);
+		}
+		// the file is read line by line if it can't be mapped
+	}
+
 	QString line;
 	if (skipFirstLine) {
 		const auto status = getLine(device, line);
@@ -762,7 +804,6 @@ AsciiFilter::Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 
 	int counter = 0;
 	int startDataRow = 1;
-	int rowIndex = dataContainerStartIndex;
 	const size_t columnCountExpected = m_DataContainer.size() - properties.createIndex - properties.createTimestamp;
 	QVector<QStringView> columnValues(columnCountExpected);
 	const auto separatorLength = properties.separator.size();
@@ -808,13 +849,13 @@ AsciiFilter::Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 			const auto& values = determineColumnsSimplifyWhiteSpace(line, properties);
 			if ((size_t)values.size() < columnCountExpected)
 				continue; // return Status::InvalidNumberDataColumns;
-			setValues(values, rowIndex, properties);
+			setValues(m_DataContainer, values, rowIndex);
 		} else {
 			// Higher performance if no whitespaces are available
 			const auto columnCount = determineColumns(line, properties, separatorSingleCharacter, separatorCharacter, columnValues);
 			if (columnCount < columnCountExpected)
 				continue; // return Status::InvalidNumberDataColumns;
-			setValues(columnValues, rowIndex, properties);
+			setValues(m_DataContainer, columnValues, rowIndex);
 		}
 
 		rowIndex++;
@@ -844,20 +885,219 @@ AsciiFilter::Status AsciiFilterPrivate::readFromDevice(QIODevice& device,
 
 	} while (true);
 
-	int removedRows = rowIndex - keepNRows;
+	return finishImport(columnImportMode, rowImportMode, dataContainerStartIndex, rowIndex, keepNRows);
+}
+
+/*!
+ * shrinks the data containers to the \c rowCount imported rows, keeps only the last \c keepNRows rows if positive
+ * and finalizes the import of the data source.
+ */
+AsciiFilter::Status AsciiFilterPrivate::finishImport(AbstractFileFilter::ImportMode columnImportMode,
+													 AbstractFileFilter::ImportMode rowImportMode,
+													 qsizetype dataContainerStartIndex,
+													 qsizetype rowCount,
+													 qint64 keepNRows) {
+	const auto removedRows = rowCount - keepNRows;
 	if (keepNRows > 0 && removedRows > 0) {
 		// Just keep the last n rows
 		m_DataContainer.removeFirst(removedRows);
 		m_DataContainer.resize(keepNRows);
-	} else
-		m_DataContainer.resize(rowIndex);
+	} else {
+		m_DataContainer.resize(rowCount);
+
+		// the rows read before were not changed, the cached values of the columns for them stay valid
+		auto* spreadsheet = dynamic_cast<Spreadsheet*>(m_dataSource);
+		if (spreadsheet && rowImportMode == AbstractFileFilter::ImportMode::Append)
+			spreadsheet->setFirstAppendedRowFinalizeImport(dataContainerStartIndex);
+	}
 
 	m_dataSource->finalizeImport(0, 0, properties.columnNames.size() - 1, properties.dateTimeFormat, columnImportMode);
-	return Status::Success;
+	return AsciiFilter::Status::Success;
+}
+
+/*!
+ * returns \c true if the data of \c device is imported in parallel from the memory mapped file instead of line by line.
+ * This is done for large regular files if the lines are split by the fast path of \c determineColumns()
+ * and if all remaining rows of the file are read.
+ */
+bool AsciiFilterPrivate::parallelImport(const QIODevice& device, qint64 lines, qint64 keepNRows, bool skipFirstLine) const {
+	const auto* file = dynamic_cast<const QFile*>(&device);
+	if (!file || device.isSequential() || file->size() < parallelImportMinSize)
+		return false;
+	if (lines >= 0 || keepNRows > 0 || skipFirstLine || properties.simplifyWhitespaces)
+		return false;
+
+	// the separator is searched in the bytes of the lines
+	for (const auto c : properties.separator) {
+		if (c.unicode() >= 0x80)
+			return false;
+	}
+	return true;
+}
+
+/*!
+ * imports the lines in \c data into the data containers starting at the row \c rowIndex, \c rowIndex is set to the number of rows afterwards.
+ *
+ * The header and the skipped rows at the beginning are handled sequentially. The remaining data is split at line ends
+ * into chunks, which are parsed in parallel into separate data containers straight from the UTF-8 encoded bytes.
+ * The chunks are processed in batches and moved into the data containers in the order of the file after every batch.
+ */
+AsciiFilter::Status AsciiFilterPrivate::readFromMappedFile(QByteArrayView data, qsizetype& rowIndex) {
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	const auto commentCharacter = properties.commentCharacter.toUtf8();
+
+	// skip the header and the rows before the start row like the sequential import
+	qsizetype position = 0;
+	int counter = 0;
+	int startDataRow = 1;
+	while (position < data.size()) {
+		const auto* newline = static_cast<const char*>(std::memchr(data.data() + position, '\n', data.size() - position));
+		const qsizetype end = newline ? newline - data.data() + 1 : data.size();
+		const auto line = data.sliced(position, end - position);
+		if (ignoringLine(line, commentCharacter)) {
+			position = end;
+			continue;
+		}
+
+		counter++;
+		if (properties.headerEnabled && properties.headerLine > 0 && counter <= properties.headerLine) {
+			if (counter == properties.headerLine)
+				startDataRow = counter + 1;
+			position = end;
+			continue;
+		}
+		if ((counter - startDataRow + 1) < properties.startRow) {
+			position = end;
+			continue;
+		}
+		break;
+	}
+
+	// split the data into chunks ending at line ends
+	const int threads = std::max(QThreadPool::globalInstance()->maxThreadCount(), 1);
+	const qsizetype chunkSize = std::clamp((data.size() - position) / (4 * threads), qsizetype(64 * 1024), qsizetype(4 * 1024 * 1024));
+	QVector<QByteArrayView> chunks;
+	while (position < data.size()) {
+		qsizetype end = std::min(position + chunkSize, data.size());
+		if (end < data.size()) {
+			const auto* newline = static_cast<const char*>(std::memchr(data.data() + end, '\n', data.size() - end));
+			end = newline ? newline - data.data() + 1 : data.size();
+		}
+		chunks << data.sliced(position, end - position);
+		position = end;
+	}
+
+	const int batchSize = 4 * threads;
+	for (int batchStart = 0; batchStart < chunks.size(); batchStart += batchSize) {
+		const int batchEnd = std::min(batchStart + batchSize, static_cast<int>(chunks.size()));
+		std::vector<DataContainer> containers(batchEnd - batchStart);
+		std::vector<qsizetype> offsets(containers.size() + 1, rowIndex);
+		Parallel::forRanges(batchEnd - batchStart, 1, [&](int start, int end) {
+			for (int i = start; i < end; ++i)
+				offsets[i + 1] = readChunk(chunks.at(batchStart + i), containers[i]);
+		});
+
+		bool enoughMemory = true;
+		for (size_t i = 0; i < containers.size(); ++i) {
+			enoughMemory = enoughMemory && offsets[i + 1] >= 0;
+			offsets[i + 1] += offsets[i];
+		}
+		try {
+			const auto rowCount = offsets.back();
+			if (enoughMemory && rowCount > m_DataContainer.rowCount())
+				m_DataContainer.resize(std::max(rowCount, 2 * static_cast<qsizetype>(m_DataContainer.rowCount())));
+		} catch (std::bad_alloc&) {
+			enoughMemory = false;
+		}
+		if (!enoughMemory) {
+			for (auto& container : containers)
+				container.clear();
+			return AsciiFilter::Status::NotEnoughMemory;
+		}
+
+		// the vectors are detached here, the tasks only write to their rows of the data
+		const auto dataPointers = m_DataContainer.dataPointers();
+		Parallel::forRanges(static_cast<int>(containers.size()), 1, [&](int start, int end) {
+			for (int i = start; i < end; ++i) {
+				m_DataContainer.moveRows(dataPointers, offsets[i], containers[i]);
+				containers[i].clear();
+			}
+		});
+
+		// the index and the timestamp are set in the order of the rows
+		for (auto row = rowIndex; row < offsets.back(); ++row) {
+			if (properties.createIndex) {
+				m_DataContainer.setData(0, row, m_index);
+				m_index++;
+			}
+			if (properties.createTimestamp)
+				m_DataContainer.setData(properties.createIndex, row, QDateTime::currentDateTime());
+		}
+		rowIndex = offsets.back();
+
+		const auto read = chunks.at(batchEnd - 1).data() + chunks.at(batchEnd - 1).size() - data.data();
+		Q_EMIT q->completed(static_cast<int>(100. * read / data.size()));
+		QApplication::processEvents(QEventLoop::AllEvents, 0);
+	}
+
+	return AsciiFilter::Status::Success;
+}
+
+/*!
+ * parses the lines of \c chunk into the new data container \c dataContainer, returns the number of rows or -1 if there is not enough memory.
+ * Called in parallel for different chunks, the filter is not modified.
+ */
+qsizetype AsciiFilterPrivate::readChunk(QByteArrayView chunk, DataContainer& dataContainer) const {
+	try {
+		// same columns as the data containers of the data source
+		for (int i = 0; i < m_DataContainer.size(); ++i)
+			dataContainer.appendVector(m_DataContainer.columnMode(i));
+		dataContainer.resize(1024);
+
+		const auto commentCharacter = properties.commentCharacter.toUtf8();
+		const auto separator = properties.separator.toLatin1();
+		const size_t columnCountExpected = m_DataContainer.size() - properties.createIndex - properties.createTimestamp;
+		QVector<QByteArrayView> columnValues(columnCountExpected);
+
+		qsizetype rowIndex = 0;
+		qsizetype position = 0;
+		while (position < chunk.size()) {
+			const auto* newline = static_cast<const char*>(std::memchr(chunk.data() + position, '\n', chunk.size() - position));
+			const qsizetype end = newline ? newline - chunk.data() + 1 : chunk.size();
+			const auto line = chunk.sliced(position, end - position);
+			position = end;
+
+			if (ignoringLine(line, commentCharacter))
+				continue;
+			if (determineColumns(line, properties, separator, columnValues) < columnCountExpected)
+				continue;
+
+			if (rowIndex >= dataContainer.rowCount())
+				dataContainer.resize(2 * dataContainer.rowCount());
+			setValues(dataContainer, columnValues, rowIndex);
+			rowIndex++;
+		}
+
+		dataContainer.resize(rowIndex);
+		return rowIndex;
+	} catch (std::bad_alloc&) {
+		return -1;
+	}
+}
+
+namespace {
+// Conversion of date-times not supported by the DateTimeParser, the values of the parallel import are UTF-8 encoded bytes
+QDateTime toDateTime(QStringView value, const AsciiFilter::Properties& properties) {
+	return QDateTime::fromString(value, properties.dateTimeFormat, properties.baseYear);
+}
+
+QDateTime toDateTime(QByteArrayView value, const AsciiFilter::Properties& properties) {
+	return QDateTime::fromString(QString::fromUtf8(value), properties.dateTimeFormat, properties.baseYear);
+}
 }
 
 template<typename T>
-void AsciiFilterPrivate::setValues(const QVector<T>& values, int rowIndex, const AsciiFilter::Properties& properties) {
+void AsciiFilterPrivate::setValues(DataContainer& dataContainer, const QVector<T>& values, int rowIndex) const {
 	int columnIndex = 0 + properties.createIndex + properties.createTimestamp;
 	// Iterate over all columns
 	for (const auto& value : values) {
@@ -866,38 +1106,44 @@ void AsciiFilterPrivate::setValues(const QVector<T>& values, int rowIndex, const
 			return;
 		switch (properties.columnModes[columnIndex]) {
 		case AbstractColumn::ColumnMode::Double: {
-			double d = properties.locale.toDouble(value, &conversionOk);
+			double d = m_numberParser.toDouble(value, &conversionOk);
 			if (!conversionOk) {
 				d = properties.nanValue;
 			}
-			m_DataContainer.setData(columnIndex, rowIndex, d);
+			dataContainer.setData(columnIndex, rowIndex, d);
 			break;
 		}
 		case AbstractColumn::ColumnMode::Integer: {
-			int i = properties.locale.toInt(value, &conversionOk);
+			int i = m_numberParser.toInt(value, &conversionOk);
 			if (!conversionOk) {
 				i = 0;
 			}
-			m_DataContainer.setData(columnIndex, rowIndex, i);
+			dataContainer.setData(columnIndex, rowIndex, i);
 			break;
 		}
 		case AbstractColumn::ColumnMode::BigInt: {
-			qint64 i = properties.locale.toLongLong(value, &conversionOk);
+			qint64 i = m_numberParser.toLongLong(value, &conversionOk);
 			if (!conversionOk) {
 				i = 0;
 			}
-			m_DataContainer.setData(columnIndex, rowIndex, i);
+			dataContainer.setData(columnIndex, rowIndex, i);
 			break;
 		}
 		case AbstractColumn::ColumnMode::Text:
-			m_DataContainer.setData(columnIndex, rowIndex, value); // Because value can be QString or QStringView
+			dataContainer.setData(columnIndex, rowIndex, value); // Because value can be QString, QStringView or QByteArrayView
 			break;
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::DateTime: {
-			auto dt = QDateTime::fromString(value, properties.dateTimeFormat, properties.baseYear);
+			// formats supported by the parser are converted into the milliseconds since the epoch directly
+			qint64 msecs;
+			if (m_dateTimeParser.toMSecsSinceEpoch(value, msecs)) {
+				dataContainer.setMSecsSinceEpoch(columnIndex, rowIndex, msecs);
+				break;
+			}
+			auto dt = toDateTime(value, properties);
 			dt.setTimeSpec(Qt::UTC);
-			m_DataContainer.setData(columnIndex, rowIndex, dt);
+			dataContainer.setData(columnIndex, rowIndex, dt);
 			break;
 		}
 		}
@@ -1067,6 +1313,103 @@ size_t AsciiFilterPrivate::determineColumns(const QStringView& line,
 	return columnIndex;
 }
 
+/*!
+ * splits the UTF-8 encoded \c line like \c determineColumns() for strings, used by the parallel import.
+ * The separator consists of ASCII characters, which are never part of encoded non ASCII characters.
+ * Only the bytes that can end a value or the line (line ends, quotes and the last character of the separator)
+ * are examined, the bytes between them are skipped with \c ByteScanner::findAny().
+ */
+size_t AsciiFilterPrivate::determineColumns(QByteArrayView line,
+											const AsciiFilter::Properties& properties,
+											QByteArrayView separator,
+											QVector<QByteArrayView>& columnValues) {
+	enum class State {
+		Column,
+		QuotedText,
+	};
+
+	const char separatorCharacter = separator.isEmpty() ? '\n' : separator.back();
+	const char quoteCharacter = properties.removeQuotes ? '"' : '\n';
+	const auto maxColumnCount = columnValues.size();
+	auto state = State::Column;
+	int columnCount = 1;
+	bool separatorLast = false;
+	qsizetype counter = 0; // Number of bytes examined
+	qsizetype startColumnIndex = 0; // Start of the column value
+	qsizetype numberCharacters = 0; // Number of bytes of the column value
+	int columnIndex = 0;
+	const char* const begin = line.data();
+	const char* const end = begin + line.size();
+	while (counter < line.size()) {
+		// skip the bytes without special meaning
+		const auto* next = ByteScanner::findAny(begin + counter, end, '\n', '\r', quoteCharacter, separatorCharacter);
+		if (next != begin + counter) {
+			numberCharacters += next - begin - counter;
+			if (state == State::Column)
+				separatorLast = false;
+			counter = next - begin;
+		}
+		if (next == end)
+			break;
+
+		const char c = *next;
+		counter++;
+		if (c == '\n' || c == '\r')
+			break;
+		if (properties.removeQuotes && c == '"') {
+			switch (state) {
+			case State::Column:
+				state = State::QuotedText;
+				startColumnIndex = counter;
+				numberCharacters = 0;
+				continue;
+			case State::QuotedText:
+				state = State::Column;
+				continue;
+			}
+		}
+
+		switch (state) {
+		case State::Column: {
+			bool separatorFound;
+			if (separator.size() == 1)
+				separatorFound = true; // the only remaining special byte
+			else
+				separatorFound = !separator.isEmpty() && line.sliced(startColumnIndex, counter - startColumnIndex).endsWith(separator);
+			if (separatorFound) {
+				separatorLast = true;
+				const auto value = line.sliced(startColumnIndex, numberCharacters);
+				if (!properties.skipEmptyParts || !value.isEmpty()) {
+					if (columnCount >= properties.startColumn && (columnCount <= properties.endColumn || properties.endColumn < 0)
+						&& columnIndex < maxColumnCount) {
+						columnValues[columnIndex] = value;
+						columnIndex++;
+					}
+					columnCount++;
+				}
+				startColumnIndex = counter;
+				numberCharacters = 0;
+			} else {
+				separatorLast = false;
+				numberCharacters++;
+			}
+			break;
+		}
+		case State::QuotedText:
+			numberCharacters++;
+			break;
+		}
+	}
+	if (columnCount >= properties.startColumn && (columnCount <= properties.endColumn || properties.endColumn < 0)) {
+		// After the separator the line was finished, but there should be a value so add a placeholder (invalid value)
+		if ((numberCharacters != 0 || (!properties.skipEmptyParts && separatorLast)) && columnIndex < maxColumnCount) {
+			columnValues[columnIndex] = line.sliced(startColumnIndex, numberCharacters);
+			return columnIndex + 1;
+		}
+	}
+	return columnIndex;
+}
+
 QStringList AsciiFilterPrivate::determineColumnsSimplifyWhiteSpace(QStringView line,
 																   const QString& separator,
 																   bool removeQuotes,
@@ -1462,12 +1805,72 @@ void AsciiFilterPrivate::DataContainer::removeFirst(int n) {
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::DateTime:
-			static_cast<QVector<QDateTime>*>(m_dataContainer[i])->remove(0, n);
+			static_cast<DateTimeVector*>(m_dataContainer[i])->remove(0, n);
 			break;
 		}
 	}
 }
 
+std::vector<void*> AsciiFilterPrivate::DataContainer::dataPointers() const {
+	std::vector<void*> data(m_dataContainer.size());
+	for (size_t i = 0; i < m_dataContainer.size(); i++) {
+		switch (m_columnModes.at(i)) {
+		case AbstractColumn::ColumnMode::BigInt:
+			data[i] = static_cast<QVector<qint64>*>(m_dataContainer[i])->data();
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			data[i] = static_cast<QVector<qint32>*>(m_dataContainer[i])->data();
+			break;
+		case AbstractColumn::ColumnMode::Double:
+			data[i] = static_cast<QVector<double>*>(m_dataContainer[i])->data();
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			data[i] = static_cast<QVector<QString>*>(m_dataContainer[i])->data();
+			break;
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::DateTime:
+			data[i] = static_cast<DateTimeVector*>(m_dataContainer[i])->data();
+			break;
+		}
+	}
+	return data;
+}
+
+void AsciiFilterPrivate::DataContainer::moveRows(const std::vector<void*>& data, qsizetype index, const DataContainer& source) const {
+	for (size_t i = 0; i < data.size(); i++) {
+		switch (m_columnModes.at(i)) {
+		case AbstractColumn::ColumnMode::BigInt: {
+			auto* vector = static_cast<QVector<qint64>*>(source.m_dataContainer[i]);
+			std::copy(vector->cbegin(), vector->cend(), static_cast<qint64*>(data[i]) + index);
+			break;
+		}
+		case AbstractColumn::ColumnMode::Integer: {
+			auto* vector = static_cast<QVector<qint32>*>(source.m_dataContainer[i]);
+			std::copy(vector->cbegin(), vector->cend(), static_cast<qint32*>(data[i]) + index);
+			break;
+		}
+		case AbstractColumn::ColumnMode::Double: {
+			auto* vector = static_cast<QVector<double>*>(source.m_dataContainer[i]);
+			std::copy(vector->cbegin(), vector->cend(), static_cast<double*>(data[i]) + index);
+			break;
+		}
+		case AbstractColumn::ColumnMode::Text: {
+			auto* vector = static_cast<QVector<QString>*>(source.m_dataContainer[i]);
+			std::move(vector->begin(), vector->end(), static_cast<QString*>(data[i]) + index);
+			break;
+		}
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::DateTime: {
+			auto* vector = static_cast<DateTimeVector*>(source.m_dataContainer[i]);
+			std::copy(vector->constData(), vector->constData() + vector->size(), static_cast<qint64*>(data[i]) + index);
+			break;
+		}
+		}
+	}
+}
+
 bool AsciiFilterPrivate::DataContainer::resize(qsizetype s) const {
 	for (unsigned long i = 0; i < m_dataContainer.size(); i++) {
 		switch (m_columnModes.at(i)) {
@@ -1487,7 +1890,7 @@ bool AsciiFilterPrivate::DataContainer::resize(qsizetype s) const {
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::DateTime:
-			static_cast<QVector<QDateTime>*>(m_dataContainer[i])->resize(s);
+			static_cast<DateTimeVector*>(m_dataContainer[i])->resize(s);
 			break;
 		}
 	}
@@ -1525,7 +1928,7 @@ bool AsciiFilterPrivate::DataContainer::reserve(qsizetype s) const {
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::DateTime:
-			static_cast<QVector<QDateTime>*>(m_dataContainer[i])->reserve(s);
+			static_cast<DateTimeVector*>(m_dataContainer[i])->reserve(s);
 			break;
 		}
 	}
@@ -1563,7 +1966,7 @@ void AsciiFilterPrivate::DataContainer::appendVector(AbstractColumn::ColumnMode
 	case AbstractColumn::ColumnMode::DateTime:
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
-		vector = new QVector<QDateTime>();
+		vector = new DateTimeVector();
 		break;
 	}
 
@@ -1591,7 +1994,7 @@ int AsciiFilterPrivate::DataContainer::rowCount(unsigned long index) const {
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::DateTime:
-		return static_cast<QVector<QDateTime>*>(m_dataContainer[index])->size();
+		return static_cast<DateTimeVector*>(m_dataContainer[index])->size();
 		break;
 	}
 	assert(false);
@@ -1614,11 +2017,13 @@ void AsciiFilterPrivate::DataContainer::clear() {
 		case AbstractColumn::ColumnMode::Double:
 			delete static_cast<QVector<double>*>(m_dataContainer[i]);
 			break;
-		// TODO: implement missing cases
 		case AbstractColumn::ColumnMode::Text:
+			delete static_cast<QVector<QString>*>(m_dataContainer[i]);
+			break;
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::DateTime:
+			delete static_cast<DateTimeVector*>(m_dataContainer[i]);
 			break;
 		}
 	}
@@ -10,10 +10,13 @@
 #ifndef ASCIIFILTERPRIVATE_H
 #define ASCIIFILTERPRIVATE_H
 
+#include <QByteArrayView>
 #include <QLocale>
 #include <QString>
 
 #include "AsciiFilter.h"
+#include "backend/lib/DateTimeVector.h"
+#include "backend/lib/ValueParser.h"
 
 class AsciiFilterPrivate {
 public:
@@ -63,9 +66,6 @@ private:
 	AsciiFilter::Status getLine(QIODevice& device, QString& line);
 	static QString statusToString(AsciiFilter::Status);
 
-	template<typename T>
-	void setValues(const QVector<T>& values, int rowIndex, const AsciiFilter::Properties& properties);
-
 	// Copied from CANFilterPrivate
 	// TODO: think about moving it to a common place
 	struct DataContainer {
@@ -86,6 +86,10 @@ private:
 
 		// Removes the first n elements
 		void removeFirst(int n);
+		// Returns the pointers to the data of the columns, detaching shared vectors. Valid until the containers are changed
+		std::vector<void*> dataPointers() const;
+		// Moves all rows of source with the same column modes to the rows starting at index of the columns with the data pointers
+		void moveRows(const std::vector<void*>& data, qsizetype index, const DataContainer& source) const;
 
 		template<class T>
 		void setData(int indexDataContainer, int indexData, T value) {
@@ -96,6 +100,18 @@ private:
 			static_cast<QVector<QString>*>(m_dataContainer.at(indexDataContainer))->operator[](indexData) = value.toString();
 		}
 
+		void setData(int indexDataContainer, int indexData, const QByteArrayView& value) {
+			static_cast<QVector<QString>*>(m_dataContainer.at(indexDataContainer))->operator[](indexData) = QString::fromUtf8(value);
+		}
+
+		void setData(int indexDataContainer, int indexData, const QDateTime& value) {
+			static_cast<DateTimeVector*>(m_dataContainer.at(indexDataContainer))->replace(indexData, value);
+		}
+
+		void setMSecsSinceEpoch(int indexDataContainer, int indexData, qint64 value) {
+			static_cast<DateTimeVector*>(m_dataContainer.at(indexDataContainer))->data()[indexData] = value;
+		}
+
 		template<class T>
 		T data(int indexDataContainer, int indexData) {
 			return static_cast<QVector<T>*>(m_dataContainer.at(indexDataContainer))->at(indexData);
@@ -120,7 +136,24 @@ private:
 		std::vector<void*> m_dataContainer; // pointers to the actual data containers
 	};
 
+	AsciiFilter::Status finishImport(AbstractFileFilter::ImportMode columnImportMode,
+									 AbstractFileFilter::ImportMode rowImportMode,
+									 qsizetype dataContainerStartIndex,
+									 qsizetype rowCount,
+									 qint64 keepNRows);
+	template<typename T>
+	void setValues(DataContainer& dataContainer, const QVector<T>& values, int rowIndex) const;
+
+	// parallel import of memory mapped files
+	bool parallelImport(const QIODevice& device, qint64 lines, qint64 keepNRows, bool skipFirstLine) const;
+	AsciiFilter::Status readFromMappedFile(QByteArrayView data, qsizetype& rowIndex);
+	qsizetype readChunk(QByteArrayView chunk, DataContainer& dataContainer) const;
+	static bool ignoringLine(QByteArrayView line, QByteArrayView commentCharacter);
+	static size_t determineColumns(QByteArrayView line, const AsciiFilter::Properties& properties, QByteArrayView separator, QVector<QByteArrayView>& columnValues);
+
 	DataContainer m_DataContainer;
+	NumberParser m_numberParser; // conversion of the numbers with the locale of the properties
+	DateTimeParser m_dateTimeParser; // conversion of the date-times with the format of the properties
 	qint64 m_index{1}; // Index counter used when a index column was prepended
 	AsciiFilter::Status lastStatus{AsciiFilter::Status::Success};
 	AbstractDataSource* m_dataSource{nullptr};
@@ -129,6 +162,7 @@ private:
 	AsciiFilter* const q;
 	static const qsizetype m_dataTypeLines = 10; // maximum lines to read for determining data types
 	qsizetype numberRowsReallocation = 10000; // When importing new data reallocate that amount of rows. So not for every row it must be reallocated
+	qint64 parallelImportMinSize{1024 * 1024}; // Smallest file size in bytes that is imported in parallel
 
 	friend class AsciiFilterTest;
 };
@@ -15,6 +15,7 @@
 #include "backend/core/column/ColumnStringIO.h"
 #include "backend/core/datatypes/Double2StringFilter.h"
 #include "backend/datasources/AbstractDataSource.h"
+#include "backend/lib/MatrixStorage.h"
 #include "backend/matrix/Matrix.h"
 #include "backend/matrix/MatrixModel.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -326,10 +327,12 @@ FITSFilterPrivate::readCHDU(const QString& fileName, AbstractDataSource* dataSou
 
 		DEBUG("lines/cols = " << lines << " " << actualCols << ", i/j = " << i << " " << j)
 		std::vector<void*> dataContainer;
+		// the values of a matrix are written directly into its storage without intermediate containers for the columns
+		auto* matrix = dynamic_cast<Matrix*>(dataSource);
 		if (dataSource) {
 			dataContainer.reserve(actualCols - j);
 			bool ok = false;
-			columnOffset = dataSource->prepareImport(dataContainer, importMode, lines - i, actualCols - j, vectorNames, columnModes, ok);
+			columnOffset = dataSource->prepareImport(dataContainer, importMode, lines - i, actualCols - j, vectorNames, columnModes, ok, !matrix);
 			if (!ok) {
 				q->setLastError(i18n("Not enough memory."));
 				return {};
@@ -352,6 +355,7 @@ FITSFilterPrivate::readCHDU(const QString& fileName, AbstractDataSource* dataSou
 			return {};
 		}
 
+		auto* storage = matrix ? static_cast<MatrixStorage<double>*>(matrix->data()) : nullptr;
 		int ii = 0;
 		DEBUG("	Import " << lines << " lines");
 		if (!dataSource) // preview
@@ -361,7 +365,9 @@ FITSFilterPrivate::readCHDU(const QString& fileName, AbstractDataSource* dataSou
 			QStringList line;
 			line.reserve(actualCols - j);
 			for (; j < actualCols; ++j) {
-				if (dataSource)
+				if (storage)
+					(*storage)(ii, columnOffset + jj++) = data[i * naxes[0] + j];
+				else if (dataSource)
 					static_cast<QVector<double>*>(dataContainer[jj++])->operator[](ii) = data[i * naxes[0] + j];
 				else
 					line << QString::number(data[i * naxes[0] + j]);
@@ -665,11 +671,11 @@ void FITSFilterPrivate::writeCHDU(const QString& fileName, AbstractDataSource* d
 			}
 			const long nelem = naxes[0] * naxes[1];
 			double* const array = new double[nelem];
-			const QVector<QVector<double>>* const data = static_cast<QVector<QVector<double>>*>(matrix->data());
+			const auto* const data = static_cast<MatrixStorage<double>*>(matrix->data());
 
 			for (int col = 0; col < naxes[0]; ++col)
 				for (int row = 0; row < naxes[1]; ++row)
-					array[row * naxes[0] + col] = data->at(row).at(col);
+					array[row * naxes[0] + col] = data->at(row, col);
 
 			if (fits_write_img(m_fitsFile, TDOUBLE, 1, nelem, array, &status)) {
 				printError(status);
@@ -689,7 +695,7 @@ void FITSFilterPrivate::writeCHDU(const QString& fileName, AbstractDataSource* d
 			tform.resize(tfields);
 			tform.squeeze();
 			// TODO: mode
-			const QVector<QVector<double>>* const matrixData = static_cast<QVector<QVector<double>>*>(matrix->data());
+			const auto* const matrixData = static_cast<MatrixStorage<double>*>(matrix->data());
 #ifndef SDK
 			const MatrixModel* matrixModel = static_cast<MatrixView*>(matrix->view())->model();
 #endif
@@ -743,7 +749,7 @@ void FITSFilterPrivate::writeCHDU(const QString& fileName, AbstractDataSource* d
 
 			double* columnNumeric = new double[nrows];
 			for (int col = 1; col <= tfields; ++col) {
-				const QVector<double>& column = matrixData->at(col - 1);
+				const auto column = matrixData->column(col - 1);
 				for (int r = 0; r < column.size(); ++r)
 					columnNumeric[r] = column.at(r);
 
@@ -9,8 +9,10 @@
 #include "backend/datasources/filters/ImageFilter.h"
 #include "backend/core/column/Column.h"
 #include "backend/datasources/filters/ImageFilterPrivate.h"
+#include "backend/lib/MatrixStorage.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/macros.h"
+#include "backend/matrix/Matrix.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
 #include <KLocalizedString>
@@ -158,9 +160,12 @@ void ImageFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataS
 	// TODO: use given names?
 	QStringList vectorNames;
 
+	// the values of a matrix are written directly into its storage without intermediate containers for the columns
+	auto* matrix = (importFormat == ImageFilter::ImportFormat::MATRIX) ? dynamic_cast<Matrix*>(dataSource) : nullptr;
+
 	if (dataSource) {
 		bool ok = false;
-		columnOffset = dataSource->prepareImport(dataContainer, mode, actualRows, actualCols, vectorNames, columnModes, ok);
+		columnOffset = dataSource->prepareImport(dataContainer, mode, actualRows, actualCols, vectorNames, columnModes, ok, !matrix);
 		if (!ok) {
 			q->setLastError(i18n("Not enough memory."));
 			return;
@@ -173,10 +178,14 @@ void ImageFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataS
 	// read data
 	switch (importFormat) {
 	case ImageFilter::ImportFormat::MATRIX: {
+		auto* storage = matrix ? static_cast<MatrixStorage<double>*>(matrix->data()) : nullptr;
 		for (int i = 0; i < actualRows; ++i) {
 			for (int j = 0; j < actualCols; ++j) {
 				double value = qGray(image.pixel(j + startColumn - 1, i + startRow - 1));
-				static_cast<QVector<double>*>(dataContainer[j])->operator[](i) = value;
+				if (storage)
+					(*storage)(i, columnOffset + j) = value;
+				else
+					static_cast<QVector<double>*>(dataContainer[j])->operator[](i) = value;
 			}
 			Q_EMIT q->completed(100 * i / actualRows);
 		}
@@ -13,6 +13,8 @@
 #include "backend/core/column/Column.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/datasources/filters/JsonFilterPrivate.h"
+#include "backend/lib/DateTimeVector.h"
+#include "backend/lib/JsonStreamReader.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/trace.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -20,13 +22,16 @@
 #include <KCompressionDevice>
 #include <KLocalizedString>
 
+#include <QBuffer>
 #include <QDataStream>
 #include <QDateTime>
+#include <QFile>
 #include <QJsonArray>
 #include <QJsonDocument>
 #include <QJsonObject>
 
 #include <cmath>
+#include <numeric>
 
 /*!
 \class JsonFilter
@@ -55,6 +60,14 @@ void JsonFilter::readDataFromFile(const QString& fileName, AbstractDataSource* d
 	d->readDataFromFile(fileName, dataSource, importMode);
 }
 
+/*!
+reads the documents of JSON Lines data in \c device, starting at the position \c from for files, and appends them to \c dataSource.
+Only the last \c keepNRows rows are kept if positive. Returns the number of bytes read.
+*/
+qint64 JsonFilter::readFromLiveDevice(QIODevice& device, AbstractDataSource* dataSource, qint64 from, int keepNRows) {
+	return d->readFromLiveDevice(device, dataSource, from, keepNRows);
+}
+
 QVector<QStringList> JsonFilter::preview(const QString& fileName, int lines) {
 	return d->preview(fileName, lines);
 }
@@ -191,18 +204,29 @@ QString JsonFilter::fileInfoString(const QString& fileName) {
 	if (device.atEnd() && !device.isSequential())
 		return i18n("Empty file");
 
-	QJsonParseError err;
-	QJsonDocument doc = QJsonDocument::fromJson(device.readAll(), &err);
-
-	if (err.error != QJsonParseError::NoError || doc.isEmpty())
-		return i18n("Parse error: %1 at offset %2", err.errorString(), err.offset);
+	// the document is only validated and not kept in memory
+	const bool jsonLines = JsonFilterPrivate::isJsonLines(device);
+	device.seek(0);
+	JsonStreamReader reader(&device);
+	reader.setJsonLines(jsonLines);
+	int documents = 0;
+	reader.readNext();
+	if (jsonLines) {
+		while (reader.readNext() != JsonStreamReader::TokenType::EndArray && reader.skipCurrentValue())
+			++documents;
+	} else if (reader.skipCurrentValue())
+		reader.readNext(); // only whitespaces are allowed after the document
+
+	if (reader.hasError())
+		return i18n("Parse error: %1", reader.errorString());
 
 	QString info;
-	info += i18n("Valid JSON document");
+	if (jsonLines)
+		info += i18n("Valid JSON Lines data with %1 documents", documents);
+	else
+		info += i18n("Valid JSON document");
 
 	// TODO: get number of object, etc.
-	// if (prepareDocumentToRead(doc) != 0)
-	//	return info;
 
 	// reset to start of file
 	if (!device.isSequential())
@@ -218,40 +242,10 @@ JsonFilterPrivate::JsonFilterPrivate(JsonFilter* owner)
 	: q(owner) {
 }
 
-/*!
-returns 1 if row is invalid and 0 otherwise.
-*/
-int JsonFilterPrivate::checkRow(QJsonValueRef value, int& countCols) {
-	switch (rowType) {
-	// TODO: implement other value types
-	case QJsonValue::Array: {
-		QJsonArray row = value.toArray();
-		if (row.isEmpty())
-			return 1;
-		countCols = (countCols == -1 || countCols > row.count()) ? row.count() : countCols;
-		break;
-	}
-	case QJsonValue::Object: {
-		QJsonObject row = value.toObject();
-		if (row.isEmpty())
-			return 1;
-		countCols = (countCols == -1 || countCols > row.count()) ? row.count() : countCols;
-		break;
-	}
-	case QJsonValue::Double:
-	case QJsonValue::String:
-	case QJsonValue::Bool:
-	case QJsonValue::Null:
-	case QJsonValue::Undefined:
-		return 1;
-	}
-	return 0;
-}
-
 /*!
 returns -1 if a parse error has occurred, 1 if the current row type not supported and 0 otherwise.
 */
-int JsonFilterPrivate::parseColumnModes(const QJsonValue& row, const QString& rowName) {
+int JsonFilterPrivate::parseColumnModes(const QVector<QJsonValue>& row, const QStringList& keys, const QString& rowName) {
 	columnModes.clear();
 	vectorNames.clear();
 
@@ -277,19 +271,13 @@ int JsonFilterPrivate::parseColumnModes(const QJsonValue& row, const QString& ro
 
 	// determine the column modes and names
 	for (int i = startColumn - 1; i < endColumn; ++i) {
-		QJsonValue columnValue;
 		switch (rowType) {
-		case QJsonValue::Array: {
-			columnValue = *(row.toArray().begin() + i);
+		case QJsonValue::Array:
 			vectorNames << i18n("Column %1", QString::number(i + 1));
 			break;
-		}
-		case QJsonValue::Object: {
-			QString key = row.toObject().keys().at(i);
-			vectorNames << key;
-			columnValue = row.toObject().value(key);
+		case QJsonValue::Object:
+			vectorNames << keys.at(i);
 			break;
-		}
 		// TODO: implement other value types
 		case QJsonValue::Double:
 		case QJsonValue::String:
@@ -299,6 +287,7 @@ int JsonFilterPrivate::parseColumnModes(const QJsonValue& row, const QString& ro
 			return 1;
 		}
 
+		const auto& columnValue = row.at(i);
 		switch (columnValue.type()) {
 		case QJsonValue::Double:
 			columnModes << AbstractColumn::ColumnMode::Double;
@@ -330,7 +319,7 @@ void JsonFilterPrivate::setEmptyValue(int column, int row) {
 		static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = 0;
 		break;
 	case AbstractColumn::ColumnMode::DateTime:
-		static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) = QDateTime();
+		static_cast<DateTimeVector*>(m_dataContainer[column])->operator[](row) = QDateTime();
 		break;
 	case AbstractColumn::ColumnMode::Text:
 		static_cast<QVector<QString>*>(m_dataContainer[column])->operator[](row) = QString();
@@ -341,30 +330,50 @@ void JsonFilterPrivate::setEmptyValue(int column, int row) {
 	}
 }
 
+void JsonFilterPrivate::setValue(int column, int row, const QJsonValue& value) {
+	switch (value.type()) {
+	case QJsonValue::Double:
+		if (columnModes.at(column) == AbstractColumn::ColumnMode::Double)
+			static_cast<QVector<double>*>(m_dataContainer[column])->operator[](row) = value.toDouble();
+		else
+			setEmptyValue(column, row);
+		break;
+	case QJsonValue::String:
+		setValueFromString(column, row, value.toString());
+		break;
+	case QJsonValue::Array:
+	case QJsonValue::Object:
+	case QJsonValue::Bool:
+	case QJsonValue::Null:
+	case QJsonValue::Undefined:
+		setEmptyValue(column, row);
+		break;
+	}
+}
+
 void JsonFilterPrivate::setValueFromString(int column, int row, const QString& valueString) {
-	QLocale locale(numberFormat);
 	switch (columnModes.at(column)) {
 	case AbstractColumn::ColumnMode::Double: {
 		bool isNumber;
-		const double value = locale.toDouble(valueString, &isNumber);
+		const double value = m_numberParser.toDouble(QStringView(valueString), &isNumber);
 		static_cast<QVector<double>*>(m_dataContainer[column])->operator[](row) = isNumber ? value : nanValue;
 		break;
 	}
 	case AbstractColumn::ColumnMode::Integer: {
 		bool isNumber;
-		const int value = locale.toInt(valueString, &isNumber);
+		const int value = m_numberParser.toInt(QStringView(valueString), &isNumber);
 		static_cast<QVector<int>*>(m_dataContainer[column])->operator[](row) = isNumber ? value : 0;
 		break;
 	}
 	case AbstractColumn::ColumnMode::BigInt: {
 		bool isNumber;
-		const qint64 value = locale.toLongLong(valueString, &isNumber);
+		const qint64 value = m_numberParser.toLongLong(QStringView(valueString), &isNumber);
 		static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = isNumber ? value : 0;
 		break;
 	}
 	case AbstractColumn::ColumnMode::DateTime: {
 		const QDateTime valueDateTime = QDateTime::fromString(valueString, dateTimeFormat);
-		static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) = valueDateTime.isValid() ? valueDateTime : QDateTime();
+		static_cast<DateTimeVector*>(m_dataContainer[column])->operator[](row) = valueDateTime.isValid() ? valueDateTime : QDateTime();
 		break;
 	}
 	case AbstractColumn::ColumnMode::Text:
@@ -382,7 +391,7 @@ void JsonFilterPrivate::setValueFromString(int column, int row, const QString& v
 int JsonFilterPrivate::prepareDeviceToRead(QIODevice& device) {
 	DEBUG(Q_FUNC_INFO << ", device is sequential = " << device.isSequential());
 
-	if (!device.open(QIODevice::ReadOnly)) {
+	if (!device.isOpen() && !device.open(QIODevice::ReadOnly)) {
 		q->setLastError(i18n("Failed to open the device/file."));
 		return -1;
 	}
@@ -392,109 +401,208 @@ int JsonFilterPrivate::prepareDeviceToRead(QIODevice& device) {
 		return 1;
 	}
 
-	QJsonParseError err;
-	m_doc = QJsonDocument::fromJson(device.readAll(), &err);
+	return 0;
+}
 
-	if (err.error != QJsonParseError::NoError || m_doc.isEmpty()) {
-		q->setLastError(i18n("JSON format error or document empty."));
-		return 1;
+/*!
+ * returns \c true if the data of \c device consists of several JSON documents separated by line ends (JSON Lines),
+ * i.e. if the first line is a complete document followed by more data.
+ */
+bool JsonFilterPrivate::isJsonLines(QIODevice& device) {
+	device.seek(0);
+	// the first line is read completely, the first document can be of any size
+	const auto line = device.readLine();
+	bool moreData = false;
+	if (line.endsWith('\n')) {
+		while (!moreData && !device.atEnd())
+			moreData = !device.read(64 * 1024).trimmed().isEmpty();
 	}
+	device.seek(0);
+	if (!moreData)
+		return false;
 
-	// reset to start of file
-	if (!device.isSequential())
-		device.seek(0);
+	QJsonParseError error;
+	QJsonDocument::fromJson(line, &error);
+	return error.error == QJsonParseError::NoError;
+}
 
-	return 0;
+/*!
+ * returns the indices of the members of an object with the keys \c keys in the order of \c QJsonObject and \c QJsonModel,
+ * i.e. sorted by their keys. Of several members with the same key only the last one is kept.
+ */
+QVector<int> JsonFilterPrivate::keyOrder(const QStringList& keys) {
+	QVector<int> order(keys.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [&keys](int a, int b) {
+		return keys.at(a) < keys.at(b);
+	});
+
+	QVector<int> uniqueOrder;
+	uniqueOrder.reserve(order.size());
+	for (int i = 0; i < order.size(); ++i) {
+		if (i + 1 < order.size() && keys.at(order.at(i)) == keys.at(order.at(i + 1)))
+			continue;
+		uniqueOrder << order.at(i);
+	}
+	return uniqueOrder;
 }
 
 /*!
-	determines the relevant part of the full JSON document to be read and its structure.
+	determines the position of the array or object selected with \c modelRows in \c device, the document isn't parsed into
+	a \c QJsonDocument for this. The members of objects are counted in the order of their keys like in \c QJsonModel.
 	returns \c true if successful, \c false otherwise.
 */
-bool JsonFilterPrivate::prepareDocumentToRead() {
-	PERFTRACE(QStringLiteral("Prepare the JSON document to read"));
-
-	if (modelRows.isEmpty())
-		m_preparedDoc = m_doc;
-	else {
-		if (modelRows.size() == 1)
-			m_preparedDoc = m_doc; // root element selected, use the full document
-		else {
-			// when running tests there is no ImportFileWidget and JsonOptionsWidget available
-			// where the model is created and also passed to JsonFilter. So, we need to create
-			// a model here for in this case.
-			if (!model) {
-				model = new QJsonModel();
-				model->loadJson(m_doc);
+bool JsonFilterPrivate::locateContainer(QIODevice& device) {
+	const bool jsonLines = isJsonLines(device);
+	qint64 offset = 0;
+	// the first model row is the root element
+	for (int i = 1; i < modelRows.size(); ++i) {
+		device.seek(offset);
+		JsonStreamReader reader(&device);
+		reader.setJsonLines(jsonLines && i == 1);
+		const auto type = reader.readNext();
+		const int row = modelRows.at(i);
+		offset = -1;
+		if (type == JsonStreamReader::TokenType::StartArray) {
+			for (int index = 0; reader.readNext() != JsonStreamReader::TokenType::EndArray && !reader.hasError(); ++index) {
+				if (index == row) {
+					offset = reader.offset();
+					break;
+				}
+				reader.skipCurrentValue();
+			}
+		} else if (type == JsonStreamReader::TokenType::StartObject) {
+			QStringList keys;
+			QVector<qint64> offsets;
+			while (reader.readNext() != JsonStreamReader::TokenType::EndObject && !reader.hasError()) {
+				keys << reader.key();
+				offsets << reader.offset();
+				reader.skipCurrentValue();
 			}
+			const auto order = keyOrder(keys);
+			if (!reader.hasError() && row >= 0 && row < order.size())
+				offset = offsets.at(order.at(row));
+		}
 
-			QModelIndex index;
-			for (auto& it : modelRows)
-				index = model->index(it, 0, index);
+		if (reader.hasError())
+			q->setLastError(reader.errorString());
+		if (offset < 0)
+			return false;
+	}
 
-			m_preparedDoc = model->genJsonByIndex(index);
-		}
+	m_containerOffset = offset;
+	m_jsonLines = jsonLines && modelRows.size() <= 1;
+	return true;
+}
+
+/*!
+ * returns a reader of \c device positioned at the start of the selected container of the rows,
+ * \c nullptr if the selected value is neither an array nor an object.
+ */
+std::unique_ptr<JsonStreamReader> JsonFilterPrivate::containerReader(QIODevice& device) {
+	device.seek(m_containerOffset);
+	auto reader = std::make_unique<JsonStreamReader>(&device);
+	reader->setJsonLines(m_jsonLines);
+	switch (reader->readNext()) {
+	case JsonStreamReader::TokenType::StartArray:
+		containerType = JsonFilter::DataContainerType::Array;
+		return reader;
+	case JsonStreamReader::TokenType::StartObject:
+		containerType = JsonFilter::DataContainerType::Object;
+		return reader;
+	default:
+		if (reader->hasError())
+			q->setLastError(reader->errorString());
+		return {};
 	}
+}
 
-	if (!m_preparedDoc.isEmpty()) {
-		if (m_preparedDoc.isArray())
-			containerType = JsonFilter::DataContainerType::Array;
-		else if (m_preparedDoc.isObject())
-			containerType = JsonFilter::DataContainerType::Object;
-		else
-			return false;
-	} else
+/*!
+	determines the relevant part of the JSON data to be read and its structure. The rows are only counted
+	without converting their values, the values of the first row determine the columns.
+	returns \c true if successful, \c false otherwise.
+*/
+bool JsonFilterPrivate::prepareContainerToRead(QIODevice& device) {
+	PERFTRACE(QStringLiteral("Prepare the JSON data to read"));
+
+	if (!locateContainer(device))
+		return false;
+	auto reader = containerReader(device);
+	if (!reader)
 		return false;
 
-	int countRows = 0;
-	int countCols = -1;
-	QJsonValue firstRow;
+	QVector<QJsonValue> firstRow;
+	QStringList firstRowKeys;
 	QString firstRowName;
 	importObjectNames = (importObjectNames && (rowType == QJsonValue::Object));
 
 	switch (containerType) {
 	case JsonFilter::DataContainerType::Array: {
-		QJsonArray arr = m_preparedDoc.array();
-		int count = arr.count();
-
-		if (count < startRow)
-			return false;
-
-		int endRowOffset = (endRow == -1 || endRow > count) ? count : endRow;
-		firstRow = *(arr.begin() + (startRow - 1));
-		for (QJsonArray::iterator it = arr.begin() + (startRow - 1); it != arr.begin() + endRowOffset; ++it) {
-			if (checkRow(*it, countCols) != 0)
-				return false;
-			countRows++;
+		int index = 0;
+		int countRows = 0;
+		while (reader->readNext() != JsonStreamReader::TokenType::EndArray && (endRow == -1 || index < endRow)) {
+			if (reader->hasError())
+				break;
+			if (index == startRow - 1) {
+				if (!readRow(*reader, firstRow, &firstRowKeys)) {
+					if (reader->hasError())
+						q->setLastError(reader->errorString());
+					return false;
+				}
+			} else
+				reader->skipCurrentValue();
+			if (index >= startRow - 1)
+				++countRows;
+			++index;
 		}
+		m_actualRows = countRows;
 		break;
 	}
 	case JsonFilter::DataContainerType::Object: {
-		QJsonObject obj = m_preparedDoc.object();
-
-		if (obj.count() < startRow)
-			return false;
-
-		int startRowOffset = startRow - 1;
-		int endRowOffset = (endRow == -1 || endRow > obj.count()) ? obj.count() : endRow;
-		firstRow = *(obj.begin() + startRowOffset);
-		firstRowName = (obj.begin() + startRowOffset).key();
-		for (QJsonObject::iterator it = obj.begin() + startRowOffset; it != obj.begin() + endRowOffset; ++it) {
-			if (checkRow(*it, countCols) != 0)
+		// the rows are ordered by their names like in QJsonObject
+		QStringList keys;
+		QVector<qint64> offsets;
+		while (reader->readNext() != JsonStreamReader::TokenType::EndObject && !reader->hasError()) {
+			keys << reader->key();
+			offsets << reader->offset();
+			reader->skipCurrentValue();
+		}
+		const auto order = keyOrder(keys);
+		const int count = static_cast<int>(order.size());
+		const int endRowOffset = (endRow == -1 || endRow > count) ? count : endRow;
+		m_actualRows = std::max(endRowOffset - (startRow - 1), 0);
+		m_rowTargets.fill(-1, keys.size());
+		for (int i = startRow - 1; i < endRowOffset; ++i)
+			m_rowTargets[order.at(i)] = i - (startRow - 1);
+
+		if (m_actualRows > 0 && !reader->hasError()) {
+			const int first = order.at(startRow - 1);
+			firstRowName = keys.at(first);
+			device.seek(offsets.at(first));
+			JsonStreamReader rowReader(&device);
+			rowReader.readNext();
+			if (!readRow(rowReader, firstRow, &firstRowKeys))
 				return false;
-			countRows++;
 		}
 		break;
 	}
 	}
 
+	if (reader->hasError()) {
+		q->setLastError(reader->errorString());
+		return false;
+	}
+	if (m_actualRows == 0)
+		return false;
+
+	// the number of columns is determined by the first row, missing values of the other rows are empty
+	const int countCols = static_cast<int>(firstRow.size());
 	if (endColumn == -1 || endColumn > countCols)
 		endColumn = countCols;
 
-	m_actualRows = countRows;
 	m_actualCols = endColumn - startColumn + 1 + createIndexEnabled + importObjectNames;
 
-	if (parseColumnModes(firstRow, firstRowName) != 0)
+	if (parseColumnModes(firstRow, firstRowKeys, firstRowName) != 0)
 		return false;
 
 	DEBUG("start/end column: = " << startColumn << ' ' << endColumn);
@@ -504,36 +612,206 @@ bool JsonFilterPrivate::prepareDocumentToRead() {
 	return true;
 }
 
+/*!
+ * reads the row starting with the current token of \c reader into \c values and its keys into \c keys if not \c nullptr.
+ * The members of objects are ordered by their keys like in \c QJsonObject. Nested arrays and objects are skipped,
+ * their values are empty. Returns \c false if the row is not of the type \c rowType.
+ */
+bool JsonFilterPrivate::readRow(JsonStreamReader& reader, QVector<QJsonValue>& values, QStringList* keys) {
+	values.clear();
+	const auto type = reader.tokenType();
+	if (type == JsonStreamReader::TokenType::StartArray && rowType == QJsonValue::Array) {
+		while (reader.readNext() != JsonStreamReader::TokenType::EndArray) {
+			if (reader.hasError())
+				return false;
+			values << reader.value();
+			reader.skipCurrentValue();
+		}
+		return true;
+	}
+
+	if (type == JsonStreamReader::TokenType::StartObject && rowType == QJsonValue::Object) {
+		// the order of the members is only determined again if the keys differ from the previous row
+		m_rowValues.clear();
+		bool sameKeys = true;
+		int index = 0;
+		while (reader.readNext() != JsonStreamReader::TokenType::EndObject) {
+			if (reader.hasError())
+				return false;
+			const auto key = reader.rawKey();
+			if (sameKeys && (index >= m_rowKeys.size() || QByteArrayView(m_rowKeys.at(index)) != key)) {
+				sameKeys = false;
+				m_rowKeys.resize(index);
+				m_rowKeyNames.resize(index);
+			}
+			if (!sameKeys) {
+				m_rowKeys << key.toByteArray();
+				m_rowKeyNames << reader.key();
+			}
+			m_rowValues << reader.value();
+			reader.skipCurrentValue();
+			++index;
+		}
+		if (!sameKeys || index != m_rowKeys.size()) {
+			m_rowKeys.resize(index);
+			m_rowKeyNames.resize(index);
+			m_rowOrder = keyOrder(m_rowKeyNames);
+		}
+
+		values.reserve(m_rowOrder.size());
+		for (int i : std::as_const(m_rowOrder))
+			values << m_rowValues.at(i);
+		if (keys) {
+			keys->clear();
+			for (int i : std::as_const(m_rowOrder))
+				*keys << m_rowKeyNames.at(i);
+		}
+		return true;
+	}
+
+	reader.skipCurrentValue();
+	return false;
+}
+
+/*!
+ * reads the selected rows of the container in the order of the document and calls \c function with the index of the row,
+ * its values and its name for the rows with an index smaller than \c maxRows. The values are \c nullptr for rows
+ * not of the type \c rowType. Returns \c false if an error occurred.
+ */
+template<typename Function>
+bool JsonFilterPrivate::readRows(QIODevice& device, int maxRows, Function function) {
+	auto reader = containerReader(device);
+	if (!reader)
+		return false;
+
+	const bool array = (containerType == JsonFilter::DataContainerType::Array);
+	const auto end = array ? JsonStreamReader::TokenType::EndArray : JsonStreamReader::TokenType::EndObject;
+	QVector<QJsonValue> values;
+	int index = 0; // index of the row in the container
+	while (reader->readNext() != end) {
+		if (reader->hasError())
+			break;
+
+		int row = -1;
+		if (array)
+			row = index - (startRow - 1);
+		else if (index < m_rowTargets.size())
+			row = m_rowTargets.at(index);
+		++index;
+
+		if (row < 0 || row >= maxRows) {
+			if (array && row >= 0)
+				break; // all rows read
+			reader->skipCurrentValue();
+			continue;
+		}
+
+		const QString rowName = reader->key(); // read before the values of the row
+		const bool valid = readRow(*reader, values, nullptr);
+		if (reader->hasError())
+			break;
+		function(row, valid ? &values : nullptr, rowName);
+	}
+
+	if (reader->hasError()) {
+		q->setLastError(reader->errorString());
+		return false;
+	}
+	return true;
+}
+
+/*!
+ * writes the row \c values with the name \c rowName and the index \c index to the row \c row of the data containers.
+ */
+void JsonFilterPrivate::setRow(int row, int index, const QVector<QJsonValue>* values, const QString& rowName) {
+	if (createIndexEnabled)
+		static_cast<QVector<int>*>(m_dataContainer[0])->operator[](row) = index;
+	if (importObjectNames)
+		setValueFromString((int)createIndexEnabled, row, rowName);
+
+	const int colOffset = (int)createIndexEnabled + (int)importObjectNames;
+	for (int n = 0; n < m_actualCols - colOffset; ++n) {
+		const int column = n + startColumn - 1;
+		if (values && column < values->size())
+			setValue(colOffset + n, row, values->at(column));
+		else
+			setEmptyValue(colOffset + n, row);
+	}
+}
+
+/*!
+ * removes the first \c removedRows rows of the data containers and resizes them to \c rows rows afterwards.
+ */
+void JsonFilterPrivate::resizeDataContainer(int removedRows, int rows) {
+	auto resize = [removedRows, rows](auto* vector) {
+		if (removedRows > 0)
+			vector->remove(0, removedRows);
+		vector->resize(rows);
+	};
+
+	for (size_t i = 0; i < m_dataContainer.size(); ++i) {
+		switch (columnModes.at(i)) {
+		case AbstractColumn::ColumnMode::Double:
+			resize(static_cast<QVector<double>*>(m_dataContainer[i]));
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			resize(static_cast<QVector<int>*>(m_dataContainer[i]));
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			resize(static_cast<QVector<qint64>*>(m_dataContainer[i]));
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			resize(static_cast<QVector<QString>*>(m_dataContainer[i]));
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			resize(static_cast<DateTimeVector*>(m_dataContainer[i]));
+			break;
+		}
+	}
+}
+
 /*!
 reads the content of the file \c fileName to the data source \c dataSource. Uses the settings defined in the data source.
 */
 void JsonFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
 	KCompressionDevice device(fileName);
-	readDataFromDevice(device, dataSource, importMode);
+	if (device.compressionType() == KCompressionDevice::None) {
+		QFile file(fileName);
+		readDataFromDevice(file, dataSource, importMode);
+	} else
+		readDataFromDevice(device, dataSource, importMode);
 }
 
 /*!
 reads the content of device \c device to the data source \c dataSource. Uses the settings defined in the data source.
+The data is parsed while reading it, sequential devices are read completely into a buffer first.
 */
-void JsonFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
-	if (!m_prepared) {
-		const int deviceError = prepareDeviceToRead(device);
-		if (deviceError != 0) {
-			q->setLastError(i18n("Empty file or invalid JSON document."));
-			return;
-		}
-		// TODO: support other modes and vector names
-		m_prepared = true;
+void JsonFilterPrivate::readDataFromDevice(QIODevice& device, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int /*lines*/) {
+	const int deviceError = prepareDeviceToRead(device);
+	if (deviceError != 0) {
+		q->setLastError(i18n("Empty file or invalid JSON document."));
+		return;
 	}
 
-	if (prepareDocumentToRead())
-		importData(dataSource, importMode, lines);
+	// the selected container and the rows are located by reading the data several times
+	QBuffer buffer;
+	QIODevice* source = &device;
+	if (device.isSequential()) {
+		buffer.setData(device.readAll());
+		buffer.open(QIODevice::ReadOnly);
+		source = &buffer;
+	}
+
+	if (prepareContainerToRead(*source))
+		importData(*source, dataSource, importMode);
 }
 
 /*!
-import the content of document \c m_preparedDoc to the data source \c dataSource. Uses the settings defined in the data source.
+import the rows of the selected container of \c device to the data source \c dataSource. Uses the settings defined in the data source.
 */
-void JsonFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
+void JsonFilterPrivate::importData(QIODevice& device, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
 	bool ok = false;
 	m_columnOffset = dataSource->prepareImport(m_dataContainer, importMode, m_actualRows, m_actualCols, vectorNames, columnModes, ok);
 	if (!ok) {
@@ -541,85 +819,24 @@ void JsonFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileF
 		return;
 	}
 
-	int rowOffset = startRow - 1;
-	int colOffset = (int)createIndexEnabled + (int)importObjectNames;
 	DEBUG("reading " << m_actualRows << " lines");
 	DEBUG("reading " << m_actualCols << " columns");
 
+	m_numberParser = NumberParser(QLocale(numberFormat));
 	int progressIndex = 0;
-	const float progressInterval = 0.01 * lines; // update on every 1% only
-
-	const auto& array = m_preparedDoc.array();
-	const auto& arrayIterator = array.begin();
-	const auto& object = m_preparedDoc.object();
-	const auto& objectIterator = object.begin();
-
-	for (int i = 0; i < m_actualRows; ++i) {
-		if (createIndexEnabled)
-			static_cast<QVector<int>*>(m_dataContainer[0])->operator[](i) = i + 1;
-
-		QJsonValue row;
-		switch (containerType) {
-		case JsonFilter::DataContainerType::Array:
-			row = *(arrayIterator + rowOffset + i);
-			break;
-		case JsonFilter::DataContainerType::Object:
-			if (importObjectNames) {
-				const QString& rowName = (objectIterator + rowOffset + i).key();
-				setValueFromString((int)createIndexEnabled, i, rowName);
-			}
-			row = *(objectIterator + rowOffset + i);
-			break;
-		}
-
-		for (int n = 0; n < m_actualCols - colOffset; ++n) {
-			QJsonValue value;
-			switch (rowType) {
-			case QJsonValue::Array:
-				value = *(row.toArray().begin() + n + startColumn - 1);
-				break;
-			case QJsonValue::Object:
-				value = *(row.toObject().begin() + n + startColumn - 1);
-				break;
-			// TODO: implement other value types
-			case QJsonValue::Double:
-			case QJsonValue::String:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				break;
-			}
-
-			switch (value.type()) {
-			case QJsonValue::Double:
-				if (columnModes[colOffset + n] == AbstractColumn::ColumnMode::Double)
-					static_cast<QVector<double>*>(m_dataContainer[colOffset + n])->operator[](i) = value.toDouble();
-				else
-					setEmptyValue(colOffset + n, i + startRow - 1);
-				break;
-			case QJsonValue::String:
-				setValueFromString(colOffset + n, i, value.toString());
-				break;
-			case QJsonValue::Array:
-			case QJsonValue::Object:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				setEmptyValue(colOffset + n, i + startRow - 1);
-				break;
-			}
-		}
+	const int progressInterval = std::max(m_actualRows / 100, 1); // update on every 1% only
+	readRows(device, m_actualRows, [&](int row, const QVector<QJsonValue>* values, const QString& rowName) {
+		setRow(row, row + 1, values, rowName);
 
 		// ask to update the progress bar only if we have more than 1000 lines
 		// only in 1% steps
 		progressIndex++;
-		if (m_actualRows > 1000 && progressIndex > progressInterval) {
-			double value = 100. * i / lines;
-			Q_EMIT q->completed(static_cast<int>(value));
+		if (m_actualRows > 1000 && progressIndex >= progressInterval) {
+			Q_EMIT q->completed(static_cast<int>(100. * row / m_actualRows));
 			progressIndex = 0;
 			QApplication::processEvents(QEventLoop::AllEvents, 0);
 		}
-	}
+	});
 
 	// set the plot designation to 'X' for index and name columns, if available
 	auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
@@ -633,85 +850,146 @@ void JsonFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileF
 	dataSource->finalizeImport(m_columnOffset, startColumn, startColumn + m_actualCols - 1, dateTimeFormat, importMode);
 }
 
+/*!
+reads the complete documents of JSON Lines data in \c device, starting at the position \c from for files, and appends them as new rows
+to \c dataSource. The columns are created for the first document, only the last \c keepNRows rows are kept if positive.
+An incomplete document at the end of the data is read again in the next call for files and kept until the remaining data is received
+for sequential devices, e.g. sockets. Returns the number of bytes read.
+*/
+qint64 JsonFilterPrivate::readFromLiveDevice(QIODevice& device, AbstractDataSource* dataSource, qint64 from, int keepNRows) {
+	if (!device.isOpen() && !device.open(QIODevice::ReadOnly)) {
+		q->setLastError(i18n("Failed to open the device/file."));
+		return 0;
+	}
+
+	QByteArray data;
+	if (device.isSequential()) {
+		m_liveData += device.readAll();
+		data = m_liveData;
+	} else {
+		device.seek(from);
+		data = device.readAll();
+	}
+
+	// only complete lines are read
+	const auto size = data.lastIndexOf('\n') + 1;
+	if (device.isSequential())
+		m_liveData = data.sliced(size);
+	if (size == 0)
+		return 0;
+	data.truncate(size);
+
+	JsonStreamReader reader(data);
+	reader.setJsonLines(true);
+	reader.readNext(); // start of the array of the documents
+
+	QVector<QVector<QJsonValue>> rows;
+	QVector<QJsonValue> values;
+	QStringList keys;
+	m_numberParser = NumberParser(QLocale(numberFormat));
+	while (reader.readNext() != JsonStreamReader::TokenType::EndArray && !reader.hasError()) {
+		if (!m_livePrepared) {
+			// the columns are determined by the first document
+			rowType = reader.tokenType() == JsonStreamReader::TokenType::StartArray ? QJsonValue::Array : QJsonValue::Object;
+			if (!readRow(reader, values, &keys))
+				continue;
+
+			importObjectNames = false;
+			if (endColumn == -1 || endColumn > values.size())
+				endColumn = static_cast<int>(values.size());
+			m_actualCols = endColumn - startColumn + 1 + createIndexEnabled;
+			if (parseColumnModes(values, keys) != 0) {
+				q->setLastError(i18n("JSON format error or document empty."));
+				return size;
+			}
+
+			bool ok = false;
+			m_columnOffset = dataSource->prepareImport(m_dataContainer, AbstractFileFilter::ImportMode::Replace, 0, m_actualCols, vectorNames, columnModes, ok);
+			if (!ok) {
+				q->setLastError(i18n("Not enough memory."));
+				return 0;
+			}
+			m_livePrepared = true;
+			m_actualRows = 0;
+			rows << values;
+		} else if (readRow(reader, values, nullptr))
+			rows << values;
+		else
+			rows << QVector<QJsonValue>();
+	}
+	if (reader.hasError())
+		q->setLastError(reader.errorString());
+	if (rows.isEmpty())
+		return size;
+
+	// append the new rows and remove the oldest rows if required
+	const int rowCount = m_actualRows;
+	const int newRowCount = rowCount + static_cast<int>(rows.size());
+	const int removedRows = (keepNRows > 0 && newRowCount > keepNRows) ? newRowCount - keepNRows : 0;
+	m_actualRows = newRowCount - removedRows;
+	// if more rows than kept were read, all rows in the containers and the first of the new rows are dropped
+	resizeDataContainer(std::min(removedRows, rowCount), m_actualRows);
+	int row = rowCount - removedRows;
+	for (const auto& rowValues : std::as_const(rows)) {
+		if (row >= 0)
+			setRow(row, m_liveIndex + 1, rowValues.isEmpty() ? nullptr : &rowValues, QString());
+		++row;
+		++m_liveIndex;
+	}
+
+	// the rows read before were not changed, the cached values of the columns for them stay valid
+	auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
+	if (spreadsheet && removedRows == 0)
+		spreadsheet->setFirstAppendedRowFinalizeImport(rowCount);
+	dataSource->finalizeImport(m_columnOffset, startColumn, startColumn + m_actualCols - 1, dateTimeFormat, AbstractFileFilter::ImportMode::Replace);
+	return size;
+}
+
 /*!
 generates the preview for the file \c fileName.
 */
 QVector<QStringList> JsonFilterPrivate::preview(const QString& fileName, int lines) {
-	if (!m_prepared) {
-		KCompressionDevice device(fileName);
-		return preview(device, lines);
-	} else
-		return preview(lines);
+	KCompressionDevice device(fileName);
+	if (device.compressionType() == KCompressionDevice::None) {
+		QFile file(fileName);
+		return preview(file, lines);
+	}
+	return preview(device, lines);
 }
 
 /*!
 generates the preview for device \c device.
 */
 QVector<QStringList> JsonFilterPrivate::preview(QIODevice& device, int lines) {
-	if (!m_prepared) {
-		const int deviceError = prepareDeviceToRead(device);
-		if (deviceError != 0) {
-			DEBUG("Device error = " << deviceError);
-			return {};
-		}
+	const int deviceError = prepareDeviceToRead(device);
+	if (deviceError != 0) {
+		DEBUG("Device error = " << deviceError);
+		return {};
 	}
 
-	if (prepareDocumentToRead())
-		return preview(lines);
-
-	return {};
-}
+	QBuffer buffer;
+	QIODevice* source = &device;
+	if (device.isSequential()) {
+		buffer.setData(device.readAll());
+		buffer.open(QIODevice::ReadOnly);
+		source = &buffer;
+	}
 
-/*!
-generates the preview for document \c m_preparedDoc.
-*/
-QVector<QStringList> JsonFilterPrivate::preview(int lines) {
-	QVector<QStringList> dataStrings;
-	const int rowOffset = startRow - 1;
-	DEBUG("	Generating preview for " << std::min(lines, m_actualRows) << " lines");
-
-	const auto& array = m_preparedDoc.array();
-	const auto& arrayIterator = array.begin();
-	const auto& object = m_preparedDoc.object();
-	const auto& objectIterator = object.begin();
-
-	for (int i = 0; i < std::min(lines, m_actualRows); ++i) {
-		QString rowName;
-		QJsonValue row;
-		switch (containerType) {
-		case JsonFilter::DataContainerType::Object:
-			rowName = (objectIterator + rowOffset + i).key();
-			row = *(objectIterator + rowOffset + i);
-			break;
-		case JsonFilter::DataContainerType::Array:
-			row = *(arrayIterator + rowOffset + i);
-			break;
-		}
+	if (!prepareContainerToRead(*source))
+		return {};
 
-		QStringList lineString;
+	const int rows = std::min(lines, m_actualRows);
+	DEBUG("	Generating preview for " << rows << " lines");
+	QVector<QStringList> dataStrings(rows);
+	readRows(*source, rows, [&](int row, const QVector<QJsonValue>* values, const QString& rowName) {
+		QStringList& lineString = dataStrings[row];
 		if (createIndexEnabled)
-			lineString += QString::number(i + 1);
+			lineString += QString::number(row + 1);
 		if (importObjectNames)
 			lineString += rowName;
 
 		for (int n = startColumn - 1; n < endColumn; ++n) {
-			QJsonValue value;
-			switch (rowType) {
-			case QJsonValue::Object:
-				value = *(row.toObject().begin() + n);
-				break;
-			case QJsonValue::Array:
-				value = *(row.toArray().begin() + n);
-				break;
-			// TODO: implement other value types
-			case QJsonValue::Double:
-			case QJsonValue::String:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				break;
-			}
-
+			const auto value = (values && n < values->size()) ? values->at(n) : QJsonValue();
 			switch (value.type()) {
 			case QJsonValue::Double:
 				lineString += QString::number(value.toDouble(), 'g', 16);
@@ -728,8 +1006,7 @@ QVector<QStringList> JsonFilterPrivate::preview(int lines) {
 				break;
 			}
 		}
-		dataStrings << lineString;
-	}
+	});
 	return dataStrings;
 }
 
@@ -43,6 +43,8 @@ public:
 	void readDataFromDevice(QIODevice& device, AbstractDataSource*, ImportMode = ImportMode::Replace, int lines = -1);
 	// overloaded function to read from file
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, ImportMode = ImportMode::Replace) override;
+	// read the new documents of JSON Lines data, e.g. of live data sources
+	qint64 readFromLiveDevice(QIODevice&, AbstractDataSource*, qint64 from = 0, int keepNRows = 0);
 	void write(const QString& fileName, AbstractDataSource*) override;
 
 	QVector<QStringList> preview(const QString& fileName, int lines);
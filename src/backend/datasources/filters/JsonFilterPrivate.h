@@ -12,30 +12,36 @@
 #define JSONFILTERPRIVATE_H
 
 #include "QJsonModel.h"
+#include "backend/lib/ValueParser.h"
+
+#include <memory>
 
-class QJsonDocument;
 class AbstractDataSource;
 class AbstractColumn;
+class JsonStreamReader;
 
 class JsonFilterPrivate {
 public:
 	explicit JsonFilterPrivate(JsonFilter* owner);
 
-	int checkRow(QJsonValueRef value, int& countCols);
-	int parseColumnModes(const QJsonValue& row, const QString& rowName = QString());
+	int parseColumnModes(const QVector<QJsonValue>& row, const QStringList& keys, const QString& rowName = QString());
 	void setEmptyValue(int column, int row);
+	void setValue(int column, int row, const QJsonValue& value);
 	void setValueFromString(int column, int row, const QString& value);
 
 	int prepareDeviceToRead(QIODevice&);
 	void
 	readDataFromDevice(QIODevice&, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace, int lines = -1);
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
-	void importData(AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace, int lines = -1);
+	qint64 readFromLiveDevice(QIODevice&, AbstractDataSource*, qint64 from, int keepNRows);
+	void importData(QIODevice&, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
 
 	void write(const QString& fileName, AbstractDataSource*);
 	QVector<QStringList> preview(const QString& fileName, int lines);
 	QVector<QStringList> preview(QIODevice& device, int lines);
-	QVector<QStringList> preview(int lines);
+
+	static bool isJsonLines(QIODevice&);
+	static QVector<int> keyOrder(const QStringList& keys);
 
 	JsonFilter* const q;
 	QJsonModel* model{nullptr};
@@ -60,13 +66,34 @@ public:
 private:
 	int m_actualRows{0};
 	int m_actualCols{0};
-	int m_prepared{false};
 	int m_columnOffset{0}; // indexes the "start column" in the datasource. Data will be imported starting from this column.
 	std::vector<void*> m_dataContainer; // pointers to the actual data containers (columns).
-	QJsonDocument m_doc; // original and full JSON document
-	QJsonDocument m_preparedDoc; // selected part of the full JSON document, the part that needs to be imported
+	NumberParser m_numberParser;
+
+	// selected container of the rows
+	qint64 m_containerOffset{0}; // position of the container in the device
+	bool m_jsonLines{false}; // the container is the array of the documents of JSON Lines data
+	QVector<int> m_rowTargets; // rows of the members of object containers in the order of the document, -1 for rows not read
+
+	// keys of the last row that was an object, the order of its members is reused for the next rows with the same keys
+	QVector<QByteArray> m_rowKeys;
+	QStringList m_rowKeyNames;
+	QVector<int> m_rowOrder;
+	QVector<QJsonValue> m_rowValues;
+
+	// live data
+	bool m_livePrepared{false};
+	int m_liveIndex{0};
+	QByteArray m_liveData; // incomplete document received from a sequential device
 
-	bool prepareDocumentToRead();
+	bool locateContainer(QIODevice&);
+	std::unique_ptr<JsonStreamReader> containerReader(QIODevice&);
+	bool prepareContainerToRead(QIODevice&);
+	bool readRow(JsonStreamReader&, QVector<QJsonValue>& values, QStringList* keys);
+	template<typename Function>
+	bool readRows(QIODevice&, int maxRows, Function);
+	void setRow(int row, int index, const QVector<QJsonValue>* values, const QString& rowName);
+	void resizeDataContainer(int removedRows, int rows);
 };
 
 #endif
@@ -0,0 +1,1172 @@
+/*
+	File                 : McapDecoder.cpp
+	Project              : LabPlot
+	Description          : Decoders of the messages in MCAP files
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/datasources/filters/McapDecoder.h"
+#include "backend/lib/JsonStreamReader.h"
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+constexpr int MaxDepth = 64; // maximal depth of nested messages, objects and arrays
+
+// ##############################################################################
+// ################################ JSON ########################################
+// ##############################################################################
+class JsonDecoder : public McapDecoder {
+public:
+	std::unique_ptr<McapDecoder> clone() const override {
+		return std::make_unique<JsonDecoder>();
+	}
+
+protected:
+	bool decodeMessage(const unsigned char* data, size_t size) override {
+		JsonStreamReader reader(QByteArray::fromRawData(reinterpret_cast<const char*>(data), static_cast<qsizetype>(size)));
+		return reader.readNext() == JsonStreamReader::TokenType::StartObject && decodeContainer(reader, 0);
+	}
+
+private:
+	bool decodeContainer(JsonStreamReader&, int depth);
+};
+
+/*!
+ * decodes the elements of the object or array started last in \c reader.
+ * The layout contains the keys and the types of the values, so the names don't need to be created for messages with the same structure.
+ */
+bool JsonDecoder::decodeContainer(JsonStreamReader& reader, int depth) {
+	size_t index = 0;
+	while (true) {
+		const auto type = reader.readNext();
+		if (type == JsonStreamReader::TokenType::EndObject || type == JsonStreamReader::TokenType::EndArray) {
+			addLayout(std::string_view(")"));
+			return true;
+		}
+
+		if (reader.hasKey()) {
+			const auto key = reader.rawKey();
+			addLayout(static_cast<uint32_t>(key.size()));
+			addLayout(std::string_view(key.data(), key.size()));
+			pushName(namesEnabled() ? reader.key().toStdString() : std::string());
+		} else
+			pushIndex(index);
+		++index;
+
+		bool ok = true;
+		switch (type) {
+		case JsonStreamReader::TokenType::StartObject:
+		case JsonStreamReader::TokenType::StartArray:
+			addLayout(std::string_view(type == JsonStreamReader::TokenType::StartObject ? "{" : "["));
+			ok = depth < MaxDepth && decodeContainer(reader, depth + 1);
+			break;
+		case JsonStreamReader::TokenType::Number: {
+			addLayout(std::string_view("n"));
+			auto& value = addValue();
+			value.type = McapValue::Type::Double;
+			value.number = reader.toDouble();
+			break;
+		}
+		case JsonStreamReader::TokenType::String: {
+			addLayout(std::string_view("s"));
+			auto& value = addValue();
+			value.type = McapValue::Type::Text;
+			value.text = reader.text().toStdString();
+			break;
+		}
+		case JsonStreamReader::TokenType::Bool: {
+			addLayout(std::string_view("b"));
+			auto& value = addValue();
+			value.type = McapValue::Type::Integer;
+			value.integer = reader.toBool();
+			break;
+		}
+		case JsonStreamReader::TokenType::Null:
+			addLayout(std::string_view("z"));
+			addValue();
+			break;
+		case JsonStreamReader::TokenType::NoToken:
+		case JsonStreamReader::TokenType::Invalid:
+		case JsonStreamReader::TokenType::EndArray:
+		case JsonStreamReader::TokenType::EndObject:
+		case JsonStreamReader::TokenType::EndDocument:
+			ok = false;
+		}
+		popName();
+		if (!ok)
+			return false;
+	}
+}
+
+// ##############################################################################
+// ########################## ROS 1 and CDR (ROS 2) #############################
+// ##############################################################################
+enum class RosType { Bool, Int8, UInt8, Int16, UInt16, Int32, UInt32, Int64, UInt64, Float32, Float64, String, WString, Time, Duration, Message };
+
+struct RosField {
+	RosType type{RosType::Message};
+	std::string name;
+	int arrayLength{0}; // 0 for single values, -1 for dynamic arrays and the number of elements for fixed-size arrays
+	std::string typeName; // name of the nested message
+	int message{-1}; // index of the definition of the nested message
+};
+
+struct RosMessage {
+	std::string name; // "package/Type"
+	std::vector<RosField> fields;
+};
+
+std::string_view trimmed(std::string_view s) {
+	const auto start = s.find_first_not_of(" \t\r");
+	if (start == std::string_view::npos)
+		return {};
+	return s.substr(start, s.find_last_not_of(" \t\r") - start + 1);
+}
+
+//! "package/msg/Type" used in ROS 2 -> "package/Type"
+std::string rosTypeName(std::string_view name) {
+	std::string result(name);
+	const auto position = result.find("/msg/");
+	if (position != std::string::npos)
+		result.erase(position, 4);
+	return result;
+}
+
+/*!
+ * parses the type of a field like "float64", "string<=10", "int32[]", "int32[3]", "int32[<=3]" or "geometry_msgs/Point[]".
+ * returns \c false for invalid array lengths.
+ */
+bool parseRosType(std::string_view type, bool ros2, RosField& field) {
+	const auto bracket = type.find('[');
+	if (bracket != std::string_view::npos) {
+		if (type.back() != ']')
+			return false;
+		const auto length = type.substr(bracket + 1, type.size() - bracket - 2);
+		if (length.empty() || length.substr(0, 2) == "<=") // unbounded and bounded sequences
+			field.arrayLength = -1;
+		else {
+			const auto result = std::from_chars(length.data(), length.data() + length.size(), field.arrayLength);
+			if (result.ec != std::errc() || result.ptr != length.data() + length.size() || field.arrayLength <= 0)
+				return false;
+		}
+		type = type.substr(0, bracket);
+	}
+
+	// bounded strings
+	const auto bound = type.find("<=");
+	if (bound != std::string_view::npos)
+		type = type.substr(0, bound);
+
+	static const std::unordered_map<std::string_view, RosType> builtinTypes = {
+		{"bool", RosType::Bool},		{"int8", RosType::Int8},	  {"uint8", RosType::UInt8},	 {"char", RosType::UInt8},
+		{"int16", RosType::Int16},		{"uint16", RosType::UInt16},  {"int32", RosType::Int32},	 {"uint32", RosType::UInt32},
+		{"int64", RosType::Int64},		{"uint64", RosType::UInt64},  {"float32", RosType::Float32}, {"float64", RosType::Float64},
+		{"string", RosType::String},
+	};
+	const auto it = builtinTypes.find(type);
+	if (it != builtinTypes.end())
+		field.type = it->second;
+	else if (type == "byte") // deprecated alias of int8 in ROS 1, octet in ROS 2
+		field.type = ros2 ? RosType::UInt8 : RosType::Int8;
+	else if (!ros2 && type == "time")
+		field.type = RosType::Time;
+	else if (!ros2 && type == "duration")
+		field.type = RosType::Duration;
+	else if (type == "wstring")
+		field.type = RosType::WString;
+	else {
+		field.type = RosType::Message;
+		field.typeName = std::string(type);
+	}
+	return true;
+}
+
+/*!
+ * parses the message definition \c text of the message \c rootName in the format of the "ros1msg" and "ros2msg" schemas.
+ * The definitions of the nested messages follow the definition of the message, separated by lines of '=' and starting with "MSG: package/Type".
+ * The root message is the first one in \c messages.
+ */
+bool parseRosDefinitions(std::string_view text, const std::string& rootName, bool ros2, std::vector<RosMessage>& messages, std::string& error) {
+	messages.push_back(RosMessage{rosTypeName(rootName), {}});
+	size_t position = 0;
+	while (position <= text.size()) {
+		auto end = text.find('\n', position);
+		if (end == std::string_view::npos)
+			end = text.size();
+		auto line = text.substr(position, end - position);
+		position = end + 1;
+
+		const auto comment = line.find('#');
+		if (comment != std::string_view::npos)
+			line = line.substr(0, comment);
+		line = trimmed(line);
+		if (line.empty())
+			continue;
+
+		if (line.find_first_not_of('=') == std::string_view::npos) {
+			messages.emplace_back();
+			continue;
+		}
+		if (line.substr(0, 4) == "MSG:") {
+			messages.back().name = rosTypeName(trimmed(line.substr(4)));
+			continue;
+		}
+
+		// "type name", "type name default_value" or the constant "type NAME=value"
+		const auto space = line.find_first_of(" \t");
+		if (space == std::string_view::npos) {
+			error = "invalid field definition '" + std::string(line) + "'";
+			return false;
+		}
+		const auto type = line.substr(0, space);
+		const auto rest = trimmed(line.substr(space));
+		const auto nameEnd = rest.find_first_of(" \t=");
+		if (nameEnd != std::string_view::npos && trimmed(rest.substr(nameEnd)).substr(0, 1) == "=")
+			continue;
+
+		RosField field;
+		field.name = std::string(rest.substr(0, nameEnd));
+		if (!parseRosType(type, ros2, field)) {
+			error = "invalid type '" + std::string(type) + "'";
+			return false;
+		}
+		messages.back().fields.push_back(std::move(field));
+	}
+
+	// resolve the nested messages, short names refer to messages of the same package
+	for (auto& message : messages) {
+		const auto package = message.name.substr(0, message.name.find('/'));
+		for (auto& field : message.fields) {
+			if (field.type != RosType::Message)
+				continue;
+
+			auto name = rosTypeName(field.typeName);
+			if (name.find('/') == std::string::npos)
+				name = (!ros2 && name == "Header") ? std::string("std_msgs/Header") : package + '/' + name;
+
+			if (name == "builtin_interfaces/Time")
+				field.type = RosType::Time;
+			else if (name == "builtin_interfaces/Duration")
+				field.type = RosType::Duration;
+			else {
+				const auto it = std::find_if(messages.cbegin(), messages.cend(), [&name](const RosMessage& m) {
+					return m.name == name;
+				});
+				if (it == messages.cend()) {
+					error = "definition of '" + name + "' not found";
+					return false;
+				}
+				field.message = static_cast<int>(it - messages.cbegin());
+			}
+		}
+	}
+
+	return true;
+}
+
+/*!
+ * reads the values of ROS 1 messages (little endian, packed) and of CDR encoded ROS 2 messages
+ * (aligned to the size of the values relative to the start of the data after the encapsulation header).
+ */
+class RosBuffer {
+public:
+	RosBuffer(const unsigned char* data, size_t size, bool bigEndian, bool aligned)
+		: m_data(data)
+		, m_size(size)
+		, m_bigEndian(bigEndian)
+		, m_aligned(aligned) {
+	}
+
+	bool readUnsigned(size_t bytes, uint64_t& value) {
+		if (m_aligned)
+			m_position = (m_position + bytes - 1) / bytes * bytes;
+		if (remaining() < bytes)
+			return false;
+
+		value = 0;
+		for (size_t i = 0; i < bytes; ++i) {
+			const uint64_t byte = m_data[m_position + i];
+			value |= byte << (8 * (m_bigEndian ? bytes - 1 - i : i));
+		}
+		m_position += bytes;
+		return true;
+	}
+
+	bool skip(uint64_t bytes) {
+		if (remaining() < bytes)
+			return false;
+		m_position += bytes;
+		return true;
+	}
+
+	const unsigned char* current() const {
+		return m_data + m_position;
+	}
+
+	size_t remaining() const {
+		return m_position < m_size ? m_size - m_position : 0;
+	}
+
+private:
+	const unsigned char* m_data;
+	size_t m_size;
+	size_t m_position{0};
+	bool m_bigEndian;
+	bool m_aligned;
+};
+
+class RosDecoder : public McapDecoder {
+public:
+	RosDecoder(std::shared_ptr<const std::vector<RosMessage>> messages, bool cdr)
+		: m_messages(std::move(messages))
+		, m_cdr(cdr) {
+	}
+
+	std::unique_ptr<McapDecoder> clone() const override {
+		return std::make_unique<RosDecoder>(m_messages, m_cdr);
+	}
+
+protected:
+	bool decodeMessage(const unsigned char* data, size_t size) override {
+		if (!m_cdr) {
+			RosBuffer buffer(data, size, false, false);
+			return decodeFields(buffer, 0, 0);
+		}
+
+		// encapsulation header, only plain CDR (big and little endian) is supported
+		if (size < 4 || data[0] != 0 || data[1] > 1)
+			return false;
+		RosBuffer buffer(data + 4, size - 4, data[1] == 0, true);
+		return decodeFields(buffer, 0, 0);
+	}
+
+private:
+	bool decodeFields(RosBuffer&, int message, int depth);
+	bool decodeField(RosBuffer&, const RosField&, int depth);
+	bool decodeElement(RosBuffer&, const RosField&, int depth);
+
+	std::shared_ptr<const std::vector<RosMessage>> m_messages;
+	bool m_cdr;
+};
+
+bool RosDecoder::decodeFields(RosBuffer& buffer, int index, int depth) {
+	if (depth > MaxDepth)
+		return false;
+
+	const auto& message = m_messages->at(index);
+	if (m_cdr && message.fields.empty()) { // empty messages contain one dummy byte in ROS 2
+		uint64_t dummy;
+		return buffer.readUnsigned(1, dummy);
+	}
+
+	for (const auto& field : message.fields) {
+		pushName(field.name);
+		const bool ok = decodeField(buffer, field, depth);
+		popName();
+		if (!ok)
+			return false;
+	}
+	return true;
+}
+
+bool RosDecoder::decodeField(RosBuffer& buffer, const RosField& field, int depth) {
+	if (field.arrayLength == 0)
+		return decodeElement(buffer, field, depth);
+
+	uint64_t count = field.arrayLength;
+	if (field.arrayLength < 0) {
+		if (!buffer.readUnsigned(4, count))
+			return false;
+		// byte arrays like images or point clouds are not imported
+		if (field.type == RosType::Int8 || field.type == RosType::UInt8)
+			return buffer.skip(count);
+		if (count > buffer.remaining())
+			return false;
+		addLayout(static_cast<uint32_t>(count));
+	}
+
+	for (uint64_t i = 0; i < count; ++i) {
+		pushIndex(i);
+		const bool ok = decodeElement(buffer, field, depth);
+		popName();
+		if (!ok)
+			return false;
+	}
+	return true;
+}
+
+bool RosDecoder::decodeElement(RosBuffer& buffer, const RosField& field, int depth) {
+	if (field.type == RosType::Message)
+		return decodeFields(buffer, field.message, depth + 1);
+
+	uint64_t value;
+	switch (field.type) {
+	case RosType::Bool:
+	case RosType::UInt8:
+	case RosType::Int8:
+	case RosType::UInt16:
+	case RosType::Int16:
+	case RosType::Int32: {
+		static constexpr size_t sizes[] = {1, 1, 1, 2, 2, 4};
+		if (!buffer.readUnsigned(sizes[static_cast<int>(field.type)], value))
+			return false;
+		auto& v = addValue();
+		v.type = McapValue::Type::Integer;
+		if (field.type == RosType::Int8)
+			v.integer = static_cast<int8_t>(value);
+		else if (field.type == RosType::Int16)
+			v.integer = static_cast<int16_t>(value);
+		else if (field.type == RosType::Int32)
+			v.integer = static_cast<int32_t>(value);
+		else
+			v.integer = static_cast<int64_t>(value);
+		return true;
+	}
+	case RosType::UInt32:
+	case RosType::Int64:
+	case RosType::UInt64: {
+		if (!buffer.readUnsigned(field.type == RosType::UInt32 ? 4 : 8, value))
+			return false;
+		auto& v = addValue();
+		v.type = McapValue::Type::BigInt;
+		v.integer = static_cast<int64_t>(value);
+		return true;
+	}
+	case RosType::Float32: {
+		if (!buffer.readUnsigned(4, value))
+			return false;
+		const auto bits = static_cast<uint32_t>(value);
+		float f;
+		std::memcpy(&f, &bits, sizeof(f));
+		auto& v = addValue();
+		v.type = McapValue::Type::Double;
+		v.number = f;
+		return true;
+	}
+	case RosType::Float64: {
+		if (!buffer.readUnsigned(8, value))
+			return false;
+		auto& v = addValue();
+		v.type = McapValue::Type::Double;
+		std::memcpy(&v.number, &value, sizeof(v.number));
+		return true;
+	}
+	case RosType::String: {
+		if (!buffer.readUnsigned(4, value) || buffer.remaining() < value)
+			return false;
+		// the length includes the terminating null character in CDR
+		const auto length = (m_cdr && value > 0) ? value - 1 : value;
+		auto& v = addValue();
+		v.type = McapValue::Type::Text;
+		v.text.assign(reinterpret_cast<const char*>(buffer.current()), length);
+		return buffer.skip(value);
+	}
+	case RosType::WString: {
+		// wide strings are not imported, the length is the number of the characters with four bytes each
+		if (!buffer.readUnsigned(4, value) || value > buffer.remaining() / 4)
+			return false;
+		return buffer.skip(4 * value);
+	}
+	case RosType::Time:
+	case RosType::Duration: {
+		uint64_t seconds, nanoseconds;
+		if (!buffer.readUnsigned(4, seconds) || !buffer.readUnsigned(4, nanoseconds))
+			return false;
+		auto& v = addValue();
+		if (field.type == RosType::Time) {
+			// unsigned seconds in ROS 1, signed in ROS 2
+			const int64_t s = m_cdr ? static_cast<int32_t>(seconds) : static_cast<int64_t>(seconds);
+			v.type = McapValue::Type::DateTime;
+			v.integer = s * 1000 + static_cast<int64_t>(nanoseconds / 1000000);
+		} else {
+			// signed nanoseconds in ROS 1, unsigned in ROS 2
+			const int64_t ns = m_cdr ? static_cast<int64_t>(nanoseconds) : static_cast<int32_t>(nanoseconds);
+			v.type = McapValue::Type::Double;
+			v.number = static_cast<int32_t>(seconds) + ns * 1e-9;
+		}
+		return true;
+	}
+	case RosType::Message:
+		break;
+	}
+	return false;
+}
+
+// ##############################################################################
+// ############################### Protobuf #####################################
+// ##############################################################################
+//! types of FieldDescriptorProto and the well-known types decoded as values
+enum class ProtobufType {
+	Double = 1,
+	Float,
+	Int64,
+	UInt64,
+	Int32,
+	Fixed64,
+	Fixed32,
+	Bool,
+	String,
+	Group,
+	Message,
+	Bytes,
+	UInt32,
+	Enum,
+	SFixed32,
+	SFixed64,
+	SInt32,
+	SInt64,
+	Timestamp = 100, // google.protobuf.Timestamp
+	Duration // google.protobuf.Duration
+};
+
+struct ProtobufField {
+	std::string name;
+	uint32_t number{0};
+	ProtobufType type{ProtobufType::Int32};
+	bool repeated{false};
+	std::string typeName; // name of the nested message
+	int message{-1}; // index of the nested message
+};
+
+struct ProtobufMessage {
+	std::string name; // full name "package.Type"
+	std::vector<ProtobufField> fields;
+	std::unordered_map<uint32_t, int> fieldIndexes; // index of the field with the number
+};
+
+//! reads the wire format of protocol buffers
+class ProtobufReader {
+public:
+	ProtobufReader(const unsigned char* data, size_t size)
+		: m_data(data)
+		, m_size(size) {
+	}
+
+	bool atEnd() const {
+		return m_position >= m_size;
+	}
+
+	bool readVarint(uint64_t& value) {
+		value = 0;
+		for (int shift = 0; shift < 64; shift += 7) {
+			if (m_position >= m_size)
+				return false;
+			const auto byte = m_data[m_position++];
+			value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+			if (!(byte & 0x80))
+				return true;
+		}
+		return false;
+	}
+
+	//! reads the value of a field with the wire type \c wireType, \c data and \c size are set for length-delimited values
+	bool readValue(int wireType, uint64_t& value, const unsigned char*& data, size_t& size) {
+		switch (wireType) {
+		case 0:
+			return readVarint(value);
+		case 1:
+		case 5: {
+			const size_t bytes = wireType == 1 ? 8 : 4;
+			if (m_size - m_position < bytes)
+				return false;
+			value = 0;
+			for (size_t i = 0; i < bytes; ++i)
+				value |= static_cast<uint64_t>(m_data[m_position + i]) << (8 * i);
+			m_position += bytes;
+			return true;
+		}
+		case 2:
+			if (!readVarint(value) || m_size - m_position < value)
+				return false;
+			data = m_data + m_position;
+			size = value;
+			m_position += value;
+			return true;
+		default: // groups are not supported
+			return false;
+		}
+	}
+
+private:
+	const unsigned char* m_data;
+	size_t m_size;
+	size_t m_position{0};
+};
+
+//! calls \c function(number, wireType, value, data, size) for all fields of the protobuf message \c data
+template<typename Function>
+bool forEachProtobufField(const unsigned char* data, size_t size, Function function) {
+	ProtobufReader reader(data, size);
+	while (!reader.atEnd()) {
+		uint64_t tag, value = 0;
+		const unsigned char* bytes = nullptr;
+		size_t length = 0;
+		if (!reader.readVarint(tag) || !reader.readValue(static_cast<int>(tag & 7), value, bytes, length))
+			return false;
+		function(tag >> 3, static_cast<int>(tag & 7), value, bytes, length);
+	}
+	return true;
+}
+
+std::string protobufString(const unsigned char* data, size_t size) {
+	return std::string(reinterpret_cast<const char*>(data), size);
+}
+
+//! parses the DescriptorProto \c data of the message with the prefix \c prefix ("package." or "package.Outer.") and of its nested messages
+bool parseProtobufMessage(const unsigned char* data, size_t size, const std::string& prefix, std::vector<ProtobufMessage>& messages) {
+	ProtobufMessage message;
+	std::vector<std::pair<const unsigned char*, size_t>> nestedMessages;
+	bool ok = true;
+	ok = forEachProtobufField(data, size, [&](uint64_t number, int wireType, uint64_t, const unsigned char* bytes, size_t length) {
+		if (wireType != 2)
+			return;
+		if (number == 1)
+			message.name = prefix + protobufString(bytes, length);
+		else if (number == 3)
+			nestedMessages.emplace_back(bytes, length);
+		else if (number == 2) {
+			ProtobufField field;
+			ok = ok
+				&& forEachProtobufField(bytes, length, [&field](uint64_t number, int wireType, uint64_t value, const unsigned char* bytes, size_t length) {
+					   if (number == 1 && wireType == 2)
+						   field.name = protobufString(bytes, length);
+					   else if (number == 3 && wireType == 0)
+						   field.number = static_cast<uint32_t>(value);
+					   else if (number == 4 && wireType == 0)
+						   field.repeated = (value == 3); // LABEL_REPEATED
+					   else if (number == 5 && wireType == 0)
+						   field.type = static_cast<ProtobufType>(value);
+					   else if (number == 6 && wireType == 2)
+						   field.typeName = protobufString(bytes, length);
+				   });
+			message.fields.push_back(std::move(field));
+		}
+	}) && ok;
+	if (!ok)
+		return false;
+
+	const auto nestedPrefix = message.name + '.';
+	messages.push_back(std::move(message));
+	for (const auto& nested : nestedMessages) {
+		if (!parseProtobufMessage(nested.first, nested.second, nestedPrefix, messages))
+			return false;
+	}
+	return true;
+}
+
+/*!
+ * parses the FileDescriptorSet \c schema and returns the index of the message \c rootName in \c messages or -1 on errors.
+ */
+int parseProtobufSchema(std::string_view schema, std::string rootName, std::vector<ProtobufMessage>& messages, std::string& error) {
+	const auto* data = reinterpret_cast<const unsigned char*>(schema.data());
+	bool ok = true;
+	ok = forEachProtobufField(data, schema.size(), [&](uint64_t number, int wireType, uint64_t, const unsigned char* bytes, size_t length) {
+		if (number != 1 || wireType != 2) // FileDescriptorProto
+			return;
+
+		std::string package;
+		std::vector<std::pair<const unsigned char*, size_t>> fileMessages;
+		ok = ok && forEachProtobufField(bytes, length, [&](uint64_t number, int wireType, uint64_t, const unsigned char* bytes, size_t length) {
+				 if (number == 2 && wireType == 2)
+					 package = protobufString(bytes, length);
+				 else if (number == 4 && wireType == 2)
+					 fileMessages.emplace_back(bytes, length);
+			 });
+		for (const auto& message : fileMessages)
+			ok = ok && parseProtobufMessage(message.first, message.second, package.empty() ? std::string() : package + '.', messages);
+	}) && ok;
+	if (!ok) {
+		error = "invalid protobuf schema";
+		return -1;
+	}
+
+	std::unordered_map<std::string, int> indexes;
+	for (size_t i = 0; i < messages.size(); ++i)
+		indexes[messages.at(i).name] = static_cast<int>(i);
+
+	for (auto& message : messages) {
+		for (size_t i = 0; i < message.fields.size(); ++i) {
+			auto& field = message.fields[i];
+			message.fieldIndexes[field.number] = static_cast<int>(i);
+			if (field.type == ProtobufType::Group) {
+				error = "groups are not supported";
+				return -1;
+			}
+			if (field.type != ProtobufType::Message)
+				continue;
+
+			if (field.typeName.empty()) {
+				error = "invalid protobuf schema";
+				return -1;
+			}
+			const auto name = field.typeName.substr(field.typeName.front() == '.' ? 1 : 0);
+			if (name == "google.protobuf.Timestamp")
+				field.type = ProtobufType::Timestamp;
+			else if (name == "google.protobuf.Duration")
+				field.type = ProtobufType::Duration;
+			else {
+				const auto it = indexes.find(name);
+				if (it == indexes.end()) {
+					error = "definition of '" + name + "' not found";
+					return -1;
+				}
+				field.message = it->second;
+			}
+		}
+	}
+
+	if (!rootName.empty() && rootName.front() == '.')
+		rootName.erase(0, 1);
+	const auto it = indexes.find(rootName);
+	if (it == indexes.end()) {
+		error = "definition of '" + rootName + "' not found";
+		return -1;
+	}
+	return it->second;
+}
+
+//! wire type of the values of the type \c type
+int protobufWireType(ProtobufType type) {
+	switch (type) {
+	case ProtobufType::Double:
+	case ProtobufType::Fixed64:
+	case ProtobufType::SFixed64:
+		return 1;
+	case ProtobufType::Float:
+	case ProtobufType::Fixed32:
+	case ProtobufType::SFixed32:
+		return 5;
+	case ProtobufType::String:
+	case ProtobufType::Bytes:
+	case ProtobufType::Message:
+	case ProtobufType::Group:
+	case ProtobufType::Timestamp:
+	case ProtobufType::Duration:
+		return 2;
+	case ProtobufType::Int64:
+	case ProtobufType::UInt64:
+	case ProtobufType::Int32:
+	case ProtobufType::Bool:
+	case ProtobufType::UInt32:
+	case ProtobufType::Enum:
+	case ProtobufType::SInt32:
+	case ProtobufType::SInt64:
+		break;
+	}
+	return 0;
+}
+
+class ProtobufDecoder : public McapDecoder {
+public:
+	ProtobufDecoder(std::shared_ptr<const std::vector<ProtobufMessage>> messages, int root)
+		: m_messages(std::move(messages))
+		, m_root(root) {
+	}
+
+	std::unique_ptr<McapDecoder> clone() const override {
+		return std::make_unique<ProtobufDecoder>(m_messages, m_root);
+	}
+
+protected:
+	bool decodeMessage(const unsigned char* data, size_t size) override {
+		m_entries.clear();
+		return decodeFields(data, size, m_root, 0);
+	}
+
+private:
+	//! field of the decoded message
+	struct Entry {
+		int field;
+		int wireType;
+		uint64_t value;
+		const unsigned char* data;
+		size_t size;
+	};
+
+	bool decodeFields(const unsigned char* data, size_t size, int message, int depth);
+	bool decodeRepeated(const ProtobufField&, size_t first, size_t last, int depth);
+	bool decodeValue(const ProtobufField&, Entry, int depth);
+	bool addScalar(ProtobufType, int wireType, uint64_t value, const unsigned char* data, size_t size);
+	void addDefault(const ProtobufField&);
+
+	std::shared_ptr<const std::vector<ProtobufMessage>> m_messages;
+	int m_root;
+	std::vector<Entry> m_entries; // fields of the messages currently decoded, reused for all messages
+};
+
+/*!
+ * decodes the fields of the message \c data in the order of their definition.
+ * Missing fields get the default value, missing nested messages have no values and are marked in the layout.
+ */
+bool ProtobufDecoder::decodeFields(const unsigned char* data, size_t size, int index, int depth) {
+	if (depth > MaxDepth)
+		return false;
+
+	const auto& message = m_messages->at(index);
+	const size_t begin = m_entries.size();
+	bool ok = forEachProtobufField(data, size, [&](uint64_t number, int wireType, uint64_t value, const unsigned char* bytes, size_t length) {
+		const auto it = message.fieldIndexes.find(static_cast<uint32_t>(number));
+		if (it != message.fieldIndexes.end()) // unknown fields are skipped
+			m_entries.push_back(Entry{it->second, wireType, value, bytes, length});
+	});
+	if (!ok) {
+		m_entries.resize(begin);
+		return false;
+	}
+
+	std::stable_sort(m_entries.begin() + begin, m_entries.end(), [](const Entry& a, const Entry& b) {
+		return a.field < b.field;
+	});
+	const size_t end = m_entries.size();
+
+	size_t entry = begin;
+	for (size_t i = 0; ok && i < message.fields.size(); ++i) {
+		const size_t first = entry;
+		while (entry < end && m_entries.at(entry).field == static_cast<int>(i))
+			++entry;
+
+		const auto& field = message.fields.at(i);
+		pushName(field.name);
+		if (field.repeated)
+			ok = decodeRepeated(field, first, entry, depth);
+		else if (field.type == ProtobufType::Bytes) // byte arrays are not imported
+			ok = true;
+		else if (first == entry)
+			addDefault(field);
+		else // the last value counts for fields given multiple times
+			ok = decodeValue(field, m_entries.at(entry - 1), depth);
+		popName();
+	}
+
+	m_entries.resize(begin);
+	return ok;
+}
+
+bool ProtobufDecoder::decodeRepeated(const ProtobufField& field, size_t first, size_t last, int depth) {
+	if (field.type == ProtobufType::Bytes)
+		return true;
+
+	// scalar numbers can be packed into one length-delimited value
+	const int wireType = protobufWireType(field.type);
+	const bool packable = wireType != 2;
+	uint32_t count = 0;
+	for (size_t i = first; i < last; ++i) {
+		const auto& entry = m_entries.at(i);
+		if (packable && entry.wireType == 2) {
+			if (wireType == 0)
+				count += static_cast<uint32_t>(std::count_if(entry.data, entry.data + entry.size, [](unsigned char byte) {
+					return !(byte & 0x80);
+				}));
+			else
+				count += static_cast<uint32_t>(entry.size / (wireType == 1 ? 8 : 4));
+		} else
+			++count;
+	}
+	addLayout(count);
+
+	size_t index = 0;
+	for (size_t i = first; i < last; ++i) {
+		const auto entry = m_entries.at(i);
+		if (packable && entry.wireType == 2) {
+			ProtobufReader reader(entry.data, entry.size);
+			while (!reader.atEnd()) {
+				uint64_t value;
+				const unsigned char* data = nullptr;
+				size_t size = 0;
+				if (!reader.readValue(wireType, value, data, size))
+					return false;
+				pushIndex(index++);
+				const bool ok = addScalar(field.type, wireType, value, data, size);
+				popName();
+				if (!ok)
+					return false;
+			}
+		} else {
+			pushIndex(index++);
+			const bool ok = decodeValue(field, entry, depth);
+			popName();
+			if (!ok)
+				return false;
+		}
+	}
+	return true;
+}
+
+bool ProtobufDecoder::decodeValue(const ProtobufField& field, Entry entry, int depth) {
+	switch (field.type) {
+	case ProtobufType::Message:
+		if (entry.wireType != 2)
+			return false;
+		addLayout(uint32_t(1));
+		return decodeFields(entry.data, entry.size, field.message, depth + 1);
+	case ProtobufType::Timestamp:
+	case ProtobufType::Duration: {
+		if (entry.wireType != 2)
+			return false;
+		int64_t seconds = 0;
+		int32_t nanos = 0;
+		const bool ok = forEachProtobufField(entry.data, entry.size, [&](uint64_t number, int wireType, uint64_t value, const unsigned char*, size_t) {
+			if (number == 1 && wireType == 0)
+				seconds = static_cast<int64_t>(value);
+			else if (number == 2 && wireType == 0)
+				nanos = static_cast<int32_t>(value);
+		});
+		auto& v = addValue();
+		if (field.type == ProtobufType::Timestamp) {
+			v.type = McapValue::Type::DateTime;
+			v.integer = seconds * 1000 + nanos / 1000000;
+		} else {
+			v.type = McapValue::Type::Double;
+			v.number = seconds + nanos * 1e-9;
+		}
+		return ok;
+	}
+	default:
+		return addScalar(field.type, entry.wireType, entry.value, entry.data, entry.size);
+	}
+}
+
+bool ProtobufDecoder::addScalar(ProtobufType type, int wireType, uint64_t value, const unsigned char* data, size_t size) {
+	if (wireType != protobufWireType(type))
+		return false;
+
+	auto& v = addValue();
+	switch (type) {
+	case ProtobufType::Double:
+		v.type = McapValue::Type::Double;
+		std::memcpy(&v.number, &value, sizeof(v.number));
+		break;
+	case ProtobufType::Float: {
+		const auto bits = static_cast<uint32_t>(value);
+		float f;
+		std::memcpy(&f, &bits, sizeof(f));
+		v.type = McapValue::Type::Double;
+		v.number = f;
+		break;
+	}
+	case ProtobufType::Int32:
+	case ProtobufType::Enum:
+	case ProtobufType::SFixed32:
+		v.type = McapValue::Type::Integer;
+		v.integer = static_cast<int32_t>(value);
+		break;
+	case ProtobufType::Bool:
+		v.type = McapValue::Type::Integer;
+		v.integer = value != 0;
+		break;
+	case ProtobufType::SInt32:
+		v.type = McapValue::Type::Integer;
+		v.integer = static_cast<int32_t>(static_cast<uint32_t>(value >> 1) ^ -static_cast<uint32_t>(value & 1));
+		break;
+	case ProtobufType::SInt64:
+		v.type = McapValue::Type::BigInt;
+		v.integer = static_cast<int64_t>((value >> 1) ^ -(value & 1));
+		break;
+	case ProtobufType::Int64:
+	case ProtobufType::UInt64:
+	case ProtobufType::UInt32:
+	case ProtobufType::Fixed32:
+	case ProtobufType::Fixed64:
+	case ProtobufType::SFixed64:
+		v.type = McapValue::Type::BigInt;
+		v.integer = static_cast<int64_t>(value);
+		break;
+	case ProtobufType::String:
+		v.type = McapValue::Type::Text;
+		v.text.assign(reinterpret_cast<const char*>(data), size);
+		break;
+	case ProtobufType::Bytes:
+	case ProtobufType::Group:
+	case ProtobufType::Message:
+	case ProtobufType::Timestamp:
+	case ProtobufType::Duration:
+		return false;
+	}
+	return true;
+}
+
+void ProtobufDecoder::addDefault(const ProtobufField& field) {
+	switch (field.type) {
+	case ProtobufType::Message:
+		addLayout(uint32_t(0));
+		break;
+	case ProtobufType::Timestamp:
+	case ProtobufType::Duration:
+		addValue();
+		break;
+	case ProtobufType::Double:
+	case ProtobufType::Float: {
+		auto& v = addValue();
+		v.type = McapValue::Type::Double;
+		v.number = 0.;
+		break;
+	}
+	case ProtobufType::String: {
+		auto& v = addValue();
+		v.type = McapValue::Type::Text;
+		v.text.clear();
+		break;
+	}
+	case ProtobufType::Int32:
+	case ProtobufType::Enum:
+	case ProtobufType::SFixed32:
+	case ProtobufType::Bool:
+	case ProtobufType::SInt32: {
+		auto& v = addValue();
+		v.type = McapValue::Type::Integer;
+		v.integer = 0;
+		break;
+	}
+	case ProtobufType::SInt64:
+	case ProtobufType::Int64:
+	case ProtobufType::UInt64:
+	case ProtobufType::UInt32:
+	case ProtobufType::Fixed32:
+	case ProtobufType::Fixed64:
+	case ProtobufType::SFixed64: {
+		auto& v = addValue();
+		v.type = McapValue::Type::BigInt;
+		v.integer = 0;
+		break;
+	}
+	case ProtobufType::Bytes:
+	case ProtobufType::Group:
+		break;
+	}
+}
+
+} // namespace
+
+// ##############################################################################
+// ################################ McapDecoder #################################
+// ##############################################################################
+/*!
+ * returns \c true if messages with the encoding \c messageEncoding and the schema encoding \c schemaEncoding can be decoded.
+ */
+bool McapDecoder::isSupported(const std::string& messageEncoding, const std::string& schemaEncoding) {
+	if (messageEncoding == "json")
+		return true;
+	if (messageEncoding == "ros1")
+		return schemaEncoding == "ros1msg";
+	if (messageEncoding == "cdr")
+		return schemaEncoding == "ros2msg";
+	if (messageEncoding == "protobuf")
+		return schemaEncoding == "protobuf";
+	return false;
+}
+
+/*!
+ * creates the decoder for the messages with the encoding \c messageEncoding and the schema \c schema.
+ * returns \c nullptr and sets \c error if the encoding is not supported or the schema is invalid.
+ */
+std::unique_ptr<McapDecoder> McapDecoder::create(const std::string& messageEncoding,
+												 const std::string& schemaEncoding,
+												 const std::string& schemaName,
+												 std::string_view schema,
+												 std::string& error) {
+	if (!isSupported(messageEncoding, schemaEncoding)) {
+		error = "unsupported message encoding '" + messageEncoding + "' with schema encoding '" + schemaEncoding + "'";
+		return nullptr;
+	}
+
+	if (messageEncoding == "json")
+		return std::make_unique<JsonDecoder>();
+
+	if (messageEncoding == "protobuf") {
+		auto messages = std::make_shared<std::vector<ProtobufMessage>>();
+		const int root = parseProtobufSchema(schema, schemaName, *messages, error);
+		if (root < 0)
+			return nullptr;
+		return std::make_unique<ProtobufDecoder>(std::move(messages), root);
+	}
+
+	const bool cdr = (messageEncoding == "cdr");
+	auto messages = std::make_shared<std::vector<RosMessage>>();
+	if (!parseRosDefinitions(schema, schemaName, cdr, *messages, error))
+		return nullptr;
+	return std::make_unique<RosDecoder>(std::move(messages), cdr);
+}
+
+/*!
+ * decodes the message \c data of size \c size, returns \c false if the message doesn't match the schema.
+ * The names of the values are only determined if \c names is \c true.
+ */
+bool McapDecoder::decode(const std::byte* data, size_t size, bool names) {
+	m_valueCount = 0;
+	m_layout.clear();
+	m_names.clear();
+	m_name.clear();
+	m_nameSizes.clear();
+	m_namesEnabled = names;
+	return decodeMessage(reinterpret_cast<const unsigned char*>(data), size);
+}
+
+//! number of values of the last decoded message
+size_t McapDecoder::valueCount() const {
+	return m_valueCount;
+}
+
+const McapValue& McapDecoder::value(size_t index) const {
+	return m_values.at(index);
+}
+
+//! names of the values of the last decoded message, only available if requested in \c decode()
+const std::vector<std::string>& McapDecoder::names() const {
+	return m_names;
+}
+
+//! layout of the last decoded message, messages with the same layout have the values with the same names at the same positions
+const std::string& McapDecoder::layout() const {
+	return m_layout;
+}
+
+bool McapDecoder::namesEnabled() const {
+	return m_namesEnabled;
+}
+
+McapValue& McapDecoder::addValue() {
+	if (m_valueCount == m_values.size())
+		m_values.emplace_back();
+	auto& value = m_values[m_valueCount++];
+	value.type = McapValue::Type::Empty;
+	if (m_namesEnabled)
+		m_names.push_back(m_name);
+	return value;
+}
+
+void McapDecoder::pushName(std::string_view name) {
+	if (!m_namesEnabled)
+		return;
+	const auto size = m_name.size();
+	if (!m_nameSizes.empty())
+		m_name += '.';
+	m_nameSizes.push_back(size);
+	m_name += name;
+}
+
+void McapDecoder::pushIndex(size_t index) {
+	if (m_namesEnabled)
+		pushName(std::to_string(index));
+}
+
+void McapDecoder::popName() {
+	if (!m_namesEnabled)
+		return;
+	m_name.resize(m_nameSizes.back());
+	m_nameSizes.pop_back();
+}
+
+void McapDecoder::addLayout(std::string_view layout) {
+	m_layout += layout;
+}
+
+void McapDecoder::addLayout(uint32_t count) {
+	m_layout.append(reinterpret_cast<const char*>(&count), sizeof(count));
+}
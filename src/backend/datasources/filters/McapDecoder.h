@@ -0,0 +1,84 @@
+/*
+	File                 : McapDecoder.h
+	Project              : LabPlot
+	Description          : Decoders of the messages in MCAP files
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef MCAPDECODER_H
+#define MCAPDECODER_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/*!
+ * \brief Value of a field of a decoded message.
+ */
+struct McapValue {
+	enum class Type { Empty, Double, Integer, BigInt, DateTime, Text };
+
+	Type type{Type::Empty};
+	double number{0.};
+	int64_t integer{0}; // value of Integer and BigInt, milliseconds since the epoch for DateTime
+	std::string text;
+};
+
+/*!
+ * \brief Decodes the messages of one MCAP channel into a flat list of values.
+ *
+ * Nested messages, objects and arrays are flattened, the name of a value consists of the names of the fields
+ * and the indices of the array elements separated by '.', e.g. "pose.position.x" or "ranges.3".
+ * The values are decoded in the order of the fields in the message. Since the number of values and their order
+ * can change from message to message only for dynamic arrays, optional fields and, for JSON, the keys of the objects,
+ * these are collected in the layout. Messages with the same layout have the same values at the same positions,
+ * so the names are only created on request if the layout changes.
+ *
+ * The encodings "json", "ros1" (schema encoding "ros1msg"), "cdr" (schema encoding "ros2msg") and "protobuf"
+ * (schema encoding "protobuf") are supported. Decoders are not thread-safe, \c clone() creates a decoder
+ * sharing the parsed schema for another thread.
+ */
+class McapDecoder {
+public:
+	virtual ~McapDecoder() = default;
+
+	static bool isSupported(const std::string& messageEncoding, const std::string& schemaEncoding);
+	static std::unique_ptr<McapDecoder>
+	create(const std::string& messageEncoding, const std::string& schemaEncoding, const std::string& schemaName, std::string_view schema, std::string& error);
+
+	virtual std::unique_ptr<McapDecoder> clone() const = 0;
+
+	bool decode(const std::byte* data, size_t size, bool names = false);
+
+	size_t valueCount() const;
+	const McapValue& value(size_t index) const;
+	const std::vector<std::string>& names() const;
+	const std::string& layout() const;
+
+protected:
+	virtual bool decodeMessage(const unsigned char* data, size_t size) = 0;
+
+	bool namesEnabled() const;
+	McapValue& addValue();
+	void pushName(std::string_view);
+	void pushIndex(size_t);
+	void popName();
+	void addLayout(std::string_view);
+	void addLayout(uint32_t count);
+
+private:
+	std::vector<McapValue> m_values; // reused for all messages, only the first m_valueCount values belong to the last message
+	size_t m_valueCount{0};
+	std::vector<std::string> m_names;
+	std::string m_layout;
+	bool m_namesEnabled{false};
+	std::string m_name; // name of the current field
+	std::vector<size_t> m_nameSizes; // sizes of m_name before the names of the fields were added
+};
+
+#endif // MCAPDECODER_H
@@ -13,6 +13,8 @@
 #include "backend/core/column/Column.h"
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/datasources/filters/McapFilterPrivate.h"
+#include "backend/lib/DateTimeVector.h"
+#include "backend/lib/Parallel.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/trace.h"
 #include "backend/spreadsheet/Spreadsheet.h"
@@ -27,7 +29,10 @@
 #include <chrono>
 #include <thread>
 
+#include <atomic>
 #include <cmath>
+#include <map>
+#include <numeric>
 
 #ifndef HAVE_LZ4
 #define MCAP_COMPRESSION_NO_LZ4
@@ -41,6 +46,84 @@
 #include "mcap/mcap.hpp"
 #include "mcap/writer.hpp"
 
+namespace {
+//! returns the topics of the channels with a supported message encoding in the order of the channel ids
+QVector<QString> supportedTopics(mcap::McapReader& reader) {
+	const auto& channels = reader.channels();
+	const std::map<mcap::ChannelId, mcap::ChannelPtr> sortedChannels(channels.cbegin(), channels.cend());
+	QVector<QString> topics;
+	for (const auto& [id, channel] : sortedChannels) {
+		const auto schema = reader.schema(channel->schemaId);
+		if (!McapDecoder::isSupported(channel->messageEncoding, schema ? schema->encoding : std::string()))
+			continue;
+		const auto topic = QString::fromStdString(channel->topic);
+		if (!topics.contains(topic))
+			topics << topic;
+	}
+	return topics;
+}
+
+//! copies the record of the chunk at \c offset with \c length bytes into \c record
+bool readChunk(mcap::McapReader& reader, quint64 offset, quint64 length, std::vector<std::byte>& record) {
+	std::byte* data = nullptr;
+	if (reader.dataSource()->read(&data, offset, length) != length)
+		return false;
+	record.assign(data, data + length);
+	return true;
+}
+
+/*!
+ * decompresses the chunk \c record into \c buffer and calls \c function(message) for its messages until it returns \c false.
+ * returns \c false if the chunk can't be read.
+ */
+template<typename Function>
+bool forEachChunkMessage(std::vector<std::byte>& record, mcap::ByteArray& buffer, Function function) {
+	// opcode and length of the record
+	constexpr size_t headerSize = 9;
+	if (record.size() < headerSize)
+		return false;
+	mcap::Chunk chunk;
+	if (!mcap::McapReader::ParseChunk(mcap::Record{mcap::OpCode::Chunk, record.size() - headerSize, record.data() + headerSize}, &chunk).ok())
+		return false;
+
+	const std::byte* data = chunk.records;
+	uint64_t size = chunk.compressedSize;
+	if (chunk.compression == "zstd") {
+#ifdef HAVE_ZSTD
+		if (!mcap::ZStdReader::DecompressAll(chunk.records, chunk.compressedSize, chunk.uncompressedSize, &buffer).ok())
+			return false;
+		data = buffer.data();
+		size = chunk.uncompressedSize;
+#else
+		return false;
+#endif
+	} else if (chunk.compression == "lz4") {
+#ifdef HAVE_LZ4
+		mcap::LZ4Reader lz4Reader;
+		if (!lz4Reader.decompressAll(chunk.records, chunk.compressedSize, chunk.uncompressedSize, &buffer).ok())
+			return false;
+		data = buffer.data();
+		size = chunk.uncompressedSize;
+#else
+		return false;
+#endif
+	} else if (!chunk.compression.empty())
+		return false;
+
+	mcap::BufferReader reader;
+	reader.reset(data, size, size);
+	mcap::RecordReader records(reader, 0, size);
+	while (auto next = records.next()) {
+		if (next->opcode != mcap::OpCode::Message)
+			continue;
+		mcap::Message message;
+		if (mcap::McapReader::ParseMessage(*next, &message).ok() && !function(message))
+			break;
+	}
+	return records.status().ok();
+}
+} // namespace
+
 /*!
 \class McapFilter
 \brief ManagesreadDataFromFile the import/export of data from/to a file formatted using JSON.
@@ -178,6 +261,27 @@ int McapFilter::endColumn() const {
 	return d->endColumn;
 }
 
+/*!
+sets the log time in milliseconds since the epoch of the first message to import.
+*/
+void McapFilter::setStartTime(qint64 time) {
+	d->startTime = time;
+}
+qint64 McapFilter::startTime() const {
+	return d->startTime;
+}
+
+/*!
+sets the log time in milliseconds since the epoch of the last message to import, -1 to import all messages after the start time.
+*/
+void McapFilter::setEndTime(qint64 time) {
+	d->endTime = time;
+}
+qint64 McapFilter::endTime() const {
+	return d->endTime;
+}
+
+
 QString McapFilter::fileInfoString(const QString& fileName) {
 	DEBUG(Q_FUNC_INFO);
 
@@ -216,23 +320,19 @@ QString McapFilter::fileInfoString(const QString& fileName) {
 	}
 
 	info += QLatin1String("<br>");
-	info += QLatin1String("JSON Encoded Topics:");
+	info += i18n("Supported Topics:");
 	info += QLatin1String("<br>");
 
-	int maxNoOfTopics = 5;
-	int topicCount = 0;
-	auto channel_map = reader.channels();
-	std::for_each(channel_map.begin(), channel_map.end(), [&](std::pair<mcap::ChannelId, mcap::ChannelPtr> entry) {
-		if (entry.second->messageEncoding == "json") {
-			info += QString::fromStdString((entry.second->topic));
-			info += QLatin1String("<br>");
-			topicCount += 1;
-			if (topicCount == maxNoOfTopics) {
-				info += QLatin1String("...");
-				info += QLatin1String("<br>");
-			}
-		}
-	});
+	const int maxNoOfTopics = 5;
+	const auto& topics = supportedTopics(reader);
+	for (int i = 0; i < std::min(static_cast<int>(topics.size()), maxNoOfTopics); ++i) {
+		info += topics.at(i);
+		info += QLatin1String("<br>");
+	}
+	if (topics.size() > maxNoOfTopics) {
+		info += QLatin1String("...");
+		info += QLatin1String("<br>");
+	}
 
 	return info;
 }
@@ -245,486 +345,603 @@ McapFilterPrivate::McapFilterPrivate(McapFilter* owner)
 }
 
 /*!
-returns 1 if row is invalid and 0 otherwise.
-*/
-int McapFilterPrivate::checkRow(QJsonValueRef value, int& countCols) {
-	switch (rowType) {
-	// TODO: implement other value types
-	case QJsonValue::Array: {
-		auto row = value.toArray();
-		if (row.isEmpty())
-			return 1;
-		countCols = (countCols == -1 || countCols > row.count()) ? row.count() : countCols;
-		break;
-	}
-	case QJsonValue::Object: {
-		auto row = value.toObject();
-		if (row.isEmpty())
-			return 1;
-		countCols = (countCols == -1 || countCols > row.count()) ? row.count() : countCols;
-		break;
+ * opens the file \c fileName, creates the decoders for the channels of the current topic, selects the chunks with messages
+ * of these channels in the selected time range and determines the columns from the first message.
+ * returns \c false and sets the last error if nothing can be imported.
+ */
+bool McapFilterPrivate::prepareToRead(mcap::McapReader& reader, const QString& fileName) {
+	DEBUG(Q_FUNC_INFO << ", topic = " << STDSTRING(current_topic));
+	auto* filter = const_cast<McapFilter*>(q);
+
+	auto status = reader.open(STDSTRING(fileName));
+	if (status.ok())
+		status = reader.readSummary(mcap::ReadSummaryMethod::AllowFallbackScan);
+	if (!status.ok()) {
+		filter->setLastError(i18n("Failed to read the file. Reason: %1", QString::fromStdString(status.message)));
+		return false;
 	}
-	case QJsonValue::Double:
-	case QJsonValue::String:
-	case QJsonValue::Bool:
-	case QJsonValue::Null:
-	case QJsonValue::Undefined:
-		return 1;
+
+	if (current_topic.isEmpty()) {
+		const auto& topics = supportedTopics(reader);
+		if (topics.isEmpty()) {
+			filter->setLastError(i18n("No topics with a supported message encoding found."));
+			return false;
+		}
+		current_topic = topics.constFirst();
 	}
-	return 0;
-}
 
-/*!
-returns -1 if a parse error has occurred, 1 if the current row type not supported and 0 otherwise.
-*/
-int McapFilterPrivate::parseColumnModes(const QJsonValue& row, const QString& /*rowName*/) {
-	columnModes.clear();
-	vectorNames.clear();
+	m_decoders.clear();
+	const auto topic = current_topic.toStdString();
+	for (const auto& [id, channel] : reader.channels()) {
+		if (channel->topic != topic)
+			continue;
 
-	// add index column if required
-	if (createIndexEnabled) {
-		columnModes << AbstractColumn::ColumnMode::Integer;
-		vectorNames << i18n("index");
+		std::string error;
+		std::unique_ptr<McapDecoder> decoder;
+		if (const auto schema = reader.schema(channel->schemaId))
+			decoder = McapDecoder::create(channel->messageEncoding,
+										  schema->encoding,
+										  schema->name,
+										  std::string_view(reinterpret_cast<const char*>(schema->data.data()), schema->data.size()),
+										  error);
+		else
+			decoder = McapDecoder::create(channel->messageEncoding, std::string(), std::string(), std::string_view(), error);
+		if (!decoder) {
+			filter->setLastError(i18n("Failed to decode the messages of the topic %1. Reason: %2", current_topic, QString::fromStdString(error)));
+			return false;
+		}
+		m_decoders[id].decoder = std::move(decoder);
+	}
+	if (m_decoders.empty()) {
+		filter->setLastError(i18n("Topic %1 not found.", current_topic));
+		return false;
 	}
 
-	// determine the column modes and names
-	for (int i = startColumn - 1; i < endColumn; ++i) {
-		QJsonValue columnValue;
-
-		QString key = row.toObject().keys().at(i);
-		vectorNames << key;
-		columnValue = row.toObject().value(key);
-		if (key == QLatin1String("logTime") || key == QLatin1String("publishTime")) {
-			columnModes << AbstractColumn::ColumnMode::DateTime;
+	// the chunk indexes are used to read only the chunks with messages of the topic in the time range
+	m_chunks.clear();
+	for (const auto& chunkIndex : reader.chunkIndexes()) {
+		if (static_cast<qint64>(chunkIndex.messageEndTime / 1000000) < startTime
+			|| (endTime >= 0 && static_cast<qint64>(chunkIndex.messageStartTime / 1000000) > endTime))
 			continue;
-		}
-		if (key == QLatin1String("sequence")) {
-			columnModes << AbstractColumn::ColumnMode::Integer;
+		// chunks without message indexes can contain messages of all channels
+		const auto& offsets = chunkIndex.messageIndexOffsets;
+		if (!offsets.empty() && std::none_of(m_decoders.cbegin(), m_decoders.cend(), [&offsets](const auto& decoder) {
+				return offsets.count(decoder.first) > 0;
+			}))
 			continue;
-		}
-		switch (columnValue.type()) {
-		case QJsonValue::Double:
-			columnModes << AbstractColumn::ColumnMode::Double;
+		m_chunks.push_back(Chunk{chunkIndex.chunkStartOffset, chunkIndex.chunkLength});
+	}
+	std::sort(m_chunks.begin(), m_chunks.end(), [](const Chunk& a, const Chunk& b) {
+		return a.offset < b.offset;
+	});
+
+	// the columns are determined from the values of the first message
+	const McapDecoder* first = nullptr;
+	ChannelDecoder* firstChannel = nullptr;
+	forEachMessage(reader, [&](const mcap::Message& message) {
+		auto& channel = m_decoders[message.channelId];
+		if (!channel.decoder->decode(message.data, message.dataSize, true))
+			return true;
+		first = channel.decoder.get();
+		firstChannel = &channel;
+		return false;
+	});
+	if (!first) {
+		filter->setLastError(i18n("No messages of the topic %1 found.", current_topic));
+		return false;
+	}
+
+	// the columns are sorted by their names, the fields of the message record replace values with the same names
+	std::map<QString, AbstractColumn::ColumnMode> columns;
+	for (size_t i = 0; i < first->valueCount(); ++i) {
+		const auto& value = first->value(i);
+		auto mode = AbstractColumn::ColumnMode::Double;
+		switch (value.type) {
+		case McapValue::Type::Empty:
+		case McapValue::Type::Double:
+			break;
+		case McapValue::Type::Integer:
+			mode = AbstractColumn::ColumnMode::Integer;
+			break;
+		case McapValue::Type::BigInt:
+			mode = AbstractColumn::ColumnMode::BigInt;
+			break;
+		case McapValue::Type::DateTime:
+			mode = AbstractColumn::ColumnMode::DateTime;
 			break;
-		case QJsonValue::String:
-			columnModes << AbstractFileFilter::columnMode(columnValue.toString(), dateTimeFormat, numberFormat);
+		case McapValue::Type::Text:
+			mode = AbstractFileFilter::columnMode(QString::fromStdString(value.text), dateTimeFormat, numberFormat);
+			if (mode == AbstractColumn::ColumnMode::Month || mode == AbstractColumn::ColumnMode::Day)
+				mode = AbstractColumn::ColumnMode::Text;
 			break;
-		case QJsonValue::Array:
-		case QJsonValue::Object:
-		case QJsonValue::Bool:
-		case QJsonValue::Null:
-		case QJsonValue::Undefined:
-			return -1;
 		}
+		columns[QString::fromStdString(first->names().at(i))] = mode;
 	}
+	columns[QStringLiteral("logTime")] = AbstractColumn::ColumnMode::DateTime;
+	columns[QStringLiteral("publishTime")] = AbstractColumn::ColumnMode::DateTime;
+	columns[QStringLiteral("sequence")] = AbstractColumn::ColumnMode::Integer;
 
-	return 0;
-}
-
-void McapFilterPrivate::setEmptyValue(int column, int row) {
-	switch (columnModes.at(column)) {
-	case AbstractColumn::ColumnMode::Double:
-		static_cast<QVector<double>*>(m_dataContainer[column])->operator[](row) = nanValue;
-		break;
-	case AbstractColumn::ColumnMode::Integer:
-		static_cast<QVector<int>*>(m_dataContainer[column])->operator[](row) = 0;
-		break;
-	case AbstractColumn::ColumnMode::BigInt:
-		static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = 0;
-		break;
-	case AbstractColumn::ColumnMode::DateTime:
-		static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) = QDateTime();
-		break;
-	case AbstractColumn::ColumnMode::Text:
-		static_cast<QVector<QString>*>(m_dataContainer[column])->operator[](row) = QString();
-		break;
-	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::Day:
-		break;
+	const int lastColumn = (endColumn == -1 || endColumn > static_cast<int>(columns.size())) ? static_cast<int>(columns.size()) : endColumn;
+	if (startColumn < 1 || startColumn > lastColumn) {
+		filter->setLastError(i18n("No columns selected."));
+		return false;
 	}
-}
 
-void McapFilterPrivate::setValueFromString(int column, int row, const QString& valueString) {
-	QLocale locale(numberFormat);
-	switch (columnModes.at(column)) {
-	case AbstractColumn::ColumnMode::Double: {
-		bool isNumber;
-		const double value = locale.toDouble(valueString, &isNumber);
-		static_cast<QVector<double>*>(m_dataContainer[column])->operator[](row) = isNumber ? value : nanValue;
-		break;
-	}
-	case AbstractColumn::ColumnMode::Integer: {
-		bool isNumber;
-		const int value = locale.toInt(valueString, &isNumber);
-		static_cast<QVector<int>*>(m_dataContainer[column])->operator[](row) = isNumber ? value : 0;
-		break;
+	columnModes.clear();
+	vectorNames.clear();
+	if (createIndexEnabled) {
+		columnModes << AbstractColumn::ColumnMode::Integer;
+		vectorNames << i18n("index");
 	}
-	case AbstractColumn::ColumnMode::BigInt: {
-		bool isNumber;
-		const qint64 value = locale.toLongLong(valueString, &isNumber);
-		static_cast<QVector<qint64>*>(m_dataContainer[column])->operator[](row) = isNumber ? value : 0;
-		break;
+
+	m_columnIndexes.clear();
+	auto it = columns.cbegin();
+	std::advance(it, startColumn - 1);
+	for (int i = 0; i < lastColumn - startColumn + 1; ++i, ++it) {
+		m_columnIndexes[it->first.toStdString()] = i;
+		vectorNames << it->first;
+		columnModes << it->second;
 	}
-	case AbstractColumn::ColumnMode::DateTime: {
-		if (vectorNames[column] == QLatin1String("publishTime") || vectorNames[column] == QLatin1String("logTime")) {
-			static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) = QDateTime::fromMSecsSinceEpoch(valueString.toLong());
-			break;
+	const auto columnIndex = [this](const char* name) {
+		const auto it = m_columnIndexes.find(name);
+		return it != m_columnIndexes.end() ? it->second : -1;
+	};
+	m_logTimeColumn = columnIndex("logTime");
+	m_publishTimeColumn = columnIndex("publishTime");
+	m_sequenceColumn = columnIndex("sequence");
+	mapValues(*firstChannel);
+
+	m_actualCols = static_cast<int>(columnModes.size());
+	m_numberParser = NumberParser(QLocale(numberFormat));
+	m_dateTimeParser = DateTimeParser(dateTimeFormat);
+
+	DEBUG("start/end column: = " << startColumn << ' ' << lastColumn);
+	DEBUG("actual cols = " << m_actualCols << ", chunks = " << m_chunks.size());
+	return true;
+}
+
+/*!
+ * calls \c function(message) for the messages of the current topic in the selected time range in the order of the file
+ * until it returns \c false. The messages are read from the selected chunks or, if the file has no chunks, from the whole file.
+ */
+template<typename Function>
+void McapFilterPrivate::forEachMessage(mcap::McapReader& reader, Function function) {
+	if (reader.chunkIndexes().empty()) {
+		mcap::ReadMessageOptions options;
+		options.readOrder = mcap::ReadMessageOptions::ReadOrder::FileOrder;
+		options.startTime = static_cast<mcap::Timestamp>(std::max(startTime, qint64(0))) * 1000000;
+		if (endTime >= 0)
+			options.endTime = static_cast<mcap::Timestamp>(endTime + 1) * 1000000;
+		const auto onProblem = [](const mcap::Status& status) {
+			WARN("Problem reading the MCAP file: " << status.message);
+		};
+		for (const auto& view : reader.readMessages(onProblem, options)) {
+			if (selectedMessage(view.message) && !function(view.message))
+				break;
 		}
-		const QDateTime valueDateTime = QDateTime::fromString(valueString, dateTimeFormat);
-		static_cast<QVector<QDateTime>*>(m_dataContainer[column])->operator[](row) = valueDateTime.isValid() ? valueDateTime : QDateTime();
-		break;
+		return;
 	}
-	case AbstractColumn::ColumnMode::Text:
-		static_cast<QVector<QString>*>(m_dataContainer[column])->operator[](row) = valueString;
-		break;
-	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::Day:
-		break;
+
+	std::vector<std::byte> record;
+	mcap::ByteArray buffer;
+	for (const auto& chunk : m_chunks) {
+		bool more = true;
+		if (!readChunk(reader, chunk.offset, chunk.length, record))
+			continue;
+		forEachChunkMessage(record, buffer, [&](const mcap::Message& message) {
+			if (selectedMessage(message))
+				more = function(message);
+			return more;
+		});
+		if (!more)
+			break;
 	}
 }
 
 /*!
-	determines the relevant part of the full JSON document to be read and its structure.
-	returns \c true if successful, \c false otherwise.
-*/
-bool McapFilterPrivate::prepareDocumentToRead() {
-	DEBUG(Q_FUNC_INFO);
-	PERFTRACE(QStringLiteral("Prepare the JSON document to read"));
-
-	if (!m_preparedDoc.isEmpty()) {
-		if (m_preparedDoc.isArray())
-			containerType = McapFilter::DataContainerType::Array;
-		else if (m_preparedDoc.isObject())
-			containerType = McapFilter::DataContainerType::Object;
-		else
-			return false;
-	} else
-		return false;
-
-	int countRows = 0;
-	int countCols = -1;
-	QJsonValue firstRow;
-	QString firstRowName;
+ * decodes the messages of the current topic in the selected time range into rows in the order of the file and calls
+ * \c function(rows, first, count) for the rows [first, first + count) of each part of the rows, starting at the start row.
+ * At most \c maxRows rows are passed. The reading stops if \c function returns \c false.
+ *
+ * The chunks are read one after the other and decompressed and decoded in parallel in batches. The first batches are small,
+ * so the preview doesn't decode more chunks than needed.
+ */
+template<typename Function>
+void McapFilterPrivate::readRows(mcap::McapReader& reader, int maxRows, Function function) {
+	if (endRow >= 0)
+		maxRows = std::min(maxRows, endRow - startRow + 1);
+	int skipRows = startRow - 1;
+	int rows = 0;
+	bool more = maxRows > 0;
+	const auto passRows = [&](Rows& part) {
+		const int first = std::min(part.count, skipRows);
+		skipRows -= first;
+		const int count = std::min(part.count - first, maxRows - rows);
+		if (count > 0) {
+			more = function(part, first, count);
+			rows += count;
+		}
+		more = more && rows < maxRows;
+		return more;
+	};
 
-	switch (containerType) {
-	case McapFilter::DataContainerType::Array: {
-		auto arr = m_preparedDoc.array();
-		int count = arr.count();
-		if (count < startRow)
-			return false;
+	if (reader.chunkIndexes().empty()) {
+		auto decoders = cloneDecoders();
+		Rows part;
+		part.columns.resize(m_actualCols - createIndexEnabled);
+		forEachMessage(reader, [&](const mcap::Message& message) {
+			decodeMessage(message, decoders, part);
+			if (part.count < 10000)
+				return true;
+			passRows(part);
+			part = Rows();
+			part.columns.resize(m_actualCols - createIndexEnabled);
+			return more;
+		});
+		if (more)
+			passRows(part);
+		return;
+	}
 
-		int endRowOffset = (endRow == -1 || endRow > count) ? count : endRow;
-		firstRow = *(arr.begin() + (startRow - 1));
-		for (QJsonArray::iterator it = arr.begin() + (startRow - 1); it != arr.begin() + endRowOffset; ++it) {
-			if (checkRow(*it, countCols) != 0)
-				return false;
-			countRows++;
+	const int threads = std::max(QThreadPool::globalInstance()->maxThreadCount(), 1);
+	std::atomic<bool> failed{false};
+	size_t batchSize = 1;
+	for (size_t batchStart = 0; more && batchStart < m_chunks.size(); batchStart += batchSize, batchSize = std::min(2 * batchSize, size_t(4 * threads))) {
+		// the file is read sequentially, only the decompression and the decoding are done in parallel
+		const size_t batchEnd = std::min(batchStart + batchSize, m_chunks.size());
+		std::vector<std::vector<std::byte>> records(batchEnd - batchStart);
+		for (size_t i = 0; i < records.size(); ++i) {
+			const auto& chunk = m_chunks.at(batchStart + i);
+			if (!readChunk(reader, chunk.offset, chunk.length, records[i]))
+				failed = true;
 		}
-		break;
-	}
-	case McapFilter::DataContainerType::Object: {
-		auto obj = m_preparedDoc.object();
-		if (obj.count() < startRow)
-			return false;
 
-		int startRowOffset = startRow - 1;
-		int endRowOffset = (endRow == -1 || endRow > obj.count()) ? obj.count() : endRow;
-		firstRow = *(obj.begin() + startRowOffset);
-		firstRowName = (obj.begin() + startRowOffset).key();
-		for (QJsonObject::iterator it = obj.begin() + startRowOffset; it != obj.begin() + endRowOffset; ++it) {
-			if (checkRow(*it, countCols) != 0)
-				return false;
-			countRows++;
+		std::vector<Rows> parts(records.size());
+		Parallel::forRanges(static_cast<int>(parts.size()), 1, [&](int start, int end) {
+			auto decoders = cloneDecoders();
+			mcap::ByteArray buffer;
+			for (int i = start; i < end; ++i) {
+				auto& part = parts[i];
+				part.columns.resize(m_actualCols - createIndexEnabled);
+				if (!records[i].empty() && !forEachChunkMessage(records[i], buffer, [&](const mcap::Message& message) {
+						if (selectedMessage(message))
+							decodeMessage(message, decoders, part);
+						return true;
+					}))
+					failed = true;
+				records[i] = std::vector<std::byte>();
+			}
+		});
+
+		for (auto& part : parts) {
+			if (!passRows(part))
+				break;
 		}
 
-		break;
+		Q_EMIT q->completed(static_cast<int>(100. * batchEnd / m_chunks.size()));
+		QApplication::processEvents(QEventLoop::AllEvents, 0);
 	}
-	}
-
-	if (endColumn == -1 || endColumn > countCols)
-		endColumn = countCols;
 
-	m_actualRows = countRows;
-	m_actualCols = endColumn - startColumn + 1 + createIndexEnabled;
+	if (failed)
+		const_cast<McapFilter*>(q)->setLastError(i18n("Failed to read some chunks of the file."));
+}
 
-	if (parseColumnModes(firstRow, firstRowName) != 0)
-		return false;
+//! returns \c true if \c message belongs to the current topic and is in the selected time range
+bool McapFilterPrivate::selectedMessage(const mcap::Message& message) const {
+	const auto time = static_cast<qint64>(message.logTime / 1000000);
+	return m_decoders.count(message.channelId) > 0 && time >= startTime && (endTime < 0 || time <= endTime);
+}
 
-	DEBUG("start/end column: = " << startColumn << ' ' << endColumn);
-	DEBUG("start/end rows = " << startRow << ' ' << endRow);
-	DEBUG("actual cols/rows = " << m_actualCols << ' ' << m_actualRows);
+McapFilterPrivate::Decoders McapFilterPrivate::cloneDecoders() const {
+	Decoders decoders;
+	for (const auto& [id, channel] : m_decoders)
+		decoders[id] = ChannelDecoder{channel.decoder->clone(), channel.mapped, channel.layout, channel.columns};
+	return decoders;
+}
 
-	return true;
+//! assigns the values of the message decoded last by the decoder of \c channel with their names to the columns
+void McapFilterPrivate::mapValues(ChannelDecoder& channel) const {
+	const auto& names = channel.decoder->names();
+	channel.columns.resize(names.size());
+	for (size_t i = 0; i < names.size(); ++i) {
+		const auto it = m_columnIndexes.find(names.at(i));
+		channel.columns[i] = (it != m_columnIndexes.end()) ? it->second : -1;
+	}
+	channel.layout = channel.decoder->layout();
+	channel.mapped = true;
 }
 
-int McapFilterPrivate::mcapToJson(const QString& fileName, int lines) {
-	DEBUG(Q_FUNC_INFO);
-	DEBUG("MCAP Filter mcapToJson:" << STDSTRING(current_topic));
+/*!
+ * decodes \c message with the decoder of its channel in \c decoders and appends its values as a new row to \c rows.
+ * returns \c false if the message can't be decoded.
+ */
+bool McapFilterPrivate::decodeMessage(const mcap::Message& message, Decoders& decoders, Rows& rows) const {
+	const auto it = decoders.find(message.channelId);
+	if (it == decoders.end())
+		return false;
 
-	mcap::McapReader reader;
-	{
-		const auto res = reader.open(STDSTRING(fileName));
-		if (!res.ok()) {
-			std::cerr << "Failed to open " << STDSTRING(fileName) << " for reading: " << res.message << std::endl;
-			const_cast<McapFilter*>(q)->setLastError(i18n("Failed to read the file. Reason: %1", QString::fromStdString(res.message)));
-			return 0;
-		}
+	auto& channel = it->second;
+	auto& decoder = *channel.decoder;
+	if (!decoder.decode(message.data, message.dataSize))
+		return false;
+	if (!channel.mapped || decoder.layout() != channel.layout) {
+		// the values are at other positions than in the previous message, they are assigned to the columns by their names
+		decoder.decode(message.data, message.dataSize, true);
+		mapValues(channel);
 	}
 
-	if (current_topic == QLatin1String("")) {
-		auto topics = getValidTopics(fileName); // Todo: make this more efficient. Only open file once.
-		if (topics.size() == 0) {
-			const_cast<McapFilter*>(q)->setLastError(i18n("No JSON encoded topics found."));
-			return 0;
+	const int row = rows.count++;
+	for (size_t column = 0; column < rows.columns.size(); ++column) {
+		auto& values = rows.columns[column];
+		switch (columnModes.at(column + createIndexEnabled)) {
+		case AbstractColumn::ColumnMode::Double:
+			values.doubles.append(nanValue);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			values.integers.append(0);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			values.bigInts.append(0);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+			values.bigInts.append(DateTimeVector::InvalidValue);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			values.texts.append(QString());
+			break;
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
 		}
-		current_topic = topics[0];
 	}
 
-	mcap::ReadMessageOptions opt;
-
-	std::function<bool(std::string_view)> lambda2 = [this](std::string_view v) {
-		std::string s{v};
-		return QString::fromStdString(s) == current_topic;
-	};
-	opt.topicFilter = lambda2;
-	auto messageView = reader.readMessages(nullptr, opt);
-
-	// Get number of messages in view
-	int msg_count = 0;
-
-	QJsonArray jsonArray;
-	try {
-		for (auto it = messageView.begin(); it != messageView.end(); it++) {
-			// skip any non-json-encoded messages.
-			// qDebug() << "Processing topic " << QString::fromStdString(it->channel->topic) << "with encoding"
-			// 		 << QString::fromStdString(it->channel->messageEncoding);
-
-			if (it->channel->messageEncoding != "json") { // only support json encoding for now
-				continue;
-			}
-			if (current_topic != QLatin1String("")) {
-				if (QString::fromStdString(it->channel->topic) != current_topic) { // only support json encoding for now
-					continue;
-				}
-			}
-
-			// Without going to string_view first I get this error:
-			// 32: QWARN  : MCAPFilterTest::testArrayImport() Error parsing JSON string: "{\"value\": 0}\u0005" "garbage at the end of the document"
-			std::string_view a(reinterpret_cast<const char*>(it->message.data), it->message.dataSize);
-
-			QString asString = QString::fromStdString(std::string(a));
-			QJsonParseError error;
-			auto jsonDocument = QJsonDocument::fromJson(asString.toUtf8(), &error);
-
-			auto obj = flattenJson(jsonDocument.object());
-
-			// TODO: handle seqeunce, and times as longs instead of strings
-			obj.insert(QLatin1String("sequence"), QJsonValue::fromVariant(QString::number(it->message.sequence)));
-			obj.insert(QLatin1String("logTime"), QJsonValue::fromVariant(QString::number(it->message.logTime / 1000000))); // nano to milli otherwise value is 0
-			obj.insert(QLatin1String("publishTime"),
-					   QJsonValue::fromVariant(QString::number(it->message.publishTime / 1000000))); // nano to milli otherwise value is 0
+	for (size_t i = 0; i < decoder.valueCount(); ++i) {
+		const int column = channel.columns.at(i);
+		if (column >= 0)
+			setValue(rows.columns[column], column, row, decoder.value(i));
+	}
 
-			if (error.error != QJsonParseError::NoError) {
-				qWarning() << "Error parsing JSON string:" << asString << error.errorString();
-				continue;
-			}
+	// the fields of the message record
+	if (m_logTimeColumn != -1)
+		rows.columns[m_logTimeColumn].bigInts[row] = static_cast<qint64>(message.logTime / 1000000);
+	if (m_publishTimeColumn != -1)
+		rows.columns[m_publishTimeColumn].bigInts[row] = static_cast<qint64>(message.publishTime / 1000000);
+	if (m_sequenceColumn != -1)
+		rows.columns[m_sequenceColumn].integers[row] = static_cast<int>(message.sequence);
 
-			// Check if the parsed JSON document is an object
-			if (!jsonDocument.isObject()) {
-				qWarning() << "JSON string does not contain an object:" << asString;
-				continue;
-			}
+	return true;
+}
 
-			// Convert the JSON document to a JSON object and add it to the JSON array
-			// foreach (const QString& key, jsonDocument.object().keys()) {
-			// 	QJsonValue value = jsonDocument.object().value(key);
-			// 	qDebug() << "Key = " << key << ", Value = " << value;
-			// }
-			jsonArray.append(obj);
-			msg_count++;
-			if (msg_count == lines) {
-				qDebug() << "Stop reading MCAP file. Requested number of " << lines << "lines reached.";
+/*!
+ * converts \c value to the mode of the column \c column and sets it in \c values at \c row.
+ * Values that can't be converted keep the empty value of the column.
+ */
+void McapFilterPrivate::setValue(Rows::Column& values, int column, int row, const McapValue& value) const {
+	const auto& text = value.text;
+	bool ok;
+	switch (columnModes.at(column + createIndexEnabled)) {
+	case AbstractColumn::ColumnMode::Double:
+		if (value.type == McapValue::Type::Double)
+			values.doubles[row] = value.number;
+		else if (value.type == McapValue::Type::Integer || value.type == McapValue::Type::BigInt)
+			values.doubles[row] = static_cast<double>(value.integer);
+		else if (value.type == McapValue::Type::Text) {
+			const double number = m_numberParser.toDouble(QByteArrayView(text.data(), text.size()), &ok);
+			values.doubles[row] = ok ? number : nanValue;
+		}
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		if (value.type == McapValue::Type::Integer)
+			values.integers[row] = static_cast<int>(value.integer);
+		else if (value.type == McapValue::Type::Text) {
+			const int number = m_numberParser.toInt(QByteArrayView(text.data(), text.size()), &ok);
+			values.integers[row] = ok ? number : 0;
+		}
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		if (value.type == McapValue::Type::Integer || value.type == McapValue::Type::BigInt)
+			values.bigInts[row] = value.integer;
+		else if (value.type == McapValue::Type::Text) {
+			const qint64 number = m_numberParser.toLongLong(QByteArrayView(text.data(), text.size()), &ok);
+			values.bigInts[row] = ok ? number : 0;
+		}
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+		if (value.type == McapValue::Type::DateTime)
+			values.bigInts[row] = value.integer;
+		else if (value.type == McapValue::Type::Text) {
+			qint64 msecs;
+			if (m_dateTimeParser.toMSecsSinceEpoch(QByteArrayView(text.data(), text.size()), msecs)) {
+				values.bigInts[row] = msecs;
 				break;
 			}
+			auto dateTime = QDateTime::fromString(QString::fromStdString(text), dateTimeFormat);
+			dateTime.setTimeSpec(Qt::UTC);
+			if (dateTime.isValid())
+				values.bigInts[row] = dateTime.toMSecsSinceEpoch();
+		}
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		switch (value.type) {
+		case McapValue::Type::Empty:
+			break;
+		case McapValue::Type::Double:
+			values.texts[row] = QString::number(value.number, 'g', 16);
+			break;
+		case McapValue::Type::Integer:
+		case McapValue::Type::BigInt:
+			values.texts[row] = QString::number(value.integer);
+			break;
+		case McapValue::Type::DateTime:
+			values.texts[row] = QDateTime::fromMSecsSinceEpoch(value.integer, QTimeZone::UTC).toString(dateTimeFormat);
+			break;
+		case McapValue::Type::Text:
+			values.texts[row] = QString::fromStdString(text);
+			break;
 		}
-	} catch (const std::exception& e) { std::cerr << "Error parsing MCAP file: " << e.what() << std::endl; }
+		break;
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+}
 
-	QJsonDocument finalJsonDocument(jsonArray);
+//! moves the rows [first, first + count) of \c rows to the data containers starting at \c row
+void McapFilterPrivate::appendRows(Rows& rows, int first, int count, int row) {
+	if (createIndexEnabled) {
+		auto* index = static_cast<QVector<int>*>(m_dataContainer[0]);
+		std::iota(index->begin() + row, index->begin() + row + count, row + 1);
+	}
 
-	// qDebug() << finalJsonDocument.toJson(QJsonDocument::Compact);
+	for (size_t column = 0; column < rows.columns.size(); ++column) {
+		auto& values = rows.columns[column];
+		void* container = m_dataContainer[column + createIndexEnabled];
+		switch (columnModes.at(column + createIndexEnabled)) {
+		case AbstractColumn::ColumnMode::Double:
+			std::copy_n(values.doubles.cbegin() + first, count, static_cast<QVector<double>*>(container)->begin() + row);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			std::copy_n(values.integers.cbegin() + first, count, static_cast<QVector<int>*>(container)->begin() + row);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			std::copy_n(values.bigInts.cbegin() + first, count, static_cast<QVector<qint64>*>(container)->begin() + row);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+			std::copy_n(values.bigInts.cbegin() + first, count, static_cast<DateTimeVector*>(container)->data() + row);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			std::move(values.texts.begin() + first, values.texts.begin() + first + count, static_cast<QVector<QString>*>(container)->begin() + row);
+			break;
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			break;
+		}
+	}
+}
 
-	m_preparedDoc = finalJsonDocument;
-	return msg_count;
+void McapFilterPrivate::resizeDataContainer(int rows) {
+	for (int i = 0; i < m_actualCols; ++i) {
+		switch (columnModes.at(i)) {
+		case AbstractColumn::ColumnMode::Double:
+			static_cast<QVector<double>*>(m_dataContainer[i])->resize(rows);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			static_cast<QVector<int>*>(m_dataContainer[i])->resize(rows);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			static_cast<QVector<qint64>*>(m_dataContainer[i])->resize(rows);
+			break;
+		case AbstractColumn::ColumnMode::DateTime:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::Day:
+			static_cast<DateTimeVector*>(m_dataContainer[i])->resize(rows);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			static_cast<QVector<QString>*>(m_dataContainer[i])->resize(rows);
+			break;
+		}
+	}
+}
+
+//! returns the string of the value in the column \c column at \c row of \c rows for the preview
+QString McapFilterPrivate::valueString(const Rows& rows, int column, int row) const {
+	const auto& values = rows.columns.at(column);
+	switch (columnModes.at(column + createIndexEnabled)) {
+	case AbstractColumn::ColumnMode::Double:
+		return QString::number(values.doubles.at(row), 'g', 16);
+	case AbstractColumn::ColumnMode::Integer:
+		return QString::number(values.integers.at(row));
+	case AbstractColumn::ColumnMode::BigInt:
+		return QString::number(values.bigInts.at(row));
+	case AbstractColumn::ColumnMode::DateTime: {
+		const auto msecs = values.bigInts.at(row);
+		if (msecs == DateTimeVector::InvalidValue)
+			return {};
+		return QDateTime::fromMSecsSinceEpoch(msecs, QTimeZone::UTC).toString(dateTimeFormat);
+	}
+	case AbstractColumn::ColumnMode::Text:
+		return values.texts.at(row);
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day:
+		break;
+	}
+	return {};
 }
 
 /*!
 reads the content of the file \c fileName to the data source \c dataSource. Uses the settings defined in the data source.
 */
 void McapFilterPrivate::readDataFromFile(const QString& fileName, AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode) {
-	DEBUG("MCAP Filter: Trying to open file:" << STDSTRING(fileName));
+	DEBUG(Q_FUNC_INFO << ", file name = " << STDSTRING(fileName));
+	PERFTRACE(QStringLiteral("Import the MCAP file"));
 
-	int msg_count = mcapToJson(fileName);
-	bool success = prepareDocumentToRead();
-	if (success)
-		importData(dataSource, importMode, msg_count);
-}
+	mcap::McapReader reader;
+	if (!prepareToRead(reader, fileName))
+		return;
+
+	bool ok = true;
+	m_columnOffset = dataSource->prepareImport(m_dataContainer, importMode, 0, m_actualCols, vectorNames, columnModes, ok);
+	if (!ok || m_dataContainer.size() < static_cast<size_t>(m_actualCols)) {
+		const_cast<McapFilter*>(q)->setLastError(i18n("Not enough memory."));
+		return;
+	}
 
-/*!
-import the content of document \c m_preparedDoc to the data source \c dataSource. Uses the settings defined in the data source.
-*/
-void McapFilterPrivate::importData(AbstractDataSource* dataSource, AbstractFileFilter::ImportMode importMode, int lines) {
-	bool ok = false;
-	m_columnOffset = dataSource->prepareImport(m_dataContainer, importMode, m_actualRows, m_actualCols, vectorNames, columnModes, ok);
-	int rowOffset = startRow - 1;
-	int colOffset = (int)createIndexEnabled;
-	DEBUG("reading " << m_actualRows << " lines");
-	DEBUG("reading " << m_actualCols << " columns");
-
-	int progressIndex = 0;
-	const float progressInterval = 0.01 * lines; // update on every 1% only
-
-	const auto& array = m_preparedDoc.array();
-	const auto& arrayIterator = array.begin();
-
-	for (int i = 0; i < m_actualRows; ++i) {
-		if (createIndexEnabled)
-			static_cast<QVector<int>*>(m_dataContainer[0])->operator[](i) = i + 1;
-
-		QJsonValue row;
-		row = *(arrayIterator + rowOffset + i);
-
-		for (int n = 0; n < m_actualCols - colOffset; ++n) {
-			QJsonValue value;
-			value = *(row.toObject().begin() + n + startColumn - 1);
-
-			switch (value.type()) {
-			case QJsonValue::Double:
-				if (columnModes[colOffset + n] == AbstractColumn::ColumnMode::Double)
-					static_cast<QVector<double>*>(m_dataContainer[colOffset + n])->operator[](i) = value.toDouble();
-				else
-					setEmptyValue(colOffset + n, i + startRow - 1);
-				break;
-			case QJsonValue::String: {
-				setValueFromString(colOffset + n, i, value.toString());
-				break;
-			}
-			case QJsonValue::Array:
-			case QJsonValue::Object:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				setEmptyValue(colOffset + n, i + startRow - 1);
-				break;
+	// the date-times are written in UTC without QDateTime, which sets the time zone of the container otherwise
+	for (int i = 0; i < m_actualCols; ++i) {
+		if (columnModes.at(i) == AbstractColumn::ColumnMode::DateTime)
+			static_cast<DateTimeVector*>(m_dataContainer[i])->setTimeZone(QTimeZone::UTC);
+	}
+
+	m_actualRows = 0;
+	int capacity = 0;
+	readRows(reader, INT_MAX, [&](Rows& rows, int first, int count) {
+		try {
+			if (m_actualRows + count > capacity) {
+				capacity = std::max(m_actualRows + count, 2 * capacity);
+				resizeDataContainer(capacity);
 			}
+		} catch (std::bad_alloc&) {
+			const_cast<McapFilter*>(q)->setLastError(i18n("Not enough memory."));
+			return false;
 		}
+		appendRows(rows, first, count, m_actualRows);
+		m_actualRows += count;
+		return true;
+	});
+	resizeDataContainer(m_actualRows);
+	DEBUG("read " << m_actualRows << " rows in " << m_actualCols << " columns");
 
-		// ask to update the progress bar only if we have more than 1000 lines
-		// only in 1% steps
-		progressIndex++;
-		if (m_actualRows > 1000 && progressIndex > progressInterval) {
-			double value = 100. * i / lines;
-			Q_EMIT q->completed(static_cast<int>(value));
-			progressIndex = 0;
-			QApplication::processEvents(QEventLoop::AllEvents, 0);
-		}
+	// set the plot designation to 'X' for the index column, if available
+	auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
+	if (spreadsheet && createIndexEnabled)
+		spreadsheet->column(m_columnOffset)->setPlotDesignation(AbstractColumn::PlotDesignation::X);
 
-		// set the plot designation to 'X' for index and name columns, if available
-		auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource);
-		if (spreadsheet) {
-			if (createIndexEnabled)
-				spreadsheet->column(m_columnOffset)->setPlotDesignation(AbstractColumn::PlotDesignation::X);
-		}
-	}
 	dataSource->finalizeImport(m_columnOffset, startColumn, startColumn + m_actualCols - 1, dateTimeFormat, importMode);
 }
 
 /*!
-generates the preview for the file \c fileName.a
+generates the preview for the file \c fileName.
 */
 QVector<QStringList> McapFilterPrivate::preview(const QString& fileName, int lines) {
-	DEBUG(Q_FUNC_INFO << "lines=" << std::to_string(lines));
-
-	mcapToJson(fileName, lines);
-	bool success = prepareDocumentToRead();
-	// TODO: check success
-	Q_UNUSED(success)
-	return preview(lines);
-}
-
-/*!
-generates the preview for document \c m_preparedDoc.
-*/
-QVector<QStringList> McapFilterPrivate::preview(int lines) {
-	DEBUG(Q_FUNC_INFO);
+	DEBUG(Q_FUNC_INFO << ", lines = " << lines);
 
 	QVector<QStringList> dataStrings;
-	const int rowOffset = startRow - 1;
-	DEBUG("	Generating preview for " << std::min(lines, m_actualRows) << " lines");
-
-	const auto& array = m_preparedDoc.array();
-	const auto& arrayIterator = array.begin();
-	const auto& object = m_preparedDoc.object();
-	const auto& objectIterator = object.begin();
-
-	for (int i = 0; i < std::min(lines, m_actualRows); ++i) {
-		QString rowName;
-		QJsonValue row;
-
-		switch (containerType) {
-		case McapFilter::DataContainerType::Object:
-			rowName = (objectIterator + rowOffset + i).key();
-			row = *(objectIterator + rowOffset + i);
-			break;
-		case McapFilter::DataContainerType::Array:
-			row = *(arrayIterator + rowOffset + i);
+	mcap::McapReader reader;
+	if (!prepareToRead(reader, fileName))
+		return dataStrings;
 
-			break;
+	readRows(reader, lines, [&](Rows& rows, int first, int count) {
+		for (int row = first; row < first + count; ++row) {
+			QStringList lineString;
+			if (createIndexEnabled)
+				lineString += QString::number(dataStrings.size() + 1);
+			for (size_t column = 0; column < rows.columns.size(); ++column)
+				lineString += valueString(rows, static_cast<int>(column), row);
+			dataStrings << lineString;
 		}
+		return true;
+	});
 
-		QStringList lineString;
-		if (createIndexEnabled)
-			lineString += QString::number(i + 1);
-
-		for (int n = startColumn - 1; n < endColumn; ++n) {
-			QJsonValue value;
-			switch (rowType) {
-			case QJsonValue::Object:
-				value = *(row.toObject().begin() + n);
-				break;
-			case QJsonValue::Array:
-				value = *(row.toArray().begin() + n);
-				break;
-			// TODO: implement other value types
-			case QJsonValue::Double:
-			case QJsonValue::String:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				break;
-			}
-
-			switch (value.type()) {
-			case QJsonValue::Double:
-				lineString += QString::number(value.toDouble(), 'g', 16);
-				break;
-			case QJsonValue::String:
-				if (columnModes.at(n + createIndexEnabled) == AbstractColumn::ColumnMode::DateTime) {
-					lineString += QDateTime::fromMSecsSinceEpoch(value.toString().toLong()).toString(dateTimeFormat);
-				} else {
-					lineString += value.toString();
-				}
-				break;
-			case QJsonValue::Array:
-			case QJsonValue::Object:
-			case QJsonValue::Bool:
-			case QJsonValue::Null:
-			case QJsonValue::Undefined:
-				lineString += QString();
-				break;
-			}
-		}
-		dataStrings << lineString;
-	}
 	return dataStrings;
 }
 
@@ -784,7 +1001,6 @@ void McapFilterPrivate::writeWithOptions(const QString& fileName, AbstractDataSo
 	auto startTime = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
 	// TODO: use startTime
 	Q_UNUSED(startTime)
-	auto jsonArray = m_preparedDoc.array();
 
 	int numRows = spreadsheet->rowCount();
 	int numCols = spreadsheet->columnCount();
@@ -845,6 +1061,8 @@ void McapFilter::save(QXmlStreamWriter* writer) const {
 	writer->writeAttribute(QStringLiteral("endRow"), QString::number(d->endRow));
 	writer->writeAttribute(QStringLiteral("startColumn"), QString::number(d->startColumn));
 	writer->writeAttribute(QStringLiteral("endColumn"), QString::number(d->endColumn));
+	writer->writeAttribute(QStringLiteral("startTime"), QString::number(d->startTime));
+	writer->writeAttribute(QStringLiteral("endTime"), QString::number(d->endTime));
 
 	QStringList list;
 	for (auto& it : modelRows())
@@ -872,6 +1090,14 @@ bool McapFilter::load(XmlStreamReader* reader) {
 	READ_INT_VALUE("startColumn", startColumn, int);
 	READ_INT_VALUE("endColumn", endColumn, int);
 
+	// the time range is not available in older projects
+	str = attribs.value(QStringLiteral("startTime")).toString();
+	if (!str.isEmpty())
+		d->startTime = str.toLongLong();
+	str = attribs.value(QStringLiteral("endTime")).toString();
+	if (!str.isEmpty())
+		d->endTime = str.toLongLong();
+
 	auto list = attribs.value(QStringLiteral("modelRows")).toString().split(QLatin1Char(';'));
 	if (list.isEmpty())
 		reader->raiseMissingAttributeWarning(QStringLiteral("'modelRows'"));
@@ -891,91 +1117,61 @@ QJsonDocument McapFilter::getJsonDocument(const QString& fileName) {
 
 QJsonDocument McapFilterPrivate::getJsonDocument(const QString& fileName) {
 	DEBUG(Q_FUNC_INFO);
-	mcapToJson(fileName);
-	bool success = prepareDocumentToRead();
-	// TODO: check success
-	Q_UNUSED(success)
-	return m_preparedDoc;
-}
-
-// https://stackoverflow.com/a/76036333
-QJsonObject McapFilterPrivate::flattenJson(QJsonValue jsonVal, QString aggregatedKey) {
-	QJsonObject flattenedJson;
-
-	auto dryFx = [&](auto& key, auto& value) {
-		const QString delimiter = QLatin1String(".");
-		QString nKey = aggregatedKey + delimiter + key;
-		if (nKey.at(0) == delimiter)
-			nKey.remove(0, 1);
-
-		if (value.isObject() || value.isArray()) {
-			QJsonObject nestedJson = flattenJson(value, nKey);
-			flattenedJson = mergeJsonObjects(flattenedJson, nestedJson);
-		} else {
-			flattenedJson.insert(nKey, value);
-		}
-	};
-
-	if (jsonVal.isArray()) {
-		const auto json_arr = jsonVal.toArray();
-		for (auto it = json_arr.constBegin(); it != json_arr.constEnd(); ++it) {
-			const auto key = QString::number((it - json_arr.constBegin()));
-			const auto value = *it;
-			dryFx(key, value);
-		}
-	}
 
-	if (jsonVal.isObject()) {
-		const auto json_obj = jsonVal.toObject();
-		for (auto it = json_obj.constBegin(); it != json_obj.constEnd(); ++it) {
-			const auto key = it.key();
-			const auto value = it.value();
-			dryFx(key, value);
+	QJsonArray array;
+	mcap::McapReader reader;
+	if (!prepareToRead(reader, fileName))
+		return QJsonDocument(array);
+
+	readRows(reader, INT_MAX, [&](Rows& rows, int first, int count) {
+		for (int row = first; row < first + count; ++row) {
+			QJsonObject object;
+			for (size_t column = 0; column < rows.columns.size(); ++column) {
+				const auto& values = rows.columns.at(column);
+				const auto& name = vectorNames.at(column + createIndexEnabled);
+				switch (columnModes.at(column + createIndexEnabled)) {
+				case AbstractColumn::ColumnMode::Double:
+					object.insert(name, values.doubles.at(row));
+					break;
+				case AbstractColumn::ColumnMode::Integer:
+					object.insert(name, values.integers.at(row));
+					break;
+				case AbstractColumn::ColumnMode::BigInt:
+				case AbstractColumn::ColumnMode::DateTime:
+					object.insert(name, values.bigInts.at(row));
+					break;
+				case AbstractColumn::ColumnMode::Text:
+					object.insert(name, values.texts.at(row));
+					break;
+				case AbstractColumn::ColumnMode::Month:
+				case AbstractColumn::ColumnMode::Day:
+					break;
+				}
+			}
+			array.append(object);
 		}
-	}
-
-	return flattenedJson;
-}
-
-// TODO: implement unflatten method
-QJsonObject McapFilterPrivate::unflattenJson(const QJsonObject& obj, QString /*separator*/) {
-	return obj;
-}
+		return true;
+	});
 
-QJsonObject McapFilterPrivate::mergeJsonObjects(const QJsonObject& obj1, const QJsonObject& obj2) {
-	auto mergedObj = obj1;
-	for (auto it = obj2.constBegin(); it != obj2.constEnd(); ++it) {
-		mergedObj.insert(it.key(), it.value());
-	}
-	return mergedObj;
+	return QJsonDocument(array);
 }
 
+/*!
+returns the topics in the file \c fileName with a supported message encoding.
+*/
 QVector<QString> McapFilterPrivate::getValidTopics(const QString& fileName) {
 	DEBUG(Q_FUNC_INFO);
 
-	QVector<QString> valid_topics;
 	mcap::McapReader reader;
-	{
-		const auto res = reader.open(STDSTRING(fileName));
-		if (!res.ok()) {
-			std::cerr << "Failed to open " << STDSTRING(fileName) << " for reading: " << res.message << std::endl;
-			const_cast<McapFilter*>(q)->setLastError(i18n("Failed to read the file. Reason: %1", QString::fromStdString(res.message)));
-			return valid_topics;
-		}
+	auto status = reader.open(STDSTRING(fileName));
+	if (status.ok())
+		status = reader.readSummary(mcap::ReadSummaryMethod::AllowFallbackScan);
+	if (!status.ok()) {
+		const_cast<McapFilter*>(q)->setLastError(i18n("Failed to read the file. Reason: %1", QString::fromStdString(status.message)));
+		return {};
 	}
 
-	auto status = reader.readSummary(mcap::ReadSummaryMethod::NoFallbackScan);
-	// TODO: check status
-	Q_UNUSED(status)
-	auto channel_map = reader.channels();
-	std::for_each(channel_map.begin(), channel_map.end(), [&](std::pair<mcap::ChannelId, mcap::ChannelPtr> entry) {
-		if (entry.second->messageEncoding == "json") {
-			DEBUG("Found valid topic:" << entry.second->topic);
-			valid_topics.append(QString::fromStdString((entry.second->topic)));
-			current_topic = QString::fromStdString(entry.second->topic); // Last topic by default?
-		}
-	});
-	return valid_topics;
+	return supportedTopics(reader);
 }
 
 QVector<QString> McapFilter::getValidTopics(const QString& fileName) {
@@ -984,9 +1180,6 @@ QVector<QString> McapFilter::getValidTopics(const QString& fileName) {
 
 void McapFilterPrivate::setCurrentTopic(QString topic) {
 	DEBUG(Q_FUNC_INFO);
-	if (current_topic != topic)
-		m_prepared = false;
-
 	current_topic = topic;
 }
 
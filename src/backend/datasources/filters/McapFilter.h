@@ -72,6 +72,10 @@ public:
 	int startColumn() const;
 	void setEndColumn(const int);
 	int endColumn() const;
+	void setStartTime(qint64);
+	qint64 startTime() const;
+	void setEndTime(qint64);
+	qint64 endTime() const;
 
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*) override;
@@ -11,33 +11,31 @@
 #define MCAPFILTERPRIVATE_H
 
 #include "QJsonModel.h"
+#include "backend/datasources/filters/McapDecoder.h"
+#include "backend/lib/ValueParser.h"
+
 #include <limits.h>
+#include <unordered_map>
 
 class QJsonDocument;
 class AbstractDataSource;
 class AbstractColumn;
 namespace mcap {
 struct McapWriterOptions;
+struct Message;
+class McapReader;
 }
 class McapFilterPrivate {
 public:
 	explicit McapFilterPrivate(McapFilter* owner);
 
-	int checkRow(QJsonValueRef value, int& countCols);
-	int parseColumnModes(const QJsonValue& row, const QString& rowName = QString());
-	void setEmptyValue(int column, int row);
-	void setValueFromString(int column, int row, const QString& value);
-
 	void readDataFromFile(const QString& fileName, AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace);
-	void importData(AbstractDataSource* = nullptr, AbstractFileFilter::ImportMode = AbstractFileFilter::ImportMode::Replace, int lines = -1);
-	int mcapToJson(const QString& fileName, int lines = INT_MAX);
 	QJsonDocument getJsonDocument(const QString&);
 
 	void write(const QString& fileName, AbstractDataSource*);
 	void writeWithOptions(const QString& fileName, AbstractDataSource*, int compressionMode, int compressionLevel);
 
 	QVector<QStringList> preview(const QString& fileName, int lines);
-	QVector<QStringList> preview(int lines);
 
 	const McapFilter* q;
 	QJsonModel* model{nullptr};
@@ -58,28 +56,68 @@ public:
 	int endRow{-1}; // end row
 	int startColumn{1}; // start column
 	int endColumn{-1}; // end column
-
-	QJsonObject flattenJson(QJsonValue jsonVal, QString aggregatedKey = QLatin1String(""));
-	QJsonObject unflattenJson(const QJsonObject& json, QString separator = QLatin1String("."));
-
-	QJsonObject mergeJsonObjects(const QJsonObject& obj1, const QJsonObject& obj2);
+	qint64 startTime{0}; // log time of the first message to read in milliseconds since the epoch
+	qint64 endTime{-1}; // log time of the last message to read in milliseconds since the epoch, -1 for all messages
 
 	QVector<QString> getValidTopics(const QString& fileName);
 	void setCurrentTopic(QString currentTopic);
 	QString getCurrentTopic();
 
 private:
+	//! values of the rows decoded from a part of the messages, only the vector for the mode of the column is used
+	struct Rows {
+		struct Column {
+			QVector<double> doubles;
+			QVector<int> integers;
+			QVector<qint64> bigInts; // also the date-times in milliseconds since the epoch
+			QVector<QString> texts;
+		};
+		std::vector<Column> columns;
+		int count{0};
+	};
+
+	//! decoder of the messages of one channel together with the columns of the values of the last decoded layout
+	struct ChannelDecoder {
+		std::unique_ptr<McapDecoder> decoder;
+		bool mapped{false};
+		std::string layout;
+		std::vector<int> columns; // column of each value, -1 for values not imported
+	};
+	using Decoders = std::unordered_map<uint16_t, ChannelDecoder>;
+
+	//! chunk of the file with messages of the selected channels in the selected time range
+	struct Chunk {
+		quint64 offset;
+		quint64 length;
+	};
+
+	bool prepareToRead(mcap::McapReader&, const QString& fileName);
+	template<typename Function>
+	void forEachMessage(mcap::McapReader&, Function);
+	template<typename Function>
+	void readRows(mcap::McapReader&, int maxRows, Function);
+	bool selectedMessage(const mcap::Message&) const;
+	Decoders cloneDecoders() const;
+	void mapValues(ChannelDecoder&) const;
+	bool decodeMessage(const mcap::Message&, Decoders&, Rows&) const;
+	void setValue(Rows::Column&, int column, int row, const McapValue&) const;
+	void appendRows(Rows&, int first, int count, int row);
+	void resizeDataContainer(int rows);
+	QString valueString(const Rows&, int column, int row) const;
+
 	int m_actualRows{0};
 	int m_actualCols{0};
-	int m_prepared{false};
 	int m_columnOffset{0}; // indexes the "start column" in the datasource. Data will be imported starting from this column.
 	QString current_topic = QLatin1String("");
 	std::vector<void*> m_dataContainer; // pointers to the actual data containers (columns).
-	QJsonDocument m_doc; // original and full JSON document
-	QJsonDocument m_preparedDoc; // selected part of the full JSON document, the part that needs to be imported
-	QVector<QString> m_validTopics;
-
-	bool prepareDocumentToRead();
+	Decoders m_decoders; // decoders of the channels of the current topic, cloned for the threads decoding the messages
+	std::vector<Chunk> m_chunks;
+	std::unordered_map<std::string, int> m_columnIndexes; // column of the values with the name, -1 for values not imported
+	int m_logTimeColumn{-1};
+	int m_publishTimeColumn{-1};
+	int m_sequenceColumn{-1};
+	NumberParser m_numberParser;
+	DateTimeParser m_dateTimeParser;
 };
 
 #endif
@@ -193,7 +193,21 @@ bool QJsonModel::load(QIODevice* device) {
 bool QJsonModel::loadJson(const QByteArray& json) {
 	QJsonParseError jsonError;
 
-	const QJsonDocument& doc = QJsonDocument::fromJson(json, &jsonError);
+	QJsonDocument doc = QJsonDocument::fromJson(json, &jsonError);
+	if (jsonError.error == QJsonParseError::GarbageAtEnd) {
+		// JSON Lines, the documents are shown as the elements of an array
+		QJsonArray documents;
+		for (const auto& line : json.split('\n')) {
+			if (line.trimmed().isEmpty())
+				continue;
+			const auto lineDoc = QJsonDocument::fromJson(line, &jsonError);
+			if (jsonError.error != QJsonParseError::NoError)
+				break;
+			documents.append(lineDoc.isArray() ? QJsonValue(lineDoc.array()) : QJsonValue(lineDoc.object()));
+		}
+		if (jsonError.error == QJsonParseError::NoError)
+			doc = QJsonDocument(documents);
+	}
 	if (jsonError.error == QJsonParseError::NoError) {
 		const bool rc = loadJson(doc);
 		if (!rc)
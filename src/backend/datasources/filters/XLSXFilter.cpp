@@ -18,6 +18,8 @@
 #include "backend/datasources/AbstractDataSource.h"
 #include "backend/datasources/filters/XLSXFilter.h"
 #include "backend/datasources/filters/XLSXFilterPrivate.h"
+#include "backend/lib/DateTimeVector.h"
+#include "backend/lib/MatrixStorage.h"
 #include "backend/matrix/Matrix.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
@@ -336,11 +338,11 @@ void XLSXFilterPrivate::write(const QString& fileName, AbstractDataSource* dataS
 	} else if (auto* const matrix = dynamic_cast<Matrix*>(dataSource)) {
 		const int columns = matrix->columnCount();
 		const int rows = matrix->rowCount();
-		const QVector<QVector<double>>* const data = static_cast<QVector<QVector<double>>*>(matrix->data());
+		const auto* const data = static_cast<MatrixStorage<double>*>(matrix->data());
 
 		for (int col = 0; col < columns; ++col) {
 			const int actualCol = startCol + col;
-			const auto& column = data->at(col);
+			const auto column = data->column(col);
 			for (int row = 0; row < rows; ++row) {
 				const int actualRow = startRow + row;
 				const auto& val = column.at(row);
@@ -420,7 +422,7 @@ void XLSXFilterPrivate::readDataRegion(const QXlsx::CellRange& region, AbstractD
 
 	if (auto* spreadsheet = dynamic_cast<Spreadsheet*>(dataSource)) {
 		std::vector<void*> numericDataPointers;
-		QVector<QVector<QDateTime>*> datetimeDataPointers;
+		QVector<DateTimeVector*> datetimeDataPointers;
 		QVector<QVector<QString>*> stringDataPointers;
 		QList<QXlsx::Cell::CellType> columnNumericTypes;
 		QStringList columnNames;
@@ -457,7 +459,7 @@ void XLSXFilterPrivate::readDataRegion(const QXlsx::CellRange& region, AbstractD
 					data->clear();
 			} else if (columnNumericTypes.at(n) == QXlsx::Cell::CellType::DateType) {
 				col->setColumnMode(AbstractColumn::ColumnMode::DateTime);
-				auto* data = static_cast<QVector<QDateTime>*>(col->data());
+				auto* data = static_cast<DateTimeVector*>(col->data());
 				datetimeDataPointers.push_back(data);
 				if (importMode == AbstractFileFilter::ImportMode::Replace)
 					data->clear();
@@ -485,7 +487,7 @@ void XLSXFilterPrivate::readDataRegion(const QXlsx::CellRange& region, AbstractD
 					if (datetimeidx < datetimeDataPointers.size()) {
 						if (val.toDateTime().time() != QTime(0, 0))
 							isDateOnly = false;
-						static_cast<QVector<QDateTime>*>(datetimeDataPointers[datetimeidx++])->push_back(val.toDateTime());
+						datetimeDataPointers[datetimeidx++]->push_back(val.toDateTime());
 					}
 				} else {
 					if (!stringDataPointers.isEmpty() && stringidx < stringDataPointers.size()) {
@@ -10,6 +10,7 @@
 
 #include "backend/gsl/ExpressionParser.h"
 #include "backend/gsl/Parser.h"
+#include "backend/lib/Parallel.h"
 #include "backend/lib/macros.h"
 #include "backend/lib/trace.h"
 #include "parser_private.h"
@@ -18,7 +19,11 @@
 
 #include <QRegularExpression>
 
+#include <cstring>
+#include <deque>
+#include <numeric>
 #include <random>
+#include <set>
 
 #include <gsl/gsl_const_mksa.h>
 #include <gsl/gsl_const_num.h>
@@ -43,6 +48,19 @@ private:
 	const Parser& mParser;
 	QString& mLastErrorMessage;
 };
+
+/*!
+ * evaluates \c program for \c count rows, the values of the variable \c name are taken from \c data.
+ * All other variables keep the values they had at compile time.
+ */
+void evaluateProgram(const Program& program, const char* name, const double* data, double* result, int count) {
+	auto values = program.variableValues();
+	std::vector<const double*> arrays(values.size(), nullptr);
+	const int index = program.variableIndex(name);
+	if (index >= 0)
+		arrays[index] = data;
+	program.evaluate(arrays, values.data(), result, count);
+}
 }
 
 ExpressionParser* ExpressionParser::m_instance{nullptr};
@@ -320,6 +338,18 @@ bool ExpressionParser::isValid(const QString& expr, const QStringList& vars) {
 	return parser.parseErrors() == 0;
 }
 
+/*!
+ * compiles \c expr using the number locale and falls back to the default locale if this fails.
+ * All variables used in \c expr must be assigned in \c parser before.
+ */
+Program ExpressionParser::compile(Parser& parser, const QString& expr) {
+	const auto numberLocale = QLocale();
+	auto program = parser.compile(qPrintable(expr), qPrintable(numberLocale.name()));
+	if (!program.isValid()) // try default locale if failing
+		program = parser.compile(qPrintable(expr), "en_US");
+	return program;
+}
+
 QStringList ExpressionParser::getParameter(const QString& expr, const QStringList& vars) {
 	QDEBUG(Q_FUNC_INFO << ", variables:" << vars);
 	QStringList parameters;
@@ -361,24 +391,20 @@ bool ExpressionParser::tryEvaluateCartesian(const QString& expr,
 
 	for (int i = 0; i < paramNames.size(); ++i)
 		parser.assign_symbol(qPrintable(paramNames.at(i)), paramValues.at(i));
+	parser.assign_symbol("x", range.start());
 
-	const auto numberLocale = QLocale();
 	gsl_set_error_handler_off();
-	for (int i = 0; i < count; i++) {
-		const double x{range.start() + step * i};
-		parser.assign_symbol("x", x);
+	const auto program = compile(parser, expr);
+	if (!program.isValid())
+		return false;
 
-		double y = parser.parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parser.parseErrors() > 0) // try default locale if failing
-			y = parser.parse(qPrintable(expr), "en_US");
-		if (parser.parseErrors() > 0)
-			return false;
+	for (int i = 0; i < count; i++)
+		(*xVector)[i] = range.start() + step * i;
 
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << x << " is NAN")
-
-		(*xVector)[i] = x;
-		(*yVector)[i] = y;
+	evaluateProgram(program, "x", xVector->constData(), yVector->data(), count);
+	for (int i = 0; i < count; i++) {
+		if (std::isnan(yVector->at(i)))
+			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << xVector->at(i) << " is NAN")
 	}
 
 	return true;
@@ -415,25 +441,19 @@ bool ExpressionParser::tryEvaluateCartesian(const QString& expr,
 
 	Parser parser;
 	ParserLastErrorMessage lock(parser, m_lastErrorMessage);
+	parser.assign_symbol("x", range.start());
 
-	const auto numberLocale = QLocale();
-	for (int i = 0; i < count; i++) {
-		const double x{range.start() + step * i};
-		parser.assign_symbol("x", x);
+	const auto program = compile(parser, expr);
+	if (!program.isValid())
+		return false;
 
-		double y = parser.parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parser.parseErrors() > 0) { // try default locale if failing
-			y = parser.parse(qPrintable(expr), "en_US");
-			// DEBUG(Q_FUNC_INFO << ", WARNING: PARSER failed, trying default locale: y = " << y)
-		}
-		if (parser.parseErrors() > 0)
-			return false;
-
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << x << " is NAN")
+	for (int i = 0; i < count; i++)
+		(*xVector)[i] = range.start() + step * i;
 
-		(*xVector)[i] = x;
-		(*yVector)[i] = y;
+	evaluateProgram(program, "x", xVector->constData(), yVector->data(), count);
+	for (int i = 0; i < count; i++) {
+		if (std::isnan(yVector->at(i)))
+			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << xVector->at(i) << " is NAN")
 	}
 
 	return true;
@@ -445,20 +465,16 @@ bool ExpressionParser::tryEvaluateCartesian(const QString& expr, QVector<double>
 
 	Parser parser;
 	ParserLastErrorMessage lock(parser, m_lastErrorMessage);
+	parser.assign_symbol("x", xVector->isEmpty() ? 0. : xVector->first());
 
-	const auto numberLocale = QLocale();
-	for (int i = 0; i < xVector->count(); i++) {
-		parser.assign_symbol("x", xVector->at(i));
-		double y = parser.parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parser.parseErrors() > 0) // try default locale if failing
-			y = parser.parse(qPrintable(expr), "en_US");
-		if (parser.parseErrors() > 0)
-			return false;
+	const auto program = compile(parser, expr);
+	if (!program.isValid())
+		return false;
 
-		if (std::isnan(y))
+	evaluateProgram(program, "x", xVector->constData(), yVector->data(), xVector->count());
+	for (int i = 0; i < xVector->count(); i++) {
+		if (std::isnan(yVector->at(i)))
 			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << xVector->at(i) << " is NAN")
-
-		(*yVector)[i] = y;
 	}
 
 	return true;
@@ -477,26 +493,208 @@ bool ExpressionParser::tryEvaluateCartesian(const QString& expr,
 
 	for (int i = 0; i < paramNames.size(); ++i)
 		parser.assign_symbol(qPrintable(paramNames.at(i)), paramValues.at(i));
+	parser.assign_symbol("x", xVector->isEmpty() ? 0. : xVector->first());
 
-	const auto numberLocale = QLocale();
-	for (int i = 0; i < xVector->count(); i++) {
-		parser.assign_symbol("x", xVector->at(i));
-
-		double y = parser.parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parser.parseErrors() > 0) // try default locale if failing
-			y = parser.parse(qPrintable(expr), "en_US");
-		if (parser.parseErrors() > 0)
-			return false;
+	const auto program = compile(parser, expr);
+	if (!program.isValid())
+		return false;
 
-		if (std::isnan(y))
+	evaluateProgram(program, "x", xVector->constData(), yVector->data(), xVector->count());
+	for (int i = 0; i < xVector->count(); i++) {
+		if (std::isnan(yVector->at(i)))
 			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << xVector->at(i) << " is NAN")
-
-		(*yVector)[i] = y;
 	}
 
 	return true;
 }
 
+/*!
+ * State of a moving window over the data of a variable used by the moving statistics (smmin, smmax, sma, smr, smmed).
+ * The rows are usually evaluated one after the other, so the window is updated incrementally when moving it
+ * by one row instead of scanning all N values of the window again:
+ * a monotonic deque for the minimum and maximum and a running sum for the average (O(1) per row) and
+ * two balanced multisets for the median (O(log N) per row).
+ * The window is rebuilt from scratch if another row is requested.
+ */
+class MovingWindow {
+public:
+	enum class Type { Minimum, Maximum, Sum, Median };
+
+	MovingWindow(Type type, int variable, int size, const QVector<double>* data)
+		: m_type(type)
+		, m_variable(variable)
+		, m_size(size)
+		, m_data(data) {
+	}
+
+	bool matches(Type type, int variable, int size) const {
+		return m_type == type && m_variable == variable && m_size == size;
+	}
+
+	// value of the window ending at row \c row containing the rows max(0, row - size + 1) .. row
+	double value(int row) {
+		if (row == m_row)
+			return m_value;
+
+		if (m_row >= 0 && row == m_row + 1 && !(m_type == Type::Sum && m_steps >= m_size)) {
+			if (row - m_size >= 0)
+				remove(row - m_size);
+			add(row);
+			++m_steps;
+		} else {
+			// rebuild, this is also done for the sum every size rows to not accumulate rounding errors
+			reset();
+			for (int index = std::max(0, row - m_size + 1); index <= row; ++index)
+				add(index);
+		}
+
+		m_row = row;
+		m_value = result();
+		return m_value;
+	}
+
+private:
+	void reset() {
+		m_candidates.clear();
+		m_sum = 0.;
+		m_compensation = 0.;
+		m_nanCount = 0;
+		m_positiveInfCount = 0;
+		m_negativeInfCount = 0;
+		m_lower.clear();
+		m_upper.clear();
+		m_steps = 0;
+	}
+
+	void add(int index) {
+		const double v = m_data->at(index);
+		switch (m_type) {
+		case Type::Minimum: // NaN values are ignored
+			if (std::isnan(v))
+				break;
+			while (!m_candidates.empty() && m_data->at(m_candidates.back()) > v)
+				m_candidates.pop_back();
+			m_candidates.push_back(index);
+			break;
+		case Type::Maximum:
+			if (std::isnan(v))
+				break;
+			while (!m_candidates.empty() && m_data->at(m_candidates.back()) < v)
+				m_candidates.pop_back();
+			m_candidates.push_back(index);
+			break;
+		case Type::Sum:
+			addToSum(v, 1);
+			break;
+		case Type::Median:
+			if (std::isnan(v))
+				break;
+			if (m_lower.empty() || v <= *m_lower.rbegin())
+				m_lower.insert(v);
+			else
+				m_upper.insert(v);
+			balance();
+			break;
+		}
+	}
+
+	void remove(int index) {
+		const double v = m_data->at(index);
+		switch (m_type) {
+		case Type::Minimum:
+		case Type::Maximum:
+			// older candidates were already removed when a better value was added
+			if (!m_candidates.empty() && m_candidates.front() == index)
+				m_candidates.pop_front();
+			break;
+		case Type::Sum:
+			addToSum(v, -1);
+			break;
+		case Type::Median:
+			if (std::isnan(v))
+				break;
+			if (!m_lower.empty() && v <= *m_lower.rbegin())
+				m_lower.erase(m_lower.find(v));
+			else
+				m_upper.erase(m_upper.find(v));
+			balance();
+			break;
+		}
+	}
+
+	// non-finite values are counted since they can't be subtracted again
+	void addToSum(double v, int sign) {
+		if (std::isnan(v))
+			m_nanCount += sign;
+		else if (std::isinf(v))
+			(v > 0 ? m_positiveInfCount : m_negativeInfCount) += sign;
+		else {
+			// Neumaier summation
+			const double value = sign * v;
+			const double sum = m_sum + value;
+			if (std::abs(m_sum) >= std::abs(value))
+				m_compensation += (m_sum - sum) + value;
+			else
+				m_compensation += (value - sum) + m_sum;
+			m_sum = sum;
+		}
+	}
+
+	// the lower half contains the median or one more value than the upper half
+	void balance() {
+		if (m_lower.size() > m_upper.size() + 1) {
+			auto it = std::prev(m_lower.end());
+			m_upper.insert(*it);
+			m_lower.erase(it);
+		} else if (m_upper.size() > m_lower.size()) {
+			auto it = m_upper.begin();
+			m_lower.insert(*it);
+			m_upper.erase(it);
+		}
+	}
+
+	double result() const {
+		switch (m_type) {
+		case Type::Minimum:
+			return m_candidates.empty() ? INFINITY : m_data->at(m_candidates.front());
+		case Type::Maximum:
+			return m_candidates.empty() ? -INFINITY : m_data->at(m_candidates.front());
+		case Type::Sum:
+			if (m_nanCount > 0 || (m_positiveInfCount > 0 && m_negativeInfCount > 0))
+				return NAN;
+			if (m_positiveInfCount > 0)
+				return INFINITY;
+			if (m_negativeInfCount > 0)
+				return -INFINITY;
+			return m_sum + m_compensation;
+		case Type::Median:
+			if (m_lower.empty())
+				return NAN;
+			if (m_lower.size() > m_upper.size())
+				return *m_lower.rbegin();
+			return (*m_lower.rbegin() + *m_upper.begin()) / 2.;
+		}
+		return NAN;
+	}
+
+	Type m_type;
+	int m_variable;
+	int m_size;
+	const QVector<double>* m_data;
+	int m_row{-1}; // last row of the current window
+	double m_value{NAN}; // value of the current window
+	int m_steps{0}; // number of incremental updates since the last rebuild
+
+	std::deque<int> m_candidates; // minimum/maximum: indices of the values which can become the minimum/maximum
+	double m_sum{0.};
+	double m_compensation{0.};
+	int m_nanCount{0};
+	int m_positiveInfCount{0};
+	int m_negativeInfCount{0};
+	std::multiset<double> m_lower; // median: lower and upper half of the values
+	std::multiset<double> m_upper;
+};
+
 struct PayloadExpressionParser : public Payload {
 	PayloadExpressionParser() {
 	}
@@ -508,6 +706,7 @@ struct PayloadExpressionParser : public Payload {
 	const QStringList* vars{nullptr};
 	int row{0};
 	const QVector<QVector<double>*>* xVectors{nullptr};
+	std::vector<MovingWindow> windows; // windows of the moving statistics used in the expression
 };
 
 double cell(double x, const std::string_view& variable, const std::weak_ptr<Payload> payload) {
@@ -568,7 +767,8 @@ double mr(const std::string_view& variable, const std::weak_ptr<Payload> payload
 	return fabs(cell(p->row + 1, variable, payload) - cell(p->row + 1 - 1, variable, payload));
 }
 
-double smmin(double x, const std::string_view& variable, const std::weak_ptr<Payload> payload) {
+// value of the moving statistics \c type for the last \c x rows of \c variable
+double movingStatistics(MovingWindow::Type type, double x, const std::string_view& variable, const std::weak_ptr<Payload>& payload) {
 	const auto p = std::dynamic_pointer_cast<PayloadExpressionParser>(payload.lock());
 	if (!p) {
 		assert(p); // Debug build
@@ -578,72 +778,40 @@ double smmin(double x, const std::string_view& variable, const std::weak_ptr<Pay
 	for (int i = 0; i < p->vars->length(); i++) {
 		if (p->vars->at(i).compare(QLatin1String(variable)) == 0) {
 			const int N = x;
-			DEBUG("N = " << N)
 			if (N < 1)
 				break;
-			// calculate min of last n points
-			double min = INFINITY;
-			const int row = p->row;
-			for (int index = std::max(0, row - N + 1); index <= row; index++) {
-				const double v = p->xVectors->at(i)->at(index);
-				if (v < min)
-					min = v;
+
+			auto it = std::find_if(p->windows.begin(), p->windows.end(), [=](const MovingWindow& window) {
+				return window.matches(type, i, N);
+			});
+			if (it == p->windows.end()) {
+				// the window size can depend on the row, don't keep too many windows
+				if (p->windows.size() >= 16)
+					p->windows.clear();
+				p->windows.emplace_back(type, i, N, p->xVectors->at(i));
+				it = std::prev(p->windows.end());
 			}
-			return min;
+			return it->value(p->row);
 		}
 	}
 	return NAN;
 }
 
-double smmax(double x, const std::string_view& variable, const std::weak_ptr<Payload> payload) {
-	const auto p = std::dynamic_pointer_cast<PayloadExpressionParser>(payload.lock());
-	if (!p) {
-		assert(p); // Debug build
-		return NAN;
-	}
+double smmin(double x, const std::string_view& variable, const std::weak_ptr<Payload> payload) {
+	return movingStatistics(MovingWindow::Type::Minimum, x, variable, payload);
+}
 
-	for (int i = 0; i < p->vars->length(); i++) {
-		if (p->vars->at(i).compare(QLatin1String(variable)) == 0) {
-			const int N = x;
-			DEBUG("N = " << N)
-			if (N < 1)
-				break;
-			// calculate max of last n points
-			double max = -INFINITY;
-			const int row = p->row;
-			for (int index = std::max(0, row - N + 1); index <= row; index++) {
-				const double v = p->xVectors->at(i)->at(index);
-				if (v > max)
-					max = v;
-			}
-			return max;
-		}
-	}
-	return NAN;
+double smmax(double x, const std::string_view& variable, const std::weak_ptr<Payload> payload) {
+	return movingStatistics(MovingWindow::Type::Maximum, x, variable, payload);
 }
 
 double sma(double x, const std::string_view& variable, const std::weak_ptr<Payload> payload) {
-	const auto p = std::dynamic_pointer_cast<PayloadExpressionParser>(payload.lock());
-	if (!p) {
-		assert(p); // Debug build
-		return NAN;
-	}
+	// the sum is divided by N also for the first rows with less than N values
+	return movingStatistics(MovingWindow::Type::Sum, x, variable, payload) / (int)x;
+}
 
-	for (int i = 0; i < p->vars->length(); i++) {
-		if (p->vars->at(i).compare(QLatin1String(variable)) == 0) {
-			const int N = x;
-			DEBUG("N = " << N)
-			if (N < 1)
-				break;
-			// calculate max of last n points
-			double sum = 0.;
-			const int row = p->row;
-			for (int index = std::max(0, row - N + 1); index <= row; index++)
-				sum += p->xVectors->at(i)->at(index);
-			return sum / N;
-		}
-	}
-	return NAN;
+double smmed(double x, const std::string_view& variable, const std::weak_ptr<Payload> payload) {
+	return movingStatistics(MovingWindow::Type::Median, x, variable, payload);
 }
 
 double smr(double x, const std::string_view& variable, const std::weak_ptr<Payload> payload) {
@@ -725,10 +893,6 @@ bool ExpressionParser::tryEvaluateCartesian(const QString& expr,
 	if (yVector->size() < minSize)
 		minSize = yVector->size();
 
-	// calculate values
-	const auto numberLocale = QLocale();
-	DEBUG("Parsing with locale " << qPrintable(numberLocale.name()))
-
 	const auto payload = std::make_shared<PayloadExpressionParser>(&vars, &xVectors);
 	const auto payloadConst = std::make_shared<PayloadExpressionParser>(&vars, &xVectors, true);
 
@@ -742,37 +906,100 @@ bool ExpressionParser::tryEvaluateCartesian(const QString& expr,
 	parser.set_specialfunctionValueVariablePayload(specialfun_smmax, smmax, payload);
 	parser.set_specialfunctionValueVariablePayload(specialfun_sma, sma, payload);
 	parser.set_specialfunctionValueVariablePayload(specialfun_smr, smr, payload);
+	parser.set_specialfunctionValueVariablePayload(specialfun_smmed, smmed, payload);
 	parser.set_specialfunctionValueVariablePayload(specialfun_psample, psample, payload);
 	parser.set_specialfunctionVariablePayload(specialfun_rsample, rsample, payload);
 
-	bool constExpression = false;
-	for (int i = 0; i < minSize || (constExpression && i < yVector->size()); i++) {
-		QString tmpExpr = expr;
+	// all variables must be known when compiling, the expression is evaluated for the first row
+	parser.assign_symbol("i", 1);
+	for (int n = 0; n < vars.size(); ++n)
+		parser.assign_symbol(qPrintable(vars.at(n)), minSize > 0 ? xVectors.at(n)->at(0) : 0.);
 
-		payload->row = i; // all special functions contain pointer to payload so they get this information
-		parser.assign_symbol("i", i + 1);
+	// calculate values
+	const auto program = compile(parser, expr);
+	if (!program.isValid()) {
+		DEBUG(Q_FUNC_INFO << ", Failed parsing expression: " << STDSTRING(expr))
+		for (int i = 0; i < yVector->size(); ++i)
+			(*yVector)[i] = NAN;
+		return true;
+	}
 
-		for (int n = 0; n < vars.size(); ++n) {
-			if (!constExpression)
-				parser.assign_symbol(qPrintable(vars.at(n)), xVectors.at(n)->at(i));
+	// resolve the slots of the variables once
+	auto values = program.variableValues();
+	const int rowIndex = program.variableIndex("i");
+	QVector<int> varIndices;
+	for (const auto& var : vars)
+		varIndices << program.variableIndex(qPrintable(var));
+
+	const bool constExpression = program.isConstant() && minSize > 0;
+	const int count = constExpression ? yVector->size() : minSize;
+	double* result = yVector->data(); // detach before the rows are processed in parallel
+
+	// The rows are split into ranges which are evaluated in parallel if the expression only uses the
+	// special functions defined here. They only read the data of the variables and every range gets its own payload
+	// with the absolute row index, so windows of the moving statistics (smmin, sma, etc.) reaching back
+	// into the previous range see the same values as in a serial evaluation.
+	// Special functions with other payloads (e.g. the column statistics) and random numbers are evaluated serially.
+	bool parallel = program.isThreadSafe();
+	for (const auto& instruction : program.instructions()) {
+		if (!instruction.special.funsptr)
+			continue;
+		const auto p = instruction.special.payload.lock();
+		if ((p != payload && p != payloadConst) || strcmp(instruction.special.funsptr->name, specialfun_rsample) == 0)
+			parallel = false;
+	}
+	const int minRangeSize = parallel ? 16 * Program::BlockSize : std::numeric_limits<int>::max();
+
+	if (program.isVectorizable()) {
+		// no special functions, evaluate directly on the data of the columns
+		std::vector<double> rows;
+		if (!constExpression && rowIndex >= 0) {
+			rows.resize(count);
+			std::iota(rows.begin(), rows.end(), 1.);
 		}
 
-		double y = parser.parse(qPrintable(tmpExpr), qPrintable(numberLocale.name()));
-		if (parser.parseErrors() > 0) { // try default locale if failing
-			// DEBUG("Parsing with locale failed. Using en_US.")
-			y = parser.parse(qPrintable(tmpExpr), "en_US");
-		}
+		Parallel::forRanges(count, minRangeSize, [&](int start, int end) {
+			auto rangeValues = values;
+			std::vector<const double*> arrays(values.size(), nullptr);
+			if (!constExpression) {
+				if (rowIndex >= 0)
+					arrays[rowIndex] = rows.data() + start;
+				for (int n = 0; n < varIndices.size(); ++n) {
+					if (varIndices.at(n) >= 0)
+						arrays[varIndices.at(n)] = xVectors.at(n)->constData() + start;
+				}
+			}
+			program.evaluate(arrays, rangeValues.data(), result + start, end - start);
+		});
+	} else {
+		Parallel::forRanges(count, minRangeSize, [&](int start, int end) {
+			// every range has its own row index
+			auto rangeProgram = program;
+			auto rangePayload = payload;
+			if (start > 0) {
+				rangePayload = std::make_shared<PayloadExpressionParser>(&vars, &xVectors);
+				rangeProgram.replacePayload(payload, rangePayload);
+			}
+
+			auto rangeValues = values;
+			for (int i = start; i < end; i++) {
+				rangePayload->row = i; // all special functions contain pointer to payload so they get this information
+				if (rowIndex >= 0)
+					rangeValues[rowIndex] = i + 1;
 
-		if (parser.parseErrors() == 0)
-			constExpression = parser.variablesCounter() == 0;
-		// continue with next value
-		// if (parser.parseErrors() > 0)
-		//	return false;
+				for (int n = 0; n < varIndices.size(); ++n) {
+					if (varIndices.at(n) >= 0)
+						rangeValues[varIndices.at(n)] = xVectors.at(n)->at(i);
+				}
 
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(tmpExpr) << " evaluated to NAN")
+				result[i] = rangeProgram.evaluate(rangeValues.data());
+			}
+		});
+	}
 
-		(*yVector)[i] = y;
+	for (int i = 0; i < count; i++) {
+		if (std::isnan(yVector->at(i)))
+			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated to NAN")
 	}
 
 	// if the y-vector is longer than the x-vector(s), set all exceeding elements to NaN
@@ -797,23 +1024,23 @@ bool ExpressionParser::tryEvaluatePolar(const QString& expr,
 
 	Parser parser;
 	ParserLastErrorMessage lock(parser, m_lastErrorMessage);
+	parser.assign_symbol("phi", range.start());
 
-	const auto numberLocale = QLocale();
-	for (int i = 0; i < count; i++) {
-		const double phi = range.start() + step * i;
-		parser.assign_symbol("phi", phi);
+	const auto program = compile(parser, expr);
+	if (!program.isValid())
+		return false;
 
-		double r = parser.parse(qPrintable(expr), qPrintable(numberLocale.name()));
-		if (parser.parseErrors() > 0) // try default locale if failing
-			r = parser.parse(qPrintable(expr), "en_US");
-		if (parser.parseErrors() > 0)
-			return false;
+	std::vector<double> phi(count), r(count);
+	for (int i = 0; i < count; i++)
+		phi[i] = range.start() + step * i;
 
-		if (std::isnan(r))
-			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << phi << " is NAN")
+	evaluateProgram(program, "phi", phi.data(), r.data(), count);
+	for (int i = 0; i < count; i++) {
+		if (std::isnan(r.at(i)))
+			WARN(Q_FUNC_INFO << ", WARNING: expression " << STDSTRING(expr) << " evaluated @ " << phi.at(i) << " is NAN")
 
-		(*xVector)[i] = r * cos(phi);
-		(*yVector)[i] = r * sin(phi);
+		(*xVector)[i] = r.at(i) * cos(phi.at(i));
+		(*yVector)[i] = r.at(i) * sin(phi.at(i));
 	}
 
 	return true;
@@ -831,32 +1058,32 @@ bool ExpressionParser::tryEvaluateParametric(const QString& xexpr,
 	const Range<double> range{min, max};
 	const double step = range.stepSize(count);
 
-	Parser parser;
-	ParserLastErrorMessage lock(parser, m_lastErrorMessage);
-
-	const auto numberLocale = QLocale();
+	// separate parsers, since the set of used symbols is collected per parser
+	Parser xParser;
+	xParser.assign_symbol("t", range.start());
+	const auto xProgram = compile(xParser, xexpr);
+	m_lastErrorMessage = QString::fromStdString(xParser.lastErrorMessage());
+	if (!xProgram.isValid())
+		return false;
+
+	Parser yParser;
+	yParser.assign_symbol("t", range.start());
+	const auto yProgram = compile(yParser, yexpr);
+	m_lastErrorMessage = QString::fromStdString(yParser.lastErrorMessage());
+	if (!yProgram.isValid())
+		return false;
+
+	std::vector<double> t(count);
+	for (int i = 0; i < count; i++)
+		t[i] = range.start() + step * i;
+
+	evaluateProgram(xProgram, "t", t.data(), xVector->data(), count);
+	evaluateProgram(yProgram, "t", t.data(), yVector->data(), count);
 	for (int i = 0; i < count; i++) {
-		parser.assign_symbol("t", range.start() + step * i);
-
-		double x = parser.parse(qPrintable(xexpr), qPrintable(numberLocale.name()));
-		if (parser.parseErrors() > 0) // try default locale if failing
-			x = parser.parse(qPrintable(xexpr), "en_US");
-		if (parser.parseErrors() > 0)
-			return false;
-
-		double y = parser.parse(qPrintable(yexpr), qPrintable(numberLocale.name()));
-		if (parser.parseErrors() > 0) // try default locale if failing
-			y = parser.parse(qPrintable(yexpr), "en_US");
-		if (parser.parseErrors() > 0)
-			return false;
-
-		if (std::isnan(x))
-			WARN(Q_FUNC_INFO << ", WARNING: X expression " << STDSTRING(xexpr) << " evaluated @ " << range.start() + step * i << " is NAN")
-		if (std::isnan(y))
-			WARN(Q_FUNC_INFO << ", WARNING: Y expression " << STDSTRING(yexpr) << " evaluated @ " << range.start() + step * i << " is NAN")
-
-		(*xVector)[i] = x;
-		(*yVector)[i] = y;
+		if (std::isnan(xVector->at(i)))
+			WARN(Q_FUNC_INFO << ", WARNING: X expression " << STDSTRING(xexpr) << " evaluated @ " << t.at(i) << " is NAN")
+		if (std::isnan(yVector->at(i)))
+			WARN(Q_FUNC_INFO << ", WARNING: Y expression " << STDSTRING(yexpr) << " evaluated @ " << t.at(i) << " is NAN")
 	}
 
 	return true;
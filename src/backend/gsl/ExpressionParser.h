@@ -12,6 +12,7 @@
 #define EXPRESSIONPARSER_H
 
 #include "backend/gsl/ParserDeclarations.h"
+#include "backend/gsl/Program.h"
 #include "backend/lib/Range.h"
 #include "backend/worksheet/plots/cartesian/XYEquationCurve.h"
 
@@ -32,6 +33,7 @@ public:
 	setSpecialFunctionValueVariablePayload(const char* function_name, Parsing::func_tValueVariablePayload funct, std::shared_ptr<Parsing::Payload> payload);
 
 	static bool isValid(const QString& expr, const QStringList& vars = QStringList());
+	static Parsing::Program compile(Parsing::Parser& parser, const QString& expr);
 	QStringList getParameter(const QString& expr, const QStringList& vars);
 	bool tryEvaluateCartesian(const QString& expr,
 							  Range<double> range,
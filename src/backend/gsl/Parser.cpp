@@ -1,5 +1,6 @@
 #include "Parser.h"
 #include "ParserDeclarations.h"
+#include "Program.h"
 #include "backend/lib/Debug.h"
 #include "parser_private.h"
 
@@ -13,6 +14,27 @@ double Parser::parse(const char* string, const char* locale) {
 	DEBUG_PARSER("PARSER: parse('" << string << "') len = " << (int)strlen(string));
 	DEBUG_PARSER("********************************");
 
+	return run(string, locale, nullptr);
+}
+
+/*!
+ * \brief parses the expression once and returns its compiled form.
+ * The variables used in the expression must be assigned before (see \c assign_symbol()),
+ * the payloads of the special functions are the ones set at compile time.
+ * \sa Program::evaluate()
+ */
+Program Parser::compile(const char* string, const char* locale) {
+	DEBUG_PARSER("PARSER: compile('" << string << "') len = " << (int)strlen(string));
+	DEBUG_PARSER("********************************");
+
+	Program program;
+	run(string, locale, &program);
+	program.mValid = (mParseErrors == 0 && program.mDepth <= 1);
+
+	return program;
+}
+
+double Parser::run(const char* string, const char* locale, Program* program) {
 	/* be sure that the symbol table has been initialized */
 	if (variable_symbols.empty() || static_symbols.empty()) {
 		init_table();
@@ -22,6 +44,7 @@ double Parser::parse(const char* string, const char* locale) {
 	param p;
 	p.locale = locale;
 	p.parser = this;
+	p.program = program;
 	p.string = string;
 	/* pdebug("PARSER: Call yyparse() for \"%s\" (len = %d)\n", p.string, (int)strlen(p.string)); */
 
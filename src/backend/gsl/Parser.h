@@ -15,6 +15,7 @@
 #include <string>
 
 #include "ParserDeclarations.h"
+#include "Program.h"
 #include "parserFunctionTypes.h"
 
 class ExpressionParser;
@@ -34,6 +35,7 @@ public:
 
 	double parse(const char* string, const char* locale);
 	double parse_with_vars(const char* str, const parser_var* vars, int nvars, const char* locale);
+	Program compile(const char* string, const char* locale);
 
 	int parseErrors() const;
 	std::string lastErrorMessage() const;
@@ -61,6 +63,8 @@ public:
 	void setLastErrorMessage(const std::string& str);
 
 private:
+	double run(const char* string, const char* locale, Program* program);
+
 	double mResult{std::nan("0")};
 	int mParseErrors{0};
 	std::string mLastErrorMessage;
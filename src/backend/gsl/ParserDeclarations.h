@@ -22,6 +22,7 @@
 namespace Parsing {
 
 class Parser;
+class Program;
 
 // variables to pass to parser
 #define MAX_VARNAME_LENGTH 10
@@ -42,6 +43,7 @@ typedef struct param {
 	std::string_view string; /* the string to parse */
 	const char* locale{nullptr}; /* name of locale to convert numbers */
 	Parser* parser{nullptr};
+	Program* program{nullptr}; /* if set, the instructions of the expression are added to it (see Parser::compile()) */
 	double result{std::nan("0")};
 	size_t variablesCounter{0};
 	size_t errorCount{0};
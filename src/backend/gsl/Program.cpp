@@ -0,0 +1,1148 @@
+/*
+	File                 : Program.cpp
+	Project              : LabPlot
+	Description          : Compiled form of a mathematical expression
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "Program.h"
+#include "functions.h"
+#include "parser_private.h"
+
+#include <gsl/gsl_sf_gamma.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace Parsing {
+
+namespace {
+// programs with a smaller stack depth are evaluated without heap allocation
+constexpr size_t FixedStackSize = 32;
+// same for the stack of dual numbers (value and derivatives) used for automatic differentiation
+constexpr size_t FixedDualStackSize = 256;
+
+template<typename FunctionType, typename... Args>
+double callSpecialFunction(const special_function_def& special, Args... args) {
+	const auto& function = std::get<FunctionType>(special.funsptr->fnct);
+	if (!function)
+		return std::nan("0");
+	return function(args..., special.payload);
+}
+
+// loops over a block, simple enough to be auto-vectorized for inlined operations
+template<typename Operation>
+inline void unaryLoop(double* a, int count, Operation op) {
+	for (int k = 0; k < count; k++)
+		a[k] = op(a[k]);
+}
+
+template<typename Operation>
+inline void binaryLoop(double* a, const double* b, int count, Operation op) {
+	for (int k = 0; k < count; k++)
+		a[k] = op(a[k], b[k]);
+}
+
+void runKernel(Kernel kernel, double* a, int count) {
+	switch (kernel) {
+	case Kernel::Sqrt:
+		unaryLoop(a, count, [](double x) {
+			return std::sqrt(x);
+		});
+		break;
+	case Kernel::Fabs:
+		unaryLoop(a, count, [](double x) {
+			return std::fabs(x);
+		});
+		break;
+	case Kernel::Ceil:
+		unaryLoop(a, count, [](double x) {
+			return std::ceil(x);
+		});
+		break;
+	case Kernel::Trunc:
+		unaryLoop(a, count, [](double x) {
+			return std::trunc(x);
+		});
+		break;
+	case Kernel::Rint:
+		unaryLoop(a, count, [](double x) {
+			return std::rint(x);
+		});
+		break;
+	case Kernel::None:
+		break;
+	}
+}
+
+// functions of the function table that have an array kernel
+Kernel kernel(double (*function)(double)) {
+	if (function == static_cast<double (*)(double)>(&sqrt))
+		return Kernel::Sqrt;
+	if (function == static_cast<double (*)(double)>(&fabs))
+		return Kernel::Fabs;
+	if (function == static_cast<double (*)(double)>(&ceil))
+		return Kernel::Ceil;
+	if (function == static_cast<double (*)(double)>(&trunc))
+		return Kernel::Trunc;
+	if (function == static_cast<double (*)(double)>(&rint))
+		return Kernel::Rint;
+	return Kernel::None;
+}
+
+// functions of the function table with a known derivative
+Derivative derivativeOf(std::string_view name) {
+	static const std::pair<std::string_view, Derivative> derivatives[] = {
+		{"exp", Derivative::Exp},
+		{"expm1", Derivative::Expm1},
+		{"log", Derivative::Log},
+		{"log10", Derivative::Log10},
+		{"log2", Derivative::Log2},
+		{"log1p", Derivative::Log1p},
+		{"sqrt", Derivative::Sqrt},
+		{"cbrt", Derivative::Cbrt},
+		{"sin", Derivative::Sin},
+		{"cos", Derivative::Cos},
+		{"tan", Derivative::Tan},
+		{"sec", Derivative::Sec},
+		{"csc", Derivative::Csc},
+		{"cot", Derivative::Cot},
+		{"asin", Derivative::Asin},
+		{"acos", Derivative::Acos},
+		{"atan", Derivative::Atan},
+		{"sinh", Derivative::Sinh},
+		{"cosh", Derivative::Cosh},
+		{"tanh", Derivative::Tanh},
+		{"asinh", Derivative::Asinh},
+		{"acosh", Derivative::Acosh},
+		{"atanh", Derivative::Atanh},
+		{"erf", Derivative::Erf},
+		{"erfc", Derivative::Erfc},
+		{"fabs", Derivative::Fabs},
+		{"pow", Derivative::Pow},
+		{"atan2", Derivative::Atan2},
+		{"hypot", Derivative::Hypot},
+		{"if", Derivative::If},
+		// piecewise constant
+		{"ceil", Derivative::Zero},
+		{"rint", Derivative::Zero},
+		{"round", Derivative::Zero},
+		{"trunc", Derivative::Zero},
+		{"sgn", Derivative::Zero},
+		{"theta", Derivative::Zero},
+		{"logb", Derivative::Zero},
+		{"equal", Derivative::Zero},
+		{"between_inc", Derivative::Zero},
+		{"outside_inc", Derivative::Zero},
+		{"between", Derivative::Zero},
+		{"outside", Derivative::Zero},
+		{"and", Derivative::Zero},
+		{"or", Derivative::Zero},
+		{"xor", Derivative::Zero},
+		{"not", Derivative::Zero},
+	};
+
+	for (const auto& derivative : derivatives) {
+		if (derivative.first == name)
+			return derivative.second;
+	}
+	if (name.size() == 4 && name.substr(0, 3) == "pow" && name[3] >= '2' && name[3] <= '9')
+		return Derivative::PowN;
+	return Derivative::Numeric;
+}
+
+double callFunction(const funs* function, const double* args, int argc) {
+	switch (argc) {
+	case 0:
+		return std::get<func_t>(function->fnct)();
+	case 1:
+		return std::get<func_t1>(function->fnct)(args[0]);
+	case 2:
+		return std::get<func_t2>(function->fnct)(args[0], args[1]);
+	case 3:
+		return std::get<func_t3>(function->fnct)(args[0], args[1], args[2]);
+	case 4:
+		return std::get<func_t4>(function->fnct)(args[0], args[1], args[2], args[3]);
+	case 5:
+		return std::get<func_t5>(function->fnct)(args[0], args[1], args[2], args[3], args[4]);
+	}
+	return std::nan("0");
+}
+
+// step size of the central differences, cbrt(DBL_EPSILON) is optimal for a truncation error O(h^2)
+double differenceStep(double x) {
+	return 6.e-6 * std::max(1., std::abs(x));
+}
+
+// partial derivative of the function with respect to the argument \c index by central differences
+double numericDerivative(const funs* function, double* args, int argc, int index) {
+	const double x = args[index];
+	const double h = differenceStep(x);
+	args[index] = x + h;
+	const double valuePlus = callFunction(function, args, argc);
+	args[index] = x - h;
+	const double valueMinus = callFunction(function, args, argc);
+	args[index] = x;
+	return (valuePlus - valueMinus) / (2. * h);
+}
+
+// derivative of the function with one argument at \c x, \c v is the value of the function at \c x
+double derivative(const Instruction& instruction, double x, double v) {
+	switch (instruction.derivative) {
+	case Derivative::Zero:
+		return 0.;
+	case Derivative::Exp:
+		return v;
+	case Derivative::Expm1:
+		return v + 1.;
+	case Derivative::Log:
+		return 1. / x;
+	case Derivative::Log10:
+		return 1. / (x * M_LN10);
+	case Derivative::Log2:
+		return 1. / (x * M_LN2);
+	case Derivative::Log1p:
+		return 1. / (1. + x);
+	case Derivative::Sqrt:
+		return 0.5 / v;
+	case Derivative::Cbrt:
+		return 1. / (3. * v * v);
+	case Derivative::Sin:
+		return std::cos(x);
+	case Derivative::Cos:
+		return -std::sin(x);
+	case Derivative::Tan:
+		return 1. + v * v;
+	case Derivative::Sec:
+		return v * std::tan(x);
+	case Derivative::Csc:
+		return -v / std::tan(x);
+	case Derivative::Cot:
+		return -(1. + v * v);
+	case Derivative::Asin:
+		return 1. / std::sqrt(1. - x * x);
+	case Derivative::Acos:
+		return -1. / std::sqrt(1. - x * x);
+	case Derivative::Atan:
+		return 1. / (1. + x * x);
+	case Derivative::Sinh:
+		return std::cosh(x);
+	case Derivative::Cosh:
+		return std::sinh(x);
+	case Derivative::Tanh:
+		return 1. - v * v;
+	case Derivative::Asinh:
+		return 1. / std::sqrt(x * x + 1.);
+	case Derivative::Acosh:
+		return 1. / std::sqrt(x * x - 1.);
+	case Derivative::Atanh:
+		return 1. / (1. - x * x);
+	case Derivative::Erf:
+		return M_2_SQRTPI * std::exp(-x * x);
+	case Derivative::Erfc:
+		return -M_2_SQRTPI * std::exp(-x * x);
+	case Derivative::Fabs:
+		return x > 0 ? 1. : (x < 0 ? -1. : 0.);
+	case Derivative::PowN: {
+		const int n = instruction.function->name[3] - '0';
+		return n * std::pow(x, n - 1);
+	}
+	case Derivative::Numeric:
+	case Derivative::Pow:
+	case Derivative::Atan2:
+	case Derivative::Hypot:
+	case Derivative::If:
+		break;
+	}
+
+	double args[] = {x};
+	return numericDerivative(instruction.function, args, 1, 0);
+}
+} // anonymous namespace
+
+bool Program::isValid() const {
+	return mValid;
+}
+
+/*!
+ * \brief returns \c true if the program can be evaluated block-wise on whole arrays.
+ * This is not possible for expressions with assignments or special functions since they depend on the current row.
+ */
+bool Program::isVectorizable() const {
+	return mVectorizable;
+}
+
+/*!
+ * \brief returns \c true if the program can be evaluated from several threads at the same time.
+ * This is not the case for random number generators since they share a global state.
+ */
+bool Program::isThreadSafe() const {
+	return mThreadSafe;
+}
+
+/*!
+ * \brief returns \c true if the expression does not depend on any variable or row dependent special function
+ */
+bool Program::isConstant() const {
+	return mVariablesCounter == 0;
+}
+
+/*!
+ * \brief number of variable references in the expression, same as \c Parser::variablesCounter() after parsing it
+ */
+size_t Program::variablesCounter() const {
+	return mVariablesCounter;
+}
+
+const std::vector<std::string>& Program::variables() const {
+	return mVariables;
+}
+
+/*!
+ * \brief returns the slot of the variable \c name or -1 if the variable is not used in the expression
+ */
+int Program::variableIndex(const char* name) const {
+	for (size_t i = 0; i < mVariables.size(); ++i) {
+		if (mVariables.at(i) == name)
+			return (int)i;
+	}
+	return -1;
+}
+
+/*!
+ * \brief values of all variable slots at compile time, can be used as initial values for \c evaluate()
+ */
+std::vector<double> Program::variableValues() const {
+	return mValues;
+}
+
+const std::vector<Instruction>& Program::instructions() const {
+	return mInstructions;
+}
+
+/*!
+ * \brief special functions using \c payload use \c replacement instead
+ */
+void Program::replacePayload(const std::shared_ptr<Payload>& payload, const std::shared_ptr<Payload>& replacement) {
+	for (auto& instruction : mInstructions) {
+		if (instruction.special.funsptr && instruction.special.payload.lock() == payload)
+			instruction.special.payload = replacement;
+	}
+}
+
+/*!
+ * \brief evaluates the program
+ * \param values values of the variable slots (see \c variableValues()). Assignments in the expression are written back into it.
+ * \return result of the expression or NAN if the program is not valid
+ */
+double Program::evaluate(double* values) const {
+	if (!mValid || mInstructions.empty())
+		return std::nan("0");
+
+	if (mStackSize <= FixedStackSize) {
+		double stack[FixedStackSize];
+		return run(values, stack);
+	}
+
+	std::vector<double> stack(mStackSize);
+	return run(values, stack.data());
+}
+
+double Program::run(double* values, double* stack) const {
+	int top = -1;
+	for (const auto& instruction : mInstructions) {
+		switch (instruction.op) {
+		case OpCode::Constant:
+			stack[++top] = instruction.value;
+			break;
+		case OpCode::Variable:
+			stack[++top] = values[instruction.slot];
+			break;
+		case OpCode::Assign:
+			values[instruction.slot] = stack[top];
+			break;
+		case OpCode::Add:
+			--top;
+			stack[top] = stack[top] + stack[top + 1];
+			break;
+		case OpCode::Subtract:
+			--top;
+			stack[top] = stack[top] - stack[top + 1];
+			break;
+		case OpCode::Multiply:
+			--top;
+			stack[top] = stack[top] * stack[top + 1];
+			break;
+		case OpCode::Divide:
+			--top;
+			stack[top] = stack[top] / stack[top + 1];
+			break;
+		case OpCode::Modulo:
+			--top;
+			stack[top] = (int)(stack[top]) % (int)(stack[top + 1]);
+			break;
+		case OpCode::Power:
+			--top;
+			stack[top] = std::pow(stack[top], stack[top + 1]);
+			break;
+		case OpCode::Negate:
+			stack[top] = -stack[top];
+			break;
+		case OpCode::Abs:
+			stack[top] = std::abs(stack[top]);
+			break;
+		case OpCode::Factorial:
+			stack[top] = gsl_sf_fact((unsigned int)stack[top]);
+			break;
+		case OpCode::And:
+			--top;
+			stack[top] = andFunction(stack[top], stack[top + 1]);
+			break;
+		case OpCode::Or:
+			--top;
+			stack[top] = orFunction(stack[top], stack[top + 1]);
+			break;
+		case OpCode::Not:
+			stack[top] = notFunction(stack[top]);
+			break;
+		case OpCode::GreaterThan:
+			--top;
+			stack[top] = greaterThan(stack[top], stack[top + 1]);
+			break;
+		case OpCode::GreaterEqualThan:
+			--top;
+			stack[top] = greaterEqualThan(stack[top], stack[top + 1]);
+			break;
+		case OpCode::LessThan:
+			--top;
+			stack[top] = lessThan(stack[top], stack[top + 1]);
+			break;
+		case OpCode::LessEqualThan:
+			--top;
+			stack[top] = lessEqualThan(stack[top], stack[top + 1]);
+			break;
+		case OpCode::Function0:
+			stack[++top] = std::get<func_t>(instruction.function->fnct)();
+			break;
+		case OpCode::Function1:
+			if (instruction.function1)
+				stack[top] = instruction.function1(stack[top]);
+			else
+				stack[top] = std::get<func_t1>(instruction.function->fnct)(stack[top]);
+			break;
+		case OpCode::Function2:
+			top -= 1;
+			if (instruction.function2)
+				stack[top] = instruction.function2(stack[top], stack[top + 1]);
+			else
+				stack[top] = std::get<func_t2>(instruction.function->fnct)(stack[top], stack[top + 1]);
+			break;
+		case OpCode::Function3:
+			top -= 2;
+			stack[top] = std::get<func_t3>(instruction.function->fnct)(stack[top], stack[top + 1], stack[top + 2]);
+			break;
+		case OpCode::Function4:
+			top -= 3;
+			stack[top] = std::get<func_t4>(instruction.function->fnct)(stack[top], stack[top + 1], stack[top + 2], stack[top + 3]);
+			break;
+		case OpCode::Function5:
+			top -= 4;
+			stack[top] = std::get<func_t5>(instruction.function->fnct)(stack[top], stack[top + 1], stack[top + 2], stack[top + 3], stack[top + 4]);
+			break;
+		case OpCode::SpecialFunction:
+			stack[++top] = callSpecialFunction<func_tPayload>(instruction.special);
+			break;
+		case OpCode::SpecialFunctionVariable:
+			stack[++top] = callSpecialFunction<func_tVariablePayload, const std::string_view&>(instruction.special, instruction.variable);
+			break;
+		case OpCode::SpecialFunctionValue:
+			stack[top] = callSpecialFunction<func_tValuePayload>(instruction.special, stack[top]);
+			break;
+		case OpCode::SpecialFunction2Value:
+			top -= 1;
+			stack[top] = callSpecialFunction<func_t2ValuePayload>(instruction.special, stack[top], stack[top + 1]);
+			break;
+		case OpCode::SpecialFunctionValueVariable:
+			stack[top] = callSpecialFunction<func_tValueVariablePayload, double, const std::string_view&>(instruction.special, stack[top], instruction.variable);
+			break;
+		case OpCode::SpecialFunction2ValueVariable:
+			top -= 1;
+			stack[top] = callSpecialFunction<func_t2ValueVariablePayload, double, double, const std::string_view&>(instruction.special,
+																												   stack[top],
+																												   stack[top + 1],
+																												   instruction.variable);
+			break;
+		case OpCode::SpecialFunction3ValueVariable:
+			top -= 2;
+			stack[top] = callSpecialFunction<func_t3ValueVariablePayload, double, double, double, const std::string_view&>(instruction.special,
+																														   stack[top],
+																														   stack[top + 1],
+																														   stack[top + 2],
+																														   instruction.variable);
+			break;
+		}
+	}
+
+	return stack[top];
+}
+
+/*!
+ * \brief evaluates the program for \c count rows
+ * \param arrays for every variable slot the array with the values of the rows or \c nullptr if the value in \c values is used for all rows
+ * \param values values of the variable slots (see \c variableValues())
+ * \param result array for the \c count results
+ *
+ * Vectorizable programs are executed block-wise, all other programs row by row.
+ */
+void Program::evaluate(const std::vector<const double*>& arrays, double* values, double* result, int count) const {
+	if (!mValid || mInstructions.empty()) {
+		std::fill(result, result + count, std::nan("0"));
+		return;
+	}
+
+	if (!mVectorizable) {
+		for (int row = 0; row < count; row++) {
+			for (size_t slot = 0; slot < arrays.size(); slot++) {
+				if (arrays.at(slot))
+					values[slot] = arrays.at(slot)[row];
+			}
+			result[row] = evaluate(values);
+		}
+		return;
+	}
+
+	std::vector<double> stack(mStackSize * BlockSize);
+	std::vector<const double*> blockArrays(arrays.size());
+	for (int start = 0; start < count; start += BlockSize) {
+		const int n = std::min(BlockSize, count - start);
+		for (size_t slot = 0; slot < arrays.size(); slot++)
+			blockArrays[slot] = arrays.at(slot) ? arrays.at(slot) + start : nullptr;
+
+		runBlock(blockArrays, values, n, stack.data());
+		std::copy(stack.data(), stack.data() + n, result + start);
+	}
+}
+
+/*!
+ * executes the instructions for one block of \c count <= \c BlockSize rows.
+ * Every stack entry is a block, the result is in the first block of \c stack.
+ */
+void Program::runBlock(const std::vector<const double*>& arrays, const double* values, int count, double* stack) const {
+	int top = -1;
+	const auto block = [stack](int index) {
+		return stack + (size_t)index * BlockSize;
+	};
+
+	for (const auto& instruction : mInstructions) {
+		switch (instruction.op) {
+		case OpCode::Constant: {
+			double* a = block(++top);
+			std::fill(a, a + count, instruction.value);
+			break;
+		}
+		case OpCode::Variable: {
+			double* a = block(++top);
+			const double* array = instruction.slot < (int)arrays.size() ? arrays.at(instruction.slot) : nullptr;
+			if (array)
+				std::copy(array, array + count, a);
+			else
+				std::fill(a, a + count, values[instruction.slot]);
+			break;
+		}
+		case OpCode::Add:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return x + y;
+			});
+			break;
+		case OpCode::Subtract:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return x - y;
+			});
+			break;
+		case OpCode::Multiply:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return x * y;
+			});
+			break;
+		case OpCode::Divide:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return x / y;
+			});
+			break;
+		case OpCode::Modulo:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return (double)((int)x % (int)y);
+			});
+			break;
+		case OpCode::Power:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return std::pow(x, y);
+			});
+			break;
+		case OpCode::Negate:
+			unaryLoop(block(top), count, [](double x) {
+				return -x;
+			});
+			break;
+		case OpCode::Abs:
+			unaryLoop(block(top), count, [](double x) {
+				return std::abs(x);
+			});
+			break;
+		case OpCode::Factorial:
+			unaryLoop(block(top), count, [](double x) {
+				return gsl_sf_fact((unsigned int)x);
+			});
+			break;
+		// same as andFunction(), orFunction(), etc. but inlined
+		case OpCode::And:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return (double)(x != 0 && y != 0);
+			});
+			break;
+		case OpCode::Or:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return (double)(x != 0 || y != 0);
+			});
+			break;
+		case OpCode::Not:
+			unaryLoop(block(top), count, [](double x) {
+				return (double)(x == 0);
+			});
+			break;
+		case OpCode::GreaterThan:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return (double)(x > y);
+			});
+			break;
+		case OpCode::GreaterEqualThan:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return (double)(x >= y);
+			});
+			break;
+		case OpCode::LessThan:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return (double)(x < y);
+			});
+			break;
+		case OpCode::LessEqualThan:
+			--top;
+			binaryLoop(block(top), block(top + 1), count, [](double x, double y) {
+				return (double)(x <= y);
+			});
+			break;
+		case OpCode::Function0: {
+			double* a = block(++top);
+			const auto& function = std::get<func_t>(instruction.function->fnct);
+			for (int k = 0; k < count; k++)
+				a[k] = function();
+			break;
+		}
+		case OpCode::Function1: {
+			double* a = block(top);
+			if (instruction.kernel != Kernel::None)
+				runKernel(instruction.kernel, a, count);
+			else if (instruction.function1) {
+				const auto function = instruction.function1;
+				unaryLoop(a, count, [function](double x) {
+					return function(x);
+				});
+			} else {
+				const auto& function = std::get<func_t1>(instruction.function->fnct);
+				unaryLoop(a, count, [&function](double x) {
+					return function(x);
+				});
+			}
+			break;
+		}
+		case OpCode::Function2: {
+			--top;
+			if (instruction.function2) {
+				const auto function = instruction.function2;
+				binaryLoop(block(top), block(top + 1), count, [function](double x, double y) {
+					return function(x, y);
+				});
+			} else {
+				const auto& function = std::get<func_t2>(instruction.function->fnct);
+				binaryLoop(block(top), block(top + 1), count, [&function](double x, double y) {
+					return function(x, y);
+				});
+			}
+			break;
+		}
+		case OpCode::Function3: {
+			top -= 2;
+			double* a = block(top);
+			const double* b = block(top + 1);
+			const double* c = block(top + 2);
+			const auto& function = std::get<func_t3>(instruction.function->fnct);
+			for (int k = 0; k < count; k++)
+				a[k] = function(a[k], b[k], c[k]);
+			break;
+		}
+		case OpCode::Function4: {
+			top -= 3;
+			double* a = block(top);
+			const double* b = block(top + 1);
+			const double* c = block(top + 2);
+			const double* d = block(top + 3);
+			const auto& function = std::get<func_t4>(instruction.function->fnct);
+			for (int k = 0; k < count; k++)
+				a[k] = function(a[k], b[k], c[k], d[k]);
+			break;
+		}
+		case OpCode::Function5: {
+			top -= 4;
+			double* a = block(top);
+			const double* b = block(top + 1);
+			const double* c = block(top + 2);
+			const double* d = block(top + 3);
+			const double* e = block(top + 4);
+			const auto& function = std::get<func_t5>(instruction.function->fnct);
+			for (int k = 0; k < count; k++)
+				a[k] = function(a[k], b[k], c[k], d[k], e[k]);
+			break;
+		}
+		// not vectorizable (see isVectorizable())
+		case OpCode::Assign:
+		case OpCode::SpecialFunction:
+		case OpCode::SpecialFunctionVariable:
+		case OpCode::SpecialFunctionValue:
+		case OpCode::SpecialFunction2Value:
+		case OpCode::SpecialFunctionValueVariable:
+		case OpCode::SpecialFunction2ValueVariable:
+		case OpCode::SpecialFunction3ValueVariable:
+			break;
+		}
+	}
+}
+
+/*!
+ * \brief evaluates the program together with its partial derivatives
+ * \param values values of the variable slots (see \c variableValues())
+ * \param slots slots of the variables to differentiate with respect to. The derivative for a slot -1 (variable not used) is 0.
+ * \param gradient array for the \c slots.size() partial derivatives
+ * \return result of the expression or NAN if the program is not valid
+ *
+ * Forward mode automatic differentiation: every value on the stack is a dual number carrying its partial derivatives.
+ * The derivatives of the elementary functions of the function table are known, all other functions are
+ * differentiated numerically. Programs with assignments or special functions are differentiated numerically as a whole.
+ */
+double Program::evaluateGradient(double* values, const std::vector<int>& slots, double* gradient) const {
+	if (!mValid || mInstructions.empty()) {
+		std::fill(gradient, gradient + slots.size(), std::nan("0"));
+		return std::nan("0");
+	}
+
+	if (!mVectorizable)
+		return numericGradient(values, slots, gradient);
+
+	const size_t size = mStackSize * (slots.size() + 1);
+	if (size <= FixedDualStackSize) {
+		double stack[FixedDualStackSize];
+		return runDual(values, slots, gradient, stack);
+	}
+
+	std::vector<double> stack(size);
+	return runDual(values, slots, gradient, stack.data());
+}
+
+/*!
+ * executes the instructions on dual numbers. Every stack entry consists of the value followed by the derivatives.
+ */
+double Program::runDual(const double* values, const std::vector<int>& slots, double* gradient, double* stack) const {
+	const size_t m = slots.size();
+	const auto entry = [stack, m](int index) {
+		return stack + (size_t)index * (m + 1);
+	};
+	const auto setConstant = [m](double* a, double value) {
+		a[0] = value;
+		std::fill(a + 1, a + 1 + m, 0.);
+	};
+	const auto hasDerivative = [m](const double* a) {
+		return std::any_of(a + 1, a + 1 + m, [](double d) {
+			return d != 0.;
+		});
+	};
+
+	int top = -1;
+	for (const auto& instruction : mInstructions) {
+		switch (instruction.op) {
+		case OpCode::Constant:
+			setConstant(entry(++top), instruction.value);
+			break;
+		case OpCode::Variable: {
+			double* a = entry(++top);
+			a[0] = values[instruction.slot];
+			for (size_t k = 0; k < m; k++)
+				a[1 + k] = slots.at(k) == instruction.slot ? 1. : 0.;
+			break;
+		}
+		case OpCode::Add: {
+			--top;
+			double* a = entry(top);
+			const double* b = entry(top + 1);
+			for (size_t j = 0; j <= m; j++)
+				a[j] += b[j];
+			break;
+		}
+		case OpCode::Subtract: {
+			--top;
+			double* a = entry(top);
+			const double* b = entry(top + 1);
+			for (size_t j = 0; j <= m; j++)
+				a[j] -= b[j];
+			break;
+		}
+		case OpCode::Multiply: {
+			--top;
+			double* a = entry(top);
+			const double* b = entry(top + 1);
+			for (size_t k = 1; k <= m; k++)
+				a[k] = a[k] * b[0] + a[0] * b[k];
+			a[0] *= b[0];
+			break;
+		}
+		case OpCode::Divide: {
+			--top;
+			double* a = entry(top);
+			const double* b = entry(top + 1);
+			const double q = a[0] / b[0];
+			for (size_t k = 1; k <= m; k++)
+				a[k] = (a[k] - q * b[k]) / b[0];
+			a[0] = q;
+			break;
+		}
+		case OpCode::Modulo: {
+			--top;
+			double* a = entry(top);
+			setConstant(a, (int)(a[0]) % (int)(entry(top + 1)[0]));
+			break;
+		}
+		case OpCode::Power: {
+			--top;
+			double* a = entry(top);
+			const double* b = entry(top + 1);
+			const double p = std::pow(a[0], b[0]);
+			for (size_t k = 1; k <= m; k++) {
+				double d = 0.;
+				if (a[k] != 0.)
+					d += b[0] * std::pow(a[0], b[0] - 1.) * a[k];
+				if (b[k] != 0.)
+					d += p * std::log(a[0]) * b[k];
+				a[k] = d;
+			}
+			a[0] = p;
+			break;
+		}
+		case OpCode::Negate: {
+			double* a = entry(top);
+			for (size_t j = 0; j <= m; j++)
+				a[j] = -a[j];
+			break;
+		}
+		case OpCode::Abs: {
+			double* a = entry(top);
+			const double sign = a[0] > 0 ? 1. : (a[0] < 0 ? -1. : 0.);
+			for (size_t k = 1; k <= m; k++)
+				a[k] *= sign;
+			a[0] = std::abs(a[0]);
+			break;
+		}
+		// piecewise constant
+		case OpCode::Factorial: {
+			double* a = entry(top);
+			setConstant(a, gsl_sf_fact((unsigned int)a[0]));
+			break;
+		}
+		case OpCode::And:
+			--top;
+			setConstant(entry(top), andFunction(entry(top)[0], entry(top + 1)[0]));
+			break;
+		case OpCode::Or:
+			--top;
+			setConstant(entry(top), orFunction(entry(top)[0], entry(top + 1)[0]));
+			break;
+		case OpCode::Not:
+			setConstant(entry(top), notFunction(entry(top)[0]));
+			break;
+		case OpCode::GreaterThan:
+			--top;
+			setConstant(entry(top), greaterThan(entry(top)[0], entry(top + 1)[0]));
+			break;
+		case OpCode::GreaterEqualThan:
+			--top;
+			setConstant(entry(top), greaterEqualThan(entry(top)[0], entry(top + 1)[0]));
+			break;
+		case OpCode::LessThan:
+			--top;
+			setConstant(entry(top), lessThan(entry(top)[0], entry(top + 1)[0]));
+			break;
+		case OpCode::LessEqualThan:
+			--top;
+			setConstant(entry(top), lessEqualThan(entry(top)[0], entry(top + 1)[0]));
+			break;
+		case OpCode::Function0:
+			setConstant(entry(++top), std::get<func_t>(instruction.function->fnct)());
+			break;
+		case OpCode::Function1: {
+			double* a = entry(top);
+			const double x = a[0];
+			const double v = instruction.function1 ? instruction.function1(x) : std::get<func_t1>(instruction.function->fnct)(x);
+			if (hasDerivative(a)) {
+				const double d = derivative(instruction, x, v);
+				for (size_t k = 1; k <= m; k++) {
+					if (a[k] != 0.)
+						a[k] *= d;
+				}
+			}
+			a[0] = v;
+			break;
+		}
+		case OpCode::Function2: {
+			--top;
+			double* a = entry(top);
+			const double* b = entry(top + 1);
+			double args[] = {a[0], b[0]};
+			const double v = callFunction(instruction.function, args, 2);
+
+			double da = 0., db = 0.; // partial derivatives with respect to the arguments
+			switch (instruction.derivative) {
+			case Derivative::Zero:
+				break;
+			case Derivative::Pow:
+				da = args[1] * std::pow(args[0], args[1] - 1.);
+				if (hasDerivative(b))
+					db = v * std::log(args[0]);
+				break;
+			case Derivative::Atan2: {
+				const double r2 = args[0] * args[0] + args[1] * args[1];
+				da = args[1] / r2;
+				db = -args[0] / r2;
+				break;
+			}
+			case Derivative::Hypot:
+				da = args[0] / v;
+				db = args[1] / v;
+				break;
+			default:
+				if (hasDerivative(a))
+					da = numericDerivative(instruction.function, args, 2, 0);
+				if (hasDerivative(b))
+					db = numericDerivative(instruction.function, args, 2, 1);
+			}
+
+			for (size_t k = 1; k <= m; k++)
+				a[k] = (a[k] != 0. ? da * a[k] : 0.) + (b[k] != 0. ? db * b[k] : 0.);
+			a[0] = v;
+			break;
+		}
+		case OpCode::Function3:
+		case OpCode::Function4:
+		case OpCode::Function5: {
+			const int argc = (int)instruction.op - (int)OpCode::Function0;
+			top -= argc - 1;
+			double* a = entry(top);
+			double args[5];
+			for (int i = 0; i < argc; i++)
+				args[i] = entry(top + i)[0];
+			const double v = callFunction(instruction.function, args, argc);
+
+			if (instruction.derivative == Derivative::If) { // derivative of the selected argument
+				const double* selected = entry(top + (args[0] != 0 ? 1 : 2));
+				std::copy(selected + 1, selected + 1 + m, a + 1);
+			} else if (instruction.derivative == Derivative::Zero)
+				std::fill(a + 1, a + 1 + m, 0.);
+			else {
+				double partials[5] = {0., 0., 0., 0., 0.};
+				for (int i = 0; i < argc; i++) {
+					if (hasDerivative(entry(top + i)))
+						partials[i] = numericDerivative(instruction.function, args, argc, i);
+				}
+				for (size_t k = 1; k <= m; k++) {
+					double d = 0.;
+					for (int i = 0; i < argc; i++) {
+						const double argumentDerivative = entry(top + i)[k];
+						if (argumentDerivative != 0.)
+							d += partials[i] * argumentDerivative;
+					}
+					a[k] = d;
+				}
+			}
+			a[0] = v;
+			break;
+		}
+		// not differentiated with dual numbers (see evaluateGradient())
+		case OpCode::Assign:
+		case OpCode::SpecialFunction:
+		case OpCode::SpecialFunctionVariable:
+		case OpCode::SpecialFunctionValue:
+		case OpCode::SpecialFunction2Value:
+		case OpCode::SpecialFunctionValueVariable:
+		case OpCode::SpecialFunction2ValueVariable:
+		case OpCode::SpecialFunction3ValueVariable:
+			break;
+		}
+	}
+
+	std::copy(stack + 1, stack + 1 + m, gradient);
+	return stack[0];
+}
+
+/*!
+ * calculates the partial derivatives of the whole program by central differences
+ */
+double Program::numericGradient(double* values, const std::vector<int>& slots, double* gradient) const {
+	const std::vector<double> initialValues(values, values + mValues.size());
+	const double value = evaluate(values);
+
+	std::vector<double> shiftedValues;
+	for (size_t k = 0; k < slots.size(); k++) {
+		const int slot = slots.at(k);
+		if (slot < 0) {
+			gradient[k] = 0.;
+			continue;
+		}
+
+		const double x = initialValues.at(slot);
+		const double h = differenceStep(x);
+		shiftedValues = initialValues;
+		shiftedValues[slot] = x + h;
+		const double valuePlus = evaluate(shiftedValues.data());
+		shiftedValues = initialValues;
+		shiftedValues[slot] = x - h;
+		const double valueMinus = evaluate(shiftedValues.data());
+		gradient[k] = (valuePlus - valueMinus) / (2. * h);
+	}
+
+	return value;
+}
+
+// ##############################################################################
+// ################### code generation (called by the parser) ###################
+// ##############################################################################
+void Program::add(Instruction&& instruction, int stackChange) {
+	mInstructions.push_back(std::move(instruction));
+	mDepth += stackChange;
+	mStackSize = std::max(mStackSize, (size_t)std::max(mDepth, 0));
+}
+
+/*!
+ * returns the slot of the variable \c symbol, adding it if not used before
+ */
+int Program::slot(const BaseSymbol* symbol) {
+	for (size_t i = 0; i < mVariables.size(); ++i) {
+		if (mVariables.at(i) == symbol->name)
+			return (int)i;
+	}
+	mVariables.emplace_back(symbol->name);
+	mValues.push_back(std::get<double>(symbol->value));
+	return (int)mVariables.size() - 1;
+}
+
+void Program::addConstant(double value) {
+	Instruction instruction{OpCode::Constant};
+	instruction.value = value;
+	add(std::move(instruction), 1);
+}
+
+/*!
+ * adds a reference to a VAR symbol. Constants (static symbols) are inlined, all other variables get a slot
+ */
+void Program::addSymbol(const BaseSymbol* symbol) {
+	mVariablesCounter++;
+	if (std::find(static_symbols.cbegin(), static_symbols.cend(), symbol) != static_symbols.cend()) {
+		addConstant(std::get<double>(symbol->value));
+		return;
+	}
+
+	Instruction instruction{OpCode::Variable};
+	instruction.slot = slot(symbol);
+	add(std::move(instruction), 1);
+}
+
+void Program::addAssignment(const BaseSymbol* symbol) {
+	mVariablesCounter++;
+	mVectorizable = false;
+	Instruction instruction{OpCode::Assign};
+	instruction.slot = slot(symbol);
+	add(std::move(instruction), 0);
+}
+
+void Program::addOperation(OpCode op) {
+	switch (op) {
+	case OpCode::Negate:
+	case OpCode::Abs:
+	case OpCode::Factorial:
+	case OpCode::Not:
+		add(Instruction{op}, 0);
+		break;
+	default: // binary operators
+		add(Instruction{op}, -1);
+	}
+}
+
+void Program::addFunction(const funs* function, int argc) {
+	static const OpCode opCodes[] = {OpCode::Function0, OpCode::Function1, OpCode::Function2, OpCode::Function3, OpCode::Function4, OpCode::Function5};
+	Instruction instruction{opCodes[argc]};
+	instruction.function = function;
+	instruction.derivative = derivativeOf(function->name);
+	// all functions without arguments are random number generators
+	if (argc == 0 || function->group == FunctionGroups::RandomNumberGenerator)
+		mThreadSafe = false;
+	if (argc == 1) {
+		const auto* pointer = std::get<func_t1>(function->fnct).target<double (*)(double)>();
+		if (pointer) {
+			instruction.function1 = *pointer;
+			instruction.kernel = kernel(*pointer);
+		}
+	} else if (argc == 2) {
+		const auto* pointer = std::get<func_t2>(function->fnct).target<double (*)(double, double)>();
+		if (pointer)
+			instruction.function2 = *pointer;
+	}
+	add(std::move(instruction), 1 - argc);
+}
+
+void Program::addSpecialFunction(OpCode op, const special_function_def& special, std::string_view variable) {
+	if (!special.payload.expired() && !special.payload.lock()->constant)
+		mVariablesCounter++;
+	mVectorizable = false;
+
+	int stackChange = 0;
+	switch (op) {
+	case OpCode::SpecialFunction:
+	case OpCode::SpecialFunctionVariable:
+		stackChange = 1;
+		break;
+	case OpCode::SpecialFunction2Value:
+	case OpCode::SpecialFunction2ValueVariable:
+		stackChange = -1;
+		break;
+	case OpCode::SpecialFunction3ValueVariable:
+		stackChange = -2;
+		break;
+	default:
+		break;
+	}
+
+	Instruction instruction{op};
+	instruction.special = special;
+	instruction.variable = std::string(variable);
+	add(std::move(instruction), stackChange);
+}
+
+} // namespace Parsing
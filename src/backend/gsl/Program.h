@@ -0,0 +1,186 @@
+/*
+	File                 : Program.h
+	Project              : LabPlot
+	Description          : Compiled form of a mathematical expression
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef PARSERPROGRAM_H
+#define PARSERPROGRAM_H
+
+#include <cmath>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "ParserDeclarations.h"
+
+namespace Parsing {
+
+struct funs;
+
+enum class OpCode : unsigned char {
+	Constant,
+	Variable,
+	Assign,
+	Add,
+	Subtract,
+	Multiply,
+	Divide,
+	Modulo,
+	Power,
+	Negate,
+	Abs,
+	Factorial,
+	And,
+	Or,
+	Not,
+	GreaterThan,
+	GreaterEqualThan,
+	LessThan,
+	LessEqualThan,
+	Function0,
+	Function1,
+	Function2,
+	Function3,
+	Function4,
+	Function5,
+	SpecialFunction, // func_tPayload
+	SpecialFunctionVariable, // func_tVariablePayload
+	SpecialFunctionValue, // func_tValuePayload
+	SpecialFunction2Value, // func_t2ValuePayload
+	SpecialFunctionValueVariable, // func_tValueVariablePayload
+	SpecialFunction2ValueVariable, // func_t2ValueVariablePayload
+	SpecialFunction3ValueVariable, // func_t3ValueVariablePayload
+};
+
+// array kernels for functions which can be vectorized by the compiler
+enum class Kernel : unsigned char { None, Sqrt, Fabs, Ceil, Trunc, Rint };
+
+// derivatives of the functions of the function table used for automatic differentiation
+enum class Derivative : unsigned char {
+	Numeric, // unknown, calculated by central differences
+	Zero, // piecewise constant functions
+	Exp,
+	Expm1,
+	Log,
+	Log10,
+	Log2,
+	Log1p,
+	Sqrt,
+	Cbrt,
+	Sin,
+	Cos,
+	Tan,
+	Sec,
+	Csc,
+	Cot,
+	Asin,
+	Acos,
+	Atan,
+	Sinh,
+	Cosh,
+	Tanh,
+	Asinh,
+	Acosh,
+	Atanh,
+	Erf,
+	Erfc,
+	Fabs,
+	PowN, // pow2 .. pow9
+	Pow,
+	Atan2,
+	Hypot,
+	If,
+};
+
+struct Instruction {
+	OpCode op;
+	int slot{-1}; // variable slot for Variable and Assign
+	double value{0.}; // value for Constant
+	const funs* function{nullptr}; // function for Function0 .. Function5
+	double (*function1)(double){nullptr}; // plain function pointer of function (if available) to avoid the std::function call
+	double (*function2)(double, double){nullptr};
+	Kernel kernel{Kernel::None};
+	Derivative derivative{Derivative::Numeric};
+	special_function_def special; // special function and its payload
+	std::string variable; // variable name argument of special functions
+};
+
+/*!
+ * \brief Expression compiled by \c Parser::compile().
+ *
+ * The instructions are stored in postfix order and are executed on a small value stack.
+ * Variables are resolved to slots at compile time, the values of the slots are passed to
+ * \c evaluate(). Use \c variableIndex() to find the slot of a variable and \c variableValues()
+ * to get the values the variables had at compile time.
+ *
+ * Evaluation does not touch the global symbol table of the parser, so a program
+ * can be evaluated for many rows without parsing the expression string again.
+ *
+ * Programs without assignments and special functions can be evaluated on whole arrays
+ * (see \c isVectorizable()). This is done in blocks of \c BlockSize values, every instruction
+ * is executed as a tight loop over the block.
+ *
+ * Evaluation is reentrant: a program can be evaluated from several threads at the same time as long as
+ * every thread uses its own variable values and the program doesn't use random numbers (see \c isThreadSafe()).
+ * Special functions get their state from the payload, use \c replacePayload() to give every thread its own copy.
+ *
+ * \c evaluateGradient() calculates the partial derivatives with respect to some of the variables
+ * together with the value using forward mode automatic differentiation.
+ */
+class Program {
+public:
+	static constexpr int BlockSize = 1024;
+
+	bool isValid() const;
+	bool isVectorizable() const;
+	bool isThreadSafe() const;
+	bool isConstant() const;
+	size_t variablesCounter() const;
+
+	const std::vector<std::string>& variables() const;
+	int variableIndex(const char* name) const;
+	std::vector<double> variableValues() const;
+
+	double evaluate(double* values) const;
+	void evaluate(const std::vector<const double*>& arrays, double* values, double* result, int count) const;
+	double evaluateGradient(double* values, const std::vector<int>& slots, double* gradient) const;
+
+	const std::vector<Instruction>& instructions() const;
+	void replacePayload(const std::shared_ptr<Payload>& payload, const std::shared_ptr<Payload>& replacement);
+
+	// called by the parser during compilation
+	void addConstant(double value);
+	void addSymbol(const BaseSymbol* symbol);
+	void addAssignment(const BaseSymbol* symbol);
+	void addOperation(OpCode op);
+	void addFunction(const funs* function, int argc);
+	void addSpecialFunction(OpCode op, const special_function_def& special, std::string_view variable = std::string_view());
+
+private:
+	int slot(const BaseSymbol* symbol);
+	void add(Instruction&& instruction, int stackChange);
+	double run(double* values, double* stack) const;
+	void runBlock(const std::vector<const double*>& arrays, const double* values, int count, double* stack) const;
+	double runDual(const double* values, const std::vector<int>& slots, double* gradient, double* stack) const;
+	double numericGradient(double* values, const std::vector<int>& slots, double* gradient) const;
+
+	std::vector<Instruction> mInstructions;
+	std::vector<std::string> mVariables;
+	std::vector<double> mValues; // values of the variables at compile time
+	size_t mStackSize{0};
+	int mDepth{0};
+	size_t mVariablesCounter{0};
+	bool mValid{false};
+	bool mVectorizable{true};
+	bool mThreadSafe{true};
+
+	friend class Parser;
+};
+
+} // namespace Parsing
+
+#endif // PARSERPROGRAM_H
@@ -197,6 +197,7 @@ const char* specialfun_smmin = "smmin";
 const char* specialfun_smmax = "smmax";
 const char* specialfun_sma = "sma";
 const char* specialfun_smr = "smr";
+const char* specialfun_smmed = "smmed";
 const char* specialfun_psample = "psample";
 const char* specialfun_rsample = "rsample";
 
@@ -246,6 +247,7 @@ const char* cell_curr_column_default = "cell_curr_column_with_default";
 		{[]() { return i18n("Simple Moving Maximum"); }, specialfun_smmax, func_tValueVariablePayload(), 2, nullptr, FunctionGroups::MovingStatistics},
 		{[]() { return i18n("Simple Moving Average"); }, specialfun_sma, func_tValueVariablePayload(), 2, nullptr, FunctionGroups::MovingStatistics},
 		{[]() { return i18n("Simple Moving Range"); }, specialfun_smr, func_tValueVariablePayload(), 2, nullptr, FunctionGroups::MovingStatistics},
+		{[]() { return i18n("Simple Moving Median"); }, specialfun_smmed, func_tValueVariablePayload(), 2, nullptr, FunctionGroups::MovingStatistics},
 		{[]() { return i18n("Period sample"); }, specialfun_psample, func_tValueVariablePayload(), 2, nullptr, FunctionGroups::MovingStatistics},
 		{[]() { return i18n("Random sample"); }, specialfun_rsample, func_tVariablePayload(), 1, nullptr, FunctionGroups::MovingStatistics},
 
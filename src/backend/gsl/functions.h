@@ -186,6 +186,7 @@ extern const char* specialfun_smmin;
 extern const char* specialfun_smmax;
 extern const char* specialfun_sma;
 extern const char* specialfun_smr;
+extern const char* specialfun_smmed;
 extern const char* specialfun_psample;
 extern const char* specialfun_rsample;
 
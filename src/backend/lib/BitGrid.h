@@ -0,0 +1,53 @@
+/*
+	File                 : BitGrid.h
+	Project              : LabPlot
+	Description          : Reusable two-dimensional grid of bits
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef BITGRID_H
+#define BITGRID_H
+
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+/*!
+ * \brief Two-dimensional grid of bits, e.g. to remember the pixels already occupied by a point.
+ *
+ * The memory is kept when the grid is reset, so the same grid can be reused for many curves
+ * and retransforms without allocations. Resetting clears the used words with a single memset.
+ */
+class BitGrid {
+public:
+	/*!
+	 * resizes the grid to \c width x \c height bits and clears all bits.
+	 */
+	void reset(int width, int height) {
+		m_height = height;
+		const size_t words = ((size_t)width * height + 63) / 64;
+		if (m_words.size() < words)
+			m_words.resize(words);
+		std::memset(m_words.data(), 0, words * sizeof(uint64_t));
+	}
+
+	/*!
+	 * sets the bit (x, y) and returns \c true if it was already set before.
+	 */
+	bool testAndSet(int x, int y) {
+		const size_t index = (size_t)x * m_height + y;
+		auto& word = m_words[index / 64];
+		const uint64_t mask = uint64_t(1) << (index % 64);
+		const bool set = word & mask;
+		word |= mask;
+		return set;
+	}
+
+private:
+	std::vector<uint64_t> m_words;
+	int m_height{0};
+};
+
+#endif // BITGRID_H
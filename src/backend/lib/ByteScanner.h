@@ -0,0 +1,132 @@
+/*
+	File                 : ByteScanner.h
+	Project              : LabPlot
+	Description          : Vectorized search of bytes, e.g. line ends and separators in text files
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef BYTESCANNER_H
+#define BYTESCANNER_H
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__AVX2__) || defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <immintrin.h>
+#define BYTESCANNER_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define BYTESCANNER_NEON
+#endif
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/*!
+ * \brief Functions to search bytes in blocks of raw bytes, e.g. the line ends and the separators in the data of text files.
+ *
+ * The bytes are compared 32 (AVX2) or 16 (SSE2, NEON) at a time, the remaining bytes and other CPUs use scalar code.
+ * AVX2 is used if the code is compiled for it, SSE2 is always available on x86-64.
+ */
+namespace ByteScanner {
+
+namespace Private {
+inline int firstBit(uint32_t mask) {
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward(&index, mask);
+	return static_cast<int>(index);
+#else
+	return __builtin_ctz(mask);
+#endif
+}
+}
+
+/*!
+ * returns the number of bytes \c c in [\c begin, \c end).
+ */
+inline qint64 count(const char* begin, const char* end, char c) {
+	qint64 result = 0;
+	const char* p = begin;
+#if defined(BYTESCANNER_SSE2)
+	// the matches are counted per byte position (compare results are -1) and summed up before the byte counters overflow
+	const __m128i needle = _mm_set1_epi8(c);
+	const __m128i zero = _mm_setzero_si128();
+	while (end - p >= 16) {
+		__m128i counters = zero;
+		for (int i = 0; i < 255 && end - p >= 16; ++i, p += 16)
+			counters = _mm_sub_epi8(counters, _mm_cmpeq_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(p)), needle));
+		alignas(16) uint64_t sums[2];
+		_mm_store_si128(reinterpret_cast<__m128i*>(sums), _mm_sad_epu8(counters, zero));
+		result += static_cast<qint64>(sums[0] + sums[1]);
+	}
+#elif defined(BYTESCANNER_NEON)
+	const uint8x16_t needle = vdupq_n_u8(static_cast<uint8_t>(c));
+	while (end - p >= 16) {
+		uint8x16_t counters = vdupq_n_u8(0);
+		for (int i = 0; i < 255 && end - p >= 16; ++i, p += 16)
+			counters = vsubq_u8(counters, vceqq_u8(vld1q_u8(reinterpret_cast<const uint8_t*>(p)), needle));
+		result += vaddlvq_u8(counters);
+	}
+#endif
+	return result + std::count(p, end, c);
+}
+
+/*!
+ * returns a pointer to the first byte in [\c begin, \c end) equal to \c a, \c b, \c c or \c d, or \c end if there is no such byte.
+ * Pass the same byte several times to search for less than four different bytes.
+ */
+inline const char* findAny(const char* begin, const char* end, char a, char b, char c, char d) {
+	const char* p = begin;
+#if defined(__AVX2__)
+	{
+		const __m256i na = _mm256_set1_epi8(a), nb = _mm256_set1_epi8(b), nc = _mm256_set1_epi8(c), nd = _mm256_set1_epi8(d);
+		for (; end - p >= 32; p += 32) {
+			const __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+			const __m256i matches = _mm256_or_si256(_mm256_or_si256(_mm256_cmpeq_epi8(v, na), _mm256_cmpeq_epi8(v, nb)),
+													_mm256_or_si256(_mm256_cmpeq_epi8(v, nc), _mm256_cmpeq_epi8(v, nd)));
+			const auto mask = static_cast<uint32_t>(_mm256_movemask_epi8(matches));
+			if (mask)
+				return p + Private::firstBit(mask);
+		}
+	}
+#endif
+#if defined(BYTESCANNER_SSE2)
+	{
+		const __m128i na = _mm_set1_epi8(a), nb = _mm_set1_epi8(b), nc = _mm_set1_epi8(c), nd = _mm_set1_epi8(d);
+		for (; end - p >= 16; p += 16) {
+			const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+			const __m128i matches =
+				_mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, na), _mm_cmpeq_epi8(v, nb)), _mm_or_si128(_mm_cmpeq_epi8(v, nc), _mm_cmpeq_epi8(v, nd)));
+			const auto mask = static_cast<uint32_t>(_mm_movemask_epi8(matches));
+			if (mask)
+				return p + Private::firstBit(mask);
+		}
+	}
+#elif defined(BYTESCANNER_NEON)
+	{
+		const uint8x16_t na = vdupq_n_u8(static_cast<uint8_t>(a)), nb = vdupq_n_u8(static_cast<uint8_t>(b));
+		const uint8x16_t nc = vdupq_n_u8(static_cast<uint8_t>(c)), nd = vdupq_n_u8(static_cast<uint8_t>(d));
+		for (; end - p >= 16; p += 16) {
+			const uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t*>(p));
+			const uint8x16_t matches = vorrq_u8(vorrq_u8(vceqq_u8(v, na), vceqq_u8(v, nb)), vorrq_u8(vceqq_u8(v, nc), vceqq_u8(v, nd)));
+			if (vmaxvq_u8(matches))
+				break; // the match is located by the scalar loop
+		}
+	}
+#endif
+	for (; p < end; ++p) {
+		if (*p == a || *p == b || *p == c || *p == d)
+			return p;
+	}
+	return end;
+}
+
+} // namespace ByteScanner
+
+#endif // BYTESCANNER_H
@@ -0,0 +1,250 @@
+/*
+	File                 : DateTimeVector.h
+	Project              : LabPlot
+	Description          : Compact container of date-time values
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef DATETIMEVECTOR_H
+#define DATETIMEVECTOR_H
+
+#include <QDateTime>
+#include <QTimeZone>
+#include <QVector>
+
+#include <algorithm>
+#include <iterator>
+#include <limits>
+
+/*!
+ * \brief Container of date-time values stored as milliseconds since epoch.
+ *
+ * This is the data container of DateTime, Month and Day columns. The values are kept as \c qint64
+ * together with one time zone for the whole container, \c QDateTime objects are only created on access.
+ * Invalid date-times are stored as \c InvalidValue.
+ *
+ * The interface follows \c QVector<QDateTime> so that the data can be filled and read like before.
+ * The time zone is set with \c setTimeZone() (import, project load) or taken from the first valid value
+ * written into the container (UTC by default). Values written later don't change it, only their instant is stored.
+ * The values read from the container are returned in this time zone.
+ * \c msecsAt() and \c constData() give direct access to the stored values without any conversion.
+ */
+class DateTimeVector {
+public:
+	static constexpr qint64 InvalidValue = std::numeric_limits<qint64>::min();
+
+	//! proxy returned by the non-const operator[] to assign a QDateTime
+	class reference {
+	public:
+		reference(DateTimeVector* vector, qsizetype index)
+			: m_vector(vector)
+			, m_index(index) {
+		}
+		operator QDateTime() const {
+			return m_vector->at(m_index);
+		}
+		reference& operator=(const QDateTime& dateTime) {
+			m_vector->replace(m_index, dateTime);
+			return *this;
+		}
+		reference& operator=(const reference& other) {
+			return *this = static_cast<QDateTime>(other);
+		}
+
+	private:
+		DateTimeVector* m_vector;
+		qsizetype m_index;
+	};
+
+	class const_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = QDateTime;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const QDateTime*;
+		using reference = QDateTime;
+
+		const_iterator(const DateTimeVector* vector, qsizetype index)
+			: m_vector(vector)
+			, m_index(index) {
+		}
+		QDateTime operator*() const {
+			return m_vector->at(m_index);
+		}
+		const_iterator& operator++() {
+			++m_index;
+			return *this;
+		}
+		bool operator==(const const_iterator& other) const {
+			return m_index == other.m_index;
+		}
+		bool operator!=(const const_iterator& other) const {
+			return m_index != other.m_index;
+		}
+
+	private:
+		const DateTimeVector* m_vector;
+		qsizetype m_index;
+	};
+
+	DateTimeVector() = default;
+	explicit DateTimeVector(qsizetype size)
+		: m_values(size, InvalidValue) {
+	}
+	DateTimeVector(const QVector<QDateTime>& dateTimes) {
+		m_values.resize(dateTimes.size());
+		for (qsizetype i = 0; i < dateTimes.size(); ++i)
+			m_values[i] = toMSecs(dateTimes.at(i));
+	}
+
+	qsizetype size() const {
+		return m_values.size();
+	}
+	qsizetype count() const {
+		return m_values.size();
+	}
+	qsizetype length() const {
+		return m_values.size();
+	}
+	bool isEmpty() const {
+		return m_values.isEmpty();
+	}
+	qsizetype capacity() const {
+		return m_values.capacity();
+	}
+
+	QDateTime at(qsizetype i) const {
+		return toDateTime(m_values.at(i));
+	}
+	QDateTime value(qsizetype i) const {
+		if (i < 0 || i >= m_values.size())
+			return {};
+		return toDateTime(m_values.at(i));
+	}
+	QDateTime operator[](qsizetype i) const {
+		return at(i);
+	}
+	reference operator[](qsizetype i) {
+		return reference(this, i);
+	}
+	QDateTime first() const {
+		return at(0);
+	}
+	QDateTime last() const {
+		return at(m_values.size() - 1);
+	}
+	const_iterator begin() const {
+		return const_iterator(this, 0);
+	}
+	const_iterator end() const {
+		return const_iterator(this, m_values.size());
+	}
+
+	//! milliseconds since epoch of the value at \c i, \c InvalidValue for invalid date-times
+	qint64 msecsAt(qsizetype i) const {
+		return m_values.at(i);
+	}
+	bool isValid(qsizetype i) const {
+		return m_values.at(i) != InvalidValue;
+	}
+	const qint64* constData() const {
+		return m_values.constData();
+	}
+	qint64* data() {
+		return m_values.data();
+	}
+	const QVector<qint64>& msecs() const {
+		return m_values;
+	}
+
+	const QTimeZone& timeZone() const {
+		return m_timeZone;
+	}
+	void setTimeZone(const QTimeZone& timeZone) {
+		m_timeZone = timeZone;
+		m_timeZoneFixed = true;
+	}
+
+	void replace(qsizetype i, const QDateTime& dateTime) {
+		m_values[i] = toMSecs(dateTime);
+	}
+	void append(const QDateTime& dateTime) {
+		m_values.append(toMSecs(dateTime));
+	}
+	void push_back(const QDateTime& dateTime) {
+		append(dateTime);
+	}
+	void insert(qsizetype i, const QDateTime& dateTime) {
+		m_values.insert(i, toMSecs(dateTime));
+	}
+	void insert(qsizetype i, qsizetype n, const QDateTime& dateTime) {
+		m_values.insert(i, n, toMSecs(dateTime));
+	}
+	void remove(qsizetype i, qsizetype n = 1) {
+		m_values.remove(i, n);
+	}
+	void removeAt(qsizetype i) {
+		m_values.removeAt(i);
+	}
+	void resize(qsizetype size) {
+		m_values.resize(size, InvalidValue);
+	}
+	void reserve(qsizetype size) {
+		m_values.reserve(size);
+	}
+	void squeeze() {
+		m_values.squeeze();
+	}
+	void clear() {
+		m_values.clear();
+		m_timeZoneFixed = false;
+	}
+
+	QVector<QDateTime> mid(qsizetype pos, qsizetype length = -1) const {
+		pos = std::clamp(pos, qsizetype(0), m_values.size());
+		if (length < 0 || pos + length > m_values.size())
+			length = m_values.size() - pos;
+		QVector<QDateTime> dateTimes(length);
+		for (qsizetype i = 0; i < length; ++i)
+			dateTimes[i] = toDateTime(m_values.at(pos + i));
+		return dateTimes;
+	}
+	QVector<QDateTime> toVector() const {
+		return mid(0);
+	}
+
+	bool operator==(const DateTimeVector& other) const {
+		return m_values == other.m_values;
+	}
+	bool operator!=(const DateTimeVector& other) const {
+		return m_values != other.m_values;
+	}
+
+private:
+	qint64 toMSecs(const QDateTime& dateTime) {
+		if (!dateTime.isValid())
+			return InvalidValue;
+
+		// the first value determines the time zone of the container if it wasn't set explicitly,
+		// values in other time zones are converted and don't re-zone the values already stored
+		if (!m_timeZoneFixed) {
+			m_timeZone = dateTime.timeRepresentation();
+			m_timeZoneFixed = true;
+		}
+		return dateTime.toMSecsSinceEpoch();
+	}
+
+	QDateTime toDateTime(qint64 msecs) const {
+		if (msecs == InvalidValue)
+			return {};
+		return QDateTime::fromMSecsSinceEpoch(msecs, m_timeZone);
+	}
+
+	QVector<qint64> m_values;
+	QTimeZone m_timeZone{QTimeZone::UTC};
+	bool m_timeZoneFixed{false};
+};
+
+#endif // DATETIMEVECTOR_H
@@ -13,6 +13,7 @@
 #define INTERVALATTRIBUTE_H
 
 #include "Interval.h"
+#include "RowBitmap.h"
 #include <QVector>
 
 //! A class representing an interval-based attribute
@@ -150,18 +151,19 @@ public:
 	}
 	IntervalAttribute(const QVector<Interval<int>>& intervals)
 		: m_intervals(intervals) {
+		updateBitmap();
 	}
 
 	void setValue(const Interval<int>& i, bool value = true) {
 		if (value) {
-			for (const auto& iv : m_intervals)
-				if (iv.contains(i))
-					return;
+			if (isSet(i))
+				return;
 
 			Interval<int>::mergeIntervalIntoList(&m_intervals, i);
 		} else { // unset
 			Interval<int>::subtractIntervalFromList(&m_intervals, i);
 		}
+		m_bitmap.setRange(i.start(), i.end(), value);
 	}
 
 	void setValue(int row, bool value) {
@@ -169,17 +171,26 @@ public:
 	}
 
 	bool isSet(int row) const {
-		for (const auto& iv : m_intervals)
-			if (iv.contains(row))
-				return true;
-		return false;
+		return m_bitmap.test(row);
 	}
 
 	bool isSet(const Interval<int>& i) const {
-		for (const auto& iv : m_intervals)
-			if (iv.contains(i))
-				return true;
-		return false;
+		return i.start() >= 0 && m_bitmap.nextUnset(i.start()) > i.end();
+	}
+
+	//! \c true if no row is set
+	bool isEmpty() const {
+		return m_intervals.isEmpty();
+	}
+
+	//! first set row at or after \c row, \c RowBitmap::NoRow if there is none
+	int nextSet(int row) const {
+		return m_bitmap.nextSet(row);
+	}
+
+	//! first row at or after \c row that is not set
+	int nextUnset(int row) const {
+		return m_bitmap.nextUnset(row);
 	}
 
 	void insertRows(int before, int count) {
@@ -199,6 +210,7 @@ public:
 			if (m_intervals.at(c).start() >= before)
 				m_intervals[c].translate(count);
 		}
+		updateBitmap();
 	}
 
 	void removeRows(int first, int count) {
@@ -218,6 +230,7 @@ public:
 			if (size_before == m_intervals.size()) // merge successful
 				c--;
 		}
+		updateBitmap();
 	}
 
 	QVector<Interval<int>> intervals() const {
@@ -226,10 +239,19 @@ public:
 
 	void clear() {
 		m_intervals.clear();
+		m_bitmap.clear();
 	}
 
 private:
-	QVector<Interval<int>> m_intervals;
+	// the bitmap is rebuilt from the intervals after rows were inserted or removed
+	void updateBitmap() {
+		m_bitmap.clear();
+		for (const auto& iv : m_intervals)
+			m_bitmap.setRange(iv.start(), iv.end());
+	}
+
+	QVector<Interval<int>> m_intervals; // stored in the project and used for undo/redo
+	RowBitmap m_bitmap; // the same rows for the lookup of single rows
 };
 
 #endif
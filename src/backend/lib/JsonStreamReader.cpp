@@ -0,0 +1,501 @@
+/*
+	File                 : JsonStreamReader.cpp
+	Project              : LabPlot
+	Description          : Pull parser reading JSON documents token by token
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "backend/lib/JsonStreamReader.h"
+#include "backend/lib/ByteScanner.h"
+
+#include <KLocalizedString>
+
+#include <QIODevice>
+
+#include <cstring>
+
+namespace {
+// number of bytes read from the device at once
+constexpr qint64 BlockSize = 1024 * 1024;
+}
+
+/*!
+ * \class JsonStreamReader
+ * \brief Pull parser reading JSON documents token by token like \c QXmlStreamReader, without building a \c QJsonDocument.
+ *
+ * The data is read in blocks from the device and only the current token is kept. Arrays and objects are returned as start and end
+ * tokens, the values inside of objects have a key. With \c setJsonLines() the documents of JSON Lines data, i.e. documents separated
+ * by line ends, are returned as the elements of one array.
+ *
+ * If a sequential device has no more data in the middle of a token, \c readNext() returns \c TokenType::Invalid with the error
+ * \c Error::PrematureEndOfDocument and reads the token again in the next call, e.g. after more data was received.
+ */
+JsonStreamReader::JsonStreamReader(QIODevice* device)
+	: m_device(device) {
+	if (!device->isSequential())
+		m_bufferOffset = device->pos();
+}
+
+JsonStreamReader::JsonStreamReader(const QByteArray& data)
+	: m_buffer(data) {
+}
+
+/*!
+ * reads the data as JSON Lines if \c jsonLines is \c true, the documents are returned as the elements of an array.
+ * Needs to be set before the first token is read.
+ */
+void JsonStreamReader::setJsonLines(bool jsonLines) {
+	m_jsonLines = jsonLines;
+}
+
+bool JsonStreamReader::jsonLines() const {
+	return m_jsonLines;
+}
+
+/*!
+ * reads the next token and returns its type.
+ */
+JsonStreamReader::TokenType JsonStreamReader::readNext() {
+	if (m_error == Error::SyntaxError)
+		return TokenType::Invalid;
+	if (m_tokenType == TokenType::EndDocument)
+		return m_tokenType;
+
+	// the data of the previous tokens is not needed anymore
+	if (m_position >= BlockSize) {
+		m_buffer.remove(0, m_position);
+		m_bufferOffset += m_position;
+		m_position = 0;
+	}
+
+	m_error = Error::NoError;
+	m_errorString.clear();
+	const auto position = m_position;
+	m_tokenType = parseToken();
+	if (m_error == Error::PrematureEndOfDocument)
+		m_position = position; // the token is read again when more data is available
+	return m_tokenType;
+}
+
+/*!
+ * reads until the end of the array or object started by the current token. Nothing is read for other tokens.
+ * Returns \c false if an error occurred.
+ */
+bool JsonStreamReader::skipCurrentValue() {
+	if (m_tokenType != TokenType::StartArray && m_tokenType != TokenType::StartObject)
+		return !hasError();
+
+	const auto depth = m_stack.size();
+	while (m_stack.size() >= depth) {
+		if (readNext() == TokenType::Invalid)
+			return false;
+	}
+	return true;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::tokenType() const {
+	return m_tokenType;
+}
+
+/*!
+ * returns \c true if the end of the document was reached or if an error occurred.
+ */
+bool JsonStreamReader::atEnd() const {
+	return m_tokenType == TokenType::EndDocument || hasError();
+}
+
+bool JsonStreamReader::hasError() const {
+	return m_error != Error::NoError;
+}
+
+JsonStreamReader::Error JsonStreamReader::error() const {
+	return m_error;
+}
+
+QString JsonStreamReader::errorString() const {
+	return m_errorString;
+}
+
+/*!
+ * returns the position of the current token in the device, this is the position of the value and not of its key
+ * for values inside of objects.
+ */
+qint64 JsonStreamReader::offset() const {
+	return m_bufferOffset + m_valueStart;
+}
+
+/*!
+ * returns \c true if the current token is a value inside of an object or the start of an array or object inside of an object.
+ */
+bool JsonStreamReader::hasKey() const {
+	return m_hasKey;
+}
+
+/*!
+ * returns the key of the current value as in the document, i.e. UTF-8 encoded and with escape sequences.
+ * The data is only valid until the next token is read.
+ */
+QByteArrayView JsonStreamReader::rawKey() const {
+	if (!m_hasKey)
+		return {};
+	return QByteArrayView(m_buffer).sliced(m_keyStart, m_keyLength);
+}
+
+QString JsonStreamReader::key() const {
+	if (!m_hasKey)
+		return {};
+	return m_keyEscaped ? unescape(rawKey()) : QString::fromUtf8(rawKey());
+}
+
+/*!
+ * returns the text of strings, numbers and booleans.
+ */
+QString JsonStreamReader::text() const {
+	switch (m_tokenType) {
+	case TokenType::String: {
+		const auto raw = QByteArrayView(m_buffer).sliced(m_textStart, m_textLength);
+		return m_textEscaped ? unescape(raw) : QString::fromUtf8(raw);
+	}
+	case TokenType::Number:
+		return QString::fromLatin1(QByteArrayView(m_buffer).sliced(m_textStart, m_textLength));
+	case TokenType::Bool:
+		return toBool() ? QStringLiteral("true") : QStringLiteral("false");
+	case TokenType::NoToken:
+	case TokenType::Invalid:
+	case TokenType::StartArray:
+	case TokenType::EndArray:
+	case TokenType::StartObject:
+	case TokenType::EndObject:
+	case TokenType::Null:
+	case TokenType::EndDocument:
+		break;
+	}
+	return {};
+}
+
+/*!
+ * returns the value of numbers, NaN if the number is invalid and 0 for other tokens.
+ */
+double JsonStreamReader::toDouble() const {
+	if (m_tokenType != TokenType::Number)
+		return 0.;
+
+	bool ok;
+	const double value = m_numberParser.toDouble(QByteArrayView(m_buffer).sliced(m_textStart, m_textLength), &ok);
+	return ok ? value : qQNaN();
+}
+
+bool JsonStreamReader::toBool() const {
+	return m_tokenType == TokenType::Bool && m_buffer.at(m_valueStart) == 't';
+}
+
+/*!
+ * returns the value of strings, numbers, booleans and null, and an empty array or object for the start of arrays and objects.
+ */
+QJsonValue JsonStreamReader::value() const {
+	switch (m_tokenType) {
+	case TokenType::String:
+		return text();
+	case TokenType::Number:
+		return toDouble();
+	case TokenType::Bool:
+		return toBool();
+	case TokenType::Null:
+		return QJsonValue(QJsonValue::Null);
+	case TokenType::StartArray:
+		return QJsonValue(QJsonValue::Array);
+	case TokenType::StartObject:
+		return QJsonValue(QJsonValue::Object);
+	case TokenType::NoToken:
+	case TokenType::Invalid:
+	case TokenType::EndArray:
+	case TokenType::EndObject:
+	case TokenType::EndDocument:
+		break;
+	}
+	return QJsonValue(QJsonValue::Undefined);
+}
+
+/*!
+ * appends the next block of data of the device to the buffer, returns \c false if no data was read.
+ */
+bool JsonStreamReader::fill() {
+	if (!m_device)
+		return false;
+
+	const auto size = m_buffer.size();
+	m_buffer.resize(size + BlockSize);
+	const qint64 bytes = m_device->read(m_buffer.data() + size, BlockSize);
+	m_buffer.resize(size + std::max(bytes, qint64(0)));
+	return bytes > 0;
+}
+
+/*!
+ * returns \c true if more data can be received although the device has no data now.
+ */
+bool JsonStreamReader::moreDataPossible() const {
+	return m_device && m_device->isSequential() && m_device->isOpen();
+}
+
+/*!
+ * skips the whitespaces, returns \c false if there is no more data afterwards.
+ */
+bool JsonStreamReader::skipWhitespace() {
+	do {
+		while (m_position < m_buffer.size()) {
+			const char c = m_buffer.at(m_position);
+			if (c != ' ' && c != '\n' && c != '\r' && c != '\t')
+				return true;
+			++m_position;
+		}
+	} while (fill());
+	return false;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::parseToken() {
+	m_hasKey = false;
+
+	if (m_stack.empty()) {
+		if (m_started) {
+			// only whitespaces are allowed after the document
+			if (skipWhitespace())
+				return raiseError(Error::SyntaxError, i18n("unexpected data after the end of the document"));
+			m_valueStart = m_position;
+			return TokenType::EndDocument;
+		}
+		if (m_jsonLines) {
+			m_stack.push_back('L');
+			m_first = true;
+			m_started = true;
+			m_valueStart = m_position;
+			return TokenType::StartArray;
+		}
+		if (!skipWhitespace())
+			return raiseError(Error::PrematureEndOfDocument);
+		return parseValue();
+	}
+
+	const char container = m_stack.back();
+	const bool data = skipWhitespace();
+	if (container == 'L') {
+		// the documents of JSON Lines are separated by whitespaces, usually by line ends
+		if (data)
+			return parseValue();
+		if (moreDataPossible())
+			return raiseError(Error::PrematureEndOfDocument);
+		m_stack.pop_back();
+		m_first = false;
+		m_valueStart = m_position;
+		return TokenType::EndArray;
+	}
+	if (!data)
+		return raiseError(Error::PrematureEndOfDocument);
+
+	const char closing = container == '[' ? ']' : '}';
+	if (m_buffer.at(m_position) == closing) {
+		m_valueStart = m_position++;
+		m_stack.pop_back();
+		m_first = false;
+		return container == '[' ? TokenType::EndArray : TokenType::EndObject;
+	}
+	if (!m_first) {
+		if (m_buffer.at(m_position) != ',')
+			return raiseError(Error::SyntaxError, i18n("missing '%1' or ','", QLatin1Char(closing)));
+		++m_position;
+		if (!skipWhitespace())
+			return raiseError(Error::PrematureEndOfDocument);
+	}
+
+	if (container == '{') {
+		if (m_buffer.at(m_position) != '"')
+			return raiseError(Error::SyntaxError, i18n("missing key"));
+		if (!parseString(m_keyStart, m_keyLength, m_keyEscaped))
+			return TokenType::Invalid;
+		if (!skipWhitespace())
+			return raiseError(Error::PrematureEndOfDocument);
+		if (m_buffer.at(m_position) != ':')
+			return raiseError(Error::SyntaxError, i18n("missing ':'"));
+		++m_position;
+		if (!skipWhitespace())
+			return raiseError(Error::PrematureEndOfDocument);
+		m_hasKey = true;
+	}
+
+	return parseValue();
+}
+
+/*!
+ * parses the value starting at the current position, the state is only changed if the value is complete.
+ */
+JsonStreamReader::TokenType JsonStreamReader::parseValue() {
+	const auto start = m_position;
+	const char c = m_buffer.at(m_position);
+	TokenType type;
+	switch (c) {
+	case '[':
+		++m_position;
+		type = TokenType::StartArray;
+		break;
+	case '{':
+		++m_position;
+		type = TokenType::StartObject;
+		break;
+	case '"':
+		if (!parseString(m_textStart, m_textLength, m_textEscaped))
+			return TokenType::Invalid;
+		type = TokenType::String;
+		break;
+	case 't':
+		if (!parseLiteral("true", 4))
+			return TokenType::Invalid;
+		type = TokenType::Bool;
+		break;
+	case 'f':
+		if (!parseLiteral("false", 5))
+			return TokenType::Invalid;
+		type = TokenType::Bool;
+		break;
+	case 'n':
+		if (!parseLiteral("null", 4))
+			return TokenType::Invalid;
+		type = TokenType::Null;
+		break;
+	default: {
+		if (c != '-' && (c < '0' || c > '9'))
+			return raiseError(Error::SyntaxError, i18n("unexpected character '%1'", QLatin1Char(c)));
+
+		// the syntax of the number is checked when converting it
+		qsizetype end = m_position + 1;
+		while (end < m_buffer.size() || fill()) {
+			const char d = m_buffer.at(end);
+			if ((d < '0' || d > '9') && d != '.' && d != 'e' && d != 'E' && d != '-' && d != '+')
+				break;
+			++end;
+		}
+		if (end == m_buffer.size() && moreDataPossible())
+			return raiseError(Error::PrematureEndOfDocument);
+		m_textStart = m_position;
+		m_textLength = end - m_position;
+		m_position = end;
+		type = TokenType::Number;
+	}
+	}
+
+	m_valueStart = start;
+	if (type == TokenType::StartArray || type == TokenType::StartObject) {
+		m_stack.push_back(c);
+		m_first = true;
+	} else
+		m_first = false;
+	m_started = true;
+	return type;
+}
+
+/*!
+ * parses the string starting with the quote at the current position, \c start and \c length are set to the characters
+ * between the quotes in the buffer.
+ */
+bool JsonStreamReader::parseString(qsizetype& start, qsizetype& length, bool& escaped) {
+	qsizetype end = m_position + 1;
+	escaped = false;
+	while (true) {
+		const char* data = m_buffer.constData();
+		end = ByteScanner::findAny(data + end, data + m_buffer.size(), '"', '\\', '"', '"') - data;
+		if (end < m_buffer.size()) {
+			if (m_buffer.at(end) == '"')
+				break;
+			// the character after the backslash is skipped, escaped quotes don't end the string
+			escaped = true;
+			if (end + 1 < m_buffer.size()) {
+				end += 2;
+				continue;
+			}
+		}
+		if (!fill()) {
+			raiseError(Error::PrematureEndOfDocument);
+			return false;
+		}
+	}
+
+	start = m_position + 1;
+	length = end - start;
+	m_position = end + 1;
+	return true;
+}
+
+bool JsonStreamReader::parseLiteral(const char* literal, qsizetype length) {
+	while (m_buffer.size() - m_position < length && fill()) { }
+
+	const auto available = std::min(m_buffer.size() - m_position, length);
+	if (std::memcmp(m_buffer.constData() + m_position, literal, available) != 0) {
+		raiseError(Error::SyntaxError, i18n("invalid literal"));
+		return false;
+	}
+	if (available < length) {
+		raiseError(Error::PrematureEndOfDocument);
+		return false;
+	}
+
+	m_position += length;
+	return true;
+}
+
+JsonStreamReader::TokenType JsonStreamReader::raiseError(Error error, const QString& message) {
+	m_error = error;
+	if (error == Error::PrematureEndOfDocument)
+		m_errorString = i18n("Premature end of the JSON document.");
+	else
+		m_errorString = i18n("JSON syntax error at offset %1: %2", m_bufferOffset + m_position, message);
+	return TokenType::Invalid;
+}
+
+/*!
+ * returns the string \c raw with the escape sequences replaced by the characters.
+ */
+QString JsonStreamReader::unescape(QByteArrayView raw) {
+	QString result;
+	result.reserve(raw.size());
+	qsizetype start = 0;
+	for (qsizetype i = 0; i < raw.size() - 1; ++i) {
+		if (raw.at(i) != '\\')
+			continue;
+
+		result += QString::fromUtf8(raw.sliced(start, i - start));
+		const char c = raw.at(++i);
+		switch (c) {
+		case 'b':
+			result += QLatin1Char('\b');
+			break;
+		case 'f':
+			result += QLatin1Char('\f');
+			break;
+		case 'n':
+			result += QLatin1Char('\n');
+			break;
+		case 'r':
+			result += QLatin1Char('\r');
+			break;
+		case 't':
+			result += QLatin1Char('\t');
+			break;
+		case 'u': {
+			// UTF-16 code unit, characters outside of the BMP are written as two escaped surrogates
+			bool ok = false;
+			const ushort code = i + 4 < raw.size() ? raw.sliced(i + 1, 4).toUShort(&ok, 16) : 0;
+			if (ok) {
+				result += QChar(code);
+				i += 4;
+			} else
+				result += QLatin1Char(c);
+			break;
+		}
+		default: // '"', '\\' and '/'
+			result += QLatin1Char(c);
+		}
+		start = i + 1;
+	}
+	result += QString::fromUtf8(raw.sliced(start));
+	return result;
+}
@@ -0,0 +1,86 @@
+/*
+	File                 : JsonStreamReader.h
+	Project              : LabPlot
+	Description          : Pull parser reading JSON documents token by token
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef JSONSTREAMREADER_H
+#define JSONSTREAMREADER_H
+
+#include "backend/lib/ValueParser.h"
+
+#include <QByteArray>
+#include <QJsonValue>
+#include <QString>
+
+#include <vector>
+
+class QIODevice;
+
+class JsonStreamReader {
+public:
+	enum class TokenType { NoToken, Invalid, StartArray, EndArray, StartObject, EndObject, String, Number, Bool, Null, EndDocument };
+	enum class Error { NoError, SyntaxError, PrematureEndOfDocument };
+
+	explicit JsonStreamReader(QIODevice* device);
+	explicit JsonStreamReader(const QByteArray& data);
+
+	void setJsonLines(bool);
+	bool jsonLines() const;
+
+	TokenType readNext();
+	bool skipCurrentValue();
+
+	TokenType tokenType() const;
+	bool atEnd() const;
+	bool hasError() const;
+	Error error() const;
+	QString errorString() const;
+	qint64 offset() const;
+
+	bool hasKey() const;
+	QByteArrayView rawKey() const;
+	QString key() const;
+	QString text() const;
+	double toDouble() const;
+	bool toBool() const;
+	QJsonValue value() const;
+
+private:
+	bool fill();
+	bool moreDataPossible() const;
+	bool skipWhitespace();
+	TokenType parseToken();
+	TokenType parseValue();
+	bool parseString(qsizetype& start, qsizetype& length, bool& escaped);
+	bool parseLiteral(const char* literal, qsizetype length);
+	TokenType raiseError(Error, const QString& message = QString());
+	static QString unescape(QByteArrayView);
+
+	QIODevice* m_device{nullptr};
+	QByteArray m_buffer;
+	qsizetype m_position{0}; // position of the next byte to parse in m_buffer
+	qint64 m_bufferOffset{0}; // offset of the first byte of m_buffer in the device
+	std::vector<char> m_stack; // open arrays ('['), objects ('{') and the array of the JSON Lines documents ('L')
+	bool m_first{false}; // no element was read yet in the innermost open container
+	bool m_started{false}; // the top-level value was started
+	bool m_jsonLines{false};
+
+	TokenType m_tokenType{TokenType::NoToken};
+	Error m_error{Error::NoError};
+	QString m_errorString;
+	qsizetype m_valueStart{0};
+	qsizetype m_textStart{0};
+	qsizetype m_textLength{0};
+	bool m_textEscaped{false};
+	bool m_hasKey{false};
+	qsizetype m_keyStart{0};
+	qsizetype m_keyLength{0};
+	bool m_keyEscaped{false};
+	NumberParser m_numberParser;
+};
+
+#endif // JSONSTREAMREADER_H
@@ -0,0 +1,311 @@
+/*
+	File                 : MatrixStorage.h
+	Project              : LabPlot
+	Description          : Contiguous storage of the values of a matrix
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef MATRIXSTORAGE_H
+#define MATRIXSTORAGE_H
+
+#include <QVector>
+
+#include <algorithm>
+#include <new>
+#include <vector>
+
+/*!
+ * \brief Allocator returning memory aligned to \c Alignment bytes, e.g. to the size of a cache line.
+ */
+template<typename T, std::size_t Alignment = 64>
+class AlignedAllocator {
+public:
+	using value_type = T;
+
+	template<typename U>
+	struct rebind {
+		using other = AlignedAllocator<U, Alignment>;
+	};
+
+	AlignedAllocator() = default;
+	template<typename U>
+	AlignedAllocator(const AlignedAllocator<U, Alignment>&) {
+	}
+
+	T* allocate(std::size_t n) {
+		return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t(Alignment)));
+	}
+	void deallocate(T* p, std::size_t) {
+		::operator delete(p, std::align_val_t(Alignment));
+	}
+
+	template<typename U>
+	bool operator==(const AlignedAllocator<U, Alignment>&) const {
+		return true;
+	}
+	template<typename U>
+	bool operator!=(const AlignedAllocator<U, Alignment>&) const {
+		return false;
+	}
+};
+
+/*!
+ * \brief Values of a matrix in one contiguous, aligned buffer.
+ *
+ * This is the data container of Matrix. The values are stored column by column (\c ColumnMajor, the default)
+ * or row by row (\c RowMajor), so the values of a column respectively of a row are contiguous in memory.
+ * \c column() and \c row() return views on the values of a column or a row without copying them,
+ * the view of the other direction steps through the buffer with a stride.
+ */
+template<typename T>
+class MatrixStorage {
+public:
+	enum class Layout { ColumnMajor, RowMajor };
+	using Buffer = std::vector<T, AlignedAllocator<T>>;
+
+	//! view on the values of one row or column, \c V is \c T or \c const \c T
+	template<typename V>
+	class StridedView {
+	public:
+		StridedView(V* data, qsizetype size, qsizetype stride)
+			: m_data(data)
+			, m_size(size)
+			, m_stride(stride) {
+		}
+
+		qsizetype size() const {
+			return m_size;
+		}
+		qsizetype stride() const {
+			return m_stride;
+		}
+		//! \c true if the values are next to each other in memory, \c data() can then be used as an array
+		bool isContiguous() const {
+			return m_stride == 1 || m_size < 2;
+		}
+		V* data() const {
+			return m_data;
+		}
+		V& operator[](qsizetype i) const {
+			return m_data[i * m_stride];
+		}
+		const T& at(qsizetype i) const {
+			return m_data[i * m_stride];
+		}
+
+		QVector<T> toVector() const {
+			QVector<T> values;
+			values.reserve(m_size);
+			for (qsizetype i = 0; i < m_size; ++i)
+				values << at(i);
+			return values;
+		}
+
+	private:
+		V* m_data;
+		qsizetype m_size;
+		qsizetype m_stride;
+	};
+	using View = StridedView<T>;
+	using ConstView = StridedView<const T>;
+
+	explicit MatrixStorage(Layout layout = Layout::ColumnMajor)
+		: m_layout(layout) {
+	}
+	MatrixStorage(int rows, int columns, Layout layout = Layout::ColumnMajor)
+		: m_values((std::size_t)rows * columns, T())
+		, m_rows(rows)
+		, m_columns(columns)
+		, m_layout(layout) {
+	}
+
+	int rowCount() const {
+		return m_rows;
+	}
+	int columnCount() const {
+		return m_columns;
+	}
+	qsizetype size() const {
+		return m_values.size();
+	}
+	bool isEmpty() const {
+		return m_values.empty();
+	}
+	Layout layout() const {
+		return m_layout;
+	}
+
+	T* data() {
+		return m_values.data();
+	}
+	const T* constData() const {
+		return m_values.data();
+	}
+
+	//! position of the cell (\c row, \c column) in the buffer
+	qsizetype index(int row, int column) const {
+		if (m_layout == Layout::ColumnMajor)
+			return (qsizetype)column * m_rows + row;
+		return (qsizetype)row * m_columns + column;
+	}
+	const T& at(int row, int column) const {
+		return m_values[index(row, column)];
+	}
+	T& operator()(int row, int column) {
+		return m_values[index(row, column)];
+	}
+
+	View column(int column) {
+		return m_layout == Layout::ColumnMajor ? View(data() + (qsizetype)column * m_rows, m_rows, 1) : View(data() + column, m_rows, m_columns);
+	}
+	ConstView column(int column) const {
+		return m_layout == Layout::ColumnMajor ? ConstView(constData() + (qsizetype)column * m_rows, m_rows, 1)
+											   : ConstView(constData() + column, m_rows, m_columns);
+	}
+	View row(int row) {
+		return m_layout == Layout::RowMajor ? View(data() + (qsizetype)row * m_columns, m_columns, 1) : View(data() + row, m_columns, m_rows);
+	}
+	ConstView row(int row) const {
+		return m_layout == Layout::RowMajor ? ConstView(constData() + (qsizetype)row * m_columns, m_columns, 1)
+											: ConstView(constData() + row, m_columns, m_rows);
+	}
+
+	void fill(const T& value) {
+		std::fill(m_values.begin(), m_values.end(), value);
+	}
+	void fillColumn(int column, const T& value) {
+		auto view = this->column(column);
+		for (qsizetype i = 0; i < view.size(); ++i)
+			view[i] = value;
+	}
+	void clear() {
+		m_values.clear();
+		m_rows = 0;
+		m_columns = 0;
+	}
+
+	//! changes the size to \c rows x \c columns keeping the values of the cells that are still present
+	void resize(int rows, int columns) {
+		rebuild(rows, columns, identity, identity);
+	}
+
+	void insertColumns(int before, int count) {
+		if (m_layout == Layout::ColumnMajor) {
+			// the columns are contiguous, insert them in place
+			m_values.insert(m_values.begin() + (qsizetype)before * m_rows, (std::size_t)count * m_rows, T());
+			m_columns += count;
+			return;
+		}
+		rebuild(m_rows, m_columns + count, identity, [before, count](int column) {
+			return column < before ? column : (column < before + count ? -1 : column - count);
+		});
+	}
+	void removeColumns(int first, int count) {
+		if (m_layout == Layout::ColumnMajor) {
+			const auto begin = m_values.begin() + (qsizetype)first * m_rows;
+			m_values.erase(begin, begin + (qsizetype)count * m_rows);
+			m_columns -= count;
+			return;
+		}
+		rebuild(m_rows, m_columns - count, identity, [first, count](int column) {
+			return column < first ? column : column + count;
+		});
+	}
+	void insertRows(int before, int count) {
+		if (m_layout == Layout::RowMajor) {
+			m_values.insert(m_values.begin() + (qsizetype)before * m_columns, (std::size_t)count * m_columns, T());
+			m_rows += count;
+			return;
+		}
+		rebuild(m_rows + count, m_columns, [before, count](int row) {
+			return row < before ? row : (row < before + count ? -1 : row - count);
+		}, identity);
+	}
+	void removeRows(int first, int count) {
+		if (m_layout == Layout::RowMajor) {
+			const auto begin = m_values.begin() + (qsizetype)first * m_columns;
+			m_values.erase(begin, begin + (qsizetype)count * m_columns);
+			m_rows -= count;
+			return;
+		}
+		rebuild(m_rows - count, m_columns, [first, count](int row) {
+			return row < first ? row : row + count;
+		}, identity);
+	}
+
+	//! reorders the values in the buffer for the new layout, the values of the cells don't change
+	void setLayout(Layout layout) {
+		if (layout == m_layout)
+			return;
+		Buffer values(m_values.size());
+		for (int column = 0; column < m_columns; ++column)
+			for (int row = 0; row < m_rows; ++row)
+				values[layout == Layout::ColumnMajor ? (qsizetype)column * m_rows + row : (qsizetype)row * m_columns + column] =
+					std::move(m_values[index(row, column)]);
+		m_values.swap(values);
+		m_layout = layout;
+	}
+
+	/*!
+	 * swaps rows and columns. Only the dimensions and the layout are swapped, the buffer is not touched:
+	 * the column-major buffer of a matrix is the row-major buffer of its transpose.
+	 */
+	void transpose() {
+		std::swap(m_rows, m_columns);
+		m_layout = (m_layout == Layout::ColumnMajor) ? Layout::RowMajor : Layout::ColumnMajor;
+	}
+
+	bool operator==(const MatrixStorage& other) const {
+		if (m_rows != other.m_rows || m_columns != other.m_columns)
+			return false;
+		if (m_layout == other.m_layout)
+			return m_values == other.m_values;
+		for (int column = 0; column < m_columns; ++column)
+			for (int row = 0; row < m_rows; ++row)
+				if (!(at(row, column) == other.at(row, column)))
+					return false;
+		return true;
+	}
+	bool operator!=(const MatrixStorage& other) const {
+		return !(*this == other);
+	}
+
+private:
+	static int identity(int i) {
+		return i;
+	}
+
+	/*!
+	 * creates a new buffer with \c rows x \c columns cells. The cell (row, column) of the new buffer
+	 * gets the value of the cell (sourceRow(row), sourceColumn(column)), cells with a source outside of
+	 * the current dimensions are default initialized.
+	 */
+	template<typename RowMap, typename ColumnMap>
+	void rebuild(int rows, int columns, RowMap sourceRow, ColumnMap sourceColumn) {
+		Buffer values((std::size_t)rows * columns, T());
+		for (int column = 0; column < columns; ++column) {
+			const int oldColumn = sourceColumn(column);
+			if (oldColumn < 0 || oldColumn >= m_columns)
+				continue;
+			for (int row = 0; row < rows; ++row) {
+				const int oldRow = sourceRow(row);
+				if (oldRow < 0 || oldRow >= m_rows)
+					continue;
+				const qsizetype i = (m_layout == Layout::ColumnMajor) ? (qsizetype)column * rows + row : (qsizetype)row * columns + column;
+				values[i] = std::move(m_values[index(oldRow, oldColumn)]);
+			}
+		}
+		m_values.swap(values);
+		m_rows = rows;
+		m_columns = columns;
+	}
+
+	Buffer m_values;
+	int m_rows{0};
+	int m_columns{0};
+	Layout m_layout;
+};
+
+#endif // MATRIXSTORAGE_H
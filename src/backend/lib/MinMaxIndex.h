@@ -0,0 +1,207 @@
+/*
+	File                 : MinMaxIndex.h
+	Project              : LabPlot
+	Description          : Index of block minima and maxima for range queries
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef MINMAXINDEX_H
+#define MINMAXINDEX_H
+
+#include "backend/lib/Parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+/*!
+ * \brief Pyramid of block minima and maxima to determine the minimum and the maximum of a range of rows in O(log n).
+ *
+ * Level 0 stores the minimum and the maximum of every block of \c BlockSize rows, every higher level
+ * summarizes \c BlockSize entries of the level below. A query only scans the partial blocks at the
+ * borders of the range on every level.
+ *
+ * The values are provided by a callable \c value(row) returning the value of the row or NAN for rows to ignore
+ * (e.g. invalid or masked rows). Changed and appended rows are updated with \c update() in O(changed rows + log n).
+ */
+class MinMaxIndex {
+public:
+	static constexpr int BlockSize = 64;
+
+	bool isBuilt() const {
+		return m_built;
+	}
+	int rowCount() const {
+		return m_rowCount;
+	}
+	void clear() {
+		m_levels.clear();
+		m_rowCount = 0;
+		m_built = false;
+	}
+
+	/*!
+	 * builds the index for the rows [0, rowCount).
+	 */
+	template<typename Value>
+	void build(int rowCount, Value value) {
+		m_rowCount = rowCount;
+		m_built = true;
+		resizeLevels();
+		if (m_levels.empty())
+			return;
+
+		auto& leaves = m_levels.front();
+		Parallel::forRanges((int)leaves.min.size(), 1024, [&](int start, int end) {
+			for (int i = start; i < end; ++i)
+				updateLeaf(i, value);
+		});
+		for (size_t level = 1; level < m_levels.size(); ++level)
+			updateNodes(level, 0, m_levels.at(level).min.size() - 1);
+	}
+
+	/*!
+	 * updates the index after the rows [first, last] were changed and the number of rows changed to \c rowCount.
+	 * Appended rows are updated in any case, the index is rebuilt if rows were removed.
+	 */
+	template<typename Value>
+	void update(int first, int last, int rowCount, Value value) {
+		if (!m_built || rowCount < m_rowCount) {
+			build(rowCount, value);
+			return;
+		}
+
+		if (rowCount > m_rowCount) {
+			first = std::min(first, m_rowCount);
+			last = rowCount - 1;
+			m_rowCount = rowCount;
+			resizeLevels();
+		}
+		first = std::max(first, 0);
+		last = std::min(last, m_rowCount - 1);
+		if (first > last)
+			return;
+
+		int lo = first / BlockSize;
+		int hi = last / BlockSize;
+		for (int i = lo; i <= hi; ++i)
+			updateLeaf(i, value);
+		for (size_t level = 1; level < m_levels.size(); ++level) {
+			lo /= BlockSize;
+			hi /= BlockSize;
+			updateNodes(level, lo, hi);
+		}
+	}
+
+	/*!
+	 * determines the minimum and the maximum of the rows [start, end].
+	 * \c min and \c max are set to INFINITY and -INFINITY if there is no value in the range.
+	 */
+	template<typename Value>
+	void minMax(int start, int end, Value value, double& min, double& max) const {
+		min = INFINITY;
+		max = -INFINITY;
+		int a = std::max(start, 0);
+		int b = std::min(end, m_rowCount - 1);
+		if (a > b)
+			return;
+
+		// level -1 are the rows
+		int level = -1;
+		while (level + 1 < (int)m_levels.size() && b - a + 1 >= 2 * BlockSize) {
+			// entries of the next level which are completely inside of the range
+			const int nextA = (a + BlockSize - 1) / BlockSize;
+			const int nextB = (b + 1) / BlockSize - 1;
+			scan(level, a, nextA * BlockSize - 1, value, min, max);
+			scan(level, (nextB + 1) * BlockSize, b, value, min, max);
+			++level;
+			a = nextA;
+			b = nextB;
+		}
+		scan(level, a, b, value, min, max);
+	}
+
+private:
+	struct Level {
+		std::vector<double> min;
+		std::vector<double> max;
+	};
+
+	void resizeLevels() {
+		size_t size = (m_rowCount + BlockSize - 1) / BlockSize;
+		size_t level = 0;
+		while (size > 0) {
+			if (level == m_levels.size())
+				m_levels.push_back(Level());
+			m_levels[level].min.resize(size);
+			m_levels[level].max.resize(size);
+			++level;
+			if (size == 1)
+				break;
+			size = (size + BlockSize - 1) / BlockSize;
+		}
+		m_levels.resize(level);
+	}
+
+	template<typename Value>
+	void updateLeaf(int leaf, Value value) {
+		double min = INFINITY;
+		double max = -INFINITY;
+		const int end = std::min((leaf + 1) * BlockSize, m_rowCount);
+		for (int row = leaf * BlockSize; row < end; ++row) {
+			const double v = value(row);
+			// comparisons with NAN are false, ignored rows are skipped this way
+			if (v < min)
+				min = v;
+			if (v > max)
+				max = v;
+		}
+		m_levels[0].min[leaf] = min;
+		m_levels[0].max[leaf] = max;
+	}
+
+	void updateNodes(size_t level, int first, int last) {
+		const auto& below = m_levels.at(level - 1);
+		auto& current = m_levels[level];
+		const int belowSize = below.min.size();
+		for (int node = first; node <= last; ++node) {
+			double min = INFINITY;
+			double max = -INFINITY;
+			const int end = std::min((node + 1) * BlockSize, belowSize);
+			for (int i = node * BlockSize; i < end; ++i) {
+				min = std::min(min, below.min.at(i));
+				max = std::max(max, below.max.at(i));
+			}
+			current.min[node] = min;
+			current.max[node] = max;
+		}
+	}
+
+	template<typename Value>
+	void scan(int level, int a, int b, Value value, double& min, double& max) const {
+		if (level < 0) {
+			for (int row = a; row <= b; ++row) {
+				const double v = value(row);
+				if (v < min)
+					min = v;
+				if (v > max)
+					max = v;
+			}
+			return;
+		}
+
+		const auto& entries = m_levels.at(level);
+		for (int i = a; i <= b; ++i) {
+			min = std::min(min, entries.min.at(i));
+			max = std::max(max, entries.max.at(i));
+		}
+	}
+
+	std::vector<Level> m_levels;
+	int m_rowCount{0};
+	bool m_built{false};
+};
+
+#endif // MINMAXINDEX_H
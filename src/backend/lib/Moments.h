@@ -0,0 +1,175 @@
+/*
+	File                 : Moments.h
+	Project              : LabPlot
+	Description          : Numerically stable one-pass moments of a data set
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef MOMENTS_H
+#define MOMENTS_H
+
+#include <cmath>
+
+/*!
+ * \brief Sum with compensation of the rounding errors (Kahan-Babuska-Neumaier summation).
+ *
+ * Non-finite values are added without compensation, the sum is infinite or NaN then as for a plain sum.
+ */
+class KahanSum {
+public:
+	void add(double value) {
+		const double sum = m_sum + value;
+		if (!std::isfinite(sum)) {
+			m_sum = sum;
+			return;
+		}
+		if (std::abs(m_sum) >= std::abs(value))
+			m_compensation += (m_sum - sum) + value;
+		else
+			m_compensation += (value - sum) + m_sum;
+		m_sum = sum;
+	}
+	void add(const KahanSum& other) {
+		add(other.m_sum);
+		m_compensation += other.m_compensation;
+	}
+	double value() const {
+		return std::isfinite(m_sum) ? m_sum + m_compensation : m_sum;
+	}
+
+private:
+	double m_sum{0.};
+	double m_compensation{0.};
+};
+
+/*!
+ * \brief Count, extrema, sums and central moments up to the fourth order of a data set, calculated in one pass.
+ *
+ * The central moments are updated for every value with the formulas of Welford and Terriberry, which don't
+ * suffer from the cancellation of the textbook formulas. Moments of different parts of the data set can be
+ * combined with \c add(const Moments&) (Chan et al., Pébay), so the parts can be processed in parallel and
+ * values appended to the data set only need to be added to the moments calculated before.
+ */
+class Moments {
+public:
+	void add(double x) {
+		const double n1 = m_count;
+		++m_count;
+		const double n = m_count;
+		const double delta = x - m_mean;
+		const double deltaN = delta / n;
+		const double deltaN2 = deltaN * deltaN;
+		const double term = delta * deltaN * n1;
+		m_mean += deltaN;
+		m_m4 += term * deltaN2 * (n * n - 3. * n + 3.) + 6. * deltaN2 * m_m2 - 4. * deltaN * m_m3;
+		m_m3 += term * deltaN * (n - 2.) - 3. * deltaN * m_m2;
+		m_m2 += term;
+
+		if (x < m_minimum)
+			m_minimum = x;
+		if (x > m_maximum)
+			m_maximum = x;
+		m_sum.add(x);
+		m_sumInverse.add(1. / x); // infinite for x == 0
+		m_sumSquare.add(x * x);
+		if (x > 0.)
+			m_sumLog.add(std::log(x));
+		if (x > -100.)
+			m_sumLogPercentage.add(std::log1p(x / 100.));
+	}
+
+	//! adds the values of another data set
+	void add(const Moments& other) {
+		if (other.m_count == 0)
+			return;
+		if (m_count == 0) {
+			*this = other;
+			return;
+		}
+
+		const double na = m_count;
+		const double nb = other.m_count;
+		const double n = na + nb;
+		const double delta = other.m_mean - m_mean;
+		const double delta2 = delta * delta;
+		m_m4 += other.m_m4 + delta2 * delta2 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+			+ 6. * delta2 * (na * na * other.m_m2 + nb * nb * m_m2) / (n * n) + 4. * delta * (na * other.m_m3 - nb * m_m3) / n;
+		m_m3 += other.m_m3 + delta2 * delta * na * nb * (na - nb) / (n * n) + 3. * delta * (na * other.m_m2 - nb * m_m2) / n;
+		m_m2 += other.m_m2 + delta2 * na * nb / n;
+		m_mean += delta * nb / n;
+		m_count += other.m_count;
+
+		if (other.m_minimum < m_minimum)
+			m_minimum = other.m_minimum;
+		if (other.m_maximum > m_maximum)
+			m_maximum = other.m_maximum;
+		m_sum.add(other.m_sum);
+		m_sumInverse.add(other.m_sumInverse);
+		m_sumSquare.add(other.m_sumSquare);
+		m_sumLog.add(other.m_sumLog);
+		m_sumLogPercentage.add(other.m_sumLogPercentage);
+	}
+
+	long long count() const {
+		return m_count;
+	}
+	double minimum() const {
+		return m_minimum;
+	}
+	double maximum() const {
+		return m_maximum;
+	}
+	double mean() const {
+		return m_mean;
+	}
+	double sum() const {
+		return m_sum.value();
+	}
+	double sumInverse() const {
+		return m_sumInverse.value();
+	}
+	double sumSquare() const {
+		return m_sumSquare.value();
+	}
+	//! sum of the logarithms of the positive values
+	double sumLog() const {
+		return m_sumLog.value();
+	}
+	//! sum of log(1 + x/100) of the values larger than -100, the values are interpreted as percentages
+	double sumLogPercentage() const {
+		return m_sumLogPercentage.value();
+	}
+
+	//! central moments divided by the count
+	double centralMoment2() const {
+		return m_m2 / m_count;
+	}
+	double centralMoment3() const {
+		return m_m3 / m_count;
+	}
+	double centralMoment4() const {
+		return m_m4 / m_count;
+	}
+	//! sample variance
+	double variance() const {
+		return (m_count > 1) ? m_m2 / (m_count - 1) : NAN;
+	}
+
+private:
+	long long m_count{0};
+	double m_mean{0.};
+	double m_m2{0.}; // sums of the powers of the deviations from the mean
+	double m_m3{0.};
+	double m_m4{0.};
+	double m_minimum{INFINITY};
+	double m_maximum{-INFINITY};
+	KahanSum m_sum;
+	KahanSum m_sumInverse;
+	KahanSum m_sumSquare;
+	KahanSum m_sumLog;
+	KahanSum m_sumLogPercentage;
+};
+
+#endif // MOMENTS_H
@@ -0,0 +1,157 @@
+/*
+	File                 : MonotonicityIndex.h
+	Project              : LabPlot
+	Description          : Monotonicity of the rows of a column tracked per block of rows
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef MONOTONICITYINDEX_H
+#define MONOTONICITYINDEX_H
+
+#include "backend/lib/Parallel.h"
+
+#include <algorithm>
+#include <vector>
+
+/*!
+ * \brief Determines whether the values of a column are constant, increasing or decreasing.
+ *
+ * For every block of \c BlockSize rows the index stores whether the block contains an invalid row and whether
+ * the value increases or decreases from one row to the next one, including the step from the last row of the
+ * previous block. The number of blocks with these flags is kept, so the monotonicity of all rows is known in O(1).
+ *
+ * Changed and appended rows are updated with \c update() in O(changed rows + BlockSize), e.g. rows appended
+ * to a live data column are only compared with the last row before them instead of scanning the whole column.
+ *
+ * The rows are accessed via the callables \c compare(a, b), returning a negative value, zero or a positive value
+ * if the value of the row \c a is smaller than, equal to or larger than the value of the row \c b,
+ * and \c valid(row), returning \c false for invalid rows and rows to ignore (e.g. masked rows).
+ */
+class MonotonicityIndex {
+public:
+	static constexpr int BlockSize = 4096;
+
+	enum class Monotonicity { Invalid, Constant, Increasing, Decreasing, NonMonotonic };
+
+	bool isBuilt() const {
+		return m_built;
+	}
+	int rowCount() const {
+		return m_rowCount;
+	}
+	void clear() {
+		m_blocks.clear();
+		m_rowCount = 0;
+		m_invalidBlocks = 0;
+		m_increasingBlocks = 0;
+		m_decreasingBlocks = 0;
+		m_built = false;
+	}
+
+	/*!
+	 * builds the index for the rows [0, rowCount).
+	 */
+	template<typename Compare, typename Valid>
+	void build(int rowCount, Compare compare, Valid valid) {
+		clear();
+		m_rowCount = rowCount;
+		m_built = true;
+		m_blocks.resize((rowCount + BlockSize - 1) / BlockSize);
+		Parallel::forRanges((int)m_blocks.size(), 16, [&](int start, int end) {
+			for (int i = start; i < end; ++i)
+				m_blocks[i] = scanBlock(i, compare, valid);
+		});
+		for (const auto& block : m_blocks)
+			count(block, 1);
+	}
+
+	/*!
+	 * updates the index after the rows [first, last] were changed and the number of rows changed to \c rowCount.
+	 * Appended rows are updated in any case, the index is rebuilt if rows were removed.
+	 */
+	template<typename Compare, typename Valid>
+	void update(int first, int last, int rowCount, Compare compare, Valid valid) {
+		if (!m_built || rowCount < m_rowCount) {
+			build(rowCount, compare, valid);
+			return;
+		}
+
+		if (rowCount > m_rowCount) {
+			first = std::min(first, m_rowCount);
+			last = rowCount - 1;
+			m_rowCount = rowCount;
+			m_blocks.resize((rowCount + BlockSize - 1) / BlockSize);
+		}
+		first = std::max(first, 0);
+		last = std::min(last, m_rowCount - 1);
+		if (first > last)
+			return;
+
+		// the step from the last changed row to the next row belongs to the next block
+		const int lo = first / BlockSize;
+		const int hi = std::min(last + 1, m_rowCount - 1) / BlockSize;
+		for (int i = lo; i <= hi; ++i) {
+			count(m_blocks.at(i), -1);
+			m_blocks[i] = scanBlock(i, compare, valid);
+			count(m_blocks.at(i), 1);
+		}
+	}
+
+	Monotonicity monotonicity() const {
+		if (m_invalidBlocks > 0)
+			return Monotonicity::Invalid;
+		if (m_increasingBlocks > 0 && m_decreasingBlocks > 0)
+			return Monotonicity::NonMonotonic;
+		if (m_increasingBlocks > 0)
+			return Monotonicity::Increasing;
+		if (m_decreasingBlocks > 0)
+			return Monotonicity::Decreasing;
+		return Monotonicity::Constant;
+	}
+
+private:
+	struct Block {
+		bool invalid{false}; // the block contains an invalid row
+		bool increasing{false}; // the value increases from one row to the next one in the block
+		bool decreasing{false}; // the value decreases from one row to the next one in the block
+	};
+
+	template<typename Compare, typename Valid>
+	Block scanBlock(int block, Compare compare, Valid valid) const {
+		Block result;
+		const int start = block * BlockSize;
+		const int end = std::min(start + BlockSize, m_rowCount);
+		for (int row = start; row < end; ++row) {
+			if (!valid(row)) {
+				result.invalid = true;
+				break;
+			}
+			if (row == 0 || (result.increasing && result.decreasing))
+				continue;
+
+			const auto order = compare(row, row - 1);
+			if (order > 0)
+				result.increasing = true;
+			else if (order < 0)
+				result.decreasing = true;
+		}
+		return result;
+	}
+
+	void count(const Block& block, int sign) {
+		m_invalidBlocks += sign * block.invalid;
+		m_increasingBlocks += sign * block.increasing;
+		m_decreasingBlocks += sign * block.decreasing;
+	}
+
+	std::vector<Block> m_blocks;
+	int m_rowCount{0};
+	int m_invalidBlocks{0};
+	int m_increasingBlocks{0};
+	int m_decreasingBlocks{0};
+	bool m_built{false};
+};
+
+#endif // MONOTONICITYINDEX_H
@@ -0,0 +1,66 @@
+/*
+	File                 : Parallel.h
+	Project              : LabPlot
+	Description          : Helper to process ranges of rows in parallel
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include <algorithm>
+#include <atomic>
+
+namespace Parallel {
+
+/*!
+ * \brief calls \c function(start, end) for consecutive ranges covering the rows [0, count).
+ *
+ * The ranges have at least \c minRangeSize rows and are processed by the calling thread and by the
+ * idle threads of the global thread pool. Every range is processed exactly once, so the result doesn't
+ * depend on the number of threads as long as \c function only writes to its own range of rows.
+ * If no thread is idle (e.g. when called from a thread of the pool) all ranges are processed by the calling thread.
+ */
+template<typename Function>
+void forRanges(int count, int minRangeSize, Function function) {
+	if (count <= 0)
+		return;
+
+	auto* pool = QThreadPool::globalInstance();
+	const int threads = std::max(pool->maxThreadCount(), 1);
+	// a few ranges per thread to balance the load
+	const int rangeSize = std::max({minRangeSize, (count + 4 * threads - 1) / (4 * threads), 1});
+	const int ranges = 1 + (count - 1) / rangeSize;
+
+	std::atomic<int> next{0};
+	const auto work = [&]() {
+		int range;
+		while ((range = next++) < ranges) {
+			const int start = range * rangeSize;
+			function(start, start + std::min(rangeSize, count - start));
+		}
+	};
+
+	QSemaphore done;
+	int helpers = 0;
+	for (int i = 1; i < std::min(ranges, threads); ++i) {
+		if (!pool->tryStart([&]() {
+				work();
+				done.release();
+			}))
+			break;
+		++helpers;
+	}
+
+	work();
+	done.acquire(helpers);
+}
+
+} // namespace Parallel
+
+#endif // PARALLEL_H
@@ -0,0 +1,176 @@
+/*
+	File                 : ParallelSort.h
+	Project              : LabPlot
+	Description          : Parallel stable sorting of row indices and reordering of rows
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef PARALLELSORT_H
+#define PARALLELSORT_H
+
+#include "backend/lib/Parallel.h"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <vector>
+
+namespace ParallelSort {
+
+//! number of rows sorted or counted by one task
+constexpr int BlockSize = 65536;
+
+/*!
+ * \brief sorts \c values stably with the comparison \c less.
+ *
+ * Blocks of \c BlockSize values are sorted in parallel, the sorted blocks are merged pairwise in parallel afterwards.
+ * Equal values keep their order since \c std::merge takes the value of the first range for equal values.
+ */
+template<typename T, typename Less>
+void stableSort(std::vector<T>& values, Less less) {
+	const qint64 count = static_cast<qint64>(values.size());
+	const int blocks = static_cast<int>((count + BlockSize - 1) / BlockSize);
+	Parallel::forRanges(blocks, 1, [&](int start, int end) {
+		for (int block = start; block < end; ++block) {
+			const qint64 first = (qint64)block * BlockSize;
+			std::stable_sort(values.begin() + first, values.begin() + std::min(first + BlockSize, count), less);
+		}
+	});
+	if (blocks < 2)
+		return;
+
+	std::vector<T> buffer(values.size());
+	for (qint64 width = BlockSize; width < count; width *= 2) {
+		const int merges = static_cast<int>((count + 2 * width - 1) / (2 * width));
+		Parallel::forRanges(merges, 1, [&](int start, int end) {
+			for (int merge = start; merge < end; ++merge) {
+				const qint64 first = merge * 2 * width;
+				const qint64 middle = std::min(first + width, count);
+				const qint64 last = std::min(first + 2 * width, count);
+				std::merge(values.begin() + first,
+						   values.begin() + middle,
+						   values.begin() + middle,
+						   values.begin() + last,
+						   buffer.begin() + first,
+						   less);
+			}
+		});
+		values.swap(buffer);
+	}
+}
+
+/*!
+ * \brief sorts the row indices \c index stably by their keys \c keys, \c keys[i] is the key of \c index[i].
+ *
+ * Least significant digit radix sort with 8 bits per pass. The digits are counted and scattered in parallel
+ * per block of \c BlockSize keys, passes over digits that are equal for all keys are skipped, e.g. the upper
+ * bytes of 32 bit integers or of date-times close to each other. \c keys is sorted too.
+ */
+inline void radixSort(std::vector<int>& index, std::vector<uint64_t>& keys) {
+	const qint64 count = static_cast<qint64>(keys.size());
+	if (count < 2)
+		return;
+
+	// bits that are not equal for all keys
+	uint64_t any = 0, all = ~uint64_t(0);
+	for (const auto key : keys) {
+		any |= key;
+		all &= key;
+	}
+	const uint64_t changing = any ^ all;
+
+	const int blocks = static_cast<int>((count + BlockSize - 1) / BlockSize);
+	std::vector<std::array<qint64, 256>> offsets(blocks);
+	std::vector<uint64_t> keyBuffer(keys.size());
+	std::vector<int> indexBuffer(index.size());
+	for (int shift = 0; shift < 64; shift += 8) {
+		if (((changing >> shift) & 0xFF) == 0)
+			continue;
+
+		// histogram of the digits per block
+		Parallel::forRanges(blocks, 1, [&](int start, int end) {
+			for (int block = start; block < end; ++block) {
+				auto& histogram = offsets[block];
+				histogram.fill(0);
+				const qint64 last = std::min((qint64)(block + 1) * BlockSize, count);
+				for (qint64 i = (qint64)block * BlockSize; i < last; ++i)
+					++histogram[(keys[i] >> shift) & 0xFF];
+			}
+		});
+
+		// position of the first key with the digit in every block, the blocks keep their order for every digit
+		qint64 position = 0;
+		for (int digit = 0; digit < 256; ++digit) {
+			for (auto& histogram : offsets) {
+				const qint64 n = histogram[digit];
+				histogram[digit] = position;
+				position += n;
+			}
+		}
+
+		Parallel::forRanges(blocks, 1, [&](int start, int end) {
+			for (int block = start; block < end; ++block) {
+				auto& positions = offsets[block];
+				const qint64 last = std::min((qint64)(block + 1) * BlockSize, count);
+				for (qint64 i = (qint64)block * BlockSize; i < last; ++i) {
+					const qint64 target = positions[(keys[i] >> shift) & 0xFF]++;
+					keyBuffer[target] = keys[i];
+					indexBuffer[target] = index[i];
+				}
+			}
+		});
+		keys.swap(keyBuffer);
+		index.swap(indexBuffer);
+	}
+}
+
+/*!
+ * \brief reorders the first \c permutation.size() values of \c data.
+ *
+ * The value in the row \c i is taken from the row \c permutation[i], if \c inverse is \c true the value
+ * of the row \c i is moved to the row \c permutation[i] instead, which reverts the permutation.
+ * The values are moved into a temporary buffer and back. This is much faster than following the cycles
+ * of the permutation in place, since the random accesses don't depend on each other, and only one buffer
+ * is needed per column that is reordered at the same time.
+ */
+template<typename T>
+void permute(T* data, const std::vector<int>& permutation, bool inverse) {
+	const size_t count = permutation.size();
+	std::vector<T> permuted(count);
+	if (inverse) {
+		for (size_t i = 0; i < count; ++i)
+			permuted[permutation[i]] = std::move(data[i]);
+	} else {
+		for (size_t i = 0; i < count; ++i)
+			permuted[i] = std::move(data[permutation[i]]);
+	}
+	std::move(permuted.begin(), permuted.end(), data);
+}
+
+/*!
+ * returns a key of the 64 bit integer \c value that is ordered like the value when compared as unsigned integer.
+ */
+inline uint64_t key(qint64 value) {
+	return static_cast<uint64_t>(value) ^ (uint64_t(1) << 63);
+}
+
+/*!
+ * returns a key of the double \c value that is ordered like the value when compared as unsigned integer,
+ * NaN values are not supported. 0 and -0 have the same key.
+ */
+inline uint64_t key(double value) {
+	if (value == 0.)
+		value = 0.;
+	uint64_t bits;
+	std::memcpy(&bits, &value, sizeof(bits));
+	// negative values: all bits are inverted, positive values: the sign bit is set
+	return (bits & (uint64_t(1) << 63)) ? ~bits : bits | (uint64_t(1) << 63);
+}
+
+} // namespace ParallelSort
+
+#endif // PARALLELSORT_H
@@ -0,0 +1,107 @@
+/*
+	File                 : RowBitmap.h
+	Project              : LabPlot
+	Description          : One bit per row, e.g. for the masked rows of a column
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef ROWBITMAP_H
+#define ROWBITMAP_H
+
+#include <QtAlgorithms>
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+
+/*!
+ * \brief Set of rows stored as one bit per row.
+ *
+ * Testing a row is O(1). The bitmap only covers the rows up to the last row that was set,
+ * rows behind it are not set. \c nextSet() and \c nextUnset() skip 64 rows per step,
+ * so runs of set or unset rows can be iterated without testing every row.
+ */
+class RowBitmap {
+public:
+	//! returned by \c nextSet() if there is no set row
+	static constexpr int NoRow = std::numeric_limits<int>::max();
+
+	bool test(int row) const {
+		if (row < 0)
+			return false;
+		const auto word = static_cast<size_t>(row) / 64;
+		return word < m_words.size() && (m_words[word] & (quint64(1) << (row % 64)));
+	}
+
+	//! sets or unsets the rows from \c first to \c last (both inclusive)
+	void setRange(int first, int last, bool value = true) {
+		first = std::max(first, 0);
+		if (last < first)
+			return;
+
+		const auto firstWord = static_cast<size_t>(first) / 64;
+		auto lastWord = static_cast<size_t>(last) / 64;
+		if (value) {
+			if (m_words.size() <= lastWord)
+				m_words.resize(lastWord + 1, 0);
+		} else {
+			if (firstWord >= m_words.size())
+				return;
+			if (lastWord >= m_words.size()) {
+				lastWord = m_words.size() - 1;
+				last = static_cast<int>(lastWord * 64 + 63);
+			}
+		}
+
+		for (auto word = firstWord; word <= lastWord; ++word) {
+			const int from = (word == firstWord) ? first % 64 : 0;
+			const int to = (word == lastWord) ? last % 64 : 63;
+			const quint64 bits = (~quint64(0) >> (63 - to)) & (~quint64(0) << from);
+			if (value)
+				m_words[word] |= bits;
+			else
+				m_words[word] &= ~bits;
+		}
+	}
+
+	void clear() {
+		m_words.clear();
+	}
+
+	//! first set row at or after \c row, \c NoRow if there is none
+	int nextSet(int row) const {
+		row = std::max(row, 0);
+		auto word = static_cast<size_t>(row) / 64;
+		if (word >= m_words.size())
+			return NoRow;
+		quint64 bits = m_words[word] & (~quint64(0) << (row % 64));
+		while (!bits) {
+			if (++word >= m_words.size())
+				return NoRow;
+			bits = m_words[word];
+		}
+		return static_cast<int>(word * 64 + qCountTrailingZeroBits(bits));
+	}
+
+	//! first row at or after \c row that is not set
+	int nextUnset(int row) const {
+		row = std::max(row, 0);
+		auto word = static_cast<size_t>(row) / 64;
+		if (word >= m_words.size())
+			return row;
+		quint64 bits = ~m_words[word] & (~quint64(0) << (row % 64));
+		while (!bits) {
+			if (++word >= m_words.size())
+				return static_cast<int>(word * 64);
+			bits = ~m_words[word];
+		}
+		return static_cast<int>(word * 64 + qCountTrailingZeroBits(bits));
+	}
+
+private:
+	std::vector<quint64> m_words;
+};
+
+#endif // ROWBITMAP_H
@@ -0,0 +1,133 @@
+/*
+	File                 : TextDictionary.h
+	Project              : LabPlot
+	Description          : Dictionary encoding of text values
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef TEXTDICTIONARY_H
+#define TEXTDICTIONARY_H
+
+#include <QHash>
+#include <QMap>
+#include <QString>
+#include <QVector>
+
+#include <algorithm>
+#include <limits>
+
+/*!
+ * \brief Dictionary encoding of text values: a code for every row and a pool of the distinct strings.
+ *
+ * The codes are assigned in the order of the first appearance of the strings, empty strings get \c EmptyCode.
+ * Equality tests, counting and sorting of categorical data can work on the codes instead of comparing strings.
+ *
+ * When built with \c intern set, the rows of the encoded vector are replaced by the strings of the pool,
+ * so equal strings share one buffer via the implicit sharing of \c QString.
+ */
+class TextDictionary {
+public:
+	static constexpr quint32 EmptyCode = std::numeric_limits<quint32>::max();
+	static constexpr quint32 UnknownCode = std::numeric_limits<quint32>::max() - 1;
+
+	void clear() {
+		m_codes.clear();
+		m_strings.clear();
+		m_counts.clear();
+		m_lookup.clear();
+	}
+
+	/*!
+	 * encodes \c values. If \c intern is \c true, equal strings in \c values are replaced by the same shared string.
+	 * The values are only interned if \c values is not shared with another vector to not detach it.
+	 */
+	void build(QVector<QString>& values, bool intern) {
+		clear();
+		const auto size = values.size();
+		m_codes.resize(size);
+		intern = intern && values.isDetached();
+		for (qsizetype row = 0; row < size; ++row) {
+			const auto& value = values.at(row);
+			if (value.isEmpty()) {
+				m_codes[row] = EmptyCode;
+				continue;
+			}
+
+			auto it = m_lookup.constFind(value);
+			if (it == m_lookup.constEnd()) {
+				it = m_lookup.insert(value, static_cast<quint32>(m_strings.size()));
+				m_strings << value;
+				m_counts << 0;
+			} else if (intern)
+				values[row] = m_strings.at(it.value());
+			m_codes[row] = it.value();
+			++m_counts[it.value()];
+		}
+	}
+
+	//! number of distinct non-empty strings
+	int size() const {
+		return m_strings.size();
+	}
+	int rowCount() const {
+		return m_codes.size();
+	}
+	const QVector<quint32>& codes() const {
+		return m_codes;
+	}
+	//! the distinct strings in the order of their first appearance
+	const QVector<QString>& strings() const {
+		return m_strings;
+	}
+
+	//! code of the row, \c EmptyCode for empty strings and rows outside of the encoded range
+	quint32 code(int row) const {
+		return (row >= 0 && row < m_codes.size()) ? m_codes.at(row) : EmptyCode;
+	}
+	//! code of \c value, \c EmptyCode for an empty string and \c UnknownCode if the string is not in the dictionary
+	quint32 code(const QString& value) const {
+		if (value.isEmpty())
+			return EmptyCode;
+		return m_lookup.value(value, UnknownCode);
+	}
+	//! number of rows with the string of \c code
+	int count(quint32 code) const {
+		return m_counts.at(code);
+	}
+
+	//! frequencies of the distinct strings
+	QMap<QString, int> frequencies() const {
+		QMap<QString, int> frequencies;
+		for (int i = 0; i < m_strings.size(); ++i)
+			frequencies.insert(m_strings.at(i), m_counts.at(i));
+		return frequencies;
+	}
+
+	/*!
+	 * returns the rank of every code when the strings are sorted ascending,
+	 * comparing the ranks of two rows is equivalent to comparing their strings.
+	 */
+	QVector<int> ranks() const {
+		QVector<int> order(m_strings.size());
+		for (int i = 0; i < order.size(); ++i)
+			order[i] = i;
+		std::sort(order.begin(), order.end(), [this](int a, int b) {
+			return m_strings.at(a) < m_strings.at(b);
+		});
+
+		QVector<int> ranks(order.size());
+		for (int i = 0; i < order.size(); ++i)
+			ranks[order.at(i)] = i;
+		return ranks;
+	}
+
+private:
+	QVector<quint32> m_codes; // code of every row
+	QVector<QString> m_strings; // pool of the distinct strings
+	QVector<int> m_counts; // number of rows for every code
+	QHash<QString, quint32> m_lookup; // code of every string in the pool
+};
+
+#endif // TEXTDICTIONARY_H
@@ -0,0 +1,75 @@
+/*
+	File                 : UndoMemoryBudget.cpp
+	Project              : LabPlot
+	Description          : Limit of the memory used by the commands on the undo stack
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#include "UndoMemoryBudget.h"
+#include "backend/lib/macros.h"
+
+#include <QUndoStack>
+#include <QVector>
+
+namespace {
+void releaseMemory(QUndoCommand* command) {
+	if (auto* memory = dynamic_cast<UndoCommandMemory*>(command))
+		memory->releaseMemory();
+	for (int i = 0; i < command->childCount(); ++i)
+		releaseMemory(const_cast<QUndoCommand*>(command->child(i)));
+}
+}
+
+/*!
+ * returns the number of bytes kept by the command \c command and its child commands (e.g. the commands of a macro).
+ * Only commands implementing \c UndoCommandMemory are taken into account.
+ */
+qint64 UndoMemoryBudget::memorySize(const QUndoCommand* command) {
+	qint64 size = 0;
+	if (const auto* memory = dynamic_cast<const UndoCommandMemory*>(command))
+		size += memory->memorySize();
+	for (int i = 0; i < command->childCount(); ++i)
+		size += memorySize(command->child(i));
+	return size;
+}
+
+/*!
+ * limits the memory used by the commands on the undo stack \c stack to \c budget bytes, no limit if \c budget is not positive.
+ * If the commands use more memory, the oldest commands are evicted from the undo history until the budget is met,
+ * the last executed command is always kept. Returns the number of evicted commands.
+ *
+ * QUndoStack doesn't allow to remove commands from the bottom of the stack, the evicted commands are marked as obsolete instead
+ * and their data is freed. Undoing an obsolete command doesn't change anything and removes it from the stack. Since all commands
+ * below an evicted command are evicted too, the state of the project stays consistent, the history just ends at the evicted commands.
+ */
+int UndoMemoryBudget::limit(QUndoStack* stack, qint64 budget) {
+	if (!stack || budget <= 0)
+		return 0;
+
+	const int count = stack->count();
+	QVector<qint64> sizes(count);
+	qint64 total = 0;
+	for (int i = 0; i < count; ++i) {
+		sizes[i] = memorySize(stack->command(i));
+		total += sizes.at(i);
+	}
+	if (total <= budget)
+		return 0;
+
+	int evicted = 0;
+	for (int i = 0; i < stack->index() - 1 && total > budget; ++i) {
+		auto* command = const_cast<QUndoCommand*>(stack->command(i));
+		if (command->isObsolete())
+			continue;
+		releaseMemory(command);
+		command->setObsolete(true);
+		total -= sizes.at(i);
+		++evicted;
+	}
+
+	if (evicted)
+		DEBUG(Q_FUNC_INFO << ", evicted commands: " << evicted << ", remaining memory: " << total)
+	return evicted;
+}
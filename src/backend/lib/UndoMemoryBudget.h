@@ -0,0 +1,36 @@
+/*
+	File                 : UndoMemoryBudget.h
+	Project              : LabPlot
+	Description          : Limit of the memory used by the commands on the undo stack
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef UNDOMEMORYBUDGET_H
+#define UNDOMEMORYBUDGET_H
+
+#include <QtGlobal>
+
+class QUndoCommand;
+class QUndoStack;
+
+/*!
+ * \brief Interface of undo commands keeping large amounts of data, e.g. the old values of a column.
+ */
+class UndoCommandMemory {
+public:
+	virtual ~UndoCommandMemory() = default;
+
+	//! number of bytes kept by the command to undo or redo it
+	virtual qint64 memorySize() const = 0;
+	//! frees the data kept by the command, the command can't be undone or redone anymore afterwards
+	virtual void releaseMemory() = 0;
+};
+
+namespace UndoMemoryBudget {
+qint64 memorySize(const QUndoCommand*);
+int limit(QUndoStack*, qint64 budget);
+}
+
+#endif // UNDOMEMORYBUDGET_H
@@ -0,0 +1,375 @@
+/*
+	File                 : ValueParser.h
+	Project              : LabPlot
+	Description          : Fast conversion of numbers and date-times in text files
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef VALUEPARSER_H
+#define VALUEPARSER_H
+
+#include <QByteArrayView>
+#include <QLocale>
+#include <QStringView>
+#include <QVector>
+
+#include <array>
+#include <charconv>
+
+namespace ValueParserPrivate {
+inline char ascii(char c) {
+	return static_cast<unsigned char>(c) < 0x80 ? c : '\0';
+}
+inline char ascii(QChar c) {
+	return c.unicode() < 0x80 ? static_cast<char>(c.unicode()) : '\0';
+}
+}
+
+/*!
+ * \brief Converts numbers like \c QLocale::toDouble(), \c QLocale::toInt() and \c QLocale::toLongLong().
+ *
+ * Numbers in the plain notation of the locale, e.g. "-1234.5e-3" or "-1234,5e-3" for a comma as the decimal point,
+ * are converted with \c std::from_chars without creating strings. All other numbers, e.g. with whitespaces,
+ * group separators or a plus sign, and locales with non-ASCII digits or signs are converted by the locale,
+ * so the result is always the same as the one of the locale.
+ */
+class NumberParser {
+public:
+	explicit NumberParser(const QLocale& locale = QLocale::c())
+		: m_locale(locale) {
+		const auto decimalPoint = locale.decimalPoint();
+		m_fast = locale.zeroDigit() == QLatin1String("0") && locale.negativeSign() == QLatin1String("-")
+			&& locale.exponential().compare(QLatin1String("e"), Qt::CaseInsensitive) == 0 && decimalPoint.size() == 1
+			&& decimalPoint.at(0).unicode() < 0x80;
+		if (m_fast)
+			m_decimalPoint = static_cast<char>(decimalPoint.at(0).unicode());
+	}
+
+	template<typename View>
+	double toDouble(View value, bool* ok) const {
+#ifdef __cpp_lib_to_chars
+		Buffer buffer;
+		int size;
+		double d;
+		if (normalize(value, buffer, size, true) && fromChars(buffer, size, d)) {
+			*ok = true;
+			return d;
+		}
+#endif
+		return m_locale.toDouble(toString(value), ok);
+	}
+
+	template<typename View>
+	int toInt(View value, bool* ok) const {
+		Buffer buffer;
+		int size;
+		int i;
+		if (normalize(value, buffer, size, false) && fromChars(buffer, size, i)) {
+			*ok = true;
+			return i;
+		}
+		return m_locale.toInt(toString(value), ok);
+	}
+
+	template<typename View>
+	qint64 toLongLong(View value, bool* ok) const {
+		Buffer buffer;
+		int size;
+		qint64 i;
+		if (normalize(value, buffer, size, false) && fromChars(buffer, size, i)) {
+			*ok = true;
+			return i;
+		}
+		return m_locale.toLongLong(toString(value), ok);
+	}
+
+private:
+	static constexpr int MaxLength = 64;
+	using Buffer = std::array<char, MaxLength>;
+
+	static QStringView toString(QStringView value) {
+		return value;
+	}
+	static QString toString(QByteArrayView value) {
+		return QString::fromUtf8(value);
+	}
+
+	template<typename Number>
+	static bool fromChars(const Buffer& buffer, int size, Number& number) {
+		const auto result = std::from_chars(buffer.data(), buffer.data() + size, number);
+		return result.ec == std::errc() && result.ptr == buffer.data() + size;
+	}
+
+	/*!
+	 * copies \c value into \c buffer with '.' as the decimal point, returns \c false if \c value is not a number in the notation
+	 * -?[0-9]+ or, if \c real is \c true, -?[0-9]+(.[0-9]+)?([eE][-+]?[0-9]+)?
+	 */
+	template<typename View>
+	bool normalize(View value, Buffer& buffer, int& size, bool real) const {
+		if (!m_fast || value.isEmpty() || value.size() > MaxLength)
+			return false;
+
+		enum class State { Sign, Integer, DecimalPoint, Fraction, Exponent, ExponentSign, ExponentDigits };
+		auto state = State::Sign;
+		size = static_cast<int>(value.size());
+		for (int i = 0; i < size; ++i) {
+			const char c = ValueParserPrivate::ascii(value[i]);
+			const bool digit = c >= '0' && c <= '9';
+			buffer[i] = c;
+			switch (state) {
+			case State::Sign:
+				if (c == '-' && i == 0)
+					continue;
+				if (!digit)
+					return false;
+				state = State::Integer;
+				break;
+			case State::Integer:
+				if (digit)
+					continue;
+				if (!real)
+					return false;
+				if (c == m_decimalPoint) {
+					buffer[i] = '.';
+					state = State::DecimalPoint;
+				} else if (c == 'e' || c == 'E')
+					state = State::Exponent;
+				else
+					return false;
+				break;
+			case State::DecimalPoint:
+				if (!digit)
+					return false;
+				state = State::Fraction;
+				break;
+			case State::Fraction:
+				if (c == 'e' || c == 'E')
+					state = State::Exponent;
+				else if (!digit)
+					return false;
+				break;
+			case State::Exponent:
+				if (c == '-' || c == '+')
+					state = State::ExponentSign;
+				else if (digit)
+					state = State::ExponentDigits;
+				else
+					return false;
+				break;
+			case State::ExponentSign:
+			case State::ExponentDigits:
+				if (!digit)
+					return false;
+				state = State::ExponentDigits;
+				break;
+			}
+		}
+		return state == State::Integer || state == State::Fraction || state == State::ExponentDigits;
+	}
+
+	QLocale m_locale;
+	bool m_fast{false};
+	char m_decimalPoint{'.'};
+};
+
+/*!
+ * \brief Converts date-times with a format like \c QDateTime::fromString() with the time spec UTC.
+ *
+ * The format is compiled once into a sequence of numeric fields and literal characters. Formats consisting of years
+ * ("yyyy", "yy"), months ("M", "MM"), days ("d", "dd"), hours ("h", "hh", "H", "HH"), minutes ("m", "mm"), seconds ("s", "ss"),
+ * milliseconds ("zzz") and literal characters are supported, e.g. "yyyy-MM-dd hh:mm:ss.zzz". The value is converted
+ * directly into the milliseconds since the epoch. \c toMSecsSinceEpoch() returns \c false for other formats and for values
+ * not matching the format or with invalid dates or times, these values need to be converted with \c QDateTime::fromString().
+ */
+class DateTimeParser {
+public:
+	explicit DateTimeParser(const QString& format = QString(), int baseYear = 1900)
+		: m_baseYear(baseYear) {
+		m_valid = compile(format);
+	}
+
+	/*!
+	 * returns \c true if the format is supported.
+	 */
+	bool isValid() const {
+		return m_valid;
+	}
+
+	template<typename View>
+	bool toMSecsSinceEpoch(View value, qint64& msecs) const {
+		if (!m_valid)
+			return false;
+
+		int fields[FieldCount] = {1900, 1, 1, 0, 0, 0, 0};
+		qsizetype position = 0;
+		for (const auto& token : m_tokens) {
+			if (token.field == Field::Literal) {
+				if (position >= value.size() || ValueParserPrivate::ascii(value[position]) != token.literal)
+					return false;
+				++position;
+				continue;
+			}
+
+			int number = 0;
+			int digits = 0;
+			while (digits < token.maxDigits && position < value.size()) {
+				const char c = ValueParserPrivate::ascii(value[position]);
+				if (c < '0' || c > '9')
+					break;
+				number = 10 * number + (c - '0');
+				++digits;
+				++position;
+			}
+			if (digits < token.minDigits)
+				return false;
+			if (token.field == Field::ShortYear)
+				fields[static_cast<int>(Field::Year)] = m_baseYear + ((number - m_baseYear) % 100 + 100) % 100;
+			else
+				fields[static_cast<int>(token.field)] = number;
+		}
+		if (position != value.size())
+			return false;
+
+		const int year = fields[static_cast<int>(Field::Year)];
+		const int month = fields[static_cast<int>(Field::Month)];
+		const int day = fields[static_cast<int>(Field::Day)];
+		if (month < 1 || month > 12 || day < 1 || day > daysInMonth(year, month) || fields[static_cast<int>(Field::Hour)] > 23
+			|| fields[static_cast<int>(Field::Minute)] > 59 || fields[static_cast<int>(Field::Second)] > 59)
+			return false;
+
+		msecs = days(year, month, day) * 86400000 + fields[static_cast<int>(Field::Hour)] * 3600000LL + fields[static_cast<int>(Field::Minute)] * 60000LL
+			+ fields[static_cast<int>(Field::Second)] * 1000LL + fields[static_cast<int>(Field::MSecs)];
+		return true;
+	}
+
+private:
+	enum class Field { Year, Month, Day, Hour, Minute, Second, MSecs, ShortYear, Literal };
+	static constexpr int FieldCount = 7;
+	struct Token {
+		Field field;
+		int minDigits{0};
+		int maxDigits{0};
+		char literal{'\0'};
+	};
+
+	bool compile(const QString& format) {
+		bool year = false;
+		for (qsizetype i = 0; i < format.size();) {
+			const QChar c = format.at(i);
+			qsizetype count = 1;
+			while (i + count < format.size() && format.at(i + count) == c)
+				++count;
+
+			if (c == QLatin1Char('\'')) {
+				// quoted literal text, two single quotes are a single quote
+				if (count % 2 == 0) {
+					for (qsizetype n = 0; n < count / 2; ++n)
+						m_tokens << Token{Field::Literal, 0, 0, '\''};
+					i += count;
+					continue;
+				}
+				const auto end = format.indexOf(c, i + 1);
+				if (end < 0)
+					return false;
+				for (qsizetype n = i + 1; n < end; ++n) {
+					if (!addLiteral(format.at(n)))
+						return false;
+				}
+				i = end + 1;
+				continue;
+			}
+
+			const char letter = ValueParserPrivate::ascii(c);
+			switch (letter) {
+			case 'y':
+				if (count != 2 && count != 4)
+					return false;
+				m_tokens << (count == 4 ? Token{Field::Year, 4, 4} : Token{Field::ShortYear, 2, 2});
+				year = true;
+				break;
+			case 'M':
+			case 'd':
+			case 'h':
+			case 'H':
+			case 'm':
+			case 's': {
+				// names of months and days are not supported
+				if (count > 2)
+					return false;
+				Field field;
+				if (letter == 'M')
+					field = Field::Month;
+				else if (letter == 'd')
+					field = Field::Day;
+				else if (letter == 'h' || letter == 'H')
+					field = Field::Hour;
+				else if (letter == 'm')
+					field = Field::Minute;
+				else
+					field = Field::Second;
+				m_tokens << Token{field, static_cast<int>(count), 2};
+				break;
+			}
+			case 'z':
+				if (count != 3)
+					return false;
+				m_tokens << Token{Field::MSecs, 3, 3};
+				break;
+			case 'a':
+			case 'A':
+			case 't':
+				// AM/PM and time zones are not supported
+				return false;
+			default:
+				for (qsizetype n = 0; n < count; ++n) {
+					if (!addLiteral(c))
+						return false;
+				}
+			}
+			i += count;
+		}
+
+		// the default year depends on the version of Qt
+		return year;
+	}
+
+	/*!
+	 * adds the literal character \c c, returns \c false for non-ASCII characters.
+	 */
+	bool addLiteral(QChar c) {
+		const char literal = ValueParserPrivate::ascii(c);
+		if (literal == '\0')
+			return false;
+		m_tokens << Token{Field::Literal, 0, 0, literal};
+		return true;
+	}
+
+	static bool isLeapYear(int year) {
+		return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+	}
+
+	static int daysInMonth(int year, int month) {
+		static constexpr int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+		return month == 2 && isLeapYear(year) ? 29 : days[month - 1];
+	}
+
+	/*!
+	 * returns the number of days since 1970-01-01 of the date in the proleptic Gregorian calendar.
+	 */
+	static qint64 days(qint64 year, int month, int day) {
+		year -= month <= 2;
+		const qint64 era = (year >= 0 ? year : year - 399) / 400;
+		const qint64 yearOfEra = year - era * 400;
+		const qint64 dayOfYear = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+		const qint64 dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+		return era * 146097 + dayOfEra - 719468;
+	}
+
+	QVector<Token> m_tokens;
+	int m_baseYear{1900};
+	bool m_valid{false};
+};
+
+#endif // VALUEPARSER_H
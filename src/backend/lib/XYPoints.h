@@ -0,0 +1,132 @@
+/*
+	File                 : XYPoints.h
+	Project              : LabPlot
+	Description          : Container of points which can share the data of columns
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+#ifndef XYPOINTS_H
+#define XYPOINTS_H
+
+#include <QPointF>
+#include <QVector>
+
+#include <algorithm>
+#include <iterator>
+
+/*!
+ * \brief Container of 2D points, either storing the points or sharing the x- and y-data of two columns.
+ *
+ * When the values of two double columns can be used as they are (no invalid or masked values),
+ * \c share() only references the data of the columns via the implicit sharing of \c QVector
+ * instead of copying every point. If a column is modified afterwards, the column detaches and
+ * the container keeps the values it was created with.
+ */
+class XYPoints {
+public:
+	class const_iterator {
+	public:
+		using iterator_category = std::forward_iterator_tag;
+		using value_type = QPointF;
+		using difference_type = std::ptrdiff_t;
+		using pointer = const QPointF*;
+		using reference = QPointF;
+
+		const_iterator(const XYPoints* points, int index)
+			: m_points(points)
+			, m_index(index) {
+		}
+		QPointF operator*() const {
+			return m_points->at(m_index);
+		}
+		const_iterator& operator++() {
+			++m_index;
+			return *this;
+		}
+		bool operator==(const const_iterator& other) const {
+			return m_index == other.m_index;
+		}
+		bool operator!=(const const_iterator& other) const {
+			return m_index != other.m_index;
+		}
+
+	private:
+		const XYPoints* m_points;
+		int m_index;
+	};
+
+	qsizetype size() const {
+		return m_shared ? m_sharedSize : m_points.size();
+	}
+	qsizetype count() const {
+		return size();
+	}
+	qsizetype length() const {
+		return size();
+	}
+	bool isEmpty() const {
+		return size() == 0;
+	}
+	bool isShared() const {
+		return m_shared;
+	}
+
+	QPointF at(int i) const {
+		return m_shared ? QPointF(m_x.at(i), m_y.at(i)) : m_points.at(i);
+	}
+	const_iterator begin() const {
+		return const_iterator(this, 0);
+	}
+	const_iterator end() const {
+		return const_iterator(this, static_cast<int>(size()));
+	}
+
+	void clear() {
+		m_points.clear();
+		m_x.clear();
+		m_y.clear();
+		m_sharedSize = 0;
+		m_shared = false;
+	}
+	void reserve(int size) {
+		m_points.reserve(size);
+	}
+	void append(QPointF point) {
+		m_points.append(point);
+	}
+
+	/*!
+	 * uses the first \c size values of \c x and \c y as the points without copying them.
+	 */
+	void share(const QVector<double>& x, const QVector<double>& y, int size) {
+		clear();
+		m_x = x;
+		m_y = y;
+		m_sharedSize = std::min({size, (int)x.size(), (int)y.size()});
+		m_shared = true;
+	}
+
+	/*!
+	 * returns the points as a vector, the points are copied if the data of columns is shared.
+	 */
+	QVector<QPointF> toVector() const {
+		if (!m_shared)
+			return m_points;
+
+		QVector<QPointF> points(m_sharedSize);
+		for (int i = 0; i < m_sharedSize; ++i)
+			points[i] = QPointF(m_x.at(i), m_y.at(i));
+		return points;
+	}
+
+private:
+	QVector<QPointF> m_points; // copied points
+	QVector<double> m_x; // x-data shared with the column
+	QVector<double> m_y; // y-data shared with the column
+	int m_sharedSize{0};
+	bool m_shared{false};
+};
+
+#endif // XYPOINTS_H
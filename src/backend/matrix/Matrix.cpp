@@ -13,6 +13,7 @@
 #include "Matrix.h"
 #include "MatrixPrivate.h"
 #include "backend/core/Folder.h"
+#include "backend/lib/DateTimeVector.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/matrix/MatrixModel.h"
@@ -197,6 +198,10 @@ bool Matrix::printPreview() const {
 // ##############################################################################
 // ##########################  getter methods  ##################################
 // ##############################################################################
+/*!
+ * returns the values of the matrix, a MatrixStorage<T> with the value type T of the mode of the matrix.
+ * The values are stored column-major, so the values of a column are contiguous.
+ */
 void* Matrix::data() const {
 	Q_D(const Matrix);
 	return d->data;
@@ -616,6 +621,11 @@ QVector<T> Matrix::columnCells(int col, int first_row, int last_row) {
 	Q_D(const Matrix);
 	return d->columnCells<T>(col, first_row, last_row);
 }
+template QVector<double> Matrix::columnCells<double>(int col, int first_row, int last_row);
+template QVector<QString> Matrix::columnCells<QString>(int col, int first_row, int last_row);
+template QVector<int> Matrix::columnCells<int>(int col, int first_row, int last_row);
+template QVector<qint64> Matrix::columnCells<qint64>(int col, int first_row, int last_row);
+template QVector<QDateTime> Matrix::columnCells<QDateTime>(int col, int first_row, int last_row);
 
 //! Set the values in the given cells from a type T vector
 template<typename T>
@@ -625,6 +635,11 @@ void Matrix::setColumnCells(int col, int first_row, int last_row, const QVector<
 	exec(new MatrixSetColumnCellsCmd<T>(d, col, first_row, last_row, values));
 	RESET_CURSOR;
 }
+template void Matrix::setColumnCells<double>(int col, int first_row, int last_row, const QVector<double>& values);
+template void Matrix::setColumnCells<QString>(int col, int first_row, int last_row, const QVector<QString>& values);
+template void Matrix::setColumnCells<int>(int col, int first_row, int last_row, const QVector<int>& values);
+template void Matrix::setColumnCells<qint64>(int col, int first_row, int last_row, const QVector<qint64>& values);
+template void Matrix::setColumnCells<QDateTime>(int col, int first_row, int last_row, const QVector<QDateTime>& values);
 
 //! Return the values in the given cells as vector (needs explicit instantiation)
 template<typename T>
@@ -636,6 +651,7 @@ template QVector<double> Matrix::rowCells<double>(int row, int first_column, int
 template QVector<QString> Matrix::rowCells<QString>(int row, int first_column, int last_column);
 template QVector<int> Matrix::rowCells<int>(int row, int first_column, int last_column);
 template QVector<QDateTime> Matrix::rowCells<QDateTime>(int row, int first_column, int last_column);
+template QVector<qint64> Matrix::rowCells<qint64>(int row, int first_column, int last_column);
 
 //! Set the values in the given cells from a type T vector
 template<typename T>
@@ -645,37 +661,43 @@ void Matrix::setRowCells(int row, int first_column, int last_column, const QVect
 	exec(new MatrixSetRowCellsCmd<T>(d, row, first_column, last_column, values));
 	RESET_CURSOR;
 }
+template void Matrix::setRowCells<double>(int row, int first_column, int last_column, const QVector<double>& values);
+template void Matrix::setRowCells<QString>(int row, int first_column, int last_column, const QVector<QString>& values);
+template void Matrix::setRowCells<int>(int row, int first_column, int last_column, const QVector<int>& values);
+template void Matrix::setRowCells<qint64>(int row, int first_column, int last_column, const QVector<qint64>& values);
+template void Matrix::setRowCells<QDateTime>(int row, int first_column, int last_column, const QVector<QDateTime>& values);
 
+/*!
+ * replaces the values of the matrix by \c data, a MatrixStorage<T> with the value type T of the mode of the matrix.
+ * The matrix takes the ownership of \c data.
+ */
 void Matrix::setData(void* data) {
 	bool isEmpty = false;
 	Q_D(Matrix);
 	switch (d->mode) {
 	case AbstractColumn::ColumnMode::Double:
-		if (static_cast<QVector<QVector<double>>*>(data)->isEmpty())
-			isEmpty = true;
+		isEmpty = static_cast<MatrixStorage<double>*>(data)->isEmpty();
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		if (static_cast<QVector<QVector<QString>>*>(data)->isEmpty())
-			isEmpty = true;
+		isEmpty = static_cast<MatrixStorage<QString>*>(data)->isEmpty();
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		if (static_cast<QVector<QVector<int>>*>(data)->isEmpty())
-			isEmpty = true;
+		isEmpty = static_cast<MatrixStorage<int>*>(data)->isEmpty();
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		if (static_cast<QVector<QVector<qint64>>*>(data)->isEmpty())
-			isEmpty = true;
+		isEmpty = static_cast<MatrixStorage<qint64>*>(data)->isEmpty();
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		if (static_cast<QVector<QVector<QDateTime>>*>(data)->isEmpty())
-			isEmpty = true;
+		isEmpty = static_cast<MatrixStorage<QDateTime>*>(data)->isEmpty();
 		break;
 	}
 
 	if (!isEmpty)
 		exec(new MatrixReplaceValuesCmd(d, data));
+	else if (data != d->data)
+		MatrixPrivate::deleteStorage(data, d->mode);
 }
 
 QVector<AspectType> Matrix::dropableOn() const {
@@ -796,6 +818,74 @@ void Matrix::mirrorVertically() {
 // ######################  Private implementation ###############################
 // ##############################################################################
 
+//! frees the data container \c data of a matrix with the mode \c mode
+void MatrixPrivate::deleteStorage(void* data, AbstractColumn::ColumnMode mode) {
+	if (!data)
+		return;
+
+	switch (mode) {
+	case AbstractColumn::ColumnMode::Double:
+		delete static_cast<MatrixStorage<double>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		delete static_cast<MatrixStorage<QString>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		delete static_cast<MatrixStorage<int>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		delete static_cast<MatrixStorage<qint64>*>(data);
+		break;
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::DateTime:
+		delete static_cast<MatrixStorage<QDateTime>*>(data);
+		break;
+	}
+}
+
+namespace {
+// new columns get the current number of rows of the matrix, which is 0 if there are no columns yet
+template<typename T>
+void insertStorageColumns(MatrixStorage<T>* storage, int rows, int before, int count) {
+	if (storage->columnCount() == 0)
+		storage->resize(rows, count);
+	else
+		storage->insertColumns(before, count);
+}
+
+template<typename T, typename S>
+void convertValues(const MatrixStorage<S>* source, MatrixStorage<T>* target) {
+	const auto* values = source->constData();
+	auto* newValues = target->data();
+	for (qsizetype i = 0; i < target->size(); ++i)
+		newValues[i] = static_cast<T>(values[i]);
+}
+
+//! returns a new numeric container with the values of \c d converted to \c T
+template<typename T>
+MatrixStorage<T>* convertedStorage(const MatrixPrivate* d, int rows, int columns) {
+	auto* storage = new MatrixStorage<T>(rows, columns);
+	switch (d->mode) {
+	case AbstractColumn::ColumnMode::Double:
+		convertValues(d->storage<double>(), storage);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		convertValues(d->storage<int>(), storage);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		convertValues(d->storage<qint64>(), storage);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::DateTime:
+		break;
+	}
+	return storage;
+}
+} // anonymous namespace
+
 MatrixPrivate::MatrixPrivate(Matrix* owner, const AbstractColumn::ColumnMode m)
 	: q(owner)
 	, data(nullptr)
@@ -803,47 +893,28 @@ MatrixPrivate::MatrixPrivate(Matrix* owner, const AbstractColumn::ColumnMode m)
 	, suppressDataChange(false) {
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		data = new QVector<QVector<double>>();
+		data = new MatrixStorage<double>();
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		data = new QVector<QVector<QString>>();
+		data = new MatrixStorage<QString>();
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		data = new QVector<QVector<int>>();
+		data = new MatrixStorage<int>();
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		data = new QVector<QVector<qint64>>();
+		data = new MatrixStorage<qint64>();
 		break;
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::DateTime:
-		data = new QVector<QVector<QDateTime>>();
+		data = new MatrixStorage<QDateTime>();
 		break;
 	}
 }
 
 MatrixPrivate::~MatrixPrivate() {
-	if (data) {
-		switch (mode) {
-		case AbstractColumn::ColumnMode::Double:
-			delete static_cast<QVector<QVector<double>>*>(data);
-			break;
-		case AbstractColumn::ColumnMode::Text:
-			delete static_cast<QVector<QVector<QString>>*>(data);
-			break;
-		case AbstractColumn::ColumnMode::Integer:
-			delete static_cast<QVector<QVector<int>>*>(data);
-			break;
-		case AbstractColumn::ColumnMode::BigInt:
-			delete static_cast<QVector<QVector<qint64>>*>(data);
-			break;
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::Month:
-		case AbstractColumn::ColumnMode::DateTime:
-			delete static_cast<QVector<QVector<QDateTime>>*>(data);
-			break;
-		}
-	}
+	deleteStorage(data, mode);
+	deleteImportData();
 }
 
 void MatrixPrivate::updateViewHeader() {
@@ -864,38 +935,25 @@ void MatrixPrivate::insertColumns(int before, int count) {
 	Q_EMIT q->columnsAboutToBeInserted(before, count);
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<double>>*>(data)->insert(before + i, QVector<double>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		insertStorageColumns(storage<double>(), rowCount, before, count);
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<QString>>*>(data)->insert(before + i, QVector<QString>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		insertStorageColumns(storage<QString>(), rowCount, before, count);
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<int>>*>(data)->insert(before + i, QVector<int>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		insertStorageColumns(storage<int>(), rowCount, before, count);
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<qint64>>*>(data)->insert(before + i, QVector<qint64>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		insertStorageColumns(storage<qint64>(), rowCount, before, count);
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		for (int i = 0; i < count; i++) {
-			static_cast<QVector<QVector<QDateTime>>*>(data)->insert(before + i, QVector<QDateTime>(rowCount));
-			columnWidths.insert(before + i, 0);
-		}
+		insertStorageColumns(storage<QDateTime>(), rowCount, before, count);
 		break;
 	}
+	for (int i = 0; i < count; i++)
+		columnWidths.insert(before + i, 0);
 
 	Q_EMIT q->columnsInserted(before, count);
 }
@@ -915,21 +973,21 @@ void MatrixPrivate::removeColumns(int first, int count) {
 
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		(static_cast<QVector<QVector<double>>*>(data))->remove(first, count);
+		storage<double>()->removeColumns(first, count);
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		(static_cast<QVector<QVector<QString>>*>(data))->remove(first, count);
+		storage<QString>()->removeColumns(first, count);
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		(static_cast<QVector<QVector<int>>*>(data))->remove(first, count);
+		storage<int>()->removeColumns(first, count);
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		(static_cast<QVector<QVector<qint64>>*>(data))->remove(first, count);
+		storage<qint64>()->removeColumns(first, count);
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		(static_cast<QVector<QVector<QDateTime>>*>(data))->remove(first, count);
+		storage<QDateTime>()->removeColumns(first, count);
 		break;
 	}
 
@@ -945,38 +1003,39 @@ void MatrixPrivate::removeColumns(int first, int count) {
 int MatrixPrivate::columnCount() const {
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		return (static_cast<QVector<QVector<double>>*>(data))->size();
+		return storage<double>()->columnCount();
 	case AbstractColumn::ColumnMode::Text:
-		return (static_cast<QVector<QVector<QString>>*>(data))->size();
+		return storage<QString>()->columnCount();
 	case AbstractColumn::ColumnMode::Integer:
-		return (static_cast<QVector<QVector<int>>*>(data))->size();
+		return storage<int>()->columnCount();
 	case AbstractColumn::ColumnMode::BigInt:
-		return (static_cast<QVector<QVector<qint64>>*>(data))->size();
+		return storage<qint64>()->columnCount();
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		return (static_cast<QVector<QVector<QDateTime>>*>(data))->size();
+		return storage<QDateTime>()->columnCount();
 	}
 	return 0;
 }
 
 int MatrixPrivate::rowCount() const {
+	// a matrix without columns has no rows
 	if (columnCount() == 0)
 		return 0;
 
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		return (static_cast<QVector<QVector<double>>*>(data))->at(0).size();
+		return storage<double>()->rowCount();
 	case AbstractColumn::ColumnMode::Text:
-		return (static_cast<QVector<QVector<QString>>*>(data))->at(0).size();
+		return storage<QString>()->rowCount();
 	case AbstractColumn::ColumnMode::Integer:
-		return (static_cast<QVector<QVector<int>>*>(data))->at(0).size();
+		return storage<int>()->rowCount();
 	case AbstractColumn::ColumnMode::BigInt:
-		return (static_cast<QVector<QVector<qint64>>*>(data))->at(0).size();
+		return storage<qint64>()->rowCount();
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		return (static_cast<QVector<QVector<QDateTime>>*>(data))->at(0).size();
+		return storage<QDateTime>()->rowCount();
 	}
 	return 0;
 }
@@ -991,33 +1050,26 @@ void MatrixPrivate::insertRows(int before, int count) {
 
 	const auto columnCount = this->columnCount();
 
-	switch (mode) {
-	case AbstractColumn::ColumnMode::Double:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<double>>*>(data))->operator[](col).insert(before + i, 0.0);
-		break;
-	case AbstractColumn::ColumnMode::Text:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<QString>>*>(data))->operator[](col).insert(before + i, QString());
-		break;
-	case AbstractColumn::ColumnMode::Integer:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<int>>*>(data))->operator[](col).insert(before + i, 0);
-		break;
-	case AbstractColumn::ColumnMode::BigInt:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<qint64>>*>(data))->operator[](col).insert(before + i, 0);
-		break;
-	case AbstractColumn::ColumnMode::Day:
-	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::DateTime:
-		for (int col = 0; col < columnCount; col++)
-			for (int i = 0; i < count; i++)
-				(static_cast<QVector<QVector<QDateTime>>*>(data))->operator[](col).insert(before + i, QDateTime());
+	if (columnCount > 0) {
+		switch (mode) {
+		case AbstractColumn::ColumnMode::Double:
+			storage<double>()->insertRows(before, count);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			storage<QString>()->insertRows(before, count);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			storage<int>()->insertRows(before, count);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			storage<qint64>()->insertRows(before, count);
+			break;
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::DateTime:
+			storage<QDateTime>()->insertRows(before, count);
+			break;
+		}
 	}
 
 	if (columnCount == 0) {
@@ -1040,29 +1092,26 @@ void MatrixPrivate::removeRows(int first, int count) {
 
 	const auto columnCount = this->columnCount();
 
-	switch (mode) {
-	case AbstractColumn::ColumnMode::Double:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<double>>*>(data))->operator[](col).remove(first, count);
-		break;
-	case AbstractColumn::ColumnMode::Text:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<QString>>*>(data))->operator[](col).remove(first, count);
-		break;
-	case AbstractColumn::ColumnMode::Integer:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<int>>*>(data))->operator[](col).remove(first, count);
-		break;
-	case AbstractColumn::ColumnMode::BigInt:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<qint64>>*>(data))->operator[](col).remove(first, count);
-		break;
-	case AbstractColumn::ColumnMode::Day:
-	case AbstractColumn::ColumnMode::Month:
-	case AbstractColumn::ColumnMode::DateTime:
-		for (int col = 0; col < columnCount; col++)
-			(static_cast<QVector<QVector<QDateTime>>*>(data))->operator[](col).remove(first, count);
-		break;
+	if (columnCount > 0) {
+		switch (mode) {
+		case AbstractColumn::ColumnMode::Double:
+			storage<double>()->removeRows(first, count);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			storage<QString>()->removeRows(first, count);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			storage<int>()->removeRows(first, count);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			storage<qint64>()->removeRows(first, count);
+			break;
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::DateTime:
+			storage<QDateTime>()->removeRows(first, count);
+			break;
+		}
 	}
 
 	if (columnCount == 0) {
@@ -1079,21 +1128,21 @@ void MatrixPrivate::removeRows(int first, int count) {
 void MatrixPrivate::clearColumn(int col) {
 	switch (mode) {
 	case AbstractColumn::ColumnMode::Double:
-		static_cast<QVector<QVector<double>>*>(data)->operator[](col).fill(0.0);
+		storage<double>()->fillColumn(col, 0.0);
 		break;
 	case AbstractColumn::ColumnMode::Text:
-		static_cast<QVector<QVector<QString>>*>(data)->operator[](col).fill(QString());
+		storage<QString>()->fillColumn(col, QString());
 		break;
 	case AbstractColumn::ColumnMode::Integer:
-		static_cast<QVector<QVector<int>>*>(data)->operator[](col).fill(0);
+		storage<int>()->fillColumn(col, 0);
 		break;
 	case AbstractColumn::ColumnMode::BigInt:
-		static_cast<QVector<QVector<qint64>>*>(data)->operator[](col).fill(0);
+		storage<qint64>()->fillColumn(col, 0);
 		break;
 	case AbstractColumn::ColumnMode::Day:
 	case AbstractColumn::ColumnMode::Month:
 	case AbstractColumn::ColumnMode::DateTime:
-		static_cast<QVector<QVector<QDateTime>>*>(data)->operator[](col).fill(QDateTime());
+		storage<QDateTime>()->fillColumn(col, QDateTime());
 		break;
 	}
 
@@ -1101,6 +1150,73 @@ void MatrixPrivate::clearColumn(int col) {
 		Q_EMIT q->dataChanged(0, col, rowCount() - 1, col);
 }
 
+/*!
+ * changes the mode of the matrix and the type of the data container. Numeric values are converted
+ * to the new type, the values are reset for all other changes.
+ */
+void MatrixPrivate::setMode(AbstractColumn::ColumnMode newMode) {
+	if (newMode == mode)
+		return;
+
+	const int rows = rowCount();
+	const int columns = columnCount();
+	void* newData = nullptr;
+	switch (newMode) {
+	case AbstractColumn::ColumnMode::Double:
+		newData = convertedStorage<double>(this, rows, columns);
+		break;
+	case AbstractColumn::ColumnMode::Integer:
+		newData = convertedStorage<int>(this, rows, columns);
+		break;
+	case AbstractColumn::ColumnMode::BigInt:
+		newData = convertedStorage<qint64>(this, rows, columns);
+		break;
+	case AbstractColumn::ColumnMode::Text:
+		newData = new MatrixStorage<QString>(rows, columns);
+		break;
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::DateTime:
+		// Day, Month and DateTime share the same container
+		if (mode == AbstractColumn::ColumnMode::Day || mode == AbstractColumn::ColumnMode::Month || mode == AbstractColumn::ColumnMode::DateTime) {
+			mode = newMode;
+			return;
+		}
+		newData = new MatrixStorage<QDateTime>(rows, columns);
+		break;
+	}
+
+	deleteStorage(data, mode);
+	data = newData;
+	mode = newMode;
+}
+
+//! frees the containers created in Matrix::prepareImport()
+void MatrixPrivate::deleteImportData() {
+	for (auto* container : importData) {
+		switch (mode) {
+		case AbstractColumn::ColumnMode::Double:
+			delete static_cast<QVector<double>*>(container);
+			break;
+		case AbstractColumn::ColumnMode::Text:
+			delete static_cast<QVector<QString>*>(container);
+			break;
+		case AbstractColumn::ColumnMode::Integer:
+			delete static_cast<QVector<int>*>(container);
+			break;
+		case AbstractColumn::ColumnMode::BigInt:
+			delete static_cast<QVector<qint64>*>(container);
+			break;
+		case AbstractColumn::ColumnMode::Day:
+		case AbstractColumn::ColumnMode::Month:
+		case AbstractColumn::ColumnMode::DateTime:
+			delete static_cast<DateTimeVector*>(container);
+			break;
+		}
+	}
+	importData.clear();
+}
+
 // ##############################################################################
 // ##################  Serialization/Deserialization  ###########################
 // ##############################################################################
@@ -1154,7 +1270,7 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::Double:
 		size = d->rowCount() * sizeof(double);
 		for (int i = 0; i < columnCount; ++i) {
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<double>>*>(d->data)->at(i).constData());
+			data = reinterpret_cast<const char*>(d->storage<double>()->column(i).data());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1163,8 +1279,8 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::Text:
 		size = d->rowCount() * sizeof(QString);
 		for (int i = 0; i < columnCount; ++i) {
-			QDEBUG("	string: " << static_cast<QVector<QVector<QString>>*>(d->data)->at(i));
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<QString>>*>(d->data)->at(i).constData());
+			QDEBUG("	string: " << d->storage<QString>()->column(i).toVector());
+			data = reinterpret_cast<const char*>(d->storage<QString>()->column(i).data());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1173,7 +1289,7 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::Integer:
 		size = d->rowCount() * sizeof(int);
 		for (int i = 0; i < columnCount; ++i) {
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<int>>*>(d->data)->at(i).constData());
+			data = reinterpret_cast<const char*>(d->storage<int>()->column(i).data());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1182,7 +1298,7 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::BigInt:
 		size = d->rowCount() * sizeof(qint64);
 		for (int i = 0; i < columnCount; ++i) {
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<qint64>>*>(d->data)->at(i).constData());
+			data = reinterpret_cast<const char*>(d->storage<qint64>()->column(i).data());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1193,7 +1309,7 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	case AbstractColumn::ColumnMode::DateTime:
 		size = d->rowCount() * sizeof(QDateTime);
 		for (int i = 0; i < columnCount; ++i) {
-			data = reinterpret_cast<const char*>(static_cast<QVector<QVector<QDateTime>>*>(d->data)->at(i).constData());
+			data = reinterpret_cast<const char*>(d->storage<QDateTime>()->column(i).data());
 			writer->writeStartElement(QStringLiteral("column"));
 			writer->writeCharacters(QLatin1String(QByteArray::fromRawData(data, size).toBase64()));
 			writer->writeEndElement();
@@ -1204,6 +1320,23 @@ void Matrix::save(QXmlStreamWriter* writer) const {
 	writer->writeEndElement(); // "matrix"
 }
 
+namespace {
+//! appends \c column to \c storage, the first column defines the number of rows
+template<typename T>
+void appendStorageColumn(MatrixStorage<T>* storage, const QVector<T>& column) {
+	const int col = storage->columnCount();
+	if (col == 0)
+		storage->resize(column.size(), 1);
+	else
+		storage->insertColumns(col, 1);
+
+	auto values = storage->column(col);
+	const int rows = std::min((int)values.size(), (int)column.size());
+	for (int row = 0; row < rows; ++row)
+		values[row] = column.at(row);
+}
+} // anonymous namespace
+
 bool Matrix::load(XmlStreamReader* reader, bool preview) {
 	DEBUG(Q_FUNC_INFO)
 	if (!readBasicAttributes(reader))
@@ -1235,7 +1368,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 			if (str.isEmpty())
 				reader->raiseMissingAttributeWarning(QStringLiteral("mode"));
 			else
-				d->mode = AbstractColumn::ColumnMode(str.toInt());
+				d->setMode(AbstractColumn::ColumnMode(str.toInt()));
 
 			str = attribs.value(QStringLiteral("headerFormat")).toString();
 			if (str.isEmpty())
@@ -1309,7 +1442,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				QVector<double> column;
 				column.resize(count);
 				memcpy(column.data(), bytes.data(), count * sizeof(double));
-				static_cast<QVector<QVector<double>>*>(d->data)->append(column);
+				appendStorageColumn(d->storage<double>(), column);
 				break;
 			}
 			case AbstractColumn::ColumnMode::Text: {
@@ -1318,7 +1451,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				column.resize(count);
 				// TODO: warning (GCC8): writing to an object of type 'class QString' with no trivial copy-assignment; use copy-assignment or
 				// copy-initialization instead memcpy(column.data(), bytes.data(), count*sizeof(QString)); QDEBUG("	string: " << column.data());
-				static_cast<QVector<QVector<QString>>*>(d->data)->append(column);
+				appendStorageColumn(d->storage<QString>(), column);
 				break;
 			}
 			case AbstractColumn::ColumnMode::Integer: {
@@ -1326,7 +1459,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				QVector<int> column;
 				column.resize(count);
 				memcpy(column.data(), bytes.data(), count * sizeof(int));
-				static_cast<QVector<QVector<int>>*>(d->data)->append(column);
+				appendStorageColumn(d->storage<int>(), column);
 				break;
 			}
 			case AbstractColumn::ColumnMode::BigInt: {
@@ -1334,7 +1467,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				QVector<qint64> column;
 				column.resize(count);
 				memcpy(column.data(), bytes.data(), count * sizeof(qint64));
-				static_cast<QVector<QVector<qint64>>*>(d->data)->append(column);
+				appendStorageColumn(d->storage<qint64>(), column);
 				break;
 			}
 			case AbstractColumn::ColumnMode::Day:
@@ -1345,7 +1478,7 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 				column.resize(count);
 				// TODO: warning (GCC8): writing to an object of type 'class QDateTime' with no trivial copy-assignment; use copy-assignment or
 				// copy-initialization instead memcpy(column.data(), bytes.data(), count*sizeof(QDateTime));
-				static_cast<QVector<QVector<QDateTime>>*>(d->data)->append(column);
+				appendStorageColumn(d->storage<QDateTime>(), column);
 				break;
 			}
 			}
@@ -1362,6 +1495,39 @@ bool Matrix::load(XmlStreamReader* reader, bool preview) {
 // ##############################################################################
 // ########################  Data Import  #######################################
 // ##############################################################################
+namespace {
+//! creates the containers filled by the filters, one for every column of the matrix
+template<typename Container>
+void createImportData(MatrixPrivate* d, std::vector<void*>& dataContainer, int rows, int cols) {
+	for (int n = 0; n < cols; n++) {
+		auto* vector = new Container(rows);
+		d->importData.push_back(vector);
+		dataContainer[n] = static_cast<void*>(vector);
+	}
+}
+
+//! copies the values of the imported columns into the matrix
+template<typename T, typename Container>
+void copyImportData(MatrixPrivate* d) {
+	auto* storage = d->storage<T>();
+	for (size_t n = d->importOffset; n < d->importData.size() && n < (size_t)storage->columnCount(); ++n) {
+		const auto* vector = static_cast<const Container*>(d->importData.at(n));
+		auto column = storage->column(n);
+		const int rows = std::min((int)vector->size(), (int)column.size());
+		for (int row = 0; row < rows; ++row)
+			column[row] = vector->at(row);
+	}
+}
+} // anonymous namespace
+
+/*!
+ * prepares the matrix for the import of \c actualRows x \c actualCols values.
+ *
+ * The matrix takes the mode of the imported data. If \c initializeDataContainer is \c true, \c dataContainer
+ * is filled with one container (\c QVector<T> or \c DateTimeVector) per column of the matrix, the imported
+ * columns start at the returned column offset. The values are copied into the matrix in finalizeImport().
+ * Otherwise the filter writes the values directly into the MatrixStorage returned by data().
+ */
 int Matrix::prepareImport(std::vector<void*>& dataContainer,
 						  AbstractFileFilter::ImportMode mode,
 						  int actualRows,
@@ -1372,6 +1538,8 @@ int Matrix::prepareImport(std::vector<void*>& dataContainer,
 						  bool initializeDataContainer) {
 	Q_D(Matrix);
 	auto newColumnMode = columnMode.at(0); // only first column mode used
+	if (newColumnMode == AbstractColumn::ColumnMode::Day || newColumnMode == AbstractColumn::ColumnMode::Month)
+		newColumnMode = AbstractColumn::ColumnMode::DateTime;
 	DEBUG(Q_FUNC_INFO << ", rows = " << actualRows << " cols = " << actualCols << ", mode = " << ENUM_TO_STRING(AbstractFileFilter, ImportMode, mode)
 					  << ", column mode = " << ENUM_TO_STRING(AbstractColumn, ColumnMode, newColumnMode))
 	// QDEBUG("	column modes = " << columnMode);
@@ -1379,24 +1547,20 @@ int Matrix::prepareImport(std::vector<void*>& dataContainer,
 	setUndoAware(false);
 
 	setSuppressDataChangedSignal(true);
+	d->deleteImportData();
 
 	// resize the matrix
 	try {
 		if (mode == AbstractFileFilter::ImportMode::Replace) {
+			d->setMode(newColumnMode);
 			clear();
 			setDimensions(actualRows, actualCols);
 		} else { // Append
-			// handle mismatch of modes
-			DEBUG(Q_FUNC_INFO << ", TODO: matrix mode = " << ENUM_TO_STRING(AbstractColumn, ColumnMode, d->mode)
-							  << ", columnMode = " << ENUM_TO_STRING(AbstractColumn, ColumnMode, columnMode.at(0)))
-			// TODO: no way to convert types yet!
+			// numeric values are converted to the new mode, all other values are lost if the modes don't match
 			if (d->mode != newColumnMode) {
-				DEBUG(Q_FUNC_INFO << ", WARNING mismatch of types in append mode!")
+				DEBUG(Q_FUNC_INFO << ", WARNING mismatch of types in append mode! matrix mode = " << ENUM_TO_STRING(AbstractColumn, ColumnMode, d->mode))
+				d->setMode(newColumnMode);
 			}
-			// catch some cases
-			if ((d->mode == AbstractColumn::ColumnMode::Integer || d->mode == AbstractColumn::ColumnMode::BigInt)
-				&& newColumnMode == AbstractColumn::ColumnMode::Double)
-				d->mode = newColumnMode;
 
 			columnOffset = columnCount();
 			actualCols += columnOffset;
@@ -1406,74 +1570,73 @@ int Matrix::prepareImport(std::vector<void*>& dataContainer,
 			else
 				setDimensions(rowCount(), actualCols);
 		}
+
+		DEBUG(Q_FUNC_INFO << ", actual rows/cols = " << actualRows << "/" << actualCols)
+		if (initializeDataContainer) {
+			// the filters fill one container per column, the values are copied into the matrix in finalizeImport()
+			dataContainer.resize(actualCols);
+			d->importOffset = columnOffset;
+			switch (d->mode) {
+			case AbstractColumn::ColumnMode::Double:
+				createImportData<QVector<double>>(d, dataContainer, actualRows, actualCols);
+				break;
+			case AbstractColumn::ColumnMode::Integer:
+				createImportData<QVector<int>>(d, dataContainer, actualRows, actualCols);
+				break;
+			case AbstractColumn::ColumnMode::BigInt:
+				createImportData<QVector<qint64>>(d, dataContainer, actualRows, actualCols);
+				break;
+			case AbstractColumn::ColumnMode::Text:
+				createImportData<QVector<QString>>(d, dataContainer, actualRows, actualCols);
+				break;
+			case AbstractColumn::ColumnMode::Day:
+			case AbstractColumn::ColumnMode::Month:
+			case AbstractColumn::ColumnMode::DateTime:
+				createImportData<DateTimeVector>(d, dataContainer, actualRows, actualCols);
+				break;
+			}
+		}
 	} catch (std::bad_alloc&) {
+		d->deleteImportData();
 		ok = false;
 		return 0;
 	}
 
-	DEBUG(Q_FUNC_INFO << ", actual rows/cols = " << actualRows << "/" << actualCols)
-	// data() returns a void* which is a pointer to a matrix of any data type (see ColumnPrivate.cpp)
-	if (initializeDataContainer) {
-		dataContainer.resize(actualCols);
+	ok = true;
+	return columnOffset;
+}
+
+void Matrix::finalizeImport(size_t /*columnOffset*/,
+							size_t /*startColumn*/,
+							size_t /*endColumn*/,
+							const QString& /*dateTimeFormat*/,
+							AbstractFileFilter::ImportMode) {
+	DEBUG(Q_FUNC_INFO)
+	Q_D(Matrix);
 
-		switch (newColumnMode) { // prepare all columns
+	if (!d->importData.empty()) {
+		switch (d->mode) {
 		case AbstractColumn::ColumnMode::Double:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<double>* vector = &(static_cast<QVector<QVector<double>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::Double;
+			copyImportData<double, QVector<double>>(d);
 			break;
 		case AbstractColumn::ColumnMode::Integer:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<int>* vector = &(static_cast<QVector<QVector<int>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::Integer;
+			copyImportData<int, QVector<int>>(d);
 			break;
 		case AbstractColumn::ColumnMode::BigInt:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<qint64>* vector = &(static_cast<QVector<QVector<qint64>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::BigInt;
+			copyImportData<qint64, QVector<qint64>>(d);
 			break;
 		case AbstractColumn::ColumnMode::Text:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<QString>* vector = &(static_cast<QVector<QVector<QString>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::Text;
+			copyImportData<QString, QVector<QString>>(d);
 			break;
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::DateTime:
-			for (int n = 0; n < actualCols; n++) {
-				QVector<QDateTime>* vector = &(static_cast<QVector<QVector<QDateTime>>*>(data())->operator[](n));
-				vector->resize(actualRows);
-				dataContainer[n] = static_cast<void*>(vector);
-			}
-			d->mode = AbstractColumn::ColumnMode::DateTime;
+			copyImportData<QDateTime, DateTimeVector>(d);
 			break;
 		}
+		d->deleteImportData();
 	}
 
-	ok = true;
-	return columnOffset;
-}
-
-void Matrix::finalizeImport(size_t /*columnOffset*/,
-							size_t /*startColumn*/,
-							size_t /*endColumn*/,
-							const QString& /*dateTimeFormat*/,
-							AbstractFileFilter::ImportMode) {
-	DEBUG(Q_FUNC_INFO)
-	Q_D(Matrix);
-
 	// update rowCount
 	d->rowHeights.clear();
 	d->rowHeights.reserve(d->rowCount());
@@ -136,6 +136,8 @@ Q_SIGNALS:
 	void rowsAboutToBeRemoved(int first, int count);
 	void rowsRemoved(int first, int count);
 	void dataChanged(int top, int left, int bottom, int right);
+	void aboutToBeReset();
+	void reset();
 	void coordinatesChanged();
 
 	void rowCountChanged(int);
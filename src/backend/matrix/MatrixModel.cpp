@@ -38,6 +38,8 @@ MatrixModel::MatrixModel(Matrix* matrix)
 	connect(m_matrix, &Matrix::rowsAboutToBeRemoved, this, &MatrixModel::handleRowsAboutToBeRemoved);
 	connect(m_matrix, &Matrix::rowsRemoved, this, &MatrixModel::handleRowsRemoved);
 	connect(m_matrix, &Matrix::dataChanged, this, &MatrixModel::handleDataChanged);
+	connect(m_matrix, &Matrix::aboutToBeReset, this, &MatrixModel::handleAboutToBeReset);
+	connect(m_matrix, &Matrix::reset, this, &MatrixModel::handleReset);
 	connect(m_matrix, &Matrix::coordinatesChanged, this, &MatrixModel::handleCoordinatesChanged);
 	connect(m_matrix, &Matrix::numericFormatChanged, this, &MatrixModel::handleFormatChanged);
 	connect(m_matrix, &Matrix::precisionChanged, this, &MatrixModel::handleFormatChanged);
@@ -265,6 +267,16 @@ void MatrixModel::handleDataChanged(int top, int left, int bottom, int right) {
 		Q_EMIT changed();
 }
 
+void MatrixModel::handleAboutToBeReset() {
+	beginResetModel();
+}
+
+void MatrixModel::handleReset() {
+	endResetModel();
+	if (!m_suppressDataChangedSignal)
+		Q_EMIT changed();
+}
+
 void MatrixModel::handleCoordinatesChanged() {
 	Q_EMIT headerDataChanged(Qt::Horizontal, 0, columnCount() - 1);
 	Q_EMIT headerDataChanged(Qt::Vertical, 0, rowCount() - 1);
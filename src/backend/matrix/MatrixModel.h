@@ -47,6 +47,8 @@ private Q_SLOTS:
 	void handleRowsAboutToBeRemoved(int first, int count);
 	void handleRowsRemoved(int first, int count);
 	void handleDataChanged(int top, int left, int bottom, int right);
+	void handleAboutToBeReset();
+	void handleReset();
 	void handleCoordinatesChanged();
 	void handleFormatChanged();
 
@@ -12,6 +12,10 @@
 #ifndef MATRIXPRIVATE_H
 #define MATRIXPRIVATE_H
 
+#include "backend/lib/MatrixStorage.h"
+
+#include <vector>
+
 class MatrixPrivate {
 public:
 	explicit MatrixPrivate(Matrix*, AbstractColumn::ColumnMode);
@@ -26,13 +30,19 @@ public:
 		return q->name();
 	}
 
+	//! the data container of the matrix for the value type \c T of the current mode
+	template<typename T>
+	MatrixStorage<T>* storage() const {
+		return static_cast<MatrixStorage<T>*>(data);
+	}
+
 	// get value of cell at row/col (must be defined in header)
 	template<typename T>
 	T cell(int row, int col) const {
 		Q_ASSERT(row >= 0 && row < rowCount());
 		Q_ASSERT(col >= 0 && col < columnCount());
 
-		return (static_cast<QVector<QVector<T>>*>(data))->at(col).at(row);
+		return storage<T>()->at(row, col);
 	}
 
 	// Set value of cell at row/col (must be defined in header)
@@ -41,7 +51,7 @@ public:
 		Q_ASSERT(row >= 0 && row < rowCount());
 		Q_ASSERT(col >= 0 && col < columnCount());
 
-		static_cast<QVector<QVector<T>>*>(data)->operator[](col)[row] = value;
+		(*storage<T>())(row, col) = value;
 
 		if (!suppressDataChange)
 			Q_EMIT q->dataChanged(row, col, row, col);
@@ -53,12 +63,11 @@ public:
 		Q_ASSERT(first_row >= 0 && first_row < currRowCount);
 		Q_ASSERT(last_row >= 0 && last_row < currRowCount);
 
-		if (first_row == 0 && last_row == currRowCount - 1)
-			return (static_cast<QVector<QVector<T>>*>(data))->at(col);
-
+		const auto column = storage<T>()->column(col);
 		QVector<T> result;
+		result.reserve(last_row - first_row + 1);
 		for (int i = first_row; i <= last_row; i++)
-			result.append(static_cast<QVector<QVector<T>>*>(data)->at(col).at(i));
+			result.append(column.at(i));
 		return result;
 	}
 	// set column cells (must be defined in header)
@@ -69,16 +78,9 @@ public:
 		Q_ASSERT(last_row >= 0 && last_row < currRowCount);
 		Q_ASSERT(values.count() > last_row - first_row);
 
-		if (first_row == 0 && last_row == currRowCount - 1) {
-			static_cast<QVector<QVector<T>>*>(data)->operator[](col) = values;
-			static_cast<QVector<QVector<T>>*>(data)->operator[](col).resize(currRowCount); // values may be larger
-			if (!suppressDataChange)
-				Q_EMIT q->dataChanged(first_row, col, last_row, col);
-			return;
-		}
-
+		auto column = storage<T>()->column(col);
 		for (int i = first_row; i <= last_row; i++)
-			static_cast<QVector<QVector<T>>*>(data)->operator[](col)[i] = values.at(i - first_row);
+			column[i] = values.at(i - first_row);
 
 		if (!suppressDataChange)
 			Q_EMIT q->dataChanged(first_row, col, last_row, col);
@@ -89,9 +91,11 @@ public:
 		Q_ASSERT(first_column >= 0 && first_column < columnCount());
 		Q_ASSERT(last_column >= 0 && last_column < columnCount());
 
+		const auto cells = storage<T>()->row(row);
 		QVector<T> result;
+		result.reserve(last_column - first_column + 1);
 		for (int i = first_column; i <= last_column; i++)
-			result.append(static_cast<QVector<QVector<T>>*>(data)->operator[](i)[row]);
+			result.append(cells.at(i));
 		return result;
 	}
 	// set row cells (must be defined in header)
@@ -101,13 +105,17 @@ public:
 		Q_ASSERT(last_column >= 0 && last_column < columnCount());
 		Q_ASSERT(values.count() > last_column - first_column);
 
+		auto cells = storage<T>()->row(row);
 		for (int i = first_column; i <= last_column; i++)
-			static_cast<QVector<QVector<T>>*>(data)->operator[](i)[row] = values.at(i - first_column);
+			cells[i] = values.at(i - first_column);
 		if (!suppressDataChange)
 			Q_EMIT q->dataChanged(row, first_column, row, last_column);
 	}
 
 	void clearColumn(int col);
+	void setMode(AbstractColumn::ColumnMode);
+	static void deleteStorage(void* data, AbstractColumn::ColumnMode);
+	void deleteImportData();
 
 	void setRowHeight(int row, int height) {
 		rowHeights[row] = height;
@@ -130,7 +138,7 @@ public:
 	}
 
 	Matrix* q;
-	void* data;
+	void* data; //!< MatrixStorage<T> with the value type T of the mode
 	AbstractColumn::ColumnMode mode; // mode (data type) of values
 
 	QVector<int> rowHeights; //!< Row widths
@@ -143,6 +151,9 @@ public:
 	double yStart{0.0}, yEnd{1.0};
 	QString formula; //!< formula used to calculate the cells
 	bool suppressDataChange;
+
+	std::vector<void*> importData; //!< containers of the columns filled by the filters during the import, copied into data in finalizeImport()
+	size_t importOffset{0}; //!< first imported column of the matrix in importData
 };
 
 #endif
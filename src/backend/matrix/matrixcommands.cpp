@@ -100,18 +100,28 @@ void MatrixSetFormulaCmd::undo() {
 MatrixReplaceValuesCmd::MatrixReplaceValuesCmd(MatrixPrivate* private_obj, void* new_values, QUndoCommand* parent)
 	: QUndoCommand(parent)
 	, m_private_obj(private_obj)
-	, m_new_values(new_values) {
+	, m_new_values(new_values)
+	, m_mode(private_obj->mode) {
 	setText(i18n("%1: replace values", m_private_obj->name()));
 }
 
+MatrixReplaceValuesCmd::~MatrixReplaceValuesCmd() {
+	// free the values that are not used by the matrix anymore
+	void* unused = m_applied ? m_old_values : m_new_values;
+	if (unused != m_private_obj->data)
+		MatrixPrivate::deleteStorage(unused, m_mode);
+}
+
 void MatrixReplaceValuesCmd::redo() {
 	m_old_values = m_private_obj->data;
 	m_private_obj->data = m_new_values;
+	m_applied = true;
 	m_private_obj->emitDataChanged(0, 0, m_private_obj->rowCount() - 1, m_private_obj->columnCount() - 1);
 }
 
 void MatrixReplaceValuesCmd::undo() {
 	m_new_values = m_private_obj->data;
 	m_private_obj->data = m_old_values;
+	m_applied = false;
 	m_private_obj->emitDataChanged(0, 0, m_private_obj->rowCount() - 1, m_private_obj->columnCount() - 1);
 }
@@ -316,28 +316,19 @@ public:
 		setText(i18n("%1: transpose", m_private_obj->name()));
 	}
 	void redo() override {
-		int rows = m_private_obj->rowCount();
-		int cols = m_private_obj->columnCount();
-		int temp_size = qMax(rows, cols);
-		m_private_obj->suppressDataChange = true;
-		if (cols < rows)
-			m_private_obj->insertColumns(cols, temp_size - cols);
-		else if (cols > rows)
-			m_private_obj->insertRows(rows, temp_size - rows);
-
-		for (int i = 1; i < temp_size; i++) {
-			QVector<T> row = m_private_obj->rowCells<T>(i, 0, i - 1);
-			QVector<T> col = m_private_obj->columnCells<T>(i, 0, i - 1);
-			m_private_obj->setRowCells(i, 0, i - 1, col);
-			m_private_obj->setColumnCells(i, 0, i - 1, row);
-		}
-
-		if (cols < rows)
-			m_private_obj->removeRows(cols, temp_size - cols);
-		else if (cols > rows)
-			m_private_obj->removeColumns(rows, temp_size - rows);
-		m_private_obj->suppressDataChange = false;
-		m_private_obj->emitDataChanged(0, 0, m_private_obj->rowCount() - 1, m_private_obj->columnCount() - 1);
+		auto* matrix = m_private_obj->q;
+		Q_EMIT matrix->aboutToBeReset();
+
+		// swap the dimensions and restore the column-major order of the values, the buffer is rebuilt only once
+		auto* storage = m_private_obj->storage<T>();
+		storage->transpose();
+		storage->setLayout(MatrixStorage<T>::Layout::ColumnMajor);
+		// the heights of the rows become the widths of the columns and vice versa
+		std::swap(m_private_obj->rowHeights, m_private_obj->columnWidths);
+
+		Q_EMIT matrix->reset();
+		Q_EMIT matrix->rowCountChanged(m_private_obj->rowCount());
+		Q_EMIT matrix->columnCountChanged(m_private_obj->columnCount());
 	}
 	void undo() override {
 		redo();
@@ -362,10 +353,12 @@ public:
 		int middle = cols / 2;
 		m_private_obj->suppressDataChange = true;
 
+		auto* storage = m_private_obj->storage<T>();
 		for (int i = 0; i < middle; i++) {
-			QVector<T> temp = m_private_obj->columnCells<T>(i, 0, rows - 1);
-			m_private_obj->setColumnCells(i, 0, rows - 1, m_private_obj->columnCells<T>(cols - i - 1, 0, rows - 1));
-			m_private_obj->setColumnCells(cols - i - 1, 0, rows - 1, temp);
+			auto left = storage->column(i);
+			auto right = storage->column(cols - i - 1);
+			for (int row = 0; row < rows; ++row)
+				std::swap(left[row], right[row]);
 		}
 		m_private_obj->suppressDataChange = false;
 		m_private_obj->emitDataChanged(0, 0, rows - 1, cols - 1);
@@ -393,10 +386,11 @@ public:
 		int middle = rows / 2;
 		m_private_obj->suppressDataChange = true;
 
-		for (int i = 0; i < middle; i++) {
-			QVector<T> temp = m_private_obj->rowCells<T>(i, 0, cols - 1);
-			m_private_obj->setRowCells(i, 0, cols - 1, m_private_obj->rowCells<T>(rows - i - 1, 0, cols - 1));
-			m_private_obj->setRowCells(rows - i - 1, 0, cols - 1, temp);
+		auto* storage = m_private_obj->storage<T>();
+		for (int col = 0; col < cols; col++) {
+			auto column = storage->column(col);
+			for (int i = 0; i < middle; i++)
+				std::swap(column[i], column[rows - i - 1]);
 		}
 
 		m_private_obj->suppressDataChange = false;
@@ -414,6 +408,7 @@ private:
 class MatrixReplaceValuesCmd : public QUndoCommand {
 public:
 	explicit MatrixReplaceValuesCmd(MatrixPrivate*, void* new_values, QUndoCommand* = nullptr);
+	~MatrixReplaceValuesCmd() override;
 	void redo() override;
 	void undo() override;
 
@@ -421,6 +416,8 @@ private:
 	MatrixPrivate* m_private_obj;
 	void* m_old_values{nullptr};
 	void* m_new_values;
+	AbstractColumn::ColumnMode m_mode; //! mode of the matrix defining the type of the values
+	bool m_applied{false}; //! true if the new values are in the matrix
 };
 
 #endif // MATRIX_COMMANDS_H
@@ -17,8 +17,14 @@
 #include "backend/core/AbstractAspect.h"
 #include "backend/core/AspectPrivate.h"
 #include "backend/core/Project.h"
+#include "backend/core/column/ColumnArrow.h"
+#include "backend/core/column/ColumnPrivate.h"
 #include "backend/core/column/ColumnStringIO.h"
 #include "backend/core/datatypes/DateTime2StringFilter.h"
+#include "backend/lib/DateTimeVector.h"
+#include "backend/lib/ParallelSort.h"
+#include "backend/lib/TextDictionary.h"
+#include "backend/lib/UndoMemoryBudget.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/lib/macros.h"
@@ -38,6 +44,8 @@
 #include <QXmlStreamWriter>
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 /*!
   \class Spreadsheet
@@ -109,6 +117,15 @@ void Spreadsheet::setSuppressSetCommentFinalizeImport(bool suppress) {
 	d->suppressSetCommentFinalizeImport = suppress;
 }
 
+/*!
+ * tells the next call of finalizeImport() that the import only appended rows starting at \c row
+ * and didn't change the rows before, e.g. when new data is read from a live data source.
+ */
+void Spreadsheet::setFirstAppendedRowFinalizeImport(int row) {
+	Q_D(Spreadsheet);
+	d->firstAppendedRowFinalizeImport = row;
+}
+
 void Spreadsheet::setModel(SpreadsheetModel* model) {
 	m_model = model;
 }
@@ -672,6 +689,33 @@ void Spreadsheet::setColumnCount(int new_size, QUndoCommand* parent) {
 		insertColumns(old_size, new_size - old_size, parent);
 }
 
+/*!
+ * exports the columns of the spreadsheet as a struct array of the Arrow C data interface, see \c ColumnArrow::exportColumns().
+ * The values of the columns are shared with the consumer, they are not copied.
+ */
+bool Spreadsheet::exportArrow(ArrowArray* array, ArrowSchema* schema, QString* errorString) const {
+	return ColumnArrow::exportColumns(children<Column>(), array, schema, errorString);
+}
+
+/*!
+ * replaces the columns of the spreadsheet by the children of the struct array \c array of the Arrow C data interface,
+ * see \c ColumnArrow::importColumns(). The ownership of the array is taken also if the import fails.
+ */
+bool Spreadsheet::importArrow(ArrowArray* array, const ArrowSchema* schema, QString* errorString) {
+	QVector<Column*> columns;
+	if (!ColumnArrow::importColumns(array, schema, columns, errorString))
+		return false;
+
+	WAIT_CURSOR;
+	beginMacro(i18n("%1: import from Arrow", name()));
+	removeColumns(0, columnCount());
+	for (auto* column : columns)
+		addChild(column);
+	endMacro();
+	RESET_CURSOR;
+	return true;
+}
+
 /*!
  * Clears all values in the spreadsheet.
  */
@@ -764,371 +808,238 @@ void Spreadsheet::moveColumn(int from, int to) {
 	endMacro();
 }
 
+namespace {
 /*!
- * Clears all values in the specified columns.
- * @param cols The columns in the spreadsheet to clear.
+ * returns the sort keys of the first \c rows rows of \c column, the keys are ordered like the values in the sort order.
+ * Invalid values and empty texts are marked in \c invalid, their keys can be equal to the keys of valid values.
  */
-void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, bool ascending) {
-	DEBUG(Q_FUNC_INFO << ", ascending = " << ascending)
-	if (cols.isEmpty())
-		return;
-
-	// the normal QPair comparison does not work properly with descending sorting
-	// therefore we use our own compare functions
-	// TODO: check this. a < b vs. a.first < b.first
-	class CompareFunctions {
-	public:
-		static bool doubleLess(QPair<double, int> a, QPair<double, int> b) {
-			return a.first < b.first;
-		}
-		static bool doubleGreater(QPair<double, int> a, QPair<double, int> b) {
-			return a.first > b.first;
-		}
-		static bool integerLess(QPair<int, int> a, QPair<int, int> b) {
-			return a.first < b.first;
-		}
-		static bool integerGreater(QPair<int, int> a, QPair<int, int> b) {
-			return a.first > b.first;
-		}
-		static bool bigIntLess(QPair<qint64, int> a, QPair<qint64, int> b) {
-			return a.first < b.first;
-		}
-		static bool bigIntGreater(QPair<qint64, int> a, QPair<qint64, int> b) {
-			return a.first > b.first;
-		}
-		static bool QStringLess(const QPair<QString, int>& a, const QPair<QString, int>& b) {
-			return a < b;
-		}
-		static bool QStringGreater(const QPair<QString, int>& a, const QPair<QString, int>& b) {
-			return a > b;
-		}
-		static bool QDateTimeLess(const QPair<QDateTime, int>& a, const QPair<QDateTime, int>& b) {
-			return a < b;
-		}
-		static bool QDateTimeGreater(const QPair<QDateTime, int>& a, const QPair<QDateTime, int>& b) {
-			return a > b;
-		}
-	};
-
-	WAIT_CURSOR;
-	beginMacro(i18n("%1: sort columns", name()));
-
-	if (!leading) { // sort separately
-		DEBUG("	sort separately")
-		for (auto* col : cols) {
-			int rows = col->rowCount();
-			std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-
-			switch (col->columnMode()) {
-			case AbstractColumn::ColumnMode::Double: {
-				QVector<QPair<double, int>> map;
-
-				for (int i = 0; i < rows; i++)
-					if (col->isValid(i))
-						map.append(QPair<double, int>(col->valueAt(i), i));
-				const int filledRows = map.size();
-
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
+std::vector<uint64_t> sortKeys(Column* column, bool ascending, int rows, std::vector<char>& invalid) {
+	std::vector<uint64_t> keys(rows, std::numeric_limits<uint64_t>::max());
+	invalid.assign(rows, 1);
+	const int n = std::min(rows, column->rowCount());
+	const auto setKeys = [&](auto key) {
+		Parallel::forRanges(n, ParallelSort::BlockSize, [&](int start, int end) {
+			for (int i = start; i < end; ++i) {
+				uint64_t value;
+				if (!key(i, value))
+					continue;
+				keys[i] = ascending ? value : ~value;
+				invalid[i] = 0;
 			}
-			case AbstractColumn::ColumnMode::Integer: {
-				QVector<QPair<int, int>> map;
+		});
+	};
 
-				for (int i = 0; i < rows; i++)
-					map.append(QPair<int, int>(col->valueAt(i), i));
+	switch (column->columnMode()) {
+	case AbstractColumn::ColumnMode::Double: {
+		const auto* values = static_cast<QVector<double>*>(column->data())->constData();
+		setKeys([values](int i, uint64_t& key) {
+			if (!std::isfinite(values[i]))
+				return false;
+			key = ParallelSort::key(values[i]);
+			return true;
+		});
+		break;
+	}
+	case AbstractColumn::ColumnMode::Integer: {
+		// the keys of integers fit into 32 bits, the radix sort skips the upper bytes
+		const auto* values = static_cast<QVector<int>*>(column->data())->constData();
+		setKeys([values](int i, uint64_t& key) {
+			key = static_cast<uint64_t>((qint64)values[i] - std::numeric_limits<int>::min());
+			return true;
+		});
+		break;
+	}
+	case AbstractColumn::ColumnMode::BigInt: {
+		const auto* values = static_cast<QVector<qint64>*>(column->data())->constData();
+		setKeys([values](int i, uint64_t& key) {
+			key = ParallelSort::key(values[i]);
+			return true;
+		});
+		break;
+	}
+	case AbstractColumn::ColumnMode::Text: {
+		// the ranks of the dictionary codes are sorted instead of comparing the strings
+		const auto& dictionary = column->dictionary();
+		const auto ranks = dictionary.ranks();
+		setKeys([&dictionary, &ranks](int i, uint64_t& key) {
+			const auto code = dictionary.code(i);
+			if (code == TextDictionary::EmptyCode)
+				return false;
+			key = static_cast<uint64_t>(ranks.at(code));
+			return true;
+		});
+		break;
+	}
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Month:
+	case AbstractColumn::ColumnMode::Day: {
+		const auto* values = static_cast<DateTimeVector*>(column->data())->constData();
+		setKeys([values](int i, uint64_t& key) {
+			if (values[i] == DateTimeVector::InvalidValue)
+				return false;
+			key = ParallelSort::key(values[i]);
+			return true;
+		});
+		break;
+	}
+	}
 
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::integerLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::integerGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < rows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
-			}
-			case AbstractColumn::ColumnMode::BigInt: {
-				QVector<QPair<qint64, int>> map;
+	return keys;
+}
 
-				for (int i = 0; i < rows; i++)
-					map.append(QPair<qint64, int>(col->valueAt(i), i));
+/*!
+ * returns the permutation of the rows sorting them by \c keys, the row \c i of the sorted columns is the row \c permutation[i].
+ * The rows are sorted stably by the first key, rows with equal values by the next key and so on.
+ * Rows with an invalid value in the first key column are not sorted and are kept behind the sorted rows in their order,
+ * invalid values of the other key columns are sorted behind the valid values.
+ */
+std::vector<int> sortPermutation(const QVector<Spreadsheet::SortKey>& keys, int rows) {
+	std::vector<std::vector<uint64_t>> keyValues;
+	std::vector<std::vector<char>> invalidValues(keys.size());
+	for (int i = 0; i < keys.size(); ++i)
+		keyValues.push_back(sortKeys(keys.at(i).column, keys.at(i).ascending, rows, invalidValues[i]));
+	const auto& leadingInvalid = invalidValues.front();
+
+	std::vector<int> permutation, invalidRows;
+	permutation.reserve(rows);
+	for (int i = 0; i < rows; ++i) {
+		if (leadingInvalid.at(i))
+			invalidRows.push_back(i);
+		else
+			permutation.push_back(i);
+	}
 
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < rows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
+	if (keyValues.size() == 1) {
+		// one key: radix sort of the keys of the valid rows
+		std::vector<uint64_t> validKeys(permutation.size());
+		for (size_t i = 0; i < permutation.size(); ++i)
+			validKeys[i] = keyValues.front()[permutation[i]];
+		keyValues.clear();
+		ParallelSort::radixSort(permutation, validKeys);
+	} else {
+		// the invalid flags are compared first, the keys of invalid values are not ordered
+		ParallelSort::stableSort(permutation, [&keyValues, &invalidValues](int a, int b) {
+			for (size_t i = 0; i < keyValues.size(); ++i) {
+				const auto& invalid = invalidValues[i];
+				if (invalid[a] != invalid[b])
+					return invalid[a] < invalid[b];
+				const auto& values = keyValues[i];
+				if (!invalid[a] && values[a] != values[b])
+					return values[a] < values[b];
 			}
-			case AbstractColumn::ColumnMode::Text: {
-				QVector<QPair<QString, int>> map;
+			return false;
+		});
+	}
 
-				for (int i = 0; i < rows; i++)
-					if (!col->textAt(i).isEmpty())
-						map.append(QPair<QString, int>(col->textAt(i), i));
-				const int filledRows = map.size();
+	permutation.insert(permutation.end(), invalidRows.cbegin(), invalidRows.cend());
+	return permutation;
+}
+}
 
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
-			}
-			case AbstractColumn::ColumnMode::DateTime:
-			case AbstractColumn::ColumnMode::Month:
-			case AbstractColumn::ColumnMode::Day: {
-				QVector<QPair<QDateTime, int>> map;
+/*!
+ * \brief Reorders the rows of columns with a permutation.
+ *
+ * Only the permutation is kept to undo the sorting instead of the values of the columns.
+ * The columns are reordered in parallel.
+ */
+class SpreadsheetSortCmd : public QUndoCommand, public UndoCommandMemory {
+public:
+	SpreadsheetSortCmd(Spreadsheet* spreadsheet, const QVector<Column*>& columns, std::vector<int> permutation, QUndoCommand* parent = nullptr)
+		: QUndoCommand(parent)
+		, m_columns(columns)
+		, m_permutation(std::move(permutation)) {
+		setText(i18n("%1: sort columns", spreadsheet->name()));
+	}
 
-				for (int i = 0; i < rows; i++)
-					if (col->isValid(i))
-						map.append(QPair<QDateTime, int>(col->dateTimeAt(i), i));
-				const int filledRows = map.size();
+	void redo() override {
+		permute(false);
+	}
 
-				if (ascending)
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
-				else
-					std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
-
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				break;
-			}
-			}
-			// copy the sorted column
-			col->copy(tempCol.get(), 0, 0, rows);
-		}
-	} else { // sort with leading column
-		DEBUG("	sort with leading column")
-		int rows = leading->rowCount();
-
-		switch (leading->columnMode()) {
-		case AbstractColumn::ColumnMode::Double: {
-			QVector<QPair<double, int>> map;
-			QVector<int> invalidIndex;
-
-			for (int i = 0; i < rows; i++)
-				if (leading->isValid(i))
-					map.append(QPair<double, int>(leading->valueAt(i), i));
-				else
-					invalidIndex << i;
-			const int filledRows = map.size();
-			const int invalidRows = invalidIndex.size();
+	void undo() override {
+		permute(true);
+	}
 
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::doubleGreater);
-
-			for (auto* col : cols) {
-				auto columnMode = col->columnMode();
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), columnMode));
-				// put the values in correct order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
+	qint64 memorySize() const override {
+		return static_cast<qint64>(m_permutation.size() * sizeof(int));
+	}
 
-				// copy the sorted column
-				if (col == leading) // update all rows
-					col->copy(tempCol.get(), 0, 0, rows);
-				else { // do not overwrite unused cols
-					std::unique_ptr<Column> tempInvalidCol(new Column(QStringLiteral("temp2"), col->columnMode()));
-					for (int i = 0; i < invalidRows; i++) {
-						const int idx = invalidIndex.at(i);
-						// too slow: tempInvalidCol->copy(col, idx, i, 1);
-						tempInvalidCol->setFromColumn(i, col, idx);
-						tempInvalidCol->setMasked(col->isMasked(idx));
-					}
-					col->copy(tempCol.get(), 0, 0, filledRows);
-					col->copy(tempInvalidCol.get(), 0, filledRows, invalidRows);
-				}
-			}
-			break;
-		}
-		case AbstractColumn::ColumnMode::Integer: {
-			// TODO: check if still working when invalid integer entries are supported
-			QVector<QPair<int, int>> map;
+	void releaseMemory() override {
+		m_permutation = std::vector<int>();
+	}
 
-			for (int i = 0; i < rows; i++)
-				map.append(QPair<int, int>(leading->valueAt(i), i));
+private:
+	void permute(bool inverse) {
+		if (m_permutation.empty())
+			return;
 
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::integerLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::integerGreater);
-
-			for (auto* col : cols) {
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-				// put the values in the right order into tempCol
-				for (int i = 0; i < rows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				// copy the sorted column
-				col->copy(tempCol.get(), 0, 0, rows);
-			}
-			break;
-		}
-		case AbstractColumn::ColumnMode::BigInt: {
-			QVector<QPair<qint64, int>> map;
+		for (auto* column : m_columns)
+			Q_EMIT column->dataAboutToChange(column);
+		Parallel::forRanges(static_cast<int>(m_columns.size()), 1, [&](int start, int end) {
+			for (int i = start; i < end; ++i)
+				m_columns.at(i)->d->permuteRows(m_permutation, inverse);
+		});
+		for (auto* column : m_columns)
+			column->setChanged();
+	}
 
-			for (int i = 0; i < rows; i++)
-				map.append(QPair<qint64, int>(leading->valueAt(i), i));
+	QVector<Column*> m_columns;
+	std::vector<int> m_permutation; // the row i of the sorted columns is the row m_permutation[i] before sorting
+};
 
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::bigIntGreater);
-
-			for (auto* col : cols) {
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-				// put the values in the right order into tempCol
-				for (int i = 0; i < rows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				// copy the sorted column
-				col->copy(tempCol.get(), 0, 0, rows);
-			}
-			break;
-		}
-		case AbstractColumn::ColumnMode::Text: {
-			QVector<QPair<QString, int>> map;
-			QVector<int> emptyIndex;
+/*!
+ * Sorts the rows of the columns \c cols.
+ * @param leading The column whose values determine the order of the rows of all columns, every column is sorted separately if \c nullptr.
+ * @param cols The columns to sort.
+ * @param ascending Sort in ascending order if \c true, in descending order otherwise.
+ */
+void Spreadsheet::sortColumns(Column* leading, const QVector<Column*>& cols, bool ascending) {
+	DEBUG(Q_FUNC_INFO << ", ascending = " << ascending)
+	if (cols.isEmpty())
+		return;
 
-			for (int i = 0; i < rows; i++)
-				if (!leading->textAt(i).isEmpty())
-					map.append(QPair<QString, int>(leading->textAt(i), i));
-				else
-					emptyIndex << i;
-			// QDEBUG("	empty indices: " << emptyIndex)
-			const int filledRows = map.size();
-			const int emptyRows = emptyIndex.size();
+	WAIT_CURSOR;
+	beginMacro(i18n("%1: sort columns", name()));
+	if (!leading) { // sort separately
+		DEBUG("	sort separately")
+		for (auto* col : cols)
+			sortColumns({SortKey{col, ascending}}, {col});
+	} else
+		sortColumns({SortKey{leading, ascending}}, cols);
+	endMacro();
+	RESET_CURSOR;
+}
 
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QStringGreater);
-
-			for (auto* col : cols) {
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
+/*!
+ * Sorts the rows of the columns \c cols by the values of the key columns \c keys, rows with equal values
+ * in the first key column are sorted by the next key column and so on. Each key has its own sort order.
+ * The sort is stable, see \c sortPermutation() for the handling of invalid values.
+ *
+ * The permutation of the rows is determined once with a radix sort for one key and a parallel merge sort for several keys
+ * and is applied to all columns in parallel. Only the first \c rowCount() rows of the first key column are sorted,
+ * columns with less rows are not changed.
+ */
+void Spreadsheet::sortColumns(const QVector<SortKey>& keys, const QVector<Column*>& cols) {
+	if (keys.isEmpty() || cols.isEmpty())
+		return;
 
-				// copy the sorted column
-				if (col == leading) // update all rows
-					col->copy(tempCol.get(), 0, 0, rows);
-				else { // do not overwrite unused cols
-					std::unique_ptr<Column> tempEmptyCol(new Column(QStringLiteral("temp2"), col->columnMode()));
-					for (int i = 0; i < emptyRows; i++) {
-						const int idx = emptyIndex.at(i);
-						// too slow: tempEmptyCol->copy(col, idx, i, 1);
-						tempEmptyCol->setFromColumn(i, col, idx);
-						tempEmptyCol->setMasked(col->isMasked(idx));
-					}
-					col->copy(tempCol.get(), 0, 0, filledRows);
-					col->copy(tempEmptyCol.get(), 0, filledRows, emptyRows);
-				}
-			}
-			break;
-		}
-		case AbstractColumn::ColumnMode::DateTime:
-		case AbstractColumn::ColumnMode::Month:
-		case AbstractColumn::ColumnMode::Day: {
-			QVector<QPair<QDateTime, int>> map;
-			QVector<int> invalidIndex;
-
-			for (int i = 0; i < rows; i++)
-				if (leading->isValid(i))
-					map.append(QPair<QDateTime, int>(leading->dateTimeAt(i), i));
-				else
-					invalidIndex << i;
-			const int filledRows = map.size();
-			const int invalidRows = invalidIndex.size();
+	PERFTRACE(QLatin1String(Q_FUNC_INFO));
+	const int rows = keys.first().column->rowCount();
+	auto permutation = sortPermutation(keys, rows);
+
+	// nothing to do if the rows are already sorted
+	bool sorted = true;
+	for (int i = 0; i < rows && sorted; ++i)
+		sorted = (permutation[i] == i);
+	if (sorted)
+		return;
 
-			if (ascending)
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeLess);
-			else
-				std::stable_sort(map.begin(), map.end(), CompareFunctions::QDateTimeGreater);
-
-			for (auto* col : cols) {
-				std::unique_ptr<Column> tempCol(new Column(QStringLiteral("temp"), col->columnMode()));
-				// put the values in the right order into tempCol
-				for (int i = 0; i < filledRows; i++) {
-					int idx = map.at(i).second;
-					// too slow: tempCol->copy(col, idx, i, 1);
-					tempCol->setFromColumn(i, col, idx);
-					tempCol->setMasked(col->isMasked(idx));
-				}
-				// copy the sorted column
-				if (col == leading) // update all rows
-					col->copy(tempCol.get(), 0, 0, rows);
-				else { // do not overwrite unused cols
-					std::unique_ptr<Column> tempInvalidCol(new Column(QStringLiteral("temp2"), col->columnMode()));
-					for (int i = 0; i < invalidRows; i++) {
-						const int idx = invalidIndex.at(i);
-						// too slow: tempInvalidCol->copy(col, idx, i, 1);
-						tempInvalidCol->setFromColumn(i, col, idx);
-						tempInvalidCol->setMasked(col->isMasked(idx));
-					}
-					col->copy(tempCol.get(), 0, 0, filledRows);
-					col->copy(tempInvalidCol.get(), 0, filledRows, invalidRows);
-				}
-			}
-			break;
-		}
-		}
+	QVector<Column*> columns;
+	for (auto* col : cols) {
+		if (col->rowCount() >= rows)
+			columns << col;
 	}
-
-	endMacro();
-	RESET_CURSOR;
-} // end of sortColumns()
+	exec(new SpreadsheetSortCmd(this, columns, std::move(permutation)));
+}
 
 /*!
   Returns an icon to be used for decorating my views.
@@ -1425,7 +1336,7 @@ int Spreadsheet::prepareImport(std::vector<void*>& dataContainer,
 			case AbstractColumn::ColumnMode::Month:
 			case AbstractColumn::ColumnMode::Day:
 			case AbstractColumn::ColumnMode::DateTime: {
-				auto* vector = static_cast<QVector<QDateTime>*>(column->data());
+				auto* vector = static_cast<DateTimeVector*>(column->data());
 				dataContainer[n] = static_cast<void*>(vector);
 				break;
 			}
@@ -1552,6 +1463,7 @@ void Spreadsheet::finalizeImport(size_t columnOffset,
 	CleanupNoArguments cleanup([d]() {
 		d->m_usedInPlots.clear();
 		d->m_involvedColumns.clear();
+		d->firstAppendedRowFinalizeImport = -1;
 	});
 
 	// determine the dependent plots
@@ -1611,9 +1523,16 @@ void Spreadsheet::finalizeImport(size_t columnOffset,
 
 		if (columnImportMode == AbstractFileFilter::ImportMode::Replace) {
 			column->setSuppressDataChangedSignal(true);
-			column->setChanged(); // Invalidate properties
+			if (d->firstAppendedRowFinalizeImport > 0)
+				column->setRowsAppended(d->firstAppendedRowFinalizeImport);
+			else
+				column->setChanged(); // Invalidate properties
 			column->setSuppressDataChangedSignal(false);
 		}
+
+		// share the data of equal strings, imported text columns are often categorical
+		if (column->columnMode() == AbstractColumn::ColumnMode::Text)
+			column->encodeTexts();
 	}
 
 	if (columnImportMode == AbstractFileFilter::ImportMode::Replace) {
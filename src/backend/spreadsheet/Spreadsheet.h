@@ -16,6 +16,8 @@
 #include "backend/lib/macros.h"
 
 class AbstractFileFilter;
+struct ArrowArray;
+struct ArrowSchema;
 class SpreadsheetView;
 class SpreadsheetModel;
 class SpreadsheetPrivate;
@@ -68,6 +70,9 @@ public:
 	void save(QXmlStreamWriter*) const override;
 	bool load(XmlStreamReader*, bool preview) override;
 
+	bool exportArrow(ArrowArray*, ArrowSchema*, QString* errorString = nullptr) const;
+	bool importArrow(ArrowArray*, const ArrowSchema*, QString* errorString = nullptr);
+
 	void setColumnSelectedInView(int index, bool selected);
 
 	// used from model to inform dock
@@ -90,8 +95,16 @@ public:
 					  bool& ok,
 					  bool initializeContainer) override;
 	void finalizeImport(size_t columnOffset, size_t startColumn, size_t endColumn, const QString& dateTimeFormat, AbstractFileFilter::ImportMode) override;
+	void setFirstAppendedRowFinalizeImport(int);
 	int resize(AbstractFileFilter::ImportMode, const QStringList& colNameList, int cols);
 
+	//! column determining the order of the rows when sorting and its sort order
+	struct SortKey {
+		Column* column{nullptr};
+		bool ascending{true};
+	};
+	void sortColumns(const QVector<SortKey>& keys, const QVector<Column*>&);
+
 	struct Linking {
 		bool linking{false};
 		const Spreadsheet* linkedSpreadsheet{nullptr};
@@ -13,6 +13,7 @@ public:
 
 public:
 	bool suppressSetCommentFinalizeImport{false};
+	int firstAppendedRowFinalizeImport{-1}; // first row appended by the import in finalizeImport(), -1 if all rows were replaced
 	Spreadsheet::Linking linking;
 	Spreadsheet* q{nullptr};
 	StatisticsSpreadsheet* statisticsSpreadsheet{nullptr};
@@ -8,6 +8,7 @@
 	SPDX-License-Identifier: GPL-2.0-or-later
 */
 #include "backend/worksheet/plots/cartesian/CartesianCoordinateSystem.h"
+#include "backend/lib/XYPoints.h"
 #include "backend/lib/macros.h"
 #include "backend/worksheet/plots/cartesian/CartesianCoordinateSystemPrivate.h"
 #include "backend/worksheet/plots/cartesian/CartesianPlot.h"
@@ -180,6 +181,25 @@ void CartesianCoordinateSystem::mapLogicalToScene(int startIndex,
 												  Points& scenePoints,
 												  std::vector<bool>& visiblePoints,
 												  MappingFlags flags) const {
+	mapPointsToScene(startIndex, endIndex, logicalPoints, scenePoints, visiblePoints, flags);
+}
+
+void CartesianCoordinateSystem::mapLogicalToScene(int startIndex,
+												  int endIndex,
+												  const XYPoints& logicalPoints,
+												  Points& scenePoints,
+												  std::vector<bool>& visiblePoints,
+												  MappingFlags flags) const {
+	mapPointsToScene(startIndex, endIndex, logicalPoints, scenePoints, visiblePoints, flags);
+}
+
+template<typename LogicalPoints>
+void CartesianCoordinateSystem::mapPointsToScene(int startIndex,
+												 int endIndex,
+												 const LogicalPoints& logicalPoints,
+												 Points& scenePoints,
+												 std::vector<bool>& visiblePoints,
+												 MappingFlags flags) const {
 	// DEBUG(Q_FUNC_INFO << ", (curve points)")
 	const QRectF pageRect = d->plot->dataRect();
 	const bool noPageClipping = pageRect.isNull() || (flags & MappingFlag::SuppressPageClipping);
@@ -194,13 +214,18 @@ void CartesianCoordinateSystem::mapLogicalToScene(int startIndex,
 	if (numberOfPixelX <= 0 || numberOfPixelY <= 0)
 		return;
 
-	// eliminate multiple scene points (size (numberOfPixelX + 1) * (numberOfPixelY + 1))
-	QVector<QVector<bool>> scenePointsUsed(numberOfPixelX + 1);
-	for (auto& col : scenePointsUsed)
-		col.resize(numberOfPixelY + 1);
+	// eliminate multiple scene points (size (numberOfPixelX + 1) * (numberOfPixelY + 1)).
+	// the grid is kept in the coordinate system and reused for all curves and retransforms.
+	auto& scenePointsUsed = d->scenePointsUsed;
+	scenePointsUsed.reset(numberOfPixelX + 1, numberOfPixelY + 1);
 
 	// DEBUG(Q_FUNC_INFO << ", xScales/YScales size: " << d->xScales.size() << '/' << d->yScales.size())
 
+	// the x and y values are mapped in blocks, the mapping of linear scales is vectorized by the compiler
+	static const int blockSize = 1024;
+	double xValues[blockSize], yValues[blockSize];
+	unsigned char xValid[blockSize], yValid[blockSize];
+
 	for (const auto* xScale : d->xScales) {
 		if (!xScale)
 			continue;
@@ -209,39 +234,47 @@ void CartesianCoordinateSystem::mapLogicalToScene(int startIndex,
 			if (!yScale)
 				continue;
 
-			for (int i = startIndex; i <= endIndex; i++) {
-				const QPointF& point = logicalPoints.at(i);
-
-				double x = point.x(), y = point.y();
-				if (!xScale->contains(x) || !yScale->contains(y))
-					continue;
-				if (!xScale->map(&x) || !yScale->map(&y))
-					continue;
-
-				if (limit) {
-					// set to max/min if passed over
-					x = qBound(xPage, x, xPage + w);
-					y = qBound(yPage, y, yPage + h);
+			for (int blockStart = startIndex; blockStart <= endIndex; blockStart += blockSize) {
+				const int count = std::min(blockSize, endIndex - blockStart + 1);
+				for (int k = 0; k < count; ++k) {
+					const QPointF point = logicalPoints.at(blockStart + k);
+					xValues[k] = point.x();
+					yValues[k] = point.y();
 				}
+				xScale->mapValues(xValues, xValid, count);
+				yScale->mapValues(yValues, yValid, count);
 
-				if (noPageClippingY)
-					y = yPage + h / 2.;
-
-				const QPointF mappedPoint(x, y);
-				// DEBUG(mappedPoint.x() << ' ' << mappedPoint.y())
-				if (noPageClipping || limit || rectContainsPoint(pageRect, mappedPoint)) {
-					// TODO: check
-					const int indexX = std::round(x - xPage);
-					const int indexY = std::round(y - yPage);
-					if (scenePointsUsed.at(indexX).at(indexY))
+				for (int k = 0; k < count; ++k) {
+					if (!xValid[k] || !yValid[k])
 						continue;
 
-					scenePointsUsed[indexX][indexY] = true;
-					scenePoints.append(mappedPoint);
+					const int i = blockStart + k;
+					double x = xValues[k], y = yValues[k];
+					if (limit) {
+						// set to max/min if passed over
+						x = qBound(xPage, x, xPage + w);
+						y = qBound(yPage, y, yPage + h);
+					}
+
+					if (noPageClippingY)
+						y = yPage + h / 2.;
+
+					const QPointF mappedPoint(x, y);
 					// DEBUG(mappedPoint.x() << ' ' << mappedPoint.y())
-					visiblePoints[i] = true;
-				} else
-					visiblePoints[i] = false;
+					if (noPageClipping || limit || rectContainsPoint(pageRect, mappedPoint)) {
+						// TODO: check
+						const int indexX = std::round(x - xPage);
+						const int indexY = std::round(y - yPage);
+						// points outside of the data rect (no page clipping) are not de-duplicated
+						if (indexX >= 0 && indexX <= numberOfPixelX && indexY >= 0 && indexY <= numberOfPixelY && scenePointsUsed.testAndSet(indexX, indexY))
+							continue;
+
+						scenePoints.append(mappedPoint);
+						// DEBUG(mappedPoint.x() << ' ' << mappedPoint.y())
+						visiblePoints[i] = true;
+					} else
+						visiblePoints[i] = false;
+				}
 			}
 		}
 	}
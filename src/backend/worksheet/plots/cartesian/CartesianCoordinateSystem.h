@@ -16,6 +16,7 @@
 class CartesianCoordinateSystemPrivate;
 class CartesianCoordinateSystemSetScalePropertiesCmd;
 class CartesianPlot;
+class XYPoints;
 
 #ifdef SDK
 #include "labplot_export.h"
@@ -45,6 +46,12 @@ public:
 						   Points& scenePoints,
 						   std::vector<bool>& visiblePoints,
 						   MappingFlags flags = MappingFlag::DefaultMapping) const;
+	void mapLogicalToScene(int startIndex,
+						   int endIndex,
+						   const XYPoints& logicalPoints,
+						   Points& scenePoints,
+						   std::vector<bool>& visiblePoints,
+						   MappingFlags flags = MappingFlag::DefaultMapping) const;
 	QPointF mapLogicalToScene(QPointF, bool& visible, MappingFlags flags = MappingFlag::DefaultMapping) const override;
 	Lines mapLogicalToScene(const Lines&, MappingFlags flags = MappingFlag::DefaultMapping) const override;
 	Points mapSceneToLogical(const Points&, MappingFlags flags = MappingFlag::DefaultMapping) const override;
@@ -62,6 +69,8 @@ public:
 private:
 	void init();
 	bool rectContainsPoint(const QRectF&, QPointF) const;
+	template<typename LogicalPoints>
+	void mapPointsToScene(int startIndex, int endIndex, const LogicalPoints&, Points& scenePoints, std::vector<bool>& visiblePoints, MappingFlags) const;
 	CartesianCoordinateSystemPrivate* d;
 };
 
@@ -12,6 +12,8 @@
 #ifndef CARTESIANCOORDINATESYSTEMPRIVATE_H
 #define CARTESIANCOORDINATESYSTEMPRIVATE_H
 
+#include "backend/lib/BitGrid.h"
+
 class CartesianCoordinateSystemPrivate {
 public:
 	explicit CartesianCoordinateSystemPrivate(CartesianCoordinateSystem* owner);
@@ -22,6 +24,7 @@ public:
 	QVector<CartesianScale*> xScales;
 	QVector<CartesianScale*> yScales;
 	int xIndex{0}, yIndex{0}; // indices of x/y plot ranges used here
+	BitGrid scenePointsUsed; // pixels occupied by mapped points, reused in mapLogicalToScene()
 };
 
 #endif
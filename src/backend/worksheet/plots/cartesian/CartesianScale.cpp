@@ -37,6 +37,15 @@ void CartesianScale::getProperties(Range<double>* range, double* a, double* b, d
 		*c = m_c;
 }
 
+/*!
+ * maps the \c count \c values in place. \c valid is set to \c false for values outside of the range
+ * or values which can't be mapped, the mapped value is undefined in this case.
+ */
+void CartesianScale::mapValues(double* values, unsigned char* valid, int count) const {
+	for (int i = 0; i < count; ++i)
+		valid[i] = contains(values[i]) && map(&values[i]);
+}
+
 /**
  * \class CartesianCoordinateSystem::LinearScale
  * \brief implementation of a linear scale for cartesian coordinate systems
@@ -56,6 +65,15 @@ public:
 		return true;
 	}
 
+	void mapValues(double* values, unsigned char* valid, int count) const override {
+		const double min = std::min(m_range.start(), m_range.end());
+		const double max = std::max(m_range.start(), m_range.end());
+		for (int i = 0; i < count; ++i) {
+			valid[i] = (min <= values[i] && values[i] <= max);
+			values[i] = values[i] * m_b + m_a;
+		}
+	}
+
 	bool inverseMap(double* value) const override {
 		*value = (*value - m_a) / m_b;
 		return true;
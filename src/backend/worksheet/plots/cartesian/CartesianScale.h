@@ -45,6 +45,7 @@ public:
 	}
 
 	virtual bool map(double*) const = 0;
+	virtual void mapValues(double* values, unsigned char* valid, int count) const;
 	virtual bool inverseMap(double*) const = 0;
 	virtual int direction() const = 0;
 
@@ -13,6 +13,7 @@
 #include "backend/core/Project.h"
 #include "backend/core/Settings.h"
 #include "backend/gsl/errors.h"
+#include "backend/lib/Parallel.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/lib/macrosCurve.h"
@@ -843,6 +844,7 @@ void XYCurve::xColumnAboutToBeRemoved(const AbstractAspect* aspect) {
 	if (aspect == d->xColumn) {
 		d->xColumn = nullptr;
 		d->m_logicalPoints.clear();
+		d->m_levelOfDetail.clear();
 		CURVE_COLUMN_REMOVED(x);
 	}
 }
@@ -852,6 +854,7 @@ void XYCurve::yColumnAboutToBeRemoved(const AbstractAspect* aspect) {
 	if (aspect == d->yColumn) {
 		d->yColumn = nullptr;
 		d->m_logicalPoints.clear();
+		d->m_levelOfDetail.clear();
 		CURVE_COLUMN_REMOVED(y);
 	}
 }
@@ -925,11 +928,6 @@ void XYCurvePrivate::calculateScenePoints() {
 			}
 			DEBUG("	numberOfPixelX/numberOfPixelY = " << numberOfPixelX << '/' << numberOfPixelY)
 
-			// eliminate multiple scene points (size (numberOfPixelX + 1) * (numberOfPixelY + 1)) TODO: why "+1"
-			QVector<QVector<bool>> scenePointsUsed(numberOfPixelX + 1);
-			for (auto& col : scenePointsUsed)
-				col.resize(numberOfPixelY + 1);
-
 			const auto& columnProperties = xColumn->properties();
 			int startIndex, endIndex;
 			if (columnProperties == AbstractColumn::Properties::MonotonicDecreasing || columnProperties == AbstractColumn::Properties::MonotonicIncreasing) {
@@ -1026,7 +1024,7 @@ void XYCurvePrivate::recalc() {
 	m_pointVisible.clear();
 	m_logicalPoints.clear();
 	connectedPointsLogical.clear();
-	validPointsIndicesLogical.clear();
+	m_levelOfDetail.clear();
 
 	if (!xColumn || !yColumn)
 		return;
@@ -1034,12 +1032,49 @@ void XYCurvePrivate::recalc() {
 	auto xColMode = xColumn->columnMode();
 	auto yColMode = yColumn->columnMode();
 	const int rows = xColumn->rowCount();
+
+	// the data of double columns without invalid and masked values is used directly without copying the points.
+	// columns with values in a cache file are read row by row to not load them into memory
+	const auto* x = dynamic_cast<const Column*>(xColumn);
+	const auto* y = dynamic_cast<const Column*>(yColumn);
+	if (x && y && !x->hasCacheFile() && !y->hasCacheFile() && x->data() && y->data() && xColMode == AbstractColumn::ColumnMode::Double && yColMode == AbstractColumn::ColumnMode::Double
+		&& yColumn->rowCount() >= rows && xColumn->maskedIntervals().isEmpty() && yColumn->maskedIntervals().isEmpty()) {
+		const auto& xData = *static_cast<QVector<double>*>(x->data());
+		const auto& yData = *static_cast<QVector<double>*>(y->data());
+		std::atomic<bool> valid{true};
+		Parallel::forRanges(rows, 100000, [&](int start, int end) {
+			bool rangeValid = true;
+			for (int row = start; row < end; ++row)
+				rangeValid = rangeValid && std::isfinite(xData.at(row)) && std::isfinite(yData.at(row));
+			if (!rangeValid)
+				valid = false;
+		});
+
+		if (valid) {
+			m_logicalPoints.share(xData, yData, rows);
+			connectedPointsLogical.assign(rows, true);
+			m_pointVisible.resize(rows);
+			return;
+		}
+	}
+
 	m_logicalPoints.reserve(rows);
 
-	// take only valid and non masked points
+	// take only valid and non masked points, the runs of masked rows are skipped as a whole
+	int nextMasked = std::min(xColumn->nextMaskedRow(0), yColumn->nextMaskedRow(0));
 	for (int row = 0; row < rows; row++) {
+		if (row == nextMasked) {
+			while (row < rows && (xColumn->isMasked(row) || yColumn->isMasked(row)))
+				row = std::max(xColumn->nextUnmaskedRow(row), yColumn->nextUnmaskedRow(row));
+			nextMasked = std::min(xColumn->nextMaskedRow(row), yColumn->nextMaskedRow(row));
+			if (!connectedPointsLogical.empty())
+				connectedPointsLogical[connectedPointsLogical.size() - 1] = false;
+			if (row >= rows)
+				break;
+		}
+
 		// DEBUG("row = " << row << " valid x/y = " << xColumn->isValid(row) << " " << yColumn->isValid(row))
-		if (xColumn->isValid(row) && yColumn->isValid(row) && (!xColumn->isMasked(row)) && (!yColumn->isMasked(row))) {
+		if (xColumn->isValid(row) && yColumn->isValid(row)) {
 			QPointF tempPoint;
 
 			switch (xColMode) {
@@ -1083,7 +1118,6 @@ void XYCurvePrivate::recalc() {
 			m_logicalPoints.append(tempPoint);
 			// TODO: append, resize-reserve
 			connectedPointsLogical.push_back(true);
-			validPointsIndicesLogical.push_back(row);
 		} else {
 			if (!connectedPointsLogical.empty())
 				connectedPointsLogical[connectedPointsLogical.size() - 1] = false;
@@ -1196,6 +1230,60 @@ void XYCurvePrivate::addUniqueLine(QPointF p, double& minY, double& maxY, QPoint
 	}
 }
 
+/*!
+ * builds the min/max decimation of the logical points used in updateLines() for large curves with monotonic increasing x.
+ * Every block of 2^(k + LevelOfDetailBaseLevel) points on level k stores the indices of the points with the minimal and maximal y.
+ * The decimation is built once after the data was changed, zooming and panning only select the blocks matching the pixels of the plot.
+ */
+void XYCurvePrivate::updateLevelOfDetail() {
+	m_levelOfDetail.clear();
+	const int numberOfPoints = m_logicalPoints.size();
+	const int baseSize = 1 << LevelOfDetailBaseLevel;
+	if (numberOfPoints < 2 * baseSize)
+		return;
+#if PERFTRACE_CURVES
+	PERFTRACE(QLatin1String(Q_FUNC_INFO) + QStringLiteral(", curve ") + name());
+#endif
+
+	const auto& points = m_logicalPoints;
+	std::vector<LevelOfDetailBlock> blocks(numberOfPoints / baseSize);
+	Parallel::forRanges(static_cast<int>(blocks.size()), 1024, [&](int start, int end) {
+		for (int b = start; b < end; ++b) {
+			const int first = b * baseSize;
+			auto& block = blocks[b];
+			block.minIndex = first;
+			block.maxIndex = first;
+			block.gap = false;
+			for (int i = first + 1; i < first + baseSize; ++i) {
+				const double y = points.at(i).y();
+				if (y < points.at(block.minIndex).y())
+					block.minIndex = i;
+				if (y > points.at(block.maxIndex).y())
+					block.maxIndex = i;
+				if (!connectedPointsLogical.at(i - 1))
+					block.gap = true;
+			}
+		}
+	});
+	m_levelOfDetail.push_back(std::move(blocks));
+
+	// every block of the next level combines two blocks
+	while (m_levelOfDetail.back().size() >= 2) {
+		const auto& below = m_levelOfDetail.back();
+		const int belowSize = 1 << (LevelOfDetailBaseLevel + m_levelOfDetail.size() - 1);
+		std::vector<LevelOfDetailBlock> level(below.size() / 2);
+		for (size_t b = 0; b < level.size(); ++b) {
+			const auto& left = below.at(2 * b);
+			const auto& right = below.at(2 * b + 1);
+			auto& block = level[b];
+			block.minIndex = points.at(right.minIndex).y() < points.at(left.minIndex).y() ? right.minIndex : left.minIndex;
+			block.maxIndex = points.at(right.maxIndex).y() > points.at(left.maxIndex).y() ? right.maxIndex : left.maxIndex;
+			block.gap = left.gap || right.gap || !connectedPointsLogical.at((2 * b + 1) * belowSize - 1);
+		}
+		m_levelOfDetail.push_back(std::move(level));
+	}
+}
+
 /*!
   recalculates the painter path for the lines connecting the data points.
   Called each time when the type of this connection is changed.
@@ -1339,7 +1427,7 @@ void XYCurvePrivate::updateLines(bool performanceOptimization) {
 #if PERFTRACE_CURVES
 				PERFTRACE(name() + QLatin1String(Q_FUNC_INFO) + QStringLiteral(", find relevant lines"));
 #endif
-				for (int i{startIndex}; i <= endIndex; i++) {
+				const auto addPoint = [&](int i) {
 					p1 = m_logicalPoints.at(i);
 					if (!lineSkipGaps && (i > startIndex && !connectedPointsLogical.at(i - 1))) {
 						if (pixelDiff == 0)
@@ -1347,13 +1435,61 @@ void XYCurvePrivate::updateLines(bool performanceOptimization) {
 						prevPixelDiffZero = false;
 						p0 = p1;
 						lastPoint = p1;
-						continue;
+						return;
 					}
 
 					if (lineIncreasingXOnly && (p1.x() < p0.x())) // skip points
-						continue;
+						return;
 					addLine(p1, xPos, minY, maxY, lastPoint, pixelDiff, numberOfPixelX, minDiffX, scale, prevPixelDiffZero, performanceOptimization);
 					p0 = p1;
+				};
+
+				if (performanceOptimization && scale == RangeT::Scale::Linear && columnProperties == AbstractColumn::Properties::MonotonicIncreasing
+					&& m_levelOfDetailEnabled && m_logicalPoints.size() >= LevelOfDetailMinPoints && std::isfinite(minDiffX) && minDiffX > 0) {
+					// all points of a block lying on the same pixel only contribute with the first and the last point and the points
+					// with the minimal and maximal y to the lines. Use the largest of such blocks to only add O(pixels) points
+					// resulting in the same lines as adding all points.
+					if (m_levelOfDetail.empty())
+						updateLevelOfDetail();
+
+					const auto pixel = [&](int i) {
+						return std::round(m_logicalPoints.at(i).x() / minDiffX);
+					};
+					int i = startIndex;
+					while (i <= endIndex) {
+						int level = static_cast<int>(m_levelOfDetail.size()) - 1;
+						int size = 0;
+						for (; level >= 0; --level) {
+							size = 1 << (level + LevelOfDetailBaseLevel);
+							if (i % size != 0 || i + size - 1 > endIndex)
+								continue;
+							const auto& block = m_levelOfDetail.at(level).at(i / size);
+							if (!lineSkipGaps && (block.gap || (i > startIndex && !connectedPointsLogical.at(i - 1))))
+								continue;
+							if (pixel(i) == pixel(i + size - 1))
+								break;
+						}
+
+						if (level < 0) {
+							addPoint(i);
+							++i;
+							continue;
+						}
+
+						// first point, minimum and maximum in the order of their indices and last point
+						const auto& block = m_levelOfDetail.at(level).at(i / size);
+						const int indices[] = {i, std::min(block.minIndex, block.maxIndex), std::max(block.minIndex, block.maxIndex), i + size - 1};
+						int prevIndex = -1;
+						for (int index : indices) {
+							if (index != prevIndex)
+								addPoint(index);
+							prevIndex = index;
+						}
+						i += size;
+					}
+				} else {
+					for (int i{startIndex}; i <= endIndex; i++)
+						addPoint(i);
 				}
 
 				if (pixelDiff == 0)
@@ -2439,11 +2575,15 @@ bool XYCurve::minMax(const AbstractColumn* column1,
 		return false;
 
 	// when property is increasing or decreasing there is a benefit in finding minimum and maximum
-	// for property == AbstractColumn::Properties::No it must be iterated over all values so it does not matter if this function or the below one is used
 	// if the property of the second column is not AbstractColumn::Properties::No means, that all values are valid and not masked
+	// for property == AbstractColumn::Properties::No of the first column the minimum and maximum of numeric columns skip the invalid and masked values
+	// and are determined with the min/max index of the column for large columns
 	// DEBUG(Q_FUNC_INFO << "\n, column 1 min/max = " << column1->minimum() << "/" << column1->maximum())
-	if ((!includeErrorBars || errorType == ErrorBar::ErrorType::NoError) && column1->properties() != AbstractColumn::Properties::No && column2
-		&& column2->properties() != AbstractColumn::Properties::No) {
+	const auto mode1 = column1->columnMode();
+	const bool column1Indexed = (mode1 == AbstractColumn::ColumnMode::Double || mode1 == AbstractColumn::ColumnMode::Integer
+								 || mode1 == AbstractColumn::ColumnMode::BigInt || mode1 == AbstractColumn::ColumnMode::DateTime);
+	if ((!includeErrorBars || errorType == ErrorBar::ErrorType::NoError) && (column1Indexed || column1->properties() != AbstractColumn::Properties::No)
+		&& column2 && column2->properties() != AbstractColumn::Properties::No) {
 		const auto min = column1->minimum(indexRange.start(), indexRange.end());
 		const auto max = column1->maximum(indexRange.start(), indexRange.end());
 		DEBUG(Q_FUNC_INFO << "\n, column 1 min/max in index range = " << min << "/" << max)
@@ -2745,7 +2885,7 @@ void XYCurvePrivate::updateErrorBars() {
 	}
 
 	calculateScenePoints();
-	errorBarsPath = errorBar->painterPath(m_logicalPoints, q->cSystem);
+	errorBarsPath = errorBar->painterPath(m_logicalPoints.toVector(), q->cSystem);
 	recalcShapeAndBoundingRect();
 }
 
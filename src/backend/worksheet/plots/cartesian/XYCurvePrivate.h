@@ -12,6 +12,7 @@
 #ifndef XYCURVEPRIVATE_H
 #define XYCURVEPRIVATE_H
 
+#include "backend/lib/XYPoints.h"
 #include "backend/worksheet/plots/cartesian/PlotPrivate.h"
 #include <vector>
 
@@ -46,6 +47,7 @@ public:
 							  int& pixelDiff,
 							  QVector<QLineF>& lines,
 							  bool& prevPixelDiffZero); // finally add line if unique (no overlay)
+	void updateLevelOfDetail();
 	void updateDropLines();
 	void updateSymbols();
 	void updateRug();
@@ -134,17 +136,26 @@ private:
 	QPainterPath errorBarsPath;
 	QPainterPath symbolsPath;
 	QVector<QLineF> m_lines;
-	QVector<QPointF> m_logicalPoints; // points in logical coordinates
+	XYPoints m_logicalPoints; // points in logical coordinates, shares the data of the columns if possible (see recalc())
 	QVector<QPointF> m_scenePoints; // points in scene coordinates
 	bool m_scenePointsDirty{true}; // true whenever the scenepoints have to be recalculated before using
 	std::vector<bool> m_pointVisible; // if point is currently visible in plot (size of m_logicalPoints)
 	QVector<QPointF> m_valuePoints; // points for showing value
 	QVector<QString> m_valueStrings; // strings for showing value
 	QVector<QPolygonF> m_fillPolygons; // polygons for filling
-	// TODO: QVector, rename, usage
-	std::vector<int> validPointsIndicesLogical; // original indices in the source columns for valid and non-masked values (size of m_logicalPoints)
 	std::vector<bool> connectedPointsLogical; // true for points connected with the consecutive point (size of m_logicalPoints)
 
+	// min/max decimation of m_logicalPoints used to draw the lines of large curves, see updateLevelOfDetail()
+	struct LevelOfDetailBlock {
+		int minIndex; // index of the point with the minimal y in the block
+		int maxIndex; // index of the point with the maximal y in the block
+		bool gap; // true if not all points of the block are connected
+	};
+	static constexpr int LevelOfDetailBaseLevel = 4; // the blocks of level 0 contain 2^LevelOfDetailBaseLevel points
+	static constexpr int LevelOfDetailMinPoints = 100000; // smaller curves are drawn without the decimation
+	std::vector<std::vector<LevelOfDetailBlock>> m_levelOfDetail; // level k contains the blocks of 2^(k + LevelOfDetailBaseLevel) points
+	bool m_levelOfDetailEnabled{true};
+
 	QPointF mousePos;
 
 	friend class RetransformTest;
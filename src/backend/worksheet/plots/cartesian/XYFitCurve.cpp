@@ -14,10 +14,12 @@
 #include "backend/gsl/ExpressionParser.h"
 #include "backend/gsl/Parser.h"
 #include "backend/gsl/errors.h"
+#include "backend/lib/Parallel.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/commandtemplates.h"
 #include "backend/nsl/nsl_sf_stats.h"
 #include "backend/nsl/nsl_stats.h"
+#include "backend/spreadsheet/Spreadsheet.h"
 #include "backend/worksheet/plots/cartesian/Histogram.h"
 
 #include <QDateTime>
@@ -986,6 +988,8 @@ struct data {
 	double* paramMin; // lower parameter limits
 	double* paramMax; // upper parameter limits
 	bool* paramFixed; // are the parameter fixed?
+	const Parsing::Program* program; // model compiled once for the whole fit
+	const std::vector<int>* paramSlots; // slots of the parameters in program (-1 if not used)
 };
 
 /*!
@@ -1004,43 +1008,48 @@ int func_f(const gsl_vector* paramValues, void* params, gsl_vector* f) {
 	QStringList* paramNames = ((struct data*)params)->paramNames;
 	double* min = ((struct data*)params)->paramMin;
 	double* max = ((struct data*)params)->paramMax;
+	const auto* program = ((struct data*)params)->program;
+	const auto& paramSlots = *((struct data*)params)->paramSlots;
 
-	Parsing::Parser parser;
+	if (!program->isValid())
+		return GSL_EINVAL;
 
 	// set current values of the parameters
+	auto values = program->variableValues();
 	for (int i = 0; i < paramNames->size(); i++) {
 		double v = gsl_vector_get(paramValues, (size_t)i);
 		// bound values if limits are set
-		parser.assign_symbol(qPrintable(paramNames->at(i)), nsl_fit_map_bound(v, min[i], max[i]));
+		if (paramSlots.at(i) >= 0)
+			values[paramSlots.at(i)] = nsl_fit_map_bound(v, min[i], max[i]);
 		QDEBUG(Q_FUNC_INFO << ", Parameter" << i << " (' " << paramNames->at(i) << "')" << '[' << min[i] << ',' << max[i]
 						   << "] free/bound:" << QString::number(v, 'g', 15) << ' ' << QString::number(nsl_fit_map_bound(v, min[i], max[i]), 'g', 15));
 	}
 
-	QString func{*(((struct data*)params)->func)};
-	for (size_t i = 0; i < n; i++) {
-		if (std::isnan(x[i]) || std::isnan(y[i]))
-			continue;
-
-		// checks for allowed values of x for different models
-		// TODO: more to check
-		if (modelCategory == nsl_fit_model_distribution && modelType == nsl_sf_stats_lognormal) {
-			if (x[i] < 0)
-				x[i] = 0;
-		}
+	// the points are independent and are evaluated in parallel
+	const int xIndex = program->variableIndex("x");
+	Parallel::forRanges(static_cast<int>(n), program->isThreadSafe() ? 4096 : INT_MAX, [&](int start, int end) {
+		auto rangeValues = values;
+		for (int i = start; i < end; i++) {
+			if (std::isnan(x[i]) || std::isnan(y[i]))
+				continue;
+
+			// checks for allowed values of x for different models
+			// TODO: more to check
+			if (modelCategory == nsl_fit_model_distribution && modelType == nsl_sf_stats_lognormal) {
+				if (x[i] < 0)
+					x[i] = 0;
+			}
 
-		parser.assign_symbol("x", x[i]);
-		// DEBUG("evaluate function \"" << STDSTRING(func) << "\" @ x = " << x[i] << ":");
-		double Yi = parser.parse(qPrintable(func), qPrintable(QLocale().name()));
-		if (parser.parseErrors() > 0) // fallback to default locale
-			Yi = parser.parse(qPrintable(func), "en_US");
-		// DEBUG("	f(x["<< i <<"]) = " << Yi);
+			if (xIndex >= 0)
+				rangeValues[xIndex] = x[i];
+			// DEBUG("evaluate function @ x = " << x[i] << ":");
+			const double Yi = program->evaluate(rangeValues.data());
+			// DEBUG("	f(x["<< i <<"]) = " << Yi);
 
-		if (parser.parseErrors() > 0)
-			return GSL_EINVAL;
-
-		// DEBUG("	weight["<< i <<"]) = " << weight[i]);
-		gsl_vector_set(f, i, sqrt(weight[i]) * (Yi - y[i]));
-	}
+			// DEBUG("	weight["<< i <<"]) = " << weight[i]);
+			gsl_vector_set(f, i, sqrt(weight[i]) * (Yi - y[i]));
+		}
+	});
 
 	return GSL_SUCCESS;
 }
@@ -1710,50 +1719,39 @@ int func_df(const gsl_vector* paramValues, void* params, gsl_matrix* J) {
 			break;
 		}
 		break;
-	case nsl_fit_model_custom:
-		double value;
-		const auto np = paramNames->size();
-		QString func{*(((struct data*)params)->func)};
+	case nsl_fit_model_custom: {
+		const auto* program = ((struct data*)params)->program;
+		const auto& paramSlots = *((struct data*)params)->paramSlots;
+		if (!program->isValid())
+			return GSL_EINVAL;
 
-		const auto numberLocale = QLocale();
-		Parsing::Parser parser;
-		for (size_t i = 0; i < n; i++) {
-			x = xVector[i];
-			parser.assign_symbol("x", x);
+		const auto np = paramNames->size();
+		auto values = program->variableValues();
+		for (auto k = 0; k < np; k++) {
+			if (paramSlots.at(k) >= 0)
+				values[paramSlots.at(k)] = nsl_fit_map_bound(gsl_vector_get(paramValues, k), min[k], max[k]);
+		}
 
-			for (auto j = 0; j < np; j++) {
-				for (auto k = 0; k < np; k++) {
-					if (k != j) {
-						value = nsl_fit_map_bound(gsl_vector_get(paramValues, k), min[k], max[k]);
-						parser.assign_symbol(qPrintable(paramNames->at(k)), value);
-					}
+		// exact derivatives with respect to the (bound) parameter values using automatic differentiation of the compiled model
+		const int xIndex = program->variableIndex("x");
+		Parallel::forRanges(static_cast<int>(n), program->isThreadSafe() ? 1024 : INT_MAX, [&](int start, int end) {
+			auto rangeValues = values;
+			std::vector<double> gradient(np);
+			for (int i = start; i < end; i++) {
+				if (xIndex >= 0)
+					rangeValues[xIndex] = xVector[i];
+				program->evaluateGradient(rangeValues.data(), paramSlots, gradient.data());
+
+				for (auto j = 0; j < np; j++) {
+					if (fixed[j])
+						gsl_matrix_set(J, (size_t)i, (size_t)j, 0.);
+					else
+						gsl_matrix_set(J, (size_t)i, (size_t)j, sqrt(weight[i]) * gradient.at(j));
 				}
-
-				value = nsl_fit_map_bound(gsl_vector_get(paramValues, j), min[j], max[j]);
-				parser.assign_symbol(qPrintable(paramNames->at(j)), value);
-				double f_p = parser.parse(qPrintable(func), qPrintable(numberLocale.name()));
-				if (parser.parseErrors() > 0) // fallback to default locale
-					f_p = parser.parse(qPrintable(func), "en_US");
-
-				double eps = 1.e-9;
-				if (std::abs(f_p) > 0)
-					eps *= std::abs(f_p); // scale step size with function value
-				value += eps;
-				parser.assign_symbol(qPrintable(paramNames->at(j)), value);
-				double f_pdp = parser.parse(qPrintable(func), qPrintable(numberLocale.name()));
-				if (parser.parseErrors() > 0) // fallback to default locale
-					f_pdp = parser.parse(qPrintable(func), "en_US");
-
-				//				DEBUG("evaluate deriv"<<func<<": f(x["<<i<<"]) ="<<QString::number(f_p, 'g', 15));
-				//				DEBUG("evaluate deriv"<<func<<": f(x["<<i<<"]+dx) ="<<QString::number(f_pdp, 'g', 15));
-				//				DEBUG("	deriv = " << STDSTRING(QString::number(sqrt(weight[i])*(f_pdp-f_p)/eps, 'g', 15));
-
-				if (fixed[j])
-					gsl_matrix_set(J, (size_t)i, (size_t)j, 0.);
-				else // calculate finite difference
-					gsl_matrix_set(J, (size_t)i, (size_t)j, sqrt(weight[i]) * (f_pdp - f_p) / eps);
 			}
-		}
+		});
+		break;
+	}
 	}
 
 	return GSL_SUCCESS;
@@ -1767,6 +1765,395 @@ int func_fdf(const gsl_vector* x, void* params, gsl_vector* f, gsl_matrix* J) {
 	return GSL_SUCCESS;
 }
 
+/*!
+ * returns the value of the column \c column in row \c row used for fitting (NAN for text columns)
+ */
+double fitValue(const AbstractColumn* column, int row) {
+	switch (column->columnMode()) {
+	case AbstractColumn::ColumnMode::Double:
+	case AbstractColumn::ColumnMode::Integer:
+	case AbstractColumn::ColumnMode::BigInt:
+		return column->valueAt(row);
+	case AbstractColumn::ColumnMode::Text: // not valid
+		break;
+	case AbstractColumn::ColumnMode::DateTime:
+	case AbstractColumn::ColumnMode::Day:
+	case AbstractColumn::ColumnMode::Month:
+		return column->dateTimeAt(row).toMSecsSinceEpoch();
+	}
+
+	return NAN;
+}
+
+/*!
+ * initializes the weights of the \c n data points for the y-weights type of \c fitData.
+ * \c yerror contains the y errors of the data points and may be empty.
+ */
+void initWeights(double* weight, const XYFitCurve::FitData& fitData, const double* ydata, int n, const QVector<double>& yerror) {
+	const double minError = 1.e-199; // minimum error for weighting
+
+	for (int i = 0; i < n; i++)
+		weight[i] = 1.;
+
+	switch (fitData.yWeightsType) {
+	case nsl_fit_weight_no:
+	case nsl_fit_weight_statistical_fit:
+	case nsl_fit_weight_relative_fit:
+		break;
+	case nsl_fit_weight_instrumental: // yerror are sigmas
+		for (int i = 0; i < n; i++)
+			if (i < yerror.size())
+				weight[i] = 1. / gsl_pow_2(std::max(yerror.at(i), std::max(sqrt(minError), std::abs(ydata[i]) * 1.e-15)));
+		break;
+	case nsl_fit_weight_direct: // yerror are weights
+		for (int i = 0; i < n; i++)
+			if (i < yerror.size())
+				weight[i] = yerror.at(i);
+		break;
+	case nsl_fit_weight_inverse: // yerror are inverse weights
+		for (int i = 0; i < n; i++)
+			if (i < yerror.size())
+				weight[i] = 1. / std::max(yerror.at(i), std::max(minError, std::abs(ydata[i]) * 1.e-15));
+		break;
+	case nsl_fit_weight_statistical:
+		for (int i = 0; i < n; i++)
+			weight[i] = 1. / std::max(ydata[i], minError);
+		break;
+	case nsl_fit_weight_relative:
+		for (int i = 0; i < n; i++)
+			weight[i] = 1. / std::max(gsl_pow_2(ydata[i]), minError);
+		break;
+	}
+}
+
+/*!
+ * iterates the Levenberg-Marquardt solver \c s until the fit converged or the maximal number of iterations is reached.
+ * \c writeState is called with the solver and chi after every iteration.
+ * \return GSL status of the fit
+ */
+template<typename StateWriter>
+int iterateSolver(gsl_multifit_fdfsolver* s, const XYFitCurve::FitData& fitData, double* weight, const double* ydata, int n, int nf, unsigned int& iter, StateWriter writeState) {
+	const auto np = fitData.paramNames.size();
+	int status = GSL_SUCCESS;
+	do {
+		iter++;
+		DEBUG(Q_FUNC_INFO << ",	iter " << iter);
+
+		// update weights for Y-depending weights (using function values from residuals)
+		if (fitData.yWeightsType == nsl_fit_weight_statistical_fit) {
+			for (auto i = 0; i < n; i++)
+				weight[i] = 1. / (gsl_vector_get(s->f, i) / sqrt(weight[i]) + ydata[i]); // 1/Y_i
+		} else if (fitData.yWeightsType == nsl_fit_weight_relative_fit) {
+			for (auto i = 0; i < n; i++)
+				weight[i] = 1. / gsl_pow_2(gsl_vector_get(s->f, i) / sqrt(weight[i]) + ydata[i]); // 1/Y_i^2
+		}
+
+		if (nf == np) { // all fixed parameter
+			DEBUG(Q_FUNC_INFO << ", all parameter fixed. Stop iteration.")
+			break;
+		}
+		DEBUG(Q_FUNC_INFO << ", run fdfsolver_iterate");
+		status = gsl_multifit_fdfsolver_iterate(s);
+		DEBUG(Q_FUNC_INFO << ", fdfsolver_iterate DONE");
+		double chi = gsl_blas_dnrm2(s->f);
+		writeState(s, chi);
+		if (status) {
+			DEBUG(Q_FUNC_INFO << ",	iter " << iter << ", status = " << gsl_strerror(status));
+			if (status == GSL_ETOLX) // change in the position vector falls below machine precision: no progress
+				status = GSL_SUCCESS;
+			break;
+		}
+		if (qFuzzyIsNull(chi)) {
+			DEBUG(Q_FUNC_INFO << ", chi is zero! Finishing.")
+			status = GSL_SUCCESS;
+		} else {
+			status = gsl_multifit_test_delta(s->dx, s->x, fitData.eps, fitData.eps);
+		}
+		DEBUG(Q_FUNC_INFO << ",	iter " << iter << ", test status = " << gsl_strerror(status));
+	} while (status == GSL_CONTINUE && iter < (unsigned int)fitData.maxIterations);
+
+	return status;
+}
+
+/*!
+ * calculates the parameter values, their errors and the goodness of the fit from the state of the solver \c s
+ * \param startValues (bound) start values of the parameters
+ */
+void calculateFitResult(XYFitCurve::FitResult& fitResult,
+						gsl_multifit_fdfsolver* s,
+						const XYFitCurve::FitData& fitData,
+						const double* startValues,
+						const double* ydata,
+						int n,
+						int nf,
+						int status,
+						unsigned int iter) {
+	const auto np = fitData.paramNames.size();
+	const double* x_min = fitData.paramLowerLimits.constData();
+	const double* x_max = fitData.paramUpperLimits.constData();
+
+	// get the covariance matrix
+	// TODO: scale the Jacobian when limits are used before constructing the covar matrix?
+	auto* covar = gsl_matrix_alloc(np, np);
+#if GSL_MAJOR_VERSION >= 2
+	// the Jacobian is not part of the solver anymore
+	auto* J = gsl_matrix_alloc(s->fdf->n, s->fdf->p);
+	gsl_multifit_fdfsolver_jac(s, J);
+	gsl_multifit_covar(J, 0.0, covar);
+	gsl_matrix_free(J);
+#else
+	gsl_multifit_covar(s->J, 0.0, covar);
+#endif
+
+	// write the result
+	fitResult.available = true;
+	fitResult.valid = true;
+	fitResult.status = gslErrorToString(status);
+	fitResult.iterations = iter;
+	fitResult.dof = n - (np - nf); // samples - (parameter - fixed parameter)
+
+	// gsl_blas_dnrm2() - computes the Euclidian norm (||r||_2 = \sqrt {\sum r_i^2}) of the vector with the elements weight[i]*(Yi - y[i])
+	// gsl_blas_dasum() - computes the absolute sum \sum |r_i| of the elements of the vector with the elements weight[i]*(Yi - y[i])
+	fitResult.sse = gsl_pow_2(gsl_blas_dnrm2(s->f));
+	fitResult.mae = gsl_blas_dasum(s->f) / n;
+
+	// SST needed for coefficient of determination, R-squared and F test
+	fitResult.sst = gsl_stats_tss(ydata, 1, n);
+	// for a linear model without intercept R-squared is calculated differently
+	// see
+	// https://cran.r-project.org/doc/FAQ/R-FAQ.html#Why-does-summary_0028_0029-report-strange-results-for-the-R_005e2-estimate-when-I-fit-a-linear-model-with-no-intercept_003f
+	if (fitData.modelCategory == nsl_fit_model_basic && fitData.modelType == nsl_fit_model_polynomial && fitData.degree == 1 && startValues[0] == 0) {
+		DEBUG("	Using alternative R^2 for linear model without intercept");
+		fitResult.sst = gsl_stats_tss_m(ydata, 1, n, 0);
+	}
+	if (fitResult.sst < fitResult.sse) {
+		DEBUG("	Using alternative R^2 since R^2 would be negative (probably custom model without intercept)");
+		fitResult.sst = gsl_stats_tss_m(ydata, 1, n, 0);
+	}
+	fitResult.calculateResult(n, np);
+
+	// parameter values
+	fitResult.paramValues.resize(np);
+	fitResult.errorValues.resize(np);
+	fitResult.tdist_tValues.resize(np);
+	fitResult.tdist_pValues.resize(np);
+	fitResult.marginValues.resize(np);
+	// GSL: cerr = GSL_MAX_DBL(1., sqrt(fitResult.rms)); // increase error for poor fit
+	// NIST: cerr = sqrt(fitResult.rms); // increase error for poor fit, decrease for good fit
+	const double cerr = sqrt(fitResult.rms);
+	// CI = 100 * (1 - alpha)
+	const double alpha = 1.0 - fitData.confidenceInterval / 100.;
+	for (auto i = 0; i < np; i++) {
+		// scale resulting values if they are bounded
+		fitResult.paramValues[i] = nsl_fit_map_bound(gsl_vector_get(s->x, i), x_min[i], x_max[i]);
+		fitResult.errorValues[i] = cerr * sqrt(gsl_matrix_get(covar, i, i));
+		fitResult.tdist_tValues[i] = nsl_stats_tdist_t(fitResult.paramValues.at(i), fitResult.errorValues.at(i));
+		fitResult.tdist_pValues[i] = nsl_stats_tdist_p(fitResult.tdist_tValues.at(i), fitResult.dof);
+		fitResult.marginValues[i] = nsl_stats_tdist_margin(alpha, fitResult.dof, fitResult.errorValues.at(i));
+		for (auto j = 0; j <= i; j++)
+			fitResult.correlationMatrix << gsl_matrix_get(covar, i, j) / sqrt(gsl_matrix_get(covar, i, i)) / sqrt(gsl_matrix_get(covar, j, j));
+	}
+
+	gsl_matrix_free(covar);
+}
+
+/*!
+ * fits the compiled model \c program to the data points (\c xdata, \c ydata) beginning at \c startValues.
+ * Used for batch fitting: only the fit settings are taken from \c fitData and no solver state is written.
+ * \return GSL status of the fit
+ */
+int fitLevenbergMarquardt(XYFitCurve::FitResult& fitResult,
+						  const XYFitCurve::FitData& fitData,
+						  const Parsing::Program& program,
+						  const std::vector<int>& paramSlots,
+						  QVector<double> xdata,
+						  QVector<double> ydata,
+						  QVector<double> startValues) {
+	const auto n = xdata.size();
+	const auto np = fitData.paramNames.size();
+	fitResult.available = true;
+	if (n == 0 || n < np) {
+		fitResult.valid = false;
+		fitResult.status = i18n("The number of data points (%1) must be greater than or equal to the number of parameters (%2)!", n, np);
+		return GSL_EINVAL;
+	}
+
+	startValues.resize(np);
+	QVector<double> weight(n);
+	initWeights(weight.data(), fitData, ydata.constData(), n, QVector<double>());
+
+	// the fit functions need non-const pointers
+	auto model = fitData.model;
+	auto paramNames = fitData.paramNames;
+	auto paramLowerLimits = fitData.paramLowerLimits;
+	auto paramUpperLimits = fitData.paramUpperLimits;
+	auto paramFixed = fitData.paramFixed;
+	paramFixed.resize(np);
+	const int nf = paramFixed.count(true);
+
+	struct data params = {static_cast<size_t>(n),
+						  xdata.data(),
+						  ydata.data(),
+						  weight.data(),
+						  fitData.modelCategory,
+						  fitData.modelType,
+						  fitData.degree,
+						  &model,
+						  &paramNames,
+						  paramLowerLimits.data(),
+						  paramUpperLimits.data(),
+						  paramFixed.data(),
+						  &program,
+						  &paramSlots};
+	gsl_multifit_function_fdf f;
+	f.f = &func_f;
+	f.df = &func_df;
+	f.fdf = &func_fdf;
+	f.n = n;
+	f.p = np;
+	f.params = &params;
+
+	auto* s = gsl_multifit_fdfsolver_alloc(gsl_multifit_fdfsolver_lmsder, n, np);
+	for (auto i = 0; i < np; i++)
+		startValues[i] = nsl_fit_map_unbound(startValues.at(i), paramLowerLimits.at(i), paramUpperLimits.at(i));
+	auto x = gsl_vector_view_array(startValues.data(), np);
+	gsl_multifit_fdfsolver_set(s, &f, &x.vector);
+
+	unsigned int iter = 0;
+	const int status = iterateSolver(s, fitData, weight.data(), ydata.constData(), n, nf, iter, [](gsl_multifit_fdfsolver*, double) {
+	});
+
+	for (auto i = 0; i < np; i++)
+		startValues[i] = nsl_fit_map_bound(startValues.at(i), paramLowerLimits.at(i), paramUpperLimits.at(i));
+	calculateFitResult(fitResult, s, fitData, startValues.constData(), ydata.constData(), n, nf, status, iter);
+
+	gsl_multifit_fdfsolver_free(s);
+	return status;
+}
+
+/*!
+ * \brief fits the model of \c fitData to the data sets given by the (x, y) column pairs in \c data.
+ *
+ * Every data set is fitted beginning at every set of parameter values in \c startValues (at the start values
+ * of \c fitData if empty) and the fit with the smallest chi^2 is kept. The fits are done in parallel with the
+ * Levenberg-Marquardt algorithm, data errors and weights depending on them are not used.
+ *
+ * \return new spreadsheet with one row per data set containing the name of the y column, the index of the best
+ * start values, the parameter values and their errors, chi^2, the reduced chi^2, the number of iterations and
+ * whether the fit converged. The caller takes the ownership of the spreadsheet.
+ */
+Spreadsheet* XYFitCurve::batchFit(const FitData& fitData, const QVector<QPair<const AbstractColumn*, const AbstractColumn*>>& data, const QVector<QVector<double>>& startValues) {
+	const auto np = fitData.paramNames.size();
+	const auto starts = startValues.isEmpty() ? QVector<QVector<double>>{fitData.paramStartValues} : startValues;
+	DEBUG(Q_FUNC_INFO << ", data sets: " << data.size() << ", start values: " << starts.size());
+
+	// compile the model once, all fits evaluate it with their own parameter values
+	Parsing::Parser parser;
+	for (auto i = 0; i < np; i++)
+		parser.assign_symbol(qPrintable(fitData.paramNames.at(i)), 0.);
+	parser.assign_symbol("x", 0.);
+	const auto program = ExpressionParser::compile(parser, fitData.model);
+	std::vector<int> paramSlots(np);
+	for (auto i = 0; i < np; i++)
+		paramSlots[i] = program.variableIndex(qPrintable(fitData.paramNames.at(i)));
+
+	// copy the valid data points inside the fit range
+	QVector<QVector<double>> xdata(data.size());
+	QVector<QVector<double>> ydata(data.size());
+	for (int k = 0; k < data.size(); k++) {
+		const auto* xColumn = data.at(k).first;
+		const auto* yColumn = data.at(k).second;
+		if (!xColumn || !yColumn)
+			continue;
+
+		const int rowCount = std::min(xColumn->rowCount(), yColumn->rowCount());
+		for (int row = 0; row < rowCount; ++row) {
+			if (!xColumn->isValid(row) || xColumn->isMasked(row) || !yColumn->isValid(row) || yColumn->isMasked(row))
+				continue;
+
+			const double x = fitValue(xColumn, row);
+			if (std::isnan(x) || (!fitData.autoRange && !fitData.fitRange.isZero() && !fitData.fitRange.contains(x)))
+				continue;
+			xdata[k].append(x);
+			ydata[k].append(fitValue(yColumn, row));
+		}
+	}
+
+	// run all fits in parallel
+	const int jobs = data.size() * starts.size();
+	QVector<FitResult> results(jobs);
+	QVector<int> statuses(jobs, GSL_EINVAL);
+	if (np > 0 && program.isValid()) {
+		auto* resultsData = results.data();
+		auto* statusesData = statuses.data();
+		gsl_set_error_handler_off();
+		Parallel::forRanges(jobs, 1, [&](int start, int end) {
+			for (int job = start; job < end; job++) {
+				const int k = job / starts.size();
+				statusesData[job] =
+					fitLevenbergMarquardt(resultsData[job], fitData, program, paramSlots, xdata.at(k), ydata.at(k), starts.at(job % starts.size()));
+			}
+		});
+	}
+
+	// keep the best fit of every data set
+	QVector<QString> names(data.size());
+	QVector<int> bestStarts(data.size(), -1);
+	QVector<QVector<double>> paramValues(np, QVector<double>(data.size(), NAN));
+	QVector<QVector<double>> errorValues(np, QVector<double>(data.size(), NAN));
+	QVector<double> chisq(data.size(), NAN);
+	QVector<double> reducedChisq(data.size(), NAN);
+	QVector<int> iterations(data.size());
+	QVector<int> converged(data.size());
+	for (int k = 0; k < data.size(); k++) {
+		if (data.at(k).second)
+			names[k] = data.at(k).second->name();
+
+		int best = -1;
+		for (int j = 0; j < starts.size(); j++) {
+			const auto& result = results.at(k * starts.size() + j);
+			if (result.valid && !std::isnan(result.sse) && (best == -1 || result.sse < results.at(k * starts.size() + best).sse))
+				best = j;
+		}
+		if (best == -1)
+			continue;
+
+		const auto& result = results.at(k * starts.size() + best);
+		bestStarts[k] = best;
+		for (auto i = 0; i < np; i++) {
+			paramValues[i][k] = result.paramValues.at(i);
+			errorValues[i][k] = result.errorValues.at(i);
+		}
+		chisq[k] = result.sse;
+		reducedChisq[k] = result.rms;
+		iterations[k] = result.iterations;
+		converged[k] = (statuses.at(k * starts.size() + best) == GSL_SUCCESS);
+	}
+
+	auto* spreadsheet = new Spreadsheet(i18n("Batch Fit"));
+	spreadsheet->removeColumns(0, spreadsheet->columnCount()); // remove default columns
+	spreadsheet->setRowCount(data.size());
+
+	auto* column = new Column(i18n("Data"), names);
+	column->setPlotDesignation(AbstractColumn::PlotDesignation::X);
+	spreadsheet->addChild(column);
+	spreadsheet->addChild(new Column(i18n("Start Values"), bestStarts));
+	for (auto i = 0; i < np; i++) {
+		column = new Column(fitData.paramNames.at(i), paramValues.at(i));
+		column->setPlotDesignation(AbstractColumn::PlotDesignation::Y);
+		spreadsheet->addChild(column);
+		column = new Column(i18n("%1 Error", fitData.paramNames.at(i)), errorValues.at(i));
+		column->setPlotDesignation(AbstractColumn::PlotDesignation::YError);
+		spreadsheet->addChild(column);
+	}
+	spreadsheet->addChild(new Column(i18n("Chi^2"), chisq));
+	spreadsheet->addChild(new Column(i18n("Reduced Chi^2"), reducedChisq));
+	spreadsheet->addChild(new Column(i18n("Iterations"), iterations));
+	spreadsheet->addChild(new Column(i18n("Converged"), converged));
+
+	return spreadsheet;
+}
+
 //////////////////////////////////////////////////////////////////
 
 /* prepare the fit result columns and note */
@@ -2336,35 +2723,8 @@ void XYFitCurvePrivate::runLevenbergMarquardt(const AbstractColumn* tmpXDataColu
 		if (!tmpXDataColumn->isValid(row) || tmpXDataColumn->isMasked(row) || !tmpYDataColumn->isValid(row) || tmpYDataColumn->isMasked(row))
 			continue;
 
-		double x = NAN;
-		switch (tmpXDataColumn->columnMode()) {
-		case AbstractColumn::ColumnMode::Double:
-		case AbstractColumn::ColumnMode::Integer:
-		case AbstractColumn::ColumnMode::BigInt:
-			x = tmpXDataColumn->valueAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Text: // not valid
-			break;
-		case AbstractColumn::ColumnMode::DateTime:
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::Month:
-			x = tmpXDataColumn->dateTimeAt(row).toMSecsSinceEpoch();
-		}
-
-		double y = NAN;
-		switch (tmpYDataColumn->columnMode()) {
-		case AbstractColumn::ColumnMode::Double:
-		case AbstractColumn::ColumnMode::Integer:
-		case AbstractColumn::ColumnMode::BigInt:
-			y = tmpYDataColumn->valueAt(row);
-			break;
-		case AbstractColumn::ColumnMode::Text: // not valid
-			break;
-		case AbstractColumn::ColumnMode::DateTime:
-		case AbstractColumn::ColumnMode::Day:
-		case AbstractColumn::ColumnMode::Month:
-			y = tmpYDataColumn->dateTimeAt(row).toMSecsSinceEpoch();
-		}
+		const double x = fitValue(tmpXDataColumn, row);
+		const double y = fitValue(tmpYDataColumn, row);
 
 		if (x >= xRange.start() && x <= xRange.end()) { // only when inside given range
 			if ((!xErrorColumn && !yErrorColumn) || !fitData.useDataErrors) { // x-y
@@ -2420,42 +2780,10 @@ void XYFitCurvePrivate::runLevenbergMarquardt(const AbstractColumn* tmpXDataColu
 	DEBUG(Q_FUNC_INFO << ", x error vector size: " << xerrorVector.size());
 	DEBUG(Q_FUNC_INFO << ", y error vector size: " << yerrorVector.size());
 	double* weight = new double[n];
-
-	for (auto i = 0; i < n; i++)
-		weight[i] = 1.;
+	initWeights(weight, fitData, ydata, n, yerrorVector);
 
 	const double minError = 1.e-199; // minimum error for weighting
 
-	switch (fitData.yWeightsType) {
-	case nsl_fit_weight_no:
-	case nsl_fit_weight_statistical_fit:
-	case nsl_fit_weight_relative_fit:
-		break;
-	case nsl_fit_weight_instrumental: // yerror are sigmas
-		for (int i = 0; i < (int)n; i++)
-			if (i < yerrorVector.size())
-				weight[i] = 1. / gsl_pow_2(std::max(yerror[i], std::max(sqrt(minError), std::abs(ydata[i]) * 1.e-15)));
-		break;
-	case nsl_fit_weight_direct: // yerror are weights
-		for (int i = 0; i < (int)n; i++)
-			if (i < yerrorVector.size())
-				weight[i] = yerror[i];
-		break;
-	case nsl_fit_weight_inverse: // yerror are inverse weights
-		for (int i = 0; i < (int)n; i++)
-			if (i < yerrorVector.size())
-				weight[i] = 1. / std::max(yerror[i], std::max(minError, std::abs(ydata[i]) * 1.e-15));
-		break;
-	case nsl_fit_weight_statistical:
-		for (int i = 0; i < (int)n; i++)
-			weight[i] = 1. / std::max(ydata[i], minError);
-		break;
-	case nsl_fit_weight_relative:
-		for (int i = 0; i < (int)n; i++)
-			weight[i] = 1. / std::max(gsl_pow_2(ydata[i]), minError);
-		break;
-	}
-
 	/////////////////////// GSL >= 2 has a complete new interface! But the old one is still supported. ///////////////////////////
 	// GSL >= 2 : "the 'fdf' field of gsl_multifit_function_fdf is now deprecated and does not need to be specified for nonlinear least squares problems"
 	int nf = 0; // number of fixed parameter
@@ -2472,6 +2800,15 @@ void XYFitCurvePrivate::runLevenbergMarquardt(const AbstractColumn* tmpXDataColu
 	// function to fit
 	gsl_multifit_function_fdf f;
 	DEBUG(Q_FUNC_INFO << ", model = " << STDSTRING(fitData.model));
+	// compile the model once for the whole fit, the values of the parameters and x are set via their slots
+	Parsing::Parser parser;
+	for (auto i = 0; i < np; i++)
+		parser.assign_symbol(qPrintable(fitData.paramNames.at(i)), fitData.paramStartValues.at(i));
+	parser.assign_symbol("x", n > 0 ? xdata[0] : 0.);
+	const auto program = ExpressionParser::compile(parser, fitData.model);
+	std::vector<int> paramSlots(np);
+	for (auto i = 0; i < np; i++)
+		paramSlots[i] = program.variableIndex(qPrintable(fitData.paramNames.at(i)));
 	struct data params = {static_cast<size_t>(n),
 						  xdata,
 						  ydata,
@@ -2483,7 +2820,9 @@ void XYFitCurvePrivate::runLevenbergMarquardt(const AbstractColumn* tmpXDataColu
 						  &fitData.paramNames,
 						  fitData.paramLowerLimits.data(),
 						  fitData.paramUpperLimits.data(),
-						  fitData.paramFixed.data()};
+						  fitData.paramFixed.data(),
+						  &program,
+						  &paramSlots};
 	f.f = &func_f;
 	f.df = &func_df;
 	f.fdf = &func_fdf;
@@ -2510,46 +2849,12 @@ void XYFitCurvePrivate::runLevenbergMarquardt(const AbstractColumn* tmpXDataColu
 	gsl_multifit_fdfsolver_set(s, &f, &x.vector);
 
 	DEBUG(Q_FUNC_INFO << ", Iterate ...");
-	int status = GSL_SUCCESS;
 	unsigned int iter = 0;
 	fitResult.solverOutput.clear();
 	writeSolverState(s);
-	do {
-		iter++;
-		DEBUG(Q_FUNC_INFO << ",	iter " << iter);
-
-		// update weights for Y-depending weights (using function values from residuals)
-		if (fitData.yWeightsType == nsl_fit_weight_statistical_fit) {
-			for (auto i = 0; i < n; i++)
-				weight[i] = 1. / (gsl_vector_get(s->f, i) / sqrt(weight[i]) + ydata[i]); // 1/Y_i
-		} else if (fitData.yWeightsType == nsl_fit_weight_relative_fit) {
-			for (auto i = 0; i < n; i++)
-				weight[i] = 1. / gsl_pow_2(gsl_vector_get(s->f, i) / sqrt(weight[i]) + ydata[i]); // 1/Y_i^2
-		}
-
-		if (nf == np) { // all fixed parameter
-			DEBUG(Q_FUNC_INFO << ", all parameter fixed. Stop iteration.")
-			break;
-		}
-		DEBUG(Q_FUNC_INFO << ", run fdfsolver_iterate");
-		status = gsl_multifit_fdfsolver_iterate(s);
-		DEBUG(Q_FUNC_INFO << ", fdfsolver_iterate DONE");
-		double chi = gsl_blas_dnrm2(s->f);
+	int status = iterateSolver(s, fitData, weight, ydata, n, nf, iter, [this](gsl_multifit_fdfsolver* s, double chi) {
 		writeSolverState(s, chi);
-		if (status) {
-			DEBUG(Q_FUNC_INFO << ",	iter " << iter << ", status = " << gsl_strerror(status));
-			if (status == GSL_ETOLX) // change in the position vector falls below machine precision: no progress
-				status = GSL_SUCCESS;
-			break;
-		}
-		if (qFuzzyIsNull(chi)) {
-			DEBUG(Q_FUNC_INFO << ", chi is zero! Finishing.")
-			status = GSL_SUCCESS;
-		} else {
-			status = gsl_multifit_test_delta(s->dx, s->x, delta, delta);
-		}
-		DEBUG(Q_FUNC_INFO << ",	iter " << iter << ", test status = " << gsl_strerror(status));
-	} while (status == GSL_CONTINUE && iter < maxIters);
+	});
 
 	// second run for x-error fitting
 	if (xerrorVector.size() > 0) {
@@ -2663,70 +2968,14 @@ void XYFitCurvePrivate::runLevenbergMarquardt(const AbstractColumn* tmpXDataColu
 	for (auto i = 0; i < np; i++)
 		x_init[i] = nsl_fit_map_bound(x_init[i], x_min[i], x_max[i]);
 
-	// get the covariance matrix
-	// TODO: scale the Jacobian when limits are used before constructing the covar matrix?
-	auto* covar = gsl_matrix_alloc(np, np);
-#if GSL_MAJOR_VERSION >= 2
-	// the Jacobian is not part of the solver anymore
-	auto* J = gsl_matrix_alloc(s->fdf->n, s->fdf->p);
-	gsl_multifit_fdfsolver_jac(s, J);
-	gsl_multifit_covar(J, 0.0, covar);
-#else
-	gsl_multifit_covar(s->J, 0.0, covar);
-#endif
-
-	// write the result
-	fitResult.available = true;
-	fitResult.valid = true;
-	fitResult.status = gslErrorToString(status);
-	fitResult.iterations = iter;
-	fitResult.dof = n - (np - nf); // samples - (parameter - fixed parameter)
-
-	// gsl_blas_dnrm2() - computes the Euclidian norm (||r||_2 = \sqrt {\sum r_i^2}) of the vector with the elements weight[i]*(Yi - y[i])
-	// gsl_blas_dasum() - computes the absolute sum \sum |r_i| of the elements of the vector with the elements weight[i]*(Yi - y[i])
-	fitResult.sse = gsl_pow_2(gsl_blas_dnrm2(s->f));
-	fitResult.mae = gsl_blas_dasum(s->f) / n;
-
-	// SST needed for coefficient of determination, R-squared and F test
-	fitResult.sst = gsl_stats_tss(ydata, 1, n);
-	// for a linear model without intercept R-squared is calculated differently
-	// see
-	// https://cran.r-project.org/doc/FAQ/R-FAQ.html#Why-does-summary_0028_0029-report-strange-results-for-the-R_005e2-estimate-when-I-fit-a-linear-model-with-no-intercept_003f
-	if (fitData.modelCategory == nsl_fit_model_basic && fitData.modelType == nsl_fit_model_polynomial && fitData.degree == 1 && x_init[0] == 0) {
-		DEBUG("	Using alternative R^2 for linear model without intercept");
-		fitResult.sst = gsl_stats_tss_m(ydata, 1, n, 0);
-	}
-	if (fitResult.sst < fitResult.sse) {
-		DEBUG("	Using alternative R^2 since R^2 would be negative (probably custom model without intercept)");
-		fitResult.sst = gsl_stats_tss_m(ydata, 1, n, 0);
-	}
-	fitResult.calculateResult(n, np);
+	calculateFitResult(fitResult, s, fitData, x_init, ydata, n, nf, status, iter);
 
-	// parameter values
-	fitResult.paramValues.resize(np);
-	fitResult.errorValues.resize(np);
-	fitResult.tdist_tValues.resize(np);
-	fitResult.tdist_pValues.resize(np);
-	fitResult.marginValues.resize(np);
-	// GSL: cerr = GSL_MAX_DBL(1., sqrt(fitResult.rms)); // increase error for poor fit
-	// NIST: cerr = sqrt(fitResult.rms); // increase error for poor fit, decrease for good fit
-	const double cerr = sqrt(fitResult.rms);
-	// CI = 100 * (1 - alpha)
-	const double alpha = 1.0 - fitData.confidenceInterval / 100.;
-	for (auto i = 0; i < np; i++) {
-		// scale resulting values if they are bounded
-		fitResult.paramValues[i] = nsl_fit_map_bound(gsl_vector_get(s->x, i), x_min[i], x_max[i]);
-		// use results as start values if desired
-		if (fitData.useResults) {
+	// use results as start values if desired
+	if (fitData.useResults) {
+		for (auto i = 0; i < np; i++) {
 			fitData.paramStartValues.data()[i] = fitResult.paramValues.at(i);
 			DEBUG("	saving parameter " << i << ": " << fitResult.paramValues[i] << ' ' << fitData.paramStartValues.data()[i]);
 		}
-		fitResult.errorValues[i] = cerr * sqrt(gsl_matrix_get(covar, i, i));
-		fitResult.tdist_tValues[i] = nsl_stats_tdist_t(fitResult.paramValues.at(i), fitResult.errorValues.at(i));
-		fitResult.tdist_pValues[i] = nsl_stats_tdist_p(fitResult.tdist_tValues.at(i), fitResult.dof);
-		fitResult.marginValues[i] = nsl_stats_tdist_margin(alpha, fitResult.dof, fitResult.errorValues.at(i));
-		for (auto j = 0; j <= i; j++)
-			fitResult.correlationMatrix << gsl_matrix_get(covar, i, j) / sqrt(gsl_matrix_get(covar, i, i)) / sqrt(gsl_matrix_get(covar, j, j));
 	}
 
 	// residuals for selected range
@@ -2741,7 +2990,6 @@ void XYFitCurvePrivate::runLevenbergMarquardt(const AbstractColumn* tmpXDataColu
 	}
 
 	gsl_multifit_fdfsolver_free(s);
-	gsl_matrix_free(covar);
 }
 
 /* evaluate fit function (preview == true: use start values, default: false) */
@@ -20,6 +20,7 @@ extern "C" {
 
 class XYFitCurvePrivate;
 class Histogram;
+class Spreadsheet;
 
 #ifdef SDK
 #include "labplot_export.h"
@@ -107,6 +108,9 @@ public:
 	void initStartValues(XYFitCurve::FitData&);
 	void initFitData(XYAnalysisCurve::AnalysisAction);
 	static void initFitData(XYFitCurve::FitData&);
+	static Spreadsheet* batchFit(const FitData&,
+								 const QVector<QPair<const AbstractColumn*, const AbstractColumn*>>& data,
+								 const QVector<QVector<double>>& startValues = QVector<QVector<double>>());
 	void clearFitResult();
 
 	QIcon icon() const override;
@@ -2626,6 +2626,10 @@ void MainWin::handleSettingsChanges(QList<Settings::Type> changes) {
 		interval *= 60 * 1000;
 		if (interval != m_autoSaveTimer.interval())
 			m_autoSaveTimer.setInterval(interval);
+
+		// memory limit of the undo history
+		if (m_project)
+			m_project->setUndoMemoryLimit(group.readEntry("UndoMemoryLimit", 2048) * qint64(1024 * 1024));
 	}
 
 	// update the number format in all visible dock widgets, worksheet elements and spreadsheets, if changed
@@ -46,6 +46,7 @@ SettingsGeneralPage::SettingsGeneralPage(QWidget* parent, const QLocale& locale)
 	connect(ui.chkSaveDockStates, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkSaveCalculations, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkCompatible, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
+	connect(ui.sbUndoMemoryLimit, QOverload<int>::of(&QSpinBox::valueChanged), this, &SettingsGeneralPage::changed);
 	connect(ui.chkInfoTrace, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkDebugTrace, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
 	connect(ui.chkPerfTrace, &QCheckBox::toggled, this, &SettingsGeneralPage::changed);
@@ -115,6 +116,7 @@ QList<Settings::Type> SettingsGeneralPage::applySettings() {
 	group.writeEntry(QLatin1String("SaveDockStates"), ui.chkSaveDockStates->isChecked());
 	group.writeEntry(QLatin1String("SaveCalculations"), ui.chkSaveCalculations->isChecked());
 	group.writeEntry(QLatin1String("CompatibleSave"), ui.chkCompatible->isChecked());
+	group.writeEntry(QLatin1String("UndoMemoryLimit"), ui.sbUndoMemoryLimit->value());
 	const bool infoTraceEnabled = ui.chkInfoTrace->isChecked();
 	group.writeEntry(QLatin1String("InfoTrace"), infoTraceEnabled);
 	enableInfoTrace(infoTraceEnabled);
@@ -147,6 +149,7 @@ void SettingsGeneralPage::restoreDefaults() {
 	ui.chkSaveDockStates->setChecked(false);
 	ui.chkSaveCalculations->setChecked(true);
 	ui.chkCompatible->setChecked(false);
+	ui.sbUndoMemoryLimit->setValue(2048);
 	ui.chkInfoTrace->setChecked(false);
 	ui.chkDebugTrace->setChecked(false);
 	ui.chkPerfTrace->setChecked(false);
@@ -200,6 +203,7 @@ void SettingsGeneralPage::loadSettings() {
 	ui.chkSaveDockStates->setChecked(group.readEntry<bool>(QLatin1String("SaveDockStates"), false));
 	ui.chkSaveCalculations->setChecked(group.readEntry<bool>(QLatin1String("SaveCalculations"), true));
 	ui.chkCompatible->setChecked(group.readEntry<bool>(QLatin1String("CompatibleSave"), false));
+	ui.sbUndoMemoryLimit->setValue(group.readEntry(QLatin1String("UndoMemoryLimit"), 2048));
 	ui.chkInfoTrace->setChecked(group.readEntry<bool>(QLatin1String("InfoTrace"), false));
 	ui.chkDebugTrace->setChecked(group.readEntry<bool>(QLatin1String("DebugTrace"), false));
 	ui.chkPerfTrace->setChecked(group.readEntry<bool>(QLatin1String("PerfTrace"), false));
@@ -275,6 +279,14 @@ void SettingsGeneralPage::retranslateUi() {
 	ui.lSaveCalculations->setToolTip(msg);
 	ui.chkSaveCalculations->setToolTip(msg);
 
+	msg = i18n(
+		"Maximal memory used to undo the changes of the data, e.g. for the old values of changed columns. \n"
+		"If the limit is exceeded, the oldest changes are removed from the undo history.");
+	ui.lUndoMemoryLimit->setToolTip(msg);
+	ui.sbUndoMemoryLimit->setToolTip(msg);
+	ui.sbUndoMemoryLimit->setSuffix(i18n(" MiB"));
+	ui.sbUndoMemoryLimit->setSpecialValueText(i18n("Unlimited"));
+
 	ui.lTracing->setToolTip(i18n("Activates additional tracing output in the terminal."));
 	ui.chkInfoTrace->setToolTip(i18n("Info trace - helpful to get information and warnings when running the application."));
 	ui.chkDebugTrace->setToolTip(i18n("Debug trace - helpful to diagnose the application, can have a negative impact on the performance."));
@@ -13,6 +13,7 @@
 #include "DatabaseManagerWidget.h"
 #include "backend/core/Settings.h"
 #include "backend/datasources/AbstractDataSource.h"
+#include "backend/lib/DateTimeVector.h"
 #include "backend/lib/macros.h"
 #include "frontend/GuiTools.h"
 
@@ -486,7 +487,7 @@ void ImportSQLDatabaseWidget::read(AbstractDataSource* dataSource, AbstractFileF
 			}
 			case AbstractColumn::ColumnMode::DateTime: {
 				const QDateTime valueDateTime = QDateTime::fromString(valueString, dateTimeFormat);
-				static_cast<QVector<QDateTime>*>(dataContainer[col])->operator[](row) = valueDateTime.isValid() ? valueDateTime : QDateTime();
+				static_cast<DateTimeVector*>(dataContainer[col])->operator[](row) = valueDateTime.isValid() ? valueDateTime : QDateTime();
 				break;
 			}
 			case AbstractColumn::ColumnMode::Text:
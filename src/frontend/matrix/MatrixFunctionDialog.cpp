@@ -12,6 +12,7 @@
 #include "backend/core/Settings.h"
 #include "backend/gsl/ExpressionParser.h"
 #include "backend/gsl/Parser.h"
+#include "backend/lib/MatrixStorage.h"
 #include "backend/lib/macros.h"
 #include "backend/matrix/Matrix.h"
 #include "frontend/widgets/ConstantsWidget.h"
@@ -146,7 +147,7 @@ void MatrixFunctionDialog::insertConstant(const QString& constantsName) const {
 /* task class for parallel fill (not used) */
 class GenerateValueTask : public QRunnable {
 public:
-	GenerateValueTask(int startCol, int endCol, QVector<QVector<double>>& matrixData, double xStart, double yStart, double xStep, double yStep, char* func)
+	GenerateValueTask(int startCol, int endCol, MatrixStorage<double>& matrixData, double xStart, double yStart, double xStep, double yStep, char* func)
 		: m_startCol(startCol)
 		, m_endCol(endCol)
 		, m_matrixData(matrixData)
@@ -158,7 +159,7 @@ public:
 	}
 
 	void run() override {
-		const int rows = m_matrixData[m_startCol].size();
+		const int rows = m_matrixData.rowCount();
 		double x = m_xStart;
 		double y = m_yStart;
 		DEBUG("FILL col" << m_startCol << "-" << m_endCol << " x/y =" << x << '/' << y << " steps =" << m_xStep << '/' << m_yStep << " rows =" << rows)
@@ -171,7 +172,7 @@ public:
 				vars[1].value = y;
 				double z = parser.parse_with_vars(m_func, vars, 2, qPrintable(QLocale().name()));
 				// DEBUG(" z =" << z);
-				m_matrixData[col][row] = z;
+				m_matrixData(row, col) = z;
 				y += m_yStep;
 			}
 
@@ -183,7 +184,7 @@ public:
 private:
 	int m_startCol;
 	int m_endCol;
-	QVector<QVector<double>>& m_matrixData;
+	MatrixStorage<double>& m_matrixData;
 	double m_xStart;
 	double m_yStart;
 	double m_xStep;
@@ -197,7 +198,9 @@ void MatrixFunctionDialog::generate() {
 	m_matrix->beginMacro(i18n("%1: fill matrix with function values", m_matrix->name()));
 
 	// TODO: data types
-	auto* new_data = static_cast<QVector<QVector<double>>*>(m_matrix->data());
+	const int rows = m_matrix->rowCount();
+	const int cols = m_matrix->columnCount();
+	auto* new_data = new MatrixStorage<double>(rows, cols);
 
 	// check if rows or cols == 1
 	double diff = m_matrix->xEnd() - m_matrix->xStart();
@@ -238,13 +241,21 @@ void MatrixFunctionDialog::generate() {
 	*/
 	double x = m_matrix->xStart();
 	double y = m_matrix->yStart();
-	Parsing::parser_var vars[] = {{"x", x}, {"y", y}};
 	Parsing::Parser parser;
-	for (int col = 0; col < m_matrix->columnCount(); ++col) {
-		vars[0].value = x;
-		for (int row = 0; row < m_matrix->rowCount(); ++row) {
-			vars[1].value = y;
-			(*new_data)[col][row] = parser.parse_with_vars(qPrintable(ui.teEquation->toPlainText()), vars, 2, qPrintable(QLocale().name()));
+	parser.assign_symbol("x", x);
+	parser.assign_symbol("y", y);
+	const auto program = ExpressionParser::compile(parser, ui.teEquation->toPlainText());
+	auto values = program.variableValues();
+	const int xIndex = program.variableIndex("x");
+	const int yIndex = program.variableIndex("y");
+	for (int col = 0; col < cols; ++col) {
+		if (xIndex >= 0)
+			values[xIndex] = x;
+		auto column = new_data->column(col);
+		for (int row = 0; row < rows; ++row) {
+			if (yIndex >= 0)
+				values[yIndex] = y;
+			column[row] = program.evaluate(values.data());
 			y += yStep;
 		}
 		y = m_matrix->yStart();
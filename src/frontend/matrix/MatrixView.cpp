@@ -12,6 +12,7 @@
 #include "frontend/matrix/MatrixView.h"
 #include "backend/core/column/Column.h"
 #include "backend/datasources/filters/FITSFilter.h"
+#include "backend/lib/MatrixStorage.h"
 #include "backend/lib/hostprocess.h"
 #include "backend/matrix/Matrix.h"
 #include "backend/matrix/MatrixModel.h"
@@ -619,11 +620,8 @@ void MatrixView::fillWithConstValues() {
 	const double value = QInputDialog::getDouble(this, i18n("Fill the matrix with constant value"), i18n("Value"), 0, -2147483647, 2147483647, 6, &ok);
 	if (ok) {
 		WAIT_CURSOR;
-		auto* newData = static_cast<QVector<QVector<double>>*>(m_matrix->data());
-		for (int col = 0; col < m_matrix->columnCount(); ++col) {
-			for (int row = 0; row < m_matrix->rowCount(); ++row)
-				(*newData)[col][row] = value;
-		}
+		auto* newData = new MatrixStorage<double>(m_matrix->rowCount(), m_matrix->columnCount());
+		newData->fill(value);
 		m_matrix->setData(newData);
 		RESET_CURSOR;
 	}
@@ -781,14 +779,15 @@ public:
 
 	void run() override {
 		double range = (m_max - m_min) / m_colors.count();
-		const auto* data = static_cast<const QVector<QVector<double>>*>(m_data);
+		const auto* data = static_cast<const MatrixStorage<double>*>(m_data);
 		for (int row = m_start; row < m_end; ++row) {
 			m_mutex.lock();
 			QRgb* line = reinterpret_cast<QRgb*>(m_image.scanLine(row));
 			m_mutex.unlock();
 
+			const auto values = data->row(row);
 			for (int col = 0; col < m_image.width(); ++col) {
-				const double value = (data->operator[](col))[row];
+				const double value = values.at(col);
 				if (!std::isnan(value) && !std::isinf(value)) {
 					const int index = range != 0 ? (value - m_min) / range : 0;
 					QColor color;
@@ -821,17 +820,17 @@ void MatrixView::updateImage() {
 
 	// find min/max value
 	double dmax = -DBL_MAX, dmin = DBL_MAX;
-	const auto* data = static_cast<QVector<QVector<double>>*>(m_matrix->data());
+	const auto* data = static_cast<MatrixStorage<double>*>(m_matrix->data());
 	const int width = m_matrix->columnCount();
 	const int height = m_matrix->rowCount();
-	for (int col = 0; col < width; ++col) {
-		for (int row = 0; row < height; ++row) {
-			const double value = (data->operator[](col))[row];
-			if (dmax < value)
-				dmax = value;
-			if (dmin > value)
-				dmin = value;
-		}
+	// the order of the values doesn't matter here, run over the whole buffer
+	const double* values = data->constData();
+	for (qsizetype i = 0; i < data->size(); ++i) {
+		const double value = values[i];
+		if (dmax < value)
+			dmax = value;
+		if (dmin > value)
+			dmin = value;
 	}
 
 	// update the image
@@ -1045,7 +1044,7 @@ void MatrixView::print(QPrinter* printer) const {
 
 	QHeaderView* hHeader = m_tableView->horizontalHeader();
 	QHeaderView* vHeader = m_tableView->verticalHeader();
-	auto* data = static_cast<QVector<QVector<double>>*>(m_matrix->data());
+	const auto* data = static_cast<MatrixStorage<double>*>(m_matrix->data());
 
 	const int rows = m_matrix->rowCount();
 	const int cols = m_matrix->columnCount();
@@ -1058,18 +1057,17 @@ void MatrixView::print(QPrinter* printer) const {
 	int firstRowStringWidth = vertHeaderWidth;
 	bool tablesNeeded = false;
 	QVector<int> firstRowCeilSizes;
-	firstRowCeilSizes.reserve(data[0].size());
-	firstRowCeilSizes.resize(data[0].size());
+	firstRowCeilSizes.resize(cols);
 	QRect br;
 
-	for (int i = 0; i < data->size(); ++i) {
-		br = painter.boundingRect(br, Qt::AlignCenter, QString::number(data->at(i)[0]) + QLatin1Char('\t'));
+	for (int i = 0; i < cols; ++i) {
+		br = painter.boundingRect(br, Qt::AlignCenter, QString::number(data->at(0, i)) + QLatin1Char('\t'));
 		firstRowCeilSizes[i] = br.width() > m_tableView->columnWidth(i) ? br.width() : m_tableView->columnWidth(i);
 	}
 	const int width = printer->pageLayout().paintRectPixels(printer->resolution()).width() - 2 * margin;
 	for (int col = 0; col < cols; ++col) {
 		headerStringWidth += m_tableView->columnWidth(col);
-		br = painter.boundingRect(br, Qt::AlignCenter, QString::number(data->at(col)[0]) + QLatin1Char('\t'));
+		br = painter.boundingRect(br, Qt::AlignCenter, QString::number(data->at(0, col)) + QLatin1Char('\t'));
 		firstRowStringWidth += br.width();
 		if ((headerStringWidth >= width) || (firstRowStringWidth >= width)) {
 			tablesNeeded = true;
@@ -1142,7 +1140,7 @@ void MatrixView::print(QPrinter* printer) const {
 			}
 			for (; j < toJ; j++) {
 				int w = /*m_tableView->columnWidth(j)*/ firstRowCeilSizes[j];
-				cellText = QString::number(data->at(j)[i]) + QLatin1Char('\t');
+				cellText = QString::number(data->at(i, j)) + QLatin1Char('\t');
 				tr = painter.boundingRect(tr, Qt::AlignCenter, cellText);
 				br.setTopLeft(QPoint(right, height));
 				br.setWidth(w);
@@ -1178,14 +1176,15 @@ void MatrixView::exportToFile(const QString& path, const QString& separator, QLo
 	// export values
 	const int cols = m_matrix->columnCount();
 	const int rows = m_matrix->rowCount();
-	const auto* data = static_cast<QVector<QVector<double>>*>(m_matrix->data());
+	const auto* data = static_cast<MatrixStorage<double>*>(m_matrix->data());
 	// TODO: use general setting for number locale?
 	QLocale locale(language);
 	for (int row = 0; row < rows; ++row) {
+		const auto values = data->row(row);
 		for (int col = 0; col < cols; ++col) {
-			out << locale.toString(data->at(col)[row], m_matrix->numericFormat(), m_matrix->precision());
+			out << locale.toString(values.at(col), m_matrix->numericFormat(), m_matrix->precision());
 
-			out << data->at(col)[row];
+			out << values.at(col);
 			if (col != cols - 1)
 				out << sep;
 		}
@@ -1554,7 +1553,7 @@ void MatrixView::showColumnStatistics() {
 		for (int col = 0; col < m_matrix->columnCount(); ++col) {
 			if (isColumnSelected(col, false)) {
 				QString headerString = m_tableView->model()->headerData(col, Qt::Horizontal).toString();
-				columns << new Column(headerString, static_cast<QVector<QVector<double>>*>(m_matrix->data())->at(col));
+				columns << new Column(headerString, static_cast<MatrixStorage<double>*>(m_matrix->data())->column(col).toVector());
 			}
 		}
 		auto* dlg = new StatisticsDialog(dlgTitle, columns);
@@ -13,6 +13,7 @@
 #include "backend/core/Settings.h"
 #include "backend/core/column/Column.h"
 #include "backend/core/datatypes/DateTime2StringFilter.h"
+#include "backend/lib/DateTimeVector.h"
 #include "backend/lib/macros.h"
 #include "backend/matrix/Matrix.h"
 #include "backend/nsl/nsl_baseline.h"
@@ -881,7 +882,7 @@ void AddSubtractValueDialog::generateForColumn(Column* col, int colIndex) {
 	} else { // datetime
 		qint64 value;
 		setDateTimeValue(value);
-		auto* data = static_cast<QVector<QDateTime>*>(col->data());
+		auto* data = static_cast<DateTimeVector*>(col->data());
 		QVector<QDateTime> new_data(rows);
 
 		switch (m_operation) {
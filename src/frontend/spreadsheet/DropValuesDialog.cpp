@@ -11,6 +11,8 @@
 #include "backend/core/Settings.h"
 #include "backend/core/column/Column.h"
 #include "backend/core/datatypes/DateTime2StringFilter.h"
+#include "backend/lib/DateTimeVector.h"
+#include "backend/lib/TextDictionary.h"
 #include "backend/lib/macros.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
@@ -204,7 +206,7 @@ public:
 		auto* data = static_cast<QVector<double>*>(m_column->data());
 		auto* data_int = static_cast<QVector<int>*>(m_column->data());
 		auto* data_bigint = static_cast<QVector<qint64>*>(m_column->data());
-		auto* data_datetime = static_cast<QVector<QDateTime>*>(m_column->data());
+		auto* data_datetime = static_cast<DateTimeVector*>(m_column->data());
 		const int rows = m_column->rowCount();
 
 		auto mode = m_column->columnMode();
@@ -701,8 +703,8 @@ public:
 			if (changed)
 				m_column->setBigInts(new_data);
 		} else if (mode == AbstractColumn::ColumnMode::DateTime) {
-			auto* data = static_cast<QVector<QDateTime>*>(m_column->data());
-			QVector<QDateTime> new_data(*data);
+			auto* data = static_cast<DateTimeVector*>(m_column->data());
+			QVector<QDateTime> new_data(data->toVector());
 
 			switch (m_operator) {
 			case Operator::EqualTo:
@@ -798,22 +800,29 @@ public:
 		const int rows = m_column->rowCount();
 
 		switch (m_operator) {
-		case OperatorText::EqualTo:
+		case OperatorText::EqualTo: {
+			// compare the dictionary codes instead of the strings
+			const auto& dictionary = m_column->dictionary();
+			const auto code = dictionary.code(m_value);
 			for (int i = 0; i < rows; ++i) {
-				if (data->at(i) == m_value) {
+				if (dictionary.code(i) == code) {
 					m_column->setMasked(i, true);
 					changed = true;
 				}
 			}
 			break;
-		case OperatorText::NotEqualTo:
+		}
+		case OperatorText::NotEqualTo: {
+			const auto& dictionary = m_column->dictionary();
+			const auto code = dictionary.code(m_value);
 			for (int i = 0; i < rows; ++i) {
-				if (data->at(i) != m_value) {
+				if (dictionary.code(i) != code) {
 					m_column->setMasked(i, true);
 					changed = true;
 				}
 			}
 			break;
+		}
 		case OperatorText::StartsWith:
 			for (int i = 0; i < rows; ++i) {
 				if (data->at(i).startsWith(m_value)) {
@@ -874,22 +883,29 @@ public:
 		QVector<QString> new_data(*data);
 
 		switch (m_operator) {
-		case OperatorText::EqualTo:
-			for (auto& d : new_data) {
-				if (d == m_value) {
-					d = QString();
+		case OperatorText::EqualTo: {
+			// compare the dictionary codes instead of the strings
+			const auto& dictionary = m_column->dictionary();
+			const auto code = dictionary.code(m_value);
+			for (int i = 0; i < new_data.size(); ++i) {
+				if (dictionary.code(i) == code) {
+					new_data[i] = QString();
 					changed = true;
 				}
 			}
 			break;
-		case OperatorText::NotEqualTo:
-			for (auto& d : new_data) {
-				if (d != m_value) {
-					d = QString();
+		}
+		case OperatorText::NotEqualTo: {
+			const auto& dictionary = m_column->dictionary();
+			const auto code = dictionary.code(m_value);
+			for (int i = 0; i < new_data.size(); ++i) {
+				if (dictionary.code(i) != code) {
+					new_data[i] = QString();
 					changed = true;
 				}
 			}
 			break;
+		}
 		case OperatorText::StartsWith:
 			for (auto& d : new_data) {
 				if (d.startsWith(m_value)) {
@@ -10,6 +10,7 @@
 #include "SampleValuesDialog.h"
 #include "backend/core/Settings.h"
 #include "backend/core/column/Column.h"
+#include "backend/lib/DateTimeVector.h"
 #include "backend/lib/macros.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
@@ -138,7 +139,7 @@ public:
 		case AbstractColumn::ColumnMode::Month:
 		case AbstractColumn::ColumnMode::Day:
 		case AbstractColumn::ColumnMode::DateTime: {
-			auto* dataSource = static_cast<QVector<QDateTime>*>(m_source->data());
+			auto* dataSource = static_cast<DateTimeVector*>(m_source->data());
 			QVector<QDateTime> dataTarget(size);
 			for (int i = 0; i < size; ++i)
 				dataTarget[i] = dataSource->at(m_rows.at(i));
@@ -3648,7 +3648,7 @@ void SpreadsheetView::sortCustom() {
 		col->setSuppressDataChangedSignal(true);
 
 	auto* dlg = new SortDialog(this, sortAll);
-	connect(dlg, &SortDialog::sort, m_spreadsheet, &Spreadsheet::sortColumns);
+	connect(dlg, &SortDialog::sort, m_spreadsheet, QOverload<Column*, const QVector<Column*>&, bool>::of(&Spreadsheet::sortColumns));
 	dlg->setColumns(columnsToSort, leadingColumn);
 
 	int rc = dlg->exec();
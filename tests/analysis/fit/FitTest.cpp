@@ -3418,4 +3418,94 @@ void FitTest::testHistogramBinomialML() {
 	QCOMPARE(fitResult.paramValues.at(2), spreadsheet.rowCount());
 }
 
+// ##############################################################################
+// ############################## batch fit #####################################
+// ##############################################################################
+
+void FitTest::testBatchFit() {
+	// three channels with different decay
+	const QVector<double> a = {1., 2.5, 4.};
+	const QVector<double> b = {0.5, 1., 2.};
+	QVector<double> xData;
+	for (int i = 0; i < 50; i++)
+		xData << 0.1 * i;
+
+	Column xDataColumn(QStringLiteral("x"), xData);
+	std::vector<std::unique_ptr<Column>> yDataColumns;
+	QVector<QPair<const AbstractColumn*, const AbstractColumn*>> data;
+	for (int k = 0; k < a.size(); k++) {
+		QVector<double> yData;
+		for (double x : xData)
+			yData << a.at(k) * std::exp(-b.at(k) * x);
+		yDataColumns.emplace_back(new Column(QStringLiteral("y%1").arg(k), yData));
+		data << qMakePair(&xDataColumn, yDataColumns.back().get());
+	}
+
+	XYFitCurve::FitData fitData;
+	fitData.modelCategory = nsl_fit_model_custom;
+	XYFitCurve::initFitData(fitData);
+	fitData.model = QStringLiteral("a*exp(-b*x)");
+	fitData.paramNames << QStringLiteral("a") << QStringLiteral("b");
+	fitData.paramStartValues << 1. << 1.;
+	fitData.paramLowerLimits << -std::numeric_limits<double>::max() << -std::numeric_limits<double>::max();
+	fitData.paramUpperLimits << std::numeric_limits<double>::max() << std::numeric_limits<double>::max();
+	fitData.eps = 1.e-9;
+
+	std::unique_ptr<Spreadsheet> spreadsheet(XYFitCurve::batchFit(fitData, data));
+	QVERIFY(spreadsheet != nullptr);
+	QCOMPARE(spreadsheet->rowCount(), 3);
+	// data, start values, a, a error, b, b error, chi^2, reduced chi^2, iterations, converged
+	QCOMPARE(spreadsheet->columnCount(), 10);
+
+	for (int k = 0; k < a.size(); k++) {
+		QCOMPARE(spreadsheet->column(0)->textAt(k), QStringLiteral("y%1").arg(k));
+		QCOMPARE(spreadsheet->column(1)->integerAt(k), 0);
+		FuzzyCompare(spreadsheet->column(2)->valueAt(k), a.at(k), 1.e-8);
+		FuzzyCompare(spreadsheet->column(4)->valueAt(k), b.at(k), 1.e-8);
+		QVERIFY(spreadsheet->column(6)->valueAt(k) < 1.e-15);
+		QCOMPARE(spreadsheet->column(9)->integerAt(k), 1);
+	}
+
+	// same result as the fit curve
+	XYFitCurve fitCurve(QStringLiteral("fit"));
+	fitCurve.setXDataColumn(&xDataColumn);
+	fitCurve.setYDataColumn(yDataColumns.at(1).get());
+	fitCurve.setFitData(fitData);
+	fitCurve.recalculate();
+	const auto& fitResult = fitCurve.fitResult();
+	QCOMPARE(fitResult.valid, true);
+	QCOMPARE(spreadsheet->column(2)->valueAt(1), fitResult.paramValues.at(0));
+	QCOMPARE(spreadsheet->column(3)->valueAt(1), fitResult.errorValues.at(0));
+	QCOMPARE(spreadsheet->column(4)->valueAt(1), fitResult.paramValues.at(1));
+	QCOMPARE(spreadsheet->column(7)->valueAt(1), fitResult.rms);
+	QCOMPARE(spreadsheet->column(8)->integerAt(1), fitResult.iterations);
+}
+
+void FitTest::testBatchFitMultiStart() {
+	QVector<double> xData, yData;
+	for (int i = 0; i < 100; i++) {
+		xData << 0.1 * i;
+		yData << std::sin(3. * xData.last());
+	}
+	Column xDataColumn(QStringLiteral("x"), xData);
+	Column yDataColumn(QStringLiteral("y"), yData);
+
+	XYFitCurve::FitData fitData;
+	fitData.modelCategory = nsl_fit_model_custom;
+	XYFitCurve::initFitData(fitData);
+	fitData.model = QStringLiteral("sin(b*x)");
+	fitData.paramNames << QStringLiteral("b");
+	fitData.paramStartValues << 1.;
+	fitData.paramLowerLimits << -std::numeric_limits<double>::max();
+	fitData.paramUpperLimits << std::numeric_limits<double>::max();
+
+	// only the last start value is close to the global minimum
+	const QVector<QVector<double>> startValues = {{0.5}, {1.}, {2.9}};
+	std::unique_ptr<Spreadsheet> spreadsheet(XYFitCurve::batchFit(fitData, {qMakePair(&xDataColumn, &yDataColumn)}, startValues));
+	QCOMPARE(spreadsheet->rowCount(), 1);
+	QCOMPARE(spreadsheet->column(1)->integerAt(0), 2);
+	FuzzyCompare(spreadsheet->column(2)->valueAt(0), 3., 1.e-6);
+	QCOMPARE(spreadsheet->column(7)->integerAt(0), 1);
+}
+
 QTEST_MAIN(FitTest)
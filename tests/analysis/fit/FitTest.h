@@ -83,5 +83,9 @@ private Q_SLOTS:
 	void testHistogramLognormalML();
 	void testHistogramPoissonML();
 	void testHistogramBinomialML();
+
+	// batch fit
+	void testBatchFit();
+	void testBatchFitMultiStart();
 };
 #endif
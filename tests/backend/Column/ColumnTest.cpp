@@ -13,12 +13,21 @@
 #include "ColumnTest.h"
 #include "backend/core/Project.h"
 #include "backend/core/column/Column.h"
+#include "backend/core/column/ColumnArrow.h"
+#include "backend/core/column/ColumnCacheFile.h"
 #include "backend/core/column/ColumnPrivate.h"
+#include "backend/lib/RowBitmap.h"
+#include "backend/lib/TextDictionary.h"
+#include "backend/lib/UndoMemoryBudget.h"
 #include "backend/lib/XmlStreamReader.h"
 #include "backend/lib/trace.h"
 #include "backend/spreadsheet/Spreadsheet.h"
 
+#include <QTemporaryDir>
+#include <QThreadPool>
+#include <QTimeZone>
 #include <QUndoStack>
+#include <QtEndian>
 
 #define SETUP_C1_C2_COLUMNS(c1Vector, c2Vector)                                                                                                                \
 	auto c1 = Column(QStringLiteral("DataColumn"), Column::ColumnMode::Double);                                                                                \
@@ -134,6 +143,173 @@ void ColumnTest::bigIntMaximum() {
 
 /////////////////////////////////////////////////////
 
+/*!
+ * range queries on large columns are answered by the min/max index,
+ * check the results after changing, appending and removing values
+ */
+void ColumnTest::minMaxIndex() {
+	const int count = 100000;
+	QVector<double> values(count);
+	for (int i = 0; i < count; ++i)
+		values[i] = std::sin(i * 0.01) * i;
+	values[500] = NAN;
+
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.replaceValues(-1, values);
+	QCOMPARE(c.properties(), Column::Properties::No); // invalid value in row 500
+
+	const auto check = [&]() {
+		const int ranges[][2] = {{0, c.rowCount() - 1}, {3, 7}, {10, 5000}, {499, 501}, {1234, 98765}, {c.rowCount() - 200, c.rowCount() - 1}};
+		for (const auto& range : ranges) {
+			double min = INFINITY, max = -INFINITY;
+			for (int i = range[0]; i <= range[1]; ++i) {
+				const double value = c.valueAt(i);
+				if (std::isnan(value))
+					continue;
+				min = std::min(min, value);
+				max = std::max(max, value);
+			}
+			QCOMPARE(c.minimum(range[0], range[1]), min);
+			QCOMPARE(c.maximum(range[0], range[1]), max);
+		}
+	};
+	check();
+
+	// change single values
+	c.setValueAt(2000, -1.e6);
+	c.setValueAt(90000, 1.e6);
+	check();
+
+	// replace a range of values
+	c.replaceValues(1230, QVector<double>(100, 2.e6));
+	check();
+
+	// append rows
+	c.setValueAt(count + 1000, -3.e6);
+	QCOMPARE(c.rowCount(), count + 1001);
+	check();
+
+	// remove rows
+	c.removeRows(1000, 5000);
+	check();
+}
+
+void ColumnTest::minMaxIndexMasked() {
+	const int count = 10000;
+	QVector<int> values(count);
+	for (int i = 0; i < count; ++i)
+		values[i] = (i * 37) % 1001;
+	values[5000] = 5000;
+
+	Column c(QStringLiteral("Integer column"), Column::ColumnMode::Integer);
+	c.replaceInteger(-1, values);
+	QCOMPARE(c.maximum(0, count - 1), 5000.);
+	QCOMPARE(c.maximum(4000, 6000), 5000.);
+
+	c.setMasked(5000);
+	QCOMPARE(c.maximum(0, count - 1), 1000.);
+	QCOMPARE(c.maximum(4000, 6000), 1000.);
+
+	c.clearMasks();
+	QCOMPARE(c.maximum(4000, 6000), 5000.);
+}
+
+void ColumnTest::benchmarkMinMaxIndex() {
+	const int count = 10000000;
+	QVector<double> values(count);
+	for (int i = 0; i < count; ++i)
+		values[i] = std::sin(i * 0.001);
+
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.replaceValues(-1, values);
+	c.minimum(0, count - 1); // build the index
+
+	QBENCHMARK {
+		// autoscaling of the y-range for many x-ranges, e.g. while zooming and panning
+		double max = -INFINITY;
+		for (int i = 0; i < 1000; ++i) {
+			const int start = (i * 7919) % (count / 2);
+			max = std::max(max, c.maximum(start, start + count / 3));
+		}
+		QVERIFY(max <= 1.);
+	}
+}
+
+/*!
+ * the monotonicity of large columns is tracked per block of rows,
+ * check the properties after appending and changing values
+ */
+void ColumnTest::propertiesIncremental() {
+	const int count = 100000;
+	QVector<double> values(count);
+	for (int i = 0; i < count; ++i)
+		values[i] = i * 0.5;
+
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.replaceValues(-1, values);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// append increasing values
+	c.replaceValues(count, QVector<double>{count * 0.5, count * 0.5 + 1.});
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// append a smaller value
+	c.setValueAt(count + 2, 0.);
+	QCOMPARE(c.properties(), Column::Properties::NonMonotonic);
+
+	// correct the appended value
+	c.setValueAt(count + 2, count);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// smaller value at the border of two blocks of rows
+	c.setValueAt(4096, 0.);
+	QCOMPARE(c.properties(), Column::Properties::NonMonotonic);
+	c.setValueAt(4096, 2048.);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// invalid and masked values
+	c.setValueAt(50000, NAN);
+	QCOMPARE(c.properties(), Column::Properties::No);
+	c.setValueAt(50000, 25000.);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+	c.setMasked(0);
+	QCOMPARE(c.properties(), Column::Properties::No);
+	c.clearMasks();
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// remove rows
+	c.removeRows(1000, 5000);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+
+	// constant and decreasing integers
+	Column ci(QStringLiteral("Integer column"), Column::ColumnMode::Integer);
+	ci.replaceInteger(-1, QVector<int>(count, 5));
+	QCOMPARE(ci.properties(), Column::Properties::Constant);
+	ci.setIntegerAt(count, 4);
+	QCOMPARE(ci.properties(), Column::Properties::MonotonicDecreasing);
+	ci.setIntegerAt(count + 1, 6);
+	QCOMPARE(ci.properties(), Column::Properties::NonMonotonic);
+}
+
+void ColumnTest::benchmarkPropertiesAppend() {
+	const int count = 10000000;
+	QVector<double> values(count);
+	for (int i = 0; i < count; ++i)
+		values[i] = i;
+
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.replaceValues(-1, values);
+	QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing); // build the index
+
+	int row = count;
+	QBENCHMARK {
+		// live data: one value is appended and the properties are requested again, e.g. when the curve is updated
+		c.setValueAt(row, row);
+		++row;
+		QCOMPARE(c.properties(), Column::Properties::MonotonicIncreasing);
+	}
+}
+
 void ColumnTest::statisticsDouble() {
 	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
 	c.setValues({1.0, 1.0, 2.0, 5.0});
@@ -503,6 +679,78 @@ void ColumnTest::statisticsText() {
 	QCOMPARE(stats.unique, 2);
 }
 
+void ColumnTest::statisticsLargeOffset() {
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.setValues({1e9 + 4., 1e9 + 7., 1e9 + 13., 1e9 + 16.});
+
+	auto& stats = c.statistics();
+	QCOMPARE(stats.size, 4);
+	QCOMPARE(stats.arithmeticMean, 1e9 + 10.);
+	QCOMPARE(stats.variance, 30.);
+	QCOMPARE(stats.skewness, 0.);
+	QCOMPARE(stats.kurtosis, 1.36);
+	QCOMPARE(stats.median, 1e9 + 10.);
+}
+
+void ColumnTest::statisticsAppend() {
+	const int count = 200000;
+	QVector<double> values(count);
+	for (int i = 0; i < count; ++i)
+		values[i] = (i * 7919) % 1000 + 0.25 * (i % 4);
+
+	// column with the first half of the values, the second half is appended after the first calculation
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.replaceValues(0, values.mid(0, count / 2));
+	c.setMasked(Interval<int>(10, 20));
+	QCOMPARE(c.statistics().size, count / 2 - 11);
+	c.replaceValues(count / 2, values.mid(count / 2));
+
+	Column reference(QStringLiteral("Reference column"), Column::ColumnMode::Double);
+	reference.replaceValues(0, values);
+	reference.setMasked(Interval<int>(10, 20));
+
+	const auto& stats = c.statistics();
+	const auto& expected = reference.statistics();
+	QCOMPARE(stats.size, count - 11);
+	QCOMPARE(stats.size, expected.size);
+	QCOMPARE(stats.minimum, expected.minimum);
+	QCOMPARE(stats.maximum, expected.maximum);
+	QCOMPARE(stats.arithmeticMean, expected.arithmeticMean);
+	QCOMPARE(stats.geometricMean, expected.geometricMean);
+	QCOMPARE(stats.harmonicMean, expected.harmonicMean);
+	QCOMPARE(stats.contraharmonicMean, expected.contraharmonicMean);
+	QCOMPARE(stats.mode, expected.mode);
+	QCOMPARE(stats.median, expected.median);
+	QCOMPARE(stats.percentile_1, expected.percentile_1);
+	QCOMPARE(stats.percentile_99, expected.percentile_99);
+	QCOMPARE(stats.variance, expected.variance);
+	QCOMPARE(stats.meanDeviation, expected.meanDeviation);
+	QCOMPARE(stats.medianDeviation, expected.medianDeviation);
+	QCOMPARE(stats.skewness, expected.skewness);
+	QCOMPARE(stats.kurtosis, expected.kurtosis);
+	QCOMPARE(stats.entropy, expected.entropy);
+
+	// changing a value of the first half invalidates the moments
+	c.setValueAt(0, 5000.);
+	QCOMPARE(c.statistics().maximum, 5000.);
+	QCOMPARE(c.statistics().size, count - 11);
+}
+
+void ColumnTest::benchmarkStatistics() {
+	const int count = 10000000;
+	QVector<double> values(count);
+	for (int i = 0; i < count; ++i)
+		values[i] = std::sin(i * 0.001) * 1000. + (i % 7);
+
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.replaceValues(-1, values);
+
+	QBENCHMARK {
+		c.invalidateProperties();
+		QCOMPARE(c.statistics().size, count);
+	}
+}
+
 void ColumnTest::statisticsMaskValues() {
 	Project project;
 	auto* c = new Column(QStringLiteral("Integer column"), Column::ColumnMode::Integer);
@@ -582,6 +830,267 @@ void ColumnTest::statisticsClearSpreadsheetMasks() {
 	QCOMPARE(stats5.maximum, 3.);
 }
 
+void ColumnTest::maskRowBitmap() {
+	RowBitmap bitmap;
+	QVERIFY(!bitmap.test(0));
+	QCOMPARE(bitmap.nextSet(0), RowBitmap::NoRow);
+	QCOMPARE(bitmap.nextUnset(10), 10);
+
+	// ranges within one word and across several words
+	bitmap.setRange(3, 5);
+	bitmap.setRange(60, 200);
+	QVERIFY(!bitmap.test(2));
+	QVERIFY(bitmap.test(3));
+	QVERIFY(bitmap.test(5));
+	QVERIFY(!bitmap.test(6));
+	QVERIFY(bitmap.test(63));
+	QVERIFY(bitmap.test(64));
+	QVERIFY(bitmap.test(200));
+	QVERIFY(!bitmap.test(201));
+	QCOMPARE(bitmap.nextSet(0), 3);
+	QCOMPARE(bitmap.nextUnset(3), 6);
+	QCOMPARE(bitmap.nextSet(6), 60);
+	QCOMPARE(bitmap.nextUnset(60), 201);
+	QCOMPARE(bitmap.nextSet(201), RowBitmap::NoRow);
+
+	// unset a part of the range and beyond the end of the bitmap
+	bitmap.setRange(100, 1000, false);
+	QVERIFY(bitmap.test(99));
+	QVERIFY(!bitmap.test(100));
+	QCOMPARE(bitmap.nextUnset(60), 100);
+	QCOMPARE(bitmap.nextSet(100), RowBitmap::NoRow);
+
+	bitmap.clear();
+	QVERIFY(!bitmap.test(3));
+}
+
+void ColumnTest::maskRuns() {
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.setValues({0., 1., 2., 3., 4., 5., 6., 7., 8., 9.});
+	c.setMasked(Interval<int>(2, 4));
+	c.setMasked(7);
+
+	QVERIFY(!c.isMasked(1));
+	QVERIFY(c.isMasked(2));
+	QVERIFY(c.isMasked(4));
+	QVERIFY(!c.isMasked(5));
+	QVERIFY(c.isMasked(Interval<int>(2, 4)));
+	QVERIFY(!c.isMasked(Interval<int>(2, 5)));
+
+	// iterate over the runs of unmasked rows
+	QVector<Interval<int>> runs;
+	int row = c.nextUnmaskedRow(0);
+	while (row < c.rowCount()) {
+		const int end = std::min(c.nextMaskedRow(row), c.rowCount());
+		runs << Interval<int>(row, end - 1);
+		row = c.nextUnmaskedRow(end);
+	}
+	QCOMPARE(runs.size(), 3);
+	QCOMPARE(runs.at(0), Interval<int>(0, 1));
+	QCOMPARE(runs.at(1), Interval<int>(5, 6));
+	QCOMPARE(runs.at(2), Interval<int>(8, 9));
+
+	c.setMasked(Interval<int>(3, 7), false);
+	QVERIFY(c.isMasked(2));
+	QVERIFY(!c.isMasked(3));
+	QVERIFY(!c.isMasked(7));
+	QCOMPARE(c.maskedIntervals().size(), 1);
+	QCOMPARE(c.nextMaskedRow(3), INT_MAX);
+}
+
+void ColumnTest::maskInsertRemoveRows() {
+	Project project;
+	auto* c = new Column(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c->setValues({0., 1., 2., 3., 4., 5.});
+	project.addChild(c);
+	c->setMasked(Interval<int>(2, 3));
+
+	// inserted rows move the masked rows behind them
+	c->insertRows(1, 2);
+	QVERIFY(!c->isMasked(2));
+	QVERIFY(c->isMasked(4));
+	QVERIFY(c->isMasked(5));
+	QVERIFY(!c->isMasked(6));
+
+	project.undoStack()->undo();
+	QVERIFY(c->isMasked(2));
+	QVERIFY(c->isMasked(3));
+	QVERIFY(!c->isMasked(4));
+
+	// removed rows remove their masks
+	c->removeRows(0, 3);
+	QVERIFY(c->isMasked(0));
+	QVERIFY(!c->isMasked(1));
+	QVERIFY(!c->isMasked(2));
+
+	project.undoStack()->undo();
+	QVERIFY(!c->isMasked(1));
+	QVERIFY(c->isMasked(2));
+	QVERIFY(c->isMasked(3));
+
+	// clear and restore the masks
+	c->clearMasks();
+	QVERIFY(!c->isMasked(2));
+	QCOMPARE(c->nextMaskedRow(0), INT_MAX);
+	project.undoStack()->undo();
+	QVERIFY(c->isMasked(2));
+	QCOMPARE(c->nextMaskedRow(0), 2);
+}
+
+void ColumnTest::benchmarkIsMasked() {
+	const int count = 1000000;
+	Column c(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	c.resizeTo(count);
+
+	// many scattered masked rows
+	for (int row = 0; row < count; row += 100)
+		c.setMasked(row);
+
+	QBENCHMARK {
+		int masked = 0;
+		for (int row = 0; row < count; ++row)
+			if (c.isMasked(row))
+				++masked;
+		QCOMPARE(masked, count / 100);
+	}
+}
+
+/*!
+ * copying a column that differs only in some rows keeps only the old values of these rows for undo
+ */
+void ColumnTest::copyChangedRowsUndo() {
+	const int count = 100000;
+	QVector<double> values(count);
+	for (int i = 0; i < count; ++i)
+		values[i] = i;
+
+	Project project;
+	auto* c = new Column(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	project.addChild(c);
+	c->replaceValues(-1, values);
+	QCOMPARE(c->maximum(0, count - 1), count - 1.);
+
+	auto newValues = values;
+	for (int i = 100; i < 200; ++i)
+		newValues[i] = -i;
+	newValues[count - 1] = NAN;
+	Column source(QStringLiteral("Source column"), Column::ColumnMode::Double);
+	source.replaceValues(-1, newValues);
+
+	c->copy(&source);
+	QCOMPARE(c->valueAt(150), -150.);
+	QVERIFY(std::isnan(c->valueAt(count - 1)));
+	QCOMPARE(c->maximum(0, count - 1), count - 2.);
+
+	auto* stack = project.undoStack();
+	QCOMPARE(UndoMemoryBudget::memorySize(stack->command(stack->index() - 1)), qint64(101 * sizeof(double)));
+
+	stack->undo();
+	QCOMPARE(c->valueAt(150), 150.);
+	QCOMPARE(c->valueAt(count - 1), count - 1.);
+	QCOMPARE(c->maximum(0, count - 1), count - 1.);
+
+	stack->redo();
+	QCOMPARE(c->valueAt(150), -150.);
+	QVERIFY(std::isnan(c->valueAt(count - 1)));
+	QCOMPARE(c->maximum(0, count - 1), count - 2.);
+}
+
+void ColumnTest::partialCopyUndo() {
+	Project project;
+	auto* c = new Column(QStringLiteral("Integer column"), Column::ColumnMode::Integer);
+	project.addChild(c);
+	c->setIntegers({1, 2, 3, 4, 5});
+
+	Column source(QStringLiteral("Source column"), Column::ColumnMode::Integer);
+	source.setIntegers({10, 20, 30});
+	c->copy(&source, 1, 2, 2);
+	QCOMPARE(c->rowCount(), 5);
+	QCOMPARE(c->integerAt(1), 2);
+	QCOMPARE(c->integerAt(2), 20);
+	QCOMPARE(c->integerAt(3), 30);
+	QCOMPARE(c->integerAt(4), 5);
+
+	// only the copied rows are kept
+	auto* stack = project.undoStack();
+	QCOMPARE(UndoMemoryBudget::memorySize(stack->command(stack->index() - 1)), qint64(2 * sizeof(int)));
+
+	// changing the source doesn't influence redo
+	source.setIntegers({0, 0, 0});
+
+	stack->undo();
+	QCOMPARE(c->integerAt(2), 3);
+	QCOMPARE(c->integerAt(3), 4);
+
+	stack->redo();
+	QCOMPARE(c->integerAt(2), 20);
+	QCOMPARE(c->integerAt(3), 30);
+}
+
+/*!
+ * the oldest commands are removed from the undo history if the memory limit is exceeded
+ */
+void ColumnTest::undoMemoryLimit() {
+	const int count = 10000;
+	Project project;
+	auto* c = new Column(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	project.addChild(c);
+	c->replaceValues(-1, QVector<double>(count, 0.));
+
+	// every copy keeps the old values of all rows, the last three copies fit into the limit
+	project.setUndoMemoryLimit(3 * count * sizeof(double));
+	for (int i = 1; i <= 5; ++i) {
+		Column source(QStringLiteral("Source column"), Column::ColumnMode::Double);
+		source.replaceValues(-1, QVector<double>(count, i));
+		c->copy(&source);
+	}
+
+	auto* stack = project.undoStack();
+	QCOMPARE(stack->count(), 6);
+	QVERIFY(stack->command(2)->isObsolete());
+	QVERIFY(!stack->command(3)->isObsolete());
+
+	// undo the last three copies, the evicted commands don't change the values anymore
+	for (int i = 4; i >= 2; --i) {
+		stack->undo();
+		QCOMPARE(c->valueAt(0), (double)i);
+	}
+	while (stack->canUndo())
+		stack->undo();
+	QCOMPARE(stack->count(), 3);
+	QCOMPARE(c->valueAt(count - 1), 2.);
+
+	while (stack->canRedo())
+		stack->redo();
+	QCOMPARE(c->valueAt(0), 5.);
+}
+
+/*!
+ * undoing evicted commands replacing the whole column must not clear the column
+ */
+void ColumnTest::undoMemoryLimitReplaceColumn() {
+	const int count = 10000;
+	Project project;
+	auto* c = new Column(QStringLiteral("Double column"), Column::ColumnMode::Double);
+	project.addChild(c);
+	c->replaceValues(-1, QVector<double>(count, 0.));
+
+	// every replace keeps the old values of all rows, only the last one fits into the limit
+	project.setUndoMemoryLimit(count * sizeof(double));
+	for (int i = 1; i <= 3; ++i)
+		c->replaceValues(-1, QVector<double>(count, i));
+
+	auto* stack = project.undoStack();
+	QCOMPARE(stack->count(), 4);
+	QVERIFY(stack->command(2)->isObsolete());
+	QVERIFY(!stack->command(3)->isObsolete());
+
+	stack->setIndex(0);
+	QCOMPARE(c->rowCount(), count);
+	QCOMPARE(c->valueAt(0), 2.);
+	QCOMPARE(c->valueAt(count - 1), 2.);
+}
+
 void ColumnTest::testFormulaAutoUpdateEnabled() {
 	Column sourceColumn(QStringLiteral("source"), Column::ColumnMode::Integer);
 	sourceColumn.setIntegers({1, 2, 3});
@@ -760,8 +1269,532 @@ void ColumnTest::testTextFrequencies() {
 	QCOMPARE(frequencies[QStringLiteral("no")], 2);
 }
 
+void ColumnTest::testTextDictionary() {
+	Column c(QStringLiteral("Text column"), Column::ColumnMode::Text);
+	c.setText({QStringLiteral("yes"), QStringLiteral("no"), QString(), QStringLiteral("no"), QStringLiteral("maybe")});
+
+	const auto& dictionary = c.dictionary();
+	QCOMPARE(dictionary.size(), 3);
+	QCOMPARE(dictionary.rowCount(), 5);
+	QCOMPARE(dictionary.strings(), (QVector<QString>{QStringLiteral("yes"), QStringLiteral("no"), QStringLiteral("maybe")}));
+
+	QCOMPARE(dictionary.code(0), 0u);
+	QCOMPARE(dictionary.code(1), 1u);
+	QCOMPARE(dictionary.code(2), TextDictionary::EmptyCode);
+	QCOMPARE(dictionary.code(3), 1u);
+	QCOMPARE(dictionary.code(4), 2u);
+	QCOMPARE(dictionary.code(QStringLiteral("no")), 1u);
+	QCOMPARE(dictionary.code(QString()), TextDictionary::EmptyCode);
+	QCOMPARE(dictionary.code(QStringLiteral("unknown")), TextDictionary::UnknownCode);
+	QCOMPARE(dictionary.count(1), 2);
+
+	// empty strings are not part of the dictionary
+	QCOMPARE(c.dictionaryIndex(2), 3);
+
+	// ranks of the sorted strings: maybe < no < yes
+	QCOMPARE(dictionary.ranks(), (QVector<int>{2, 1, 0}));
+}
+
+/*!
+ * equal strings share their data after the encoding, the values don't change
+ */
+void ColumnTest::testTextDictionaryEncode() {
+	QVector<QString> values;
+	for (int i = 0; i < 100; ++i)
+		values << QStringLiteral("status %1").arg(i % 3);
+
+	Column c(QStringLiteral("Text column"), Column::ColumnMode::Text);
+	c.setText(values);
+	values.clear(); // don't share the vector with the column
+	c.encodeTexts();
+
+	QCOMPARE(c.rowCount(), 100);
+	for (int i = 0; i < 100; ++i)
+		QCOMPARE(c.textAt(i), QStringLiteral("status %1").arg(i % 3));
+
+	const auto* data = static_cast<QVector<QString>*>(c.data());
+	QCOMPARE(data->at(3).constData(), data->at(0).constData());
+	QCOMPARE(data->at(4).constData(), data->at(1).constData());
+	QVERIFY(data->at(0).constData() != data->at(1).constData());
+
+	QCOMPARE(c.frequencies().value(QStringLiteral("status 0")), 34);
+	QCOMPARE(c.frequencies().value(QStringLiteral("status 2")), 33);
+}
+
+void ColumnTest::benchmarkTextFrequencies() {
+	const int rows = 1000000;
+	QVector<QString> values(rows);
+	for (int i = 0; i < rows; ++i)
+		values[i] = QStringLiteral("device %1").arg(i % 500);
+
+	Column c(QStringLiteral("Text column"), Column::ColumnMode::Text);
+	c.setText(values);
+
+	int unique = 0;
+	QBENCHMARK {
+		c.invalidateProperties();
+		unique = c.frequencies().size();
+	}
+	QCOMPARE(unique, 500);
+}
+
 //////////////////////////////////////////////////
 
+/*!
+ * values are written in chunks, the summary of every chunk ignores NaN values
+ */
+void ColumnTest::cacheFileWriteRead() {
+	QTemporaryDir dir;
+	const QString fileName = dir.filePath(QStringLiteral("test.lpcc"));
+
+	ColumnCacheFile::Writer writer(fileName, 4);
+	QVERIFY(writer.open());
+	const int x = writer.addColumn(QStringLiteral("x"));
+	const int y = writer.addColumn(QStringLiteral("y"));
+	const QVector<double> xValues{1., 2., 3., 4., 5., 6., 7., 8., 9., 10.};
+	const QVector<double> yValues{NAN, NAN, NAN, NAN, -1., NAN, 3., 2.};
+	// append in parts not matching the chunks
+	QVERIFY(writer.append(x, xValues.constData(), 3));
+	QVERIFY(writer.append(y, yValues.constData(), yValues.size()));
+	QVERIFY(writer.append(x, xValues.constData() + 3, 7));
+	QVERIFY(writer.finish());
+
+	ColumnCacheFile file(fileName);
+	QVERIFY(file.open());
+	QCOMPARE(file.columnCount(), 2);
+	QCOMPARE(file.columnName(0), QStringLiteral("x"));
+	QCOMPARE(file.columnName(1), QStringLiteral("y"));
+	QCOMPARE(file.rowCount(0), 10);
+	QCOMPARE(file.rowCount(1), 8);
+	QCOMPARE(file.chunkRows(), 4);
+	QCOMPARE(file.chunkCount(0), 3);
+	QCOMPARE(file.chunkCount(1), 2);
+
+	for (int row = 0; row < xValues.size(); ++row)
+		QCOMPARE(file.value(0, row), xValues.at(row));
+	QVERIFY(std::isnan(file.value(0, 10)));
+
+	QCOMPARE(file.chunkInfo(0, 2).rows, 2);
+	QCOMPARE(file.chunkInfo(0, 2).min, 9.);
+	QCOMPARE(file.chunkInfo(0, 2).max, 10.);
+	QCOMPARE(file.chunkInfo(1, 0).nanCount, 4);
+	QCOMPARE(file.chunkInfo(1, 1).nanCount, 1);
+	QCOMPARE(file.chunkInfo(1, 1).min, -1.);
+	QCOMPARE(file.chunkInfo(1, 1).max, 3.);
+
+	double min, max;
+	file.minMax(0, 2, 8, min, max);
+	QCOMPARE(min, 3.);
+	QCOMPARE(max, 9.);
+	file.minMax(1, 0, 7, min, max);
+	QCOMPARE(min, -1.);
+	QCOMPARE(max, 3.);
+	file.minMax(1, 0, 3, min, max);
+	QCOMPARE(min, INFINITY);
+	QCOMPARE(max, -INFINITY);
+
+	QVector<double> copied(6);
+	file.copy(0, 2, 6, copied.data());
+	QCOMPARE(copied, (QVector<double>{3., 4., 5., 6., 7., 8.}));
+
+	// invalid files
+	ColumnCacheFile invalidFile(dir.filePath(QStringLiteral("missing.lpcc")));
+	QVERIFY(!invalidFile.open());
+	QVERIFY(!invalidFile.errorString().isEmpty());
+
+	// the layout of the chunks in the footer has to match the number of rows and the rows per chunk
+	const QString layoutFileName = dir.filePath(QStringLiteral("layout.lpcc"));
+	ColumnCacheFile::Writer layoutWriter(layoutFileName, 4);
+	QVERIFY(layoutWriter.open());
+	QVERIFY(layoutWriter.append(layoutWriter.addColumn(QStringLiteral("x")), xValues.constData(), 6));
+	QVERIFY(layoutWriter.finish());
+
+	QFile layoutFile(layoutFileName);
+	QVERIFY(layoutFile.open(QIODevice::ReadWrite));
+	QVERIFY(layoutFile.seek(layoutFile.size() - 16));
+	const qint64 footerOffset = qFromLittleEndian<qint64>(layoutFile.read(8).constData());
+	// chunk rows, column count and the name "x" come before the row count, the chunk count and the offset come before the rows of the first chunk
+	const qint64 rowCountOffset = footerOffset + 4 + 4 + 4 + 2;
+	const qint64 firstChunkRowsOffset = rowCountOffset + 8 + 4 + 8;
+	const auto writeValue = [&layoutFile](qint64 position, auto value) {
+		const auto data = qToLittleEndian(value);
+		layoutFile.seek(position);
+		layoutFile.write(reinterpret_cast<const char*>(&data), sizeof(data));
+		layoutFile.flush();
+	};
+
+	writeValue(rowCountOffset, qint64(7)); // more rows than in the chunks
+	ColumnCacheFile tooManyRows(layoutFileName);
+	QVERIFY(!tooManyRows.open());
+
+	writeValue(rowCountOffset, qint64(5));
+	writeValue(firstChunkRowsOffset, qint32(3)); // first chunk not full
+	ColumnCacheFile partialChunk(layoutFileName);
+	QVERIFY(!partialChunk.open());
+
+	writeValue(rowCountOffset, qint64(6));
+	writeValue(firstChunkRowsOffset, qint32(4));
+	ColumnCacheFile validFile(layoutFileName);
+	QVERIFY(validFile.open());
+	QCOMPARE(validFile.rowCount(0), 6);
+}
+
+/*!
+ * the column reads its values from the cache file without loading them into memory
+ */
+void ColumnTest::cacheFileColumn() {
+	QTemporaryDir dir;
+	const QString fileName = dir.filePath(QStringLiteral("test.lpcc"));
+
+	const int rows = 10000;
+	Column source(QStringLiteral("source"), Column::ColumnMode::Double);
+	QVector<double> values(rows);
+	for (int i = 0; i < rows; ++i)
+		values[i] = (i == 5000) ? NAN : std::sin(i * 0.01) * i;
+	source.replaceValues(-1, values);
+	QVERIFY(ColumnCacheFile::write(fileName, {&source}, 1000));
+
+	auto file = std::make_shared<ColumnCacheFile>(fileName);
+	QVERIFY(file->open());
+
+	Column c(QStringLiteral("cached"), Column::ColumnMode::Double);
+	QVERIFY(c.setCacheFile(file, 0));
+	QVERIFY(c.hasCacheFile());
+	QCOMPARE(c.rowCount(), rows);
+	QCOMPARE(c.valueAt(1), values.at(1));
+	QCOMPARE(c.doubleAt(9999), values.at(9999));
+	QVERIFY(!c.isValid(5000));
+	QCOMPARE(c.minimum(), source.minimum());
+	QCOMPARE(c.maximum(), source.maximum());
+	QCOMPARE(c.minimum(100, 2500), source.minimum(100, 2500));
+	QCOMPARE(c.maximum(100, 2500), source.maximum(100, 2500));
+	QCOMPARE(c.statistics().arithmeticMean, source.statistics().arithmeticMean);
+
+	// masked values are ignored
+	c.setMasked(Interval<int>(0, 5999));
+	source.setMasked(Interval<int>(0, 5999));
+	QCOMPARE(c.minimum(), source.minimum());
+	QCOMPARE(c.maximum(), source.maximum());
+	QVERIFY(c.hasCacheFile());
+
+	// only double columns can use a cache file
+	Column integerColumn(QStringLiteral("integer"), Column::ColumnMode::Integer);
+	QVERIFY(!integerColumn.setCacheFile(file, 0));
+	QVERIFY(!c.setCacheFile(file, 1));
+}
+
+/*!
+ * the values are loaded into memory when the column is modified
+ */
+void ColumnTest::cacheFileColumnModify() {
+	QTemporaryDir dir;
+	const QString fileName = dir.filePath(QStringLiteral("test.lpcc"));
+
+	Column source(QStringLiteral("source"), Column::ColumnMode::Double);
+	source.replaceValues(-1, {1., 2., 3., 4., 5.});
+	QVERIFY(ColumnCacheFile::write(fileName, {&source}, 2));
+
+	auto file = std::make_shared<ColumnCacheFile>(fileName);
+	QVERIFY(file->open());
+
+	Column c(QStringLiteral("cached"), Column::ColumnMode::Double);
+	QVERIFY(c.setCacheFile(file, 0));
+
+	c.setValueAt(1, 20.);
+	QVERIFY(!c.hasCacheFile());
+	QCOMPARE(c.rowCount(), 5);
+	QCOMPARE(c.valueAt(0), 1.);
+	QCOMPARE(c.valueAt(1), 20.);
+	QCOMPARE(c.valueAt(4), 5.);
+
+	// inserting rows loads the values too
+	Column c2(QStringLiteral("cached 2"), Column::ColumnMode::Double);
+	QVERIFY(c2.setCacheFile(file, 0));
+	c2.insertRows(0, 1);
+	QVERIFY(!c2.hasCacheFile());
+	QCOMPARE(c2.rowCount(), 6);
+	QVERIFY(std::isnan(c2.valueAt(0)));
+	QCOMPARE(c2.valueAt(1), 1.);
+	QCOMPARE(c2.valueAt(5), 5.);
+}
+
+/*!
+ * only the reference to the cache file is saved in the project
+ */
+void ColumnTest::cacheFileSaveLoad() {
+	QTemporaryDir dir;
+	const QString fileName = dir.filePath(QStringLiteral("test.lpcc"));
+
+	Column source(QStringLiteral("source"), Column::ColumnMode::Double);
+	source.replaceValues(-1, {1., 2., 3.});
+	QVERIFY(ColumnCacheFile::write(fileName, {&source, &source}, 2));
+
+	auto file = std::make_shared<ColumnCacheFile>(fileName);
+	QVERIFY(file->open());
+	Column c(QStringLiteral("cached"), Column::ColumnMode::Double);
+	QVERIFY(c.setCacheFile(file, 1));
+
+	QByteArray array;
+	QXmlStreamWriter writer(&array);
+	c.save(&writer);
+	QVERIFY(array.contains("cacheFile"));
+	QVERIFY(c.hasCacheFile()); // saving doesn't load the values
+
+	Column c2(QStringLiteral("cached 2"), Column::ColumnMode::Double);
+	XmlStreamReader reader(array);
+	while (!reader.atEnd()) {
+		reader.readNext();
+		if (reader.isStartElement() && reader.name() == QLatin1String("column"))
+			break;
+	}
+	QCOMPARE(c2.load(&reader, false), true);
+	QThreadPool::globalInstance()->waitForDone();
+
+	QVERIFY(c2.hasCacheFile());
+	QCOMPARE(c2.rowCount(), 3);
+	QCOMPARE(c2.valueAt(2), 3.);
+}
+
+namespace {
+// array of a producer counting the calls of its release callback
+struct TestArrowArray {
+	std::vector<double> values;
+	std::vector<uint8_t> validity;
+	const void* buffers[2]{nullptr, nullptr};
+	int* released;
+};
+
+void releaseTestArrowArray(ArrowArray* array) {
+	auto* data = static_cast<TestArrowArray*>(array->private_data);
+	++*data->released;
+	delete data;
+	array->release = nullptr;
+}
+
+ArrowArray testArrowArray(const std::vector<double>& values, const std::vector<uint8_t>& validity, int* released) {
+	auto* data = new TestArrowArray{values, validity, {}, released};
+	data->buffers[0] = validity.empty() ? nullptr : data->validity.data();
+	data->buffers[1] = data->values.data();
+
+	ArrowArray array{};
+	array.length = static_cast<int64_t>(values.size());
+	array.null_count = validity.empty() ? 0 : -1;
+	array.n_buffers = 2;
+	array.buffers = data->buffers;
+	array.release = releaseTestArrowArray;
+	array.private_data = data;
+	return array;
+}
+
+ArrowSchema testArrowSchema(const char* format) {
+	ArrowSchema schema{};
+	schema.format = format;
+	schema.name = "imported";
+	return schema;
+}
+}
+
+void ColumnTest::arrowExport() {
+	Column c(QStringLiteral("double"), Column::ColumnMode::Double);
+	c.setValues({1., NAN, 3.});
+
+	ArrowArray array;
+	ArrowSchema schema;
+	QVERIFY(ColumnArrow::exportColumn(&c, &array, &schema));
+	QCOMPARE(QLatin1String(schema.format), QLatin1String("g"));
+	QCOMPARE(QLatin1String(schema.name), QLatin1String("double"));
+	QCOMPARE(array.length, (int64_t)3);
+	QCOMPARE(array.null_count, (int64_t)1);
+	QCOMPARE(array.n_buffers, (int64_t)2);
+
+	// the values are shared with the column, NaN is exported as null
+	const auto* values = static_cast<const double*>(array.buffers[1]);
+	QCOMPARE(values, static_cast<QVector<double>*>(c.data())->constData());
+	QCOMPARE(static_cast<const uint8_t*>(array.buffers[0])[0], (uint8_t)0b101);
+
+	// the column detaches from the exported values when it's modified
+	c.setValueAt(0, 10.);
+	QCOMPARE(values[0], 1.);
+	QCOMPARE(c.valueAt(0), 10.);
+
+	array.release(&array);
+	schema.release(&schema);
+	QVERIFY(!array.release);
+	QVERIFY(!schema.release);
+
+	// text
+	Column text(QStringLiteral("text"), Column::ColumnMode::Text);
+	text.setText({QStringLiteral("a"), QStringLiteral("bc")});
+	QVERIFY(ColumnArrow::exportColumn(&text, &array, &schema));
+	QCOMPARE(QLatin1String(schema.format), QLatin1String("u"));
+	QCOMPARE(array.n_buffers, (int64_t)3);
+	const auto* offsets = static_cast<const int32_t*>(array.buffers[1]);
+	QCOMPARE(offsets[1], 1);
+	QCOMPARE(offsets[2], 3);
+	QCOMPARE(QByteArray(static_cast<const char*>(array.buffers[2]), 3), QByteArray("abc"));
+	array.release(&array);
+	schema.release(&schema);
+
+	// date-time, invalid values are exported as null
+	const auto dateTime = QDateTime(QDate(2020, 1, 1), QTime(0, 0), QTimeZone::UTC);
+	Column dateTimes(QStringLiteral("datetime"), Column::ColumnMode::DateTime);
+	dateTimes.setDateTimes({dateTime, QDateTime()});
+	QVERIFY(ColumnArrow::exportColumn(&dateTimes, &array, &schema));
+	QCOMPARE(QLatin1String(schema.format), QLatin1String("tsm:UTC"));
+	QCOMPARE(array.null_count, (int64_t)1);
+	QCOMPARE((qint64)static_cast<const int64_t*>(array.buffers[1])[0], dateTime.toMSecsSinceEpoch());
+	array.release(&array);
+	schema.release(&schema);
+}
+
+void ColumnTest::arrowImport() {
+	const std::vector<double> values{1., 2., 3., 4.};
+	int released = 0;
+	auto array = testArrowArray(values, {}, &released);
+	auto schema = testArrowSchema("g");
+	const double* buffer = static_cast<const double*>(array.buffers[1]);
+
+	// float64 without null values is not copied, the array is moved
+	auto* c = ColumnArrow::importColumn(&array, &schema);
+	QVERIFY(c);
+	QVERIFY(!array.release);
+	QVERIFY(c->hasCacheFile());
+	QCOMPARE(c->cacheFile()->columnData(0), buffer);
+	QCOMPARE(c->name(), QStringLiteral("imported"));
+	QCOMPARE(c->rowCount(), 4);
+	QCOMPARE(c->valueAt(2), 3.);
+	QCOMPARE(c->maximum(), 4.);
+	QCOMPARE(released, 0);
+
+	// exporting the imported column again shares the memory of the producer
+	ArrowArray exported;
+	ArrowSchema exportedSchema;
+	QVERIFY(ColumnArrow::exportColumn(c, &exported, &exportedSchema));
+	QCOMPARE(static_cast<const double*>(exported.buffers[1]), buffer);
+
+	// the values are copied when the column is modified, the array is released when the export is released too
+	c->setValueAt(0, 10.);
+	QVERIFY(!c->hasCacheFile());
+	QCOMPARE(c->valueAt(0), 10.);
+	QCOMPARE(c->valueAt(3), 4.);
+	QCOMPARE(released, 0);
+	exported.release(&exported);
+	exportedSchema.release(&exportedSchema);
+	QCOMPARE(released, 1);
+	delete c;
+
+	// the array is released when the column is deleted
+	released = 0;
+	array = testArrowArray(values, {}, &released);
+	c = ColumnArrow::importColumn(&array, &schema);
+	QVERIFY(c);
+	delete c;
+	QCOMPARE(released, 1);
+
+	// the array is released if it can't be imported
+	released = 0;
+	array = testArrowArray(values, {}, &released);
+	auto unsupported = testArrowSchema("+l");
+	QString error;
+	QVERIFY(!ColumnArrow::importColumn(&array, &unsupported, &error));
+	QVERIFY(!error.isEmpty());
+	QCOMPARE(released, 1);
+}
+
+void ColumnTest::arrowImportNulls() {
+	int released = 0;
+	// rows 0 and 2 are valid
+	auto array = testArrowArray({1., 2., 3.}, {0b101}, &released);
+	auto schema = testArrowSchema("g");
+	std::unique_ptr<Column> c(ColumnArrow::importColumn(&array, &schema));
+	QVERIFY(c);
+	QVERIFY(!c->hasCacheFile()); // copied
+	QCOMPARE(released, 1);
+	QCOMPARE(c->valueAt(0), 1.);
+	QVERIFY(std::isnan(c->valueAt(1)));
+	QCOMPARE(c->valueAt(2), 3.);
+
+	// the offset of the array is taken into account
+	released = 0;
+	array = testArrowArray({1., 2., 3.}, {0b101}, &released);
+	array.offset = 1;
+	array.length = 2;
+	c.reset(ColumnArrow::importColumn(&array, &schema));
+	QVERIFY(c);
+	QCOMPARE(c->rowCount(), 2);
+	QVERIFY(std::isnan(c->valueAt(0)));
+	QCOMPARE(c->valueAt(1), 3.);
+
+	// integers with null values become doubles
+	struct {
+		std::vector<int32_t> values{5, 6};
+		std::vector<uint8_t> validity{0b10};
+		const void* buffers[2];
+	} integers;
+	integers.buffers[0] = integers.validity.data();
+	integers.buffers[1] = integers.values.data();
+	ArrowArray integerArray{};
+	integerArray.length = 2;
+	integerArray.null_count = 1;
+	integerArray.n_buffers = 2;
+	integerArray.buffers = integers.buffers;
+	integerArray.release = [](ArrowArray* array) {
+		array->release = nullptr;
+	};
+	auto integerSchema = testArrowSchema("i");
+	c.reset(ColumnArrow::importColumn(&integerArray, &integerSchema));
+	QVERIFY(c);
+	QCOMPARE(c->columnMode(), Column::ColumnMode::Double);
+	QVERIFY(std::isnan(c->valueAt(0)));
+	QCOMPARE(c->valueAt(1), 6.);
+
+	// without null values they stay integers
+	integerArray.null_count = 0;
+	integerArray.release = [](ArrowArray* array) {
+		array->release = nullptr;
+	};
+	c.reset(ColumnArrow::importColumn(&integerArray, &integerSchema));
+	QVERIFY(c);
+	QCOMPARE(c->columnMode(), Column::ColumnMode::Integer);
+	QCOMPARE(c->integerAt(0), 5);
+}
+
+void ColumnTest::arrowSpreadsheet() {
+	Project project;
+	auto* source = new Spreadsheet(QStringLiteral("source"));
+	project.addChild(source);
+	source->setColumnCount(2);
+	source->setRowCount(3);
+	source->column(0)->setValues({1., 2., 3.});
+	source->column(1)->setColumnMode(Column::ColumnMode::Text);
+	source->column(1)->setText({QStringLiteral("a"), QString(), QStringLiteral("c")});
+
+	ArrowArray array;
+	ArrowSchema schema;
+	QVERIFY(source->exportArrow(&array, &schema));
+	QCOMPARE(QLatin1String(schema.format), QLatin1String("+s"));
+	QCOMPARE(array.n_children, (int64_t)2);
+	QCOMPARE(array.length, (int64_t)3);
+
+	auto* target = new Spreadsheet(QStringLiteral("target"));
+	project.addChild(target);
+	QVERIFY(target->importArrow(&array, &schema));
+	QVERIFY(!array.release);
+	schema.release(&schema);
+
+	QCOMPARE(target->columnCount(), 2);
+	QCOMPARE(target->rowCount(), 3);
+	QCOMPARE(target->column(0)->name(), source->column(0)->name());
+	QVERIFY(target->column(0)->hasCacheFile()); // shared with the source spreadsheet
+	QCOMPARE(target->column(0)->valueAt(2), 3.);
+	QCOMPARE(target->column(1)->columnMode(), Column::ColumnMode::Text);
+	QCOMPARE(target->column(1)->textAt(2), QStringLiteral("c"));
+
+	// the imported values don't change when the source is modified
+	source->column(0)->setValueAt(2, 30.);
+	QCOMPARE(target->column(0)->valueAt(2), 3.);
+}
+
 void ColumnTest::saveLoadDateTime() {
 	Column c(QStringLiteral("Datetime column"), Column::ColumnMode::DateTime);
 	c.setDateTimes({
@@ -791,6 +1824,7 @@ void ColumnTest::saveLoadDateTime() {
 	}
 	QCOMPARE(found, true);
 	QCOMPARE(c2.load(&reader, false), true);
+	QThreadPool::globalInstance()->waitForDone(); // the values are decoded in a separate thread
 
 	QCOMPARE(c2.rowCount(), 4);
 	QCOMPARE(c2.dateTimeAt(0).isValid(), true);
@@ -803,6 +1837,120 @@ void ColumnTest::saveLoadDateTime() {
 	QCOMPARE(c2.dateTimeAt(3), QDateTime::fromString(QStringLiteral("2019-03-26T02:14:34.000Z"), Qt::DateFormat::ISODateWithMs));
 }
 
+void ColumnTest::saveLoadDateTimeTimeZone() {
+	const QTimeZone timeZone(3600);
+	Column c(QStringLiteral("Datetime column"), Column::ColumnMode::DateTime);
+	c.setDateTimes({QDateTime(QDate(2020, 1, 1), QTime(12, 0), timeZone), QDateTime(), QDateTime(QDate(2021, 6, 30), QTime(23, 59, 59, 999), timeZone)});
+
+	QByteArray array;
+	QXmlStreamWriter writer(&array);
+	c.save(&writer);
+
+	Column c2(QStringLiteral("Datetime 2 column"), Column::ColumnMode::DateTime);
+	XmlStreamReader reader(array);
+	while (!reader.atEnd()) {
+		reader.readNext();
+		if (reader.isStartElement() && reader.name() == QLatin1String("column"))
+			break;
+	}
+	QCOMPARE(c2.load(&reader, false), true);
+	QThreadPool::globalInstance()->waitForDone();
+
+	QCOMPARE(c2.rowCount(), 3);
+	QCOMPARE(c2.dateTimeAt(0), QDateTime(QDate(2020, 1, 1), QTime(12, 0), timeZone));
+	QCOMPARE(c2.dateTimeAt(0).offsetFromUtc(), 3600);
+	QCOMPARE(c2.dateTimeAt(1).isValid(), false);
+	QCOMPARE(c2.dateTimeAt(2), QDateTime(QDate(2021, 6, 30), QTime(23, 59, 59, 999), timeZone));
+}
+
+/*!
+ * the date-time values are stored as milliseconds since epoch, invalid values have to survive all modifications
+ */
+void ColumnTest::dateTimeStorage() {
+	const auto dateTime1 = QDateTime::fromString(QStringLiteral("2018-03-26T02:14:34.000Z"), Qt::DateFormat::ISODateWithMs);
+	const auto dateTime2 = QDateTime::fromString(QStringLiteral("2019-03-26T02:14:34.123Z"), Qt::DateFormat::ISODateWithMs);
+
+	Column c(QStringLiteral("Datetime column"), Column::ColumnMode::DateTime);
+	c.setDateTimes({dateTime1, QDateTime(), dateTime2});
+	QCOMPARE(c.rowCount(), 3);
+	QCOMPARE(c.valueAt(0), (double)dateTime1.toMSecsSinceEpoch());
+	QCOMPARE(c.valueAt(2), (double)dateTime2.toMSecsSinceEpoch());
+	QCOMPARE(c.dateTimeAt(0), dateTime1);
+	QCOMPARE(c.dateTimeAt(0).timeSpec(), Qt::UTC);
+	QCOMPARE(c.dateTimeAt(1).isValid(), false);
+	QCOMPARE(c.dateTimeAt(2), dateTime2);
+	QCOMPARE(c.minimum(), (double)dateTime1.toMSecsSinceEpoch());
+	QCOMPARE(c.maximum(), (double)dateTime2.toMSecsSinceEpoch());
+
+	c.insertRows(1, 2);
+	QCOMPARE(c.rowCount(), 5);
+	QCOMPARE(c.dateTimeAt(1).isValid(), false);
+	QCOMPARE(c.dateTimeAt(2).isValid(), false);
+	QCOMPARE(c.dateTimeAt(4), dateTime2);
+
+	c.setDateTimeAt(1, dateTime2);
+	QCOMPARE(c.dateTimeAt(1), dateTime2);
+
+	c.removeRows(0, 2);
+	QCOMPARE(c.rowCount(), 3);
+	QCOMPARE(c.dateTimeAt(0).isValid(), false);
+	QCOMPARE(c.dateTimeAt(1).isValid(), false);
+	QCOMPARE(c.dateTimeAt(2), dateTime2);
+
+	c.replaceDateTimes(0, {dateTime1});
+	QCOMPARE(c.dateTimeAt(0), dateTime1);
+	QCOMPARE(c.dateTimeAt(2), dateTime2);
+}
+
+/*!
+ * writing a value in another time zone must not change the time zone of the column and the values in the other rows
+ */
+void ColumnTest::dateTimeOtherTimeZone() {
+	const auto dateTime1 = QDateTime(QDate(2020, 1, 1), QTime(12, 0), QTimeZone::UTC);
+	const auto dateTime2 = QDateTime(QDate(2021, 6, 30), QTime(23, 59, 59, 999), QTimeZone::UTC);
+	const auto dateTime3 = QDateTime(QDate(2022, 3, 15), QTime(8, 30), QTimeZone(3600));
+	const auto localDateTime = QDateTime(QDate(2023, 7, 1), QTime(10, 15), QTimeZone::LocalTime);
+
+	Column c(QStringLiteral("Datetime column"), Column::ColumnMode::DateTime);
+	c.setDateTimes({dateTime1, dateTime2, dateTime1});
+
+	c.setDateTimeAt(2, localDateTime);
+	QCOMPARE(c.dateTimeAt(0), dateTime1);
+	QCOMPARE(c.dateTimeAt(0).timeSpec(), Qt::UTC);
+	QCOMPARE(c.dateTimeAt(0).time(), QTime(12, 0));
+	QCOMPARE(c.dateTimeAt(1), dateTime2);
+	QCOMPARE(c.dateTimeAt(1).time(), QTime(23, 59, 59, 999));
+	QCOMPARE(c.dateTimeAt(2), localDateTime);
+	QCOMPARE(c.dateTimeAt(2).timeSpec(), Qt::UTC);
+
+	// another offset from UTC
+	c.setDateTimeAt(2, dateTime3);
+	QCOMPARE(c.dateTimeAt(0), dateTime1);
+	QCOMPARE(c.dateTimeAt(0).offsetFromUtc(), 0);
+	QCOMPARE(c.dateTimeAt(2), dateTime3);
+	QCOMPARE(c.dateTimeAt(2).offsetFromUtc(), 0);
+}
+
+void ColumnTest::benchmarkDateTimeMinMax() {
+	const int rows = 1000000;
+	const qint64 start = QDateTime(QDate(2020, 1, 1), QTime(0, 0), QTimeZone::UTC).toMSecsSinceEpoch();
+	QVector<QDateTime> dateTimes(rows);
+	for (int i = 0; i < rows; ++i)
+		dateTimes[i] = QDateTime::fromMSecsSinceEpoch(start + ((qint64)i * 7919 % rows) * 1000, QTimeZone::UTC);
+
+	Column c(QStringLiteral("Datetime column"), Column::ColumnMode::DateTime);
+	c.setDateTimes(dateTimes);
+
+	double min = 0, max = 0;
+	QBENCHMARK {
+		c.invalidateProperties(); // don't use the cached minimum and maximum
+		min = c.minimum();
+		max = c.maximum();
+	}
+	QCOMPARE(min, (double)start);
+	QCOMPARE(max, (double)(start + (qint64)(rows - 1) * 1000));
+}
+
 void ColumnTest::loadDoubleFromProject() {
 	Project project;
 	project.load(QFINDTESTDATA(QLatin1String("data/Load.lml")));
@@ -1494,6 +2642,26 @@ void ColumnTest::testFormulasma() {
 	VALUES_EQUAL(c2.valueAt(7), 13. / 3.);
 }
 
+void ColumnTest::testFormulasmmed() {
+	auto c1 = Column(QStringLiteral("DataColumn"), Column::ColumnMode::Double);
+	c1.replaceValues(-1, {1., -1., 5., 5., 3., 8., 10., -5});
+
+	auto c2 = Column(QStringLiteral("FormulaColumn"), Column::ColumnMode::Double);
+	c2.replaceValues(-1, {11., 12., 13., 14., 15., 16., 17., 18.});
+
+	c2.setFormula(QStringLiteral("smmed(3; x)"), {QStringLiteral("x")}, QVector<Column*>({&c1}), true);
+	c2.updateFormula();
+	QCOMPARE(c2.rowCount(), 8);
+	VALUES_EQUAL(c2.valueAt(0), 1.);
+	VALUES_EQUAL(c2.valueAt(1), 0.);
+	VALUES_EQUAL(c2.valueAt(2), 1.);
+	VALUES_EQUAL(c2.valueAt(3), 5.);
+	VALUES_EQUAL(c2.valueAt(4), 5.);
+	VALUES_EQUAL(c2.valueAt(5), 5.);
+	VALUES_EQUAL(c2.valueAt(6), 8.);
+	VALUES_EQUAL(c2.valueAt(7), 8.);
+}
+
 void ColumnTest::testFormulapsample() {
 	auto c1 = Column(QStringLiteral("DataColumn"), Column::ColumnMode::Double);
 	c1.replaceValues(-1, {10., 9., 8., 7., 6., 5., 4., 3., 2., 1.});
@@ -1536,6 +2704,76 @@ void ColumnTest::testFormularsample() {
 	QVERIFY(c2.valueAt(4) == 1. || c2.valueAt(4) == 2.);
 }
 
+/*!
+ * large columns are evaluated in parallel, the result must not depend on the splitting of the rows
+ */
+void ColumnTest::testFormulaParallel() {
+	const int rows = 200000;
+	QVector<double> data(rows);
+	for (int i = 0; i < rows; ++i)
+		data[i] = std::sin(i);
+
+	auto c1 = Column(QStringLiteral("DataColumn"), Column::ColumnMode::Double);
+	c1.replaceValues(-1, data);
+
+	auto c2 = Column(QStringLiteral("FormulaColumn"), Column::ColumnMode::Double);
+	c2.replaceValues(-1, QVector<double>(rows));
+
+	c2.setFormula(QStringLiteral("x^2 + i"), {QStringLiteral("x")}, {&c1}, true);
+	c2.updateFormula();
+	QCOMPARE(c2.rowCount(), rows);
+	for (int i = 0; i < rows; ++i)
+		QCOMPARE(c2.valueAt(i), data.at(i) * data.at(i) + (i + 1));
+}
+
+/*!
+ * the windows of the moving statistics reach back into the rows of the previous range when evaluated in parallel
+ */
+void ColumnTest::testFormulaMovingStatisticsParallel() {
+	const int rows = 200000;
+	QVector<double> data(rows);
+	for (int i = 0; i < rows; ++i)
+		data[i] = std::sin(i);
+
+	auto c1 = Column(QStringLiteral("DataColumn"), Column::ColumnMode::Double);
+	c1.replaceValues(-1, data);
+
+	auto c2 = Column(QStringLiteral("FormulaColumn"), Column::ColumnMode::Double);
+	c2.replaceValues(-1, QVector<double>(rows));
+
+	c2.setFormula(QStringLiteral("smmin(5; x) + sma(3; x)"), {QStringLiteral("x")}, {&c1}, true);
+	c2.updateFormula();
+	QCOMPARE(c2.rowCount(), rows);
+	for (int i = 0; i < rows; ++i) {
+		double min = INFINITY;
+		for (int j = std::max(0, i - 4); j <= i; ++j)
+			min = std::min(min, data.at(j));
+		double sum = 0.;
+		for (int j = std::max(0, i - 2); j <= i; ++j)
+			sum += data.at(j);
+		QCOMPARE(c2.valueAt(i), min + sum / 3.);
+	}
+}
+
+void ColumnTest::testFormulaParallelBenchmark() {
+	const int rows = 2000000;
+	QVector<double> data(rows);
+	for (int i = 0; i < rows; ++i)
+		data[i] = i;
+
+	auto c1 = Column(QStringLiteral("DataColumn"), Column::ColumnMode::Double);
+	c1.replaceValues(-1, data);
+
+	auto c2 = Column(QStringLiteral("FormulaColumn"), Column::ColumnMode::Double);
+	c2.replaceValues(-1, QVector<double>(rows));
+	c2.setFormula(QStringLiteral("sin(x)^2 + cos(x)^2 + sma(10; x)"), {QStringLiteral("x")}, {&c1}, true);
+
+	QBENCHMARK {
+		c2.updateFormula();
+	}
+	QCOMPARE(c2.rowCount(), rows);
+}
+
 /////////////////////////////////////////////////////
 
 void ColumnTest::testFormulasMinColumnInvalid() {
@@ -26,6 +26,11 @@ private Q_SLOTS:
 	void integerMaximum();
 	void bigIntMinimum();
 	void bigIntMaximum();
+	void minMaxIndex();
+	void minMaxIndexMasked();
+	void benchmarkMinMaxIndex();
+	void propertiesIncremental();
+	void benchmarkPropertiesAppend();
 
 	// statistical properties for different column modes
 	void statisticsDouble(); // only positive double values
@@ -39,10 +44,25 @@ private Q_SLOTS:
 	void statisticsIntOverflow(); // check overflow of integer
 	void statisticsBigInt(); // big ints
 	void statisticsText();
+	void statisticsLargeOffset(); // numerical stability for values with a large offset
+	void statisticsAppend(); // incremental update of the moments after rows were appended
+	void benchmarkStatistics();
 
 	void statisticsMaskValues();
 	void statisticsClearSpreadsheetMasks();
 
+	// masking
+	void maskRowBitmap();
+	void maskRuns();
+	void maskInsertRemoveRows();
+	void benchmarkIsMasked();
+
+	// undo
+	void copyChangedRowsUndo();
+	void partialCopyUndo();
+	void undoMemoryLimit();
+	void undoMemoryLimitReplaceColumn();
+
 	// generation of column values via a formula
 	void testFormulaAutoUpdateEnabledResize();
 	void testFormulaAutoUpdateEnabled();
@@ -53,6 +73,21 @@ private Q_SLOTS:
 	// dictionary related tests for text columns
 	void testDictionaryIndex();
 	void testTextFrequencies();
+	void testTextDictionary();
+	void testTextDictionaryEncode();
+	void benchmarkTextFrequencies();
+
+	// cache file
+	void cacheFileWriteRead();
+	void cacheFileColumn();
+	void cacheFileColumnModify();
+	void cacheFileSaveLoad();
+
+	// Arrow C data interface
+	void arrowExport();
+	void arrowImport();
+	void arrowImportNulls();
+	void arrowSpreadsheet();
 
 	// performance of save and load
 	void loadDoubleFromProject();
@@ -61,6 +96,10 @@ private Q_SLOTS:
 	void loadTextFromProject();
 	void loadDateTimeFromProject();
 	void saveLoadDateTime();
+	void saveLoadDateTimeTimeZone();
+	void dateTimeStorage();
+	void dateTimeOtherTimeZone();
+	void benchmarkDateTimeMinMax();
 
 	void testIndexForValue();
 	void testIndexForValueDoubleVector();
@@ -80,8 +119,12 @@ private Q_SLOTS:
 	void testFormulasmmin();
 	void testFormulasmmax();
 	void testFormulasma();
+	void testFormulasmmed();
 	void testFormulapsample();
 	void testFormularsample();
+	void testFormulaParallel();
+	void testFormulaMovingStatisticsParallel();
+	void testFormulaParallelBenchmark();
 
 	void testFormulasMinColumnInvalid();
 
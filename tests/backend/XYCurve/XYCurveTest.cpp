@@ -13,10 +13,14 @@
 #include "backend/core/Project.h"
 #include "backend/core/column/Column.h"
 #include "backend/lib/trace.h"
+#include "backend/spreadsheet/Spreadsheet.h"
+#include "backend/worksheet/Worksheet.h"
+#include "backend/worksheet/plots/cartesian/CartesianPlot.h"
 #include "backend/worksheet/plots/cartesian/XYCurve.h"
 #include "backend/worksheet/plots/cartesian/XYCurvePrivate.h"
 
 #include <QFile>
+#include <QSet>
 #include <QUndoStack>
 
 #define GET_CURVE_PRIVATE(plot, child_index, column_name, curve_variable_name)                                                                                 \
@@ -1975,6 +1979,180 @@ void XYCurveTest::updateLinesLog10() {
 
 // TODO: create tests for Splines
 
+/*!
+ * the logical points of curves with valid double data share the data of the columns
+ */
+void XYCurveTest::recalcSharedColumnData() {
+	Project project;
+	auto* sheet = new Spreadsheet(QStringLiteral("data"), false);
+	project.addChild(sheet);
+	sheet->setColumnCount(2);
+	sheet->setRowCount(5);
+	sheet->column(0)->replaceValues(0, {1., 2., 3., 4., 5.});
+	sheet->column(1)->replaceValues(0, {2., 4., 6., 8., 10.});
+
+	auto* worksheet = new Worksheet(QStringLiteral("worksheet"));
+	project.addChild(worksheet);
+	auto* plot = new CartesianPlot(QStringLiteral("plot"));
+	plot->setType(CartesianPlot::Type::TwoAxes);
+	worksheet->addChild(plot);
+	auto* curve = new XYCurve(QStringLiteral("curve"));
+	plot->addChild(curve);
+	curve->setXColumn(sheet->column(0));
+	curve->setYColumn(sheet->column(1));
+	auto* curvePrivate = curve->d_func();
+	curvePrivate->recalc();
+
+	const auto& points = curvePrivate->m_logicalPoints;
+	QVERIFY(points.isShared());
+	QCOMPARE(points.size(), qsizetype(5));
+	QCOMPARE(points.at(2), QPointF(3., 6.));
+
+	// the shared data is updated when the curve is recalculated after the column was modified
+	sheet->column(1)->setValueAt(2, 7.);
+	curvePrivate->recalc();
+	QVERIFY(points.isShared());
+	QCOMPARE(points.at(2), QPointF(3., 7.));
+
+	// invalid values are skipped, the points are copied
+	sheet->column(1)->setValueAt(2, NAN);
+	curvePrivate->recalc();
+	QVERIFY(!points.isShared());
+	QCOMPARE(points.size(), qsizetype(4));
+	QCOMPARE(points.at(2), QPointF(4., 8.));
+	QCOMPARE(curvePrivate->connectedPointsLogical.at(1), false);
+
+	// masked values are skipped
+	sheet->column(1)->setValueAt(2, 6.);
+	sheet->column(0)->setMasked(0);
+	curvePrivate->recalc();
+	QVERIFY(!points.isShared());
+	QCOMPARE(points.size(), qsizetype(4));
+	QCOMPARE(points.at(0), QPointF(2., 4.));
+}
+
+#define LOAD_LARGE_CURVE_PROJECT(rows)                                                                                                                         \
+	Project project;                                                                                                                                           \
+	auto* sheet = new Spreadsheet(QStringLiteral("data"), false);                                                                                              \
+	project.addChild(sheet);                                                                                                                                   \
+	sheet->setColumnCount(2);                                                                                                                                  \
+	sheet->setRowCount(rows);                                                                                                                                  \
+	{                                                                                                                                                          \
+		QVector<double> xData(rows), yData(rows);                                                                                                              \
+		double y = 0.;                                                                                                                                         \
+		for (int i = 0; i < rows; ++i) {                                                                                                                       \
+			xData[i] = i * 0.5;                                                                                                                                \
+			y += ((i * 7919) % 201) - 100.;                                                                                                                    \
+			yData[i] = (i % 50000 == 777) ? NAN : y; /* a few gaps */                                                                                          \
+		}                                                                                                                                                      \
+		sheet->column(0)->replaceValues(0, xData);                                                                                                             \
+		sheet->column(1)->replaceValues(0, yData);                                                                                                             \
+	}                                                                                                                                                          \
+                                                                                                                                                               \
+	auto* worksheet = new Worksheet(QStringLiteral("worksheet"));                                                                                              \
+	project.addChild(worksheet);                                                                                                                               \
+	auto* plot = new CartesianPlot(QStringLiteral("plot"));                                                                                                    \
+	plot->setType(CartesianPlot::Type::TwoAxes);                                                                                                               \
+	worksheet->addChild(plot);                                                                                                                                 \
+	auto* curve = new XYCurve(QStringLiteral("curve"));                                                                                                        \
+	plot->addChild(curve);                                                                                                                                     \
+	curve->setXColumn(sheet->column(0));                                                                                                                       \
+	curve->setYColumn(sheet->column(1));                                                                                                                       \
+	auto* curvePrivate = curve->d_func();                                                                                                                      \
+	QCOMPARE(sheet->column(0)->properties(), AbstractColumn::Properties::MonotonicIncreasing);
+
+/*!
+ * the lines calculated with the min/max decimation of large curves need to be the same as the lines calculated with all points
+ */
+void XYCurveTest::updateLinesLevelOfDetail() {
+	LOAD_LARGE_CURVE_PROJECT(300000)
+
+	const auto compare = [curvePrivate]() {
+		curvePrivate->m_levelOfDetailEnabled = true;
+		curvePrivate->updateLines();
+		QVERIFY(!curvePrivate->m_levelOfDetail.empty());
+		const auto lines = curvePrivate->m_lines;
+		QVERIFY(!lines.isEmpty());
+
+		curvePrivate->m_levelOfDetailEnabled = false;
+		curvePrivate->updateLines();
+		const auto refLines = curvePrivate->m_lines;
+		QCOMPARE(lines.size(), refLines.size());
+		for (int i = 0; i < lines.size(); i++)
+			QCOMPARE(lines.at(i), refLines.at(i));
+	};
+
+	// gaps are connected
+	curve->setLineSkipGaps(true);
+	compare();
+
+	// gaps are not connected
+	curve->setLineSkipGaps(false);
+	compare();
+
+	// zoomed in
+	const auto& xRange = plot->range(Dimension::X, 0);
+	plot->setRange(Dimension::X, 0, Range<double>(xRange.start() + xRange.size() / 3, xRange.start() + xRange.size() / 2));
+	compare();
+}
+
+void XYCurveTest::benchmarkUpdateLinesLevelOfDetail() {
+	LOAD_LARGE_CURVE_PROJECT(10000000)
+	curve->setLineSkipGaps(true);
+	curvePrivate->updateLines(); // builds the decimation
+
+	QBENCHMARK {
+		curvePrivate->updateLines();
+	}
+}
+
+/*!
+ * every pixel is occupied by one scene point at most, mapping the points again gives the same result
+ */
+void XYCurveTest::mapLogicalToSceneUniquePixels() {
+	LOAD_LARGE_CURVE_PROJECT(200000)
+
+	const auto* cSystem = plot->coordinateSystem(curve->coordinateSystemIndex());
+	const auto& logicalPoints = curvePrivate->m_logicalPoints;
+	const int count = static_cast<int>(logicalPoints.size());
+	const auto dataRect = plot->dataRect();
+
+	QVector<QPointF> scenePoints;
+	std::vector<bool> visiblePoints(count, false);
+	cSystem->mapLogicalToScene(0, count - 1, logicalPoints, scenePoints, visiblePoints);
+	QVERIFY(!scenePoints.isEmpty());
+	QVERIFY(scenePoints.size() < count);
+
+	QSet<QPair<int, int>> pixels;
+	for (const auto& point : scenePoints) {
+		const auto pixel = qMakePair(qRound(point.x() - dataRect.x()), qRound(point.y() - dataRect.y()));
+		QVERIFY(!pixels.contains(pixel));
+		pixels.insert(pixel);
+	}
+
+	// the occupancy grid is reused
+	QVector<QPointF> scenePoints2;
+	std::vector<bool> visiblePoints2(count, false);
+	cSystem->mapLogicalToScene(0, count - 1, logicalPoints, scenePoints2, visiblePoints2);
+	QCOMPARE(scenePoints2, scenePoints);
+	QVERIFY(visiblePoints2 == visiblePoints);
+}
+
+void XYCurveTest::benchmarkMapLogicalToScene() {
+	LOAD_LARGE_CURVE_PROJECT(10000000)
+
+	const auto* cSystem = plot->coordinateSystem(curve->coordinateSystemIndex());
+	const auto& logicalPoints = curvePrivate->m_logicalPoints;
+	const int count = static_cast<int>(logicalPoints.size());
+	QVector<QPointF> scenePoints;
+	std::vector<bool> visiblePoints(count, false);
+
+	QBENCHMARK {
+		scenePoints.clear();
+		cSystem->mapLogicalToScene(0, count - 1, logicalPoints, scenePoints, visiblePoints);
+	}
+}
+
 // ############################################################################
 //  Hover tests
 // ############################################################################
@@ -19,6 +19,7 @@ class XYCurveTest : public CommonTest {
 private Q_SLOTS:
 
 	void setColumn();
+	void recalcSharedColumnData();
 
 	void addUniqueLineTest01();
 
@@ -62,6 +63,14 @@ private Q_SLOTS:
 	// Nonlinear
 	void updateLinesLog10();
 
+	// Level of detail
+	void updateLinesLevelOfDetail();
+	void benchmarkUpdateLinesLevelOfDetail();
+
+	// Mapping of the points
+	void mapLogicalToSceneUniquePixels();
+	void benchmarkMapLogicalToScene();
+
 	// Hover XYCurve
 	void hooverCurveIntegerEndingZeros();
 };
@@ -1,5 +1,6 @@
 #include "ExpressionParserTest.h"
 #include "backend/gsl/ExpressionParser.h"
+#include "backend/gsl/Parser.h"
 #include "backend/gsl/functions.h"
 
 using namespace Parsing;
@@ -645,6 +646,344 @@ void ExpressionParserTest::testBenchmark() {
 	}
 }
 
+// compare parsing the expression for every row with evaluating the compiled expression
+void ExpressionParserTest::testBenchmarkPerRowParse() {
+	const QString expr = QStringLiteral("atan2(x;y) + sqrt(x)");
+	const int values = 10000;
+
+	QVector<double> yVector(values);
+	QBENCHMARK {
+		Parser parser;
+		for (int i = 0; i < values; i++) {
+			parser.assign_symbol("x", i % 2 == 0 ? 5. : 24.);
+			parser.assign_symbol("y", i % 2 == 0 ? 2. : 22.);
+			yVector[i] = parser.parse(qPrintable(expr), "en_US");
+		}
+	}
+
+	for (int i = 0; i < values; i++)
+		VALUES_EQUAL(yVector.at(i), i % 2 == 0 ? 3.42635792718232 : 5.72782854435533);
+}
+
+void ExpressionParserTest::testBenchmarkCompiled() {
+	const QString expr = QStringLiteral("atan2(x;y) + sqrt(x)");
+	const int values = 10000;
+
+	QVector<double> yVector(values);
+	QBENCHMARK {
+		Parser parser;
+		parser.assign_symbol("x", 0.);
+		parser.assign_symbol("y", 0.);
+		const auto program = ExpressionParser::compile(parser, expr);
+		auto variables = program.variableValues();
+		const int xIndex = program.variableIndex("x");
+		const int yIndex = program.variableIndex("y");
+		for (int i = 0; i < values; i++) {
+			variables[xIndex] = i % 2 == 0 ? 5. : 24.;
+			variables[yIndex] = i % 2 == 0 ? 2. : 22.;
+			yVector[i] = program.evaluate(variables.data());
+		}
+	}
+
+	for (int i = 0; i < values; i++)
+		VALUES_EQUAL(yVector.at(i), i % 2 == 0 ? 3.42635792718232 : 5.72782854435533);
+}
+
+void ExpressionParserTest::testBenchmarkCompiledBatch() {
+	const QString expr = QStringLiteral("atan2(x;y) + sqrt(x)");
+	const int values = 10000;
+
+	QVector<double> xVector(values), yVector(values), result(values);
+	for (int i = 0; i < values; i++) {
+		xVector[i] = i % 2 == 0 ? 5. : 24.;
+		yVector[i] = i % 2 == 0 ? 2. : 22.;
+	}
+
+	QBENCHMARK {
+		Parser parser;
+		parser.assign_symbol("x", 0.);
+		parser.assign_symbol("y", 0.);
+		const auto program = ExpressionParser::compile(parser, expr);
+		auto variables = program.variableValues();
+		std::vector<const double*> arrays(variables.size(), nullptr);
+		arrays[program.variableIndex("x")] = xVector.constData();
+		arrays[program.variableIndex("y")] = yVector.constData();
+		program.evaluate(arrays, variables.data(), result.data(), values);
+	}
+
+	for (int i = 0; i < values; i++)
+		VALUES_EQUAL(result.at(i), i % 2 == 0 ? 3.42635792718232 : 5.72782854435533);
+}
+
+void ExpressionParserTest::testBenchmarkMovingStatistics() {
+	const int rows = 1000000;
+	QVector<double> data(rows);
+	for (int i = 0; i < rows; ++i)
+		data[i] = std::sin(i);
+
+	const QStringList vars = {QStringLiteral("x")};
+	const QVector<QVector<double>*> xVectors = {&data};
+	QVector<double> result(rows);
+
+	QBENCHMARK {
+		ExpressionParser::getInstance()->tryEvaluateCartesian(QStringLiteral("sma(10000; x) + smr(10000; x)"), vars, xVectors, &result);
+	}
+
+	// last window
+	double min = INFINITY, max = -INFINITY, sum = 0.;
+	for (int i = rows - 10000; i < rows; ++i) {
+		min = std::min(min, data.at(i));
+		max = std::max(max, data.at(i));
+		sum += data.at(i);
+	}
+	VALUES_EQUAL(result.at(rows - 1), sum / 10000. + max - min);
+}
+
+void ExpressionParserTest::testBenchmarkGradient() {
+	const QString expr = QStringLiteral("a*exp(-b*x) + c");
+	const int values = 100000;
+
+	Parser parser;
+	parser.assign_symbol("a", 2.);
+	parser.assign_symbol("b", 0.5);
+	parser.assign_symbol("c", 1.);
+	parser.assign_symbol("x", 0.);
+	const auto program = ExpressionParser::compile(parser, expr);
+	QVERIFY(program.isValid());
+	const std::vector<int> slots = {program.variableIndex("a"), program.variableIndex("b"), program.variableIndex("c")};
+	const int xIndex = program.variableIndex("x");
+
+	auto variables = program.variableValues();
+	double gradient[3];
+	double sum = 0.;
+	QBENCHMARK {
+		sum = 0.;
+		for (int i = 0; i < values; i++) {
+			variables[xIndex] = 1.e-4 * i;
+			program.evaluateGradient(variables.data(), slots, gradient);
+			sum += gradient[1];
+		}
+	}
+
+	// sum of d/db = -a*x*exp(-b*x)
+	double ref = 0.;
+	for (int i = 0; i < values; i++)
+		ref -= 2. * 1.e-4 * i * std::exp(-0.5e-4 * i);
+	VALUES_EQUAL(sum, ref);
+}
+
+// the compiled expression must give the same results as parsing it
+void ExpressionParserTest::testCompile() {
+	const QStringList expressions = {QStringLiteral("sin(x) + cos(x)*2"),
+									 QStringLiteral("x^2 - 3*x + 1"),
+									 QStringLiteral("-x + |x - 5|"),
+									 QStringLiteral("4!"),
+									 QStringLiteral("x > 2 && x < 5"),
+									 QStringLiteral("!(x > 3) || x <= 1"),
+									 QStringLiteral("atan2(x; y) + sqrt(x)"),
+									 QStringLiteral("pi*x"),
+									 QStringLiteral("2**3 + x%3"),
+									 QStringLiteral("if(x > 2; 1; 2)"),
+									 QStringLiteral("((((x))))+(((x + 1)*(x + 2))*(x + 3))")};
+
+	for (const auto& expr : expressions) {
+		Parser compileParser;
+		compileParser.assign_symbol("x", 0.);
+		compileParser.assign_symbol("y", 0.);
+		const auto program = ExpressionParser::compile(compileParser, expr);
+		QVERIFY(program.isValid());
+		auto variables = program.variableValues();
+		const int xIndex = program.variableIndex("x");
+		const int yIndex = program.variableIndex("y");
+
+		for (double x : {0.5, 2., 3.5, 7.}) {
+			Parser parser;
+			parser.assign_symbol("x", x);
+			parser.assign_symbol("y", 2 * x);
+			const double ref = parser.parse(qPrintable(expr), "en_US");
+			QCOMPARE(parser.parseErrors(), 0);
+
+			if (xIndex >= 0)
+				variables[xIndex] = x;
+			if (yIndex >= 0)
+				variables[yIndex] = 2 * x;
+			QCOMPARE(program.evaluate(variables.data()), ref);
+		}
+	}
+
+	// constant expression
+	Parser parser;
+	const auto program = ExpressionParser::compile(parser, QStringLiteral("sqrt(4) + 1"));
+	QVERIFY(program.isValid());
+	QVERIFY(program.isConstant());
+	QCOMPARE(program.evaluate(nullptr), 3.);
+}
+
+void ExpressionParserTest::testCompileInvalid() {
+	Parser parser;
+	parser.assign_symbol("x", 0.);
+
+	auto program = ExpressionParser::compile(parser, QStringLiteral("1 +* x"));
+	QVERIFY(!program.isValid());
+	QVERIFY(std::isnan(program.evaluate(nullptr)));
+
+	program = ExpressionParser::compile(parser, QStringLiteral("unknownVariable + x"));
+	QVERIFY(!program.isValid());
+}
+
+// the incrementally updated moving statistics must give the same results as scanning the whole window for every row
+void ExpressionParserTest::testMovingStatistics() {
+	const int rows = 3000;
+	QVector<double> data(rows);
+	for (int i = 0; i < rows; ++i)
+		data[i] = std::round(10. * std::sin(0.37 * i)) / 4.; // many equal values
+	data[100] = NAN;
+	data[1000] = INFINITY;
+	data[1003] = -INFINITY;
+	for (int i = 2000; i < 2010; ++i)
+		data[i] = NAN;
+
+	const QStringList vars = {QStringLiteral("x")};
+	const QVector<QVector<double>*> xVectors = {&data};
+	auto* parser = ExpressionParser::getInstance();
+
+	for (int N : {1, 2, 3, 8, 100}) {
+		QVector<double> min(rows), max(rows), average(rows), range(rows), median(rows);
+		QVERIFY(parser->tryEvaluateCartesian(QStringLiteral("smmin(%1; x)").arg(N), vars, xVectors, &min));
+		QVERIFY(parser->tryEvaluateCartesian(QStringLiteral("smmax(%1; x)").arg(N), vars, xVectors, &max));
+		QVERIFY(parser->tryEvaluateCartesian(QStringLiteral("sma(%1; x)").arg(N), vars, xVectors, &average));
+		QVERIFY(parser->tryEvaluateCartesian(QStringLiteral("smr(%1; x)").arg(N), vars, xVectors, &range));
+		QVERIFY(parser->tryEvaluateCartesian(QStringLiteral("smmed(%1; x)").arg(N), vars, xVectors, &median));
+
+		for (int row = 0; row < rows; ++row) {
+			double refMin = INFINITY, refMax = -INFINITY, sum = 0.;
+			std::vector<double> values;
+			for (int index = std::max(0, row - N + 1); index <= row; index++) {
+				const double v = data.at(index);
+				if (v < refMin)
+					refMin = v;
+				if (v > refMax)
+					refMax = v;
+				sum += v;
+				if (!std::isnan(v))
+					values.push_back(v);
+			}
+			double refMedian = NAN;
+			if (!values.empty()) {
+				std::sort(values.begin(), values.end());
+				const size_t n = values.size();
+				refMedian = n % 2 ? values.at(n / 2) : (values.at(n / 2 - 1) + values.at(n / 2)) / 2.;
+			}
+
+			QCOMPARE(min.at(row), refMin);
+			QCOMPARE(max.at(row), refMax);
+			VALUES_EQUAL(average.at(row), sum / N);
+			VALUES_EQUAL(range.at(row), refMax - refMin);
+			VALUES_EQUAL(median.at(row), refMedian);
+		}
+	}
+}
+
+// evaluating a compiled expression on whole arrays must give the same results as evaluating it row by row
+void ExpressionParserTest::testCompileBatch() {
+	const QStringList expressions = {QStringLiteral("sin(x) + cos(x)*2"),
+									 QStringLiteral("x^2 - 3*x + 1"),
+									 QStringLiteral("-x + |x - 5|"),
+									 QStringLiteral("x > 2 && x < 5"),
+									 QStringLiteral("!(x > 3) || x <= 1"),
+									 QStringLiteral("atan2(x; y) + sqrt(y) + fabs(x) + ceil(x)"),
+									 QStringLiteral("2**3 + x%3 + 3!"),
+									 QStringLiteral("if(x > 2; 1; y)"),
+									 QStringLiteral("z = x + y")};
+
+	// more values than one block
+	const int count = 2 * Program::BlockSize + 17;
+	QVector<double> xVector(count), yVector(count);
+	for (int i = 0; i < count; i++) {
+		xVector[i] = -5. + 0.01 * i;
+		yVector[i] = 0.5 * i;
+	}
+
+	for (const auto& expr : expressions) {
+		Parser parser;
+		parser.assign_symbol("x", 0.);
+		parser.assign_symbol("y", 0.);
+		parser.assign_symbol("z", 0.);
+		const auto program = ExpressionParser::compile(parser, expr);
+		QVERIFY(program.isValid());
+		QCOMPARE(program.isVectorizable(), !expr.startsWith(QLatin1Char('z')));
+
+		auto variables = program.variableValues();
+		const int xIndex = program.variableIndex("x");
+		const int yIndex = program.variableIndex("y");
+		std::vector<const double*> arrays(variables.size(), nullptr);
+		if (xIndex >= 0)
+			arrays[xIndex] = xVector.constData();
+		if (yIndex >= 0)
+			arrays[yIndex] = yVector.constData();
+
+		QVector<double> result(count);
+		program.evaluate(arrays, variables.data(), result.data(), count);
+
+		for (int i = 0; i < count; i++) {
+			if (xIndex >= 0)
+				variables[xIndex] = xVector.at(i);
+			if (yIndex >= 0)
+				variables[yIndex] = yVector.at(i);
+			QCOMPARE(result.at(i), program.evaluate(variables.data()));
+		}
+	}
+}
+
+// the derivatives calculated by automatic differentiation must agree with central differences
+void ExpressionParserTest::testCompileGradient() {
+	const QStringList expressions = {QStringLiteral("a*exp(-b*x) + c"),
+									 QStringLiteral("a*sin(b*x + c)"),
+									 QStringLiteral("a/(1 + (x - b)^2/c^2)"),
+									 QStringLiteral("a*x^b + c^x"),
+									 QStringLiteral("log(a*x) + sqrt(b) + cbrt(c*x)"),
+									 QStringLiteral("atan2(a; b*x) + hypot(a; c) + pow(a; b) + pow3(c*x)"),
+									 QStringLiteral("a*erf(b*x) + erfc(c) + tanh(a*x)*cosh(b)"),
+									 QStringLiteral("a*gamma(b) + c*x"), // numerical derivative
+									 QStringLiteral("if(x > 1; a*x; b*x^2) + c"),
+									 QStringLiteral("|a - x|*b + ceil(c)"),
+									 QStringLiteral("z = a*x*x + b*c")}; // not vectorizable: differentiated numerically
+
+	for (const auto& expr : expressions) {
+		Parser parser;
+		parser.assign_symbol("a", 1.3);
+		parser.assign_symbol("b", 0.7);
+		parser.assign_symbol("c", 2.2);
+		parser.assign_symbol("x", 0.);
+		parser.assign_symbol("z", 0.);
+		const auto program = ExpressionParser::compile(parser, expr);
+		QVERIFY(program.isValid());
+
+		const std::vector<int> slots = {program.variableIndex("a"), program.variableIndex("b"), program.variableIndex("c")};
+		const int xIndex = program.variableIndex("x");
+		for (double x : {0.3, 1.7, 2.5}) {
+			auto variables = program.variableValues();
+			variables[xIndex] = x;
+
+			auto gradientVariables = variables;
+			double gradient[3];
+			const double value = program.evaluateGradient(gradientVariables.data(), slots, gradient);
+			auto valueVariables = variables;
+			VALUES_EQUAL(value, program.evaluate(valueVariables.data()));
+
+			for (int k = 0; k < 3; k++) {
+				const double h = 1.e-6;
+				auto plus = variables;
+				plus[slots.at(k)] += h;
+				auto minus = variables;
+				minus[slots.at(k)] -= h;
+				const double ref = (program.evaluate(plus.data()) - program.evaluate(minus.data())) / (2. * h);
+				QVERIFY(std::abs(gradient[k] - ref) < 1.e-6 * std::max(1., std::abs(ref)));
+			}
+		}
+	}
+}
+
 // This is not implemented. It uses always the smallest rowCount
 // Does not matter if the variable is used in the expression or not
 // void ExpressionParserTest::testevaluateCartesianConstExpr2() {
@@ -35,6 +35,18 @@ private Q_SLOTS:
 	void testevaluateLessEqualThan();
 	void testevaluateGreaterEqualThan();
 	void testBenchmark();
+	void testBenchmarkPerRowParse();
+	void testBenchmarkCompiled();
+	void testBenchmarkCompiledBatch();
+	void testBenchmarkMovingStatistics();
+	void testBenchmarkGradient();
+
+	void testCompile();
+	void testCompileInvalid();
+	void testCompileBatch();
+	void testCompileGradient();
+
+	void testMovingStatistics();
 
 	void testEvaluateAnd();
 	void testEvaluateOr();
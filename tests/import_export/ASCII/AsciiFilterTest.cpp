@@ -22,6 +22,7 @@
 #include "backend/worksheet/plots/cartesian/XYCurve.h"
 
 #include <KCompressionDevice>
+#include <QFileInfo>
 #include <QXmlStreamWriter>
 
 #include <gsl/gsl_randist.h>
@@ -114,6 +115,18 @@ void AsciiFilterTest::lineCount() {
 	QCOMPARE(AsciiFilter::lineCount(fileName3), 5);
 	QCOMPARE(AsciiFilter::lineCount(fileName3, 3), 3);
 	QCOMPARE(AsciiFilter::lineCount(fileName3, 10), 5);
+
+	// lines with CRLF line ends spanning several blocks read from the file
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	QByteArray data;
+	for (int i = 0; i < 300000; ++i)
+		data += QByteArray::number(i) + ",value " + QByteArray::number(i * 2) + "\r\n";
+	data += "last line without line end";
+	file.write(data);
+	file.close();
+	QCOMPARE(AsciiFilter::lineCount(file.fileName()), 300001);
+	QCOMPARE(AsciiFilter::lineCount(file.fileName(), 100000), 100000);
 }
 
 // column modes
@@ -2849,6 +2862,87 @@ void AsciiFilterTest::testCommaAsDecimalSeparator() {
 	VALUES_EQUAL(spreadsheet.column(5)->valueAt(4), 2.211);
 }
 
+/*!
+ * import a file that is large enough to be imported in parallel and compare it with the sequential import of the same file
+ */
+void AsciiFilterTest::testParallelImport() {
+	QStringList content;
+	content << QStringLiteral("# comment before the header") << QStringLiteral("x,n,big,text,time");
+	int rows = 0;
+	for (int i = 0; i < 40000; ++i) {
+		if (i % 1000 == 0)
+			content << QStringLiteral("# comment");
+		if (i % 777 == 0)
+			content << QString(); // empty line
+		if (i % 555 == 554)
+			content << QStringLiteral("1,2"); // not enough columns
+
+		const auto x = (i % 999 == 998) ? QStringLiteral("abc") : QString::number(i * 0.25);
+		auto line = QStringLiteral("%1,%2,%3,\"text, %4\",2024-01-%5 10:%6:00")
+						.arg(x)
+						.arg(i)
+						.arg(qint64(i) * 10000000000)
+						.arg(i)
+						.arg(i % 28 + 1, 2, 10, QLatin1Char('0'))
+						.arg(i % 60, 2, 10, QLatin1Char('0'));
+		if (i % 3 == 0)
+			line += QLatin1Char('\r');
+		content << line;
+		++rows;
+	}
+
+	QString savePath;
+	SAVE_FILE("testfile", content);
+	QVERIFY(QFileInfo(savePath).size() > 1024 * 1024);
+
+	auto properties = AsciiFilter().properties();
+	properties.automaticSeparatorDetection = false;
+	properties.separator = QStringLiteral(",");
+	properties.headerEnabled = true;
+	properties.headerLine = 1;
+	properties.removeQuotes = true;
+	properties.intAsDouble = false;
+	properties.dateTimeFormat = QStringLiteral("yyyy-MM-dd hh:mm:ss");
+
+	// parallel import of the mapped file
+	Spreadsheet spreadsheet(QStringLiteral("parallel"), false);
+	AsciiFilter filter;
+	filter.setProperties(properties);
+	filter.readDataFromFile(savePath, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	QVERIFY(filter.lastError().isEmpty());
+
+	// sequential import of the same file, the compression device is not mapped
+	Spreadsheet spreadsheetSequential(QStringLiteral("sequential"), false);
+	AsciiFilter filterSequential;
+	filterSequential.setProperties(properties);
+	filterSequential.setDataSource(&spreadsheetSequential);
+	KCompressionDevice device(savePath);
+	filterSequential.readFromDevice(device, AbstractFileFilter::ImportMode::Replace, AbstractFileFilter::ImportMode::Replace, 0, -1);
+
+	QCOMPARE(spreadsheet.columnCount(), 5);
+	QCOMPARE(spreadsheet.rowCount(), rows);
+	QCOMPARE(spreadsheetSequential.rowCount(), rows);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(3)->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(spreadsheet.column(4)->columnMode(), AbstractColumn::ColumnMode::DateTime);
+
+	for (int i = 0; i < rows; ++i) {
+		const double x = spreadsheet.column(0)->valueAt(i);
+		if (i % 999 == 998)
+			QVERIFY(std::isnan(x));
+		else
+			QCOMPARE(x, i * 0.25);
+		QCOMPARE(spreadsheet.column(1)->integerAt(i), i);
+		QCOMPARE(spreadsheet.column(2)->bigIntAt(i), qint64(i) * 10000000000);
+		QCOMPARE(spreadsheet.column(3)->textAt(i), spreadsheetSequential.column(3)->textAt(i));
+		QCOMPARE(spreadsheet.column(4)->dateTimeAt(i), spreadsheetSequential.column(4)->dateTimeAt(i));
+	}
+	QCOMPARE(spreadsheet.column(3)->textAt(1), QStringLiteral("text, 1"));
+	QCOMPARE(spreadsheet.column(4)->dateTimeAt(1), QDateTime(QDate(2024, 1, 2), QTime(10, 1), Qt::UTC));
+}
+
 void AsciiFilterTest::testMatrixHeader() {
 	Matrix matrix(QStringLiteral("test"), false);
 
@@ -3431,6 +3525,87 @@ void AsciiFilterTest::benchDoubleImport_cleanup() {
 	QFile::remove(benchDataFileName);
 }
 
+void AsciiFilterTest::benchLineCount() {
+	QTemporaryFile file;
+	QVERIFY(file.open());
+	QByteArray line;
+	for (int column = 0; column < 5; ++column)
+		line += "1.234567,";
+	line += "1.234567\n";
+	for (int i = 0; i < 1000000; ++i)
+		file.write(line);
+	file.close();
+
+	size_t lines = 0;
+	QBENCHMARK {
+		lines = AsciiFilter::lineCount(file.fileName());
+	}
+	QCOMPARE(lines, 1000000);
+}
+
+void AsciiFilterTest::benchDoubleConversion_data() {
+	QTest::addColumn<bool>("parser");
+	QTest::newRow("QLocale") << false;
+	QTest::newRow("NumberParser") << true;
+}
+
+void AsciiFilterTest::benchDoubleConversion() {
+	QFETCH(bool, parser);
+
+	QVector<QByteArray> values;
+	for (int i = 0; i < 100000; ++i)
+		values << QByteArray::number(i * 0.001 - 50., 'g', 12);
+
+	const QLocale locale = QLocale::c();
+	const NumberParser numberParser(locale);
+	double sum = 0.;
+	bool ok;
+	QBENCHMARK {
+		sum = 0.;
+		if (parser) {
+			for (const auto& value : values)
+				sum += numberParser.toDouble(QByteArrayView(value), &ok);
+		} else {
+			for (const auto& value : values)
+				sum += locale.toDouble(QString::fromUtf8(value), &ok);
+		}
+	}
+	QVERIFY(std::abs(sum - (100000. * 99999. / 2. * 0.001 - 50. * 100000.)) < 1e-2);
+}
+
+void AsciiFilterTest::benchDateTimeConversion_data() {
+	QTest::addColumn<bool>("parser");
+	QTest::newRow("QDateTime") << false;
+	QTest::newRow("DateTimeParser") << true;
+}
+
+void AsciiFilterTest::benchDateTimeConversion() {
+	QFETCH(bool, parser);
+
+	const auto format = QStringLiteral("yyyy-MM-dd hh:mm:ss.zzz");
+	const QDateTime start(QDate(2024, 1, 1), QTime(0, 0), Qt::UTC);
+	QVector<QByteArray> values;
+	for (int i = 0; i < 10000; ++i)
+		values << start.addMSecs(i * 1234567LL).toString(format).toUtf8();
+
+	const DateTimeParser dateTimeParser(format);
+	qint64 sum = 0;
+	QBENCHMARK {
+		sum = 0;
+		for (const auto& value : values) {
+			qint64 msecs;
+			if (parser && dateTimeParser.toMSecsSinceEpoch(QByteArrayView(value), msecs))
+				sum += msecs - start.toMSecsSinceEpoch();
+			else {
+				auto dt = QDateTime::fromString(QString::fromUtf8(value), format);
+				dt.setTimeSpec(Qt::UTC);
+				sum += dt.toMSecsSinceEpoch() - start.toMSecsSinceEpoch();
+			}
+		}
+	}
+	QCOMPARE(sum, 1234567LL * 10000 * 9999 / 2);
+}
+
 void AsciiFilterTest::benchMarkCompare_SimplifyWhiteSpace() {
 	const int numberColumns = 5;
 	const int numberRows = 10;
@@ -3505,6 +3680,79 @@ void AsciiFilterTest::benchMarkCompare_SimplifyWhiteSpace() {
 	}
 }
 
+/*!
+ * the numbers converted by the parser are the same as the ones converted by the locale
+ */
+void AsciiFilterTest::numberParser() {
+	QStringList values;
+	values << QStringLiteral("1") << QStringLiteral("-12") << QStringLiteral("0.25") << QStringLiteral("-1.5e-3") << QStringLiteral("1E+10");
+	values << QStringLiteral("1,5") << QStringLiteral("1.234,5") << QStringLiteral("1,234.5") << QStringLiteral(" 7") << QStringLiteral("+7");
+	values << QStringLiteral(".5") << QStringLiteral("5.") << QStringLiteral("1e") << QStringLiteral("abc") << QString() << QStringLiteral("nan");
+	values << QStringLiteral("1e400") << QStringLiteral("0x10") << QStringLiteral("2147483648") << QStringLiteral("-9223372036854775808");
+
+	for (const auto& locale : {QLocale::c(), QLocale(QLocale::German), QLocale(QLocale::English)}) {
+		const NumberParser parser(locale);
+		for (const auto& value : values) {
+			const auto utf8 = value.toUtf8();
+			bool ok, okParser, okParserUtf8;
+
+			const double d = locale.toDouble(value, &ok);
+			const double dParser = parser.toDouble(QStringView(value), &okParser);
+			const double dParserUtf8 = parser.toDouble(QByteArrayView(utf8), &okParserUtf8);
+			QCOMPARE(okParser, ok);
+			QCOMPARE(okParserUtf8, ok);
+			if (ok) {
+				QCOMPARE(dParser, d);
+				QCOMPARE(dParserUtf8, d);
+			}
+
+			const int i = locale.toInt(value, &ok);
+			QCOMPARE(parser.toInt(QByteArrayView(utf8), &okParser), i);
+			QCOMPARE(okParser, ok);
+
+			const qint64 l = locale.toLongLong(value, &ok);
+			QCOMPARE(parser.toLongLong(QStringView(value), &okParser), l);
+			QCOMPARE(okParser, ok);
+		}
+	}
+}
+
+/*!
+ * the date-times converted by the parser are the same as the ones converted by QDateTime
+ */
+void AsciiFilterTest::dateTimeParser() {
+	const QVector<QPair<QString, QStringList>> formats{
+		{QStringLiteral("yyyy-MM-dd hh:mm:ss.zzz"),
+		 {QStringLiteral("2024-02-29 10:01:02.345"), QStringLiteral("1969-12-31 23:59:59.999"), QStringLiteral("2023-02-29 10:01:02.345"),
+		  QStringLiteral("2024-13-01 00:00:00.000"), QStringLiteral("2024-01-01 24:00:00.000"), QStringLiteral("2024-01-01 00:00:00")}},
+		{QStringLiteral("yyyy-MM-ddThh:mm:ss"), {QStringLiteral("2000-01-01T00:00:00"), QStringLiteral("2100-12-31T23:59:59")}},
+		{QStringLiteral("d.M.yy hh:mm"), {QStringLiteral("5.11.49 07:30"), QStringLiteral("15.1.99 00:00"), QStringLiteral("1.1.00 12:00")}},
+		{QStringLiteral("yyyy/MM/dd 'at' hh"), {QStringLiteral("2020/06/15 at 08"), QStringLiteral("2020/06/15 on 08")}},
+	};
+
+	for (const auto& format : formats) {
+		const DateTimeParser parser(format.first, 1950);
+		QVERIFY(parser.isValid());
+		for (const auto& value : format.second) {
+			auto dt = QDateTime::fromString(value, format.first, 1950);
+			dt.setTimeSpec(Qt::UTC);
+
+			qint64 msecs;
+			if (parser.toMSecsSinceEpoch(QByteArrayView(value.toUtf8()), msecs)) {
+				QVERIFY(dt.isValid());
+				QCOMPARE(msecs, dt.toMSecsSinceEpoch());
+			} else
+				QVERIFY(!dt.isValid());
+		}
+	}
+
+	// formats with names, AM/PM or time zones are converted by QDateTime
+	QVERIFY(!DateTimeParser(QStringLiteral("dd MMM yyyy")).isValid());
+	QVERIFY(!DateTimeParser(QStringLiteral("yyyy-MM-dd hh:mm AP")).isValid());
+	QVERIFY(!DateTimeParser(QStringLiteral("yyyy-MM-dd hh:mm t")).isValid());
+	QVERIFY(!DateTimeParser(QStringLiteral("hh:mm:ss")).isValid());
+}
+
 void AsciiFilterTest::determineSeparator() {
 	QString separator;
 	bool removeQuotes = true;
@@ -121,6 +121,9 @@ private Q_SLOTS:
 
 	void testCommaAsDecimalSeparator();
 
+	// parallel import of large files
+	void testParallelImport();
+
 	// check updates in the dependent objects after the data was modified by the import
 	void spreadsheetFormulaUpdateAfterImport();
 	void spreadsheetFormulaUpdateAfterImportWithColumnRestore();
@@ -136,6 +139,14 @@ private Q_SLOTS:
 	void benchDoubleImport();
 	void benchDoubleImport_cleanup(); // delete data
 	void benchMarkCompare_SimplifyWhiteSpace();
+	void benchLineCount();
+	void benchDoubleConversion_data();
+	void benchDoubleConversion();
+	void benchDateTimeConversion_data();
+	void benchDateTimeConversion();
+
+	void numberParser();
+	void dateTimeParser();
 
 	void determineSeparator();
 	void determineColumns();
@@ -14,6 +14,8 @@
 
 #include <KLocalizedString>
 
+#include <QTemporaryFile>
+
 void JSONFilterTest::testArrayImport() {
 	Spreadsheet spreadsheet(QStringLiteral("test"), false);
 	JsonFilter filter;
@@ -269,4 +271,142 @@ void JSONFilterTest::testObjectImport04() {
 	QCOMPARE(spreadsheet.column(5)->integerAt(1), 127830);
 }
 
+/*!
+ * import JSON Lines data, the documents are the rows
+ */
+void JSONFilterTest::testJsonLinesImport() {
+	QTemporaryFile file(QStringLiteral("XXXXXX.jsonl"));
+	QVERIFY(file.open());
+	file.write("{\"y\": \"a\\\"b\", \"x\": 1.5}\n");
+	file.write("{\"x\": 2, \"y\": \"c\\nd\"}\n");
+	file.write("{\"x\": 3}\n");
+	file.flush();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	JsonFilter filter;
+	filter.setDataRowType(QJsonValue::Object);
+	filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	// the columns are ordered by the keys, missing values are empty
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("x"));
+	QCOMPARE(spreadsheet.column(1)->name(), QLatin1String("y"));
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Text);
+
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 1.5);
+	QCOMPARE(spreadsheet.column(0)->valueAt(1), 2.);
+	QCOMPARE(spreadsheet.column(0)->valueAt(2), 3.);
+
+	QCOMPARE(spreadsheet.column(1)->textAt(0), QStringLiteral("a\"b"));
+	QCOMPARE(spreadsheet.column(1)->textAt(1), QStringLiteral("c\nd"));
+	QCOMPARE(spreadsheet.column(1)->textAt(2), QString());
+}
+
+/*!
+ * JSON Lines data with a first document larger than the data read ahead for the detection
+ */
+void JSONFilterTest::testJsonLinesLargeDocument() {
+	QTemporaryFile file(QStringLiteral("XXXXXX.jsonl"));
+	QVERIFY(file.open());
+	const QByteArray text(2 * 1024 * 1024, 'a');
+	file.write("{\"x\": 1, \"y\": \"" + text + "\"}\n");
+	file.write("{\"x\": 2, \"y\": \"b\"}\n");
+	file.flush();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	JsonFilter filter;
+	filter.setDataRowType(QJsonValue::Object);
+	filter.readDataFromFile(file.fileName(), &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->valueAt(0), 1.);
+	QCOMPARE(spreadsheet.column(0)->valueAt(1), 2.);
+	QCOMPARE(spreadsheet.column(1)->textAt(0).size(), text.size());
+	QCOMPARE(spreadsheet.column(1)->textAt(1), QStringLiteral("b"));
+}
+
+/*!
+ * append the new documents of JSON Lines data to the spreadsheet like for live data sources
+ */
+void JSONFilterTest::testLiveImport() {
+	QTemporaryFile tempFile;
+	QVERIFY(tempFile.open());
+	tempFile.write("[1, 2]\n[3, 4]\n");
+	tempFile.flush();
+
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	JsonFilter filter;
+	filter.setCreateIndexEnabled(true);
+	QFile file(tempFile.fileName());
+	qint64 bytes = filter.readFromLiveDevice(file, &spreadsheet, 0, 3);
+
+	QCOMPARE(bytes, qint64(14));
+	QCOMPARE(spreadsheet.columnCount(), 3);
+	QCOMPARE(spreadsheet.rowCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(1)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(2)->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 3.);
+
+	// the incomplete document is read in the next call
+	tempFile.write("[5, 6]\n[7, ");
+	tempFile.flush();
+	bytes += filter.readFromLiveDevice(file, &spreadsheet, bytes, 3);
+
+	QCOMPARE(bytes, qint64(21));
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	QCOMPARE(spreadsheet.column(1)->valueAt(2), 5.);
+
+	// only the last three rows are kept
+	tempFile.write("8]\n");
+	tempFile.flush();
+	bytes += filter.readFromLiveDevice(file, &spreadsheet, bytes, 3);
+
+	QCOMPARE(bytes, qint64(28));
+	QCOMPARE(spreadsheet.rowCount(), 3);
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 2);
+	QCOMPARE(spreadsheet.column(0)->integerAt(2), 4);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 3.);
+	QCOMPARE(spreadsheet.column(2)->valueAt(0), 4.);
+	QCOMPARE(spreadsheet.column(1)->valueAt(2), 7.);
+	QCOMPARE(spreadsheet.column(2)->valueAt(2), 8.);
+}
+
+void JSONFilterTest::testLiveImportKeepRows() {
+	QTemporaryFile tempFile;
+	QVERIFY(tempFile.open());
+	tempFile.write("[1]\n[2]\n[3]\n[4]\n[5]\n");
+	tempFile.flush();
+
+	// the first read has more rows than kept
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	JsonFilter filter;
+	filter.setCreateIndexEnabled(true);
+	QFile file(tempFile.fileName());
+	qint64 bytes = filter.readFromLiveDevice(file, &spreadsheet, 0, 2);
+
+	QCOMPARE(bytes, qint64(20));
+	QCOMPARE(spreadsheet.columnCount(), 2);
+	QCOMPARE(spreadsheet.rowCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 4);
+	QCOMPARE(spreadsheet.column(0)->integerAt(1), 5);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 4.);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 5.);
+
+	// the next batch has more rows than kept too
+	tempFile.write("[6]\n[7]\n[8]\n");
+	tempFile.flush();
+	bytes += filter.readFromLiveDevice(file, &spreadsheet, bytes, 2);
+
+	QCOMPARE(bytes, qint64(32));
+	QCOMPARE(spreadsheet.rowCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->integerAt(0), 7);
+	QCOMPARE(spreadsheet.column(0)->integerAt(1), 8);
+	QCOMPARE(spreadsheet.column(1)->valueAt(0), 7.);
+	QCOMPARE(spreadsheet.column(1)->valueAt(1), 8.);
+}
+
 QTEST_MAIN(JSONFilterTest)
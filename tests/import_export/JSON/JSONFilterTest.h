@@ -22,6 +22,10 @@ private Q_SLOTS:
 	void testObjectImport02();
 	void testObjectImport03();
 	void testObjectImport04();
+	void testJsonLinesImport();
+	void testJsonLinesLargeDocument();
+	void testLiveImport();
+	void testLiveImportKeepRows();
 };
 
 #endif
@@ -15,6 +15,8 @@
 #include <KLocalizedString>
 #include <QTemporaryFile>
 
+#include <cmath>
+
 void MCAPFilterTest::testArrayImport() {
 	// This mcap file has one topic with name: integer_topic with 10 entries
 	// Its encoded in json schema, so each entry looks like this: {"value": n } with n from 0 to 9
@@ -97,6 +99,182 @@ void MCAPFilterTest::testArrayImport() {
 	}
 }
 
+void MCAPFilterTest::testTimeRangeImport() {
+	QVector<QString> compression_types = {QLatin1String("data/basic_NONE.mcap")};
+#ifdef HAVE_LZ4
+	compression_types.append(QLatin1String("data/basic_LZ4.mcap"));
+#endif
+#ifdef HAVE_ZSTD
+	compression_types.append(QLatin1String("data/basic_ZSTD.mcap"));
+#endif
+
+	for (const QString& file : compression_types) {
+		Spreadsheet spreadsheet(QStringLiteral("test"), false);
+		McapFilter filter;
+
+		const QString& fileName = QFINDTESTDATA(file);
+
+		// messages with the log times 1h, 2h and 3h
+		filter.setStartTime(1 * 3600000);
+		filter.setEndTime(3 * 3600000);
+		filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+		QCOMPARE(spreadsheet.columnCount(), 4);
+		QCOMPARE(spreadsheet.rowCount(), 3);
+		QCOMPARE(spreadsheet.column(3)->name(), QLatin1String("value"));
+
+		QCOMPARE(spreadsheet.column(0)->valueAt(0), 1 * 3600000);
+		QCOMPARE(spreadsheet.column(0)->valueAt(2), 3 * 3600000);
+		QCOMPARE(spreadsheet.column(2)->valueAt(0), 1);
+		QCOMPARE(spreadsheet.column(3)->valueAt(0), 1);
+		QCOMPARE(spreadsheet.column(3)->valueAt(1), 2);
+		QCOMPARE(spreadsheet.column(3)->valueAt(2), 3);
+	}
+}
+
+void MCAPFilterTest::testRos1Import() {
+	// 20 messages of the topic /ros1 in separate chunks with a message of the topic /json in between, schema test_msgs/Ros1:
+	// std_msgs/Header header (seq = n, stamp = 1000 + n s + 0.5 s, frame_id = "frame")
+	// float64[] values (2, 3 or 1 values n, n + 0.5, n + 1)
+	// int16[2] pair (-n, n)
+	// uint8[] blob (n % 4 bytes, not imported)
+	// duration elapsed (n s + 0.25 s)
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	McapFilter filter;
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/ros1_chunks.mcap"));
+	QCOMPARE(filter.getValidTopics(fileName), (QVector<QString>{QStringLiteral("/ros1"), QStringLiteral("/json")}));
+
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	QCOMPARE(filter.lastError(), QString());
+
+	// the columns are determined by the first message with two values
+	QCOMPARE(spreadsheet.columnCount(), 11);
+	QCOMPARE(spreadsheet.rowCount(), 20);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("elapsed"));
+	QCOMPARE(spreadsheet.column(10)->name(), QLatin1String("values.1"));
+	QCOMPARE(spreadsheet.column(QStringLiteral("header.frame_id"))->columnMode(), AbstractColumn::ColumnMode::Text);
+	QCOMPARE(spreadsheet.column(QStringLiteral("header.seq"))->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(QStringLiteral("header.stamp"))->columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(spreadsheet.column(QStringLiteral("pair.0"))->columnMode(), AbstractColumn::ColumnMode::Integer);
+	QCOMPARE(spreadsheet.column(QStringLiteral("values.0"))->columnMode(), AbstractColumn::ColumnMode::Double);
+	QCOMPARE(spreadsheet.column(QStringLiteral("elapsed"))->columnMode(), AbstractColumn::ColumnMode::Double);
+
+	// the rows are in the order of the messages
+	for (int row = 0; row < 20; ++row) {
+		QCOMPARE(spreadsheet.column(QStringLiteral("header.seq"))->bigIntAt(row), row);
+		QCOMPARE(spreadsheet.column(QStringLiteral("header.stamp"))->valueAt(row), (1000 + row) * 1000 + 500);
+		QCOMPARE(spreadsheet.column(QStringLiteral("header.frame_id"))->textAt(row), QLatin1String("frame"));
+		QCOMPARE(spreadsheet.column(QStringLiteral("values.0"))->valueAt(row), row);
+		QCOMPARE(spreadsheet.column(QStringLiteral("pair.0"))->integerAt(row), -row);
+		QCOMPARE(spreadsheet.column(QStringLiteral("pair.1"))->integerAt(row), row);
+		QCOMPARE(spreadsheet.column(QStringLiteral("elapsed"))->valueAt(row), row + 0.25);
+		QCOMPARE(spreadsheet.column(QStringLiteral("logTime"))->valueAt(row), row * 1000);
+		QCOMPARE(spreadsheet.column(QStringLiteral("sequence"))->integerAt(row), row);
+	}
+
+	// the values are assigned by their names if the number of the values changes
+	QCOMPARE(spreadsheet.column(QStringLiteral("values.1"))->valueAt(0), 0.5);
+	QCOMPARE(spreadsheet.column(QStringLiteral("values.1"))->valueAt(1), 1.5);
+	QVERIFY(std::isnan(spreadsheet.column(QStringLiteral("values.1"))->valueAt(2)));
+	QCOMPARE(spreadsheet.column(QStringLiteral("values.1"))->valueAt(3), 3.5);
+	QVERIFY(std::isnan(spreadsheet.column(QStringLiteral("values.1"))->valueAt(17)));
+	QCOMPARE(spreadsheet.column(QStringLiteral("values.1"))->valueAt(19), 19.5);
+}
+
+void MCAPFilterTest::testRos1TopicImport() {
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	McapFilter filter;
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/ros1_chunks.mcap"));
+
+	// only the chunks with messages of the topic are read
+	filter.setCurrentTopic(QStringLiteral("/json"));
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 4);
+	QCOMPARE(spreadsheet.rowCount(), 20);
+	QCOMPARE(spreadsheet.column(3)->name(), QLatin1String("value"));
+	for (int row = 0; row < 20; ++row)
+		QCOMPARE(spreadsheet.column(3)->valueAt(row), row);
+
+	// only the chunks with messages in the time range are read
+	filter.setCurrentTopic(QStringLiteral("/ros1"));
+	filter.setStartTime(5000);
+	filter.setEndTime(9000);
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+
+	QCOMPARE(spreadsheet.columnCount(), 11);
+	QCOMPARE(spreadsheet.rowCount(), 5);
+	QCOMPARE(spreadsheet.column(QStringLiteral("header.seq"))->bigIntAt(0), 5);
+	QCOMPARE(spreadsheet.column(QStringLiteral("header.seq"))->bigIntAt(4), 9);
+}
+
+void MCAPFilterTest::testCdrImport() {
+	// two messages of the topic /cdr, the first one little endian, the second one big endian, schema test_msgs/msg/Cdr:
+	// builtin_interfaces/Time stamp
+	// uint8 flag
+	// float64 x (aligned to 8 bytes)
+	// string name
+	// int32[] seq
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	McapFilter filter;
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/ros2_cdr.mcap"));
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	QCOMPARE(filter.lastError(), QString());
+
+	QCOMPARE(spreadsheet.columnCount(), 9);
+	QCOMPARE(spreadsheet.rowCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("flag"));
+	QCOMPARE(spreadsheet.column(8)->name(), QLatin1String("x"));
+
+	const auto* stamp = spreadsheet.column(QStringLiteral("stamp"));
+	QCOMPARE(stamp->columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(stamp->valueAt(0), 10002);
+	QCOMPARE(stamp->valueAt(1), 11000);
+	QCOMPARE(spreadsheet.column(QStringLiteral("flag"))->integerAt(0), 1);
+	QCOMPARE(spreadsheet.column(QStringLiteral("flag"))->integerAt(1), 0);
+	QCOMPARE(spreadsheet.column(QStringLiteral("x"))->valueAt(0), 3.25);
+	QCOMPARE(spreadsheet.column(QStringLiteral("x"))->valueAt(1), -1.5);
+	QCOMPARE(spreadsheet.column(QStringLiteral("name"))->textAt(0), QLatin1String("hi"));
+	QCOMPARE(spreadsheet.column(QStringLiteral("name"))->textAt(1), QLatin1String("ros"));
+	QCOMPARE(spreadsheet.column(QStringLiteral("seq.0"))->integerAt(0), -1);
+	QCOMPARE(spreadsheet.column(QStringLiteral("seq.1"))->integerAt(0), 5);
+	QCOMPARE(spreadsheet.column(QStringLiteral("seq.0"))->integerAt(1), 7);
+	QCOMPARE(spreadsheet.column(QStringLiteral("seq.1"))->integerAt(1), 8);
+}
+
+void MCAPFilterTest::testProtobufImport() {
+	// two messages of the topic /protobuf, schema pkg.Proto:
+	// double x = 1; repeated int32 v = 2 (packed in the first message); sint64 z = 3;
+	// google.protobuf.Timestamp t = 4; pkg.Inner inner = 5 (only in the first message); string s = 6 (only in the first message)
+	Spreadsheet spreadsheet(QStringLiteral("test"), false);
+	McapFilter filter;
+	const QString& fileName = QFINDTESTDATA(QLatin1String("data/protobuf.mcap"));
+	filter.readDataFromFile(fileName, &spreadsheet, AbstractFileFilter::ImportMode::Replace);
+	QCOMPARE(filter.lastError(), QString());
+
+	QCOMPARE(spreadsheet.columnCount(), 10);
+	QCOMPARE(spreadsheet.rowCount(), 2);
+	QCOMPARE(spreadsheet.column(0)->name(), QLatin1String("inner.a"));
+	QCOMPARE(spreadsheet.column(9)->name(), QLatin1String("z"));
+
+	QCOMPARE(spreadsheet.column(QStringLiteral("x"))->valueAt(0), 2.5);
+	QCOMPARE(spreadsheet.column(QStringLiteral("x"))->valueAt(1), -1.);
+	QCOMPARE(spreadsheet.column(QStringLiteral("v.0"))->integerAt(0), 1);
+	QCOMPARE(spreadsheet.column(QStringLiteral("v.1"))->integerAt(0), 300);
+	QCOMPARE(spreadsheet.column(QStringLiteral("v.0"))->integerAt(1), 7);
+	QCOMPARE(spreadsheet.column(QStringLiteral("v.1"))->integerAt(1), 8);
+	QCOMPARE(spreadsheet.column(QStringLiteral("z"))->columnMode(), AbstractColumn::ColumnMode::BigInt);
+	QCOMPARE(spreadsheet.column(QStringLiteral("z"))->bigIntAt(0), -2);
+	QCOMPARE(spreadsheet.column(QStringLiteral("z"))->bigIntAt(1), 3);
+	QCOMPARE(spreadsheet.column(QStringLiteral("t"))->columnMode(), AbstractColumn::ColumnMode::DateTime);
+	QCOMPARE(spreadsheet.column(QStringLiteral("t"))->valueAt(0), 1000005);
+	QCOMPARE(spreadsheet.column(QStringLiteral("t"))->valueAt(1), 2000000);
+	QCOMPARE(spreadsheet.column(QStringLiteral("inner.a"))->integerAt(0), 42);
+	QCOMPARE(spreadsheet.column(QStringLiteral("inner.a"))->integerAt(1), 0);
+	QCOMPARE(spreadsheet.column(QStringLiteral("s"))->textAt(0), QLatin1String("str"));
+	QCOMPARE(spreadsheet.column(QStringLiteral("s"))->textAt(1), QString());
+}
+
 void MCAPFilterTest::testExport() {
 	QElapsedTimer timer_import;
 	timer_import.start();
@@ -138,7 +316,7 @@ void MCAPFilterTest::testImportWithoutValidTopics() {
 	AbstractFileFilter::ImportMode mode = AbstractFileFilter::ImportMode::Replace;
 	filter.readDataFromFile(fileName, &spreadsheet, mode);
 
-	QCOMPARE(filter.lastError(), i18n("No JSON encoded topics found."));
+	QCOMPARE(filter.lastError(), i18n("No topics with a supported message encoding found."));
 }
 
 void MCAPFilterTest::testImportWrongFile() {
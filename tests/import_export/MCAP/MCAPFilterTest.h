@@ -18,6 +18,11 @@ class MCAPFilterTest : public CommonMetaTest {
 
 private Q_SLOTS:
 	void testArrayImport();
+	void testTimeRangeImport();
+	void testRos1Import();
+	void testRos1TopicImport();
+	void testCdrImport();
+	void testProtobufImport();
 	void testExport();
 	void testImportWithoutValidTopics();
 	void testImportWrongFile();
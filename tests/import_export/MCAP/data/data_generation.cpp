@@ -0,0 +1,252 @@
+/*
+	File                 : data_generation.cpp
+	Project              : LabPlot
+	Description          : Generates the ROS 1, ROS 2 (CDR) and protobuf MCAP files for the tests
+	--------------------------------------------------------------------
+	SPDX-FileCopyrightText: 2026 LabPlot developers
+	SPDX-License-Identifier: GPL-2.0-or-later
+*/
+
+// Not part of the build, compile it with the bundled MCAP library and run it in this directory:
+// g++ -std=c++17 -I../../../../src/3rdparty/mcap/include data_generation.cpp -o data_generation && ./data_generation .
+
+#define MCAP_COMPRESSION_NO_LZ4
+#define MCAP_COMPRESSION_NO_ZSTD
+#define MCAP_IMPLEMENTATION
+#include "mcap/writer.hpp"
+
+#include <iostream>
+
+using Bytes = std::string;
+
+template<typename T>
+void put(Bytes& bytes, T value, bool bigEndian = false) {
+	const char* data = reinterpret_cast<const char*>(&value);
+	if (bigEndian) {
+		for (size_t i = sizeof(value); i-- > 0;)
+			bytes.push_back(data[i]);
+	} else
+		bytes.append(data, sizeof(value));
+}
+
+// CDR aligns relative to the data after the encapsulation header
+void align(Bytes& bytes, size_t size) {
+	while ((bytes.size() - 4) % size)
+		bytes.push_back(0);
+}
+
+void varint(Bytes& bytes, uint64_t value) {
+	while (value >= 0x80) {
+		bytes.push_back(char(value | 0x80));
+		value >>= 7;
+	}
+	bytes.push_back(char(value));
+}
+
+void tag(Bytes& bytes, int number, int wireType) {
+	varint(bytes, (uint64_t(number) << 3) | wireType);
+}
+
+void lengthField(Bytes& bytes, int number, const Bytes& value) {
+	tag(bytes, number, 2);
+	varint(bytes, value.size());
+	bytes += value;
+}
+
+void varintField(Bytes& bytes, int number, uint64_t value) {
+	tag(bytes, number, 0);
+	varint(bytes, value);
+}
+
+// FieldDescriptorProto
+Bytes fieldDescriptor(const char* name, int number, int type, int label = 1, const char* typeName = nullptr) {
+	Bytes field;
+	lengthField(field, 1, name);
+	varintField(field, 3, number);
+	varintField(field, 4, label);
+	varintField(field, 5, type);
+	if (typeName)
+		lengthField(field, 6, typeName);
+	return field;
+}
+
+void check(const mcap::Status& status) {
+	if (!status.ok()) {
+		std::cerr << status.message << std::endl;
+		exit(1);
+	}
+}
+
+void write(mcap::McapWriter& writer, mcap::ChannelId channel, uint32_t sequence, uint64_t time, const Bytes& data) {
+	mcap::Message message;
+	message.channelId = channel;
+	message.sequence = sequence;
+	message.logTime = time;
+	message.publishTime = time;
+	message.data = reinterpret_cast<const std::byte*>(data.data());
+	message.dataSize = data.size();
+	check(writer.write(message));
+}
+
+// 20 ROS 1 messages, each in its own chunk, with messages of a JSON channel in between
+void writeRos1(const std::string& directory) {
+	mcap::McapWriterOptions options("ros1");
+	options.compression = mcap::Compression::None;
+	options.chunkSize = 1;
+	mcap::McapWriter writer;
+	check(writer.open(directory + "/ros1_chunks.mcap", options));
+
+	const std::string definition =
+		"std_msgs/Header header\nfloat64[] values\nint16[2] pair\nuint8[] blob\nduration elapsed\n"
+		"================================================================================\n"
+		"MSG: std_msgs/Header\nuint32 seq\ntime stamp\nstring frame_id\n";
+	mcap::Schema schema("test_msgs/Ros1", "ros1msg", definition);
+	writer.addSchema(schema);
+	mcap::Channel channel("/ros1", "ros1", schema.id);
+	writer.addChannel(channel);
+	mcap::Schema jsonSchema("json", "jsonschema", std::string("{}"));
+	writer.addSchema(jsonSchema);
+	mcap::Channel jsonChannel("/json", "json", jsonSchema.id);
+	writer.addChannel(jsonChannel);
+
+	for (uint32_t i = 0; i < 20; ++i) {
+		Bytes message;
+		put<uint32_t>(message, i);
+		put<uint32_t>(message, 1000 + i);
+		put<uint32_t>(message, 500000000);
+		put<uint32_t>(message, 5);
+		message += "frame";
+		const uint32_t count = (i % 3 == 0) ? 2 : (i % 3 == 1) ? 3 : 1;
+		put<uint32_t>(message, count);
+		for (uint32_t k = 0; k < count; ++k)
+			put<double>(message, i + 0.5 * k);
+		put<int16_t>(message, -int16_t(i));
+		put<int16_t>(message, int16_t(i));
+		put<uint32_t>(message, i % 4);
+		message += std::string(i % 4, 'x');
+		put<int32_t>(message, int32_t(i));
+		put<int32_t>(message, 250000000);
+		write(writer, channel.id, i, i * 1000000000ULL, message);
+		write(writer, jsonChannel.id, i, i * 1000000000ULL + 1, "{\"value\": " + std::to_string(i) + "}");
+	}
+	writer.close();
+}
+
+// two CDR encoded ROS 2 messages, the first one little endian, the second one big endian
+void writeRos2(const std::string& directory) {
+	mcap::McapWriterOptions options("ros2");
+	options.compression = mcap::Compression::None;
+	mcap::McapWriter writer;
+	check(writer.open(directory + "/ros2_cdr.mcap", options));
+
+	const std::string definition =
+		"builtin_interfaces/Time stamp\nuint8 flag\nfloat64 x\nstring name\nint32[] seq\n"
+		"================================================================================\n"
+		"MSG: builtin_interfaces/Time\nint32 sec\nuint32 nanosec\n";
+	mcap::Schema schema("test_msgs/msg/Cdr", "ros2msg", definition);
+	writer.addSchema(schema);
+	mcap::Channel channel("/cdr", "cdr", schema.id);
+	writer.addChannel(channel);
+
+	for (int big = 0; big < 2; ++big) {
+		Bytes message(big ? std::string("\0\0\0\0", 4) : std::string("\0\1\0\0", 4));
+		put<int32_t>(message, 10 + big, big);
+		put<uint32_t>(message, big ? 0 : 2000000, big);
+		message.push_back(char(1 - big));
+		align(message, 8);
+		put<double>(message, big ? -1.5 : 3.25, big);
+		const std::string name = big ? "ros" : "hi";
+		put<uint32_t>(message, name.size() + 1, big);
+		message += name;
+		message.push_back(0);
+		align(message, 4);
+		put<uint32_t>(message, 2, big);
+		put<int32_t>(message, big ? 7 : -1, big);
+		put<int32_t>(message, big ? 8 : 5, big);
+		write(writer, channel.id, big, big * 1000000000ULL, message);
+	}
+	writer.close();
+}
+
+// two protobuf messages, the second one without the optional fields and with a repeated field that is not packed
+void writeProtobuf(const std::string& directory) {
+	mcap::McapWriterOptions options("");
+	options.compression = mcap::Compression::None;
+	mcap::McapWriter writer;
+	check(writer.open(directory + "/protobuf.mcap", options));
+
+	// FileDescriptorSet of pkg.Proto and google.protobuf.Timestamp
+	Bytes inner;
+	lengthField(inner, 1, "Inner");
+	lengthField(inner, 2, fieldDescriptor("a", 1, 5));
+	Bytes proto;
+	lengthField(proto, 1, "Proto");
+	lengthField(proto, 2, fieldDescriptor("x", 1, 1));
+	lengthField(proto, 2, fieldDescriptor("v", 2, 5, 3));
+	lengthField(proto, 2, fieldDescriptor("z", 3, 18));
+	lengthField(proto, 2, fieldDescriptor("t", 4, 11, 1, ".google.protobuf.Timestamp"));
+	lengthField(proto, 2, fieldDescriptor("inner", 5, 11, 1, ".pkg.Inner"));
+	lengthField(proto, 2, fieldDescriptor("s", 6, 9));
+	Bytes file;
+	lengthField(file, 1, "proto.proto");
+	lengthField(file, 2, "pkg");
+	lengthField(file, 3, "google/protobuf/timestamp.proto");
+	lengthField(file, 4, proto);
+	lengthField(file, 4, inner);
+	Bytes timestamp;
+	lengthField(timestamp, 1, "Timestamp");
+	lengthField(timestamp, 2, fieldDescriptor("seconds", 1, 3));
+	lengthField(timestamp, 2, fieldDescriptor("nanos", 2, 5));
+	Bytes timestampFile;
+	lengthField(timestampFile, 1, "google/protobuf/timestamp.proto");
+	lengthField(timestampFile, 2, "google.protobuf");
+	lengthField(timestampFile, 4, timestamp);
+	Bytes descriptors;
+	lengthField(descriptors, 1, file);
+	lengthField(descriptors, 1, timestampFile);
+
+	mcap::Schema schema("pkg.Proto", "protobuf", descriptors);
+	writer.addSchema(schema);
+	mcap::Channel channel("/protobuf", "protobuf", schema.id);
+	writer.addChannel(channel);
+
+	// the fields are not in the order of their numbers
+	Bytes message;
+	lengthField(message, 6, "str");
+	Bytes packed;
+	varint(packed, 1);
+	varint(packed, 300);
+	lengthField(message, 2, packed);
+	tag(message, 1, 1);
+	put<double>(message, 2.5);
+	varintField(message, 3, 3); // zigzag encoded -2
+	Bytes time;
+	varintField(time, 1, 1000);
+	varintField(time, 2, 5000000);
+	lengthField(message, 4, time);
+	Bytes innerMessage;
+	varintField(innerMessage, 1, 42);
+	lengthField(message, 5, innerMessage);
+	write(writer, channel.id, 0, 0, message);
+
+	message.clear();
+	tag(message, 1, 1);
+	put<double>(message, -1.);
+	varintField(message, 2, 7);
+	varintField(message, 2, 8);
+	varintField(message, 3, 6); // zigzag encoded 3
+	time.clear();
+	varintField(time, 1, 2000);
+	lengthField(message, 4, time);
+	write(writer, channel.id, 1, 1000000000ULL, message);
+
+	writer.close();
+}
+
+int main(int argc, char** argv) {
+	const std::string directory = argc > 1 ? argv[1] : ".";
+	writeRos1(directory);
+	writeRos2(directory);
+	writeProtobuf(directory);
+	return 0;
+}
@@ -9,9 +9,267 @@
 */
 
 #include "MatrixTest.h"
+#include "backend/lib/MatrixStorage.h"
+#include "backend/lib/XmlStreamReader.h"
 #include "backend/matrix/Matrix.h"
 #include "frontend/matrix/MatrixView.h"
 
-// TODO
+namespace {
+//! matrix with rows x cols cells and the value 10 * row + col in every cell
+MatrixStorage<double> testStorage(int rows, int cols, MatrixStorage<double>::Layout layout) {
+	MatrixStorage<double> storage(rows, cols, layout);
+	for (int row = 0; row < rows; ++row)
+		for (int col = 0; col < cols; ++col)
+			storage(row, col) = 10 * row + col;
+	return storage;
+}
+}
+
+// ##############################################################################
+// ################################  storage  ###################################
+// ##############################################################################
+/*!
+ * the values of the rows respectively of the columns are contiguous, depending on the layout
+ */
+void MatrixTest::storageLayout() {
+	using Layout = MatrixStorage<double>::Layout;
+	auto storage = testStorage(3, 2, Layout::ColumnMajor);
+	QCOMPARE(storage.size(), 6);
+	QCOMPARE(reinterpret_cast<quintptr>(storage.constData()) % 64, 0);
+	QCOMPARE(storage.constData()[1], 10.); // (1, 0)
+	QCOMPARE(storage.constData()[3], 1.); // (0, 1)
+
+	auto column = storage.column(1);
+	QVERIFY(column.isContiguous());
+	QCOMPARE(column.size(), 3);
+	QCOMPARE(column.at(2), 21.);
+	auto row = storage.row(2);
+	QVERIFY(!row.isContiguous());
+	QCOMPARE(row.size(), 2);
+	QCOMPARE(row.at(0), 20.);
+	QCOMPARE(row.at(1), 21.);
+
+	// the views don't copy
+	row[1] = 42.;
+	QCOMPARE(storage.at(2, 1), 42.);
+	QCOMPARE(column.toVector(), (QVector<double>{1., 11., 42.}));
+
+	// same values in the other layout
+	auto rowMajor = testStorage(3, 2, Layout::RowMajor);
+	QCOMPARE(rowMajor.constData()[1], 1.); // (0, 1)
+	QVERIFY(rowMajor.row(1).isContiguous());
+	QVERIFY(!rowMajor.column(1).isContiguous());
+	rowMajor(2, 1) = 42.;
+	QVERIFY(rowMajor == storage);
+
+	storage.setLayout(Layout::RowMajor);
+	QCOMPARE(storage.layout(), Layout::RowMajor);
+	QCOMPARE(storage.at(2, 1), 42.);
+	QVERIFY(storage.row(2).isContiguous());
+	QVERIFY(rowMajor == storage);
+}
+
+void MatrixTest::storageInsertRemove() {
+	using Layout = MatrixStorage<double>::Layout;
+	for (auto layout : {Layout::ColumnMajor, Layout::RowMajor}) {
+		auto storage = testStorage(3, 3, layout);
+
+		storage.insertColumns(1, 2);
+		QCOMPARE(storage.columnCount(), 5);
+		QCOMPARE(storage.at(1, 0), 10.);
+		QCOMPARE(storage.at(1, 1), 0.);
+		QCOMPARE(storage.at(1, 2), 0.);
+		QCOMPARE(storage.at(1, 3), 11.);
+		QCOMPARE(storage.at(2, 4), 22.);
+
+		storage.insertRows(0, 1);
+		QCOMPARE(storage.rowCount(), 4);
+		QCOMPARE(storage.at(0, 0), 0.);
+		QCOMPARE(storage.at(3, 4), 22.);
+
+		storage.removeColumns(1, 2);
+		storage.removeRows(0, 1);
+		QVERIFY(storage == testStorage(3, 3, layout));
+
+		storage.resize(2, 4);
+		QCOMPARE(storage.at(1, 1), 11.);
+		QCOMPARE(storage.at(1, 3), 0.);
+	}
+}
+
+void MatrixTest::storageTranspose() {
+	using Layout = MatrixStorage<double>::Layout;
+	auto storage = testStorage(2, 3, Layout::ColumnMajor);
+	const auto* data = storage.constData();
+	storage.transpose();
+	QCOMPARE(storage.constData(), data); // the buffer is not touched
+	QCOMPARE(storage.rowCount(), 3);
+	QCOMPARE(storage.columnCount(), 2);
+	QCOMPARE(storage.layout(), Layout::RowMajor);
+	for (int row = 0; row < 3; ++row)
+		for (int col = 0; col < 2; ++col)
+			QCOMPARE(storage.at(row, col), 10. * col + row);
+
+	storage.setLayout(Layout::ColumnMajor);
+	QCOMPARE(storage.at(2, 1), 12.);
+	QVERIFY(storage.column(1).isContiguous());
+}
+
+// ##############################################################################
+// ################################  matrix  ####################################
+// ##############################################################################
+void MatrixTest::insertRemove() {
+	Matrix m(QStringLiteral("matrix"), true);
+	m.setDimensions(3, 2);
+	for (int row = 0; row < 3; ++row)
+		for (int col = 0; col < 2; ++col)
+			m.setCell(row, col, 10. * row + col);
+
+	m.insertColumns(1, 1);
+	m.insertRows(0, 2);
+	QCOMPARE(m.rowCount(), 5);
+	QCOMPARE(m.columnCount(), 3);
+	QCOMPARE(m.cell<double>(4, 2), 21.);
+	QCOMPARE(m.cell<double>(4, 1), 0.);
+	QCOMPARE(m.rowCells<double>(3, 0, 2), (QVector<double>{10., 0., 11.}));
+	QCOMPARE(m.columnCells<double>(2, 2, 4), (QVector<double>{1., 11., 21.}));
+
+	// the values of a column are contiguous
+	const auto* storage = static_cast<MatrixStorage<double>*>(m.data());
+	QVERIFY(storage->column(2).isContiguous());
+	QCOMPARE(storage->column(2).data()[4], 21.);
+
+	m.setRowCells<double>(0, 0, 2, {1., 2., 3.});
+	QCOMPARE(m.cell<double>(0, 1), 2.);
+
+	m.removeRows(0, 2);
+	m.removeColumns(1, 1);
+	QCOMPARE(m.rowCount(), 3);
+	QCOMPARE(m.columnCount(), 2);
+	QCOMPARE(m.cell<double>(2, 1), 21.);
+
+	// a matrix without columns has no rows
+	m.removeColumns(0, 2);
+	QCOMPARE(m.rowCount(), 0);
+	m.appendColumns(1);
+	QCOMPARE(m.rowCount(), 0);
+	QCOMPARE(m.columnCount(), 1);
+}
+
+void MatrixTest::transposeMirror() {
+	Matrix m(QStringLiteral("matrix"), true, AbstractColumn::ColumnMode::Integer);
+	m.setDimensions(2, 3);
+	for (int row = 0; row < 2; ++row)
+		for (int col = 0; col < 3; ++col)
+			m.setCell(row, col, 10 * row + col);
+
+	m.transpose();
+	QCOMPARE(m.rowCount(), 3);
+	QCOMPARE(m.columnCount(), 2);
+	QCOMPARE(m.columnCells<int>(0, 0, 2), (QVector<int>{0, 1, 2}));
+	QCOMPARE(m.columnCells<int>(1, 0, 2), (QVector<int>{10, 11, 12}));
+	QVERIFY(static_cast<MatrixStorage<int>*>(m.data())->column(1).isContiguous());
+
+	m.mirrorHorizontally();
+	QCOMPARE(m.rowCells<int>(0, 0, 1), (QVector<int>{10, 0}));
+
+	m.mirrorVertically();
+	QCOMPARE(m.columnCells<int>(0, 0, 2), (QVector<int>{12, 11, 10}));
+	QCOMPARE(m.columnCells<int>(1, 0, 2), (QVector<int>{2, 1, 0}));
+}
+
+/*!
+ * the heights of the rows and the widths of the columns are swapped when transposing a non-square matrix
+ */
+void MatrixTest::transposeSizes() {
+	Matrix m(QStringLiteral("matrix"), true);
+	m.setDimensions(2, 5);
+	for (int row = 0; row < 2; ++row)
+		m.setRowHeight(row, 10 + row);
+	for (int col = 0; col < 5; ++col)
+		m.setColumnWidth(col, 100 + col);
+
+	m.transpose();
+	QCOMPARE(m.rowCount(), 5);
+	QCOMPARE(m.columnCount(), 2);
+	for (int row = 0; row < 5; ++row)
+		QCOMPARE(m.rowHeight(row), 100 + row);
+	for (int col = 0; col < 2; ++col)
+		QCOMPARE(m.columnWidth(col), 10 + col);
+
+	QByteArray array;
+	QXmlStreamWriter writer(&array);
+	m.save(&writer);
+
+	Matrix m2(QStringLiteral("matrix 2"), true);
+	XmlStreamReader reader(array);
+	while (!reader.atEnd()) {
+		reader.readNext();
+		if (reader.isStartElement() && reader.name() == QLatin1String("matrix"))
+			break;
+	}
+	QVERIFY(m2.load(&reader, false));
+
+	QCOMPARE(m2.rowCount(), 5);
+	QCOMPARE(m2.columnCount(), 2);
+	for (int row = 0; row < 5; ++row)
+		QCOMPARE(m2.rowHeight(row), 100 + row);
+	for (int col = 0; col < 2; ++col)
+		QCOMPARE(m2.columnWidth(col), 10 + col);
+
+	// transposing again restores the sizes
+	m.transpose();
+	QCOMPARE(m.rowCount(), 2);
+	QCOMPARE(m.columnCount(), 5);
+	for (int row = 0; row < 2; ++row)
+		QCOMPARE(m.rowHeight(row), 10 + row);
+	for (int col = 0; col < 5; ++col)
+		QCOMPARE(m.columnWidth(col), 100 + col);
+}
+
+void MatrixTest::saveLoad() {
+	Matrix m(QStringLiteral("matrix"), true);
+	m.setDimensions(3, 2);
+	for (int row = 0; row < 3; ++row)
+		for (int col = 0; col < 2; ++col)
+			m.setCell(row, col, 10. * row + col + 0.5);
+
+	QByteArray array;
+	QXmlStreamWriter writer(&array);
+	m.save(&writer);
+
+	Matrix m2(QStringLiteral("matrix 2"), true);
+	XmlStreamReader reader(array);
+	while (!reader.atEnd()) {
+		reader.readNext();
+		if (reader.isStartElement() && reader.name() == QLatin1String("matrix"))
+			break;
+	}
+	QVERIFY(m2.load(&reader, false));
+
+	QCOMPARE(m2.rowCount(), 3);
+	QCOMPARE(m2.columnCount(), 2);
+	for (int row = 0; row < 3; ++row)
+		for (int col = 0; col < 2; ++col)
+			QCOMPARE(m2.cell<double>(row, col), 10. * row + col + 0.5);
+}
+
+/*!
+ * reading whole rows of a large matrix
+ */
+void MatrixTest::benchmarkRowAccess() {
+	const int size = 2000;
+	Matrix m(QStringLiteral("matrix"), true);
+	m.setDimensions(size, size);
+
+	double sum = 0.;
+	QBENCHMARK {
+		for (int row = 0; row < size; ++row) {
+			const auto values = m.rowCells<double>(row, 0, size - 1);
+			sum += values.at(row);
+		}
+	}
+	QCOMPARE(sum, 0.);
+}
 
 QTEST_MAIN(MatrixTest)
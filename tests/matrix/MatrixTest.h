@@ -17,6 +17,17 @@ class MatrixTest : public CommonTest {
 	Q_OBJECT
 
 private Q_SLOTS:
+	// storage
+	void storageLayout();
+	void storageInsertRemove();
+	void storageTranspose();
+
+	void insertRemove();
+	void transposeMirror();
+	void transposeSizes();
+	void saveLoad();
+
+	void benchmarkRowAccess();
 
 	// TODO: see Spreadsheet for things to test
 };
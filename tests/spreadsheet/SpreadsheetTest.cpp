@@ -1136,6 +1136,112 @@ void SpreadsheetTest::testSortDateTime2() {
 	QCOMPARE(col1->integerAt(6), 7);
 }
 
+/*
+ * check sorting with two key columns with different sort orders
+ */
+void SpreadsheetTest::testSortMultipleKeys() {
+	Spreadsheet sheet(QStringLiteral("test"), false);
+	sheet.setColumnCount(3);
+	sheet.setRowCount(6);
+	auto* col0{sheet.column(0)};
+	auto* col1{sheet.column(1)};
+	auto* col2{sheet.column(2)};
+	col0->setColumnMode(AbstractColumn::ColumnMode::Text);
+	col0->replaceTexts(0, {QStringLiteral("b"), QStringLiteral("a"), QStringLiteral("b"), QString(), QStringLiteral("a"), QStringLiteral("b")});
+	col1->replaceValues(0, {1., 2., GSL_NAN, 4., 5., 3.});
+	col2->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	col2->replaceInteger(0, {1, 2, 3, 4, 5, 6});
+
+	// sort by the text ascending and by the value descending, NaN is sorted behind the valid values
+	sheet.sortColumns({{col0, true}, {col1, false}}, {col0, col1, col2});
+
+	QCOMPARE(col2->integerAt(0), 5);
+	QCOMPARE(col2->integerAt(1), 2);
+	QCOMPARE(col2->integerAt(2), 6);
+	QCOMPARE(col2->integerAt(3), 1);
+	QCOMPARE(col2->integerAt(4), 3);
+	QCOMPARE(col2->integerAt(5), 4); // empty text
+	QCOMPARE(col0->textAt(0), QStringLiteral("a"));
+	QCOMPARE(col0->textAt(4), QStringLiteral("b"));
+	QCOMPARE(col1->valueAt(0), 5.);
+	QCOMPARE(col1->valueAt(2), 3.);
+	QVERIFY(std::isnan(col1->valueAt(4)));
+}
+
+/*
+ * check that empty texts of a descending key column are sorted behind the first text in the sort order
+ */
+void SpreadsheetTest::testSortMultipleKeysInvalid() {
+	Spreadsheet sheet(QStringLiteral("test"), false);
+	sheet.setColumnCount(3);
+	sheet.setRowCount(5);
+	auto* col0{sheet.column(0)};
+	auto* col1{sheet.column(1)};
+	auto* col2{sheet.column(2)};
+	col0->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	col0->replaceInteger(0, {1, 1, 1, 1, 1});
+	col1->setColumnMode(AbstractColumn::ColumnMode::Text);
+	col1->replaceTexts(0, {QString(), QStringLiteral("a"), QStringLiteral("b"), QString(), QStringLiteral("a")});
+	col2->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	col2->replaceInteger(0, {1, 2, 3, 4, 5});
+
+	sheet.sortColumns({{col0, true}, {col1, false}}, {col0, col1, col2});
+
+	QCOMPARE(col2->integerAt(0), 3);
+	QCOMPARE(col2->integerAt(1), 2);
+	QCOMPARE(col2->integerAt(2), 5);
+	QCOMPARE(col2->integerAt(3), 1);
+	QCOMPARE(col2->integerAt(4), 4);
+	QCOMPARE(col1->textAt(0), QStringLiteral("b"));
+	QCOMPARE(col1->textAt(2), QStringLiteral("a"));
+	QCOMPARE(col1->textAt(3), QString());
+}
+
+/*
+ * check that undoing the sort restores the original order of all columns
+ */
+void SpreadsheetTest::testSortUndo() {
+	Project project;
+	auto* sheet = new Spreadsheet(QStringLiteral("test"));
+	project.addChild(sheet);
+	sheet->setColumnCount(3);
+	sheet->setRowCount(1000);
+
+	QVector<double> xData;
+	QVector<qint64> yData;
+	QVector<QString> zData;
+	for (int i = 0; i < sheet->rowCount(); i++) {
+		xData << (i * 7919) % 1000;
+		yData << -i;
+		zData << QString::number(i);
+	}
+	auto* col0{sheet->column(0)};
+	auto* col1{sheet->column(1)};
+	auto* col2{sheet->column(2)};
+	col0->replaceValues(0, xData);
+	col1->setColumnMode(AbstractColumn::ColumnMode::BigInt);
+	col1->replaceBigInt(0, yData);
+	col2->setColumnMode(AbstractColumn::ColumnMode::Text);
+	col2->replaceTexts(0, zData);
+
+	sheet->sortColumns(col0, {col0, col1, col2}, true);
+	for (int i = 0; i < 1000; i++) {
+		QCOMPARE(col0->valueAt(i), (double)i);
+		QCOMPARE(col2->textAt(i), QString::number(-col1->bigIntAt(i)));
+	}
+
+	project.undoStack()->undo();
+	for (int i = 0; i < 1000; i++) {
+		QCOMPARE(col0->valueAt(i), xData.at(i));
+		QCOMPARE(col1->bigIntAt(i), yData.at(i));
+		QCOMPARE(col2->textAt(i), zData.at(i));
+	}
+
+	project.undoStack()->redo();
+	QCOMPARE(col0->valueAt(999), 999.);
+	QCOMPARE(col2->textAt(0), QStringLiteral("0"));
+}
+
 // performance
 
 /*
@@ -1184,6 +1290,43 @@ void SpreadsheetTest::testSortPerformanceNumeric2() {
 	QBENCHMARK { sheet.sortColumns(col0, {col0, col1}, true); }
 }
 
+/*
+ * check performance of sorting many columns by an integer column
+ */
+void SpreadsheetTest::testSortPerformanceMultipleColumns() {
+	const int rows = 100000;
+	const int columns = 30;
+	Spreadsheet sheet(QStringLiteral("test"), false);
+	sheet.setColumnCount(columns);
+	sheet.setRowCount(rows);
+
+	QVector<int> keys(rows);
+	QVector<double> values(rows);
+	for (int i = 0; i < rows; i++) {
+		keys[i] = QRandomGenerator::global()->bounded(1000);
+		values[i] = QRandomGenerator::global()->generateDouble();
+	}
+
+	QVector<Column*> cols;
+	for (int c = 0; c < columns; c++) {
+		auto* col = sheet.column(c);
+		col->replaceValues(0, values);
+		cols << col;
+	}
+	auto* key = sheet.column(0);
+	key->setColumnMode(AbstractColumn::ColumnMode::Integer);
+	key->replaceInteger(0, keys);
+
+	bool ascending = true;
+	QBENCHMARK {
+		sheet.sortColumns(key, cols, ascending);
+		ascending = !ascending;
+	}
+
+	for (int i = 1; i < rows; i++)
+		QVERIFY(ascending ? key->integerAt(i - 1) >= key->integerAt(i) : key->integerAt(i - 1) <= key->integerAt(i));
+}
+
 // **********************************************************
 // ********************* drop/mask  *************************
 // **********************************************************
@@ -59,9 +59,13 @@ private Q_SLOTS:
 	void testSortText2();
 	void testSortDateTime1();
 	void testSortDateTime2();
+	void testSortMultipleKeys();
+	void testSortMultipleKeysInvalid();
+	void testSortUndo();
 
 	void testSortPerformanceNumeric1();
 	void testSortPerformanceNumeric2();
+	void testSortPerformanceMultipleColumns();
 
 	// drop/mask
 	void testRemoveRowsWithMissingValues();